@@ -8,6 +8,14 @@
  * 1. Initialize hardware (GPIO, timebase, drivers)
  * 2. Run all checkpoint tests (results cached)
  * 3. Enter interactive TUI (non-scrolling console)
+ *
+ * Fast boot (FAST_BOOT=1, production profile): no USB enumeration delay,
+ * the NSP service starts as soon as Core1 is running, checkpoint tests are
+ * skipped and the TUI draws itself when a host opens the console port.
+ *
+ * Warm restart (after a watchdog reset, see warm_restart.h): boots as fast
+ * boot does, with the wheels and running scenarios restored from the
+ * previous boot.
  */
 
 #include <stdio.h>
@@ -15,12 +23,15 @@
 #include "pico/stdlib.h"
 #include "pico/multicore.h"
 #include "pico/unique_id.h"
-#include "hardware/watchdog.h"
+#include "hardware/sync.h"
 
 // Platform layer
 #include "board_pico.h"
 #include "gpio_map.h"
 #include "timebase.h"
+#include "hot_path.h"
+#include "clock_profile.h"
+#include "warm_restart.h"
 
 // Test system
 #include "test_mode.h"
@@ -31,6 +42,7 @@
 #include "tui.h"
 #include "tables.h"
 #include "logo.h"
+#include "table_tests.h"
 #include "table_config.h"
 #include "table_control.h"
 #include "table_fault_injection.h"
@@ -38,29 +50,65 @@
 #include "table_test_modes.h"
 #include "table_serial.h"
 #include "table_nsp.h"
+#include "table_cmd_stats.h"
+#include "table_profiler.h"
+#include "table_stream.h"
+#include "table_flight_rec.h"
+#include "table_timebase.h"
+#include "table_stats.h"
+#include "table_loadgen.h"
+#include "table_mem.h"
+#include "table_protection_limits.h"
+#include "table_protection_status.h"
+#include "batch.h"
 
 // Test modes (operating scenarios)
 #include "nss_nrwa_t6_test_modes.h"
 
 // Fault injection
 #include "config/scenario.h"
+#include "config/config_store.h"
 
 // Device model
 #include "nss_nrwa_t6_model.h"
 #include "nss_nrwa_t6_protection.h"
+#include "nss_nrwa_t6_engine.h"
 
 // Inter-core sync
 #include "util/core_sync.h"
+#include "util/profiler.h"
+#include "util/tick_trace.h"
+#include "util/flash_store.h"
+#include "util/nsp_trace.h"
+#include "util/flight_rec.h"
+#include "util/dlog.h"
+#include "util/stats.h"
+#include "util/mem_budget.h"
 
 // NSP packet handler (Core0)
 #include "nsp_handler.h"
 
 // NSP commands (for commands_init)
 #include "nss_nrwa_t6_commands.h"
+#include "nss_nrwa_t6_telemetry.h"
+
+// Binary telemetry stream (USB CDC 1)
+#include "usb_stream.h"
+
+// Hall/tach pulse outputs (PIO1), PWM analog monitors, FAULT/RESET lines
+#include "hall_out.h"
+#include "monitor_out.h"
+#include "fault_line.h"
+#include "reset_line.h"
 
 // Uncomment to run Phase 9 tests at boot (normally user-triggered from TUI)
 // #define RUN_PHASE9_TESTS
 
+// Production boot profile (passed from CMake, NRWA_FAST_BOOT)
+#ifndef FAST_BOOT
+#define FAST_BOOT 0
+#endif
+
 // Firmware version (passed from CMake)
 #ifndef FIRMWARE_VERSION
 #define FIRMWARE_VERSION "v0.1.0-unknown"
@@ -83,61 +131,106 @@ static void print_banner(uint8_t device_addr) {
 
     // Print banner
     printf("NRWA-T6 Emulator %s\n", FIRMWARE_VERSION);
-    printf("Build: %s %s | RP2040 Dual-Core @ 125MHz\n", BUILD_DATE, BUILD_TIME);
-    printf("NewSpace NRWA-T6 Compatible | 100Hz Physics Engine\n");
+    printf("Build: %s %s | RP2040 Dual-Core @ %luMHz (%s)\n", BUILD_DATE, BUILD_TIME,
+           (unsigned long)(clock_profile_get_sys_hz() / 1000000u),
+           clock_profile_get_name(clock_profile_get()));
+    printf("NewSpace NRWA-T6 Compatible | Wheel Profile: %s | %uHz Physics Engine\n",
+           WHEEL_PROFILE_NAME, (unsigned)PHYSICS_TICK_RATE_HZ);
     printf("Board: %02X%02X%02X%02X%02X%02X%02X%02X | Device Address: 0x%02X\n\n",
            board_id.id[0], board_id.id[1], board_id.id[2], board_id.id[3],
            board_id.id[4], board_id.id[5], board_id.id[6], board_id.id[7],
            device_addr);
 }
 
+/**
+ * @brief Stop here when NSP cannot run (address out of range, RS-485 down)
+ *
+ * Never returns and never starts Core1 or the NSP service: the wheel stays
+ * off the bus. The heartbeat LED blinks at 5 Hz instead of 1 Hz and the
+ * reason is repeated every 2 s, so a console opened later still sees it.
+ */
+static void __attribute__((noreturn)) halt_nsp_init_failed(uint8_t device_addr) {
+#if ENABLE_EXTERNAL_LEDS
+    gpio_set_fault_led(true);
+#endif
+    bool led_state = false;
+    for (uint32_t n = 0; ; n++) {
+        if (n % 20 == 0) {
+            printf("[Core0] HALT: NSP handler init failed (address 0x%02X, %u wheel(s)); "
+                   "check the ADDR pins and the RS-485 link\n",
+                   device_addr, (unsigned)EMULATED_WHEEL_COUNT);
+        }
+        led_state = !led_state;
+        gpio_set_heartbeat_led(led_state);
+        sleep_ms(100);
+    }
+}
+
 // ============================================================================
 // Global State (Shared between cores via core_sync)
 // ============================================================================
 
-wheel_state_t g_wheel_state;  // Non-static for console/test mode access
+wheel_state_t CORE1_WHEEL_DATA g_wheel_states[EMULATED_WHEEL_COUNT];  // Non-static for console/test mode access
 static volatile bool g_core1_ready = false;
 
 // ============================================================================
-// Core1: Physics Loop (100 Hz Hard Real-Time)
+// Core1: Physics Loop (PHYSICS_TICK_RATE_HZ Hard Real-Time, 100 Hz default)
 // ============================================================================
 
 /**
- * @brief 100 Hz physics tick callback (called from ISR)
+ * @brief Physics tick callback (called from ISR)
  *
- * This function is called by the hardware alarm ISR at 100 Hz.
- * It must complete in <200µs to meet jitter requirements.
+ * This function is called by the hardware alarm ISR at PHYSICS_TICK_RATE_HZ.
+ * It must complete in <MAX_TICK_JITTER_US to meet jitter requirements.
  */
 static volatile bool g_physics_tick_flag = false;
 
-static void physics_tick_callback(void) {
+static void HOT_PATH_FUNC(physics_tick_callback)(void) {
     // Set flag for Core1 main loop to process
     // Do NOT do any work here - ISR must be fast
     g_physics_tick_flag = true;
+    __sev();  // Wake Core1 from WFE (latched if it has not slept yet)
 }
 
 /**
- * @brief Core 1 entry point - Physics simulation at 100 Hz
+ * @brief Core 1 entry point - Physics simulation at PHYSICS_TICK_RATE_HZ
  *
- * This core runs a hard real-time loop at 100 Hz (10ms period).
+ * This core runs a hard real-time loop at PHYSICS_TICK_RATE_HZ (100 Hz /
+ * 10 ms period by default).
  * It reads commands from Core0, updates physics, checks protections,
  * and publishes telemetry back to Core0.
  */
-void core1_main(void) {
-    printf("[Core1] Starting physics engine...\n");
+void HOT_PATH_FUNC(core1_main)(void) {
+    // Stack high-water mark (Table 20): paint before anything runs deep
+    mem_budget_paint_stack();
 
-    // Initialize wheel model with default state
-    // Note: wheel_model_init() internally calls protection_init()
-    wheel_model_init(&g_wheel_state);
-    printf("[Core1] Wheel model initialized (includes protection system)\n");
+    printf("[Core1] Starting physics engine...\n");
 
-    // Initialize test mode framework
-    test_mode_init();
+    // Initialize wheel models with default state (includes protection) and
+    // the test mode framework; every snapshot also feeds the USB stream
+    physics_engine_init(g_wheel_states, usb_stream_core1_push);
+    printf("[Core1] %u wheel model(s) initialized (includes protection system)\n",
+           (unsigned)EMULATED_WHEEL_COUNT);
     printf("[Core1] Test mode framework initialized\n");
 
+    // After a watchdog reset the wheels continue from their saved state
+    warm_restart_core1_init(g_wheel_states);
+
+    // Core1 cycle counter for the hot-path profiler (SysTick is per core)
+    timebase_cycle_counter_start();
+
     // Set up timebase with callback
     timebase_init(physics_tick_callback);
-    printf("[Core1] Timebase initialized (100 Hz)\n");
+    printf("[Core1] Timebase initialized (%u Hz)\n", (unsigned)PHYSICS_TICK_RATE_HZ);
+
+    // Hardware RESET edges interrupt this core, next to SYNC and PPS
+    reset_line_init();
+
+    // Hall/tach and analog monitor outputs follow wheel 0, updated every tick;
+    // the FAULT line follows every wheel
+    hall_out_init();
+    monitor_out_init();
+    fault_line_init();
 
     // Start the physics tick
     timebase_start();
@@ -146,158 +239,56 @@ void core1_main(void) {
     // Signal that Core1 is ready
     g_core1_ready = true;
 
-    // Statistics
-    uint32_t tick_count = 0;
-    uint32_t max_jitter_us = 0;
-
     // Main physics loop
     while (1) {
-        // Wait for physics tick flag
-        while (!g_physics_tick_flag) {
-            tight_loop_contents();
+        // Sleep until the alarm ISR sets the tick flag or, in stepped mode,
+        // an external step is pending. Both wake Core1 with a latched SEV
+        // (or the sync pulse IRQ), so a tick landing between the check and
+        // WFE is not lost; other events just re-check. A pending flash
+        // write parks Core1 in RAM here, between ticks.
+        while (!g_physics_tick_flag && !timebase_take_step()) {
+            warm_restart_core1_beat();
+            flash_store_core1_poll();
+            __wfe();
         }
 
         // Clear flag
         g_physics_tick_flag = false;
 
-        // Record tick start time
-        uint64_t tick_start = time_us_64();
-
-        // ====================================================================
-        // 1. Read commands from Core0
-        // ====================================================================
-        command_mailbox_t cmd;
-        if (core_sync_read_command(&cmd)) {
-            // Apply command to wheel model
-            switch (cmd.type) {
-                case CMD_SET_MODE:
-                    // param1 = mode index, param2 = setpoint (optional, from APP-CMD)
-                    {
-                        control_mode_t new_mode = (control_mode_t)cmd.param1;
-                        wheel_model_set_mode(&g_wheel_state, new_mode);
-
-                        // If param2 is non-zero, apply the setpoint for the new mode
-                        // This enables atomic mode+setpoint changes from APPLICATION-COMMAND
-                        if (cmd.param2 != 0.0f) {
-                            switch (new_mode) {
-                                case CONTROL_MODE_CURRENT:
-                                    wheel_model_set_current(&g_wheel_state, cmd.param2);
-                                    break;
-                                case CONTROL_MODE_SPEED:
-                                    wheel_model_set_speed(&g_wheel_state, cmd.param2);
-                                    break;
-                                case CONTROL_MODE_TORQUE:
-                                    wheel_model_set_torque(&g_wheel_state, cmd.param2);
-                                    break;
-                                case CONTROL_MODE_PWM:
-                                    wheel_model_set_pwm(&g_wheel_state, cmd.param2);
-                                    break;
-                            }
-                        }
-                    }
-                    break;
-
-                case CMD_SET_SPEED:
-                    wheel_model_set_speed(&g_wheel_state, cmd.param1);
-                    break;
-
-                case CMD_SET_CURRENT:
-                    wheel_model_set_current(&g_wheel_state, cmd.param1);
-                    break;
-
-                case CMD_SET_TORQUE:
-                    wheel_model_set_torque(&g_wheel_state, cmd.param1);
-                    break;
-
-                case CMD_SET_PWM:
-                    wheel_model_set_pwm(&g_wheel_state, cmd.param1);
-                    break;
-
-                case CMD_CLEAR_FAULT:
-                    // Clear latched faults (param1 = fault mask encoded as float)
-                    {
-                        uint32_t fault_mask;
-                        memcpy(&fault_mask, &cmd.param1, sizeof(uint32_t));
-                        g_wheel_state.fault_latch &= ~fault_mask;
-                        g_wheel_state.fault_status &= ~fault_mask;
-                    }
-                    break;
-
-                case CMD_RESET:
-                    // Soft reset: reinitialize wheel model
-                    wheel_model_init(&g_wheel_state);
-                    protection_init(&g_wheel_state);
-                    break;
-
-                case CMD_TRIP_LCL:
-                    // Test LCL trip (ICD TRIP-LCL command)
-                    // This simulates the hardware LCL tripping
-                    wheel_model_trip_lcl(&g_wheel_state);
-                    break;
-
-                case CMD_CONFIG_PROTECTION:
-                    // Configure protection enable mask (ICD CONFIGURE-PROTECTION)
-                    // param1 contains the enable mask encoded as float
-                    {
-                        uint32_t enable_mask;
-                        memcpy(&enable_mask, &cmd.param1, sizeof(uint32_t));
-                        g_wheel_state.protection_enable = enable_mask;
-                    }
-                    break;
-
-                default:
-                    break;
-            }
-        }
-
-        // ====================================================================
-        // 2. Update physics model (10ms tick)
-        // ====================================================================
-        // Note: wheel_model_tick() includes protection checks
-        wheel_model_tick(&g_wheel_state);
-
-        // ====================================================================
-        // 3. Publish telemetry snapshot to Core0
-        // ====================================================================
-        telemetry_snapshot_t snapshot;
-        snapshot.omega_rad_s = g_wheel_state.omega_rad_s;
-        snapshot.speed_rpm = g_wheel_state.omega_rad_s * RAD_S_TO_RPM;
-        snapshot.momentum_nms = g_wheel_state.momentum_nms;
-        snapshot.current_a = g_wheel_state.current_out_a;
-        snapshot.torque_mnm = g_wheel_state.torque_out_mnm;
-        snapshot.power_w = g_wheel_state.power_w;
-        snapshot.voltage_v = g_wheel_state.voltage_v;
-        snapshot.mode = g_wheel_state.mode;
-        snapshot.direction = g_wheel_state.direction;
-        snapshot.fault_status = g_wheel_state.fault_status;
-        snapshot.fault_latch = g_wheel_state.fault_latch;
-        snapshot.warning_status = g_wheel_state.warning_status;
-        snapshot.lcl_tripped = g_wheel_state.lcl_tripped;
-        snapshot.tick_count = g_wheel_state.tick_count;
-
-        // Record jitter
-        uint64_t tick_end = time_us_64();
-        uint32_t jitter_us = (uint32_t)(tick_end - tick_start);
-        snapshot.jitter_us = jitter_us;
-
-        if (jitter_us > max_jitter_us) {
-            max_jitter_us = jitter_us;
-        }
-        snapshot.max_jitter_us = max_jitter_us;
-        snapshot.timestamp_us = tick_end;
-
-        // Publish snapshot
-        core_sync_publish_telemetry(&snapshot);
+        // Commands, physics, telemetry, recorder and load for this tick,
+        // then idle-time work (telemetry blocks) in the slack before the next
+        uint32_t tick_start_us = time_us_32();
+        physics_engine_tick(timebase_get_last_wake_us());
+        fault_line_update(g_wheel_states, EMULATED_WHEEL_COUNT, tick_start_us);
+        reset_line_update();
+        hall_out_update(g_wheel_states[0].omega_rad_s);
+        monitor_out_update(g_wheel_states[0].omega_rad_s * RAD_S_TO_RPM,
+                           g_wheel_states[0].current_out_a, g_wheel_states[0].torque_out_mnm);
+        physics_engine_idle();
+        warm_restart_core1_beat();  // Also when the next tick is already due
+    }
+}
 
-        tick_count++;
+/**
+ * @brief Dump the NSP trace when any wheel latches a new fault (Core0)
+ *
+ * Captures the transactions leading up to the fault; the dump goes out on
+ * the telemetry USB port as soon as the host has it open.
+ */
+static void check_fault_trace_dump(void) {
+    static uint32_t latched_prev[EMULATED_WHEEL_COUNT];
+    telemetry_snapshot_t snap;
 
-        // ====================================================================
-        // 5. Jitter monitoring (log if > 200µs)
-        // ====================================================================
-        if (jitter_us > 200) {
-            // NOTE: Don't printf here! It will cause even more jitter.
-            // Instead, log to a counter and check from Core0.
+    for (uint8_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        if (!core_sync_read_wheel_telemetry(w, &snap)) {
+            continue;
+        }
+        if ((snap.fault_latch & ~latched_prev[w]) != 0) {
+            printf("[NSP] Wheel %u fault latch 0x%08lX: NSP trace dump requested\n",
+                   (unsigned)w, (unsigned long)snap.fault_latch);
+            nsp_trace_request_dump(NSP_TRACE_DUMP_FAULT);
         }
+        latched_prev[w] = snap.fault_latch;
     }
 }
 
@@ -305,11 +296,26 @@ void core1_main(void) {
  * @brief Main entry point
  */
 int main(void) {
+    // Stack high-water mark (Table 20): paint before anything runs deep
+    mem_budget_paint_stack();
+
+    // Warm restart or cold boot, before anything touches the saved state;
+    // a warm restart takes the fast boot path
+    bool warm = warm_restart_init();
+    bool quick = FAST_BOOT || warm;
+
+    // System clock profile first: clk_peri (UART) and every later
+    // peripheral setup depend on it
+    bool clock_ok = clock_profile_apply(CLOCK_PROFILE_DEFAULT);
+
     // Initialize stdio (USB-CDC only, UART1 reserved for RS-485)
     stdio_init_all();
+    usb_stream_init();
 
-    // Small delay for USB enumeration
-    sleep_ms(2000);
+    if (!quick) {
+        // Small delay for USB enumeration
+        sleep_ms(2000);
+    }
 
     // Initialize GPIO first to read device address
     gpio_init_all();
@@ -318,10 +324,26 @@ int main(void) {
     // Print startup banner with device address
     print_banner(device_addr);
 
+    if (!clock_ok) {
+        printf("[CLOCK] WARNING: %s profile rejected (%s), running %s\n",
+               clock_profile_get_name(CLOCK_PROFILE_DEFAULT), clock_profile_get_status(),
+               clock_profile_get_name(clock_profile_get()));
+    }
+
+    if (warm) {
+        printf("[WARM] Watchdog reset: warm restart %lu since the last cold boot\n",
+               (unsigned long)warm_restart_get_count());
+    }
+
     printf("[Core0] Initializing hardware...\n");
     printf("[Core0] Device address: 0x%02X (from ADDR pins)\n", device_addr);
+    if (EMULATED_WHEEL_COUNT > 1) {
+        printf("[Core0] Wheel cluster: %u wheels at 0x%02X-0x%02X\n",
+               (unsigned)EMULATED_WHEEL_COUNT, device_addr,
+               (unsigned)(device_addr + EMULATED_WHEEL_COUNT - 1));
+    }
 
-    // Initialize timebase (100 Hz tick for Core1 physics)
+    // Initialize timebase (PHYSICS_TICK_RATE_HZ tick for Core1 physics)
     // Note: Callback will be set by Core1
     // timebase_init(NULL);  // Moved to Core1
 
@@ -329,9 +351,14 @@ int main(void) {
     printf("[Core0] Initializing inter-core communication...\n");
     core_sync_init();
 
+    // Core0 cycle counter for per-command latency (Table 12) and profiler
+    timebase_cycle_counter_start();
+
     // Initialize NSP handler (RS-485, SLIP, NSP, command dispatch)
     printf("[Core0] Initializing NSP handler...\n");
-    nsp_handler_init(device_addr);
+    if (!nsp_handler_init(device_addr)) {
+        halt_nsp_init_failed(device_addr);
+    }
 
     printf("[Core0] Hardware initialization complete.\n");
     printf("\n");
@@ -349,11 +376,17 @@ int main(void) {
     }
     printf("[Core0] Core1 ready\n");
 
-    // Initialize commands module with wheel state pointer
-    // This MUST happen after Core1 has initialized g_wheel_state
-    commands_init(&g_wheel_state);
+    // Initialize commands module with the wheel state array
+    // This MUST happen after Core1 has initialized g_wheel_states
+    commands_init_wheels(g_wheel_states, EMULATED_WHEEL_COUNT);
     printf("[Core0] Commands module initialized\n");
 
+    if (quick) {
+        // Answer the OBC before anything else; nothing below touches RS-485
+        nsp_handler_start_service();
+        scenario_start_service();
+    }
+
     // Wait for first telemetry snapshot from Core1
     // This ensures TUI has valid data to display at startup
     printf("[Core0] Waiting for first telemetry...\n");
@@ -375,17 +408,31 @@ int main(void) {
     // ========================================================================
 
     test_results_init();
-    run_all_checkpoint_tests();
+
+    if (quick) {
+        // The loopback and NSP checkpoints drive RS-485 directly, so they
+        // cannot share the bus with the live service; only this build's
+        // cached results (re-verified without the bus) are shown
+        if (!run_cached_checkpoint_tests()) {
+            printf("[Core0] Fast boot: no cached results, checkpoint tests skipped\n");
+        }
+    } else {
+        // A fully passing earlier boot of this build saves the full run
+        if (!run_cached_checkpoint_tests()) {
+            run_all_checkpoint_tests();
+            test_results_save();
+        }
 
 #ifdef RUN_PHASE9_TESTS
-    // Run Phase 9 scenario engine tests
-    run_phase9_tests();
+        // Run Phase 9 scenario engine tests
+        run_phase9_tests();
 #endif
 
-    // Wait for user to acknowledge test results
-    printf("Waiting for keypress...\n");
-    while (getchar_timeout_us(0) == PICO_ERROR_TIMEOUT) {
-        sleep_ms(100);
+        // Wait for user to acknowledge test results
+        printf("Waiting for keypress...\n");
+        while (getchar_timeout_us(0) == PICO_ERROR_TIMEOUT) {
+            sleep_ms(100);
+        }
     }
 
     // ========================================================================
@@ -395,18 +442,30 @@ int main(void) {
     printf("\n");
     printf("[Core0] Initializing console & TUI...\n");
 
-    // Enable watchdog timer (8 second timeout for fault recovery)
-    // DISABLED: Uncomment after confirming system is stable on hardware
-    // Watchdog can prevent recovery if system is in boot loop
-    // watchdog_enable(8000, true);  // 8000ms, pause on debug
-    printf("[Core0] Watchdog DISABLED (enable after hardware validation)\n");
+    // Watchdog fed while both cores run; a reset from here on is a warm
+    // restart (a restart loop falls back to a cold boot)
+    warm_restart_start_watchdog();
 
-    // Initialize catalog (register tables)
+    // Load stored configuration, then set up the catalog (restores persistent fields)
+    config_store_init();
     catalog_init();
 
-    // Initialize TUI (clears screen, enters interactive mode)
+    // Scenarios running at a watchdog reset pick up where they were
+    warm_restart_resume_scenarios();
+
+    // Initialize TUI (clears screen, enters interactive mode); with no host
+    // on the console port it draws nothing until one connects
     tui_init();
 
+    if (!quick) {
+        // Hand NSP over to its IRQ-driven service so replies no longer wait
+        // for TUI redraws or the main loop sleep below
+        nsp_handler_start_service();
+
+        // Core1 rings Core0 when a conditional scenario trigger holds
+        scenario_start_service();
+    }
+
     // ========================================================================
     // MAIN LOOP: TUI Update
     // ========================================================================
@@ -416,8 +475,8 @@ int main(void) {
     bool led_state = false;
 
     while (1) {
-        // Update watchdog (disabled until hardware validation complete)
-        // watchdog_update();
+        // Core0 heartbeat for the watchdog feed
+        warm_restart_core0_beat();
 
         // Heartbeat LED: Toggle every 1 second (20 iterations × 50ms = 1000ms)
         if (heartbeat_counter++ >= 20) {
@@ -429,28 +488,47 @@ int main(void) {
         // Periodic TUI refresh: Every 500ms to update uptime
         if (tui_refresh_counter++ >= 10) {
             tui_refresh_counter = 0;
-            tui_update(true);  // Force periodic refresh for live values
+            tui_update(false);  // Rewrite changed live values
         }
 
         // Handle keyboard input
         if (tui_handle_input()) {
-            // Input was processed - force immediate redraw
-            tui_update(true);
+            // Input was processed - navigation redraws, typing updates in place
+            tui_update(false);
             tui_refresh_counter = 0;  // Reset periodic counter after input
         }
 
+        // Finish an update held back while the console port drained
+        tui_poll();
+
+        // Messages logged from the NSP service and Core1 since the last pass
+        dlog_drain(DLOG_DRAIN_BATCH);
+
         // Update scenario engine (check for event triggers)
         scenario_update();
 
+        // Timeline positions for a warm restart
+        warm_restart_poll();
+
+        // NSP trace dump on a new fault latch
+        check_fault_trace_dump();
+
+        // Cached test results (Table 1)
+        table_tests_update();
+
+        // Table updates below that take core_sync doorbells return at once
+        // when their inputs have not changed since the last pass
+
         // Update table values from scenario engine
         table_config_update();
         table_fault_injection_update();
 
         // Update Core1 telemetry snapshot (Table 10 and Table 4 both use this)
         table_core1_stats_update();
-        table_control_update();  // Keep control table in sync with telemetry
+        table_control_update();  // Control table: mode/setpoint/fault changes only
 
-        // Poll RS-485 for incoming NSP packets (non-blocking)
+        // NSP is serviced from its own IRQ; this only re-arms it if bytes
+        // are pending without a frame delimiter
         nsp_handler_poll();
 
         // Update serial layer stats (Table 2)
@@ -459,8 +537,51 @@ int main(void) {
         // Update NSP stats table (Table 3)
         table_nsp_update();
 
-        // Small delay to avoid busy-waiting
-        sleep_ms(50);  // 20 Hz update rate
+        // Update per-command latency table (Table 12)
+        table_cmd_stats_update();
+
+        // Update hot-path profiler table (Table 13)
+        table_profiler_update();
+
+        // Apply stream settings, refresh stream counters (Table 14)
+        table_stream_update();
+
+        // Flight recorder requests and capture summary (Table 15)
+        table_flight_rec_update();
+
+        // PPS enable and discipline statistics (Table 17)
+        table_timebase_update();
+
+        // Close the per-minute interval when due, refresh totals (Table 18)
+        stats_update(time_us_64());
+        table_stats_update();
+
+        // Load test: start on request, one sweep step per pass; replay (Table 19)
+        table_loadgen_update();
+
+        // Test-mode sequence requests and results (Table 16)
+        table_test_modes_update();
+
+        // Stack high-water marks and static RAM budget (Table 20)
+        table_mem_update();
+
+        // Limits and gains to the wheels, FAULT line delay, then commit
+        // persistent fields
+        // (coalesced: flash is written only after edits settle)
+        table_protection_limits_update();
+        table_protection_status_update();
+
+        // Parameter transaction held back while Core1 applied the last one
+        core_sync_params_poll();
+        catalog_save_persistent(time_us_64());
+
+        // Small delay to avoid busy-waiting (20 Hz update rate); batch mode
+        // answers commands as they arrive during it
+        if (batch_is_active()) {
+            batch_service(50000);
+        } else {
+            sleep_ms(50);
+        }
     }
 
     return 0;
@@ -0,0 +1,526 @@
+/**
+ * @file bench_main.c
+ * @brief NRWA-T6 Emulator - Hot-Path Microbenchmark Suite
+ *
+ * Times the protocol and physics hot paths one call at a time: CRC, SLIP
+ * encode/decode, NSP receive/parse/reply, each telemetry block builder,
+ * commands_dispatch() per command, wheel_model_tick() per control mode and
+ * the core_sync publish/read round trips.
+ *
+ * Each benchmark runs BENCH_SAMPLES timed calls with interrupts masked.
+ * Inputs are reset before every call (outside the timed window), the
+ * timer read overhead is measured once and subtracted, and min / median /
+ * max are reported. The median is the figure to track across versions.
+ *
+ * On the RP2040 the unit is processor cycles (SysTick, see
+ * timebase_cycle_counter_start()); the host build reports nanoseconds.
+ *
+ * Report (between the BENCH-BEGIN / BENCH-END lines, CSV in between):
+ *   BENCH-BEGIN version=<git> unit=cycles clock_hz=125000000 wheels=1 tick_hz=100 samples=64
+ *   bench,bytes,min,median,max,per_byte,ok
+ *   crc_ccitt,256,2571,2573,2610,10.05,1
+ *   ...
+ *   BENCH-END count=<rows>
+ *
+ * per_byte is median / bytes (empty for benchmarks that are not byte
+ * oriented); ok = 0 means the call returned a wrong result.
+ * tools/bench_compare.py diffs two reports.
+ */
+
+#include "board_pico.h"
+#include "timebase.h"
+#include "crc_ccitt.h"
+#include "slip.h"
+#include "nsp.h"
+#include "nss_nrwa_t6_engine.h"
+#include "nss_nrwa_t6_commands.h"
+#include "nss_nrwa_t6_telemetry.h"
+#include "nss_nrwa_t6_regs.h"
+#include "util/core_sync.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifndef NRWA_HOST
+#include "hardware/clocks.h"
+#include "pico/stdio_usb.h"
+#include "clock_profile.h"
+#endif
+
+// Firmware version (passed from CMake)
+#ifndef FIRMWARE_VERSION
+#define FIRMWARE_VERSION "v0.1.0-unknown"
+#endif
+
+/** Timed calls per benchmark */
+#define BENCH_SAMPLES           64
+
+/** Payload size of the byte-oriented benchmarks (CRC, SLIP) */
+#define BENCH_PAYLOAD_LEN       256
+
+/** Ticks run before sampling a control mode (settles the loop) */
+#define BENCH_SETTLE_TICKS      200
+
+#ifdef NRWA_HOST
+#define BENCH_UNIT              "ns"
+#else
+#define BENCH_UNIT              "cycles"
+#endif
+
+// ============================================================================
+// Benchmark Table Types
+// ============================================================================
+
+/**
+ * @brief One benchmark
+ *
+ * prep() restores the inputs before every sample (untimed); op() is the
+ * timed call and returns false if its result is wrong.
+ */
+typedef struct {
+    const char* name;
+    uint32_t bytes;                 // Bytes processed per call (0 = not byte oriented)
+    void (*prep)(const void* arg);  // NULL = nothing to restore
+    bool (*op)(const void* arg);
+    const void* arg;
+} bench_case_t;
+
+/**
+ * @brief One commands_dispatch() request
+ */
+typedef struct {
+    uint8_t command;
+    uint8_t payload[8];
+    uint16_t payload_len;
+    cmd_response_t expect;
+} bench_cmd_t;
+
+// ============================================================================
+// Global State
+// ============================================================================
+
+wheel_state_t g_wheel_states[EMULATED_WHEEL_COUNT];
+
+static uint32_t samples[BENCH_SAMPLES];
+static uint32_t timer_overhead = 0;
+
+// Shared inputs and outputs
+static uint8_t payload[BENCH_PAYLOAD_LEN];
+static uint16_t payload_crc;
+static uint8_t slip_frame[BENCH_PAYLOAD_LEN * 2 + 2];
+static size_t slip_frame_len;
+static uint8_t out_buf[BENCH_PAYLOAD_LEN * 2 + 2];
+static slip_decoder_t slip_dec;
+
+static uint8_t nsp_frame[NSP_MAX_PACKET_SIZE];       // APP-TELEM request, unescaped
+static size_t nsp_frame_len;
+static uint8_t nsp_frame_slip[NSP_MAX_PACKET_SIZE * 2 + 2];
+static size_t nsp_frame_slip_len;
+static nsp_rx_t nsp_rx;
+static nsp_packet_t nsp_packet;
+static nsp_view_t nsp_view;
+static uint8_t reply_data[TELEM_MAX_BLOCK_SIZE];
+
+static wheel_state_t mode_template[4];
+static wheel_state_t bench_wheel;
+static telemetry_snapshot_t snapshot;
+
+// ============================================================================
+// Inputs
+// ============================================================================
+
+/**
+ * @brief Fill the payload with a fixed pseudo-random pattern
+ *
+ * Same bytes on every run and build (xorshift32, fixed seed), so SLIP
+ * escape counts and therefore timings are comparable.
+ */
+static void make_payload(void) {
+    uint32_t x = 0x2545F491u;
+    for (size_t i = 0; i < BENCH_PAYLOAD_LEN; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        payload[i] = (uint8_t)x;
+    }
+    payload_crc = crc_ccitt_update_bitwise(CRC_CCITT_INIT, payload, BENCH_PAYLOAD_LEN);
+    slip_encode(payload, BENCH_PAYLOAD_LEN, slip_frame, &slip_frame_len);
+}
+
+/**
+ * @brief Build an APP-TELEM (STANDARD block) request addressed to wheel 0
+ */
+static void make_nsp_request(uint8_t device_addr) {
+    nsp_frame[0] = device_addr;
+    nsp_frame[1] = 0x11;
+    nsp_frame[2] = nsp_make_ctrl(true, false, false, NSP_CMD_APPLICATION_TELEMETRY);
+    nsp_frame[3] = TELEM_BLOCK_STANDARD;
+    nsp_frame_len = crc_ccitt_append(nsp_frame, 4);
+    slip_encode(nsp_frame, nsp_frame_len, nsp_frame_slip, &nsp_frame_slip_len);
+}
+
+/**
+ * @brief Settle one wheel per control mode (setpoints stay below overspeed)
+ */
+static void make_mode_templates(void) {
+    for (uint32_t m = 0; m < 4; m++) {
+        wheel_state_t* ws = &mode_template[m];
+        wheel_model_init(ws);
+        switch ((control_mode_t)m) {
+            case CONTROL_MODE_CURRENT: wheel_model_set_current(ws, 0.1f); break;
+            case CONTROL_MODE_SPEED:   wheel_model_set_speed(ws, 1000.0f); break;
+            case CONTROL_MODE_TORQUE:  wheel_model_set_torque(ws, 10.0f); break;
+            case CONTROL_MODE_PWM:     wheel_model_set_pwm(ws, 5.0f); break;
+        }
+        wheel_model_set_mode(ws, (control_mode_t)m);
+        for (uint32_t t = 0; t < BENCH_SETTLE_TICKS; t++) {
+            wheel_model_tick(ws);
+        }
+    }
+}
+
+// ============================================================================
+// Benchmark Bodies
+// ============================================================================
+
+typedef uint16_t (*crc_fn_t)(uint16_t crc, const uint8_t* data, size_t len);
+
+static const crc_fn_t crc_default = crc_ccitt_update;
+static const crc_fn_t crc_bitwise = crc_ccitt_update_bitwise;
+static const crc_fn_t crc_table = crc_ccitt_update_table;
+static const crc_fn_t crc_dma = crc_ccitt_update_dma;
+
+static bool op_empty(const void* arg) {
+    (void)arg;
+    return true;
+}
+
+static bool op_crc(const void* arg) {
+    crc_fn_t fn = *(const crc_fn_t*)arg;
+    return fn(CRC_CCITT_INIT, payload, BENCH_PAYLOAD_LEN) == payload_crc;
+}
+
+static bool op_slip_encode(const void* arg) {
+    (void)arg;
+    size_t len = 0;
+    return slip_encode(payload, BENCH_PAYLOAD_LEN, out_buf, &len) && len == slip_frame_len;
+}
+
+static void prep_slip_decode(const void* arg) {
+    (void)arg;
+    slip_decoder_init(&slip_dec);
+}
+
+static bool op_slip_decode(const void* arg) {
+    (void)arg;
+    size_t len = 0;
+    bool done = false;
+    for (size_t i = 0; i < slip_frame_len; i++) {
+        done = slip_decode_byte(&slip_dec, slip_frame[i], out_buf, &len);
+    }
+    return done && len == BENCH_PAYLOAD_LEN;
+}
+
+static bool op_nsp_parse(const void* arg) {
+    (void)arg;
+    return nsp_parse(nsp_frame, nsp_frame_len, &nsp_packet) == NSP_OK;
+}
+
+static bool op_nsp_parse_view(const void* arg) {
+    (void)arg;
+    return nsp_parse_view(nsp_frame, nsp_frame_len, &nsp_view) == NSP_OK;
+}
+
+static void prep_nsp_rx(const void* arg) {
+    (void)arg;
+    nsp_rx_init(&nsp_rx, nsp_frame[0]);
+}
+
+static bool op_nsp_rx(const void* arg) {
+    (void)arg;
+    nsp_rx_event_t ev = NSP_RX_NONE;
+    for (size_t i = 0; i < nsp_frame_slip_len; i++) {
+        ev = nsp_rx_byte(&nsp_rx, nsp_frame_slip[i]);
+    }
+    return ev == NSP_RX_FRAME;
+}
+
+static bool op_nsp_reply(const void* arg) {
+    (void)arg;
+    size_t len = 0;
+    return nsp_encode_reply_slip(&nsp_view, true, reply_data, sizeof(reply_data),
+                                 out_buf, sizeof(out_buf), &len);
+}
+
+typedef uint16_t (*telem_fn_t)(const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size);
+
+static const telem_fn_t telem_standard = telemetry_build_standard;
+static const telem_fn_t telem_temperatures = telemetry_build_temperatures;
+static const telem_fn_t telem_voltages = telemetry_build_voltages;
+static const telem_fn_t telem_currents = telemetry_build_currents;
+static const telem_fn_t telem_diagnostics = telemetry_build_diagnostics;
+
+static bool op_telem(const void* arg) {
+    telem_fn_t fn = *(const telem_fn_t*)arg;
+    return fn(&mode_template[CONTROL_MODE_SPEED], out_buf, sizeof(out_buf)) > 0;
+}
+
+static void prep_cmd(const void* arg) {
+    (void)arg;
+    // No Core1 here: drop whatever the previous call queued
+    command_mailbox_t cmd;
+    while (core_sync_read_command(&cmd)) {
+    }
+}
+
+static bool op_cmd(const void* arg) {
+    const bench_cmd_t* c = (const bench_cmd_t*)arg;
+    cmd_result_t result;
+    return commands_dispatch(c->command, c->payload, c->payload_len, &result) &&
+           result.status == c->expect;
+}
+
+static void prep_multi_telem(const void* arg) {
+    prep_cmd(arg);
+    commands_set_multi_telem_enabled(true);
+}
+
+static void prep_tick(const void* arg) {
+    bench_wheel = mode_template[*(const control_mode_t*)arg];
+}
+
+static bool op_tick(const void* arg) {
+    (void)arg;
+    wheel_model_tick(&bench_wheel);
+    return !wheel_model_has_faults(&bench_wheel);
+}
+
+static bool op_snapshot_round_trip(const void* arg) {
+    (void)arg;
+    telemetry_snapshot_t copy;
+    core_sync_publish_wheel_telemetry(0, &snapshot);
+    return core_sync_read_wheel_telemetry(0, &copy) && copy.tick_count == snapshot.tick_count;
+}
+
+static bool op_blocks_round_trip(const void* arg) {
+    (void)arg;
+    uint16_t len = 0;
+    core_sync_publish_wheel_blocks(0);
+    return core_sync_read_wheel_block(0, TELEM_BLOCK_STANDARD, reply_data, sizeof(reply_data), &len, NULL);
+}
+
+// ============================================================================
+// Benchmark Table
+// ============================================================================
+
+#define U32LE(v) (uint8_t)(v), (uint8_t)((v) >> 8), (uint8_t)((v) >> 16), (uint8_t)((v) >> 24)
+
+static const bench_cmd_t cmd_ping_req     = { NSP_CMD_PING, { 0 }, 0, CMD_ACK };
+static const bench_cmd_t cmd_peek_req     = { NSP_CMD_PEEK, { ICD_REG_DEVICE_ID, ICD_REG_COUNT }, 2, CMD_ACK };
+static const bench_cmd_t cmd_poke_req     = { NSP_CMD_POKE, { ICD_REG_SPEED_SETPOINT, U32LE(1000u << 18) }, 5, CMD_ACK };
+static const bench_cmd_t cmd_telem_std    = { NSP_CMD_APPLICATION_TELEMETRY, { TELEM_BLOCK_STANDARD }, 1, CMD_ACK };
+static const bench_cmd_t cmd_telem_temp   = { NSP_CMD_APPLICATION_TELEMETRY, { TELEM_BLOCK_TEMPERATURES }, 1, CMD_ACK };
+static const bench_cmd_t cmd_telem_volt   = { NSP_CMD_APPLICATION_TELEMETRY, { TELEM_BLOCK_VOLTAGES }, 1, CMD_ACK };
+static const bench_cmd_t cmd_telem_curr   = { NSP_CMD_APPLICATION_TELEMETRY, { TELEM_BLOCK_CURRENTS }, 1, CMD_ACK };
+static const bench_cmd_t cmd_telem_diag   = { NSP_CMD_APPLICATION_TELEMETRY, { TELEM_BLOCK_DIAGNOSTICS }, 1, CMD_ACK };
+static const bench_cmd_t cmd_app_cmd_req  = { NSP_CMD_APPLICATION_COMMAND, { ICD_MODE_SPEED, U32LE(1000u << 18) }, 5, CMD_ACK };
+static const bench_cmd_t cmd_clear_req    = { NSP_CMD_CLEAR_FAULT, { U32LE(0xFFFFFFFFu) }, 4, CMD_ACK };
+static const bench_cmd_t cmd_protect_req  = { NSP_CMD_CONFIGURE_PROTECTION, { U32LE(0u) }, 4, CMD_ACK };
+static const bench_cmd_t cmd_trip_req     = { NSP_CMD_TRIP_LCL, { 0 }, 0, CMD_NO_REPLY };
+static const bench_cmd_t cmd_step_req     = { NSP_CMD_SIM_STEP, { 0 }, 0, CMD_ACK };  // Query only
+static const bench_cmd_t cmd_multi_all    = { NSP_CMD_MULTI_TELEMETRY, { (1u << TELEM_BLOCK_COUNT) - 1u }, 1, CMD_ACK };
+
+static const control_mode_t mode_current = CONTROL_MODE_CURRENT;
+static const control_mode_t mode_speed = CONTROL_MODE_SPEED;
+static const control_mode_t mode_torque = CONTROL_MODE_TORQUE;
+static const control_mode_t mode_pwm = CONTROL_MODE_PWM;
+
+/** Row order is the report order; append new benchmarks at the end */
+static const bench_case_t bench_cases[] = {
+    { "crc_ccitt",              BENCH_PAYLOAD_LEN, NULL, op_crc, &crc_default },
+    { "crc_ccitt_bitwise",      BENCH_PAYLOAD_LEN, NULL, op_crc, &crc_bitwise },
+    { "crc_ccitt_table",        BENCH_PAYLOAD_LEN, NULL, op_crc, &crc_table },
+    { "crc_ccitt_dma",          BENCH_PAYLOAD_LEN, NULL, op_crc, &crc_dma },
+    { "slip_encode",            BENCH_PAYLOAD_LEN, NULL, op_slip_encode, NULL },
+    { "slip_decode",            BENCH_PAYLOAD_LEN, prep_slip_decode, op_slip_decode, NULL },
+    { "nsp_rx_frame",           0, prep_nsp_rx, op_nsp_rx, NULL },
+    { "nsp_parse",              0, NULL, op_nsp_parse, NULL },
+    { "nsp_parse_view",         0, NULL, op_nsp_parse_view, NULL },
+    { "nsp_encode_reply_slip",  0, NULL, op_nsp_reply, NULL },
+    { "telemetry_build_standard",     0, NULL, op_telem, &telem_standard },
+    { "telemetry_build_temperatures", 0, NULL, op_telem, &telem_temperatures },
+    { "telemetry_build_voltages",     0, NULL, op_telem, &telem_voltages },
+    { "telemetry_build_currents",     0, NULL, op_telem, &telem_currents },
+    { "telemetry_build_diagnostics",  0, NULL, op_telem, &telem_diagnostics },
+    { "cmd_ping",               0, prep_cmd, op_cmd, &cmd_ping_req },
+    { "cmd_peek",               0, prep_cmd, op_cmd, &cmd_peek_req },
+    { "cmd_poke",               0, prep_cmd, op_cmd, &cmd_poke_req },
+    { "cmd_app_telem_standard", 0, prep_cmd, op_cmd, &cmd_telem_std },
+    { "cmd_app_telem_temperatures", 0, prep_cmd, op_cmd, &cmd_telem_temp },
+    { "cmd_app_telem_voltages", 0, prep_cmd, op_cmd, &cmd_telem_volt },
+    { "cmd_app_telem_currents", 0, prep_cmd, op_cmd, &cmd_telem_curr },
+    { "cmd_app_telem_diagnostics", 0, prep_cmd, op_cmd, &cmd_telem_diag },
+    { "cmd_app_command",        0, prep_cmd, op_cmd, &cmd_app_cmd_req },
+    { "cmd_clear_fault",        0, prep_cmd, op_cmd, &cmd_clear_req },
+    { "cmd_configure_protection", 0, prep_cmd, op_cmd, &cmd_protect_req },
+    { "cmd_trip_lcl",           0, prep_cmd, op_cmd, &cmd_trip_req },
+    { "cmd_sim_step",           0, prep_cmd, op_cmd, &cmd_step_req },
+    { "wheel_model_tick_current", 0, prep_tick, op_tick, &mode_current },
+    { "wheel_model_tick_speed", 0, prep_tick, op_tick, &mode_speed },
+    { "wheel_model_tick_torque", 0, prep_tick, op_tick, &mode_torque },
+    { "wheel_model_tick_pwm",   0, prep_tick, op_tick, &mode_pwm },
+    { "core_sync_snapshot_rt",  0, NULL, op_snapshot_round_trip, NULL },
+    { "core_sync_blocks_rt",    0, NULL, op_blocks_round_trip, NULL },
+    { "cmd_multi_telem_all",    0, prep_multi_telem, op_cmd, &cmd_multi_all },
+};
+
+#define BENCH_CASE_COUNT (sizeof(bench_cases) / sizeof(bench_cases[0]))
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+/**
+ * @brief Time BENCH_SAMPLES calls, sorted ascending into samples[]
+ *
+ * @return true if every call returned a correct result
+ */
+static bool bench_sample(const bench_case_t* c) {
+    bool ok = true;
+
+    for (uint32_t s = 0; s < BENCH_SAMPLES; s++) {
+        if (c->prep) {
+            c->prep(c->arg);
+        }
+        uint32_t irq = save_and_disable_interrupts();
+        uint32_t t0 = timebase_get_cycles();
+        bool good = c->op(c->arg);
+        uint32_t t1 = timebase_get_cycles();
+        restore_interrupts(irq);
+
+        uint32_t dt = (t1 - t0) & TIMEBASE_CYCLE_MASK;
+        samples[s] = (dt > timer_overhead) ? dt - timer_overhead : 0;
+        ok = ok && good;
+    }
+
+    // Insertion sort (64 entries)
+    for (uint32_t i = 1; i < BENCH_SAMPLES; i++) {
+        uint32_t v = samples[i];
+        uint32_t j = i;
+        while (j > 0 && samples[j - 1] > v) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = v;
+    }
+    return ok;
+}
+
+/**
+ * @brief Run every benchmark and print the report
+ */
+static void bench_run_all(void) {
+    static const bench_case_t empty = { "empty", 0, NULL, op_empty, NULL };
+    bool dma_ok = crc_ccitt_dma_init();
+    uint32_t rows = 0;
+
+    timer_overhead = 0;
+    bench_sample(&empty);
+    timer_overhead = samples[0];
+
+#ifdef NRWA_HOST
+    uint32_t clock_hz = 0;
+#else
+    uint32_t clock_hz = clock_get_hz(clk_sys);
+#endif
+
+    printf("BENCH-BEGIN version=%s unit=%s clock_hz=%lu wheels=%u tick_hz=%u samples=%u\n",
+           FIRMWARE_VERSION, BENCH_UNIT, (unsigned long)clock_hz, (unsigned)EMULATED_WHEEL_COUNT,
+           (unsigned)PHYSICS_TICK_RATE_HZ, (unsigned)BENCH_SAMPLES);
+    printf("bench,bytes,min,median,max,per_byte,ok\n");
+
+    for (uint32_t i = 0; i < BENCH_CASE_COUNT; i++) {
+        const bench_case_t* c = &bench_cases[i];
+        if (c->arg == &crc_dma && !dma_ok) {
+            continue;   // No DMA channel (host build)
+        }
+
+        bool ok = bench_sample(c);
+        uint32_t median = samples[BENCH_SAMPLES / 2];
+        printf("%s,%lu,%lu,%lu,%lu,", c->name, (unsigned long)c->bytes,
+               (unsigned long)samples[0], (unsigned long)median,
+               (unsigned long)samples[BENCH_SAMPLES - 1]);
+        if (c->bytes > 0) {
+            // Two decimals without float formatting
+            uint32_t x100 = (median * 100u + c->bytes / 2u) / c->bytes;
+            printf("%lu.%02lu", (unsigned long)(x100 / 100u), (unsigned long)(x100 % 100u));
+        }
+        printf(",%u\n", ok ? 1u : 0u);
+        rows++;
+    }
+
+    printf("BENCH-END count=%lu\n", (unsigned long)rows);
+}
+
+/**
+ * @brief Bring up the modules the benchmarks call into
+ */
+static void bench_init(void) {
+    core_sync_init();
+    timebase_cycle_counter_start();
+
+    physics_engine_init(g_wheel_states, NULL);
+    commands_init_wheels(g_wheel_states, EMULATED_WHEEL_COUNT);
+    nsp_init(0);
+
+    // A few ticks publish snapshots and encoded blocks for PEEK/APP-TELEM
+    for (uint32_t t = 0; t < 4; t++) {
+        physics_engine_tick(0);
+        physics_engine_idle();
+    }
+
+    make_payload();
+    make_nsp_request(0);
+    nsp_parse_view(nsp_frame, nsp_frame_len, &nsp_view);
+    make_mode_templates();
+    core_sync_read_wheel_telemetry(0, &snapshot);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+#ifdef NRWA_HOST
+
+int main(void) {
+    bench_init();
+    bench_run_all();
+    return 0;
+}
+
+#else
+
+int main(void) {
+    // Same clock profile as the emulator build (clock_hz in the header)
+    clock_profile_apply(CLOCK_PROFILE_DEFAULT);
+    stdio_init_all();
+
+    // Report goes to the console port: wait for a host to open it
+    while (!stdio_usb_connected()) {
+        sleep_ms(100);
+    }
+    sleep_ms(500);
+
+    bench_init();
+    bench_run_all();
+
+    printf("Press 'r' to run again\n");
+    while (true) {
+        int c = getchar_timeout_us(100000);
+        if (c == 'r' || c == 'R') {
+            bench_run_all();
+        }
+    }
+}
+
+#endif
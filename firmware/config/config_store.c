@@ -0,0 +1,334 @@
+/**
+ * @file config_store.c
+ * @brief Persistent Configuration Store Implementation
+ */
+
+#include "config_store.h"
+#include "board_pico.h"
+#include "crc_ccitt.h"
+#include "../util/flash_store.h"
+#include "pico/time.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_SECTORS         (FLASH_CONFIG_SIZE / FLASH_SECTOR_SIZE)
+#define LOG_MAGIC           0x4746434Eu     // "NCFG"
+#define KEY_INVALID         0x0000u         // Record cleared to zero: ignored
+#define KEY_ERASED          0xFFFFu
+
+_Static_assert(FLASH_SECTOR_SIZE == FLASH_STORE_SECTOR_SIZE, "flash sector size mismatch");
+_Static_assert(LOG_SECTORS >= 2, "compaction needs a second sector");
+_Static_assert(CONFIG_STORE_MAX_KEYS <= 32, "dirty keys are a 32-bit mask");
+
+/**
+ * @brief Sector header (generation_inv = ~generation)
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t generation;
+    uint32_t generation_inv;
+    uint32_t reserved;
+} log_header_t;
+
+/**
+ * @brief One log record (crc over key and value)
+ */
+typedef struct {
+    uint16_t key;
+    uint16_t crc;
+    uint32_t value;
+} log_record_t;
+
+#define RECORDS_START       sizeof(log_header_t)
+
+_Static_assert(sizeof(log_record_t) == 8, "record layout");
+_Static_assert(CONFIG_STORE_MAX_KEYS * sizeof(log_record_t) <= FLASH_STORE_PAGE_SIZE,
+               "a commit spans at most two pages");
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+// RAM index: the latest value of every key
+static uint16_t index_keys[CONFIG_STORE_MAX_KEYS];
+static uint32_t index_values[CONFIG_STORE_MAX_KEYS];
+static uint32_t index_count = 0;
+static uint32_t dirty_mask = 0;
+
+// Active log
+static int32_t active_sector = -1;          // -1 = no valid log
+static uint32_t generation = 0;
+static uint32_t write_pos = RECORDS_START;  // Next free record (byte offset in the sector)
+
+// Commit coalescing
+static uint64_t last_change_us = 0;
+static uint64_t last_commit_us = 0;
+static bool committed = false;
+
+static config_store_stats_t stats;
+
+// Program buffers (flash_store needs the source in RAM)
+static uint8_t page_buf[2 * FLASH_STORE_PAGE_SIZE];
+static uint8_t compact_buf[RECORDS_START + CONFIG_STORE_MAX_KEYS * sizeof(log_record_t)];
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint32_t sector_offset(int32_t sector) {
+    return FLASH_CONFIG_OFFSET + (uint32_t)sector * FLASH_SECTOR_SIZE;
+}
+
+static uint16_t record_crc(uint16_t key, uint32_t value) {
+    uint8_t bytes[6] = {
+        (uint8_t)key, (uint8_t)(key >> 8),
+        (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24),
+    };
+    return crc_ccitt_calculate(bytes, sizeof(bytes));
+}
+
+static void make_record(log_record_t* rec, uint32_t slot) {
+    rec->key = index_keys[slot];
+    rec->value = index_values[slot];
+    rec->crc = record_crc(rec->key, rec->value);
+}
+
+static int32_t index_find(uint16_t key) {
+    for (uint32_t i = 0; i < index_count; i++) {
+        if (index_keys[i] == key) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+static void index_put(uint16_t key, uint32_t value) {
+    int32_t slot = index_find(key);
+    if (slot < 0) {
+        if (index_count == CONFIG_STORE_MAX_KEYS) {
+            return;
+        }
+        slot = (int32_t)index_count++;
+        index_keys[slot] = key;
+    }
+    index_values[slot] = value;
+}
+
+static bool header_valid(const log_header_t* hdr) {
+    return hdr->magic == LOG_MAGIC && hdr->generation == ~hdr->generation_inv;
+}
+
+// ============================================================================
+// Log Writes
+// ============================================================================
+
+/**
+ * @brief Append the changed keys to the active log
+ */
+static bool append_dirty(uint32_t count) {
+    uint32_t page_base = write_pos & ~(FLASH_STORE_PAGE_SIZE - 1u);
+    uint32_t end = write_pos + count * (uint32_t)sizeof(log_record_t);
+    uint32_t len = (end - page_base + FLASH_STORE_PAGE_SIZE - 1u) & ~(FLASH_STORE_PAGE_SIZE - 1u);
+
+    // 0xFF leaves the records already in the page as programmed
+    memset(page_buf, 0xFF, sizeof(page_buf));
+    uint32_t pos = write_pos - page_base;
+    for (uint32_t i = 0; i < index_count; i++) {
+        if (dirty_mask & (1u << i)) {
+            make_record((log_record_t*)&page_buf[pos], i);
+            pos += sizeof(log_record_t);
+        }
+    }
+
+    if (!flash_store_program(sector_offset(active_sector) + page_base, page_buf, len)) {
+        return false;
+    }
+    write_pos = end;
+    return true;
+}
+
+/**
+ * @brief Write every key to the next sector and make it the active log
+ */
+static bool compact(void) {
+    int32_t next = (active_sector < 0) ? 0 : (active_sector + 1) % LOG_SECTORS;
+    uint32_t len = RECORDS_START + index_count * (uint32_t)sizeof(log_record_t);
+
+    // Records first, header left erased
+    memset(compact_buf, 0xFF, sizeof(compact_buf));
+    for (uint32_t i = 0; i < index_count; i++) {
+        make_record((log_record_t*)&compact_buf[RECORDS_START + i * sizeof(log_record_t)], i);
+    }
+    if (!flash_store_write(sector_offset(next), compact_buf, len)) {
+        return false;
+    }
+
+    // Header last: until it is programmed the old log stays active
+    memset(page_buf, 0xFF, FLASH_STORE_PAGE_SIZE);
+    log_header_t* hdr = (log_header_t*)page_buf;
+    hdr->magic = LOG_MAGIC;
+    hdr->generation = generation + 1;
+    hdr->generation_inv = ~hdr->generation;
+    hdr->reserved = 0xFFFFFFFFu;
+    if (!flash_store_program(sector_offset(next), page_buf, FLASH_STORE_PAGE_SIZE)) {
+        return false;
+    }
+
+    active_sector = next;
+    generation++;
+    write_pos = len;
+    stats.compactions++;
+    return true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+uint32_t config_store_init(void) {
+    uint32_t start = time_us_32();
+    index_count = 0;
+    dirty_mask = 0;
+    active_sector = -1;
+    generation = 0;
+    write_pos = RECORDS_START;
+
+    // Active log: valid header with the highest generation
+    for (int32_t s = 0; s < LOG_SECTORS; s++) {
+        log_header_t hdr;
+        memcpy(&hdr, FLASH_STORE_XIP(sector_offset(s)), sizeof(hdr));
+        if (header_valid(&hdr) &&
+            (active_sector < 0 || (int32_t)(hdr.generation - generation) > 0)) {
+            active_sector = s;
+            generation = hdr.generation;
+        }
+    }
+
+    if (active_sector >= 0) {
+        // Records are appended in order: the first erased slot ends the log
+        const uint8_t* base = FLASH_STORE_XIP(sector_offset(active_sector));
+        uint32_t pos = RECORDS_START;
+        while (pos + sizeof(log_record_t) <= FLASH_SECTOR_SIZE) {
+            log_record_t rec;
+            memcpy(&rec, base + pos, sizeof(rec));
+            if (rec.key == KEY_ERASED && rec.crc == 0xFFFFu && rec.value == 0xFFFFFFFFu) {
+                break;
+            }
+            if (rec.key != KEY_INVALID && rec.key != KEY_ERASED &&
+                rec.crc == record_crc(rec.key, rec.value)) {
+                index_put(rec.key, rec.value);
+            }
+            pos += sizeof(log_record_t);
+        }
+        write_pos = pos;
+    }
+
+    stats.scan_us = time_us_32() - start;
+    if (active_sector >= 0) {
+        printf("[CONFIG] Restored %lu keys (log generation %lu, %lu B used, scan %lu us)\n",
+               (unsigned long)index_count, (unsigned long)generation,
+               (unsigned long)write_pos, (unsigned long)stats.scan_us);
+    } else {
+        printf("[CONFIG] No stored configuration (defaults)\n");
+    }
+    return index_count;
+}
+
+bool config_store_get(uint16_t key, uint32_t* value) {
+    int32_t slot = index_find(key);
+    if (slot < 0 || !value) {
+        return false;
+    }
+    *value = index_values[slot];
+    return true;
+}
+
+bool config_store_set(uint16_t key, uint32_t value, uint64_t now_us) {
+    if (key == KEY_INVALID || key == KEY_ERASED) {
+        return false;
+    }
+
+    int32_t slot = index_find(key);
+    if (slot >= 0 && index_values[slot] == value) {
+        return true;
+    }
+    if (slot < 0) {
+        if (index_count == CONFIG_STORE_MAX_KEYS) {
+            return false;
+        }
+        slot = (int32_t)index_count++;
+        index_keys[slot] = key;
+    }
+
+    index_values[slot] = value;
+    dirty_mask |= 1u << slot;
+    last_change_us = now_us;
+    return true;
+}
+
+bool config_store_service(uint64_t now_us) {
+    if (dirty_mask == 0 ||
+        now_us - last_change_us < (uint64_t)CONFIG_STORE_COMMIT_DELAY_MS * 1000u ||
+        (committed && now_us - last_commit_us < (uint64_t)CONFIG_STORE_MIN_INTERVAL_MS * 1000u)) {
+        return false;
+    }
+
+    // A refused write is retried after the interval too: writes stay bounded
+    committed = true;
+    last_commit_us = now_us;
+    return config_store_commit();
+}
+
+bool config_store_commit(void) {
+    if (dirty_mask == 0) {
+        return true;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < index_count; i++) {
+        count += (dirty_mask >> i) & 1u;
+    }
+
+    bool fits = active_sector >= 0 &&
+                write_pos + count * sizeof(log_record_t) <= FLASH_SECTOR_SIZE;
+    if (!(fits ? append_dirty(count) : compact())) {
+        stats.failures++;
+        printf("[CONFIG] Commit failed (flash write refused)\n");
+        return false;
+    }
+
+    dirty_mask = 0;
+    stats.commits++;
+    return true;
+}
+
+bool config_store_erase(void) {
+    for (int32_t s = 0; s < LOG_SECTORS; s++) {
+        if (!flash_store_write(sector_offset(s), NULL, 0)) {
+            stats.failures++;
+            return false;
+        }
+    }
+
+    index_count = 0;
+    dirty_mask = 0;
+    active_sector = -1;
+    generation = 0;
+    write_pos = RECORDS_START;
+    printf("[CONFIG] Stored configuration erased (defaults after reset)\n");
+    return true;
+}
+
+void config_store_get_stats(config_store_stats_t* out) {
+    if (!out) {
+        return;
+    }
+    *out = stats;
+    out->keys = index_count;
+    out->dirty = 0;
+    for (uint32_t i = 0; i < index_count; i++) {
+        out->dirty += (dirty_mask >> i) & 1u;
+    }
+    out->generation = generation;
+    out->used_bytes = (active_sector >= 0) ? write_pos : 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file config_store.h
+ * @brief Persistent Configuration Store in Flash
+ *
+ * Log-structured key/value store for configuration that must survive a
+ * reset (catalog fields marked persistent, keyed by field ID). It lives in
+ * the partition reserved by FLASH_CONFIG_OFFSET / FLASH_CONFIG_SIZE
+ * (board_pico.h), one log per 4 KB sector:
+ *
+ * - A sector starts with a header (magic, generation); the sector with the
+ *   highest valid generation is the active log.
+ * - Records (key, CRC, value; 8 bytes) are appended in order, by page
+ *   programs that leave the earlier records of the page untouched. The
+ *   last record of a key wins.
+ * - When the active sector is full, the latest value of every key is
+ *   compacted into the next sector with the next generation, round robin,
+ *   so erases spread evenly over the partition. The header is programmed
+ *   last: a compaction cut short by a reset leaves the old log active.
+ *
+ * Boot reads the sector headers and scans the active log once, up to its
+ * first erased slot, into a RAM index; lookups never touch flash again.
+ * A record with a bad CRC (write cut short) is skipped.
+ *
+ * Writes are coalesced: config_store_set() only updates the index, and
+ * config_store_service() commits every changed key in one page program
+ * once no change has arrived for CONFIG_STORE_COMMIT_DELAY_MS, and at most
+ * once every CONFIG_STORE_MIN_INTERVAL_MS. Core0 only (flash_store.h).
+ */
+
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Distinct keys the store holds */
+#define CONFIG_STORE_MAX_KEYS           32
+
+/** Quiet time after the last change before it is committed (ms) */
+#define CONFIG_STORE_COMMIT_DELAY_MS    2000
+
+/** Least time between two commits (ms) */
+#define CONFIG_STORE_MIN_INTERVAL_MS    30000
+
+/**
+ * @brief Store statistics
+ */
+typedef struct {
+    uint32_t keys;              // Keys held
+    uint32_t dirty;             // Keys changed since the last commit
+    uint32_t generation;        // Generation of the active log (0 = empty store)
+    uint32_t used_bytes;        // Bytes used in the active sector
+    uint32_t scan_us;           // Boot scan time
+    uint32_t commits;           // Commits since boot
+    uint32_t compactions;       // Sector erases since boot
+    uint32_t failures;          // Flash operations refused
+} config_store_stats_t;
+
+/**
+ * @brief Find the active log and build the index
+ *
+ * @return Number of keys restored
+ */
+uint32_t config_store_init(void);
+
+/**
+ * @brief Look up a key
+ *
+ * @param key Key (field ID, not 0 or 0xFFFF)
+ * @param value Output: stored value
+ * @return false if the key has never been stored
+ */
+bool config_store_get(uint16_t key, uint32_t* value);
+
+/**
+ * @brief Set a key (RAM only; committed by config_store_service())
+ *
+ * @param key Key (field ID, not 0 or 0xFFFF)
+ * @param value New value
+ * @param now_us Current time (restarts the commit delay on a change)
+ * @return false if the key is invalid or the store is full
+ */
+bool config_store_set(uint16_t key, uint32_t value, uint64_t now_us);
+
+/**
+ * @brief Commit changed keys when the coalescing delays allow it
+ *
+ * Call from the Core0 main loop.
+ *
+ * @param now_us Current time
+ * @return true if a commit was made
+ */
+bool config_store_service(uint64_t now_us);
+
+/**
+ * @brief Commit changed keys now
+ *
+ * @return false if a flash operation was refused (keys stay changed)
+ */
+bool config_store_commit(void);
+
+/**
+ * @brief Erase the partition and forget every key
+ *
+ * @return false if a flash operation was refused
+ */
+bool config_store_erase(void);
+
+/**
+ * @brief Get store statistics
+ *
+ * @param stats Output statistics
+ */
+void config_store_get_stats(config_store_stats_t* stats);
+
+#endif // CONFIG_STORE_H
@@ -4,6 +4,14 @@
  *
  * Lightweight JSON parser specifically designed for fault injection scenarios.
  * Does not support full JSON spec - only features needed for scenarios.
+ *
+ * Two layers, both resumable at any byte:
+ * - A token scanner that accumulates strings, numbers and literals in the
+ *   context's token buffer and passes punctuation straight through.
+ * - A schema state machine (root → schedule → event → condition/action,
+ *   and the action's target_cmds list)
+ *   that assigns each completed token. Unknown members are skipped
+ *   whatever their value, nested or not.
  */
 
 #include "json_loader.h"
@@ -16,464 +24,778 @@
 // Parser State
 // ============================================================================
 
+// Token scanner
+enum {
+    LEX_IDLE = 0,
+    LEX_STRING,
+    LEX_ESCAPE,
+    LEX_NUMBER,
+    LEX_LITERAL,
+};
+
+// Completed tokens handed to the schema layer
+enum {
+    TOK_STRING = 0,
+    TOK_NUMBER,
+    TOK_LITERAL,
+};
+
+// What the next token must be
+enum {
+    EXPECT_ROOT = 0,        // '{' opening the document
+    EXPECT_KEY_OR_END,      // Member name or '}' (object just opened)
+    EXPECT_KEY,             // Member name (after ',')
+    EXPECT_COLON,
+    EXPECT_VALUE,
+    EXPECT_NEXT,            // ',' or the closing bracket of the level
+    EXPECT_ELEMENT_OR_END,  // Event '{' or ']' (schedule just opened)
+    EXPECT_ELEMENT,         // Event '{' (after ',')
+    EXPECT_VALUE_OR_END,    // Command or ']' (target_cmds just opened)
+    EXPECT_EOF,             // Trailing whitespace only
+};
+
+// Schema object being filled
+enum {
+    LEVEL_ROOT = 0,
+    LEVEL_SCHEDULE,
+    LEVEL_EVENT,
+    LEVEL_CONDITION,
+    LEVEL_ACTION,
+    LEVEL_CMD_LIST,         // action.target_cmds array
+};
+
+// Required members (json_stream_t.seen)
+#define SEEN_NAME       0x01
+#define SEEN_SCHEDULE   0x02
+#define SEEN_T_MS       0x04
+#define SEEN_ACTION     0x08
+
+// Member keys per level; the key id is the index + 1 (0 = unknown)
+static const char* const root_keys[] = {
+    "name", "description", "version", "schedule", "seed",
+};
+enum { ROOT_NAME = 1, ROOT_DESCRIPTION, ROOT_VERSION, ROOT_SCHEDULE, ROOT_SEED };
+
+static const char* const event_keys[] = {
+    "t_ms", "duration_ms", "condition", "action",
+};
+enum { EVENT_T_MS = 1, EVENT_DURATION_MS, EVENT_CONDITION, EVENT_ACTION };
+
+static const char* const condition_keys[] = {
+    "mode_in", "rpm_gt", "rpm_lt", "nsp_cmd_eq", "nsp_cmd_count",
+};
+enum { COND_MODE_IN = 1, COND_RPM_GT, COND_RPM_LT, COND_NSP_CMD_EQ, COND_NSP_CMD_COUNT };
+
+static const char* const action_keys[] = {
+    "inject_crc_error", "drop_frames_pct", "delay_reply_ms", "force_nack",
+    "flip_status_bits", "set_fault_bits", "clear_fault_bits",
+    "limit_power_w", "limit_current_a", "limit_speed_rpm", "override_torque_mNm",
+    "overspeed_fault", "trip_lcl",
+    "burst_p_enter", "burst_p_exit", "burst_loss_good", "burst_loss_bad", "target_cmds",
+};
+enum {
+    ACT_INJECT_CRC_ERROR = 1, ACT_DROP_FRAMES_PCT, ACT_DELAY_REPLY_MS, ACT_FORCE_NACK,
+    ACT_FLIP_STATUS_BITS, ACT_SET_FAULT_BITS, ACT_CLEAR_FAULT_BITS,
+    ACT_LIMIT_POWER_W, ACT_LIMIT_CURRENT_A, ACT_LIMIT_SPEED_RPM, ACT_OVERRIDE_TORQUE_MNM,
+    ACT_OVERSPEED_FAULT, ACT_TRIP_LCL,
+    ACT_BURST_P_ENTER, ACT_BURST_P_EXIT, ACT_BURST_LOSS_GOOD, ACT_BURST_LOSS_BAD, ACT_TARGET_CMDS,
+};
+
+// One-shot parser result
 static const char* g_last_error = NULL;
-static const char* g_parse_ptr = NULL;
+static char g_error_buf[96];
 
 // ============================================================================
 // Utility Functions
 // ============================================================================
 
-static void set_error(const char* msg) {
-    g_last_error = msg;
-}
-
-static void skip_whitespace(void) {
-    while (*g_parse_ptr && isspace(*g_parse_ptr)) {
-        g_parse_ptr++;
+static void set_error(json_stream_t* s, const char* msg) {
+    if (s->error == NULL) {
+        s->error = msg;
+        s->error_offset = s->tok_offset;
     }
 }
 
-static bool expect_char(char c) {
-    skip_whitespace();
-    if (*g_parse_ptr == c) {
-        g_parse_ptr++;
-        return true;
+static uint8_t lookup_key(const json_stream_t* s, const char* const* keys, size_t count) {
+    if (s->tok_overflow) {
+        return 0;
     }
-    return false;
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(s->tok, keys[i]) == 0) {
+            return (uint8_t)(i + 1);
+        }
+    }
+    return 0;
 }
 
-static bool parse_string(char* buf, size_t buflen) {
-    skip_whitespace();
-    if (*g_parse_ptr != '"') {
-        set_error("Expected string");
-        return false;
-    }
-    g_parse_ptr++; // Skip opening quote
+#define LOOKUP(s, keys) lookup_key((s), (keys), sizeof(keys) / sizeof((keys)[0]))
 
-    size_t i = 0;
-    while (*g_parse_ptr && *g_parse_ptr != '"' && i < buflen - 1) {
-        if (*g_parse_ptr == '\\') {
-            g_parse_ptr++; // Skip escape char
-            if (!*g_parse_ptr) {
-                set_error("Unterminated string escape");
-                return false;
-            }
-        }
-        buf[i++] = *g_parse_ptr++;
+static bool copy_string(json_stream_t* s, uint8_t type, char* buf, size_t buflen) {
+    if (type != TOK_STRING) {
+        set_error(s, "Expected string");
+        return false;
     }
-
-    if (*g_parse_ptr != '"') {
-        set_error("Unterminated string");
+    if (s->tok_overflow || s->tok_len >= buflen) {
+        set_error(s, "String too long");
         return false;
     }
-    g_parse_ptr++; // Skip closing quote
-
-    buf[i] = '\0';
+    memcpy(buf, s->tok, (size_t)s->tok_len + 1);
     return true;
 }
 
-static bool parse_number(float* value) {
-    skip_whitespace();
+static bool token_number(json_stream_t* s, uint8_t type, float* value) {
     char* endptr;
-    *value = strtof(g_parse_ptr, &endptr);
-    if (endptr == g_parse_ptr) {
-        set_error("Expected number");
-        return false;
+    if (type == TOK_NUMBER && !s->tok_overflow) {
+        *value = strtof(s->tok, &endptr);
+        if (endptr != s->tok && *endptr == '\0') {
+            return true;
+        }
     }
-    g_parse_ptr = endptr;
-    return true;
+    set_error(s, "Expected number");
+    return false;
 }
 
-static bool parse_int(uint32_t* value) {
-    skip_whitespace();
+static bool token_int(json_stream_t* s, uint8_t type, uint32_t* value) {
     char* endptr;
-    *value = strtoul(g_parse_ptr, &endptr, 10);
-    if (endptr == g_parse_ptr) {
-        set_error("Expected integer");
-        return false;
+    if (type == TOK_NUMBER && !s->tok_overflow) {
+        *value = strtoul(s->tok, &endptr, 10);
+        if (endptr != s->tok && *endptr == '\0') {
+            return true;
+        }
     }
-    g_parse_ptr = endptr;
-    return true;
+    set_error(s, "Expected integer");
+    return false;
 }
 
-static bool parse_bool(bool* value) {
-    skip_whitespace();
-    if (strncmp(g_parse_ptr, "true", 4) == 0) {
+static bool token_bool(json_stream_t* s, uint8_t type, bool* value) {
+    if (type == TOK_LITERAL && strcmp(s->tok, "true") == 0) {
         *value = true;
-        g_parse_ptr += 4;
         return true;
     }
-    if (strncmp(g_parse_ptr, "false", 5) == 0) {
+    if (type == TOK_LITERAL && strcmp(s->tok, "false") == 0) {
         *value = false;
-        g_parse_ptr += 5;
         return true;
     }
-    set_error("Expected boolean");
+    set_error(s, "Expected boolean");
     return false;
 }
 
 // ============================================================================
-// JSON Object Parsers
+// Schema: Member Values
 // ============================================================================
 
-static bool parse_condition(scenario_condition_t* cond) {
-    memset(cond, 0, sizeof(*cond));
-
-    if (!expect_char('{')) {
-        set_error("Expected '{' for condition");
-        return false;
+static bool root_value(json_stream_t* s, uint8_t type) {
+    scenario_bin_builder_t* b = s->builder;
+    char version[16];
+
+    switch (s->key) {
+        case ROOT_NAME:
+            if (!copy_string(s, type, b->name, sizeof(b->name))) return false;
+            s->seen |= SEEN_NAME;
+            return true;
+        case ROOT_DESCRIPTION:
+            return copy_string(s, type, b->description, sizeof(b->description));
+        case ROOT_VERSION:
+            return copy_string(s, type, version, sizeof(version));
+        case ROOT_SEED:
+            return token_int(s, type, &b->seed);
+        default:
+            return true;
     }
+}
 
-    bool first = true;
-    while (!expect_char('}')) {
-        if (!first && !expect_char(',')) {
-            set_error("Expected ',' in condition");
+static bool event_value(json_stream_t* s, uint8_t type) {
+    switch (s->key) {
+        case EVENT_T_MS:
+            if (!token_int(s, type, &s->event.t_ms)) return false;
+            s->seen |= SEEN_T_MS;
+            return true;
+        case EVENT_DURATION_MS:
+            return token_int(s, type, &s->event.duration_ms);
+        case EVENT_CONDITION:
+            set_error(s, "Expected '{' for condition");
             return false;
-        }
-        first = false;
-
-        char key[32];
-        if (!parse_string(key, sizeof(key))) {
+        case EVENT_ACTION:
+            set_error(s, "Expected '{' for action");
             return false;
-        }
+        default:
+            return true;
+    }
+}
 
-        if (!expect_char(':')) {
-            set_error("Expected ':' after key");
-            return false;
-        }
+static bool condition_value(json_stream_t* s, uint8_t type) {
+    scenario_condition_t* cond = &s->event.condition;
+    char str[16];
 
-        if (strcmp(key, "mode_in") == 0) {
-            char mode_str[16];
-            if (!parse_string(mode_str, sizeof(mode_str))) {
-                return false;
-            }
+    switch (s->key) {
+        case COND_MODE_IN:
+            if (!copy_string(s, type, str, sizeof(str))) return false;
             cond->check_mode = true;
-            if (strcmp(mode_str, "CURRENT") == 0) cond->mode_value = 0;
-            else if (strcmp(mode_str, "SPEED") == 0) cond->mode_value = 1;
-            else if (strcmp(mode_str, "TORQUE") == 0) cond->mode_value = 2;
-            else if (strcmp(mode_str, "PWM") == 0) cond->mode_value = 3;
+            if (strcmp(str, "CURRENT") == 0) cond->mode_value = 0;
+            else if (strcmp(str, "SPEED") == 0) cond->mode_value = 1;
+            else if (strcmp(str, "TORQUE") == 0) cond->mode_value = 2;
+            else if (strcmp(str, "PWM") == 0) cond->mode_value = 3;
             else {
-                set_error("Invalid mode value");
+                set_error(s, "Invalid mode value");
                 return false;
             }
-        }
-        else if (strcmp(key, "rpm_gt") == 0) {
-            if (!parse_number(&cond->rpm_gt)) return false;
+            return true;
+        case COND_RPM_GT:
+            if (!token_number(s, type, &cond->rpm_gt)) return false;
             cond->check_rpm_gt = true;
-        }
-        else if (strcmp(key, "rpm_lt") == 0) {
-            if (!parse_number(&cond->rpm_lt)) return false;
+            return true;
+        case COND_RPM_LT:
+            if (!token_number(s, type, &cond->rpm_lt)) return false;
             cond->check_rpm_lt = true;
-        }
-        else if (strcmp(key, "nsp_cmd_eq") == 0) {
-            char cmd_str[8];
-            if (!parse_string(cmd_str, sizeof(cmd_str))) return false;
-            if (strncmp(cmd_str, "0x", 2) == 0) {
-                cond->nsp_cmd_value = (uint8_t)strtoul(cmd_str + 2, NULL, 16);
-                cond->check_nsp_cmd = true;
-            } else {
-                set_error("Invalid NSP command format");
+            return true;
+        case COND_NSP_CMD_EQ:
+            if (!copy_string(s, type, str, 8)) return false;
+            if (strncmp(str, "0x", 2) != 0) {
+                set_error(s, "Invalid NSP command format");
                 return false;
             }
-        }
-        else {
-            // Unknown key - skip value
-            skip_whitespace();
-            if (*g_parse_ptr == '"') {
-                char dummy[64];
-                parse_string(dummy, sizeof(dummy));
-            } else if (isdigit(*g_parse_ptr) || *g_parse_ptr == '-') {
-                float dummy_f;
-                parse_number(&dummy_f);
-            } else if (*g_parse_ptr == 't' || *g_parse_ptr == 'f') {
-                bool dummy_b;
-                parse_bool(&dummy_b);
+            cond->nsp_cmd_value = (uint8_t)strtoul(str + 2, NULL, 16);
+            cond->check_nsp_cmd = true;
+            return true;
+        case COND_NSP_CMD_COUNT: {
+            float count;
+            if (!token_number(s, type, &count)) return false;
+            if (count < 0.0f || count > 255.0f) {
+                set_error(s, "nsp_cmd_count out of range (0-255)");
+                return false;
             }
+            cond->nsp_cmd_count = (uint8_t)count;
+            return true;
         }
+        default:
+            return true;
     }
-
-    return true;
 }
 
-static bool parse_action(scenario_action_t* action) {
-    memset(action, 0, sizeof(*action));
-
-    if (!expect_char('{')) {
-        set_error("Expected '{' for action");
-        return false;
-    }
-
-    bool first = true;
-    while (!expect_char('}')) {
-        if (!first && !expect_char(',')) {
-            set_error("Expected ',' in action");
-            return false;
-        }
-        first = false;
-
-        char key[32];
-        if (!parse_string(key, sizeof(key))) {
-            return false;
-        }
-
-        if (!expect_char(':')) {
-            set_error("Expected ':' after key");
-            return false;
-        }
-
-        // Parse action fields
-        if (strcmp(key, "inject_crc_error") == 0) {
-            if (!parse_bool(&action->inject_crc_error)) return false;
-        }
-        else if (strcmp(key, "drop_frames_pct") == 0) {
-            float pct;
-            if (!parse_number(&pct)) return false;
-            action->drop_frames_pct = (uint8_t)pct;
-        }
-        else if (strcmp(key, "delay_reply_ms") == 0) {
-            uint32_t delay;
-            if (!parse_int(&delay)) return false;
-            action->delay_reply_ms = (uint16_t)delay;
-        }
-        else if (strcmp(key, "force_nack") == 0) {
-            if (!parse_bool(&action->force_nack)) return false;
-        }
-        else if (strcmp(key, "flip_status_bits") == 0) {
-            if (!parse_int(&action->flip_status_bits)) return false;
+static bool action_value(json_stream_t* s, uint8_t type) {
+    scenario_action_t* action = &s->event.action;
+    float f;
+    uint32_t u;
+
+    switch (s->key) {
+        case ACT_INJECT_CRC_ERROR:
+            return token_bool(s, type, &action->inject_crc_error);
+        case ACT_DROP_FRAMES_PCT:
+            if (!token_number(s, type, &f)) return false;
+            action->drop_frames_pct = (uint8_t)f;
+            return true;
+        case ACT_DELAY_REPLY_MS:
+            if (!token_int(s, type, &u)) return false;
+            action->delay_reply_ms = (uint16_t)u;
+            return true;
+        case ACT_FORCE_NACK:
+            return token_bool(s, type, &action->force_nack);
+        case ACT_FLIP_STATUS_BITS:
+            if (!token_int(s, type, &action->flip_status_bits)) return false;
             action->flip_status_bits_en = true;
-        }
-        else if (strcmp(key, "set_fault_bits") == 0) {
-            if (!parse_int(&action->set_fault_bits)) return false;
+            return true;
+        case ACT_SET_FAULT_BITS:
+            if (!token_int(s, type, &action->set_fault_bits)) return false;
             action->set_fault_bits_en = true;
-        }
-        else if (strcmp(key, "clear_fault_bits") == 0) {
-            if (!parse_int(&action->clear_fault_bits)) return false;
+            return true;
+        case ACT_CLEAR_FAULT_BITS:
+            if (!token_int(s, type, &action->clear_fault_bits)) return false;
             action->clear_fault_bits_en = true;
-        }
-        else if (strcmp(key, "limit_power_w") == 0) {
-            if (!parse_number(&action->limit_power_w)) return false;
+            return true;
+        case ACT_LIMIT_POWER_W:
+            if (!token_number(s, type, &action->limit_power_w)) return false;
             action->limit_power_en = true;
-        }
-        else if (strcmp(key, "limit_current_a") == 0) {
-            if (!parse_number(&action->limit_current_a)) return false;
+            return true;
+        case ACT_LIMIT_CURRENT_A:
+            if (!token_number(s, type, &action->limit_current_a)) return false;
             action->limit_current_en = true;
-        }
-        else if (strcmp(key, "limit_speed_rpm") == 0) {
-            if (!parse_number(&action->limit_speed_rpm)) return false;
+            return true;
+        case ACT_LIMIT_SPEED_RPM:
+            if (!token_number(s, type, &action->limit_speed_rpm)) return false;
             action->limit_speed_en = true;
-        }
-        else if (strcmp(key, "override_torque_mNm") == 0) {
-            if (!parse_number(&action->override_torque_mNm)) return false;
+            return true;
+        case ACT_OVERRIDE_TORQUE_MNM:
+            if (!token_number(s, type, &action->override_torque_mNm)) return false;
             action->override_torque_en = true;
-        }
-        else if (strcmp(key, "overspeed_fault") == 0) {
-            if (!parse_bool(&action->overspeed_fault)) return false;
-        }
-        else if (strcmp(key, "trip_lcl") == 0) {
-            if (!parse_bool(&action->trip_lcl)) return false;
-        }
-        else {
-            // Unknown key - skip value
-            skip_whitespace();
-            if (*g_parse_ptr == '"') {
-                char dummy[64];
-                parse_string(dummy, sizeof(dummy));
-            } else if (isdigit(*g_parse_ptr) || *g_parse_ptr == '-') {
-                float dummy_f;
-                parse_number(&dummy_f);
-            } else if (*g_parse_ptr == 't' || *g_parse_ptr == 'f') {
-                bool dummy_b;
-                parse_bool(&dummy_b);
-            }
-        }
+            return true;
+        case ACT_OVERSPEED_FAULT:
+            return token_bool(s, type, &action->overspeed_fault);
+        case ACT_TRIP_LCL:
+            return token_bool(s, type, &action->trip_lcl);
+        case ACT_BURST_P_ENTER:
+            if (!token_number(s, type, &action->burst_p_enter)) return false;
+            action->burst_en = true;
+            return true;
+        case ACT_BURST_P_EXIT:
+            return token_number(s, type, &action->burst_p_exit);
+        case ACT_BURST_LOSS_GOOD:
+            return token_number(s, type, &action->burst_loss_good);
+        case ACT_BURST_LOSS_BAD:
+            if (!token_number(s, type, &action->burst_loss_bad)) return false;
+            action->burst_loss_bad_en = true;
+            return true;
+        case ACT_TARGET_CMDS:
+            set_error(s, "Expected '[' for target_cmds");
+            return false;
+        default:
+            return true;
     }
+}
 
+/**
+ * @brief One element of action.target_cmds ("0x.." strings)
+ */
+static bool cmd_list_value(json_stream_t* s, uint8_t type) {
+    char str[8];
+    if (!copy_string(s, type, str, sizeof(str))) return false;
+    if (strncmp(str, "0x", 2) != 0) {
+        set_error(s, "Invalid NSP command format");
+        return false;
+    }
+    s->event.action.target_cmd_mask |= 1u << (strtoul(str + 2, NULL, 16) & 0x1F);
     return true;
 }
 
-static bool parse_event(scenario_event_t* event) {
-    memset(event, 0, sizeof(*event));
+// ============================================================================
+// Schema: Token Handlers
+// ============================================================================
 
-    if (!expect_char('{')) {
-        set_error("Expected '{' for event");
-        return false;
+/**
+ * @brief Close the current level's object or array
+ */
+static void close_level(json_stream_t* s, char c) {
+    switch (s->level) {
+        case LEVEL_ROOT:
+            if (c != '}') break;
+            if ((s->seen & (SEEN_NAME | SEEN_SCHEDULE)) != (SEEN_NAME | SEEN_SCHEDULE)) {
+                set_error(s, "Scenario missing required fields (name, schedule)");
+                return;
+            }
+            // Records stay in file order; scenario_bin_finish() sorts the index (stable)
+            s->expect = EXPECT_EOF;
+            return;
+
+        case LEVEL_SCHEDULE:
+            if (c != ']') break;
+            s->seen |= SEEN_SCHEDULE;
+            s->level = LEVEL_ROOT;
+            s->expect = EXPECT_NEXT;
+            return;
+
+        case LEVEL_EVENT:
+            if (c != '}') break;
+            if ((s->seen & (SEEN_T_MS | SEEN_ACTION)) != (SEEN_T_MS | SEEN_ACTION)) {
+                set_error(s, "Event missing required fields (t_ms, action)");
+                return;
+            }
+            // One event at a time, compiled straight into the image
+            if (!scenario_bin_add_event(s->builder, &s->event)) {
+                set_error(s, "Too many events in scenario");
+                return;
+            }
+            s->level = LEVEL_SCHEDULE;
+            s->expect = EXPECT_NEXT;
+            return;
+
+        case LEVEL_CMD_LIST:
+            if (c != ']') break;
+            s->level = LEVEL_ACTION;
+            s->expect = EXPECT_NEXT;
+            return;
+
+        case LEVEL_CONDITION:
+        case LEVEL_ACTION:
+            if (c != '}') break;
+            if (s->level == LEVEL_ACTION) {
+                s->seen |= SEEN_ACTION;
+            }
+            s->level = LEVEL_EVENT;
+            s->expect = EXPECT_NEXT;
+            return;
     }
+    set_error(s, (s->level == LEVEL_SCHEDULE || s->level == LEVEL_CMD_LIST) ?
+                 "Expected ',' or ']'" : "Expected ',' or '}'");
+}
 
-    bool has_t_ms = false;
-    bool has_action = false;
+/**
+ * @brief Open an event object in the schedule
+ */
+static void open_event(json_stream_t* s, char c) {
+    if (c != '{') {
+        set_error(s, "Expected '{' for event");
+        return;
+    }
+    memset(&s->event, 0, sizeof(s->event));
+    s->seen &= (uint8_t)~(SEEN_T_MS | SEEN_ACTION);
+    s->level = LEVEL_EVENT;
+    s->expect = EXPECT_KEY_OR_END;
+}
 
-    bool first = true;
-    while (!expect_char('}')) {
-        if (!first && !expect_char(',')) {
-            set_error("Expected ',' in event");
-            return false;
-        }
-        first = false;
+/**
+ * @brief Value that opens an object or array
+ */
+static void open_value(json_stream_t* s, char c) {
+    if (s->key == 0) {
+        s->skip_depth = 1;  // Ignored member: skip the whole value
+        return;
+    }
 
-        char key[32];
-        if (!parse_string(key, sizeof(key))) {
-            return false;
+    if (s->level == LEVEL_ROOT && s->key == ROOT_SCHEDULE) {
+        if (c != '[') {
+            set_error(s, "Expected '[' for schedule");
+            return;
         }
-
-        if (!expect_char(':')) {
-            set_error("Expected ':' after key");
-            return false;
+        if (s->seen & SEEN_SCHEDULE) {
+            set_error(s, "Duplicate schedule");
+            return;
         }
+        s->level = LEVEL_SCHEDULE;
+        s->expect = EXPECT_ELEMENT_OR_END;
+        return;
+    }
 
-        if (strcmp(key, "t_ms") == 0) {
-            if (!parse_int(&event->t_ms)) return false;
-            has_t_ms = true;
-        }
-        else if (strcmp(key, "duration_ms") == 0) {
-            if (!parse_int(&event->duration_ms)) return false;
-        }
-        else if (strcmp(key, "condition") == 0) {
-            if (!parse_condition(&event->condition)) return false;
-        }
-        else if (strcmp(key, "action") == 0) {
-            if (!parse_action(&event->action)) return false;
-            has_action = true;
-        }
-        else {
-            // Unknown key - skip
-            skip_whitespace();
-            if (*g_parse_ptr == '{') {
-                int depth = 0;
-                while (*g_parse_ptr) {
-                    if (*g_parse_ptr == '{') depth++;
-                    if (*g_parse_ptr == '}') {
-                        depth--;
-                        g_parse_ptr++;
-                        if (depth == 0) break;
-                    } else {
-                        g_parse_ptr++;
-                    }
-                }
-            }
-        }
+    if (s->level == LEVEL_EVENT && c == '{' &&
+        (s->key == EVENT_CONDITION || s->key == EVENT_ACTION)) {
+        if (s->key == EVENT_CONDITION) {
+            memset(&s->event.condition, 0, sizeof(s->event.condition));
+            s->level = LEVEL_CONDITION;
+        } else {
+            memset(&s->event.action, 0, sizeof(s->event.action));
+            s->level = LEVEL_ACTION;
+        }
+        s->expect = EXPECT_KEY_OR_END;
+        return;
     }
 
-    if (!has_t_ms || !has_action) {
-        set_error("Event missing required fields (t_ms, action)");
-        return false;
+    if (s->level == LEVEL_ACTION && c == '[' && s->key == ACT_TARGET_CMDS) {
+        s->event.action.target_cmd_mask = 0;
+        s->level = LEVEL_CMD_LIST;
+        s->expect = EXPECT_VALUE_OR_END;
+        return;
     }
 
-    return true;
+    // Known member with a scalar type
+    if (s->level == LEVEL_EVENT) {
+        event_value(s, TOK_STRING);  // Reports the member's expected type
+    } else if (s->level == LEVEL_ACTION && s->key == ACT_TARGET_CMDS) {
+        action_value(s, TOK_STRING);
+    } else {
+        set_error(s, "Unexpected object or array");
+    }
 }
 
-// ============================================================================
-// Main Parser
-// ============================================================================
-
-bool json_parse_scenario(const char* json_str, size_t json_len, scenario_t* scenario) {
-    if (!json_str || !scenario) {
-        set_error("NULL parameter");
-        return false;
+/**
+ * @brief Handle one punctuation character
+ */
+static void on_punct(json_stream_t* s, char c) {
+    // Inside an ignored value only nesting matters
+    if (s->skip_depth > 0) {
+        if (c == '{' || c == '[') {
+            if (++s->skip_depth == 0) set_error(s, "Nesting too deep");
+        } else if (c == '}' || c == ']') {
+            if (--s->skip_depth == 0) s->expect = EXPECT_NEXT;
+        }
+        return;
     }
 
-    g_last_error = NULL;
-    g_parse_ptr = json_str;
+    switch (s->expect) {
+        case EXPECT_ROOT:
+            if (c != '{') {
+                set_error(s, "Expected '{' at root");
+                return;
+            }
+            s->level = LEVEL_ROOT;
+            s->expect = EXPECT_KEY_OR_END;
+            return;
+
+        case EXPECT_KEY_OR_END:
+            if (c == '}') {
+                close_level(s, c);
+                return;
+            }
+            set_error(s, "Expected string");
+            return;
 
-    memset(scenario, 0, sizeof(*scenario));
+        case EXPECT_KEY:
+            set_error(s, "Expected string");
+            return;
 
-    if (!expect_char('{')) {
-        set_error("Expected '{' at root");
-        return false;
-    }
+        case EXPECT_COLON:
+            if (c != ':') {
+                set_error(s, "Expected ':' after key");
+                return;
+            }
+            s->expect = EXPECT_VALUE;
+            return;
 
-    bool has_name = false;
-    bool has_schedule = false;
+        case EXPECT_VALUE:
+            if (s->level != LEVEL_CMD_LIST && (c == '{' || c == '[')) {
+                open_value(s, c);
+                return;
+            }
+            set_error(s, "Expected value");
+            return;
 
-    bool first = true;
-    while (!expect_char('}')) {
-        if (!first && !expect_char(',')) {
-            set_error("Expected ',' in root object");
-            return false;
-        }
-        first = false;
+        case EXPECT_VALUE_OR_END:
+            if (c == ']') {
+                close_level(s, c);
+                return;
+            }
+            set_error(s, "Expected value");
+            return;
+
+        case EXPECT_NEXT:
+            if (c == ',') {
+                s->expect = (s->level == LEVEL_SCHEDULE) ? EXPECT_ELEMENT :
+                            (s->level == LEVEL_CMD_LIST) ? EXPECT_VALUE : EXPECT_KEY;
+                return;
+            }
+            close_level(s, c);
+            return;
 
-        char key[32];
-        if (!parse_string(key, sizeof(key))) {
-            return false;
-        }
+        case EXPECT_ELEMENT_OR_END:
+            if (c == ']') {
+                close_level(s, c);
+                return;
+            }
+            open_event(s, c);
+            return;
 
-        if (!expect_char(':')) {
-            set_error("Expected ':' after key");
-            return false;
-        }
+        case EXPECT_ELEMENT:
+            open_event(s, c);
+            return;
 
-        if (strcmp(key, "name") == 0) {
-            if (!parse_string(scenario->name, sizeof(scenario->name))) {
-                return false;
+        case EXPECT_EOF:
+        default:
+            set_error(s, "Data after end of document");
+            return;
+    }
+}
+
+/**
+ * @brief Handle one completed string, number or literal
+ */
+static void on_token(json_stream_t* s, uint8_t type) {
+    if (s->skip_depth > 0) {
+        return;
+    }
+
+    switch (s->expect) {
+        case EXPECT_KEY_OR_END:
+        case EXPECT_KEY:
+            if (type != TOK_STRING) {
+                set_error(s, "Expected string");
+                return;
             }
-            has_name = true;
-        }
-        else if (strcmp(key, "description") == 0) {
-            if (!parse_string(scenario->description, sizeof(scenario->description))) {
-                return false;
+            switch (s->level) {
+                case LEVEL_ROOT:      s->key = LOOKUP(s, root_keys); break;
+                case LEVEL_EVENT:     s->key = LOOKUP(s, event_keys); break;
+                case LEVEL_CONDITION: s->key = LOOKUP(s, condition_keys); break;
+                default:              s->key = LOOKUP(s, action_keys); break;
             }
-        }
-        else if (strcmp(key, "version") == 0) {
-            char version[16];
-            if (!parse_string(version, sizeof(version))) {
-                return false;
+            s->expect = EXPECT_COLON;
+            return;
+
+        case EXPECT_VALUE:
+        case EXPECT_VALUE_OR_END: {
+            bool ok;
+            switch (s->level) {
+                case LEVEL_ROOT:      ok = root_value(s, type); break;
+                case LEVEL_EVENT:     ok = event_value(s, type); break;
+                case LEVEL_CONDITION: ok = condition_value(s, type); break;
+                case LEVEL_CMD_LIST:  ok = cmd_list_value(s, type); break;
+                default:              ok = action_value(s, type); break;
             }
-        }
-        else if (strcmp(key, "schedule") == 0) {
-            if (!expect_char('[')) {
-                set_error("Expected '[' for schedule");
-                return false;
+            if (ok) {
+                s->expect = EXPECT_NEXT;
+            }
+            return;
+        }
+
+        case EXPECT_ROOT:
+            set_error(s, "Expected '{' at root");
+            return;
+        case EXPECT_ELEMENT_OR_END:
+        case EXPECT_ELEMENT:
+            set_error(s, "Expected '{' for event");
+            return;
+        case EXPECT_COLON:
+            set_error(s, "Expected ':' after key");
+            return;
+        case EXPECT_EOF:
+            set_error(s, "Data after end of document");
+            return;
+        default:
+            set_error(s, (s->level == LEVEL_SCHEDULE || s->level == LEVEL_CMD_LIST) ?
+                         "Expected ',' or ']'" : "Expected ',' or '}'");
+            return;
+    }
+}
+
+// ============================================================================
+// Token Scanner
+// ============================================================================
+
+static void tok_start(json_stream_t* s, uint8_t lex) {
+    s->lex = lex;
+    s->tok_len = 0;
+    s->tok_overflow = false;
+    s->tok_offset = s->offset;
+}
+
+static void tok_append(json_stream_t* s, char c) {
+    if (s->tok_len < JSON_STREAM_TOKEN_MAX - 1) {
+        s->tok[s->tok_len++] = c;
+    } else {
+        s->tok_overflow = true;
+    }
+}
+
+static void tok_finish(json_stream_t* s, uint8_t type) {
+    s->tok[s->tok_len] = '\0';
+    s->lex = LEX_IDLE;
+    on_token(s, type);
+}
+
+static bool is_number_char(char c) {
+    return isdigit((unsigned char)c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+/**
+ * @brief Scan one byte
+ */
+static void scan_char(json_stream_t* s, char c) {
+    switch (s->lex) {
+        case LEX_STRING:
+            if (c == '\\') {
+                s->lex = LEX_ESCAPE;
+            } else if (c == '"') {
+                tok_finish(s, TOK_STRING);
+            } else {
+                tok_append(s, c);
             }
+            return;
 
-            scenario->event_count = 0;
-            bool first_event = true;
-            while (!expect_char(']')) {
-                if (!first_event && !expect_char(',')) {
-                    set_error("Expected ',' in schedule array");
-                    return false;
-                }
-                first_event = false;
-
-                if (scenario->event_count >= MAX_EVENTS_PER_SCENARIO) {
-                    set_error("Too many events in scenario");
-                    return false;
-                }
-
-                if (!parse_event(&scenario->events[scenario->event_count])) {
-                    return false;
-                }
-                scenario->event_count++;
+        case LEX_ESCAPE:
+            tok_append(s, c);  // Escaped character taken literally
+            s->lex = LEX_STRING;
+            return;
+
+        case LEX_NUMBER:
+            if (is_number_char(c)) {
+                tok_append(s, c);
+                return;
             }
+            tok_finish(s, TOK_NUMBER);
+            break;  // c ends the number and is scanned below
 
-            has_schedule = true;
-        }
-        else {
-            // Unknown key - skip value
-            skip_whitespace();
-            if (*g_parse_ptr == '"') {
-                char dummy[128];
-                parse_string(dummy, sizeof(dummy));
+        case LEX_LITERAL:
+            if (isalpha((unsigned char)c)) {
+                tok_append(s, c);
+                return;
             }
-        }
+            tok_finish(s, TOK_LITERAL);
+            break;
+
+        default:
+            break;
+    }
+
+    if (s->error != NULL) {
+        return;
+    }
+
+    if (isspace((unsigned char)c)) {
+        return;
+    }
+    if (c == '"') {
+        tok_start(s, LEX_STRING);
+    } else if (isdigit((unsigned char)c) || c == '-') {
+        tok_start(s, LEX_NUMBER);
+        tok_append(s, c);
+    } else if (isalpha((unsigned char)c)) {
+        tok_start(s, LEX_LITERAL);
+        tok_append(s, c);
+    } else {
+        s->tok_offset = s->offset;
+        on_punct(s, c);
+    }
+}
+
+// ============================================================================
+// Incremental Parser
+// ============================================================================
+
+void json_stream_begin(json_stream_t* stream, scenario_bin_builder_t* builder) {
+    memset(stream, 0, sizeof(*stream));
+    stream->builder = builder;
+    stream->expect = EXPECT_ROOT;
+    stream->lex = LEX_IDLE;
+}
+
+bool json_stream_feed(json_stream_t* stream, const char* data, size_t len) {
+    if (stream->builder == NULL) {
+        set_error(stream, "NULL parameter");
+    }
+    for (size_t i = 0; i < len && stream->error == NULL; i++) {
+        scan_char(stream, data[i]);
+        stream->offset++;
     }
+    return stream->error == NULL;
+}
+
+bool json_stream_done(const json_stream_t* stream) {
+    return stream->error == NULL && stream->expect == EXPECT_EOF;
+}
+
+bool json_stream_end(json_stream_t* stream) {
+    // A number or literal is only complete once a delimiter follows
+    if (stream->error == NULL && stream->lex == LEX_NUMBER) {
+        tok_finish(stream, TOK_NUMBER);
+    } else if (stream->error == NULL && stream->lex == LEX_LITERAL) {
+        tok_finish(stream, TOK_LITERAL);
+    }
+    if (stream->error == NULL && stream->expect != EXPECT_EOF) {
+        stream->tok_offset = stream->offset;
+        set_error(stream, "Unexpected end of document");
+    }
+    return stream->error == NULL;
+}
 
-    if (!has_name || !has_schedule) {
-        set_error("Scenario missing required fields (name, schedule)");
+const char* json_stream_error(const json_stream_t* stream, uint32_t* offset) {
+    if (offset) *offset = stream->error_offset;
+    return stream->error;
+}
+
+// ============================================================================
+// One-Shot Parser
+// ============================================================================
+
+bool json_parse_scenario(const char* json_str, size_t json_len, scenario_bin_builder_t* builder) {
+    if (!json_str || !builder) {
+        g_last_error = "NULL parameter";
         return false;
     }
 
-    // Sort events by t_ms for efficient timeline processing
-    for (uint8_t i = 0; i < scenario->event_count - 1; i++) {
-        for (uint8_t j = i + 1; j < scenario->event_count; j++) {
-            if (scenario->events[j].t_ms < scenario->events[i].t_ms) {
-                scenario_event_t temp = scenario->events[i];
-                scenario->events[i] = scenario->events[j];
-                scenario->events[j] = temp;
-            }
-        }
+    const char* nul = memchr(json_str, '\0', json_len);
+    if (nul) {
+        json_len = (size_t)(nul - json_str);
     }
 
-    return true;
+    // The context is ~250 bytes; keep it off the caller's stack
+    static json_stream_t stream;
+    json_stream_begin(&stream, builder);
+    json_stream_feed(&stream, json_str, json_len);
+    if (json_stream_end(&stream)) {
+        g_last_error = NULL;
+        return true;
+    }
+
+    uint32_t offset;
+    const char* msg = json_stream_error(&stream, &offset);
+    snprintf(g_error_buf, sizeof(g_error_buf), "%s at byte %lu", msg, (unsigned long)offset);
+    g_last_error = g_error_buf;
+    return false;
 }
 
 const char* json_get_last_error(void) {
@@ -4,6 +4,14 @@
  *
  * Minimal JSON parser for fault injection scenarios.
  * Supports the schema defined in SPEC.md §9.
+ *
+ * The parser is incremental: a json_stream_t is fed the document in
+ * chunks of any size (down to one byte, e.g. as characters arrive on the
+ * USB console) and compiles each event into the image builder as soon as
+ * its closing brace is seen. All parse state lives in the stream context,
+ * so RAM use is fixed whatever the document size, and the caller may do
+ * other work between chunks. Errors carry the byte offset where they
+ * were detected.
  */
 
 #ifndef JSON_LOADER_H
@@ -12,21 +20,102 @@
 #include "scenario.h"
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+/** Longest string value kept (the scenario description) */
+#define JSON_STREAM_TOKEN_MAX   128
+
+/**
+ * @brief Incremental parser context (treat as opaque)
+ */
+typedef struct {
+    scenario_bin_builder_t* builder;
+    uint32_t offset;            // Bytes consumed so far
+    uint32_t tok_offset;        // Offset where the current token began
+    uint32_t error_offset;      // Offset of the first error
+    const char* error;          // First error, NULL while parsing is fine
+    uint8_t lex;                // Token scanner state
+    uint8_t expect;             // What the next token must be
+    uint8_t level;              // Schema object being filled
+    uint8_t key;                // Member whose value comes next (0 = ignored)
+    uint8_t skip_depth;         // Nesting inside an ignored value
+    uint8_t seen;               // Required members present
+    bool tok_overflow;          // Token longer than tok[]
+    uint16_t tok_len;
+    char tok[JSON_STREAM_TOKEN_MAX];
+    scenario_event_t event;     // Event being filled
+} json_stream_t;
+
+// ============================================================================
+// Incremental Parser
+// ============================================================================
+
+/**
+ * @brief Start parsing a document into an image builder
+ *
+ * @param stream Parser context
+ * @param builder Builder started with scenario_bin_begin()
+ */
+void json_stream_begin(json_stream_t* stream, scenario_bin_builder_t* builder);
+
+/**
+ * @brief Feed the next chunk of the document
+ *
+ * Bytes after the closing brace of the document must be whitespace.
+ *
+ * @param stream Parser context
+ * @param data Chunk (need not be null-terminated)
+ * @param len Chunk length
+ * @return false once an error has occurred (further chunks are ignored)
+ */
+bool json_stream_feed(json_stream_t* stream, const char* data, size_t len);
 
 /**
- * @brief Parse JSON scenario string into scenario structure
+ * @brief Check whether the document's root object has been closed
  *
- * @param json_str JSON string (null-terminated)
+ * @param stream Parser context
+ * @return true if the whole scenario has been parsed without error
+ */
+bool json_stream_done(const json_stream_t* stream);
+
+/**
+ * @brief Signal end of input
+ *
+ * @param stream Parser context
+ * @return true if the document was complete and valid
+ */
+bool json_stream_end(json_stream_t* stream);
+
+/**
+ * @brief Get the parse error
+ *
+ * @param stream Parser context
+ * @param offset Output: byte offset of the error (can be NULL)
+ * @return Error string or NULL if no error
+ */
+const char* json_stream_error(const json_stream_t* stream, uint32_t* offset);
+
+// ============================================================================
+// One-Shot Parser
+// ============================================================================
+
+/**
+ * @brief Parse JSON scenario string into an image builder
+ *
+ * Each event is compiled into the image as soon as it is parsed; call
+ * scenario_bin_finish() afterwards to seal the image.
+ *
+ * @param json_str JSON string (parsing stops at a null terminator)
  * @param json_len Length of JSON string
- * @param scenario Output scenario structure
- * @return true if parsed successfully, false on error
+ * @param builder Builder started with scenario_bin_begin()
+ * @return true if parsed successfully, false on error (or image full)
  */
-bool json_parse_scenario(const char* json_str, size_t json_len, scenario_t* scenario);
+bool json_parse_scenario(const char* json_str, size_t json_len, scenario_bin_builder_t* builder);
 
 /**
  * @brief Get last parse error message
  *
- * @return Error string or NULL if no error
+ * @return Error string with byte offset, or "No error"
  */
 const char* json_get_last_error(void);
 
@@ -2,14 +2,24 @@
  * @file scenario.c
  * @brief Fault Injection Scenario Engine Implementation
  *
- * Timeline-based fault injection for HIL testing.
+ * Timeline-based fault injection for HIL testing. The engine runs a
+ * compiled image (scenario_bin.h) where it lies: built-in scenarios from
+ * flash, JSON uploads from a RAM image compiled at load.
  */
 
 #include "scenario.h"
 #include "json_loader.h"
 #include "../device/nss_nrwa_t6_model.h"
 #include "../drivers/crc_ccitt.h"
+#include "../util/core_sync.h"
+#include "../util/rng.h"
+#include "timebase.h"
 #include "pico/stdlib.h"
+#include "pico/time.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#include "hardware/irq.h"
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -17,29 +27,314 @@
 // Global State
 // ============================================================================
 
-static scenario_t g_scenario;
 static bool g_initialized = false;
 
-// Active injections (for duration-based events)
-static scenario_action_t g_active_transport_action;
-static scenario_action_t g_active_device_action;
-static scenario_action_t g_active_physics_action;
+// Per-event runtime state, bit per timeline position
+#define EVENT_WORDS SCENARIO_EVENT_WORDS
 
-static uint32_t g_transport_action_end_ms = 0;
-static uint32_t g_device_action_end_ms = 0;
-static uint32_t g_physics_action_end_ms = 0;
+/**
+ * @brief One of the concurrently running scenarios
+ *
+ * Each layer runs its own image on its own timeline. The actions active in
+ * all layers are merged into the single blocks the injection paths read
+ * (merge_transport(), merge_physics()).
+ */
+typedef struct {
+    // Loaded scenario: a validated image in flash (XIP) or RAM
+    const scenario_bin_header_t* image;
+    uint32_t image_len;
+    uint8_t event_count;
+    bool active;
+    uint32_t activation_time_ms;
+    int64_t activation_us;      // Negative for a run resumed after a reset
+
+    volatile uint32_t triggered[EVENT_WORDS];
+    uint32_t trigger_time_ms[MAX_EVENTS_PER_SCENARIO];
+
+    // Fired events scenario_update() has logged and applied device actions
+    // for, outside the alarm IRQ (each event fires once per run)
+    uint32_t reported[EVENT_WORDS];
+
+    // Active injections live in the image: the ops of the event driving
+    // each action layer (NULL = none) and their expiry (0 = until replaced)
+    const scenario_bin_op_t* transport_ops;
+    uint8_t transport_count;
+    uint8_t transport_event;    // Timeline position of transport_ops' event
+    uint32_t transport_end_ms;
+    const scenario_bin_op_t* physics_ops;
+    uint8_t physics_count;
+    uint8_t physics_event;
+    uint32_t physics_end_ms;
+    uint32_t device_end_ms;
+
+    // Timeline cursor: events are sorted by t_ms at load, everything before
+    // next_event is done (fired, or parked waiting for its condition)
+    uint8_t next_event;
+    volatile alarm_id_t event_alarm;    // Armed for next_event (0 = none)
+
+    // RAM copy of the image's conditions for Core1 (no XIP reads in the tick),
+    // one slot per conditional event in timeline order
+    scenario_bin_condition_t predicates[MAX_SCENARIO_CONDITIONS];
+    uint8_t cond_event[MAX_SCENARIO_CONDITIONS];    // Timeline position of each slot
+    uint8_t next_cond;                              // Slot of the next conditional event
+    uint32_t cond_stateless;                        // Slots without speed or mode predicates
+
+    // NSP command hook: armed slots waiting on each command, matches
+    // counted since arming
+    uint32_t cmd_slots[32];
+    uint8_t cmd_matches[MAX_SCENARIO_CONDITIONS];
+} scenario_layer_t;
+
+static scenario_layer_t g_layers[SCENARIO_LAYERS];
+
+// JSON uploads are compiled event by event into g_ram_image
+static uint32_t g_ram_image[SCENARIO_RAM_IMAGE_SIZE / 4];
+static scenario_bin_builder_t g_ram_builder;
+
+// Transport injection published for the NSP reply path (see scenario.h):
+// the union of the merged per-command words beside it
+volatile uint32_t g_scenario_transport = 0;
+
+// Merged transport injection parameters (published before
+// g_scenario_transport; only read while it is non-zero)
+static volatile uint32_t g_xport_cmd_word[32];      // Transport word per NSP command
+static volatile uint32_t g_xport_burst_model = 0;   // SCENARIO_OP_BURST_MODEL operand
+static volatile uint32_t g_xport_burst_loss = 0;    // SCENARIO_OP_BURST_LOSS operand
+static const scenario_bin_op_t* g_burst_source = NULL;  // Ops the burst model comes from
+
+// Fault-injection RNG: seeded when the first layer of a run is activated,
+// drawn only by the NSP service IRQ, so a run replays exactly from its seed
+static rng_t g_rng;
+static uint32_t g_seed = 0;             // Seed of the current/last run
+static uint32_t g_seed_override = 0;    // Next run's seed (0 = image seed)
+static bool g_burst_bad = false;        // Gilbert-Elliott state (true = bad)
+
+// Transport injection counters (written by the NSP service IRQ)
+static volatile uint32_t g_xport_bursts = 0;
+static volatile uint32_t g_xport_dropped = 0;
+static volatile uint32_t g_xport_corrupted = 0;
+static volatile uint32_t g_xport_nacked = 0;
+static volatile uint32_t g_xport_delayed = 0;
+
+// Most recently triggered event of any layer (read by Core1 for the
+// deadline-miss trace)
+static volatile uint8_t g_last_event = SCENARIO_NO_EVENT;
+
+// Condition slots shared with Core1, one word per layer with a bit per slot.
+// Due conditional events (written by Core0 only)
+static volatile uint32_t g_cond_armed[SCENARIO_LAYERS];
+// Armed events whose condition held on a tick (written by Core1 only)
+static volatile uint32_t g_cond_hit[SCENARIO_LAYERS];
+// Core0 bumps g_cond_gen to have Core1 clear g_cond_hit; Core1 acks it
+static volatile uint32_t g_cond_gen[SCENARIO_LAYERS];
+static volatile uint32_t g_cond_gen_ack[SCENARIO_LAYERS];
+// Armed slots whose speed and mode predicates held on the last tick
+// (written by Core1 only; the NSP command hook reads it)
+static volatile uint32_t g_cond_state_ok[SCENARIO_LAYERS];
+
+// Bit per NSP command some layer has an armed slot waiting on
+volatile uint32_t g_scenario_cmd_wanted = 0;
+
+static bool g_service_started = false;
+
+/**
+ * @brief Scenario clock (simulation time, follows external steps in lockstep)
+ */
+static inline uint32_t sim_now_ms(void) {
+    return (uint32_t)(timebase_get_sim_us() / 1000u);
+}
+
+/**
+ * @brief Get a layer by index
+ *
+ * @return Layer, or NULL if the index is out of range
+ */
+static scenario_layer_t* get_layer(uint8_t layer) {
+    return (layer < SCENARIO_LAYERS) ? &g_layers[layer] : NULL;
+}
+
+static inline uint8_t layer_index(const scenario_layer_t* layer) {
+    return (uint8_t)(layer - g_layers);
+}
+
+// ============================================================================
+// Action Merging (interrupts disabled or the event alarm)
+// ============================================================================
+
+/**
+ * @brief Compile an event's transport ops into one word
+ *
+ * @param cmd_mask Output: commands the word applies to (0 = all)
+ * @param burst_model Output: SCENARIO_OP_BURST_MODEL operand (if BURST set)
+ * @param burst_loss Output: SCENARIO_OP_BURST_LOSS operand
+ * @return SCENARIO_XPORT_* word (0 = no transport action)
+ */
+static uint32_t transport_word(const scenario_bin_op_t* ops, uint8_t count, uint32_t* cmd_mask,
+                               uint32_t* burst_model, uint32_t* burst_loss) {
+    uint32_t word = 0;
+    for (uint8_t k = 0; k < count; k++) {
+        uint32_t arg = ops[k].arg.u;
+        switch (ops[k].opcode) {
+            case SCENARIO_OP_BURST_MODEL:
+                *burst_model = arg;
+                word |= SCENARIO_XPORT_BURST;
+                break;
+            case SCENARIO_OP_BURST_LOSS:
+                *burst_loss = arg;
+                break;
+            case SCENARIO_OP_TARGET_CMDS:
+                *cmd_mask = arg;
+                break;
+            case SCENARIO_OP_DROP_FRAMES:
+                word = (word & ~SCENARIO_XPORT_DROP_PCT_MASK) | (arg > 100 ? 100 : arg);
+                break;
+            case SCENARIO_OP_CRC_ERROR:
+                word |= SCENARIO_XPORT_CRC_ERROR;
+                break;
+            case SCENARIO_OP_FORCE_NACK:
+                word |= SCENARIO_XPORT_FORCE_NACK;
+                break;
+            case SCENARIO_OP_DELAY_REPLY:
+                word |= (arg > 0xFFFFu ? 0xFFFFu : arg) << SCENARIO_XPORT_DELAY_SHIFT;
+                break;
+            default:
+                break;
+        }
+    }
+    return word;
+}
+
+/**
+ * @brief Stack a higher layer's transport word on a lower one's
+ *
+ * Drop rate and delay set by the higher layer replace the lower layer's;
+ * forced NACK, CRC corruption and burst loss add up.
+ */
+static uint32_t stack_transport_word(uint32_t low, uint32_t high) {
+    const uint32_t flags = SCENARIO_XPORT_CRC_ERROR | SCENARIO_XPORT_FORCE_NACK |
+                           SCENARIO_XPORT_BURST;
+    uint32_t word = (low | high) & flags;
+    uint32_t drop = high & SCENARIO_XPORT_DROP_PCT_MASK;
+    word |= drop ? drop : (low & SCENARIO_XPORT_DROP_PCT_MASK);
+    uint32_t delay = high >> SCENARIO_XPORT_DELAY_SHIFT;
+    word |= (delay ? delay : (low >> SCENARIO_XPORT_DELAY_SHIFT)) << SCENARIO_XPORT_DELAY_SHIFT;
+    return word;
+}
+
+/**
+ * @brief Merge the layers' transport actions into the per-command words
+ *
+ * Layers are stacked in index order (stack_transport_word()), each on the
+ * commands it targets; the burst model is the highest layer's. Runs only
+ * when an action starts or ends, so the reply path reads one word.
+ */
+static void merge_transport(void) {
+    uint32_t words[32];
+    uint32_t model = 0;
+    uint32_t loss = 0;
+    const scenario_bin_op_t* burst_source = NULL;
+    memset(words, 0, sizeof(words));
+
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        const scenario_layer_t* layer = &g_layers[l];
+        if (!layer->active || layer->transport_ops == NULL) {
+            continue;
+        }
+        uint32_t cmd_mask = 0;
+        uint32_t layer_model = 0;
+        uint32_t layer_loss = 0;
+        uint32_t word = transport_word(layer->transport_ops, layer->transport_count, &cmd_mask,
+                                       &layer_model, &layer_loss);
+        if (word & SCENARIO_XPORT_BURST) {
+            model = layer_model;
+            loss = layer_loss;
+            burst_source = layer->transport_ops;
+        }
+        for (uint8_t cmd = 0; cmd < 32; cmd++) {
+            if (cmd_mask == 0 || (cmd_mask & (1u << cmd)) != 0) {
+                words[cmd] = stack_transport_word(words[cmd], word);
+            }
+        }
+    }
+
+    uint32_t any = 0;
+    g_scenario_transport = 0;
+    for (uint8_t cmd = 0; cmd < 32; cmd++) {
+        g_xport_cmd_word[cmd] = words[cmd];
+        any |= words[cmd];
+    }
+    g_xport_burst_model = model;
+    g_xport_burst_loss = loss;
+    if (burst_source != g_burst_source) {
+        g_burst_source = burst_source;
+        g_burst_bad = false;  // Each burst-loss action starts in the good state
+    }
+    g_scenario_transport = any;
+}
+
+/**
+ * @brief Add physics-layer ops to an override block (later ops win)
+ */
+static void add_physics_ops(physics_override_t* ovr, const scenario_bin_op_t* ops, uint8_t count) {
+    // Values are already in model units (converted when compiled)
+    for (uint8_t k = 0; ops != NULL && k < count; k++) {
+        float arg = ops[k].arg.f;
+        switch (ops[k].opcode) {
+            case SCENARIO_OP_LIMIT_POWER:
+                ovr->flags |= PHYS_OVR_POWER_LIMIT;
+                ovr->power_limit_w = arg;
+                break;
+            case SCENARIO_OP_LIMIT_CURRENT:
+                ovr->flags |= PHYS_OVR_CURRENT_LIMIT;
+                ovr->current_limit_a = arg;
+                break;
+            case SCENARIO_OP_LIMIT_SPEED:
+                ovr->flags |= PHYS_OVR_SPEED_LIMIT;
+                ovr->speed_limit_rad_s = arg;
+                break;
+            case SCENARIO_OP_OVERRIDE_TORQUE:
+                ovr->flags |= PHYS_OVR_TORQUE;
+                ovr->torque_mnm = arg;
+                break;
+            default:
+                break;  // Other layers
+        }
+    }
+}
+
+/**
+ * @brief Merge the layers' physics actions into one override block
+ *
+ * Each override is taken from the highest layer that sets it.
+ */
+static void merge_physics(void) {
+    physics_override_t ovr;
+    memset(&ovr, 0, sizeof(ovr));
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        const scenario_layer_t* layer = &g_layers[l];
+        if (layer->active) {
+            add_physics_ops(&ovr, layer->physics_ops, layer->physics_count);
+        }
+    }
+    core_sync_publish_physics_override(&ovr);
+}
 
 // ============================================================================
 // Initialization
 // ============================================================================
 
 void scenario_engine_init(void) {
-    memset(&g_scenario, 0, sizeof(g_scenario));
-    memset(&g_active_transport_action, 0, sizeof(g_active_transport_action));
-    memset(&g_active_device_action, 0, sizeof(g_active_device_action));
-    memset(&g_active_physics_action, 0, sizeof(g_active_physics_action));
+    if (g_initialized) {
+        scenario_deactivate_all();
+    }
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        g_layers[l].image = NULL;
+        g_layers[l].event_count = 0;
+        g_layers[l].active = false;
+    }
+    g_scenario_transport = 0;
     g_initialized = true;
-    printf("[SCENARIO] Engine initialized\n");
+    printf("[SCENARIO] Engine initialized (%u layers)\n", (unsigned)SCENARIO_LAYERS);
 }
 
 // ============================================================================
@@ -47,312 +342,951 @@ void scenario_engine_init(void) {
 // ============================================================================
 
 bool scenario_load(const char* json_str, size_t json_len) {
+    scenario_bin_builder_t* builder = scenario_begin_ram_image();
+    if (builder == NULL) {
+        return false;
+    }
+
+    // Parse JSON, compiling each event into the RAM image
+    if (!json_parse_scenario(json_str, json_len, builder)) {
+        printf("[SCENARIO] ERROR: Parse failed: %s\n", json_get_last_error());
+        return false;
+    }
+
+    return scenario_load_ram_image();
+}
+
+scenario_bin_builder_t* scenario_begin_ram_image(void) {
+    if (!g_initialized) {
+        printf("[SCENARIO] ERROR: Engine not initialized\n");
+        return NULL;
+    }
+
+    // The RAM image may be running, in the base layer or any other
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        if (l == SCENARIO_BASE_LAYER ||
+            g_layers[l].image == (const scenario_bin_header_t*)g_ram_image) {
+            scenario_layer_unload(l);
+        }
+    }
+
+    scenario_bin_begin(&g_ram_builder, g_ram_image, sizeof(g_ram_image));
+    return &g_ram_builder;
+}
+
+bool scenario_load_ram_image(void) {
+    size_t len = scenario_bin_finish(&g_ram_builder);
+    if (len == 0) {
+        printf("[SCENARIO] ERROR: Scenario does not fit the RAM image\n");
+        return false;
+    }
+
+    return scenario_load_image((const scenario_bin_header_t*)g_ram_image, len);
+}
+
+bool scenario_layer_load_image(uint8_t index, const scenario_bin_header_t* image, size_t len) {
     if (!g_initialized) {
         printf("[SCENARIO] ERROR: Engine not initialized\n");
         return false;
     }
+    scenario_layer_t* layer = get_layer(index);
+    if (layer == NULL) {
+        printf("[SCENARIO] ERROR: No layer %u\n", (unsigned)index);
+        return false;
+    }
 
-    // Deactivate current scenario if active
-    if (g_scenario.active) {
-        scenario_deactivate();
+    // Deactivate the layer's current scenario if active
+    if (layer->active) {
+        scenario_layer_deactivate(index);
     }
 
-    // Parse JSON
-    if (!json_parse_scenario(json_str, json_len, &g_scenario)) {
-        printf("[SCENARIO] ERROR: Parse failed: %s\n", json_get_last_error());
+    const char* error = scenario_bin_validate(image, len);
+    if (error != NULL) {
+        printf("[SCENARIO] ERROR: Invalid image: %s\n", error);
+        layer->image = NULL;
+        layer->event_count = 0;
         return false;
     }
 
-    printf("[SCENARIO] Loaded: %s (%d events)\n", g_scenario.name, g_scenario.event_count);
-    if (g_scenario.description[0]) {
-        printf("[SCENARIO]   %s\n", g_scenario.description);
+    layer->image = image;
+    layer->image_len = (uint32_t)len;
+    layer->event_count = image->event_count;
+    for (uint8_t w = 0; w < EVENT_WORDS; w++) {
+        layer->triggered[w] = 0;
+    }
+
+    // Condition slots in timeline order, the order timeline_advance() arms them
+    uint8_t slot = 0;
+    layer->cond_stateless = 0;
+    for (uint8_t i = 0; i < layer->event_count; i++) {
+        const scenario_bin_condition_t* cond = scenario_bin_condition(scenario_bin_event(image, i));
+        if (cond != NULL) {
+            layer->predicates[slot] = *cond;
+            layer->cond_event[slot] = i;
+            if (cond->omega_gt_rad_s == -INFINITY && cond->omega_lt_rad_s == INFINITY &&
+                cond->mode_mask == 0xFF) {
+                layer->cond_stateless |= 1u << slot;
+            }
+            slot++;
+        }
+    }
+
+    printf("[SCENARIO] Loaded: %s (%d events, layer %u)\n", image->name, layer->event_count,
+           (unsigned)index);
+    const char* desc = scenario_bin_description(image);
+    if (desc) {
+        printf("[SCENARIO]   %s\n", desc);
     }
 
+    core_sync_ring(CORE_SYNC_BELL_SCENARIO);
     return true;
 }
 
-bool scenario_activate(void) {
+const scenario_bin_header_t* scenario_layer_get_image(uint8_t index) {
+    const scenario_layer_t* layer = get_layer(index);
+    return layer ? layer->image : NULL;
+}
+
+void scenario_layer_unload(uint8_t index) {
+    scenario_layer_t* layer = get_layer(index);
+    if (layer == NULL) {
+        return;
+    }
+    if (layer->active) {
+        scenario_layer_deactivate(index);
+    }
+    layer->image = NULL;
+    layer->event_count = 0;
+    core_sync_ring(CORE_SYNC_BELL_SCENARIO);
+}
+
+static void timeline_advance(scenario_layer_t* layer);
+
+/**
+ * @brief Recompute g_scenario_cmd_wanted from the layers' waiting slots
+ */
+static void refresh_cmd_wanted(void) {
+    uint32_t wanted = 0;
+    for (uint8_t cmd = 0; cmd < 32; cmd++) {
+        for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+            if (g_layers[l].cmd_slots[cmd] != 0) {
+                wanted |= 1u << cmd;
+                break;
+            }
+        }
+    }
+    g_scenario_cmd_wanted = wanted;
+}
+
+/**
+ * @brief Forget every event of a layer waiting on an NSP command
+ */
+static void clear_cmd_waiters(scenario_layer_t* layer) {
+    memset(layer->cmd_slots, 0, sizeof(layer->cmd_slots));
+    refresh_cmd_wanted();
+}
+
+/**
+ * @brief Drop a layer's actions from the merged blocks (interrupts disabled)
+ */
+static void clear_layer_actions(scenario_layer_t* layer) {
+    layer->transport_ops = NULL;
+    layer->transport_count = 0;
+    layer->transport_end_ms = 0;
+    layer->physics_ops = NULL;
+    layer->physics_count = 0;
+    layer->physics_end_ms = 0;
+    layer->device_end_ms = 0;
+    merge_transport();
+    merge_physics();
+}
+
+/**
+ * @brief Start a run: counters from zero, RNG from the run's seed
+ */
+static void begin_run(uint32_t seed) {
+    g_last_event = SCENARIO_NO_EVENT;
+    g_xport_bursts = 0;
+    g_xport_dropped = 0;
+    g_xport_corrupted = 0;
+    g_xport_nacked = 0;
+    g_xport_delayed = 0;
+
+    g_seed = seed;
+    rng_seed(&g_rng, g_seed);
+    g_burst_bad = false;
+}
+
+bool scenario_layer_activate(uint8_t index) {
     if (!g_initialized) {
         printf("[SCENARIO] ERROR: Engine not initialized\n");
         return false;
     }
 
-    if (g_scenario.event_count == 0) {
-        printf("[SCENARIO] ERROR: No scenario loaded\n");
+    scenario_layer_t* layer = get_layer(index);
+    if (layer == NULL || layer->image == NULL || layer->event_count == 0) {
+        printf("[SCENARIO] ERROR: No scenario loaded in layer %u\n", (unsigned)index);
         return false;
     }
 
-    if (g_scenario.active) {
-        printf("[SCENARIO] WARNING: Scenario already active\n");
+    if (layer->active) {
+        printf("[SCENARIO] WARNING: Layer %u already active\n", (unsigned)index);
         return false;
     }
 
     // Reset all event states
-    for (uint8_t i = 0; i < g_scenario.event_count; i++) {
-        g_scenario.events[i].triggered = false;
-        g_scenario.events[i].trigger_time_ms = 0;
+    for (uint8_t w = 0; w < EVENT_WORDS; w++) {
+        layer->triggered[w] = 0;
+        layer->reported[w] = 0;
+    }
+    memset(layer->trigger_time_ms, 0, sizeof(layer->trigger_time_ms));
+    layer->next_event = 0;
+    layer->next_cond = 0;
+
+    // The first layer starts a run: new seed, counters from zero. Layers
+    // added to a running one share its RNG and counters.
+    bool new_run = (scenario_get_active_layers() == 0);
+    if (new_run) {
+        // Seed: Table 10 override, else the scenario's, else a fresh one
+        begin_run(g_seed_override ? g_seed_override :
+                  layer->image->seed ? layer->image->seed : rng_mix(time_us_32()));
     }
 
-    // Clear active actions
-    memset(&g_active_transport_action, 0, sizeof(g_active_transport_action));
-    memset(&g_active_device_action, 0, sizeof(g_active_device_action));
-    memset(&g_active_physics_action, 0, sizeof(g_active_physics_action));
-    g_transport_action_end_ms = 0;
-    g_device_action_end_ms = 0;
-    g_physics_action_end_ms = 0;
-
-    // Activate scenario
-    g_scenario.active = true;
-    g_scenario.activation_time_ms = to_ms_since_boot(get_absolute_time());
-
-    printf("[SCENARIO] Activated: %s\n", g_scenario.name);
+    // Activate the layer and arm its first deadline
+    uint32_t save = save_and_disable_interrupts();
+    g_cond_armed[index] = 0;
+    clear_cmd_waiters(layer);
+    g_cond_gen[index]++;  // Stale hits from the layer's previous run are dropped by Core1
+    layer->active = true;
+    clear_layer_actions(layer);
+    layer->activation_us = (int64_t)timebase_get_sim_us();
+    layer->activation_time_ms = (uint32_t)(layer->activation_us / 1000);
+    timeline_advance(layer);
+    restore_interrupts(save);
+    core_sync_ring(CORE_SYNC_BELL_SCENARIO);
+
+    if (new_run) {
+        printf("[SCENARIO] Activated: %s (layer %u, seed %lu)\n", layer->image->name,
+               (unsigned)index, (unsigned long)g_seed);
+    } else {
+        printf("[SCENARIO] Activated: %s (layer %u, joins the run of seed %lu)\n",
+               layer->image->name, (unsigned)index, (unsigned long)g_seed);
+    }
     return true;
 }
 
-void scenario_deactivate(void) {
-    if (!g_scenario.active) {
+void scenario_layer_deactivate(uint8_t index) {
+    scenario_layer_t* layer = get_layer(index);
+    if (layer == NULL || !layer->active) {
         return;
     }
 
-    g_scenario.active = false;
+    uint32_t save = save_and_disable_interrupts();
+    layer->active = false;
+    g_cond_armed[index] = 0;
+    clear_cmd_waiters(layer);
+    if (layer->event_alarm > 0) {
+        cancel_alarm(layer->event_alarm);
+        layer->event_alarm = 0;
+    }
+
+    // Clear the layer's actions; the other layers' stay in effect
+    clear_layer_actions(layer);
+    if (scenario_get_active_layers() == 0) {
+        g_last_event = SCENARIO_NO_EVENT;
+    }
+    restore_interrupts(save);
+    core_sync_ring(CORE_SYNC_BELL_SCENARIO);
 
-    // Clear all active actions
-    memset(&g_active_transport_action, 0, sizeof(g_active_transport_action));
-    memset(&g_active_device_action, 0, sizeof(g_active_device_action));
-    memset(&g_active_physics_action, 0, sizeof(g_active_physics_action));
-    g_transport_action_end_ms = 0;
-    g_device_action_end_ms = 0;
-    g_physics_action_end_ms = 0;
+    printf("[SCENARIO] Deactivated layer %u\n", (unsigned)index);
+}
 
-    printf("[SCENARIO] Deactivated\n");
+void scenario_deactivate_all(void) {
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        scenario_layer_deactivate(l);
+    }
 }
 
 // ============================================================================
-// Condition Checking
+// Condition Checking (conditions are compiled into the image)
 // ============================================================================
 
-static bool check_condition(const scenario_condition_t* cond) {
-    // If no conditions specified, always true
-    if (!cond->check_mode && !cond->check_rpm_gt && !cond->check_rpm_lt && !cond->check_nsp_cmd) {
-        return true;
+void __not_in_flash_func(scenario_eval_conditions)(float omega_rad_s, uint8_t mode) {
+    uint32_t mode_bit = 1u << (mode & 0x07);
+    uint32_t rung = 0;
+
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        if (g_cond_armed[l] == 0) {
+            continue;  // Idle layers cost one load
+        }
+
+        uint32_t gen = g_cond_gen[l];
+        if (gen != g_cond_gen_ack[l]) {
+            g_cond_hit[l] = 0;
+            g_cond_state_ok[l] = 0;
+            __dmb();
+            g_cond_gen_ack[l] = gen;
+        }
+
+        uint32_t pending = g_cond_armed[l] & ~g_cond_hit[l];
+        if (pending == 0) {
+            continue;
+        }
+
+        // Events on an NSP command fire from the command hook; for them only
+        // the state part of the condition is published
+        const scenario_bin_condition_t* predicates = g_layers[l].predicates;
+        uint32_t hits = 0;
+        uint32_t state_ok = 0;
+        for (uint32_t i = 0; pending != 0; i++, pending >>= 1) {
+            if ((pending & 1u) == 0) {
+                continue;
+            }
+
+            const scenario_bin_condition_t* p = &predicates[i];
+            uint32_t ok = (uint32_t)(omega_rad_s > p->omega_gt_rad_s) &
+                          (uint32_t)(omega_rad_s < p->omega_lt_rad_s) &
+                          (uint32_t)((p->mode_mask & mode_bit) != 0);
+            if (p->cmd_mask == 0) {
+                hits |= ok << i;
+            } else {
+                state_ok |= ok << i;
+            }
+        }
+        g_cond_state_ok[l] = state_ok;
+
+        if (hits != 0) {
+            g_cond_hit[l] |= hits;
+            rung |= hits;
+        }
     }
 
-    // TODO Phase 10: Integrate with global wheel state
-    // For now, unconditional triggers only (simple timeline-based execution)
-    // Condition checking will be added when global wheel state access is available
+    // Doorbell only; a full FIFO means Core0 already has one pending
+    if (rung != 0 && multicore_fifo_wready()) {
+        multicore_fifo_push_blocking(rung);
+    }
+}
+
+static void fire_event(scenario_layer_t* layer, uint8_t i);
 
-    printf("[SCENARIO] Conditional triggers not yet supported (Phase 10)\n");
-    return true; // Simplified for Phase 9 - all conditions pass
+void scenario_nsp_command(uint8_t command) {
+    uint8_t cmd = command & 0x1F;
+    uint32_t save = save_and_disable_interrupts();
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        scenario_layer_t* layer = &g_layers[l];
+        uint32_t slots = layer->cmd_slots[cmd] & g_cond_armed[l];
+        if (slots == 0) {
+            continue;
+        }
+
+        // Core1's state flags are the previous run's until it acks the new one
+        uint32_t ready = layer->cond_stateless;
+        if (g_cond_gen_ack[l] == g_cond_gen[l]) {
+            ready |= g_cond_state_ok[l];
+        }
+        for (uint8_t slot = 0; slots != 0; slot++, slots >>= 1) {
+            uint32_t bit = 1u << slot;
+            if ((slots & 1u) == 0 || (ready & bit) == 0) {
+                continue;  // Not waiting, or speed/mode not (yet) as required
+            }
+            if (++layer->cmd_matches[slot] < layer->predicates[slot].cmd_count) {
+                continue;
+            }
+            g_cond_armed[l] &= ~bit;
+            layer->cmd_slots[cmd] &= ~bit;
+            fire_event(layer, layer->cond_event[slot]);  // Slot order is timeline order
+        }
+    }
+    refresh_cmd_wanted();
+    restore_interrupts(save);
+}
+
+/**
+ * @brief Park a due conditional event (interrupts disabled)
+ *
+ * Events on an NSP command wait in the command hook; the others are
+ * evaluated by Core1.
+ */
+static void arm_condition(scenario_layer_t* layer, uint8_t slot) {
+    uint32_t cmd_mask = layer->predicates[slot].cmd_mask;
+    if (cmd_mask != 0) {
+        uint8_t cmd = (uint8_t)__builtin_ctz(cmd_mask);
+        layer->cmd_matches[slot] = 0;  // Only commands received from now on count
+        layer->cmd_slots[cmd] |= 1u << slot;
+        g_scenario_cmd_wanted |= cmd_mask;
+    }
+    g_cond_armed[layer_index(layer)] |= 1u << slot;
 }
 
 // ============================================================================
 // Timeline Processing
 // ============================================================================
 
-void scenario_update(void) {
-    if (!g_initialized || !g_scenario.active) {
+/**
+ * @brief Fire one event (alarm IRQ or interrupts disabled, no printf)
+ *
+ * Transport and physics actions take effect here, merged with the other
+ * layers'; logging and device actions follow in scenario_update().
+ */
+static void fire_event(scenario_layer_t* layer, uint8_t i) {
+    const scenario_bin_event_t* event = scenario_bin_event(layer->image, i);
+    const scenario_bin_op_t* ops = scenario_bin_ops(event);
+    uint32_t now_ms = sim_now_ms();
+
+    layer->triggered[i >> 5] |= 1u << (i & 31u);
+    layer->trigger_time_ms[i] = now_ms;
+    g_last_event = i;
+    core_sync_ring(CORE_SYNC_BELL_SCENARIO);
+
+    // Layers were computed when the image was built; set active duration
+    if (event->layers & SCENARIO_LAYER_TRANSPORT) {
+        if (event->duration_ms > 0) {
+            layer->transport_end_ms = now_ms + event->duration_ms;
+        } else {
+            layer->transport_end_ms = 0; // Instant/persistent
+        }
+        layer->transport_ops = ops;
+        layer->transport_count = event->op_count;
+        layer->transport_event = i;
+        merge_transport();
+    }
+
+    if ((event->layers & SCENARIO_LAYER_DEVICE) && event->duration_ms > 0) {
+        layer->device_end_ms = now_ms + event->duration_ms;
+    }
+
+    if (event->layers & SCENARIO_LAYER_PHYSICS) {
+        if (event->duration_ms > 0) {
+            layer->physics_end_ms = now_ms + event->duration_ms;
+        } else {
+            layer->physics_end_ms = 0; // Instant/persistent
+        }
+        layer->physics_ops = ops;
+        layer->physics_count = event->op_count;
+        layer->physics_event = i;
+        merge_physics();
+    }
+}
+
+static int64_t scenario_event_alarm_cb(alarm_id_t id, void* user_data) {
+    (void)id;
+    scenario_layer_t* layer = (scenario_layer_t*)user_data;
+    layer->event_alarm = 0;
+    timeline_advance(layer);
+    return 0;  // timeline_advance() arms the next deadline itself
+}
+
+/**
+ * @brief Process every due event at a layer's cursor, then arm its next deadline
+ *
+ * Runs from the layer's event alarm or with interrupts disabled.
+ * Conditional events are armed for Core1 rather than evaluated here.
+ */
+static void timeline_advance(scenario_layer_t* layer) {
+    if (!layer->active || layer->event_alarm > 0) {
         return;
     }
 
-    uint32_t now_ms = to_ms_since_boot(get_absolute_time());
-    uint32_t elapsed_ms = now_ms - g_scenario.activation_time_ms;
+    while (layer->next_event < layer->event_count) {
+        const scenario_bin_event_t* event = scenario_bin_event(layer->image, layer->next_event);
+        int64_t due_us = layer->activation_us + (int64_t)event->t_ms * 1000;
+
+        if ((int64_t)timebase_get_sim_us() < due_us) {
+            if (timebase_get_mode() == TIMEBASE_STEPPED) {
+                return;  // Wall-clock alarm is meaningless: scenario_update() polls
+            }
+            alarm_id_t id = add_alarm_at(from_us_since_boot((uint64_t)due_us),
+                                         scenario_event_alarm_cb, layer, false);
+            if (id > 0) {
+                layer->event_alarm = id;
+                return;  // Armed
+            }
+            if (id < 0) {
+                return;  // No alarm slot: scenario_update() polls instead
+            }
+            continue;  // Deadline passed while arming: due now
+        }
+
+        if (event->has_condition) {
+            arm_condition(layer, layer->next_cond++);
+        } else {
+            fire_event(layer, layer->next_event);
+        }
+        layer->next_event++;
+    }
+}
 
-    // Check for expired duration-based actions
-    if (g_transport_action_end_ms != 0 && now_ms >= g_transport_action_end_ms) {
-        memset(&g_active_transport_action, 0, sizeof(g_active_transport_action));
-        g_transport_action_end_ms = 0;
+/**
+ * @brief Fire a layer's armed events whose condition Core1 reported
+ *        (interrupts disabled)
+ */
+static void fire_condition_hits(scenario_layer_t* layer) {
+    uint8_t l = layer_index(layer);
+    if (!layer->active || g_cond_gen_ack[l] != g_cond_gen[l]) {
+        return;  // Core1 has not dropped the previous run's hits yet
     }
-    if (g_device_action_end_ms != 0 && now_ms >= g_device_action_end_ms) {
-        memset(&g_active_device_action, 0, sizeof(g_active_device_action));
-        g_device_action_end_ms = 0;
+
+    uint32_t hits = g_cond_hit[l] & g_cond_armed[l];
+    g_cond_armed[l] &= ~hits;
+    for (uint8_t slot = 0; hits != 0; slot++, hits >>= 1) {
+        if (hits & 1u) {
+            fire_event(layer, layer->cond_event[slot]);  // Slot order is timeline order
+        }
     }
-    if (g_physics_action_end_ms != 0 && now_ms >= g_physics_action_end_ms) {
-        memset(&g_active_physics_action, 0, sizeof(g_active_physics_action));
-        g_physics_action_end_ms = 0;
+}
+
+/**
+ * @brief Core1 doorbell (SIO FIFO IRQ on Core0)
+ */
+static void scenario_doorbell_isr(void) {
+    while (multicore_fifo_rvalid()) {
+        (void)multicore_fifo_pop_blocking();
     }
+    multicore_fifo_clear_irq();
 
-    // Check for new events to trigger
-    for (uint8_t i = 0; i < g_scenario.event_count; i++) {
-        scenario_event_t* event = &g_scenario.events[i];
+    uint32_t save = save_and_disable_interrupts();
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        fire_condition_hits(&g_layers[l]);
+    }
+    restore_interrupts(save);
+}
 
-        // Skip if already triggered or not yet time
-        if (event->triggered || elapsed_ms < event->t_ms) {
+bool scenario_start_service(void) {
+    if (g_service_started) {
+        return true;
+    }
+
+    // Core1 is running, so the launch handshake no longer owns the FIFO
+    while (multicore_fifo_rvalid()) {
+        (void)multicore_fifo_pop_blocking();
+    }
+    multicore_fifo_clear_irq();
+
+    irq_set_exclusive_handler(SIO_IRQ_PROC0, scenario_doorbell_isr);
+    irq_set_enabled(SIO_IRQ_PROC0, true);
+    g_service_started = true;
+
+    printf("[SCENARIO] Conditional trigger doorbell started\n");
+    return true;
+}
+
+void scenario_update(void) {
+    if (!g_initialized || scenario_get_active_layers() == 0) {
+        return;
+    }
+
+    uint32_t now_ms = sim_now_ms();
+
+    // Check for expired duration-based actions (the event alarms also
+    // write these), then re-merge what changed
+    uint32_t save = save_and_disable_interrupts();
+    bool transport_expired = false;
+    bool physics_expired = false;
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        scenario_layer_t* layer = &g_layers[l];
+        if (!layer->active) {
             continue;
         }
+        if (layer->transport_end_ms != 0 && now_ms >= layer->transport_end_ms) {
+            layer->transport_end_ms = 0;
+            layer->transport_ops = NULL;
+            transport_expired = true;
+        }
+        if (layer->device_end_ms != 0 && now_ms >= layer->device_end_ms) {
+            layer->device_end_ms = 0;
+        }
+        if (layer->physics_end_ms != 0 && now_ms >= layer->physics_end_ms) {
+            layer->physics_end_ms = 0;
+            layer->physics_ops = NULL;
+            physics_expired = true;
+        }
+    }
+    if (transport_expired) {
+        merge_transport();
+    }
+    if (physics_expired) {
+        merge_physics();
+    }
 
-        // Check conditions
-        if (!check_condition(&event->condition)) {
+    // Fallback if no alarm could be armed (no-op while one is pending),
+    // and condition hits the doorbell has not delivered (no service yet)
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        timeline_advance(&g_layers[l]);
+        fire_condition_hits(&g_layers[l]);
+    }
+    restore_interrupts(save);
+
+    // Report fired events and apply their device actions (timeline order
+    // within a layer, layers in index order)
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        scenario_layer_t* layer = &g_layers[l];
+        if (!layer->active) {
             continue;
         }
+        for (uint8_t w = 0; w < EVENT_WORDS; w++) {
+            uint32_t fresh = layer->triggered[w] & ~layer->reported[w];
+            layer->reported[w] |= fresh;
+            for (uint8_t b = 0; fresh != 0; b++, fresh >>= 1) {
+                if ((fresh & 1u) == 0) {
+                    continue;
+                }
+                uint8_t i = (uint8_t)(w * 32u + b);
+                printf("[SCENARIO] Event %d triggered at t=%lu ms (layer %u)\n", i,
+                       layer->trigger_time_ms[i] - layer->activation_time_ms, (unsigned)l);
+
+                const scenario_bin_event_t* event = scenario_bin_event(layer->image, i);
+                if (event->layers & SCENARIO_LAYER_DEVICE) {
+                    scenario_apply_device(scenario_bin_ops(event), event->op_count);
+                }
+            }
+        }
+    }
+}
 
-        // Trigger event
-        event->triggered = true;
-        event->trigger_time_ms = now_ms;
+// ============================================================================
+// Resume (warm restart)
+// ============================================================================
 
-        printf("[SCENARIO] Event %d triggered at t=%lu ms\n", i, elapsed_ms);
+bool scenario_layer_save_resume(uint8_t index, scenario_resume_t* out) {
+    scenario_layer_t* layer = get_layer(index);
+    if (layer == NULL || !layer->active ||
+        layer->image == (const scenario_bin_header_t*)g_ram_image) {
+        return false;
+    }
 
-        // Apply action
-        const scenario_action_t* action = &event->action;
+    uint32_t save = save_and_disable_interrupts();
+    uint32_t now_ms = sim_now_ms();
+    out->image = layer->image;
+    out->image_len = layer->image_len;
+    out->elapsed_us = (uint64_t)((int64_t)timebase_get_sim_us() - layer->activation_us);
+    out->seed = g_seed;
+    for (uint8_t w = 0; w < EVENT_WORDS; w++) {
+        out->triggered[w] = layer->triggered[w];
+    }
 
-        // Determine action layer and set active duration
-        bool has_transport = action->inject_crc_error || action->drop_frames_pct > 0 ||
-                           action->delay_reply_ms > 0 || action->force_nack;
-        bool has_device = action->flip_status_bits_en || action->set_fault_bits_en ||
-                        action->clear_fault_bits_en || action->overspeed_fault || action->trip_lcl;
-        bool has_physics = action->limit_power_en || action->limit_current_en ||
-                         action->limit_speed_en || action->override_torque_en;
+    // Durations left (an action past its end waits for scenario_update())
+    out->transport_event = layer->transport_ops ? layer->transport_event : SCENARIO_NO_EVENT;
+    out->transport_left_ms = 0;
+    if (layer->transport_end_ms != 0) {
+        int32_t left = (int32_t)(layer->transport_end_ms - now_ms);
+        out->transport_left_ms = (left > 0) ? (uint32_t)left : 1u;
+    }
+    out->physics_event = layer->physics_ops ? layer->physics_event : SCENARIO_NO_EVENT;
+    out->physics_left_ms = 0;
+    if (layer->physics_end_ms != 0) {
+        int32_t left = (int32_t)(layer->physics_end_ms - now_ms);
+        out->physics_left_ms = (left > 0) ? (uint32_t)left : 1u;
+    }
+    restore_interrupts(save);
+    return true;
+}
 
-        if (has_transport) {
-            g_active_transport_action = *action;
-            if (event->duration_ms > 0) {
-                g_transport_action_end_ms = now_ms + event->duration_ms;
-            } else {
-                g_transport_action_end_ms = 0; // Instant/persistent
-            }
-        }
+bool scenario_layer_resume(uint8_t index, const scenario_resume_t* resume) {
+    if (!scenario_layer_load_image(index, resume->image, resume->image_len)) {
+        return false;
+    }
+    scenario_layer_t* layer = get_layer(index);
+    if (resume->transport_event != SCENARIO_NO_EVENT && resume->transport_event >= layer->event_count) {
+        return false;
+    }
+    if (resume->physics_event != SCENARIO_NO_EVENT && resume->physics_event >= layer->event_count) {
+        return false;
+    }
 
-        if (has_device) {
-            scenario_apply_device(action);
-            if (event->duration_ms > 0) {
-                g_active_device_action = *action;
-                g_device_action_end_ms = now_ms + event->duration_ms;
-            }
-        }
+    // Fired events were logged and applied before the reset
+    for (uint8_t w = 0; w < EVENT_WORDS; w++) {
+        layer->triggered[w] = resume->triggered[w];
+        layer->reported[w] = resume->triggered[w];
+    }
+    memset(layer->trigger_time_ms, 0, sizeof(layer->trigger_time_ms));
+    layer->next_event = 0;
+    layer->next_cond = 0;
 
-        if (has_physics) {
-            g_active_physics_action = *action;
-            if (event->duration_ms > 0) {
-                g_physics_action_end_ms = now_ms + event->duration_ms;
-            } else {
-                g_physics_action_end_ms = 0; // Instant/persistent
+    if (scenario_get_active_layers() == 0) {
+        begin_run(resume->seed);
+    }
+
+    uint32_t save = save_and_disable_interrupts();
+    g_cond_armed[index] = 0;
+    clear_cmd_waiters(layer);
+    g_cond_gen[index]++;
+    layer->active = true;
+    clear_layer_actions(layer);
+    uint64_t now_us = timebase_get_sim_us();
+    uint32_t now_ms = (uint32_t)(now_us / 1000u);
+    layer->activation_us = (int64_t)now_us - (int64_t)resume->elapsed_us;
+    layer->activation_time_ms = now_ms - (uint32_t)(resume->elapsed_us / 1000u);
+
+    // The actions in effect at the reset, for what was left of them
+    if (resume->transport_event != SCENARIO_NO_EVENT) {
+        const scenario_bin_event_t* event = scenario_bin_event(layer->image, resume->transport_event);
+        layer->transport_ops = scenario_bin_ops(event);
+        layer->transport_count = event->op_count;
+        layer->transport_event = resume->transport_event;
+        layer->transport_end_ms = resume->transport_left_ms ? now_ms + resume->transport_left_ms : 0;
+        merge_transport();
+    }
+    if (resume->physics_event != SCENARIO_NO_EVENT) {
+        const scenario_bin_event_t* event = scenario_bin_event(layer->image, resume->physics_event);
+        layer->physics_ops = scenario_bin_ops(event);
+        layer->physics_count = event->op_count;
+        layer->physics_event = resume->physics_event;
+        layer->physics_end_ms = resume->physics_left_ms ? now_ms + resume->physics_left_ms : 0;
+        merge_physics();
+    }
+
+    // Cursor past every event fired or parked by now; parked conditional
+    // events wait again, events due since the last save fire late
+    while (layer->next_event < layer->event_count) {
+        uint8_t i = layer->next_event;
+        const scenario_bin_event_t* event = scenario_bin_event(layer->image, i);
+        bool fired = (layer->triggered[i >> 5] & (1u << (i & 31u))) != 0;
+        if ((uint64_t)event->t_ms * 1000u > resume->elapsed_us && !fired) {
+            break;
+        }
+        if (event->has_condition) {
+            uint8_t slot = layer->next_cond++;
+            if (!fired) {
+                arm_condition(layer, slot);
             }
+        } else if (!fired) {
+            fire_event(layer, i);
         }
+        layer->next_event++;
     }
+    timeline_advance(layer);
+    restore_interrupts(save);
+    core_sync_ring(CORE_SYNC_BELL_SCENARIO);
+
+    printf("[SCENARIO] Resumed: %s (layer %u at t=%lu ms, seed %lu)\n", layer->image->name,
+           (unsigned)index, (unsigned long)(resume->elapsed_us / 1000u), (unsigned long)g_seed);
+    return true;
 }
 
 // ============================================================================
 // Query Functions
 // ============================================================================
 
-bool scenario_is_active(void) {
-    return g_scenario.active;
+uint8_t scenario_get_active_layers(void) {
+    uint8_t mask = 0;
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        if (g_layers[l].active) {
+            mask |= (uint8_t)(1u << l);
+        }
+    }
+    return mask;
 }
 
-const char* scenario_get_name(void) {
-    return g_scenario.name[0] ? g_scenario.name : NULL;
+bool scenario_layer_is_active(uint8_t index) {
+    const scenario_layer_t* layer = get_layer(index);
+    return layer != NULL && layer->active;
 }
 
-const char* scenario_get_description(void) {
-    return g_scenario.description[0] ? g_scenario.description : NULL;
+const char* scenario_layer_get_name(uint8_t index) {
+    const scenario_layer_t* layer = get_layer(index);
+    return (layer && layer->image && layer->image->name[0]) ? layer->image->name : NULL;
 }
 
-uint32_t scenario_get_elapsed_ms(void) {
-    if (!g_scenario.active) {
+const char* scenario_layer_get_description(uint8_t index) {
+    const scenario_layer_t* layer = get_layer(index);
+    return (layer && layer->image) ? scenario_bin_description(layer->image) : NULL;
+}
+
+uint32_t scenario_layer_get_elapsed_ms(uint8_t index) {
+    const scenario_layer_t* layer = get_layer(index);
+    if (layer == NULL || !layer->active) {
         return 0;
     }
-    uint32_t now_ms = to_ms_since_boot(get_absolute_time());
-    return now_ms - g_scenario.activation_time_ms;
+    uint32_t now_ms = sim_now_ms();
+    return now_ms - layer->activation_time_ms;
 }
 
-uint8_t scenario_get_triggered_count(void) {
+uint8_t scenario_layer_get_triggered_count(uint8_t index) {
+    const scenario_layer_t* layer = get_layer(index);
     uint8_t count = 0;
-    for (uint8_t i = 0; i < g_scenario.event_count; i++) {
-        if (g_scenario.events[i].triggered) {
+    for (uint8_t w = 0; layer != NULL && w < EVENT_WORDS; w++) {
+        for (uint32_t bits = layer->triggered[w]; bits != 0; bits &= bits - 1) {
             count++;
         }
     }
     return count;
 }
 
+uint8_t scenario_layer_get_total_events(uint8_t index) {
+    const scenario_layer_t* layer = get_layer(index);
+    return layer ? layer->event_count : 0;
+}
+
+uint8_t scenario_get_last_event(void) {
+    return (scenario_get_active_layers() != 0) ? g_last_event : SCENARIO_NO_EVENT;
+}
+
+// Single-scenario API: the base layer
+
+bool scenario_load_image(const scenario_bin_header_t* image, size_t len) {
+    return scenario_layer_load_image(SCENARIO_BASE_LAYER, image, len);
+}
+
+const scenario_bin_header_t* scenario_get_image(void) {
+    return scenario_layer_get_image(SCENARIO_BASE_LAYER);
+}
+
+void scenario_unload(void) {
+    scenario_layer_unload(SCENARIO_BASE_LAYER);
+}
+
+bool scenario_activate(void) {
+    return scenario_layer_activate(SCENARIO_BASE_LAYER);
+}
+
+void scenario_deactivate(void) {
+    scenario_layer_deactivate(SCENARIO_BASE_LAYER);
+}
+
+bool scenario_is_active(void) {
+    return scenario_layer_is_active(SCENARIO_BASE_LAYER);
+}
+
+const char* scenario_get_name(void) {
+    return scenario_layer_get_name(SCENARIO_BASE_LAYER);
+}
+
+const char* scenario_get_description(void) {
+    return scenario_layer_get_description(SCENARIO_BASE_LAYER);
+}
+
+uint32_t scenario_get_elapsed_ms(void) {
+    return scenario_layer_get_elapsed_ms(SCENARIO_BASE_LAYER);
+}
+
+uint8_t scenario_get_triggered_count(void) {
+    return scenario_layer_get_triggered_count(SCENARIO_BASE_LAYER);
+}
+
 uint8_t scenario_get_total_events(void) {
-    return g_scenario.event_count;
+    return scenario_layer_get_total_events(SCENARIO_BASE_LAYER);
 }
 
 // ============================================================================
 // Injection Action Applicators
 // ============================================================================
 
-bool scenario_apply_transport(const scenario_action_t* action, uint8_t* packet, size_t* len) {
-    // Use active transport action if available
-    const scenario_action_t* active_action = &g_active_transport_action;
+uint32_t scenario_transport_decide(uint8_t command, uint32_t* delay_us) {
+    // Merged for this command: replies no layer targets go out untouched
+    uint32_t word = g_xport_cmd_word[command & 0x1F];
+    uint32_t decision = 0;
+    if (word == 0) {
+        return 0;
+    }
 
-    // Drop frames
-    if (active_action->drop_frames_pct > 0) {
-        // Simple RNG: use current time
-        uint32_t now = to_ms_since_boot(get_absolute_time());
-        if ((now % 100) < active_action->drop_frames_pct) {
-            printf("[SCENARIO] Frame dropped (%.0f%%)\n", (float)active_action->drop_frames_pct);
-            return false; // Drop this frame
+    // Gilbert-Elliott burst loss: one state step per reply, then a loss
+    // draw with that state's rate
+    if (word & SCENARIO_XPORT_BURST) {
+        uint32_t model = g_xport_burst_model;
+        uint32_t loss = g_xport_burst_loss;
+        if (g_burst_bad) {
+            g_burst_bad = !rng_chance_q16(&g_rng, model >> 16);
+        } else if (rng_chance_q16(&g_rng, model & 0xFFFFu)) {
+            g_burst_bad = true;
+            g_xport_bursts++;
+        }
+        if (rng_chance_q16(&g_rng, g_burst_bad ? (loss >> 16) : (loss & 0xFFFFu))) {
+            g_xport_dropped++;
+            return SCENARIO_XPORT_DROP;
         }
     }
 
-    // Inject CRC error
-    if (active_action->inject_crc_error && *len >= 2) {
-        // Corrupt last 2 bytes (CRC)
-        packet[*len - 2] ^= 0xFF;
-        packet[*len - 1] ^= 0xFF;
-        printf("[SCENARIO] CRC corrupted\n");
+    // Drop frames (independent losses)
+    uint32_t drop_pct = word & SCENARIO_XPORT_DROP_PCT_MASK;
+    if (drop_pct > 0 && rng_chance_pct(&g_rng, drop_pct)) {
+        g_xport_dropped++;
+        return SCENARIO_XPORT_DROP;  // Nothing else matters for a dropped reply
     }
 
-    // Note: delay_reply_ms and force_nack handled by NSP layer
-
-    return true; // Send frame
-}
-
-void scenario_apply_device(const scenario_action_t* action) {
-    // TODO Phase 10: Integrate with wheel state for direct fault injection
-    // For now, just log the actions
-
-    // Flip status bits
-    if (action->flip_status_bits_en) {
-        printf("[SCENARIO] Status bits flip requested: 0x%08lX (not yet implemented)\n", action->flip_status_bits);
+    if (word & SCENARIO_XPORT_FORCE_NACK) {
+        decision |= SCENARIO_XPORT_NACK;
+        g_xport_nacked++;
     }
 
-    // Set fault bits
-    if (action->set_fault_bits_en) {
-        printf("[SCENARIO] Fault bits set requested: 0x%08lX (not yet implemented)\n", action->set_fault_bits);
+    if (word & SCENARIO_XPORT_CRC_ERROR) {
+        decision |= SCENARIO_XPORT_CORRUPT;
+        g_xport_corrupted++;
     }
 
-    // Clear fault bits
-    if (action->clear_fault_bits_en) {
-        printf("[SCENARIO] Fault bits clear requested: 0x%08lX (not yet implemented)\n", action->clear_fault_bits);
+    uint32_t delay_ms = word >> SCENARIO_XPORT_DELAY_SHIFT;
+    if (delay_ms > 0) {
+        decision |= SCENARIO_XPORT_DELAY;
+        if (delay_us) *delay_us = delay_ms * 1000u;
+        g_xport_delayed++;
     }
 
-    // Trigger overspeed fault
-    if (action->overspeed_fault) {
-        printf("[SCENARIO] Overspeed fault requested (not yet implemented)\n");
-    }
+    return decision;
+}
 
-    // Trip LCL
-    if (action->trip_lcl) {
-        printf("[SCENARIO] LCL trip requested (not yet implemented)\n");
-    }
+void scenario_set_seed(uint32_t seed) {
+    g_seed_override = seed;
 }
 
-void scenario_apply_physics(const scenario_action_t* action) {
-    // TODO Phase 10: Integrate with wheel state for physics overrides
-    // For now, just log the actions
+uint32_t scenario_get_seed(void) {
+    return g_seed;
+}
 
-    // Use active physics action if available
-    const scenario_action_t* active_action = &g_active_physics_action;
+uint32_t scenario_get_burst_count(void) {
+    return g_xport_bursts;
+}
 
-    // Override power limit
-    if (active_action->limit_power_en) {
-        printf("[SCENARIO] Power limit override: %.1f W (not yet implemented)\n", active_action->limit_power_w);
-    }
+void scenario_get_transport_stats(uint32_t* dropped, uint32_t* corrupted, uint32_t* nacked,
+                                  uint32_t* delayed) {
+    if (dropped) *dropped = g_xport_dropped;
+    if (corrupted) *corrupted = g_xport_corrupted;
+    if (nacked) *nacked = g_xport_nacked;
+    if (delayed) *delayed = g_xport_delayed;
+}
 
-    // Override current limit
-    if (active_action->limit_current_en) {
-        printf("[SCENARIO] Current limit override: %.1f A (not yet implemented)\n", active_action->limit_current_a);
+/**
+ * @brief Queue a fault-mask command for every wheel (mask carried as float bits)
+ */
+static void send_fault_mask(command_type_t type, uint32_t mask) {
+    float mask_as_float;
+    memcpy(&mask_as_float, &mask, sizeof(float));
+    if (!core_sync_send_wheel_command(CORE_SYNC_WHEEL_ALL, type, mask_as_float, 0.0f)) {
+        printf("[SCENARIO] Device injection dropped (command queue full)\n");
     }
+}
 
-    // Override speed limit
-    if (active_action->limit_speed_en) {
-        printf("[SCENARIO] Speed limit override: %.1f RPM (not yet implemented)\n", active_action->limit_speed_rpm);
+void scenario_apply_device(const scenario_bin_op_t* ops, uint8_t count) {
+    // Fault and LCL actions go to Core1 through the command queue like the
+    // NSP commands that produce them; the status register has no state of
+    // its own to flip (telemetry derives it)
+    for (uint8_t k = 0; k < count; k++) {
+        uint32_t arg = ops[k].arg.u;
+        switch (ops[k].opcode) {
+            case SCENARIO_OP_FLIP_STATUS:
+                printf("[SCENARIO] Status bits flip requested: 0x%08lX (not yet implemented)\n", arg);
+                break;
+            case SCENARIO_OP_SET_FAULT:
+                send_fault_mask(CMD_INJECT_FAULT, arg);
+                break;
+            case SCENARIO_OP_CLEAR_FAULT:
+                send_fault_mask(CMD_CLEAR_FAULT, arg);
+                break;
+            case SCENARIO_OP_OVERSPEED:
+                send_fault_mask(CMD_INJECT_FAULT, FAULT_OVERSPEED);
+                break;
+            case SCENARIO_OP_TRIP_LCL:
+                if (!core_sync_send_wheel_command(CORE_SYNC_WHEEL_ALL, CMD_TRIP_LCL, 0.0f, 0.0f)) {
+                    printf("[SCENARIO] Device injection dropped (command queue full)\n");
+                }
+                break;
+            default:
+                break;  // Other layers
+        }
     }
+}
 
-    // Override torque output
-    if (active_action->override_torque_en) {
-        printf("[SCENARIO] Torque override: %.1f mN·m (not yet implemented)\n", active_action->override_torque_mNm);
-    }
+void scenario_apply_physics(const scenario_bin_op_t* ops, uint8_t count) {
+    physics_override_t ovr;
+    memset(&ovr, 0, sizeof(ovr));
+    add_physics_ops(&ovr, ops, count);
+    core_sync_publish_physics_override(&ovr);
 }
@@ -5,6 +5,12 @@
  * Implements timeline-based fault injection for HIL testing.
  * Scenarios loaded from JSON define timed events that inject errors
  * into transport (CRC, SLIP), device (faults), or physics (limits).
+ *
+ * Up to SCENARIO_LAYERS scenarios run at once, one per layer, each on its
+ * own timeline (a background drop rate under a targeted fault, say). The
+ * actions active in all layers are merged whenever one starts or ends, a
+ * higher layer taking precedence, so the injection paths read one block
+ * per action layer whatever the number of scenarios running.
  */
 
 #ifndef SCENARIO_H
@@ -13,14 +19,16 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include "scenario_bin.h"
 
 // ============================================================================
 // Constants
 // ============================================================================
 
-#define MAX_SCENARIO_NAME_LEN   32
-#define MAX_SCENARIO_DESC_LEN   128
-#define MAX_EVENTS_PER_SCENARIO 32
+#define SCENARIO_NO_EVENT       0xFF    // No event triggered yet
+#define SCENARIO_LAYERS         4       // Concurrently running scenarios
+#define SCENARIO_BASE_LAYER     0       // Layer of the single-scenario API
+#define SCENARIO_EVENT_WORDS    ((MAX_EVENTS_PER_SCENARIO + 31) / 32)  // Bit per event
 
 // ============================================================================
 // Condition Structure
@@ -47,6 +55,7 @@ typedef struct {
     // NSP command condition
     bool check_nsp_cmd;
     uint8_t nsp_cmd_value;   // Trigger on specific NSP command
+    uint8_t nsp_cmd_count;   // On its Nth occurrence (0 or 1 = the first)
 } scenario_condition_t;
 
 // ============================================================================
@@ -66,6 +75,17 @@ typedef struct {
     uint16_t delay_reply_ms;    // Delay reply by N milliseconds
     bool force_nack;            // Force NACK response
 
+    // Gilbert-Elliott burst loss (two-state Markov chain, one step per reply)
+    bool burst_en;
+    float burst_p_enter;        // P(good → bad) per reply
+    float burst_p_exit;         // P(bad → good) per reply
+    float burst_loss_good;      // P(drop) in the good state (default 0)
+    bool burst_loss_bad_en;
+    float burst_loss_bad;       // P(drop) in the bad state (default 1)
+
+    // Transport injections apply only to replies to these commands (0 = all)
+    uint32_t target_cmd_mask;   // Bit per NSP command (& 0x1F)
+
     // Device-layer injections
     bool flip_status_bits_en;
     uint32_t flip_status_bits;  // XOR status register with mask
@@ -101,41 +121,16 @@ typedef struct {
 /**
  * @brief Timed injection event
  *
- * Represents a single event in the scenario timeline.
- * Events are sorted by t_ms for efficient timeline processing.
+ * Parse form of one timeline event. The JSON loader fills one at a time
+ * and compiles it straight into an image with scenario_bin_add_event().
  */
 typedef struct {
     uint32_t t_ms;              // Time offset from scenario activation (ms)
     uint32_t duration_ms;       // How long action persists (0 = instant)
     scenario_condition_t condition;
     scenario_action_t action;
-
-    // Runtime state
-    bool triggered;             // Has this event been triggered?
-    uint32_t trigger_time_ms;   // Absolute time when triggered
 } scenario_event_t;
 
-// ============================================================================
-// Scenario Structure
-// ============================================================================
-
-/**
- * @brief Complete fault injection scenario
- *
- * Loaded from JSON file, contains metadata and event timeline.
- */
-typedef struct {
-    char name[MAX_SCENARIO_NAME_LEN];
-    char description[MAX_SCENARIO_DESC_LEN];
-
-    uint8_t event_count;
-    scenario_event_t events[MAX_EVENTS_PER_SCENARIO];
-
-    // Runtime state
-    bool active;
-    uint32_t activation_time_ms;  // Absolute time when scenario started
-} scenario_t;
-
 // ============================================================================
 // Scenario Engine API
 // ============================================================================
@@ -148,6 +143,9 @@ void scenario_engine_init(void);
 /**
  * @brief Load scenario from JSON string
  *
+ * Parses and compiles it into the engine's RAM image (ad-hoc uploads;
+ * built-in scenarios are loaded with scenario_load_image()).
+ *
  * @param json_str JSON scenario definition
  * @param json_len Length of JSON string
  * @return true if loaded successfully, false on parse error
@@ -155,7 +153,64 @@ void scenario_engine_init(void);
 bool scenario_load(const char* json_str, size_t json_len);
 
 /**
- * @brief Activate currently loaded scenario
+ * @brief Start compiling a scenario into the engine's RAM image
+ *
+ * For incremental uploads: unloads the base layer's scenario and any
+ * layer running the RAM image (deactivating them) and returns a builder on the RAM image to feed with json_stream_feed().
+ * Finish with scenario_load_ram_image().
+ *
+ * @return Builder, or NULL if the engine is not initialized
+ */
+scenario_bin_builder_t* scenario_begin_ram_image(void);
+
+/**
+ * @brief Seal the RAM image and load it into the base layer
+ *
+ * @return true if loaded, false if the scenario did not fit the RAM image
+ */
+bool scenario_load_ram_image(void);
+
+/**
+ * @brief Load a compiled scenario image in place (base layer)
+ *
+ * The image is validated and then used where it lies (flash via XIP, or
+ * RAM); it must stay valid and unchanged until another scenario is loaded.
+ * See scenario_layer_load_image().
+ *
+ * @param image Compiled image (4-byte aligned)
+ * @param len Bytes available at image
+ * @return true if loaded, false if the image is invalid
+ */
+bool scenario_load_image(const scenario_bin_header_t* image, size_t len);
+
+/**
+ * @brief Get the base layer's scenario image
+ *
+ * @return Image (flash or the RAM image of the last JSON upload), or NULL
+ */
+const scenario_bin_header_t* scenario_get_image(void);
+
+/**
+ * @brief Forget the base layer's scenario (deactivating it first)
+ *
+ * Call before the storage under the loaded image is rewritten.
+ */
+void scenario_unload(void);
+
+/**
+ * @brief Compile a parsed event into an image
+ *
+ * Appends the event record, its compiled condition and its ops (ascending
+ * opcode order, units converted) exactly as tools/scenario_compile.py does.
+ *
+ * @param builder Builder started with scenario_bin_begin()
+ * @param event Parsed event
+ * @return true if appended, false if the image is full
+ */
+bool scenario_bin_add_event(scenario_bin_builder_t* builder, const scenario_event_t* event);
+
+/**
+ * @brief Activate the base layer's scenario
  *
  * Starts the timeline from t=0.
  *
@@ -164,94 +219,391 @@ bool scenario_load(const char* json_str, size_t json_len);
 bool scenario_activate(void);
 
 /**
- * @brief Deactivate current scenario
+ * @brief Deactivate the base layer's scenario
  *
- * Stops timeline and clears all active injections.
+ * Stops its timeline and clears its active injections.
  */
 void scenario_deactivate(void);
 
 /**
  * @brief Update scenario timeline
  *
- * Call from main loop (Core0) to check for triggered events.
- * Applies actions when event conditions are met.
+ * Call from main loop (Core0) to check for triggered events in every
+ * layer. Expires timed actions and applies device actions.
  */
 void scenario_update(void);
 
 /**
- * @brief Check if scenario is active
+ * @brief Start the Core1 doorbell for conditional triggers
+ *
+ * Installs the SIO FIFO IRQ on Core0 so an event whose condition Core1
+ * saw hold fires immediately instead of on the next scenario_update().
+ * Call on Core0 after Core1 is launched (the FIFO is used by the launch
+ * handshake until then).
+ *
+ * @return true if the doorbell is running
+ */
+bool scenario_start_service(void);
+
+/**
+ * @brief Evaluate armed conditional triggers (Core1, once per tick)
+ *
+ * Conditions are compiled at load into thresholds in rad/s and a mode
+ * bitmask, so each armed event costs three compares; a layer with nothing
+ * armed costs one load. Matches ring the Core0 doorbell, giving one
+ * tick of trigger latency. For events on an NSP command the result is only
+ * published for scenario_nsp_command(), which fires them.
+ *
+ * @param omega_rad_s Signed wheel speed after this tick (rad/s)
+ * @param mode Control mode after this tick (control_mode_t)
+ */
+void scenario_eval_conditions(float omega_rad_s, uint8_t mode);
+
+/** Bit per NSP command some armed event waits for (see scenario_nsp_cmd_wanted()) */
+extern volatile uint32_t g_scenario_cmd_wanted;
+
+/**
+ * @brief Check whether an armed event waits for an NSP command
+ *
+ * A single load and test, so commands nobody waits for cost nothing in
+ * the dispatch path.
+ *
+ * @param command NSP command code (5 bits)
+ * @return true if scenario_nsp_command() must be called
+ */
+static inline bool scenario_nsp_cmd_wanted(uint8_t command) {
+    return (g_scenario_cmd_wanted & (1u << (command & 0x1F))) != 0;
+}
+
+/**
+ * @brief Count an NSP command for the events waiting on it (Core0 dispatch)
+ *
+ * Called by commands_dispatch_wheel() before the handler runs, only when
+ * scenario_nsp_cmd_wanted(). Each armed nsp_cmd_eq event (of any layer) counts the
+ * command if its speed and mode predicates held on the last tick, and
+ * fires here, synchronously, on its nsp_cmd_count-th match: its transport
+ * injection (forced NACK, drop, corruption, delay) applies to the reply
+ * to this very command, and physics actions are published before it runs.
+ * Device actions and the log follow in scenario_update().
+ *
+ * @param command NSP command code (5 bits)
+ */
+void scenario_nsp_command(uint8_t command);
+
+/**
+ * @brief Check if the base layer's scenario is active
  *
  * @return true if scenario is running
  */
 bool scenario_is_active(void);
 
 /**
- * @brief Get current scenario name
+ * @brief Get the base layer's scenario name
  *
  * @return Scenario name or NULL if no scenario loaded
  */
 const char* scenario_get_name(void);
 
 /**
- * @brief Get current scenario description
+ * @brief Get the base layer's scenario description
  *
  * @return Scenario description or NULL if no scenario loaded
  */
 const char* scenario_get_description(void);
 
 /**
- * @brief Get scenario elapsed time
+ * @brief Get the base layer's elapsed time
  *
  * @return Milliseconds since scenario activation (0 if inactive)
  */
 uint32_t scenario_get_elapsed_ms(void);
 
 /**
- * @brief Get count of triggered events
+ * @brief Get the base layer's count of triggered events
  *
  * @return Number of events that have triggered
  */
 uint8_t scenario_get_triggered_count(void);
 
 /**
- * @brief Get total event count
+ * @brief Get the base layer's total event count
  *
  * @return Total number of events in scenario
  */
 uint8_t scenario_get_total_events(void);
 
+/**
+ * @brief Get the index of the most recently triggered event (any layer)
+ *
+ * Single byte read, safe to call from Core1.
+ *
+ * @return Event index, or SCENARIO_NO_EVENT if none triggered or no layer active
+ */
+uint8_t scenario_get_last_event(void);
+
+// ============================================================================
+// Scenario Layers
+// ============================================================================
+
+/**
+ * @brief Load a compiled scenario image in place into a layer
+ *
+ * As scenario_load_image(); the layer's running scenario is deactivated
+ * first, the other layers keep running.
+ *
+ * @param layer Layer index (0 to SCENARIO_LAYERS - 1)
+ * @param image Compiled image (4-byte aligned)
+ * @param len Bytes available at image
+ * @return true if loaded, false if the image or layer is invalid
+ */
+bool scenario_layer_load_image(uint8_t layer, const scenario_bin_header_t* image, size_t len);
+
+/**
+ * @brief Get a layer's scenario image
+ *
+ * @return Image, or NULL if the layer has none
+ */
+const scenario_bin_header_t* scenario_layer_get_image(uint8_t layer);
+
+/**
+ * @brief Forget a layer's scenario (deactivating it first)
+ */
+void scenario_layer_unload(uint8_t layer);
+
+/**
+ * @brief Activate a layer's scenario
+ *
+ * Starts its timeline from t=0. Activating the first layer starts a run:
+ * the RNG is seeded (scenario_set_seed(), else this scenario's seed) and
+ * the transport counters restart; layers activated while others run join
+ * that run.
+ *
+ * Where layers' actions overlap, the higher layer takes precedence: its
+ * drop rate, reply delay and physics overrides replace the lower layers',
+ * forced NACK and CRC corruption add up, and the burst-loss model is the
+ * highest layer's. Each layer's target_cmds limits only its own transport
+ * action.
+ *
+ * @param layer Layer index
+ * @return true if activated, false if the layer has no scenario or runs
+ */
+bool scenario_layer_activate(uint8_t layer);
+
+/**
+ * @brief Deactivate a layer's scenario
+ *
+ * Stops its timeline and withdraws its actions; the other layers' stay
+ * in effect.
+ */
+void scenario_layer_deactivate(uint8_t layer);
+
+/**
+ * @brief Deactivate every layer
+ */
+void scenario_deactivate_all(void);
+
+/**
+ * @brief Get the layers whose scenario is running
+ *
+ * @return Bit per active layer (0 = no scenario running)
+ */
+uint8_t scenario_get_active_layers(void);
+
+/**
+ * @brief Check if a layer's scenario is active
+ */
+bool scenario_layer_is_active(uint8_t layer);
+
+/**
+ * @brief Get a layer's scenario name
+ *
+ * @return Scenario name or NULL if the layer has none
+ */
+const char* scenario_layer_get_name(uint8_t layer);
+
+/**
+ * @brief Get a layer's scenario description
+ *
+ * @return Scenario description or NULL if the layer has none
+ */
+const char* scenario_layer_get_description(uint8_t layer);
+
+/**
+ * @brief Get a layer's elapsed time
+ *
+ * @return Milliseconds since the layer's activation (0 if inactive)
+ */
+uint32_t scenario_layer_get_elapsed_ms(uint8_t layer);
+
+/**
+ * @brief Get a layer's count of triggered events
+ */
+uint8_t scenario_layer_get_triggered_count(uint8_t layer);
+
+/**
+ * @brief Get a layer's total event count
+ */
+uint8_t scenario_layer_get_total_events(uint8_t layer);
+
+// ============================================================================
+// Resume (warm restart)
+// ============================================================================
+
+/**
+ * @brief Where a running layer is on its timeline
+ *
+ * Enough to pick the run up again after a reset that kept RAM but not
+ * the engine: the image stays where it was (flash), the timeline resumes
+ * at the elapsed time with the same events done and the same actions in
+ * effect for what is left of their duration.
+ */
+typedef struct {
+    const scenario_bin_header_t* image;     // Image in flash (RAM images are lost)
+    uint32_t image_len;
+    uint64_t elapsed_us;                    // Simulation time since activation
+    uint32_t seed;                          // Run seed
+    uint32_t triggered[SCENARIO_EVENT_WORDS];   // Events fired
+    uint8_t transport_event;                // Event driving the transport action (or NO_EVENT)
+    uint8_t physics_event;                  // Event driving the physics action (or NO_EVENT)
+    uint32_t transport_left_ms;             // Left of its duration (0 = until replaced)
+    uint32_t physics_left_ms;
+} scenario_resume_t;
+
+/**
+ * @brief Capture a running layer for scenario_layer_resume()
+ *
+ * @param layer Layer index
+ * @param out Resume point
+ * @return true if captured; false if the layer is idle or runs the RAM
+ *         image (a JSON upload does not survive a reset)
+ */
+bool scenario_layer_save_resume(uint8_t layer, scenario_resume_t* out);
+
+/**
+ * @brief Load and restart a layer from a resume point
+ *
+ * The image is validated again. Events already fired stay done (they are
+ * not logged or applied again), parked conditional events are armed anew
+ * (NSP command counts start over) and the saved actions take effect for
+ * their remaining duration. The first layer resumed restores the run's
+ * seed; the RNG itself restarts from it, so random transport decisions
+ * after the resume do not continue the original sequence.
+ *
+ * @param layer Layer index
+ * @param resume Resume point from scenario_layer_save_resume()
+ * @return true if the layer runs again
+ */
+bool scenario_layer_resume(uint8_t layer, const scenario_resume_t* resume);
+
 // ============================================================================
 // Injection Action Applicators
 // ============================================================================
 
 /**
- * @brief Apply transport-layer injection
+ * @brief Transport injection armed for the NSP reply path
+ *
+ * One aligned word written by the scenario engine (Core0 main loop) and
+ * read by the NSP service IRQ: 0 when no layer has a transport action
+ * active, otherwise the union of the merged per-command SCENARIO_XPORT_*
+ * words scenario_transport_decide() applies.
+ */
+extern volatile uint32_t g_scenario_transport;
+
+#define SCENARIO_XPORT_DROP_PCT_MASK    0x000000FFu  // drop_frames_pct (0-100)
+#define SCENARIO_XPORT_CRC_ERROR        0x00000100u  // inject_crc_error
+#define SCENARIO_XPORT_FORCE_NACK       0x00000200u  // force_nack
+#define SCENARIO_XPORT_BURST            0x00000400u  // Gilbert-Elliott burst loss active
+#define SCENARIO_XPORT_DELAY_SHIFT      16           // delay_reply_ms in bits 16-31
+
+/** Per-reply decisions returned by scenario_transport_decide() */
+#define SCENARIO_XPORT_DROP     0x01u   // Do not send the reply
+#define SCENARIO_XPORT_CORRUPT  0x02u   // Corrupt the reply CRC on the wire
+#define SCENARIO_XPORT_NACK     0x04u   // Answer NACK instead of ACK
+#define SCENARIO_XPORT_DELAY    0x08u   // Hold the reply for *delay_us
+
+/**
+ * @brief Check whether a transport action is active
  *
- * Called from RS-485 TX/RX path to inject errors.
+ * A single load and branch so the nominal reply path stays unpenalized.
+ *
+ * @return true if scenario_transport_decide() must be consulted
+ */
+static inline bool scenario_transport_armed(void) {
+    return g_scenario_transport != 0;
+}
+
+/**
+ * @brief Decide the transport injections for one reply
+ *
+ * Called from the NSP reply path (service IRQ) only when
+ * scenario_transport_armed(). Applies the command's merged transport
+ * word (all layers, one load). No printf; decisions are counted and
+ * reported through scenario_get_transport_stats(). Random drops (burst
+ * model first, then drop_frames_pct) draw from the seeded engine RNG, one
+ * reply at a time, so the same seed and command sequence reproduce them.
+ *
+ * @param command NSP command being answered (for target_cmds)
+ * @param delay_us Output: reply delay when SCENARIO_XPORT_DELAY is set
+ * @return SCENARIO_XPORT_DROP / _CORRUPT / _NACK / _DELAY flags (0 = send as is)
+ */
+uint32_t scenario_transport_decide(uint8_t command, uint32_t* delay_us);
+
+/**
+ * @brief Set the RNG seed for the next run (first layer activated)
+ *
+ * @param seed Seed to replay a run (0 = the scenario's seed, or a fresh
+ *             one per run if the scenario has none)
+ */
+void scenario_set_seed(uint32_t seed);
+
+/**
+ * @brief Get the RNG seed of the current (or last) run
+ *
+ * Logged at activation; set it with scenario_set_seed() to replay the run.
+ *
+ * @return Seed
+ */
+uint32_t scenario_get_seed(void);
+
+/**
+ * @brief Get the number of loss bursts (good → bad transitions) this run
+ *
+ * @return Bursts entered
+ */
+uint32_t scenario_get_burst_count(void);
+
+/**
+ * @brief Get transport injection counters of the current (or last) run
  *
- * @param action Action to apply
- * @param packet Packet buffer (may be modified)
- * @param len Packet length
- * @return true if packet should be sent, false if dropped
+ * @param dropped Output: replies dropped (can be NULL)
+ * @param corrupted Output: replies sent with a bad CRC (can be NULL)
+ * @param nacked Output: replies forced to NACK (can be NULL)
+ * @param delayed Output: replies held for delay_reply_ms (can be NULL)
  */
-bool scenario_apply_transport(const scenario_action_t* action, uint8_t* packet, size_t* len);
+void scenario_get_transport_stats(uint32_t* dropped, uint32_t* corrupted, uint32_t* nacked,
+                                  uint32_t* delayed);
 
 /**
  * @brief Apply device-layer injection
  *
- * Called from device model to inject faults/status changes.
+ * Dispatches on the device-layer opcodes present; others are skipped.
  *
- * @param action Action to apply
+ * @param ops Ops of the triggered event
+ * @param count Number of ops
  */
-void scenario_apply_device(const scenario_action_t* action);
+void scenario_apply_device(const scenario_bin_op_t* ops, uint8_t count);
 
 /**
- * @brief Apply physics-layer injection
+ * @brief Publish physics-layer injection to Core1
  *
- * Called from physics tick to override limits/outputs.
+ * Copies the physics-layer ops (already in model units) into the
+ * core_sync override block; Core1 picks them up on its next tick. The
+ * engine publishes the merge of all layers' physics actions itself; this
+ * replaces them until the next action starts or ends.
  *
- * @param action Action to apply
+ * @param ops Ops of the triggered event (NULL clears all overrides)
+ * @param count Number of ops
  */
-void scenario_apply_physics(const scenario_action_t* action);
+void scenario_apply_physics(const scenario_bin_op_t* ops, uint8_t count);
 
 #endif // SCENARIO_H
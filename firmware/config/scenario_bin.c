@@ -0,0 +1,301 @@
+/**
+ * @file scenario_bin.c
+ * @brief Compiled Binary Scenario Format Implementation
+ */
+
+#include "scenario_bin.h"
+#include "scenario.h"
+#include "../device/nss_nrwa_t6_model.h"
+#include "../drivers/crc_ccitt.h"
+#include <math.h>
+#include <string.h>
+
+// ============================================================================
+// Validation
+// ============================================================================
+
+static bool opcode_valid(uint8_t op) {
+    switch (op) {
+        case SCENARIO_OP_CRC_ERROR:
+        case SCENARIO_OP_DROP_FRAMES:
+        case SCENARIO_OP_DELAY_REPLY:
+        case SCENARIO_OP_FORCE_NACK:
+        case SCENARIO_OP_BURST_MODEL:
+        case SCENARIO_OP_BURST_LOSS:
+        case SCENARIO_OP_TARGET_CMDS:
+        case SCENARIO_OP_FLIP_STATUS:
+        case SCENARIO_OP_SET_FAULT:
+        case SCENARIO_OP_CLEAR_FAULT:
+        case SCENARIO_OP_OVERSPEED:
+        case SCENARIO_OP_TRIP_LCL:
+        case SCENARIO_OP_LIMIT_POWER:
+        case SCENARIO_OP_LIMIT_CURRENT:
+        case SCENARIO_OP_LIMIT_SPEED:
+        case SCENARIO_OP_OVERRIDE_TORQUE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+const char* scenario_bin_validate(const void* image, size_t len) {
+    const scenario_bin_header_t* h = (const scenario_bin_header_t*)image;
+    const uint8_t* bytes = (const uint8_t*)image;
+
+    if (image == NULL || ((uintptr_t)image & 3u) != 0) {
+        return "misaligned";
+    }
+    if (len < SCENARIO_BIN_HEADER_SIZE || h->magic != SCENARIO_BIN_MAGIC) {
+        return "bad magic";
+    }
+    if (h->version != SCENARIO_BIN_VERSION) {
+        return "unsupported version";
+    }
+    if (h->total_len > len || h->total_len < SCENARIO_BIN_HEADER_SIZE) {
+        return "truncated";
+    }
+    if (memchr(h->name, '\0', sizeof(h->name)) == NULL) {
+        return "unterminated name";
+    }
+    if (h->desc_offset != 0) {
+        const char* desc = (const char*)image + h->desc_offset;
+        if (h->desc_len == 0 || (uint32_t)h->desc_offset + h->desc_len > h->total_len ||
+            desc[h->desc_len - 1] != '\0') {
+            return "bad description";
+        }
+    }
+
+    uint16_t crc = crc_ccitt_calculate(bytes + SCENARIO_BIN_CRC_START,
+                                       h->total_len - SCENARIO_BIN_CRC_START);
+    if (crc != h->crc) {
+        return "CRC mismatch";
+    }
+
+    // Records live between the header and the index
+    if (h->event_count > MAX_EVENTS_PER_SCENARIO ||
+        h->condition_count > MAX_SCENARIO_CONDITIONS ||
+        h->index_offset < SCENARIO_BIN_HEADER_SIZE || (h->index_offset & 1u) != 0 ||
+        (uint32_t)h->index_offset + 2u * h->event_count > h->total_len) {
+        return "bad event count";
+    }
+
+    const uint16_t* index = (const uint16_t*)(bytes + h->index_offset);
+    uint8_t conditions = 0;
+    uint32_t prev_t = 0;
+    for (uint8_t i = 0; i < h->event_count; i++) {
+        uint16_t offset = index[i];
+        if (offset < SCENARIO_BIN_HEADER_SIZE || (offset & 3u) != 0 ||
+            (uint32_t)offset + sizeof(scenario_bin_event_t) > h->index_offset) {
+            return "bad event offset";
+        }
+
+        const scenario_bin_event_t* ev = (const scenario_bin_event_t*)(bytes + offset);
+        uint32_t end = offset + sizeof(scenario_bin_event_t) +
+                       (ev->has_condition ? sizeof(scenario_bin_condition_t) : 0) +
+                       (uint32_t)ev->op_count * sizeof(scenario_bin_op_t);
+        if (end > h->index_offset) {
+            return "bad event record";
+        }
+        if (i > 0 && ev->t_ms < prev_t) {
+            return "index not sorted";
+        }
+        prev_t = ev->t_ms;
+        if (ev->has_condition) {
+            conditions++;
+        }
+
+        const scenario_bin_op_t* ops = scenario_bin_ops(ev);
+        uint8_t layers = 0;
+        for (uint8_t k = 0; k < ev->op_count; k++) {
+            if (!opcode_valid(ops[k].opcode)) {
+                return "unknown opcode";
+            }
+            layers |= (uint8_t)SCENARIO_OP_LAYER(ops[k].opcode);
+        }
+        if (layers != ev->layers) {
+            return "bad layer mask";
+        }
+    }
+    if (conditions != h->condition_count) {
+        return "bad condition count";
+    }
+
+    return NULL;
+}
+
+// ============================================================================
+// Builder (JSON uploads; tools/scenario_compile.py for built-ins)
+// ============================================================================
+
+#define SCENARIO_MAX_EVENT_OPS  16      // One of each opcode
+
+void scenario_bin_begin(scenario_bin_builder_t* builder, void* buf, size_t cap) {
+    memset(builder, 0, sizeof(*builder));
+    builder->buf = (uint8_t*)buf;
+    builder->cap = cap;
+    builder->len = SCENARIO_BIN_HEADER_SIZE;
+    builder->overflow = (((uintptr_t)buf & 3u) != 0) || cap < SCENARIO_BIN_HEADER_SIZE;
+}
+
+static void compile_condition(const scenario_condition_t* cond, scenario_bin_condition_t* out) {
+    memset(out, 0, sizeof(*out));
+    out->omega_gt_rad_s = cond->check_rpm_gt ? cond->rpm_gt * RPM_TO_RAD_S : -INFINITY;
+    out->omega_lt_rad_s = cond->check_rpm_lt ? cond->rpm_lt * RPM_TO_RAD_S : INFINITY;
+    out->cmd_mask = cond->check_nsp_cmd ? (1u << (cond->nsp_cmd_value & 0x1F)) : 0;
+    out->mode_mask = cond->check_mode ? (uint8_t)(1u << (cond->mode_value & 0x07)) : 0xFF;
+    out->cmd_count = cond->check_nsp_cmd ? cond->nsp_cmd_count : 0;
+}
+
+/**
+ * @brief Probability (0..1, clamped) to Q16
+ */
+static uint32_t to_q16(float p) {
+    if (!(p > 0.0f)) return 0;
+    if (p >= 1.0f) return SCENARIO_Q16_ONE;
+    return (uint32_t)(p * 65535.0f + 0.5f);
+}
+
+/**
+ * @brief Compile an action into ops, ascending opcode order
+ *
+ * @return Number of ops written (at most SCENARIO_MAX_EVENT_OPS)
+ */
+static uint8_t compile_action(const scenario_action_t* action, scenario_bin_op_t* ops) {
+    uint8_t n = 0;
+
+#define EMIT_U(code, value) do { ops[n].opcode = (code); ops[n].arg.u = (value); n++; } while (0)
+#define EMIT_F(code, value) do { ops[n].opcode = (code); ops[n].arg.f = (value); n++; } while (0)
+
+    if (action->inject_crc_error)       EMIT_U(SCENARIO_OP_CRC_ERROR, 0);
+    if (action->drop_frames_pct > 0)    EMIT_U(SCENARIO_OP_DROP_FRAMES, action->drop_frames_pct);
+    if (action->delay_reply_ms > 0)     EMIT_U(SCENARIO_OP_DELAY_REPLY, action->delay_reply_ms);
+    if (action->force_nack)             EMIT_U(SCENARIO_OP_FORCE_NACK, 0);
+    if (action->burst_en) {
+        float loss_bad = action->burst_loss_bad_en ? action->burst_loss_bad : 1.0f;
+        EMIT_U(SCENARIO_OP_BURST_MODEL, to_q16(action->burst_p_enter) |
+                                        (to_q16(action->burst_p_exit) << 16));
+        EMIT_U(SCENARIO_OP_BURST_LOSS, to_q16(action->burst_loss_good) | (to_q16(loss_bad) << 16));
+    }
+    if (action->target_cmd_mask != 0)   EMIT_U(SCENARIO_OP_TARGET_CMDS, action->target_cmd_mask);
+    if (action->flip_status_bits_en)    EMIT_U(SCENARIO_OP_FLIP_STATUS, action->flip_status_bits);
+    if (action->set_fault_bits_en)      EMIT_U(SCENARIO_OP_SET_FAULT, action->set_fault_bits);
+    if (action->clear_fault_bits_en)    EMIT_U(SCENARIO_OP_CLEAR_FAULT, action->clear_fault_bits);
+    if (action->overspeed_fault)        EMIT_U(SCENARIO_OP_OVERSPEED, 0);
+    if (action->trip_lcl)               EMIT_U(SCENARIO_OP_TRIP_LCL, 0);
+    if (action->limit_power_en)         EMIT_F(SCENARIO_OP_LIMIT_POWER, action->limit_power_w);
+    if (action->limit_current_en)       EMIT_F(SCENARIO_OP_LIMIT_CURRENT, action->limit_current_a);
+    if (action->limit_speed_en)         EMIT_F(SCENARIO_OP_LIMIT_SPEED,
+                                               action->limit_speed_rpm * RPM_TO_RAD_S);
+    if (action->override_torque_en)     EMIT_F(SCENARIO_OP_OVERRIDE_TORQUE,
+                                               action->override_torque_mNm);
+
+#undef EMIT_U
+#undef EMIT_F
+
+    return n;
+}
+
+bool scenario_bin_add_event(scenario_bin_builder_t* builder, const scenario_event_t* event) {
+    if (builder->overflow) {
+        return false;
+    }
+
+    const scenario_condition_t* c = &event->condition;
+    bool conditional = c->check_mode || c->check_rpm_gt || c->check_rpm_lt || c->check_nsp_cmd;
+
+    scenario_bin_op_t ops[SCENARIO_MAX_EVENT_OPS];
+    memset(ops, 0, sizeof(ops));
+    uint8_t op_count = compile_action(&event->action, ops);
+
+    size_t size = sizeof(scenario_bin_event_t) +
+                  (conditional ? sizeof(scenario_bin_condition_t) : 0) +
+                  op_count * sizeof(scenario_bin_op_t);
+    if (builder->event_count >= MAX_EVENTS_PER_SCENARIO ||
+        (conditional && builder->condition_count >= MAX_SCENARIO_CONDITIONS) ||
+        builder->len + size > builder->cap) {
+        builder->overflow = true;
+        return false;
+    }
+
+    uint8_t* p = builder->buf + builder->len;
+    scenario_bin_event_t* rec = (scenario_bin_event_t*)p;
+    memset(rec, 0, sizeof(*rec));
+    rec->t_ms = event->t_ms;
+    rec->duration_ms = event->duration_ms;
+    rec->op_count = op_count;
+    rec->has_condition = conditional ? 1 : 0;
+    for (uint8_t k = 0; k < op_count; k++) {
+        rec->layers |= (uint8_t)SCENARIO_OP_LAYER(ops[k].opcode);
+    }
+    p += sizeof(*rec);
+
+    if (conditional) {
+        compile_condition(c, (scenario_bin_condition_t*)p);
+        p += sizeof(scenario_bin_condition_t);
+        builder->condition_count++;
+    }
+    memcpy(p, ops, op_count * sizeof(scenario_bin_op_t));
+
+    builder->len += size;
+    builder->event_count++;
+    return true;
+}
+
+size_t scenario_bin_finish(scenario_bin_builder_t* builder) {
+    if (builder->overflow) {
+        return 0;
+    }
+
+    uint8_t* bytes = builder->buf;
+    uint8_t count = builder->event_count;
+    size_t index_offset = builder->len;
+    size_t index_end = (index_offset + 2u * count + 3u) & ~(size_t)3u;
+
+    const char* nul = memchr(builder->description, '\0', sizeof(builder->description));
+    size_t desc_len = nul ? (size_t)(nul - builder->description) : sizeof(builder->description) - 1;
+    size_t total = index_end + (desc_len > 0 ? desc_len + 1 : 0);
+    total = (total + 3u) & ~(size_t)3u;
+    if (total > builder->cap || total > UINT16_MAX) {
+        return 0;
+    }
+    memset(bytes + index_offset, 0, total - index_offset);
+
+    // Timeline order (stable insertion sort: equal t_ms keep file order)
+    uint16_t* index = (uint16_t*)(bytes + index_offset);
+    size_t offset = SCENARIO_BIN_HEADER_SIZE;
+    for (uint8_t i = 0; i < count; i++) {
+        const scenario_bin_event_t* ev = (const scenario_bin_event_t*)(bytes + offset);
+        uint8_t j = i;
+        while (j > 0 && ((const scenario_bin_event_t*)(bytes + index[j - 1]))->t_ms > ev->t_ms) {
+            index[j] = index[j - 1];
+            j--;
+        }
+        index[j] = (uint16_t)offset;
+        offset += sizeof(*ev) + (ev->has_condition ? sizeof(scenario_bin_condition_t) : 0) +
+                  (size_t)ev->op_count * sizeof(scenario_bin_op_t);
+    }
+
+    scenario_bin_header_t* h = (scenario_bin_header_t*)bytes;
+    memset(h, 0, sizeof(*h));
+    h->magic = SCENARIO_BIN_MAGIC;
+    h->version = SCENARIO_BIN_VERSION;
+    h->total_len = (uint32_t)total;
+    h->event_count = count;
+    h->condition_count = builder->condition_count;
+    h->index_offset = (uint16_t)index_offset;
+    size_t name_len = strlen(builder->name);
+    if (name_len > sizeof(h->name) - 1) {
+        name_len = sizeof(h->name) - 1;
+    }
+    memcpy(h->name, builder->name, name_len);   // Header zeroed: stays NUL-terminated
+    h->seed = builder->seed;
+
+    if (desc_len > 0) {
+        h->desc_offset = (uint16_t)index_end;
+        h->desc_len = (uint16_t)(desc_len + 1);
+        memcpy(bytes + index_end, builder->description, desc_len);
+    }
+
+    h->crc = crc_ccitt_calculate(bytes + SCENARIO_BIN_CRC_START, total - SCENARIO_BIN_CRC_START);
+    return total;
+}
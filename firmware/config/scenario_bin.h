@@ -0,0 +1,244 @@
+/**
+ * @file scenario_bin.h
+ * @brief Compiled Binary Scenario Format
+ *
+ * Flat, position-independent image of a scenario that the engine runs
+ * directly, from flash (XIP) or RAM, with no parsing. Built-in scenarios
+ * are compiled from the JSON files in tests/scenarios at build time by
+ * tools/scenario_compile.py; JSON uploads are compiled into a RAM image by
+ * the builder (scenario_bin_begin(), scenario_bin_add_event() in
+ * scenario.h, scenario_bin_finish()).
+ *
+ * Layout (little-endian, every field naturally aligned):
+ *
+ *   scenario_bin_header_t                      (SCENARIO_BIN_HEADER_SIZE)
+ *   event records, in file order:
+ *     scenario_bin_event_t
+ *     scenario_bin_condition_t                 (only if has_condition)
+ *     scenario_bin_op_t[op_count]
+ *   uint16_t index[event_count]                (record offsets sorted by
+ *                                               t_ms, stable; padded to 4)
+ *   description, NUL-terminated                (optional, desc_offset)
+ *
+ * An action is a list of opcodes with one 32-bit operand each, so an event
+ * costs 12 bytes plus 8 per injection. The layer bitmask of every event is
+ * computed when the image is built. Conditions are stored compiled: speed
+ * thresholds in rad/s, a control-mode bitmask, an NSP command bit and the
+ * occurrence of that command to fire on.
+ * Randomized injections (frame drops, burst loss) draw from the engine's
+ * seeded RNG, so a run is reproduced by reusing its seed.
+ *
+ * The CRC (CRC-16 CCITT, as on the NSP wire) covers every byte after the
+ * crc field up to total_len. tools/scenario_compile.py mirrors this file;
+ * bump SCENARIO_BIN_VERSION in both when the layout changes.
+ */
+
+#ifndef SCENARIO_BIN_H
+#define SCENARIO_BIN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Format Constants
+// ============================================================================
+
+#define MAX_SCENARIO_NAME_LEN   32
+#define MAX_SCENARIO_DESC_LEN   128
+#define MAX_EVENTS_PER_SCENARIO 128     // Timeline positions are uint8_t
+#define MAX_SCENARIO_CONDITIONS 32      // Conditional events (Core1 bitmask)
+
+#define SCENARIO_BIN_MAGIC          0x4E43534Eu     // "NSCN"
+#define SCENARIO_BIN_VERSION        3
+#define SCENARIO_BIN_CRC_START      8               // First byte covered by crc
+
+/** RAM image for JSON uploads (~80 single-injection events) */
+#ifndef SCENARIO_RAM_IMAGE_SIZE
+#define SCENARIO_RAM_IMAGE_SIZE     2048
+#endif
+
+// ============================================================================
+// Opcodes
+// ============================================================================
+
+// High nibble selects the layer (SCENARIO_OP_LAYER)
+#define SCENARIO_OP_CRC_ERROR       0x01    // No operand
+#define SCENARIO_OP_DROP_FRAMES     0x02    // arg.u: percent (1-100)
+#define SCENARIO_OP_DELAY_REPLY     0x03    // arg.u: milliseconds
+#define SCENARIO_OP_FORCE_NACK      0x04    // No operand
+#define SCENARIO_OP_BURST_MODEL     0x05    // arg.u: P(good→bad) Q16 | P(bad→good) Q16 << 16
+#define SCENARIO_OP_BURST_LOSS      0x06    // arg.u: P(loss|good) Q16 | P(loss|bad) Q16 << 16
+#define SCENARIO_OP_TARGET_CMDS     0x07    // arg.u: bit per targeted NSP command (& 0x1F)
+#define SCENARIO_OP_FLIP_STATUS     0x10    // arg.u: XOR mask
+#define SCENARIO_OP_SET_FAULT       0x11    // arg.u: bits to set
+#define SCENARIO_OP_CLEAR_FAULT     0x12    // arg.u: bits to clear
+#define SCENARIO_OP_OVERSPEED       0x13    // No operand
+#define SCENARIO_OP_TRIP_LCL        0x14    // No operand
+#define SCENARIO_OP_LIMIT_POWER     0x20    // arg.f: W
+#define SCENARIO_OP_LIMIT_CURRENT   0x21    // arg.f: A
+#define SCENARIO_OP_LIMIT_SPEED     0x22    // arg.f: rad/s (converted from RPM)
+#define SCENARIO_OP_OVERRIDE_TORQUE 0x23    // arg.f: mN·m
+
+#define SCENARIO_LAYER_TRANSPORT    (1u << 0)
+#define SCENARIO_LAYER_DEVICE       (1u << 1)
+#define SCENARIO_LAYER_PHYSICS      (1u << 2)
+
+#define SCENARIO_OP_LAYER(op)       (1u << ((op) >> 4))
+
+/** Probabilities are stored as Q16 fractions; 0xFFFF means always */
+#define SCENARIO_Q16_ONE            0xFFFFu
+
+// ============================================================================
+// Image Records
+// ============================================================================
+
+/**
+ * @brief Image header
+ */
+typedef struct {
+    uint32_t magic;             // SCENARIO_BIN_MAGIC
+    uint16_t version;           // SCENARIO_BIN_VERSION
+    uint16_t crc;               // CRC-16 CCITT of bytes [SCENARIO_BIN_CRC_START, total_len)
+    uint32_t total_len;         // Whole image in bytes
+    uint8_t event_count;        // Event records
+    uint8_t condition_count;    // Records with has_condition set
+    uint16_t index_offset;      // Sorted record index from image start
+    uint16_t desc_offset;       // Description from image start (0 = none)
+    uint16_t desc_len;          // Description length including the NUL
+    char name[MAX_SCENARIO_NAME_LEN];  // NUL-terminated
+    uint32_t seed;              // Fault-injection RNG seed (0 = fresh seed per run)
+} scenario_bin_header_t;
+
+/**
+ * @brief Event record (followed by its condition and ops)
+ */
+typedef struct {
+    uint32_t t_ms;              // Offset from activation (ms)
+    uint32_t duration_ms;       // How long the action persists (0 = instant)
+    uint8_t op_count;           // Ops following the record
+    uint8_t layers;             // SCENARIO_LAYER_* of those ops
+    uint8_t has_condition;      // A scenario_bin_condition_t follows
+    uint8_t reserved;
+} scenario_bin_event_t;
+
+/**
+ * @brief Compiled trigger condition (unchecked fields always pass)
+ */
+typedef struct {
+    float omega_gt_rad_s;       // Speed > this (-INFINITY if unchecked)
+    float omega_lt_rad_s;       // Speed < this (+INFINITY if unchecked)
+    uint32_t cmd_mask;          // Bit of the NSP command to wait for (0 = any)
+    uint8_t mode_mask;          // Accepted control modes, bit per control_mode_t
+    uint8_t cmd_count;          // Fire on this match of the command (0 or 1 = first)
+    uint8_t reserved[2];
+} scenario_bin_condition_t;
+
+/**
+ * @brief One injection: opcode and operand
+ */
+typedef struct {
+    uint8_t opcode;             // SCENARIO_OP_*
+    uint8_t reserved[3];
+    union {
+        uint32_t u;
+        float f;
+    } arg;
+} scenario_bin_op_t;
+
+#define SCENARIO_BIN_HEADER_SIZE    56
+
+_Static_assert(sizeof(scenario_bin_header_t) == SCENARIO_BIN_HEADER_SIZE,
+               "scenario_bin_header_t layout must match tools/scenario_compile.py");
+_Static_assert(sizeof(scenario_bin_event_t) == 12 && sizeof(scenario_bin_condition_t) == 16 &&
+               sizeof(scenario_bin_op_t) == 8,
+               "scenario_bin record layout must match tools/scenario_compile.py");
+
+// ============================================================================
+// Image Access (validated images only)
+// ============================================================================
+
+/**
+ * @brief Event at timeline position i (sorted by t_ms)
+ */
+static inline const scenario_bin_event_t* scenario_bin_event(const scenario_bin_header_t* image,
+                                                             uint8_t i) {
+    const uint16_t* index = (const uint16_t*)((const uint8_t*)image + image->index_offset);
+    return (const scenario_bin_event_t*)((const uint8_t*)image + index[i]);
+}
+
+/**
+ * @brief Condition of an event (NULL if unconditional)
+ */
+static inline const scenario_bin_condition_t* scenario_bin_condition(const scenario_bin_event_t* event) {
+    return event->has_condition ? (const scenario_bin_condition_t*)(event + 1) : NULL;
+}
+
+/**
+ * @brief Ops of an event (event->op_count entries)
+ */
+static inline const scenario_bin_op_t* scenario_bin_ops(const scenario_bin_event_t* event) {
+    const uint8_t* p = (const uint8_t*)(event + 1);
+    if (event->has_condition) {
+        p += sizeof(scenario_bin_condition_t);
+    }
+    return (const scenario_bin_op_t*)p;
+}
+
+/**
+ * @brief Description of an image (NULL if none)
+ */
+static inline const char* scenario_bin_description(const scenario_bin_header_t* image) {
+    return image->desc_offset ? (const char*)image + image->desc_offset : NULL;
+}
+
+/**
+ * @brief Check magic, version, bounds, records, index order and CRC
+ *
+ * @param image Image (4-byte aligned)
+ * @param len Bytes available at image
+ * @return Error description, or NULL if the image is valid
+ */
+const char* scenario_bin_validate(const void* image, size_t len);
+
+// ============================================================================
+// Builder
+// ============================================================================
+
+/**
+ * @brief Incremental image builder
+ *
+ * Records are appended in file order as they are parsed, so no parse-form
+ * copy of the whole scenario is kept. Name and description may be filled
+ * in at any point before scenario_bin_finish().
+ */
+typedef struct {
+    uint8_t* buf;               // Output (4-byte aligned)
+    size_t cap;                 // Capacity of buf
+    size_t len;                 // Bytes written
+    uint8_t event_count;
+    uint8_t condition_count;
+    bool overflow;              // An event did not fit
+    uint32_t seed;              // Header seed (0 = fresh seed per run)
+    char name[MAX_SCENARIO_NAME_LEN];
+    char description[MAX_SCENARIO_DESC_LEN];
+} scenario_bin_builder_t;
+
+/**
+ * @brief Start an image
+ *
+ * @param builder Builder state
+ * @param buf Output buffer (4-byte aligned)
+ * @param cap Capacity of buf
+ */
+void scenario_bin_begin(scenario_bin_builder_t* builder, void* buf, size_t cap);
+
+/**
+ * @brief Append the sorted index and description, then seal the header
+ *
+ * @param builder Builder state
+ * @return Image length, or 0 if the scenario did not fit
+ */
+size_t scenario_bin_finish(scenario_bin_builder_t* builder);
+
+#endif // SCENARIO_BIN_H
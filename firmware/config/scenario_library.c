@@ -0,0 +1,149 @@
+/**
+ * @file scenario_library.c
+ * @brief User Scenario Library in Flash Implementation
+ */
+
+#include "scenario_library.h"
+#include "scenario.h"
+#include "board_pico.h"
+#include "../util/flash_store.h"
+#include <stdio.h>
+#include <string.h>
+
+_Static_assert(FLASH_SCENARIO_SIZE / FLASH_SECTOR_SIZE == SCENARIO_LIBRARY_SLOTS,
+               "one library slot per reserved flash sector");
+_Static_assert(FLASH_SECTOR_SIZE == FLASH_STORE_SECTOR_SIZE, "flash sector size mismatch");
+
+// ============================================================================
+// Catalog (RAM index of the flash slots)
+// ============================================================================
+
+static scenario_entry_t g_slots[SCENARIO_LIBRARY_SLOTS];
+static uint8_t g_used = 0;
+
+static uint32_t slot_offset(uint8_t slot) {
+    return FLASH_SCENARIO_OFFSET + (uint32_t)slot * FLASH_SECTOR_SIZE;
+}
+
+/**
+ * @brief Re-read one slot from flash into the catalog
+ */
+static void scan_slot(uint8_t slot) {
+    const scenario_bin_header_t* image = FLASH_STORE_XIP(slot_offset(slot));
+    scenario_entry_t* e = &g_slots[slot];
+
+    if (e->image != NULL) {
+        g_used--;
+    }
+    memset(e, 0, sizeof(*e));
+
+    if (scenario_bin_validate(image, FLASH_SECTOR_SIZE) == NULL) {
+        e->name = image->name;
+        e->image = image;
+        e->image_len = image->total_len;
+        g_used++;
+    }
+}
+
+/**
+ * @brief Forget the scenarios loaded from a slot about to change
+ */
+static const char* release_slot(uint8_t slot) {
+    if (scenario_get_active_layers() != 0) {
+        return "a scenario is running";
+    }
+    const uint8_t* base = (const uint8_t*)FLASH_STORE_XIP(slot_offset(slot));
+    for (uint8_t layer = 0; layer < SCENARIO_LAYERS; layer++) {
+        const uint8_t* loaded = (const uint8_t*)scenario_layer_get_image(layer);
+        if (loaded >= base && loaded < base + FLASH_SECTOR_SIZE) {
+            scenario_layer_unload(layer);
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// Library API
+// ============================================================================
+
+void scenario_library_init(void) {
+    memset(g_slots, 0, sizeof(g_slots));
+    g_used = 0;
+    for (uint8_t slot = 0; slot < SCENARIO_LIBRARY_SLOTS; slot++) {
+        scan_slot(slot);
+    }
+    printf("[LIBRARY] %u/%u user scenario slots in use\n", (unsigned)g_used,
+           (unsigned)SCENARIO_LIBRARY_SLOTS);
+}
+
+const scenario_entry_t* scenario_library_get(uint8_t slot) {
+    if (slot >= SCENARIO_LIBRARY_SLOTS || g_slots[slot].image == NULL) {
+        return NULL;
+    }
+    return &g_slots[slot];
+}
+
+uint8_t scenario_library_count(void) {
+    return g_used;
+}
+
+const char* scenario_library_store(const scenario_bin_header_t* image, size_t len, uint8_t* slot_out) {
+    const char* error = scenario_bin_validate(image, len);
+    if (error != NULL) {
+        return error;
+    }
+    len = image->total_len;
+    if (len > FLASH_SECTOR_SIZE) {
+        return "image larger than a slot";
+    }
+
+    // Same name replaces, otherwise first free slot
+    uint8_t slot = SCENARIO_LIBRARY_SLOTS;
+    for (uint8_t i = 0; i < SCENARIO_LIBRARY_SLOTS; i++) {
+        if (g_slots[i].image != NULL && strcmp(g_slots[i].name, image->name) == 0) {
+            slot = i;
+            break;
+        }
+        if (g_slots[i].image == NULL && slot == SCENARIO_LIBRARY_SLOTS) {
+            slot = i;
+        }
+    }
+    if (slot == SCENARIO_LIBRARY_SLOTS) {
+        return "library full";
+    }
+
+    error = release_slot(slot);
+    if (error != NULL) {
+        return error;
+    }
+    if (!flash_store_write(slot_offset(slot), image, len)) {
+        return "flash write failed";
+    }
+
+    scan_slot(slot);
+    if (g_slots[slot].image == NULL) {
+        return "flash verify failed";
+    }
+    if (slot_out) *slot_out = slot;
+    return NULL;
+}
+
+const char* scenario_library_erase(uint8_t slot) {
+    if (slot >= SCENARIO_LIBRARY_SLOTS) {
+        return "invalid slot";
+    }
+    if (g_slots[slot].image == NULL) {
+        return NULL;  // Already empty
+    }
+
+    const char* error = release_slot(slot);
+    if (error != NULL) {
+        return error;
+    }
+    if (!flash_store_write(slot_offset(slot), NULL, 0)) {
+        return "flash write failed";
+    }
+
+    scan_slot(slot);
+    return NULL;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file scenario_library.h
+ * @brief User Scenario Library in Flash
+ *
+ * Compiled scenario images uploaded at runtime, kept in the flash
+ * partition reserved by FLASH_SCENARIO_OFFSET / FLASH_SCENARIO_SIZE
+ * (board_pico.h) so they survive resets and reflashing the UF2 does not
+ * touch them. Each 4 KB sector is one slot holding one image
+ * (scenario_bin.h) at its start; a slot is in use exactly when its image
+ * validates.
+ *
+ * The catalog is a RAM index rebuilt by scanning the slots at init and
+ * updated on every store/erase. Entries point into XIP flash, so a
+ * library scenario is activated with scenario_load_image() on the flash
+ * copy, without copying it to RAM.
+ */
+
+#ifndef SCENARIO_LIBRARY_H
+#define SCENARIO_LIBRARY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "scenario_registry.h"
+
+/** Library slots (one flash sector each) */
+#define SCENARIO_LIBRARY_SLOTS  16
+
+// ============================================================================
+// Library API
+// ============================================================================
+
+/**
+ * @brief Scan the flash partition and build the catalog
+ */
+void scenario_library_init(void);
+
+/**
+ * @brief Get a slot's scenario
+ *
+ * @param slot Slot index (0 to SCENARIO_LIBRARY_SLOTS-1)
+ * @return Entry with name and XIP image, or NULL if the slot is empty
+ */
+const scenario_entry_t* scenario_library_get(uint8_t slot);
+
+/**
+ * @brief Get the number of slots in use
+ *
+ * @return Stored scenarios
+ */
+uint8_t scenario_library_count(void);
+
+/**
+ * @brief Store an image in the library
+ *
+ * Replaces the scenario with the same name, otherwise takes the first
+ * free slot. Refused while a scenario is running; a loaded scenario in
+ * the target slot is unloaded first.
+ *
+ * @param image Validated image in RAM (e.g. scenario_get_image() after scenario_load())
+ * @param len Image length (at most one flash sector)
+ * @param slot Output: slot written (can be NULL)
+ * @return NULL on success, otherwise the reason it was not stored
+ */
+const char* scenario_library_store(const scenario_bin_header_t* image, size_t len, uint8_t* slot);
+
+/**
+ * @brief Erase a slot
+ *
+ * Refused while a scenario is running; a loaded scenario in that slot is
+ * unloaded first.
+ *
+ * @param slot Slot index
+ * @return NULL on success, otherwise the reason it was not erased
+ */
+const char* scenario_library_erase(uint8_t slot);
+
+#endif // SCENARIO_LIBRARY_H
@@ -4,6 +4,11 @@
  *
  * Registry of all embedded scenarios (compiled into firmware).
  * Used by TUI to list and select scenarios for execution.
+ *
+ * The registry table and the images themselves are generated at build
+ * time from the JSON files in tests/scenarios by tools/scenario_compile.py
+ * (scenario_images.c in the build tree); images stay in flash and are
+ * run in place with scenario_load_image().
  */
 
 #ifndef SCENARIO_REGISTRY_H
@@ -11,6 +16,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include "scenario_bin.h"
 
 // ============================================================================
 // Scenario Registry Entry
@@ -19,12 +25,12 @@
 /**
  * @brief Scenario registry entry
  *
- * Links scenario name to JSON data (compiled as string constant)
+ * Links scenario name to its compiled image in flash
  */
 typedef struct {
-    const char* name;       // Display name (shown in TUI)
-    const char* json_data;  // JSON scenario data (string constant)
-    size_t json_len;        // JSON data length
+    const char* name;                   // Display name (shown in TUI)
+    const scenario_bin_header_t* image; // Compiled scenario (XIP flash)
+    size_t image_len;                   // Image length in bytes
 } scenario_entry_t;
 
 // ============================================================================
@@ -43,6 +49,13 @@ extern const scenario_entry_t g_scenario_registry[];
  */
 extern const uint8_t g_scenario_count;
 
+/**
+ * @brief Scenario names in UPPERCASE, registry order (TUI enum strings)
+ *
+ * SCENARIO_BUILTIN_COUNT (scenario_images.h) is the compile-time count.
+ */
+extern const char* g_scenario_registry_enum[];
+
 // ============================================================================
 // Registry API
 // ============================================================================
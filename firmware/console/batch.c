@@ -0,0 +1,457 @@
+/**
+ * @file batch.c
+ * @brief Batch Command Protocol Implementation
+ */
+
+#include "batch.h"
+#include "tables.h"
+#include "tui.h"
+#include "table_test_modes.h"
+#include "table_fault_injection.h"
+#include "drivers/usb_console.h"
+#include "config/scenario.h"
+#include "nss_nrwa_t6_test_modes.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "pico/stdlib.h"
+#include "pico/time.h"
+
+#define BATCH_MAX_SETS      32      // Assignments per set command
+#define BATCH_REPLY_MAX     2048    // Longest reply (a full profiler table)
+
+// ============================================================================
+// State
+// ============================================================================
+
+static bool g_active = false;
+static char g_line[BATCH_LINE_MAX];
+static uint16_t g_line_len = 0;
+static bool g_line_overflow = false;        // Discarding the rest of a long line
+
+static char g_reply[BATCH_REPLY_MAX];
+static size_t g_reply_len = 0;
+static bool g_reply_overflow = false;
+
+// ============================================================================
+// Reply Building
+// ============================================================================
+
+static void reply_begin(void) {
+    g_reply_len = 0;
+    g_reply_overflow = false;
+}
+
+static void reply_add(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+static void reply_add(const char* fmt, ...) {
+    size_t room = sizeof(g_reply) - g_reply_len;
+    va_list args;
+
+    va_start(args, fmt);
+    int n = vsnprintf(&g_reply[g_reply_len], room, fmt, args);
+    va_end(args);
+
+    if (n < 0 || (size_t)n >= room) {
+        g_reply_overflow = true;
+        return;
+    }
+    g_reply_len += (size_t)n;
+}
+
+static void reply_send(void) {
+    if (g_reply_overflow) {
+        printf("ERR reply too long\n");
+    } else {
+        printf("%s\n", g_reply);
+    }
+}
+
+static void reply_error(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+static void reply_error(const char* fmt, ...) {
+    va_list args;
+
+    reply_begin();
+    reply_add("ERR ");
+    va_start(args, fmt);
+    int n = vsnprintf(&g_reply[g_reply_len], sizeof(g_reply) - g_reply_len, fmt, args);
+    va_end(args);
+    if (n > 0) {
+        g_reply_len += (size_t)n;
+    }
+}
+
+/**
+ * @brief Append " <id>=<value>" with a value that reads back through set
+ */
+static void reply_add_field(const field_meta_t* field) {
+    uint32_t raw;
+    char value_str[64];
+
+    if (!catalog_get_value(field, &raw)) {
+        reply_add(" %u=N/A", field->id);
+        return;
+    }
+
+    if (field->type == FIELD_TYPE_FLOAT) {
+        float f;
+        memcpy(&f, &raw, sizeof(f));
+        snprintf(value_str, sizeof(value_str), "%.9g", (double)f);
+    } else {
+        catalog_format_value(field, raw, value_str, sizeof(value_str));
+    }
+
+    // Keep one token per value
+    for (char* p = value_str; *p; p++) {
+        if (*p == ' ') {
+            *p = '_';
+        }
+    }
+    reply_add(" %u=%s", field->id, value_str);
+}
+
+// ============================================================================
+// Command Helpers
+// ============================================================================
+
+/**
+ * @brief Resolve "402" or "4.speed_rpm" to a field
+ */
+static const field_meta_t* find_field(const char* ref) {
+    char* end;
+    unsigned long id = strtoul(ref, &end, 10);
+
+    if (end == ref) {
+        return NULL;
+    }
+    if (*end == '\0') {
+        return (id <= 0xFFFFu) ? catalog_get_field_by_id((uint16_t)id) : NULL;
+    }
+    if (*end == '.' && id <= 0xFFu) {
+        const table_meta_t* table = catalog_get_table_by_id((uint8_t)id);
+        return table ? catalog_get_field_by_name(table, end + 1) : NULL;
+    }
+    return NULL;
+}
+
+static const char* access_name(field_access_t access) {
+    switch (access) {
+        case FIELD_ACCESS_RO: return "RO";
+        case FIELD_ACCESS_WO: return "WO";
+        default:              return "RW";
+    }
+}
+
+// ============================================================================
+// Commands
+// ============================================================================
+
+static void cmd_get(char** argv, int argc) {
+    if (argc < 2) {
+        reply_error("usage: get <field>...");
+        return;
+    }
+
+    reply_begin();
+    reply_add("OK");
+    for (int i = 1; i < argc; i++) {
+        const field_meta_t* field = find_field(argv[i]);
+        if (!field) {
+            reply_error("unknown field %s", argv[i]);
+            return;
+        }
+        reply_add_field(field);
+    }
+}
+
+static void cmd_set(char** argv, int argc) {
+    const field_meta_t* fields[BATCH_MAX_SETS];
+    uint32_t values[BATCH_MAX_SETS];
+    int count = argc - 1;
+
+    if (count < 1 || count > BATCH_MAX_SETS) {
+        reply_error("usage: set <field>=<value>... (at most %d)", BATCH_MAX_SETS);
+        return;
+    }
+
+    // Check everything first, so a bad assignment changes nothing
+    for (int i = 0; i < count; i++) {
+        char* ref = argv[i + 1];
+        char* eq = strchr(ref, '=');
+        if (!eq) {
+            reply_error("expected <field>=<value>: %s", ref);
+            return;
+        }
+        *eq = '\0';
+
+        const field_meta_t* field = find_field(ref);
+        if (!field) {
+            reply_error("unknown field %s", ref);
+            return;
+        }
+        if (field->access == FIELD_ACCESS_RO || !field->ptr) {
+            reply_error("read-only %s", ref);
+            return;
+        }
+        if (!catalog_parse_value(field, eq + 1, &values[i])) {
+            reply_error("bad value for %s: %s", ref, eq + 1);
+            return;
+        }
+        fields[i] = field;
+    }
+
+    for (int i = 0; i < count; i++) {
+        catalog_set_value(fields[i], values[i]);
+        tui_send_control_command(fields[i]->id, values[i]);
+    }
+
+    reply_begin();
+    reply_add("OK");
+}
+
+static void cmd_table(char** argv, int argc) {
+    const table_meta_t* table = (argc == 2) ? catalog_get_table_by_id((uint8_t)atoi(argv[1])) : NULL;
+    if (!table) {
+        reply_error("usage: table <table_id>");
+        return;
+    }
+
+    reply_begin();
+    reply_add("OK");
+    for (uint8_t i = 0; i < table->field_count; i++) {
+        reply_add_field(&table->fields[i]);
+    }
+}
+
+static void cmd_list(char** argv, int argc) {
+    reply_begin();
+    reply_add("OK");
+
+    if (argc == 1) {
+        for (uint8_t i = 0; i < catalog_get_table_count(); i++) {
+            const table_meta_t* table = catalog_get_table_by_index(i);
+            reply_add(" %u:", table->id);
+            for (const char* p = table->name; *p; p++) {
+                reply_add("%c", (*p == ' ') ? '_' : *p);
+            }
+        }
+        return;
+    }
+
+    const table_meta_t* table = catalog_get_table_by_id((uint8_t)atoi(argv[1]));
+    if (!table) {
+        reply_error("unknown table %s", argv[1]);
+        return;
+    }
+    for (uint8_t i = 0; i < table->field_count; i++) {
+        const field_meta_t* field = &table->fields[i];
+        reply_add(" %u:%s:%s:%s", field->id, field->name,
+                  field_type_name(field->type), access_name(field->access));
+    }
+}
+
+static void cmd_test(char** argv, int argc) {
+    if (argc != 2) {
+        reply_error("usage: test <mode_id>|off");
+        return;
+    }
+
+    if (strcasecmp(argv[1], "off") == 0 || strcmp(argv[1], "0") == 0) {
+        table_test_modes_deactivate();
+    } else {
+        int mode_id = atoi(argv[1]);
+        if (mode_id < 1 || mode_id >= TEST_MODE_COUNT || !table_test_modes_activate(mode_id)) {
+            reply_error("cannot activate test mode %s", argv[1]);
+            return;
+        }
+    }
+
+    reply_begin();
+    reply_add("OK");
+}
+
+static void cmd_seq(char** argv, int argc) {
+    static const char* state_names[] = { "IDLE", "RUNNING", "DONE", "STOPPED" };
+
+    if (argc == 1) {
+        uint32_t done = 0;
+        uint32_t passed = 0;
+        test_seq_result_t result;
+        while (test_seq_get_result(done, &result)) {
+            passed += result.pass ? 1u : 0u;
+            done++;
+        }
+        reply_begin();
+        reply_add("OK state=%s mode=%u done=%lu/%lu passed=%lu",
+                  state_names[test_seq_get_state()], (unsigned)test_seq_get_current(),
+                  (unsigned long)done, (unsigned long)test_seq_get_length(),
+                  (unsigned long)passed);
+        return;
+    }
+
+    if (strcasecmp(argv[1], "stop") == 0) {
+        if (!test_seq_stop()) {
+            reply_error("command queue full");
+            return;
+        }
+    } else {
+        uint32_t list = (uint32_t)strtoul(argv[1], NULL, 16);
+        uint32_t settle_ticks = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 0;
+        if (!test_seq_start(list, settle_ticks)) {
+            reply_error("cannot start sequence %s", argv[1]);
+            return;
+        }
+    }
+
+    reply_begin();
+    reply_add("OK");
+}
+
+static void cmd_scenario(char** argv, int argc) {
+    if (argc == 1) {
+        reply_begin();
+        reply_add("OK active=%d elapsed_ms=%lu events=%u/%u layers=0x%X",
+                  scenario_is_active() ? 1 : 0,
+                  (unsigned long)scenario_get_elapsed_ms(),
+                  scenario_get_triggered_count(), scenario_get_total_events(),
+                  (unsigned)scenario_get_active_layers());
+        return;
+    }
+
+    // Optional layer after the index or stop (default: the base layer, or
+    // every layer for stop)
+    unsigned long layer = SCENARIO_BASE_LAYER;
+    if (argc > 2) {
+        char* end;
+        layer = strtoul(argv[2], &end, 10);
+        if (end == argv[2] || *end != '\0' || layer >= SCENARIO_LAYERS) {
+            reply_error("layer must be 0-%u", (unsigned)(SCENARIO_LAYERS - 1));
+            return;
+        }
+    }
+
+    if (strcasecmp(argv[1], "stop") == 0) {
+        if (argc > 2) {
+            scenario_layer_deactivate((uint8_t)layer);
+        } else {
+            scenario_deactivate_all();
+        }
+    } else {
+        char* end;
+        unsigned long index = strtoul(argv[1], &end, 10);
+        if (end == argv[1] || *end != '\0') {
+            reply_error("usage: scenario [<index> [layer]|stop [layer]]");
+            return;
+        }
+        const char* err = fault_injection_start((uint32_t)index, (uint8_t)layer);
+        if (err) {
+            reply_error("scenario %lu: %s", index, err);
+            return;
+        }
+    }
+
+    reply_begin();
+    reply_add("OK");
+}
+
+/**
+ * @brief Split a line into words and run it
+ */
+static void execute_line(char* line) {
+    char* argv[BATCH_MAX_SETS + 1];
+    int argc = 0;
+
+    for (char* p = line; *p && argc < (int)(sizeof(argv) / sizeof(argv[0])); ) {
+        while (*p == ' ' || *p == '\t') {
+            *p++ = '\0';
+        }
+        if (*p) {
+            argv[argc++] = p;
+            while (*p && *p != ' ' && *p != '\t') {
+                p++;
+            }
+        }
+    }
+    if (argc == 0) {
+        return;     // Blank line: no reply
+    }
+
+    const char* cmd = argv[0];
+    if (strcasecmp(cmd, "ping") == 0) {
+        reply_begin();
+        reply_add("OK");
+    } else if (strcasecmp(cmd, "get") == 0) {
+        cmd_get(argv, argc);
+    } else if (strcasecmp(cmd, "set") == 0) {
+        cmd_set(argv, argc);
+    } else if (strcasecmp(cmd, "table") == 0) {
+        cmd_table(argv, argc);
+    } else if (strcasecmp(cmd, "list") == 0) {
+        cmd_list(argv, argc);
+    } else if (strcasecmp(cmd, "test") == 0) {
+        cmd_test(argv, argc);
+    } else if (strcasecmp(cmd, "seq") == 0) {
+        cmd_seq(argv, argc);
+    } else if (strcasecmp(cmd, "scenario") == 0) {
+        cmd_scenario(argv, argc);
+    } else if (strcasecmp(cmd, "exit") == 0) {
+        g_active = false;
+        printf("OK\n");
+        tui_update(true);
+        return;
+    } else {
+        reply_error("unknown command %s", cmd);
+    }
+
+    reply_send();
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+void batch_enter(void) {
+    usb_console_wait_idle(100000);      // Let the last TUI frame out first
+    g_active = true;
+    g_line_len = 0;
+    g_line_overflow = false;
+    printf("\nOK batch\n");
+}
+
+bool batch_is_active(void) {
+    return g_active;
+}
+
+void batch_service(uint32_t budget_us) {
+    absolute_time_t deadline = make_timeout_time_us(budget_us);
+
+    while (g_active) {
+        int64_t left_us = absolute_time_diff_us(get_absolute_time(), deadline);
+        if (left_us <= 0) {
+            return;
+        }
+
+        int c = getchar_timeout_us((uint32_t)left_us);
+        if (c == PICO_ERROR_TIMEOUT) {
+            return;
+        }
+
+        if (c == '\r' || c == '\n') {
+            if (g_line_overflow) {
+                printf("ERR line too long\n");
+            } else {
+                g_line[g_line_len] = '\0';
+                execute_line(g_line);
+            }
+            g_line_len = 0;
+            g_line_overflow = false;
+        } else if (g_line_len < BATCH_LINE_MAX - 1) {
+            g_line[g_line_len++] = (char)c;
+        } else {
+            g_line_overflow = true;
+        }
+    }
+}
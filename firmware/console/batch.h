@@ -0,0 +1,68 @@
+/**
+ * @file batch.h
+ * @brief Line-Oriented Batch Command Protocol (Console Automation)
+ *
+ * A machine interface on the console port, next to the TUI. Send Ctrl-B
+ * (0x02) from the TUI to enter it: rendering stops, the emulator answers
+ * "OK batch", and from then on every non-blank line is one command with
+ * exactly one reply line:
+ *
+ *   OK [results]          success
+ *   ERR <reason>          failure (nothing was changed)
+ *
+ * Other lines (log messages from the firmware) never start with OK or ERR
+ * and can be skipped. Commands read while in batch mode are answered as
+ * soon as the line is complete, not on the 50 ms main-loop period.
+ *
+ * A field is named by ID ("402") or table ID and name ("4.speed_rpm").
+ * Values use the TUI syntax: enum/bool names or numbers, hex for HEX
+ * fields; floats are printed with full precision.
+ *
+ *   ping                         OK
+ *   get <field>...               OK 402=3000 401=SPEED
+ *   set <field>=<value>...       OK            (all checked before any is written)
+ *   table <table_id>             OK <id>=<value> for every field (stats)
+ *   list                         OK <table_id>:<Name_With_Underscores>...
+ *   list <table_id>              OK <id>:<name>:<type>:<RO|RW|WO>...
+ *   test <mode_id>|off           OK            (Table 11 test modes)
+ *   seq <hexlist> [ticks]|stop   OK            (test-mode sequence, 0 = all modes)
+ *   seq                          OK state=DONE mode=0 done=3/3 passed=3
+ *   scenario <index> [layer]     OK            (run without console playback)
+ *   scenario stop [layer]        OK            (every layer if none given)
+ *   scenario                     OK active=1 elapsed_ms=1200 events=2/5 layers=0x1
+ *   exit                         OK            (back to the TUI, full redraw)
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Key that enters batch mode from the TUI (Ctrl-B) */
+#define BATCH_ENTER_KEY     0x02
+
+/** Longest command line (longer lines are rejected whole) */
+#define BATCH_LINE_MAX      256
+
+/**
+ * @brief Enter batch mode (TUI rendering stops)
+ */
+void batch_enter(void);
+
+/**
+ * @brief Check whether batch mode is active
+ */
+bool batch_is_active(void);
+
+/**
+ * @brief Read and answer commands for up to budget_us
+ *
+ * Call in place of the main loop's idle sleep while batch mode is active.
+ * Returns early if batch mode is left.
+ *
+ * @param budget_us Time to spend waiting for input
+ */
+void batch_service(uint32_t budget_us);
+
+#endif // BATCH_H
@@ -70,3 +70,33 @@ void console_print_box_bottom(void) {
     putchar('+');
     putchar('\n');
 }
+
+void console_format_sparkline(char* buf, size_t len, const float* values, uint32_t count,
+                              uint32_t width, float lo, float hi) {
+    static const char* const blocks[8] = {
+        "▁", "▂", "▃", "▄", "▅", "▆", "▇", "█",
+    };
+
+    if (count > width) {
+        values += count - width;
+        count = width;
+    }
+
+    size_t pos = 0;
+    for (uint32_t i = 0; i < width && pos + 4 <= len; i++) {
+        if (i < width - count) {
+            buf[pos++] = ' ';
+            continue;
+        }
+        int level = 0;
+        if (hi > lo) {
+            level = (int)((values[i - (width - count)] - lo) * 8.0f / (hi - lo));
+            level = (level < 0) ? 0 : (level > 7) ? 7 : level;
+        }
+        memcpy(&buf[pos], blocks[level], 3);
+        pos += 3;
+    }
+    if (len > 0) {
+        buf[pos < len ? pos : len - 1] = '\0';
+    }
+}
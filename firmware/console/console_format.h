@@ -11,6 +11,7 @@
 #include "console_config.h"
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 /**
  * @brief Print a horizontal line across console width
@@ -45,6 +46,24 @@ void console_print_box_top(void);
  */
 void console_print_box_bottom(void);
 
+/**
+ * @brief Format values as a sparkline (one block character per value)
+ *
+ * Each value maps to one of eight block heights between lo and hi (all
+ * the lowest one if hi <= lo). The line is padded on the left to width
+ * characters, so the newest value stays in the last column.
+ *
+ * @param buf Output buffer (3 bytes per character: UTF-8 blocks)
+ * @param len Size of buf
+ * @param values Values, oldest first
+ * @param count Number of values (at most width are shown, the newest)
+ * @param width Characters in the line
+ * @param lo Value drawn as the lowest block
+ * @param hi Value drawn as the full block
+ */
+void console_format_sparkline(char* buf, size_t len, const float* values, uint32_t count,
+                              uint32_t width, float lo, float hi);
+
 /**
  * @brief Calculate padding needed to center text
  *
@@ -0,0 +1,708 @@
+/**
+ * @file table_cmd_stats.c
+ * @brief Command Stats Table Implementation
+ *
+ * Table 12: Command Stats (per-command call count and handler cycles)
+ *
+ * Also the command latency: for every command queued to Core1, the time
+ * from its receive time (NSP frame END) to the start of the tick that
+ * applied it, as percentiles per command type, and the ID and tick Core1
+ * echoed for the last command applied to wheel 0.
+ */
+
+#include "table_cmd_stats.h"
+#include "tables.h"
+#include "../device/nss_nrwa_t6_commands.h"
+#include "../device/nss_nrwa_t6_engine.h"
+#include "../util/core_sync.h"
+#include <stdio.h>
+
+// ============================================================================
+// Live Data (Connected to Command Dispatcher)
+// ============================================================================
+
+// Row order of the table (one row per implemented command)
+static const uint8_t cmd_codes[] = {
+    NSP_CMD_PING,
+    NSP_CMD_PEEK,
+    NSP_CMD_POKE,
+    NSP_CMD_APPLICATION_TELEMETRY,
+    NSP_CMD_APPLICATION_COMMAND,
+    NSP_CMD_CLEAR_FAULT,
+    NSP_CMD_CONFIGURE_PROTECTION,
+    NSP_CMD_TRIP_LCL,
+    NSP_CMD_SIM_STEP,
+    NSP_CMD_MULTI_TELEMETRY,
+};
+
+#define CMD_STATS_ROWS (sizeof(cmd_codes) / sizeof(cmd_codes[0]))
+
+static volatile uint32_t cmd_calls[CMD_STATS_ROWS];       // Handler invocations
+static volatile uint32_t cmd_min_cycles[CMD_STATS_ROWS];  // Fastest call
+static volatile uint32_t cmd_avg_cycles[CMD_STATS_ROWS];  // Mean over all calls
+static volatile uint32_t cmd_max_cycles[CMD_STATS_ROWS];  // Slowest call
+static volatile uint32_t cmd_unknown = 0;                 // Codes with no handler
+
+// Command latency for the selected command type (index = command_type_t,
+// 0 = every type)
+static volatile uint32_t cmd_apply_sel = 0;
+static volatile uint32_t cmd_apply_reset = 0;             // Write 1 to clear histograms
+static latency_summary_t cmd_apply_lat;
+
+// Last command Core1 applied to wheel 0 (echoed in its snapshot)
+static volatile uint32_t cmd_last_id = 0;
+static volatile uint32_t cmd_last_tick = 0;
+static volatile uint32_t cmd_last_latency_us = 0;
+
+static const char* apply_cmd_strings[] = {
+    "ALL",
+    "SET_MODE",
+    "SET_SPEED",
+    "SET_CURRENT",
+    "SET_TORQUE",
+    "SET_PWM",
+    "CLEAR_FAULT",
+    "RESET",
+    "TRIP_LCL",
+    "CONFIG_PROT",
+    "SET_INTEGRATOR",
+    "TEST_SEQ_START",
+    "TEST_SEQ_STOP",
+    "INJECT_FAULT",
+};
+
+#define APPLY_CMD_CHOICES (sizeof(apply_cmd_strings) / sizeof(apply_cmd_strings[0]))
+
+_Static_assert(APPLY_CMD_CHOICES == CMD_TYPE_COUNT, "apply_cmd_strings must name every command type");
+
+// ============================================================================
+// Field Definitions
+// ============================================================================
+
+static const field_meta_t cmd_stats_fields[] = {
+    // PING
+    {
+        .id = 1201,
+        .name = "ping_calls",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_calls[0],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1202,
+        .name = "ping_min_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_min_cycles[0],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1203,
+        .name = "ping_avg_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_avg_cycles[0],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1204,
+        .name = "ping_max_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_max_cycles[0],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    // PEEK
+    {
+        .id = 1205,
+        .name = "peek_calls",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_calls[1],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1206,
+        .name = "peek_min_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_min_cycles[1],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1207,
+        .name = "peek_avg_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_avg_cycles[1],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1208,
+        .name = "peek_max_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_max_cycles[1],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    // POKE
+    {
+        .id = 1209,
+        .name = "poke_calls",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_calls[2],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1210,
+        .name = "poke_min_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_min_cycles[2],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1211,
+        .name = "poke_avg_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_avg_cycles[2],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1212,
+        .name = "poke_max_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_max_cycles[2],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    // APP-TELEM
+    {
+        .id = 1213,
+        .name = "app_telem_calls",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_calls[3],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1214,
+        .name = "app_telem_min_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_min_cycles[3],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1215,
+        .name = "app_telem_avg_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_avg_cycles[3],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1216,
+        .name = "app_telem_max_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_max_cycles[3],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    // APP-CMD
+    {
+        .id = 1217,
+        .name = "app_cmd_calls",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_calls[4],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1218,
+        .name = "app_cmd_min_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_min_cycles[4],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1219,
+        .name = "app_cmd_avg_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_avg_cycles[4],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1220,
+        .name = "app_cmd_max_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_max_cycles[4],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    // CLEAR-FAULT
+    {
+        .id = 1221,
+        .name = "clear_fault_calls",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_calls[5],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1222,
+        .name = "clear_fault_min_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_min_cycles[5],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1223,
+        .name = "clear_fault_avg_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_avg_cycles[5],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1224,
+        .name = "clear_fault_max_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_max_cycles[5],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    // CONFIG-PROT
+    {
+        .id = 1225,
+        .name = "config_prot_calls",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_calls[6],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1226,
+        .name = "config_prot_min_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_min_cycles[6],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1227,
+        .name = "config_prot_avg_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_avg_cycles[6],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1228,
+        .name = "config_prot_max_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_max_cycles[6],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    // TRIP-LCL
+    {
+        .id = 1229,
+        .name = "trip_lcl_calls",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_calls[7],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1230,
+        .name = "trip_lcl_min_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_min_cycles[7],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1231,
+        .name = "trip_lcl_avg_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_avg_cycles[7],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1232,
+        .name = "trip_lcl_max_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_max_cycles[7],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1233,
+        .name = "unknown_cmds",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_unknown,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    // SIM-STEP (emulator extension)
+    {
+        .id = 1234,
+        .name = "sim_step_calls",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_calls[8],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1235,
+        .name = "sim_step_min_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_min_cycles[8],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1236,
+        .name = "sim_step_avg_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_avg_cycles[8],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1237,
+        .name = "sim_step_max_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_max_cycles[8],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    // MULTI-TELEMETRY (emulator extension)
+    {
+        .id = 1238,
+        .name = "multi_telem_calls",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_calls[9],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1239,
+        .name = "multi_telem_min_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_min_cycles[9],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1240,
+        .name = "multi_telem_avg_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_avg_cycles[9],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1241,
+        .name = "multi_telem_max_cyc",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_max_cycles[9],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    // Command latency (receive to the Core1 tick that applied it)
+    {
+        .id = 1242,
+        .name = "apply_cmd",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_apply_sel,
+        .enum_values = apply_cmd_strings,
+        .enum_count = APPLY_CMD_CHOICES,
+    },
+    {
+        .id = 1243,
+        .name = "apply_count",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_apply_lat.count,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1244,
+        .name = "apply_p50",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_apply_lat.p50_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1245,
+        .name = "apply_p90",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_apply_lat.p90_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1246,
+        .name = "apply_p99",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_apply_lat.p99_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1247,
+        .name = "apply_p999",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_apply_lat.p999_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1248,
+        .name = "apply_max",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_apply_lat.max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1249,
+        .name = "apply_reset",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_apply_reset,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1250,
+        .name = "last_cmd_id",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_last_id,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1251,
+        .name = "last_cmd_tick",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_last_tick,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1252,
+        .name = "last_cmd_lat",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&cmd_last_latency_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    }
+};
+
+const table_meta_t table_cmd_stats_meta = {
+    .id = 12,
+    .name = "Command Stats",
+    .description = "Per-command calls and handler cycles",
+    .fields = cmd_stats_fields,
+    .field_count = sizeof(cmd_stats_fields) / sizeof(cmd_stats_fields[0]),
+};
+
+// ============================================================================
+// Update Function
+// ============================================================================
+
+void table_cmd_stats_update(void) {
+    for (uint32_t i = 0; i < CMD_STATS_ROWS; i++) {
+        cmd_latency_stats_t stats = {0};
+        commands_get_latency_stats(cmd_codes[i], &stats);
+
+        cmd_calls[i] = stats.calls;
+        cmd_min_cycles[i] = stats.min_cycles;
+        cmd_avg_cycles[i] = (stats.calls > 0) ? (uint32_t)(stats.total_cycles / stats.calls) : 0;
+        cmd_max_cycles[i] = stats.max_cycles;
+    }
+    cmd_unknown = commands_get_unknown_count();
+
+    // Command latency for the selected type (reset request first)
+    if (cmd_apply_reset) {
+        cmd_apply_reset = 0;
+        physics_engine_reset_cmd_latency();
+    }
+    if (cmd_apply_sel >= APPLY_CMD_CHOICES) {
+        cmd_apply_sel = 0;
+    }
+    physics_engine_get_cmd_latency((uint8_t)cmd_apply_sel, &cmd_apply_lat);
+
+    telemetry_snapshot_t snapshot;
+    if (core_sync_read_telemetry(&snapshot)) {
+        cmd_last_id = snapshot.cmd_id;
+        cmd_last_tick = snapshot.cmd_tick;
+        cmd_last_latency_us = snapshot.cmd_latency_us;
+    }
+}
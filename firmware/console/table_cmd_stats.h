@@ -0,0 +1,20 @@
+/**
+ * @file table_cmd_stats.h
+ * @brief Command Stats Table for Console TUI
+ *
+ * Table 12: Command Stats (per-command calls and min/avg/max handler cycles)
+ */
+
+#ifndef TABLE_CMD_STATS_H
+#define TABLE_CMD_STATS_H
+
+#include <stdint.h>
+
+/**
+ * @brief Update command stats from the dispatcher
+ *
+ * Call this periodically to fetch the latest per-command statistics
+ */
+void table_cmd_stats_update(void);
+
+#endif // TABLE_CMD_STATS_H
@@ -8,6 +8,7 @@
 #include "table_config.h"
 #include "tables.h"
 #include "../config/scenario.h"
+#include "../util/core_sync.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -35,7 +36,6 @@ static const field_meta_t config_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)cfg_scenario_name,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -47,7 +47,6 @@ static const field_meta_t config_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&cfg_scenario_loaded,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -59,7 +58,6 @@ static const field_meta_t config_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&cfg_scenario_active,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -71,7 +69,6 @@ static const field_meta_t config_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&cfg_scenario_elapsed_ms,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -83,7 +80,6 @@ static const field_meta_t config_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&cfg_scenario_events_triggered,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -95,7 +91,6 @@ static const field_meta_t config_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&cfg_scenario_events_total,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -105,7 +100,7 @@ static const field_meta_t config_fields[] = {
 // Table Definition
 // ============================================================================
 
-static const table_meta_t config_table = {
+const table_meta_t table_config_meta = {
     .id = 9,
     .name = "Fault Injection Status",
     .description = "Scenario engine, timeline, events",
@@ -121,8 +116,6 @@ void table_config_init(void) {
     // Initialize scenario engine
     scenario_engine_init();
 
-    // Register table with catalog
-    catalog_register_table(&config_table);
 }
 
 // ============================================================================
@@ -135,6 +128,13 @@ void table_config_init(void) {
  * Call this periodically to refresh TUI display
  */
 void table_config_update(void) {
+    // Elapsed time moves on its own only while a scenario runs
+    static core_sync_doorbell_t bell;
+    bool rung = core_sync_doorbell_take(&bell, CORE_SYNC_BELL(CORE_SYNC_BELL_SCENARIO), 0);
+    if (!rung && !scenario_is_active()) {
+        return;
+    }
+
     // Update scenario name
     const char* name = scenario_get_name();
     if (name != NULL) {
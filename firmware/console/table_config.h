@@ -10,7 +10,7 @@
 #include <stdint.h>
 
 /**
- * @brief Initialize Config & JSON table and register with catalog
+ * @brief Initialize Config & JSON table state
  */
 void table_config_init(void);
 
@@ -5,7 +5,8 @@
  * Table 4: Control Mode (mode, setpoint, direction, PWM, source)
  *
  * NOTE: This table now pulls live data from the Core1 telemetry snapshot,
- * ensuring consistency with Table 10 and the banner status line.
+ * ensuring consistency with Table 10 and the banner status line. The
+ * setpoint fields show the commanded values, not the measured response.
  */
 
 #include "table_control.h"
@@ -34,6 +35,8 @@ static volatile uint32_t control_current_ma = 0;      // Current in mA
 static volatile uint32_t control_torque_mnm = 0;      // Torque in mN·m
 static volatile uint32_t control_pwm_pct = 0;         // PWM duty cycle %
 static volatile uint32_t control_direction = 0;       // DIRECTION_POSITIVE
+static volatile uint32_t control_integrator = 0;      // INTEGRATOR_EULER
+static volatile uint32_t control_substeps = DEFAULT_INTEGRATOR_SUBSTEPS;
 
 // ============================================================================
 // Enum String Tables (UPPERCASE)
@@ -53,6 +56,15 @@ static const char* direction_enum[] = {
     "NEGATIVE"
 };
 
+// Integrator enum (integrator_mode_t)
+static const char* integrator_enum[] = {
+    "EULER",
+    "SUBSTEP",
+    "RK4",
+    "FIXED",
+    "LUT"
+};
+
 // ============================================================================
 // Field Definitions
 // ============================================================================
@@ -66,7 +78,6 @@ static const field_meta_t control_fields[] = {
         .access = FIELD_ACCESS_RW,
         .default_val = 0,  // CONTROL_MODE_CURRENT
         .ptr = (volatile uint32_t*)&control_mode,
-        .dirty = false,
         .enum_values = control_mode_enum,
         .enum_count = 4,
     },
@@ -78,7 +89,6 @@ static const field_meta_t control_fields[] = {
         .access = FIELD_ACCESS_RW,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&control_speed_rpm,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -90,7 +100,6 @@ static const field_meta_t control_fields[] = {
         .access = FIELD_ACCESS_RW,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&control_current_ma,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -102,7 +111,6 @@ static const field_meta_t control_fields[] = {
         .access = FIELD_ACCESS_RW,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&control_torque_mnm,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -114,7 +122,6 @@ static const field_meta_t control_fields[] = {
         .access = FIELD_ACCESS_RW,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&control_pwm_pct,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -126,17 +133,38 @@ static const field_meta_t control_fields[] = {
         .access = FIELD_ACCESS_RW,
         .default_val = 0,  // DIRECTION_POSITIVE
         .ptr = (volatile uint32_t*)&control_direction,
-        .dirty = false,
         .enum_values = direction_enum,
         .enum_count = 2,
     },
+    {
+        .id = 407,
+        .name = "integrator",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,  // INTEGRATOR_EULER
+        .ptr = (volatile uint32_t*)&control_integrator,
+        .enum_values = integrator_enum,
+        .enum_count = INTEGRATOR_COUNT,
+    },
+    {
+        .id = 408,
+        .name = "substeps",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = DEFAULT_INTEGRATOR_SUBSTEPS,
+        .ptr = (volatile uint32_t*)&control_substeps,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
 };
 
 // ============================================================================
 // Table Definition
 // ============================================================================
 
-static const table_meta_t control_table = {
+const table_meta_t table_control_meta = {
     .id = 4,
     .name = "Control Setpoints",
     .description = "Mode, setpoint, direction, PWM",
@@ -154,8 +182,6 @@ void table_control_init(void) {
     memset(&g_control_update_buffer, 0, sizeof(g_control_update_buffer));
     g_control_snapshot_valid = false;
 
-    // Register table with catalog
-    catalog_register_table(&control_table);
 }
 
 // ============================================================================
@@ -163,8 +189,17 @@ void table_control_init(void) {
 // ============================================================================
 
 void table_control_update(void) {
+    // Only mode, setpoint and fault changes matter to this table
+    static core_sync_doorbell_t bell;
+    if (!core_sync_doorbell_take(&bell, CORE_SYNC_BELL(CORE_SYNC_BELL_CONTROL) |
+                                        CORE_SYNC_BELL(CORE_SYNC_BELL_FAULT), 0)) {
+        return;
+    }
+
     // Read latest telemetry snapshot from Core1 into temporary buffer
-    if (core_sync_read_telemetry(&g_control_update_buffer)) {
+    // (skipped without copying if Core1 has not published since last time)
+    uint32_t last_tick = g_control_snapshot_valid ? g_control_snapshot.tick_count : UINT32_MAX;
+    if (core_sync_read_telemetry_newer(last_tick, &g_control_update_buffer)) {
         // Atomically swap buffers - disable interrupts to prevent TUI from
         // reading partially-updated display snapshot during struct copy
         uint32_t save = save_and_disable_interrupts();
@@ -175,11 +210,12 @@ void table_control_update(void) {
         // Update cached display values from snapshot
         control_mode = (uint32_t)g_control_snapshot.mode;
         control_direction = (uint32_t)g_control_snapshot.direction;
-        control_speed_rpm = (uint32_t)g_control_snapshot.speed_rpm;
-        control_current_ma = (uint32_t)(g_control_snapshot.current_a * 1000.0f);  // A → mA
-        control_torque_mnm = (uint32_t)g_control_snapshot.torque_mnm;
-        // PWM duty cycle not in telemetry snapshot - keep as 0 for now
-        control_pwm_pct = 0;
+        control_speed_rpm = (uint32_t)g_control_snapshot.speed_cmd_rpm;
+        control_current_ma = (uint32_t)(g_control_snapshot.current_cmd_a * 1000.0f);  // A → mA
+        control_torque_mnm = (uint32_t)g_control_snapshot.torque_cmd_mnm;
+        control_pwm_pct = (uint32_t)g_control_snapshot.pwm_duty_pct;
+        control_integrator = (uint32_t)g_control_snapshot.integrator;
+        control_substeps = g_control_snapshot.integrator_substeps;
     }
 }
 
@@ -211,6 +247,14 @@ uint32_t table_control_get_pwm_pct(void) {
     return control_pwm_pct;
 }
 
+uint32_t table_control_get_integrator(void) {
+    return control_integrator;
+}
+
+uint32_t table_control_get_substeps(void) {
+    return control_substeps;
+}
+
 const char* table_control_get_mode_string(uint32_t mode) {
     if (mode < 4) {
         return control_mode_enum[mode];
@@ -12,7 +12,7 @@
 #include <stdbool.h>
 
 /**
- * @brief Initialize Control Mode table and register with catalog
+ * @brief Initialize Control Mode table state
  */
 void table_control_init(void);
 
@@ -60,6 +60,18 @@ uint32_t table_control_get_torque_mnm(void);
  */
 uint32_t table_control_get_pwm_pct(void);
 
+/**
+ * @brief Get active dynamics integrator
+ * @return Integrator (0=EULER, 1=SUBSTEP, 2=RK4, 3=FIXED)
+ */
+uint32_t table_control_get_integrator(void);
+
+/**
+ * @brief Get integrator sub-steps per tick
+ * @return Sub-steps (1-16)
+ */
+uint32_t table_control_get_substeps(void);
+
 /**
  * @brief Get mode enum string (UPPERCASE)
  * @param mode Mode value (0-3)
@@ -1,9 +1,11 @@
 /**
- * @file table_core1_stats.c
+ * @file table_core1_stats_meta.c
  * @brief Table 11: Core1 Physics Statistics
  *
- * Displays live telemetry from the Core1 physics engine at 100 Hz.
- * All values are read-only snapshots from the inter-core telemetry system.
+ * Displays live telemetry from the Core1 physics engine (PHYSICS_TICK_RATE_HZ).
+ * Values are read-only snapshots from the inter-core telemetry system,
+ * except the tick source fields that switch Core1 to external stepping and
+ * the task selector of the scheduler budget view.
  */
 
 // Suppress harmless alignment warning for enum field pointers
@@ -11,7 +13,13 @@
 
 #include "tables.h"
 #include "util/core_sync.h"
+#include "util/tick_trace.h"
+#include "util/task_sched.h"
+#include "timebase.h"
+#include "clock_profile.h"
 #include "nss_nrwa_t6_regs.h"
+#include "wheel_profile.h"
+#include "warm_restart.h"
 #include "pico/stdlib.h"
 #include "hardware/sync.h"
 #include <stdio.h>
@@ -26,12 +34,92 @@
 static telemetry_snapshot_t g_display_snapshot = {0};  // Safe for TUI to read
 static telemetry_snapshot_t g_update_buffer = {0};     // Temporary buffer for updates
 static bool g_snapshot_valid = false;
-static uint32_t g_jitter_violations = 0;  // Count of ticks >200µs
+static uint32_t g_jitter_violations = 0;  // Count of ticks >MAX_TICK_JITTER_US
+
+// Core0 -> Core1 command queue statistics
+static uint32_t g_cmd_queued = 0;
+static uint32_t g_cmd_dropped = 0;
+static uint32_t g_cmd_queue_peak = 0;
+static uint32_t g_telem_read_retries = 0;
+
+// Physics tick execution time (integrator cost, all wheels)
+static uint32_t g_physics_us = 0;
+static uint32_t g_max_physics_us = 0;
+static uint32_t g_wheel_count = EMULATED_WHEEL_COUNT;
+static uint32_t g_serialize_us = 0;   // Core1 APP-TELEM block encoding time
+
+// Tick execution / wake-up latency distribution and deadline misses
+static latency_summary_t g_exec_summary = {0};
+static latency_summary_t g_wake_summary = {0};
+static uint32_t g_deadline_misses = 0;
+static uint32_t g_last_miss_tick = 0;
+static uint32_t g_last_miss_us = 0;   // Wake-up + execution of the last miss
+
+// Core1 CPU load (time awake vs. time in WFE)
+static uint32_t g_busy_us = 0;
+static uint32_t g_max_busy_us = 0;
+static float g_load_pct = 0.0f;
+
+// Tick source (lockstep with an external clock, see timebase_set_mode())
+static uint32_t g_tick_source = TIMEBASE_FREE_RUN;
+static uint32_t g_tick_source_prev = TIMEBASE_FREE_RUN;   // Detects console edits
+static uint32_t g_steps_per_pulse = 1;
+static uint32_t g_step_request = 0;   // Write N to queue N ticks
+static uint32_t g_steps_pending = 0;
+static uint32_t g_sim_time_ms = 0;
+
+// Core1 scheduler: budget accounting of the selected task
+static uint32_t g_task = 0;           // Task index (enum of task names)
+static uint32_t g_task_period = 0;    // Ticks between runs (0 = idle)
+static uint32_t g_task_budget_us = 0;
+static uint32_t g_task_last_us = 0;
+static uint32_t g_task_max_us = 0;
+static uint32_t g_task_mean_us = 0;
+static uint32_t g_task_runs = 0;
+static uint32_t g_task_overruns = 0;
+static uint32_t g_task_skipped = 0;
+static uint32_t g_task_reset = 0;     // Write 1 to clear every task's statistics
+static uint32_t g_task_priority = TASK_SCHED_PRIO_HARD;
+static uint32_t g_task_deferred = 0;  // Moved to the slack by the budget governor
+static uint32_t g_task_shed = 0;      // Dropped by the budget governor
+static uint32_t g_shed_ticks = 0;     // Ticks on which the governor held work back
+static const char* task_enum_values[TASK_SCHED_MAX_TASKS];
+
+// Clock profile and the tick budget it leaves
+static uint32_t g_clock_profile = CLOCK_PROFILE_STANDARD;
+static uint32_t g_sys_clock_mhz = 0;
+static float g_headroom_pct = 0.0f;   // Tick period not used by the worst tick so far
+
+// Watchdog resets survived with the wheel state (since the last cold boot)
+static uint32_t g_warm_restarts = 0;
+
+// Parameter transactions committed by Core0 / swapped in by Core1
+static uint32_t g_param_commits = 0;
+static uint32_t g_param_swaps = 0;
 
 // ============================================================================
 // Enum Values
 // ============================================================================
 
+static const char* tick_source_enum_values[] = {
+    "FREE_RUN",
+    "STEPPED"
+};
+
+static const char* task_priority_enum_values[] = {
+    "HARD",
+    "DEFER",
+    "SHED"
+};
+_Static_assert(sizeof(task_priority_enum_values) / sizeof(task_priority_enum_values[0]) ==
+               TASK_SCHED_PRIO_COUNT, "task_priority_enum_values must name every priority");
+
+static const char* clock_profile_enum_values[] = {
+    "STANDARD",
+    "FAST",
+    "TURBO"
+};
+
 static const char* mode_enum_values[] = {
     "CURRENT",
     "SPEED",
@@ -48,7 +136,7 @@ static const char* direction_enum_values[] = {
 // Table Definition
 // ============================================================================
 
-static field_meta_t table_core1_stats_fields[] = {
+static const field_meta_t table_core1_stats_fields[] = {
     // Dynamic state (from physics simulation)
     {
         .id = 1101,
@@ -58,7 +146,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.speed_rpm,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -70,7 +157,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.current_a,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -82,7 +168,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.torque_mnm,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -94,7 +179,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.power_w,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -106,7 +190,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.voltage_v,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -118,7 +201,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.momentum_nms,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -130,7 +212,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.omega_rad_s,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -144,7 +225,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.mode,
-        .dirty = false,
         .enum_values = mode_enum_values,
         .enum_count = 4,
     },
@@ -156,7 +236,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.direction,
-        .dirty = false,
         .enum_values = direction_enum_values,
         .enum_count = 2,
     },
@@ -170,7 +249,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.fault_status,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -182,7 +260,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.warning_status,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -194,7 +271,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.lcl_tripped,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -208,7 +284,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.tick_count,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -220,7 +295,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.jitter_us,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -232,7 +306,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.max_jitter_us,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -244,7 +317,6 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_jitter_violations,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -256,13 +328,528 @@ static field_meta_t table_core1_stats_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&g_display_snapshot.timestamp_us,
-        .dirty = false,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1118,
+        .name = "cmd_queued",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_cmd_queued,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1119,
+        .name = "cmd_dropped",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_cmd_dropped,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1120,
+        .name = "cmd_queue_peak",
+        .type = FIELD_TYPE_U32,
+        .units = "entries",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_cmd_queue_peak,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1121,
+        .name = "telem_read_retries",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_telem_read_retries,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1122,
+        .name = "physics_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_physics_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1123,
+        .name = "max_physics_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_max_physics_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1124,
+        .name = "wheels",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = EMULATED_WHEEL_COUNT,
+        .ptr = (volatile uint32_t*)&g_wheel_count,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1125,
+        .name = "telem_encode_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_serialize_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+
+    // Tick timing distribution (Core1 tick trace, P key dumps the miss ring)
+    {
+        .id = 1126,
+        .name = "tick_p50_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_exec_summary.p50_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1127,
+        .name = "tick_p99_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_exec_summary.p99_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1128,
+        .name = "tick_p999_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_exec_summary.p999_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1129,
+        .name = "wake_p50_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_wake_summary.p50_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1130,
+        .name = "wake_p99_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_wake_summary.p99_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1131,
+        .name = "wake_max_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_wake_summary.max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1132,
+        .name = "deadline_misses",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_deadline_misses,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1133,
+        .name = "last_miss_tick",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_last_miss_tick,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1134,
+        .name = "last_miss_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_last_miss_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+
+    // Core1 CPU load (headroom for more wheels / higher tick rates)
+    {
+        .id = 1135,
+        .name = "busy_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_busy_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1136,
+        .name = "max_busy_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_max_busy_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1137,
+        .name = "cpu_load_pct",
+        .type = FIELD_TYPE_FLOAT,
+        .units = "%",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_load_pct,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+
+    // Tick source (STEPPED: ticks from SYNC pin pulses, NSP SIM-STEP or step)
+    {
+        .id = 1138,
+        .name = "tick_source",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = TIMEBASE_FREE_RUN,
+        .ptr = (volatile uint32_t*)&g_tick_source,
+        .enum_values = tick_source_enum_values,
+        .enum_count = 2,
+    },
+    {
+        .id = 1139,
+        .name = "steps_per_pulse",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 1,
+        .ptr = (volatile uint32_t*)&g_steps_per_pulse,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1140,
+        .name = "step",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_step_request,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1141,
+        .name = "steps_pending",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_steps_pending,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1142,
+        .name = "sim_time_ms",
+        .type = FIELD_TYPE_U32,
+        .units = "ms",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_sim_time_ms,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1143,
+        .name = "task",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task,
+        .enum_values = task_enum_values,
+        .enum_count = TASK_SCHED_MAX_TASKS,
+    },
+    {
+        .id = 1144,
+        .name = "task_period",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task_period,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1145,
+        .name = "task_budget_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task_budget_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1146,
+        .name = "task_last_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task_last_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1147,
+        .name = "task_max_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task_max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1148,
+        .name = "task_mean_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task_mean_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1149,
+        .name = "task_runs",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task_runs,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1150,
+        .name = "task_overruns",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task_overruns,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1151,
+        .name = "task_skipped",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task_skipped,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1152,
+        .name = "task_reset",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task_reset,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+
+    // System clock profile (cmake -DNRWA_CLOCK_PROFILE=...) and headroom
+    {
+        .id = 1153,
+        .name = "clock_profile",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = CLOCK_PROFILE_STANDARD,
+        .ptr = (volatile uint32_t*)&g_clock_profile,
+        .enum_values = clock_profile_enum_values,
+        .enum_count = CLOCK_PROFILE_COUNT,
+    },
+    {
+        .id = 1154,
+        .name = "sys_clock_mhz",
+        .type = FIELD_TYPE_U32,
+        .units = "MHz",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_sys_clock_mhz,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1155,
+        .name = "headroom_pct",
+        .type = FIELD_TYPE_FLOAT,
+        .units = "%",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_headroom_pct,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1156,
+        .name = "wheel_profile",
+        .type = FIELD_TYPE_STRING,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)WHEEL_PROFILE_NAME,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1157,
+        .name = "warm_restarts",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_warm_restarts,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1158,
+        .name = "param_commits",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_param_commits,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1159,
+        .name = "param_swaps",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_param_swaps,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+
+    // Budget governor (selected task, then all tasks)
+    {
+        .id = 1160,
+        .name = "task_priority",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = TASK_SCHED_PRIO_HARD,
+        .ptr = (volatile uint32_t*)&g_task_priority,
+        .enum_values = task_priority_enum_values,
+        .enum_count = TASK_SCHED_PRIO_COUNT,
+    },
+    {
+        .id = 1161,
+        .name = "task_deferred",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task_deferred,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1162,
+        .name = "task_shed",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_task_shed,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1163,
+        .name = "shed_ticks",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&g_shed_ticks,
         .enum_values = NULL,
         .enum_count = 0,
     },
 };
 
-static table_meta_t table_core1_stats = {
+const table_meta_t table_core1_stats_meta = {
     .id = 11,
     .name = "Core1 Physics Stats",
     .fields = table_core1_stats_fields,
@@ -273,8 +860,8 @@ static table_meta_t table_core1_stats = {
 // Public API
 // ============================================================================
 
-table_meta_t* table_core1_stats_get(void) {
-    return &table_core1_stats;
+const table_meta_t* table_core1_stats_get(void) {
+    return &table_core1_stats_meta;
 }
 
 void table_core1_stats_init(void) {
@@ -283,19 +870,130 @@ void table_core1_stats_init(void) {
     memset(&g_update_buffer, 0, sizeof(g_update_buffer));
     g_snapshot_valid = false;
     g_jitter_violations = 0;
+    g_cmd_queued = 0;
+    g_cmd_dropped = 0;
+    g_cmd_queue_peak = 0;
+    g_telem_read_retries = 0;
+    g_physics_us = 0;
+    g_max_physics_us = 0;
+    g_serialize_us = 0;
+    memset(&g_exec_summary, 0, sizeof(g_exec_summary));
+    memset(&g_wake_summary, 0, sizeof(g_wake_summary));
+    g_deadline_misses = 0;
+    g_last_miss_tick = 0;
+    g_last_miss_us = 0;
+    g_busy_us = 0;
+    g_max_busy_us = 0;
+    g_load_pct = 0.0f;
+    g_tick_source = g_tick_source_prev = timebase_get_mode();
+    g_steps_per_pulse = timebase_get_steps_per_pulse();
+    g_step_request = 0;
+
+    // Task selector lists what Core1 registered (done before Core0 gets here);
+    // unused slots read "?"
+    for (uint8_t i = 0; i < TASK_SCHED_MAX_TASKS; i++) {
+        task_enum_values[i] = task_sched_get_name(i);
+    }
+    g_task = 0;
+    g_task_reset = 0;
+    g_clock_profile = clock_profile_get();
+    g_sys_clock_mhz = clock_profile_get_sys_hz() / 1000000u;
+    g_headroom_pct = 100.0f;
+    g_warm_restarts = warm_restart_get_count();
 
-    // Register table with catalog
-    catalog_register_table(&table_core1_stats);
 }
 
 void table_core1_stats_update(void) {
+    // Everything here moves with Core1 ticks, NSP SIM-STEP or a field edit
+    static core_sync_doorbell_t bell;
+    if (!core_sync_doorbell_take(&bell, CORE_SYNC_BELL(CORE_SYNC_BELL_SNAPSHOT) |
+                                        CORE_SYNC_BELL(CORE_SYNC_BELL_BUS) |
+                                        CORE_SYNC_BELL(CORE_SYNC_BELL_CONFIG), 0)) {
+        return;
+    }
+
+    // Tick source edits take effect here; NSP SIM-STEP may change it too
+    if (g_tick_source != g_tick_source_prev && g_tick_source <= TIMEBASE_STEPPED) {
+        timebase_set_mode((timebase_mode_t)g_tick_source);
+        printf("[Timebase] Tick source: %s\n", tick_source_enum_values[g_tick_source]);
+    }
+    g_tick_source = g_tick_source_prev = timebase_get_mode();
+    timebase_set_steps_per_pulse(g_steps_per_pulse);
+    if (g_step_request != 0) {
+        if (!timebase_step(g_step_request)) {
+            printf("[Timebase] step ignored: tick_source is FREE_RUN\n");
+        }
+        g_step_request = 0;
+    }
+    g_steps_pending = timebase_get_pending_steps();
+    g_sim_time_ms = (uint32_t)(timebase_get_sim_us() / 1000u);
+
+    // Scheduler budget accounting for the selected task
+    if (g_task_reset != 0) {
+        task_sched_request_reset();
+        g_task_reset = 0;
+    }
+    if (g_task >= task_sched_get_count()) {
+        g_task = 0;
+    }
+    task_sched_stats_t task;
+    if (task_sched_get_stats((uint8_t)g_task, &task)) {
+        g_task_period = task.period_ticks;
+        g_task_budget_us = task.budget_us;
+        g_task_last_us = task.last_us;
+        g_task_max_us = task.max_us;
+        g_task_mean_us = task.runs ? (uint32_t)(task.total_us / task.runs) : 0;
+        g_task_runs = task.runs;
+        g_task_overruns = task.overruns;
+        g_task_skipped = task.skipped;
+        g_task_priority = task.priority;
+        g_task_deferred = task.deferred;
+        g_task_shed = task.shed;
+    }
+    g_shed_ticks = task_sched_get_shed_ticks();
+
+    core_sync_get_command_stats(&g_cmd_queued, &g_cmd_dropped, &g_cmd_queue_peak);
+    core_sync_get_param_stats(&g_param_commits, &g_param_swaps);
+    g_telem_read_retries = core_sync_telemetry_read_retries();
+
+    tick_trace_get_exec(&g_exec_summary);
+    timebase_get_wake_latency(&g_wake_summary);
+    g_deadline_misses = tick_trace_get_miss_count();
+    tick_sample_t last_miss;
+    if (tick_trace_get_misses(&last_miss, 1) == 1) {
+        g_last_miss_tick = last_miss.tick;
+        g_last_miss_us = last_miss.wake_us + last_miss.exec_us;
+    } else {
+        g_last_miss_tick = 0;
+        g_last_miss_us = 0;
+    }
+
     // Read latest telemetry snapshot from Core1 into temporary buffer
-    if (core_sync_read_telemetry(&g_update_buffer)) {
-        // Track jitter violations (>200µs)
-        if (g_update_buffer.jitter_us > 200) {
+    // (skipped without copying if Core1 has not published since last time)
+    uint32_t last_tick = g_snapshot_valid ? g_display_snapshot.tick_count : UINT32_MAX;
+    if (core_sync_read_telemetry_newer(last_tick, &g_update_buffer)) {
+        // Track jitter violations (>MAX_TICK_JITTER_US, 2% of the tick period)
+        if (g_update_buffer.jitter_us > MAX_TICK_JITTER_US) {
             g_jitter_violations++;
         }
 
+        // Integrator cost as seen by Core1
+        g_physics_us = g_update_buffer.physics_us;
+        if (g_physics_us > g_max_physics_us) {
+            g_max_physics_us = g_physics_us;
+        }
+        g_serialize_us = g_update_buffer.serialize_us;
+
+        // Core1 load: awake time per tick, one-second average as a percentage
+        g_busy_us = g_update_buffer.busy_us;
+        if (g_busy_us > g_max_busy_us) {
+            g_max_busy_us = g_busy_us;
+        }
+        g_load_pct = (float)g_update_buffer.load_permille / 10.0f;
+
+        // Headroom left by the worst tick at this clock profile
+        g_headroom_pct = 100.0f - (100.0f * (float)g_max_busy_us) / (float)PHYSICS_TICK_PERIOD_US;
+
         // Atomically swap buffers - disable interrupts to prevent TUI from
         // reading partially-updated display snapshot during struct copy
         uint32_t save = save_and_disable_interrupts();
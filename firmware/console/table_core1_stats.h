@@ -15,7 +15,7 @@
  *
  * @return Pointer to table metadata
  */
-table_meta_t* table_core1_stats_get(void);
+const table_meta_t* table_core1_stats_get(void);
 
 /**
  * @brief Initialize Core1 stats table
@@ -37,7 +37,6 @@ static const field_meta_t dynamics_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&dyn_speed_rpm,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -49,7 +48,6 @@ static const field_meta_t dynamics_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&dyn_momentum_nms,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -61,7 +59,6 @@ static const field_meta_t dynamics_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&dyn_torque_cmd_mnm,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -73,7 +70,6 @@ static const field_meta_t dynamics_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&dyn_torque_out_mnm,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -85,7 +81,6 @@ static const field_meta_t dynamics_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&dyn_current_cmd_ma,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -97,7 +92,6 @@ static const field_meta_t dynamics_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&dyn_current_out_ma,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -109,7 +103,6 @@ static const field_meta_t dynamics_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&dyn_power_w,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -121,7 +114,6 @@ static const field_meta_t dynamics_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&dyn_loss_visc,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -133,7 +125,6 @@ static const field_meta_t dynamics_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&dyn_loss_fric,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -145,7 +136,6 @@ static const field_meta_t dynamics_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&dyn_alpha_rad_s2,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -155,19 +145,10 @@ static const field_meta_t dynamics_fields[] = {
 // Table Definition
 // ============================================================================
 
-static const table_meta_t dynamics_table = {
+const table_meta_t table_dynamics_meta = {
     .id = 5,
     .name = "Dynamics Status",
     .description = "Speed, momentum, torque, current, power",
     .fields = dynamics_fields,
     .field_count = sizeof(dynamics_fields) / sizeof(dynamics_fields[0]),
 };
-
-// ============================================================================
-// Initialization
-// ============================================================================
-
-void table_dynamics_init(void) {
-    // Register table with catalog
-    catalog_register_table(&dynamics_table);
-}
@@ -10,9 +10,4 @@
 
 #include <stdint.h>
 
-/**
- * @brief Initialize Dynamics table and register with catalog
- */
-void table_dynamics_init(void);
-
 #endif // TABLE_DYNAMICS_H
@@ -9,24 +9,18 @@
 #include "tables.h"
 #include "../config/scenario.h"
 #include "../config/scenario_registry.h"
+#include "../config/scenario_library.h"
 #include "../config/json_loader.h"
+#include "scenario_images.h"
+#include "../drivers/rs485_uart.h"
+#include "../util/flash_store.h"
+#include "../util/core_sync.h"
+#include "../nsp_handler.h"
+#include "warm_restart.h"
 #include "pico/stdlib.h"
 #include <stdio.h>
 #include <string.h>
 
-// ============================================================================
-// Enum String Tables (UPPERCASE)
-// ============================================================================
-
-// Scenario enum (matching scenario_registry.c order)
-static const char* scenario_enum[] = {
-    "SINGLE CRC ERROR",
-    "CRC BURST TEST",
-    "FRAME DROP 50%",
-    "OVERSPEED FAULT",
-    "POWER LIMIT TEST"
-};
-
 // ============================================================================
 // Live Data
 // ============================================================================
@@ -35,6 +29,27 @@ static volatile uint32_t fic_scenario_index = 0;        // Selected scenario ind
 static volatile uint32_t fic_scenario_count = 0;        // Total scenarios available
 static volatile uint32_t fic_trigger = 0;                // Execute trigger (write 1 to execute)
 static char fic_selected_name[64] = "";                  // Selected scenario name
+static volatile uint32_t fic_xport_dropped = 0;          // Replies dropped by injection
+static volatile uint32_t fic_xport_corrupted = 0;        // Replies sent with a bad CRC
+static volatile uint32_t fic_xport_nacked = 0;           // Replies forced to NACK
+static volatile uint32_t fic_xport_delayed = 0;          // Replies held by delay_reply_ms
+static volatile uint32_t fic_defer_max_late_us = 0;      // Worst delayed-reply release error
+static volatile uint32_t fic_library_count = 0;          // User scenarios stored in flash
+static volatile uint32_t fic_flash_park_max_us = 0;      // Longest Core1 park for a flash write
+static volatile uint32_t fic_flash_jitter_max_us = 0;    // Worst tick lateness during flash writes
+static volatile uint32_t fic_rng_seed = 0;               // RNG seed of the current/last run
+static volatile uint32_t fic_seed_override = 0;          // Seed for the next run (0 = scenario's)
+static volatile uint32_t fic_xport_bursts = 0;           // Loss bursts entered (burst model)
+static volatile uint32_t fic_layer = SCENARIO_BASE_LAYER; // Layer trigger loads the scenario into
+static volatile uint32_t fic_active_layers = 0;          // Bit per layer running a scenario
+
+// Scenario index: built-ins first, then one entry per library slot
+#define FIC_SCENARIO_CHOICES    (SCENARIO_BUILTIN_COUNT + SCENARIO_LIBRARY_SLOTS)
+static const char* fic_scenario_enum[FIC_SCENARIO_CHOICES];
+
+// Console uploads are parsed as they arrive, in chunks of what is buffered
+#define FIC_UPLOAD_CHUNK        64
+static json_stream_t fic_upload;
 
 // ============================================================================
 // Field Definitions
@@ -49,9 +64,8 @@ static const field_meta_t fault_injection_fields[] = {
         .access = FIELD_ACCESS_RW,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&fic_scenario_index,
-        .dirty = false,
-        .enum_values = scenario_enum,
-        .enum_count = 5,
+        .enum_values = fic_scenario_enum,           // Built-ins, then library slots
+        .enum_count = FIC_SCENARIO_CHOICES,
     },
     {
         .id = 1002,
@@ -61,7 +75,6 @@ static const field_meta_t fault_injection_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&fic_scenario_count,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -73,7 +86,6 @@ static const field_meta_t fault_injection_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)fic_selected_name,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -85,7 +97,149 @@ static const field_meta_t fault_injection_fields[] = {
         .access = FIELD_ACCESS_RW,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&fic_trigger,
-        .dirty = false,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1005,
+        .name = "xport_dropped",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_xport_dropped,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1006,
+        .name = "xport_corrupted",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_xport_corrupted,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1007,
+        .name = "xport_nacked",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_xport_nacked,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1008,
+        .name = "xport_delayed",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_xport_delayed,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1009,
+        .name = "delay_max_late_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_defer_max_late_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1010,
+        .name = "library_count",
+        .type = FIELD_TYPE_U8,
+        .units = "scenarios",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_library_count,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1011,
+        .name = "flash_park_max_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_flash_park_max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1012,
+        .name = "rng_seed",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_rng_seed,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1013,
+        .name = "seed_override",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_seed_override,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1014,
+        .name = "xport_bursts",
+        .type = FIELD_TYPE_U32,
+        .units = "bursts",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_xport_bursts,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1015,
+        .name = "flash_jitter_max_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_flash_jitter_max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1016,
+        .name = "scenario_layer",
+        .type = FIELD_TYPE_U8,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = SCENARIO_BASE_LAYER,
+        .ptr = (volatile uint32_t*)&fic_layer,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1017,
+        .name = "active_layers",
+        .type = FIELD_TYPE_HEX,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fic_active_layers,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -95,7 +249,7 @@ static const field_meta_t fault_injection_fields[] = {
 // Table Definition
 // ============================================================================
 
-static const table_meta_t fault_injection_table = {
+const table_meta_t table_fault_injection_meta = {
     .id = 10,
     .name = "Fault Injection Control",
     .description = "Scenario selection and execution",
@@ -103,18 +257,53 @@ static const table_meta_t fault_injection_table = {
     .field_count = sizeof(fault_injection_fields) / sizeof(fault_injection_fields[0]),
 };
 
+// ============================================================================
+// Scenario Selection (built-ins and library)
+// ============================================================================
+
+/**
+ * @brief Rebuild the scenario_index choices after the library changed
+ */
+static void fic_refresh_choices(void) {
+    for (uint8_t i = 0; i < SCENARIO_BUILTIN_COUNT; i++) {
+        fic_scenario_enum[i] = g_scenario_registry_enum[i];
+    }
+    for (uint8_t slot = 0; slot < SCENARIO_LIBRARY_SLOTS; slot++) {
+        const scenario_entry_t* entry = scenario_library_get(slot);
+        fic_scenario_enum[SCENARIO_BUILTIN_COUNT + slot] = entry ? entry->name : "(empty slot)";
+    }
+    fic_library_count = scenario_library_count();
+    fic_scenario_count = scenario_registry_count() + fic_library_count;
+}
+
+/**
+ * @brief Resolve a scenario_index to its entry
+ *
+ * @return Built-in or library entry, or NULL for an empty slot
+ */
+static const scenario_entry_t* fic_get_entry(uint32_t index) {
+    if (index < SCENARIO_BUILTIN_COUNT) {
+        return scenario_registry_get((uint8_t)index);
+    }
+    if (index < FIC_SCENARIO_CHOICES) {
+        return scenario_library_get((uint8_t)(index - SCENARIO_BUILTIN_COUNT));
+    }
+    return NULL;
+}
+
 // ============================================================================
 // Initialization
 // ============================================================================
 
 void table_fault_injection_init(void) {
-    // Initialize scenario count
-    fic_scenario_count = scenario_registry_count();
+    // Index the user scenarios already in flash
+    scenario_library_init();
+    fic_refresh_choices();
     fic_scenario_index = 0;
     fic_trigger = 0;
 
     // Set initial selected name
-    const scenario_entry_t* entry = scenario_registry_get(fic_scenario_index);
+    const scenario_entry_t* entry = fic_get_entry(fic_scenario_index);
     if (entry) {
         strncpy(fic_selected_name, entry->name, sizeof(fic_selected_name) - 1);
         fic_selected_name[sizeof(fic_selected_name) - 1] = '\0';
@@ -122,8 +311,6 @@ void table_fault_injection_init(void) {
         strcpy(fic_selected_name, "(none)");
     }
 
-    // Register table with catalog
-    catalog_register_table(&fault_injection_table);
 }
 
 // ============================================================================
@@ -131,13 +318,43 @@ void table_fault_injection_init(void) {
 // ============================================================================
 
 void table_fault_injection_update(void) {
-    // Clamp scenario index to valid range
-    if (fic_scenario_index >= fic_scenario_count) {
+    // Transport counters move with the bus, flash stats with time
+    static core_sync_doorbell_t bell;
+    if (!core_sync_doorbell_take(&bell, CORE_SYNC_BELL(CORE_SYNC_BELL_BUS) |
+                                        CORE_SYNC_BELL(CORE_SYNC_BELL_SCENARIO) |
+                                        CORE_SYNC_BELL(CORE_SYNC_BELL_CONFIG),
+                                 CORE_SYNC_DOORBELL_AGE_US)) {
+        return;
+    }
+
+    // Transport injections applied on the wire by the last scenario run
+    uint32_t dropped, corrupted, nacked, delayed, max_late_us;
+    scenario_get_transport_stats(&dropped, &corrupted, &nacked, &delayed);
+    rs485_get_deferred_stats(NULL, NULL, NULL, &max_late_us);
+    fic_xport_dropped = dropped;
+    fic_xport_corrupted = corrupted;
+    fic_xport_nacked = nacked;
+    fic_xport_delayed = delayed;
+    fic_defer_max_late_us = max_late_us;
+    fic_xport_bursts = scenario_get_burst_count();
+    fic_rng_seed = scenario_get_seed();
+    fic_active_layers = scenario_get_active_layers();
+
+    flash_store_stats_t flash;
+    flash_store_get_stats(&flash);
+    fic_flash_park_max_us = flash.max_park_us;
+    fic_flash_jitter_max_us = flash.max_jitter_us;
+
+    // Clamp scenario index and layer to valid range
+    if (fic_scenario_index >= FIC_SCENARIO_CHOICES) {
         fic_scenario_index = 0;
     }
+    if (fic_layer >= SCENARIO_LAYERS) {
+        fic_layer = SCENARIO_BASE_LAYER;
+    }
 
     // Update selected scenario name
-    const scenario_entry_t* entry = scenario_registry_get(fic_scenario_index);
+    const scenario_entry_t* entry = fic_get_entry(fic_scenario_index);
     if (entry) {
         strncpy(fic_selected_name, entry->name, sizeof(fic_selected_name) - 1);
         fic_selected_name[sizeof(fic_selected_name) - 1] = '\0';
@@ -156,24 +373,40 @@ void table_fault_injection_update(void) {
 // Scenario Execution with Live Playback
 // ============================================================================
 
+/**
+ * @brief Block until a key is pressed
+ *
+ * Beats for the watchdog while it waits: a prompt is not a hung main loop.
+ */
+static int fic_wait_key(void) {
+    int c;
+    while ((c = getchar_timeout_us(0)) == PICO_ERROR_TIMEOUT) {
+        warm_restart_core0_beat();
+        sleep_ms(10);
+    }
+    return c;
+}
+
 /**
  * @brief Execute selected scenario with live console playback
  *
  * This function:
  * 1. Clears screen and shows scenario details
- * 2. Loads and activates scenario
+ * 2. Loads and activates scenario in the scenario_layer layer
  * 3. Runs timeline with live event logging
  * 4. Waits for keypress to return to TUI
+ *
+ * Scenarios running in other layers keep running throughout.
  */
 void fault_injection_execute(void) {
+    uint8_t layer = (uint8_t)fic_layer;
+
     // Get selected scenario
-    const scenario_entry_t* entry = scenario_registry_get(fic_scenario_index);
+    const scenario_entry_t* entry = fic_get_entry(fic_scenario_index);
     if (!entry) {
-        printf("\n[ERROR] Invalid scenario index: %d\n", fic_scenario_index);
+        printf("\n[ERROR] No scenario at index %d (empty library slot?)\n", fic_scenario_index);
         printf("Press any key to return...\n");
-        while (getchar_timeout_us(0) == PICO_ERROR_TIMEOUT) {
-            sleep_ms(100);
-        }
+        fic_wait_key();
         return;
     }
 
@@ -186,33 +419,30 @@ void fault_injection_execute(void) {
 
     // Load scenario
     printf("[LOAD] Loading scenario...\n");
-    bool loaded = scenario_load(entry->json_data, entry->json_len);
+    bool loaded = scenario_layer_load_image(layer, entry->image, entry->image_len);
     if (!loaded) {
-        printf("[ERROR] Failed to load scenario: %s\n", json_get_last_error());
+        printf("[ERROR] Failed to load scenario: %s\n", scenario_bin_validate(entry->image, entry->image_len));
         printf("\nPress any key to return to TUI...\n");
-        while (getchar_timeout_us(0) == PICO_ERROR_TIMEOUT) {
-            sleep_ms(100);
-        }
+        fic_wait_key();
         return;
     }
 
     // Show scenario details
-    const char* desc = scenario_get_description();
+    const char* desc = scenario_layer_get_description(layer);
     if (desc) {
         printf("[INFO] %s\n", desc);
     }
-    printf("[INFO] Events: %d\n", scenario_get_total_events());
+    printf("[INFO] Events: %d (layer %u)\n", scenario_layer_get_total_events(layer), (unsigned)layer);
     printf("\n");
 
-    // Activate scenario
+    // Activate scenario (seed_override replays a logged run)
     printf("[EXEC] Activating scenario...\n");
-    bool activated = scenario_activate();
+    scenario_set_seed(fic_seed_override);
+    bool activated = scenario_layer_activate(layer);
     if (!activated) {
         printf("[ERROR] Failed to activate scenario\n");
         printf("\nPress any key to return to TUI...\n");
-        while (getchar_timeout_us(0) == PICO_ERROR_TIMEOUT) {
-            sleep_ms(100);
-        }
+        fic_wait_key();
         return;
     }
 
@@ -224,12 +454,14 @@ void fault_injection_execute(void) {
     uint32_t last_triggered = 0;
     uint32_t update_counter = 0;
 
-    while (scenario_is_active()) {
+    while (scenario_layer_is_active(layer)) {
+        warm_restart_core0_beat();
+
         // Update scenario engine (checks for event triggers)
         scenario_update();
 
         // Check if new events triggered
-        uint32_t triggered = scenario_get_triggered_count();
+        uint32_t triggered = scenario_layer_get_triggered_count(layer);
         if (triggered > last_triggered) {
             // New event triggered - already logged by scenario engine
             last_triggered = triggered;
@@ -237,9 +469,9 @@ void fault_injection_execute(void) {
 
         // Show periodic status update (every second)
         if ((update_counter % 100) == 0) {  // 100 * 10ms = 1 second
-            uint32_t elapsed = scenario_get_elapsed_ms();
+            uint32_t elapsed = scenario_layer_get_elapsed_ms(layer);
             printf("[STATUS] t=%lu ms: %d/%d events triggered\n",
-                   elapsed, triggered, scenario_get_total_events());
+                   elapsed, triggered, scenario_layer_get_total_events(layer));
         }
 
         update_counter++;
@@ -257,13 +489,20 @@ void fault_injection_execute(void) {
 
     // Deactivate scenario
     printf("────────────────────────────────────────────────────────────────\n");
-    scenario_deactivate();
+    scenario_layer_deactivate(layer);
 
     // Show summary
-    uint32_t final_triggered = scenario_get_triggered_count();
-    uint32_t total_events = scenario_get_total_events();
+    uint32_t final_triggered = scenario_layer_get_triggered_count(layer);
+    uint32_t total_events = scenario_layer_get_total_events(layer);
     printf("\n[DONE] Scenario complete\n");
     printf("[SUMMARY] %d/%d events triggered\n", final_triggered, total_events);
+    uint32_t dropped, corrupted, nacked, delayed;
+    scenario_get_transport_stats(&dropped, &corrupted, &nacked, &delayed);
+    printf("[SUMMARY] Replies: %lu dropped, %lu CRC-corrupted, %lu forced NACK, %lu delayed\n",
+           (unsigned long)dropped, (unsigned long)corrupted, (unsigned long)nacked,
+           (unsigned long)delayed);
+    printf("[SUMMARY] RNG seed %lu (set seed_override to replay), %lu loss bursts\n",
+           (unsigned long)scenario_get_seed(), (unsigned long)scenario_get_burst_count());
     printf("[INFO] Trigger field auto-cleared (one-shot activation)\n");
 
     if (final_triggered == total_events) {
@@ -274,10 +513,187 @@ void fault_injection_execute(void) {
 
     // Wait for keypress to return
     printf("\nPress any key to return to TUI...\n");
-    while (getchar_timeout_us(0) == PICO_ERROR_TIMEOUT) {
-        sleep_ms(100);
-    }
+    fic_wait_key();
 
     // Clear screen before returning to TUI
     printf("\033[2J\033[H");  // Clear screen, move cursor to home
 }
+
+const char* fault_injection_start(uint32_t index, uint8_t layer) {
+    const scenario_entry_t* entry = fic_get_entry(index);
+    if (!entry) {
+        return "no scenario at index";
+    }
+    if (layer >= SCENARIO_LAYERS) {
+        return "no such layer";
+    }
+    if (!scenario_layer_load_image(layer, entry->image, entry->image_len)) {
+        const char* err = scenario_bin_validate(entry->image, entry->image_len);
+        return err ? err : "load failed";
+    }
+    scenario_set_seed(fic_seed_override);
+    if (!scenario_layer_activate(layer)) {
+        return "activation failed";
+    }
+    return NULL;
+}
+
+// ============================================================================
+// Scenario Library (upload to flash)
+// ============================================================================
+
+/**
+ * @brief Discard input until the host stops sending (rest of a failed paste)
+ */
+static void fic_drain_input(void) {
+    while (getchar_timeout_us(100000) != PICO_ERROR_TIMEOUT) {
+    }
+}
+
+/**
+ * @brief Receive a pasted JSON scenario, compile it and store it in flash
+ *
+ * Input is parsed chunk by chunk straight into the RAM image, so the
+ * document size is not limited by a staging buffer, and NSP keeps being
+ * serviced between chunks.
+ */
+static void fic_library_upload(void) {
+    printf("\nPaste the scenario JSON (ends at its closing brace; Ctrl-D ends early, ESC cancels)...\n");
+
+    scenario_bin_builder_t* builder = scenario_begin_ram_image();
+    if (builder == NULL) {
+        return;
+    }
+    json_stream_begin(&fic_upload, builder);
+
+    char chunk[FIC_UPLOAD_CHUNK];
+    uint32_t received = 0;
+    bool end_of_input = false;
+    uint64_t idle_deadline = time_us_64() + 30000000ull;  // 30 s without input aborts
+
+    while (!end_of_input && !json_stream_done(&fic_upload)) {
+        warm_restart_core0_beat();
+
+        // Collect whatever has arrived (waiting briefly for the first byte)
+        size_t n = 0;
+        int c;
+        while (n < sizeof(chunk) &&
+               (c = getchar_timeout_us(n == 0 ? 1000 : 0)) != PICO_ERROR_TIMEOUT) {
+            if (c == 27) {  // ESC
+                printf("\n[ABORT] Upload cancelled\n");
+                fic_drain_input();
+                return;
+            }
+            if (c == 0x04) {  // Ctrl-D: end of document
+                end_of_input = true;
+                break;
+            }
+            chunk[n++] = (char)c;
+        }
+
+        if (n == 0) {
+            if (!end_of_input && time_us_64() > idle_deadline) {
+                printf("\n[ERROR] Upload timed out\n");
+                return;
+            }
+        } else {
+            idle_deadline = time_us_64() + 30000000ull;
+            if ((received / 256) != ((received + n) / 256)) {
+                printf(".");
+            }
+            received += n;
+            if (!json_stream_feed(&fic_upload, chunk, n)) {
+                break;
+            }
+        }
+
+        // Keep NSP serviced between chunks
+        nsp_handler_poll();
+    }
+
+    if (!json_stream_end(&fic_upload)) {
+        uint32_t offset;
+        const char* error = json_stream_error(&fic_upload, &offset);
+        printf("\n[ERROR] Parse failed at byte %lu: %s\n", (unsigned long)offset, error);
+        fic_drain_input();
+        return;
+    }
+    printf("\n[LOAD] Parsed %lu bytes\n", (unsigned long)received);
+
+    if (!scenario_load_ram_image()) {
+        return;  // Engine printed the reason
+    }
+
+    // Copy the compiled RAM image into a flash slot
+    const scenario_bin_header_t* image = scenario_get_image();
+    uint8_t slot = 0;
+    const char* error = scenario_library_store(image, image->total_len, &slot);
+    if (error != NULL) {
+        printf("[ERROR] Not stored: %s\n", error);
+        return;
+    }
+
+    // Run from flash from now on, and select it in Table 10
+    const scenario_entry_t* entry = scenario_library_get(slot);
+    scenario_layer_load_image((uint8_t)fic_layer, entry->image, entry->image_len);
+    fic_refresh_choices();
+    fic_scenario_index = SCENARIO_BUILTIN_COUNT + slot;
+
+    flash_store_stats_t flash;
+    flash_store_get_stats(&flash);
+    printf("[DONE] Stored \"%s\" in slot %u (%u bytes, Core1 parked %lu us at most, "
+           "worst tick lateness %lu us)\n", entry->name, (unsigned)slot, (unsigned)entry->image_len,
+           (unsigned long)flash.last_park_us, (unsigned long)flash.max_jitter_us);
+}
+
+void fault_injection_library_menu(void) {
+    while (1) {
+        printf("\033[2J\033[H");  // Clear screen, move cursor to home
+        printf("═══ Scenario Library (flash) ═══\n\n");
+        for (uint8_t slot = 0; slot < SCENARIO_LIBRARY_SLOTS; slot++) {
+            const scenario_entry_t* entry = scenario_library_get(slot);
+            if (entry) {
+                const scenario_bin_header_t* image = entry->image;
+                printf("  %X: %-32s %4u bytes, %3u events\n", (unsigned)slot, entry->name,
+                       (unsigned)entry->image_len, (unsigned)image->event_count);
+            } else {
+                printf("  %X: (empty)\n", (unsigned)slot);
+            }
+        }
+        printf("\n  U: Upload JSON scenario | X: Erase a slot | Q: Return\n");
+        printf("  Library scenarios are selected in Table 10 after the built-ins.\n");
+
+        int key = fic_wait_key();
+        if (key == 'u' || key == 'U') {
+            fic_library_upload();
+        } else if (key == 'x' || key == 'X') {
+            printf("\nSlot to erase (0-F): ");
+            int c = fic_wait_key();
+            int slot = -1;
+            if (c >= '0' && c <= '9') slot = c - '0';
+            else if (c >= 'a' && c <= 'f') slot = 10 + (c - 'a');
+            else if (c >= 'A' && c <= 'F') slot = 10 + (c - 'A');
+            if (slot < 0 || slot >= SCENARIO_LIBRARY_SLOTS) {
+                printf("\n[ABORT] Invalid slot\n");
+            } else {
+                const char* error = scenario_library_erase((uint8_t)slot);
+                if (error != NULL) {
+                    printf("\n[ERROR] Not erased: %s\n", error);
+                } else {
+                    printf("\n[DONE] Slot %X erased\n", (unsigned)slot);
+                }
+                fic_refresh_choices();
+            }
+        } else if (key == 'q' || key == 'Q' || key == 27) {
+            break;
+        } else {
+            continue;
+        }
+
+        printf("\nPress any key to continue...\n");
+        fic_wait_key();
+    }
+
+    // Clear screen before returning to TUI
+    printf("\033[2J\033[H");
+}
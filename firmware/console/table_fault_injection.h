@@ -10,7 +10,7 @@
 #include <stdint.h>
 
 /**
- * @brief Initialize Fault Injection Control table and register with catalog
+ * @brief Initialize Fault Injection Control table state
  */
 void table_fault_injection_init(void);
 
@@ -29,4 +29,24 @@ void table_fault_injection_update(void);
  */
 void fault_injection_execute(void);
 
+/**
+ * @brief Scenario library menu (list, upload JSON to flash, erase slots)
+ *
+ * Uploaded scenarios are compiled, stored in a flash slot and run from
+ * flash when selected in Table 10.
+ */
+void fault_injection_library_menu(void);
+
+/**
+ * @brief Load and activate a scenario without console playback
+ *
+ * For the batch protocol; scenario_update() in the main loop runs it, and
+ * scenario_layer_deactivate() stops it. Uses the seed_override field.
+ *
+ * @param index Scenario index (as scenario_index: built-ins, then library slots)
+ * @param layer Scenario layer to run it in (others keep running)
+ * @return NULL on success, or the reason it could not start
+ */
+const char* fault_injection_start(uint32_t index, uint8_t layer);
+
 #endif // TABLE_FAULT_INJECTION_H
@@ -0,0 +1,228 @@
+/**
+ * @file table_flight_rec.c
+ * @brief Flight Recorder Table Implementation
+ *
+ * Table 15: Flight Recorder (pre/post-trigger physics capture)
+ *
+ * trigger_mask and post_ticks take effect on the next arm. The capture is
+ * downloaded on the telemetry USB port (drivers/usb_stream.h).
+ */
+
+#include "table_flight_rec.h"
+#include "tables.h"
+#include "../util/flight_rec.h"
+#include "../drivers/usb_stream.h"
+
+// ============================================================================
+// Live Data (Connected to Flight Recorder)
+// ============================================================================
+
+static volatile uint32_t rec_state_val = 0;                          // flight_rec_state_t
+static volatile uint32_t rec_trigger_mask = FLIGHT_REC_TRIG_ALL;     // FLIGHT_REC_TRIG_* for the next arm
+static volatile uint32_t rec_post_ticks = FLIGHT_REC_TICKS / 4;      // Ticks kept after the trigger
+static volatile uint32_t rec_arm = 0;                                // Write 1 to clear and re-arm
+static volatile uint32_t rec_trigger = 0;                            // Write 1 to trigger now
+static volatile uint32_t rec_cause = 0;                              // Trigger that fired
+static volatile uint32_t rec_trigger_wheel = 0;                      // Wheel that fired it
+static volatile uint32_t rec_trigger_tick = 0;                       // Physics tick of the trigger
+static volatile uint32_t rec_ticks = 0;                              // Ticks captured
+static volatile uint32_t rec_pre_ticks = 0;                          // Ticks before the trigger
+static volatile uint32_t rec_capacity = FLIGHT_REC_TICKS;            // Buffer size in ticks
+static volatile uint32_t rec_download = 0;                           // Write 1 to send the capture
+static volatile uint32_t rec_downloads = 0;                          // Downloads completed
+
+static const char* rec_state_enum[] = {
+    "ARMED",
+    "TRIGGERED",
+    "FROZEN",
+};
+
+// ============================================================================
+// Field Definitions
+// ============================================================================
+
+static const field_meta_t flight_rec_fields[] = {
+    {
+        .id = 1501,
+        .name = "state",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rec_state_val,
+        .enum_values = rec_state_enum,
+        .enum_count = sizeof(rec_state_enum) / sizeof(rec_state_enum[0]),
+    },
+    {
+        .id = 1502,
+        .name = "trigger_mask",
+        .type = FIELD_TYPE_HEX,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = FLIGHT_REC_TRIG_ALL,
+        .ptr = (volatile uint32_t*)&rec_trigger_mask,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1503,
+        .name = "post_ticks",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RW,
+        .default_val = FLIGHT_REC_TICKS / 4,
+        .ptr = (volatile uint32_t*)&rec_post_ticks,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1504,
+        .name = "arm",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rec_arm,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1505,
+        .name = "trigger",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rec_trigger,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1506,
+        .name = "cause",
+        .type = FIELD_TYPE_HEX,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rec_cause,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1507,
+        .name = "trigger_wheel",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rec_trigger_wheel,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1508,
+        .name = "trigger_tick",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rec_trigger_tick,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1509,
+        .name = "ticks",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rec_ticks,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1510,
+        .name = "pre_ticks",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rec_pre_ticks,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1511,
+        .name = "capacity",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RO,
+        .default_val = FLIGHT_REC_TICKS,
+        .ptr = (volatile uint32_t*)&rec_capacity,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1512,
+        .name = "download",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rec_download,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1513,
+        .name = "downloads",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rec_downloads,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+};
+
+const table_meta_t table_flight_rec_meta = {
+    .id = 15,
+    .name = "Flight Recorder",
+    .description = "Physics history around faults (download on USB port 2)",
+    .fields = flight_rec_fields,
+    .field_count = sizeof(flight_rec_fields) / sizeof(flight_rec_fields[0]),
+};
+
+// ============================================================================
+// Update Function
+// ============================================================================
+
+void table_flight_rec_update(void) {
+    if (rec_arm) {
+        rec_arm = 0;
+        flight_rec_arm(rec_trigger_mask, rec_post_ticks);
+    }
+    if (rec_trigger) {
+        rec_trigger = 0;
+        flight_rec_trigger();
+    }
+    if (rec_download) {
+        rec_download = 0;
+        usb_stream_request_flight_rec();
+    }
+
+    flight_rec_info_t info;
+    flight_rec_get_info(&info);
+    rec_state_val = (uint32_t)info.state;
+    rec_cause = info.cause;
+    rec_trigger_wheel = info.wheel;
+    rec_trigger_tick = info.trigger_tick;
+    rec_ticks = info.ticks;
+    rec_pre_ticks = info.pre_ticks;
+
+    usb_stream_stats_t stats;
+    usb_stream_get_stats(&stats);
+    rec_downloads = stats.rec_downloads;
+}
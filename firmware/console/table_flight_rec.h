@@ -0,0 +1,20 @@
+/**
+ * @file table_flight_rec.h
+ * @brief Flight Recorder Table for Console TUI
+ *
+ * Table 15: Flight Recorder (pre/post-trigger physics capture)
+ */
+
+#ifndef TABLE_FLIGHT_REC_H
+#define TABLE_FLIGHT_REC_H
+
+#include <stdint.h>
+
+/**
+ * @brief Apply arm/trigger/download requests and refresh the capture summary
+ *
+ * Call this periodically from the main loop
+ */
+void table_flight_rec_update(void);
+
+#endif // TABLE_FLIGHT_REC_H
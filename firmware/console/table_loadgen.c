@@ -0,0 +1,436 @@
+/**
+ * @file table_loadgen.c
+ * @brief Load Test Table Implementation
+ *
+ * Table 19: Load Test (on-device NSP load generator, nsp_loadgen.h)
+ *
+ * Set path, mix and step_ms, then write run = 1. The sweep runs one step
+ * per main-loop pass and prints its report on the console when done.
+ * step picks the sweep step shown below it (0 = 100 req/s, the last one is
+ * the closed-loop step with offered_hz 0). Disconnect the OBC first.
+ *
+ * replay_run = 1 replays the NSP capture loaded at FLASH_REPLAY_OFFSET
+ * (nsp_replay.h) in real time through the same injection path; it is
+ * refused while a sweep runs.
+ */
+
+#include "table_loadgen.h"
+#include "tables.h"
+#include "../nsp_loadgen.h"
+#include "../nsp_replay.h"
+#include "board_pico.h"
+#include "../util/flash_store.h"
+
+// ============================================================================
+// Live Data (Connected to Load Generator)
+// ============================================================================
+
+static volatile uint32_t lg_path = NSP_LOADGEN_PATH_INJECT;         // nsp_loadgen_path_t for the next run
+static volatile uint32_t lg_mix = NSP_LOADGEN_MIX_TELEM;            // nsp_loadgen_mix_t for the next run
+static volatile uint32_t lg_step_ms = NSP_LOADGEN_STEP_MS_DEFAULT;  // Step duration for the next run
+static volatile uint32_t lg_run = 0;                                // Write 1 to start a sweep
+static volatile uint32_t lg_state = 0;                              // nsp_loadgen_state_t
+static volatile uint32_t lg_steps_done = 0;                         // Steps completed
+static volatile uint32_t lg_max_clean_hz = 0;                       // Highest error-free rate
+static volatile uint32_t lg_first_error_hz = 0;                     // Offered rate where errors began
+static volatile uint32_t lg_step = 0;                               // Step shown below
+static volatile uint32_t lg_offered_hz = 0;
+static volatile uint32_t lg_achieved_hz = 0;
+static volatile uint32_t lg_sent = 0;
+static volatile uint32_t lg_replies = 0;
+static volatile uint32_t lg_lost = 0;
+static volatile uint32_t lg_errors = 0;
+static volatile uint32_t lg_stalled = 0;
+static volatile uint32_t lg_p50_us = 0;
+static volatile uint32_t lg_p99_us = 0;
+static volatile uint32_t lg_p999_us = 0;
+static volatile uint32_t lg_max_us = 0;
+static volatile uint32_t rp_run = 0;                                // Write 1 to replay the capture
+static volatile uint32_t rp_state = 0;                              // nsp_replay_state_t
+static volatile uint32_t rp_injected = 0;
+static volatile uint32_t rp_skipped = 0;
+static volatile uint32_t rp_tick = 0;                               // Capture tick reached
+static volatile uint32_t rp_late_max_us = 0;
+
+static const char* path_enum[] = {
+    "INJECT",
+    "LOOPBACK",
+    "WIRE",
+};
+
+static const char* mix_enum[] = {
+    "PING",
+    "TELEM",
+    "MIXED",
+};
+
+static const char* state_enum[] = {
+    "IDLE",
+    "RUNNING",
+    "DONE",
+    "FAILED",
+};
+
+// ============================================================================
+// Field Definitions
+// ============================================================================
+
+static const field_meta_t loadgen_fields[] = {
+    {
+        .id = 1901,
+        .name = "path",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_path,
+        .enum_values = path_enum,
+        .enum_count = sizeof(path_enum) / sizeof(path_enum[0]),
+    },
+    {
+        .id = 1902,
+        .name = "mix",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_mix,
+        .enum_values = mix_enum,
+        .enum_count = sizeof(mix_enum) / sizeof(mix_enum[0]),
+    },
+    {
+        .id = 1903,
+        .name = "step_ms",
+        .type = FIELD_TYPE_U32,
+        .units = "ms",
+        .access = FIELD_ACCESS_RW,
+        .default_val = NSP_LOADGEN_STEP_MS_DEFAULT,
+        .ptr = (volatile uint32_t*)&lg_step_ms,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1904,
+        .name = "run",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_run,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1905,
+        .name = "state",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_state,
+        .enum_values = state_enum,
+        .enum_count = sizeof(state_enum) / sizeof(state_enum[0]),
+    },
+    {
+        .id = 1906,
+        .name = "steps_done",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_steps_done,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1907,
+        .name = "max_clean_hz",
+        .type = FIELD_TYPE_U32,
+        .units = "req/s",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_max_clean_hz,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1908,
+        .name = "first_error_hz",
+        .type = FIELD_TYPE_U32,
+        .units = "req/s",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_first_error_hz,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1909,
+        .name = "step",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_step,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1910,
+        .name = "offered_hz",
+        .type = FIELD_TYPE_U32,
+        .units = "req/s",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_offered_hz,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1911,
+        .name = "achieved_hz",
+        .type = FIELD_TYPE_U32,
+        .units = "req/s",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_achieved_hz,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1912,
+        .name = "sent",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_sent,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1913,
+        .name = "replies",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_replies,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1914,
+        .name = "lost",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_lost,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1915,
+        .name = "errors",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_errors,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1916,
+        .name = "stalled",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_stalled,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1917,
+        .name = "p50_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_p50_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1918,
+        .name = "p99_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_p99_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1919,
+        .name = "p999_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_p999_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1920,
+        .name = "max_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&lg_max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1921,
+        .name = "replay_run",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rp_run,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1922,
+        .name = "replay_state",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rp_state,
+        .enum_values = state_enum,
+        .enum_count = sizeof(state_enum) / sizeof(state_enum[0]),
+    },
+    {
+        .id = 1923,
+        .name = "replay_injected",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rp_injected,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1924,
+        .name = "replay_skipped",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rp_skipped,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1925,
+        .name = "replay_tick",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rp_tick,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1926,
+        .name = "replay_late_max_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&rp_late_max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    }
+};
+
+const table_meta_t table_loadgen_meta = {
+    .id = 19,
+    .name = "Load Test",
+    .description = "NSP request rate sweep and capture replay (disconnect the OBC)",
+    .fields = loadgen_fields,
+    .field_count = sizeof(loadgen_fields) / sizeof(loadgen_fields[0]),
+};
+
+// ============================================================================
+// Update Function
+// ============================================================================
+
+void table_loadgen_update(void) {
+    if (lg_run) {
+        lg_run = 0;
+        nsp_loadgen_start((nsp_loadgen_path_t)lg_path, (nsp_loadgen_mix_t)lg_mix, lg_step_ms);
+    }
+
+    // Runs one step (blocking) while a sweep is in progress
+    nsp_loadgen_service();
+
+    const nsp_loadgen_report_t* report = nsp_loadgen_get_report();
+    lg_state = (uint32_t)nsp_loadgen_get_state();
+    lg_steps_done = report->steps_done;
+    lg_max_clean_hz = report->max_clean_hz;
+    lg_first_error_hz = report->first_error_hz;
+
+    if (lg_step < report->steps_done) {
+        const nsp_loadgen_step_t* step = &report->steps[lg_step];
+        lg_offered_hz = step->offered_hz;
+        lg_achieved_hz = step->achieved_hz;
+        lg_sent = step->sent;
+        lg_replies = step->replies;
+        lg_lost = step->lost;
+        lg_errors = step->errors;
+        lg_stalled = step->stalled;
+        lg_p50_us = step->latency.p50_us;
+        lg_p99_us = step->latency.p99_us;
+        lg_p999_us = step->latency.p999_us;
+        lg_max_us = step->latency.max_us;
+    } else {
+        lg_offered_hz = 0;
+        lg_achieved_hz = 0;
+        lg_sent = 0;
+        lg_replies = 0;
+        lg_lost = 0;
+        lg_errors = 0;
+        lg_stalled = 0;
+        lg_p50_us = 0;
+        lg_p99_us = 0;
+        lg_p999_us = 0;
+        lg_max_us = 0;
+    }
+
+    if (rp_run) {
+        rp_run = 0;
+        nsp_replay_start(FLASH_STORE_XIP(FLASH_REPLAY_OFFSET), FLASH_REPLAY_SIZE);
+    }
+
+    // Requests the alarm could not take (no free slot) go out from here
+    nsp_replay_service();
+
+    nsp_replay_status_t replay;
+    nsp_replay_get_status(&replay);
+    rp_state = (uint32_t)replay.state;
+    rp_injected = replay.injected;
+    rp_skipped = replay.skipped;
+    rp_tick = replay.last_tick;
+    rp_late_max_us = replay.late_max_us;
+}
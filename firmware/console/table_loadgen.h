@@ -0,0 +1,20 @@
+/**
+ * @file table_loadgen.h
+ * @brief Load Test Table for Console TUI
+ *
+ * Table 19: Load Test (on-device NSP load generator and capture replay)
+ */
+
+#ifndef TABLE_LOADGEN_H
+#define TABLE_LOADGEN_H
+
+#include <stdint.h>
+
+/**
+ * @brief Start a requested sweep, run its next step and refresh the results
+ *
+ * Call this periodically from the main loop
+ */
+void table_loadgen_update(void);
+
+#endif // TABLE_LOADGEN_H
@@ -0,0 +1,223 @@
+/**
+ * @file table_mem.c
+ * @brief Memory Table Implementation
+ *
+ * Table 20: Memory (stack high-water marks, static RAM budget)
+ *
+ * From util/mem_budget.h. A stack mark equal to its size means the stack
+ * reached its bottom (a warning is printed once). The static budget is by
+ * link section; tools/ram_report.py splits it by subsystem.
+ */
+
+#include "table_mem.h"
+#include "tables.h"
+#include "../util/mem_budget.h"
+#include <stdio.h>
+
+// ============================================================================
+// Live Data (Connected to Memory Budget)
+// ============================================================================
+
+static volatile uint32_t mem_core0_size = 0;             // Core0 stack size
+static volatile uint32_t mem_core0_hwm = 0;              // Deepest Core0 stack use
+static volatile uint32_t mem_core0_free = 0;             // Core0 headroom at the mark
+static volatile uint32_t mem_core1_size = 0;             // Core1 stack size
+static volatile uint32_t mem_core1_hwm = 0;              // Deepest Core1 stack use
+static volatile uint32_t mem_core1_free = 0;             // Core1 headroom at the mark
+static volatile uint32_t mem_data = 0;                   // Initialised data and SRAM functions
+static volatile uint32_t mem_bss = 0;                    // Zeroed data
+static volatile uint32_t mem_scratch_x = 0;              // Core1 data in SRAM4
+static volatile uint32_t mem_scratch_y = 0;              // Data in SRAM5
+static volatile uint32_t mem_heap = 0;                   // Heap obtained by malloc
+static volatile uint32_t mem_sram_free = 0;              // Main SRAM above the heap
+
+// ============================================================================
+// Field Definitions
+// ============================================================================
+
+static const field_meta_t mem_fields[] = {
+    {
+        .id = 2001,
+        .name = "core0_stack",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_core0_size,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 2002,
+        .name = "core0_stack_hwm",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_core0_hwm,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 2003,
+        .name = "core0_stack_free",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_core0_free,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 2004,
+        .name = "core1_stack",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_core1_size,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 2005,
+        .name = "core1_stack_hwm",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_core1_hwm,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 2006,
+        .name = "core1_stack_free",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_core1_free,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 2007,
+        .name = "data",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_data,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 2008,
+        .name = "bss",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_bss,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 2009,
+        .name = "scratch_x",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_scratch_x,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 2010,
+        .name = "scratch_y",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_scratch_y,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 2011,
+        .name = "heap_used",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_heap,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 2012,
+        .name = "sram_free",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&mem_sram_free,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+};
+
+// ============================================================================
+// Table Definition
+// ============================================================================
+
+const table_meta_t table_mem_meta = {
+    .id = 20,
+    .name = "Memory",
+    .description = "Stack high-water marks and static RAM budget",
+    .fields = mem_fields,
+    .field_count = sizeof(mem_fields) / sizeof(mem_fields[0]),
+};
+
+// ============================================================================
+// Update Function
+// ============================================================================
+
+/**
+ * @brief Refresh one core's stack fields, warn once if it hit the bottom
+ */
+static void update_stack(uint32_t core, volatile uint32_t* size, volatile uint32_t* hwm,
+                         volatile uint32_t* free_bytes) {
+    static bool warned[2] = { false, false };
+    mem_stack_t stack;
+    mem_budget_get_stack(core, &stack);
+    if (!stack.painted) {
+        return;
+    }
+
+    *size = stack.size;
+    *hwm = stack.high_water;
+    *free_bytes = stack.size - stack.high_water;
+    if (stack.high_water >= stack.size && !warned[core]) {
+        warned[core] = true;
+        printf("[MEM] Core%lu stack reached its bottom (%lu B): probable overflow\n",
+               (unsigned long)core, (unsigned long)stack.size);
+    }
+}
+
+void table_mem_update(void) {
+    update_stack(0, &mem_core0_size, &mem_core0_hwm, &mem_core0_free);
+    update_stack(1, &mem_core1_size, &mem_core1_hwm, &mem_core1_free);
+
+    mem_static_t budget;
+    mem_budget_get_static(&budget);
+    mem_data = budget.data;
+    mem_bss = budget.bss;
+    mem_scratch_x = budget.scratch_x;
+    mem_scratch_y = budget.scratch_y;
+    mem_heap = budget.heap_used;
+    mem_sram_free = budget.sram_free;
+}
@@ -0,0 +1,20 @@
+/**
+ * @file table_mem.h
+ * @brief Memory Table for Console TUI
+ *
+ * Table 20: Memory (stack high-water marks, static RAM budget)
+ */
+
+#ifndef TABLE_MEM_H
+#define TABLE_MEM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Refresh the stack marks and the static budget
+ *
+ * Call this periodically from the main loop
+ */
+void table_mem_update(void);
+
+#endif // TABLE_MEM_H
@@ -8,6 +8,9 @@
 #include "table_nsp.h"
 #include "tables.h"
 #include "../nsp_handler.h"
+#include "../device/nss_nrwa_t6_commands.h"
+#include "../util/nsp_trace.h"
+#include "../util/core_sync.h"
 #include <stdio.h>
 
 // ============================================================================
@@ -28,6 +31,70 @@ static volatile uint32_t nsp_last_parse_error = 0;    // Last parse error code
 static volatile uint32_t nsp_last_cmd_error = 0;      // Last command error code
 static volatile uint32_t nsp_last_frame_len = 0;      // Last frame length in bytes
 
+// Request-to-reply timing
+static volatile uint32_t nsp_turnaround_us = 0;       // Last reply turnaround
+static volatile uint32_t nsp_max_turnaround_us = 0;   // Worst-case reply turnaround
+
+// APP-TELEM reply cache
+static volatile uint32_t nsp_telem_cache_hits = 0;    // Blocks reused within one publish
+static volatile uint32_t nsp_telem_cache_misses = 0;  // Blocks encoded
+static volatile uint32_t nsp_frame_cache_hits = 0;    // Replies copied as finished frames
+
+// Reply latency percentiles for the selected command (see nsp_handler_get_latency)
+static volatile uint32_t nsp_lat_cmd = 0;             // Index into lat_cmd_codes
+static volatile uint32_t nsp_lat_reset = 0;           // Write 1 to clear histograms
+static latency_summary_t nsp_lat_start;               // SLIP END -> first reply byte
+static latency_summary_t nsp_lat_end;                 // SLIP END -> last reply stop bit
+
+// Transaction trace (binary dump on the telemetry USB port)
+static volatile uint32_t nsp_trace_total = 0;         // Transactions recorded since boot
+static volatile uint32_t nsp_trace_dump = 0;          // Write 1 to dump the trace ring
+
+// Boot
+static volatile uint32_t nsp_online_ms = 0;           // Reset to NSP service start
+
+// Bus frame rates and idle gaps over the last 1 s window (util/bus_meter.h)
+static volatile uint32_t nsp_rx_frame_rate = 0;       // Frames/s on the bus, any destination
+static volatile uint32_t nsp_tx_frame_rate = 0;       // Replies/s
+static volatile uint32_t nsp_peak_frame_rate = 0;     // Highest RX + TX frames/s
+static volatile uint32_t nsp_gap_min_us = 0;          // Idle time before a received frame
+static volatile uint32_t nsp_gap_mean_us = 0;
+static volatile uint32_t nsp_gap_max_us = 0;
+
+// Vendor extensions
+static volatile uint32_t nsp_multi_telem = 0;         // Serve MULTI-TELEMETRY (0x0D)
+
+// Commands selectable for the latency view (index = enum value)
+static const uint8_t lat_cmd_codes[] = {
+    NSP_HANDLER_LATENCY_ALL,
+    NSP_CMD_PING,
+    NSP_CMD_PEEK,
+    NSP_CMD_POKE,
+    NSP_CMD_APPLICATION_TELEMETRY,
+    NSP_CMD_APPLICATION_COMMAND,
+    NSP_CMD_CLEAR_FAULT,
+    NSP_CMD_CONFIGURE_PROTECTION,
+    NSP_CMD_TRIP_LCL,
+    NSP_CMD_SIM_STEP,
+    NSP_CMD_MULTI_TELEMETRY,
+};
+
+#define LAT_CMD_CHOICES (sizeof(lat_cmd_codes) / sizeof(lat_cmd_codes[0]))
+
+static const char* lat_cmd_strings[] = {
+    "ALL",
+    "PING",
+    "PEEK",
+    "POKE",
+    "APP_TELEM",
+    "APP_CMD",
+    "CLEAR_FAULT",
+    "CONFIG_PROT",
+    "TRIP_LCL",
+    "SIM_STEP",
+    "MULTI_TELEM",
+};
+
 // Last RX command (formatted as hex string)
 static char last_rx_cmd_str[64] = "-";  // Format: "01,00,82,..." or "-" if none
 
@@ -53,7 +120,6 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&nsp_rx_bytes,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -65,7 +131,6 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&nsp_rx_packets,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -77,7 +142,6 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&nsp_tx_packets,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -89,7 +153,6 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&nsp_slip_errors,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -101,7 +164,6 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&nsp_parse_errors,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -113,7 +175,6 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&nsp_wrong_addr,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -125,7 +186,6 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&nsp_cmd_errors,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -137,7 +197,6 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&nsp_total_errors,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -149,7 +208,6 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&nsp_last_parse_error,
-        .dirty = false,
         .enum_values = parse_error_strings,
         .enum_count = sizeof(parse_error_strings) / sizeof(parse_error_strings[0]),
     },
@@ -161,7 +219,6 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&nsp_last_cmd_error,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -173,7 +230,6 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&nsp_last_frame_len,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -185,7 +241,314 @@ static const field_meta_t nsp_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)last_rx_cmd_str,
-        .dirty = false,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 313,
+        .name = "turnaround_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_turnaround_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 314,
+        .name = "max_turnaround_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_max_turnaround_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 315,
+        .name = "telem_cache_hits",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_telem_cache_hits,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 316,
+        .name = "telem_cache_miss",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_telem_cache_misses,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 317,
+        .name = "frame_cache_hits",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_frame_cache_hits,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 318,
+        .name = "lat_cmd",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_cmd,
+        .enum_values = lat_cmd_strings,
+        .enum_count = LAT_CMD_CHOICES,
+    },
+    {
+        .id = 319,
+        .name = "lat_count",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_start.count,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 320,
+        .name = "lat_start_p50",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_start.p50_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 321,
+        .name = "lat_start_p90",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_start.p90_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 322,
+        .name = "lat_start_p99",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_start.p99_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 323,
+        .name = "lat_start_p999",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_start.p999_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 324,
+        .name = "lat_start_max",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_start.max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 325,
+        .name = "lat_end_p50",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_end.p50_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 326,
+        .name = "lat_end_p90",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_end.p90_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 327,
+        .name = "lat_end_p99",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_end.p99_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 328,
+        .name = "lat_end_p999",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_end.p999_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 329,
+        .name = "lat_end_max",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_end.max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 330,
+        .name = "lat_reset",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_lat_reset,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 331,
+        .name = "trace_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_trace_total,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 332,
+        .name = "trace_dump",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_trace_dump,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 333,
+        .name = "online_ms",
+        .type = FIELD_TYPE_U32,
+        .units = "ms",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_online_ms,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 334,
+        .name = "rx_frame_rate",
+        .type = FIELD_TYPE_U32,
+        .units = "frames/s",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_rx_frame_rate,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 335,
+        .name = "tx_frame_rate",
+        .type = FIELD_TYPE_U32,
+        .units = "frames/s",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_tx_frame_rate,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 336,
+        .name = "peak_frame_rate",
+        .type = FIELD_TYPE_U32,
+        .units = "frames/s",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_peak_frame_rate,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 337,
+        .name = "gap_min_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_gap_min_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 338,
+        .name = "gap_mean_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_gap_mean_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 339,
+        .name = "gap_max_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_gap_max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 340,
+        .name = "multi_telem",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&nsp_multi_telem,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -195,28 +558,27 @@ static const field_meta_t nsp_fields[] = {
 // Table Definition
 // ============================================================================
 
-static const table_meta_t nsp_table = {
+const table_meta_t table_nsp_meta = {
     .id = 3,
     .name = "NSP Stats",
-    .description = "RX/TX packets, errors breakdown",
+    .description = "RX/TX packets, errors, reply latency",
     .fields = nsp_fields,
     .field_count = sizeof(nsp_fields) / sizeof(nsp_fields[0]),
 };
 
-// ============================================================================
-// Initialization
-// ============================================================================
-
-void table_nsp_init(void) {
-    // Register table with catalog
-    catalog_register_table(&nsp_table);
-}
-
 // ============================================================================
 // Update Function
 // ============================================================================
 
 void table_nsp_update(void) {
+    // Counters move with the bus; rates and uptime also move when it is quiet
+    static core_sync_doorbell_t bell;
+    if (!core_sync_doorbell_take(&bell, CORE_SYNC_BELL(CORE_SYNC_BELL_BUS) |
+                                        CORE_SYNC_BELL(CORE_SYNC_BELL_CONFIG),
+                                 CORE_SYNC_DOORBELL_AGE_US)) {
+        return;
+    }
+
     // Fetch latest stats from NSP handler
     uint32_t rx_b, rx_p, tx_p, slip_e, nsp_e, wrong_a, cmd_e, total_e;
 
@@ -242,6 +604,52 @@ void table_nsp_update(void) {
     nsp_last_cmd_error = last_cmd;
     nsp_last_frame_len = frame_len;
 
+    // Fetch reply timing
+    uint32_t turnaround, max_turnaround;
+    nsp_handler_get_turnaround(&turnaround, &max_turnaround);
+    nsp_turnaround_us = turnaround;
+    nsp_max_turnaround_us = max_turnaround;
+
+    // Fetch reply cache counters
+    uint32_t telem_hits, telem_misses, frame_hits;
+    commands_get_telem_cache_stats(&telem_hits, &telem_misses);
+    nsp_handler_get_reply_cache_stats(&frame_hits);
+    nsp_telem_cache_hits = telem_hits;
+    nsp_telem_cache_misses = telem_misses;
+    nsp_frame_cache_hits = frame_hits;
+
+    // Reply latency for the selected command (reset request first)
+    if (nsp_lat_reset) {
+        nsp_lat_reset = 0;
+        nsp_handler_reset_latency();
+    }
+    if (nsp_lat_cmd >= LAT_CMD_CHOICES) {
+        nsp_lat_cmd = 0;
+    }
+    nsp_handler_get_latency(lat_cmd_codes[nsp_lat_cmd], false, &nsp_lat_start);
+    nsp_handler_get_latency(lat_cmd_codes[nsp_lat_cmd], true, &nsp_lat_end);
+
+    // Transaction trace (dump goes out on the telemetry port once it is open)
+    if (nsp_trace_dump) {
+        nsp_trace_dump = 0;
+        nsp_trace_request_dump(NSP_TRACE_DUMP_MANUAL);
+    }
+    nsp_trace_total = nsp_trace_count();
+    nsp_online_ms = nsp_handler_get_online_us() / 1000u;
+
+    // Frame rates and inter-frame idle gaps
+    bus_meter_rates_t rates;
+    nsp_handler_get_bus_rates(&rates);
+    nsp_rx_frame_rate = rates.rx_frames_per_s;
+    nsp_tx_frame_rate = rates.tx_frames_per_s;
+    nsp_peak_frame_rate = rates.peak_frames_per_s;
+    nsp_gap_min_us = rates.gap_min_us;
+    nsp_gap_mean_us = rates.gap_mean_us;
+    nsp_gap_max_us = rates.gap_max_us;
+
+    // Vendor extension opt-in
+    commands_set_multi_telem_enabled(nsp_multi_telem != 0);
+
     // Fetch and format last RX command
     uint8_t cmd_bytes[16];
     uint32_t cmd_len;
@@ -10,11 +10,6 @@
 
 #include <stdint.h>
 
-/**
- * @brief Initialize NSP Layer table and register with catalog
- */
-void table_nsp_init(void);
-
 /**
  * @brief Update NSP stats from handler
  *
@@ -0,0 +1,558 @@
+/**
+ * @file table_profiler.c
+ * @brief Profiler Table Implementation
+ *
+ * Table 13: Profiler (per-probe count and min/mean/max cycles)
+ *
+ * Histograms are printed with the P key (profiler_dump()).
+ */
+
+#include "table_profiler.h"
+#include "tables.h"
+#include "../util/profiler.h"
+#include <stdio.h>
+
+// ============================================================================
+// Live Data (Connected to Profiler)
+// ============================================================================
+
+static volatile uint32_t prof_enabled = 0;                    // Probes compiled in (bool)
+static volatile uint32_t prof_count[PROF_PROBE_COUNT];        // Samples
+static volatile uint32_t prof_min_cycles[PROF_PROBE_COUNT];   // Fastest sample
+static volatile uint32_t prof_mean_cycles[PROF_PROBE_COUNT];  // Mean over all samples
+static volatile uint32_t prof_max_cycles[PROF_PROBE_COUNT];   // Slowest sample
+
+// ============================================================================
+// Field Definitions
+// ============================================================================
+
+static const field_meta_t profiler_fields[] = {
+    {
+        .id = 1301,
+        .name = "enabled",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_enabled,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1302,
+        .name = "c1_cmd_drain_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_count[PROF_CORE1_CMD_DRAIN],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1303,
+        .name = "c1_cmd_drain_min",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_min_cycles[PROF_CORE1_CMD_DRAIN],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1304,
+        .name = "c1_cmd_drain_mean",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_mean_cycles[PROF_CORE1_CMD_DRAIN],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1305,
+        .name = "c1_cmd_drain_max",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_max_cycles[PROF_CORE1_CMD_DRAIN],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1306,
+        .name = "c1_control_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_count[PROF_CORE1_CONTROL],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1307,
+        .name = "c1_control_min",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_min_cycles[PROF_CORE1_CONTROL],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1308,
+        .name = "c1_control_mean",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_mean_cycles[PROF_CORE1_CONTROL],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1309,
+        .name = "c1_control_max",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_max_cycles[PROF_CORE1_CONTROL],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1310,
+        .name = "c1_limits_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_count[PROF_CORE1_LIMITS],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1311,
+        .name = "c1_limits_min",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_min_cycles[PROF_CORE1_LIMITS],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1312,
+        .name = "c1_limits_mean",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_mean_cycles[PROF_CORE1_LIMITS],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1313,
+        .name = "c1_limits_max",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_max_cycles[PROF_CORE1_LIMITS],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1314,
+        .name = "c1_dynamics_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_count[PROF_CORE1_DYNAMICS],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1315,
+        .name = "c1_dynamics_min",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_min_cycles[PROF_CORE1_DYNAMICS],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1316,
+        .name = "c1_dynamics_mean",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_mean_cycles[PROF_CORE1_DYNAMICS],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1317,
+        .name = "c1_dynamics_max",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_max_cycles[PROF_CORE1_DYNAMICS],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1318,
+        .name = "c1_protection_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_count[PROF_CORE1_PROTECTION],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1319,
+        .name = "c1_protection_min",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_min_cycles[PROF_CORE1_PROTECTION],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1320,
+        .name = "c1_protection_mean",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_mean_cycles[PROF_CORE1_PROTECTION],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1321,
+        .name = "c1_protection_max",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_max_cycles[PROF_CORE1_PROTECTION],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1322,
+        .name = "c1_publish_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_count[PROF_CORE1_PUBLISH],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1323,
+        .name = "c1_publish_min",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_min_cycles[PROF_CORE1_PUBLISH],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1324,
+        .name = "c1_publish_mean",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_mean_cycles[PROF_CORE1_PUBLISH],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1325,
+        .name = "c1_publish_max",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_max_cycles[PROF_CORE1_PUBLISH],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1326,
+        .name = "nsp_slip_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_count[PROF_NSP_SLIP],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1327,
+        .name = "nsp_slip_min",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_min_cycles[PROF_NSP_SLIP],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1328,
+        .name = "nsp_slip_mean",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_mean_cycles[PROF_NSP_SLIP],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1329,
+        .name = "nsp_slip_max",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_max_cycles[PROF_NSP_SLIP],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1330,
+        .name = "nsp_parse_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_count[PROF_NSP_PARSE],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1331,
+        .name = "nsp_parse_min",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_min_cycles[PROF_NSP_PARSE],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1332,
+        .name = "nsp_parse_mean",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_mean_cycles[PROF_NSP_PARSE],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1333,
+        .name = "nsp_parse_max",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_max_cycles[PROF_NSP_PARSE],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1334,
+        .name = "nsp_dispatch_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_count[PROF_NSP_DISPATCH],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1335,
+        .name = "nsp_dispatch_min",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_min_cycles[PROF_NSP_DISPATCH],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1336,
+        .name = "nsp_dispatch_mean",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_mean_cycles[PROF_NSP_DISPATCH],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1337,
+        .name = "nsp_dispatch_max",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_max_cycles[PROF_NSP_DISPATCH],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1338,
+        .name = "nsp_reply_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_count[PROF_NSP_REPLY],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1339,
+        .name = "nsp_reply_min",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_min_cycles[PROF_NSP_REPLY],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1340,
+        .name = "nsp_reply_mean",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_mean_cycles[PROF_NSP_REPLY],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1341,
+        .name = "nsp_reply_max",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_max_cycles[PROF_NSP_REPLY],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1342,
+        .name = "nsp_tx_count",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_count[PROF_NSP_TX],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1343,
+        .name = "nsp_tx_min",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_min_cycles[PROF_NSP_TX],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1344,
+        .name = "nsp_tx_mean",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_mean_cycles[PROF_NSP_TX],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1345,
+        .name = "nsp_tx_max",
+        .type = FIELD_TYPE_U32,
+        .units = "cycles",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prof_max_cycles[PROF_NSP_TX],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+};
+
+const table_meta_t table_profiler_meta = {
+    .id = 13,
+    .name = "Profiler",
+    .description = "Hot-path stage cycles (P dumps histograms)",
+    .fields = profiler_fields,
+    .field_count = sizeof(profiler_fields) / sizeof(profiler_fields[0]),
+};
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+void table_profiler_init(void) {
+    prof_enabled = profiler_is_enabled() ? 1 : 0;
+
+}
+
+// ============================================================================
+// Update Function
+// ============================================================================
+
+void table_profiler_update(void) {
+    for (uint32_t p = 0; p < PROF_PROBE_COUNT; p++) {
+        profiler_stats_t stats;
+        profiler_get_stats((profiler_probe_t)p, &stats);
+
+        prof_count[p] = stats.count;
+        prof_min_cycles[p] = stats.min_cycles;
+        prof_mean_cycles[p] = (stats.count > 0) ? (uint32_t)(stats.total_cycles / stats.count) : 0;
+        prof_max_cycles[p] = stats.max_cycles;
+    }
+}
@@ -0,0 +1,25 @@
+/**
+ * @file table_profiler.h
+ * @brief Profiler Table for Console TUI
+ *
+ * Table 13: Profiler (per-probe count and min/mean/max cycles)
+ */
+
+#ifndef TABLE_PROFILER_H
+#define TABLE_PROFILER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Initialize Profiler table state
+ */
+void table_profiler_init(void);
+
+/**
+ * @brief Update probe statistics from the profiler
+ *
+ * Call this periodically to fetch the latest probe statistics
+ */
+void table_profiler_update(void);
+
+#endif // TABLE_PROFILER_H
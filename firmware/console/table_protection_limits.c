@@ -2,25 +2,77 @@
  * @file table_protection_limits.c
  * @brief Protection Limits Table Implementation
  *
- * Table 6: Protection Limits (configurable thresholds - all RW)
+ * Table 6: Protection Limits (configurable thresholds and speed-loop gains)
+ *
+ * The edits found on one update go to every wheel as one parameter
+ * transaction, so Core1 applies coupled changes (a limit and its enable
+ * bit, Kp with Ki) in the same tick. The protection enable mask also
+ * follows NSP writes (POKE, CONFIGURE-PROTECTION). Fields 601-611
+ * are persistent: they are restored from the flash config store at boot
+ * and re-applied after a wheel RESET. restore_defaults erases the store
+ * and returns them to their defaults.
  */
 
 #include "table_protection_limits.h"
 #include "tables.h"
 #include "../device/nss_nrwa_t6_regs.h"
+#include "../device/nss_nrwa_t6_model.h"
+#include "../device/nss_nrwa_t6_protection.h"
+#include "../config/config_store.h"
+#include "../util/core_sync.h"
 #include <stdio.h>
+#include <string.h>
+
+// Wheel states (protection_enable also changes with NSP POKE/CONFIGURE-PROTECTION)
+extern wheel_state_t g_wheel_states[EMULATED_WHEEL_COUNT];
+
+// Wheel profile defaults in field units (rounded)
+#define LIMIT_OVERVOLT_MV       ((uint32_t)(DEFAULT_OVERVOLTAGE_THRESHOLD_V * 1000.0f + 0.5f))
+#define LIMIT_OVERSPEED_RPM     ((uint32_t)(DEFAULT_OVERSPEED_FAULT_RPM + 0.5f))
+#define LIMIT_SOFT_OVERSPEED_RPM ((uint32_t)(DEFAULT_OVERSPEED_SOFT_RPM + 0.5f))
+#define LIMIT_OVERCURR_MA       ((uint32_t)(DEFAULT_HARD_OVERCURRENT_A * 1000.0f + 0.5f))
+#define LIMIT_SOFT_OVERCURR_MA  ((uint32_t)(DEFAULT_SOFT_OVERCURRENT_A * 1000.0f + 0.5f))
+#define LIMIT_OVERPOWER_MW      ((uint32_t)(DEFAULT_OVERPOWER_LIMIT_W * 1000.0f + 0.5f))
+#define LIMIT_MAX_DUTY_X100     ((uint32_t)(DEFAULT_MAX_DUTY_CYCLE_PCT * 100.0f + 0.5f))
 
 // ============================================================================
-// Live Data (Stubs - will be connected to wheel_state in future)
+// Live Data (applied to every wheel through a Core1 parameter transaction)
 // ============================================================================
 
-static volatile uint32_t prot_overvolt_v = 36000;         // 36V (mV)
-static volatile uint32_t prot_overspeed_rpm = 6000;       // 6000 RPM (latched)
-static volatile uint32_t prot_soft_overspeed_rpm = 5000;  // 5000 RPM (soft)
-static volatile uint32_t prot_overcurr_a = 6000;          // 6A (mA)
-static volatile uint32_t prot_soft_overcurr_a = 5000;     // 5A (mA, soft)
-static volatile uint32_t prot_overpower_w = 100000;       // 100W (mW)
-static volatile uint32_t prot_max_duty_pct = 9785;        // 97.85% (× 100)
+static volatile uint32_t prot_overvolt_v = LIMIT_OVERVOLT_MV;                  // mV
+static volatile uint32_t prot_overspeed_rpm = LIMIT_OVERSPEED_RPM;             // RPM (latched)
+static volatile uint32_t prot_soft_overspeed_rpm = LIMIT_SOFT_OVERSPEED_RPM;   // RPM (soft)
+static volatile uint32_t prot_overcurr_a = LIMIT_OVERCURR_MA;                  // mA
+static volatile uint32_t prot_soft_overcurr_a = LIMIT_SOFT_OVERCURR_MA;        // mA (soft)
+static volatile uint32_t prot_overpower_w = LIMIT_OVERPOWER_MW;                // mW
+static volatile uint32_t prot_max_duty_pct = LIMIT_MAX_DUTY_X100;              // % × 100
+static volatile uint32_t prot_enable = PROT_ENABLE_ALL;   // Protection enable mask
+static volatile float prot_pi_kp = DEFAULT_PI_KP;         // Speed loop proportional gain
+static volatile float prot_pi_ki = DEFAULT_PI_KI;         // Speed loop integral gain
+static volatile float prot_pi_i_max_a = DEFAULT_PI_I_MAX_A;
+static volatile uint32_t store_keys = 0;                  // Keys in the config store
+static volatile uint32_t store_commits = 0;               // Flash commits since boot
+static volatile uint32_t store_compactions = 0;           // Sector erases since boot
+static volatile uint32_t store_used_bytes = 0;            // Active log sector fill
+static volatile uint32_t store_restore_defaults = 0;      // Write 1 to erase the store
+
+// Values last sent to the wheels
+typedef struct {
+    uint32_t overvolt_v;
+    uint32_t overspeed_rpm;
+    uint32_t soft_overspeed_rpm;
+    uint32_t overcurr_a;
+    uint32_t soft_overcurr_a;
+    uint32_t overpower_w;
+    uint32_t max_duty_pct;
+    uint32_t enable;
+    float pi_kp;
+    float pi_ki;
+    float pi_i_max_a;
+} applied_limits_t;
+
+static applied_limits_t applied;
+static uint32_t last_tick[EMULATED_WHEEL_COUNT];
 
 // ============================================================================
 // Field Definitions
@@ -33,11 +85,11 @@ static const field_meta_t protection_limits_fields[] = {
         .type = FIELD_TYPE_U32,
         .units = "mV",
         .access = FIELD_ACCESS_RW,
-        .default_val = 36000,
+        .default_val = LIMIT_OVERVOLT_MV,
         .ptr = (volatile uint32_t*)&prot_overvolt_v,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
+        .persistent = true,
     },
     {
         .id = 602,
@@ -45,11 +97,11 @@ static const field_meta_t protection_limits_fields[] = {
         .type = FIELD_TYPE_U32,
         .units = "RPM",
         .access = FIELD_ACCESS_RW,
-        .default_val = 6000,
+        .default_val = LIMIT_OVERSPEED_RPM,
         .ptr = (volatile uint32_t*)&prot_overspeed_rpm,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
+        .persistent = true,
     },
     {
         .id = 603,
@@ -57,11 +109,11 @@ static const field_meta_t protection_limits_fields[] = {
         .type = FIELD_TYPE_U32,
         .units = "RPM",
         .access = FIELD_ACCESS_RW,
-        .default_val = 5000,
+        .default_val = LIMIT_SOFT_OVERSPEED_RPM,
         .ptr = (volatile uint32_t*)&prot_soft_overspeed_rpm,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
+        .persistent = true,
     },
     {
         .id = 604,
@@ -69,11 +121,11 @@ static const field_meta_t protection_limits_fields[] = {
         .type = FIELD_TYPE_U32,
         .units = "mA",
         .access = FIELD_ACCESS_RW,
-        .default_val = 6000,
+        .default_val = LIMIT_OVERCURR_MA,
         .ptr = (volatile uint32_t*)&prot_overcurr_a,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
+        .persistent = true,
     },
     {
         .id = 605,
@@ -81,11 +133,11 @@ static const field_meta_t protection_limits_fields[] = {
         .type = FIELD_TYPE_U32,
         .units = "mA",
         .access = FIELD_ACCESS_RW,
-        .default_val = 5000,
+        .default_val = LIMIT_SOFT_OVERCURR_MA,
         .ptr = (volatile uint32_t*)&prot_soft_overcurr_a,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
+        .persistent = true,
     },
     {
         .id = 606,
@@ -93,11 +145,11 @@ static const field_meta_t protection_limits_fields[] = {
         .type = FIELD_TYPE_U32,
         .units = "mW",
         .access = FIELD_ACCESS_RW,
-        .default_val = 100000,
+        .default_val = LIMIT_OVERPOWER_MW,
         .ptr = (volatile uint32_t*)&prot_overpower_w,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
+        .persistent = true,
     },
     {
         .id = 607,
@@ -105,11 +157,119 @@ static const field_meta_t protection_limits_fields[] = {
         .type = FIELD_TYPE_U32,
         .units = "%×100",
         .access = FIELD_ACCESS_RW,
-        .default_val = 9785,
+        .default_val = LIMIT_MAX_DUTY_X100,
         .ptr = (volatile uint32_t*)&prot_max_duty_pct,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
+        .persistent = true,
+    },
+    {
+        .id = 608,
+        .name = "prot_enable",
+        .type = FIELD_TYPE_HEX,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = PROT_ENABLE_ALL,
+        .ptr = (volatile uint32_t*)&prot_enable,
+        .enum_values = NULL,
+        .enum_count = 0,
+        .persistent = true,
+    },
+    {
+        .id = 609,
+        .name = "pi_kp",
+        .type = FIELD_TYPE_FLOAT,
+        .units = "A/(rad/s)",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prot_pi_kp,
+        .enum_values = NULL,
+        .enum_count = 0,
+        .persistent = true,
+    },
+    {
+        .id = 610,
+        .name = "pi_ki",
+        .type = FIELD_TYPE_FLOAT,
+        .units = "A/rad",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prot_pi_ki,
+        .enum_values = NULL,
+        .enum_count = 0,
+        .persistent = true,
+    },
+    {
+        .id = 611,
+        .name = "pi_i_max_a",
+        .type = FIELD_TYPE_FLOAT,
+        .units = "A",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&prot_pi_i_max_a,
+        .enum_values = NULL,
+        .enum_count = 0,
+        .persistent = true,
+    },
+    {
+        .id = 612,
+        .name = "store_keys",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&store_keys,
+        .enum_values = NULL,
+        .enum_count = 0,
+        .persistent = false,
+    },
+    {
+        .id = 613,
+        .name = "store_commits",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&store_commits,
+        .enum_values = NULL,
+        .enum_count = 0,
+        .persistent = false,
+    },
+    {
+        .id = 614,
+        .name = "store_compactions",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&store_compactions,
+        .enum_values = NULL,
+        .enum_count = 0,
+        .persistent = false,
+    },
+    {
+        .id = 615,
+        .name = "store_used",
+        .type = FIELD_TYPE_U32,
+        .units = "B",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&store_used_bytes,
+        .enum_values = NULL,
+        .enum_count = 0,
+        .persistent = false,
+    },
+    {
+        .id = 616,
+        .name = "restore_defaults",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&store_restore_defaults,
+        .enum_values = NULL,
+        .enum_count = 0,
+        .persistent = false,
     },
 };
 
@@ -117,10 +277,10 @@ static const field_meta_t protection_limits_fields[] = {
 // Table Definition
 // ============================================================================
 
-static const table_meta_t protection_limits_table = {
+const table_meta_t table_protection_limits_meta = {
     .id = 6,
     .name = "Protection Limits",
-    .description = "Configurable thresholds",
+    .description = "Configurable thresholds and speed-loop gains",
     .fields = protection_limits_fields,
     .field_count = sizeof(protection_limits_fields) / sizeof(protection_limits_fields[0]),
 };
@@ -129,7 +289,133 @@ static const table_meta_t protection_limits_table = {
 // Initialization
 // ============================================================================
 
+/**
+ * @brief Shadow of the model defaults (what every wheel starts with)
+ */
+static void applied_defaults(applied_limits_t* a) {
+    a->overvolt_v = LIMIT_OVERVOLT_MV;
+    a->overspeed_rpm = LIMIT_OVERSPEED_RPM;
+    a->soft_overspeed_rpm = LIMIT_SOFT_OVERSPEED_RPM;
+    a->overcurr_a = LIMIT_OVERCURR_MA;
+    a->soft_overcurr_a = LIMIT_SOFT_OVERCURR_MA;
+    a->overpower_w = LIMIT_OVERPOWER_MW;
+    a->max_duty_pct = LIMIT_MAX_DUTY_X100;
+    a->enable = PROT_ENABLE_ALL;
+    a->pi_kp = DEFAULT_PI_KP;
+    a->pi_ki = DEFAULT_PI_KI;
+    a->pi_i_max_a = DEFAULT_PI_I_MAX_A;
+}
+
 void table_protection_limits_init(void) {
-    // Register table with catalog
-    catalog_register_table(&protection_limits_table);
+    applied_defaults(&applied);
+
+}
+
+// ============================================================================
+// Update Function
+// ============================================================================
+
+/**
+ * @brief Stage one threshold in the transaction if it changed
+ */
+static void apply_threshold(wheel_params_t* txn, uint32_t value, uint32_t* applied_value,
+                            uint8_t param_id, float scale) {
+    if (value != *applied_value) {
+        txn->threshold[param_id] = (float)value * scale;
+        txn->set |= PARAM_SET_THRESHOLD(param_id);
+        *applied_value = value;
+    }
+}
+
+/**
+ * @brief Stage one speed-loop gain in the transaction if it changed (and is valid)
+ */
+static void apply_gain(wheel_params_t* txn, volatile float* field, float* applied_value,
+                       float* txn_value, uint32_t set_bit, float min) {
+    float value = *field;
+    if (value == *applied_value) {
+        return;
+    }
+    if (!(value >= min)) {
+        printf("[PROTECTION] Gain %g rejected, keeping %g\n", (double)value, (double)*applied_value);
+        *field = *applied_value;
+        return;
+    }
+    *txn_value = value;
+    txn->set |= set_bit;
+    *applied_value = value;
+}
+
+static void restore_defaults(void) {
+    config_store_erase();
+    prot_overvolt_v = LIMIT_OVERVOLT_MV;
+    prot_overspeed_rpm = LIMIT_OVERSPEED_RPM;
+    prot_soft_overspeed_rpm = LIMIT_SOFT_OVERSPEED_RPM;
+    prot_overcurr_a = LIMIT_OVERCURR_MA;
+    prot_soft_overcurr_a = LIMIT_SOFT_OVERCURR_MA;
+    prot_overpower_w = LIMIT_OVERPOWER_MW;
+    prot_max_duty_pct = LIMIT_MAX_DUTY_X100;
+    prot_enable = PROT_ENABLE_ALL;
+    prot_pi_kp = DEFAULT_PI_KP;
+    prot_pi_ki = DEFAULT_PI_KI;
+    prot_pi_i_max_a = DEFAULT_PI_I_MAX_A;
+}
+
+void table_protection_limits_update(void) {
+    if (store_restore_defaults) {
+        store_restore_defaults = 0;
+        restore_defaults();
+    }
+
+    // A wheel RESET (tick count restarts) brings back the model defaults:
+    // send everything that differs from them again
+    for (uint8_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        uint32_t tick = g_wheel_states[w].tick_count;
+        if (tick < last_tick[w]) {
+            applied_defaults(&applied);
+        }
+        last_tick[w] = tick;
+    }
+
+    // Every change found on this pass goes out as one transaction
+    wheel_params_t txn;
+    memset(&txn, 0, sizeof(txn));
+
+    // Enable mask: an NSP write changes the wheels directly, an edit here
+    // goes out to them
+    uint32_t wheel_enable = g_wheel_states[0].protection_enable;
+    if (prot_enable != applied.enable) {
+        uint32_t mask = prot_enable & PROT_ENABLE_ALL;
+        txn.protection_enable = mask;
+        txn.set |= PARAM_SET_ENABLE;
+        prot_enable = mask;
+        applied.enable = mask;
+    } else if (wheel_enable != applied.enable && !core_sync_params_pending()) {
+        prot_enable = wheel_enable;
+        applied.enable = wheel_enable;
+    }
+
+    apply_threshold(&txn, prot_overvolt_v, &applied.overvolt_v, PROT_PARAM_OVERVOLTAGE_THRESHOLD, 0.001f);
+    apply_threshold(&txn, prot_overspeed_rpm, &applied.overspeed_rpm, PROT_PARAM_OVERSPEED_FAULT_RPM, 1.0f);
+    apply_threshold(&txn, prot_soft_overspeed_rpm, &applied.soft_overspeed_rpm,
+                    PROT_PARAM_OVERSPEED_SOFT_RPM, 1.0f);
+    apply_threshold(&txn, prot_overcurr_a, &applied.overcurr_a, PROT_PARAM_HARD_OVERCURRENT_A, 0.001f);
+    apply_threshold(&txn, prot_soft_overcurr_a, &applied.soft_overcurr_a,
+                    PROT_PARAM_SOFT_OVERCURRENT_A, 0.001f);
+    apply_threshold(&txn, prot_overpower_w, &applied.overpower_w, PROT_PARAM_OVERPOWER_LIMIT_W, 0.001f);
+    apply_threshold(&txn, prot_max_duty_pct, &applied.max_duty_pct, PROT_PARAM_MAX_DUTY_CYCLE_PCT, 0.01f);
+
+    // Ki divides the integral limit: must stay positive
+    apply_gain(&txn, &prot_pi_kp, &applied.pi_kp, &txn.pi_kp, PARAM_SET_PI_KP, 0.0f);
+    apply_gain(&txn, &prot_pi_ki, &applied.pi_ki, &txn.pi_ki, PARAM_SET_PI_KI, 1.0e-6f);
+    apply_gain(&txn, &prot_pi_i_max_a, &applied.pi_i_max_a, &txn.pi_i_max_a, PARAM_SET_PI_I_MAX, 0.0f);
+
+    core_sync_params_commit(CORE_SYNC_WHEEL_ALL, &txn);
+
+    config_store_stats_t stats;
+    config_store_get_stats(&stats);
+    store_keys = stats.keys;
+    store_commits = stats.commits;
+    store_compactions = stats.compactions;
+    store_used_bytes = stats.used_bytes;
 }
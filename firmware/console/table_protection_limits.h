@@ -13,4 +13,11 @@
  */
 void table_protection_limits_init(void);
 
+/**
+ * @brief Send edited limits and gains to the wheels, refresh store status
+ *
+ * Call from the Core0 main loop.
+ */
+void table_protection_limits_update(void);
+
 #endif // TABLE_PROTECTION_LIMITS_H
@@ -3,11 +3,20 @@
  * @brief Protection Status Table Implementation
  *
  * Table 7: Protection Status (fault/warning flags - all RO)
+ *
+ * Also the hardware FAULT line (drivers/fault_line.h): its state and
+ * detection-to-pin latency, and the persistent assertion delay; and the
+ * RESET line (drivers/reset_line.h): resets, their latency and the
+ * persistent emulated boot time.
  */
 
 #include "table_protection_status.h"
 #include "tables.h"
 #include "../device/nss_nrwa_t6_regs.h"
+#include "../drivers/fault_line.h"
+#include "../drivers/reset_line.h"
+#include "../nsp_handler.h"
+#include "board_pico.h"
 #include <stdio.h>
 
 // ============================================================================
@@ -16,6 +25,22 @@
 
 static volatile uint32_t prot_flags = 0;                  // Fault flags
 static volatile uint32_t prot_warnings = 0;               // Warning flags
+static volatile uint32_t fault_pin = 0;                   // FAULT line asserted (low)
+static volatile uint32_t fault_pin_delay_us = FAULT_ASSERT_DELAY_US;
+static volatile uint32_t fault_pin_asserts = 0;           // Assertions since boot
+static volatile uint32_t fault_pin_latency_us = 0;        // Last detection to pin
+static volatile uint32_t fault_pin_latency_max_us = 0;    // Worst detection to pin
+static volatile uint32_t reset_held = 0;                  // RESET_PIN low
+static volatile uint32_t reset_count = 0;                 // Resets since boot
+static volatile uint32_t reset_apply_us = 0;              // Edge to wheels reset, last
+static volatile uint32_t reset_apply_max_us = 0;          // Edge to wheels reset, worst
+static volatile uint32_t reset_ready_us = 0;              // Release to ready, last
+static volatile uint32_t reset_boot_us = RESET_BOOT_US;   // Emulated boot time
+static volatile uint32_t reset_dropped_bytes = 0;         // Bus bytes ignored in reset
+
+// Values last given to the FAULT/RESET lines (UINT32_MAX: not yet, e.g. restored)
+static uint32_t applied_delay_us = UINT32_MAX;
+static uint32_t applied_boot_us = UINT32_MAX;
 
 // ============================================================================
 // Field Definitions
@@ -23,26 +48,158 @@ static volatile uint32_t prot_warnings = 0;               // Warning flags
 
 static const field_meta_t protection_status_fields[] = {
     {
-        .id = 608,
+        .id = 801,
         .name = "fault_flags",
         .type = FIELD_TYPE_HEX,
         .units = "",
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&prot_flags,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
     {
-        .id = 609,
+        .id = 802,
         .name = "warning_flags",
         .type = FIELD_TYPE_HEX,
         .units = "",
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&prot_warnings,
-        .dirty = false,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 803,
+        .name = "fault_pin",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fault_pin,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 804,
+        .name = "fault_pin_delay_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RW,
+        .default_val = FAULT_ASSERT_DELAY_US,
+        .ptr = (volatile uint32_t*)&fault_pin_delay_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+        .persistent = true,
+    },
+    {
+        .id = 805,
+        .name = "fault_pin_asserts",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fault_pin_asserts,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 806,
+        .name = "fault_pin_latency_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fault_pin_latency_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 807,
+        .name = "fault_pin_latency_max_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&fault_pin_latency_max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 808,
+        .name = "reset_held",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&reset_held,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 809,
+        .name = "reset_count",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&reset_count,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 810,
+        .name = "reset_apply_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&reset_apply_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 811,
+        .name = "reset_apply_max_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&reset_apply_max_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 812,
+        .name = "reset_ready_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&reset_ready_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 813,
+        .name = "reset_boot_us",
+        .type = FIELD_TYPE_U32,
+        .units = "us",
+        .access = FIELD_ACCESS_RW,
+        .default_val = RESET_BOOT_US,
+        .ptr = (volatile uint32_t*)&reset_boot_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+        .persistent = true,
+    },
+    {
+        .id = 814,
+        .name = "reset_dropped_bytes",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&reset_dropped_bytes,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -52,19 +209,50 @@ static const field_meta_t protection_status_fields[] = {
 // Table Definition
 // ============================================================================
 
-static const table_meta_t protection_status_table = {
-    .id = 7,
+const table_meta_t table_protection_status_meta = {
+    .id = 8,
     .name = "Protection Status",
-    .description = "Fault and warning flags",
+    .description = "Fault and warning flags, FAULT/RESET lines",
     .fields = protection_status_fields,
     .field_count = sizeof(protection_status_fields) / sizeof(protection_status_fields[0]),
 };
 
-// ============================================================================
-// Initialization
-// ============================================================================
+void table_protection_status_update(void) {
+    // Edits (and the values restored at boot) go to the FAULT/RESET lines
+    if (fault_pin_delay_us != applied_delay_us) {
+        if (!fault_line_set_delay_us(fault_pin_delay_us)) {
+            printf("[FAULT] Delay %lu us above %lu us, ignored\n",
+                   (unsigned long)fault_pin_delay_us, (unsigned long)FAULT_ASSERT_DELAY_MAX_US);
+            fault_pin_delay_us = (applied_delay_us == UINT32_MAX) ? FAULT_ASSERT_DELAY_US : applied_delay_us;
+            fault_line_set_delay_us(fault_pin_delay_us);
+        }
+        applied_delay_us = fault_pin_delay_us;
+    }
+
+    if (reset_boot_us != applied_boot_us) {
+        if (!reset_line_set_boot_us(reset_boot_us)) {
+            printf("[RESET] Boot time %lu us outside %lu-%lu us, ignored\n",
+                   (unsigned long)reset_boot_us, (unsigned long)PHYSICS_TICK_PERIOD_US,
+                   (unsigned long)RESET_BOOT_MAX_US);
+            reset_boot_us = (applied_boot_us == UINT32_MAX) ? RESET_BOOT_US : applied_boot_us;
+            reset_line_set_boot_us(reset_boot_us);
+        }
+        applied_boot_us = reset_boot_us;
+    }
+
+    fault_line_stats_t stats;
+    fault_line_get_stats(&stats);
+    fault_pin = stats.asserted ? 1 : 0;
+    fault_pin_asserts = stats.asserts;
+    fault_pin_latency_us = stats.last_latency_us;
+    fault_pin_latency_max_us = stats.max_latency_us;
 
-void table_protection_status_init(void) {
-    // Register table with catalog
-    catalog_register_table(&protection_status_table);
+    reset_line_stats_t reset;
+    reset_line_get_stats(&reset);
+    reset_held = reset.held ? 1 : 0;
+    reset_count = reset.resets;
+    reset_apply_us = reset.last_apply_us;
+    reset_apply_max_us = reset.max_apply_us;
+    reset_ready_us = reset.last_ready_us;
+    reset_dropped_bytes = nsp_handler_get_reset_dropped();
 }
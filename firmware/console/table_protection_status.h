@@ -7,10 +7,10 @@
 #define TABLE_PROTECTION_STATUS_H
 
 /**
- * @brief Initialize Protection Status table
+ * @brief Apply the FAULT/RESET line settings and refresh their statistics
  *
- * Registers table with catalog.
+ * Call periodically from the Core0 main loop.
  */
-void table_protection_status_init(void);
+void table_protection_status_update(void);
 
 #endif // TABLE_PROTECTION_STATUS_H
@@ -8,6 +8,8 @@
 #include "table_serial.h"
 #include "tables.h"
 #include "../nsp_handler.h"
+#include "../drivers/rs485_uart.h"
+#include "../util/core_sync.h"
 #include <stdio.h>
 
 // ============================================================================
@@ -17,9 +19,34 @@
 static volatile uint32_t serial_status = 1;           // 1 = active, 0 = inactive
 static volatile uint32_t serial_tx_count = 0;         // Total TX bytes
 static volatile uint32_t serial_rx_count = 0;         // Total RX bytes
-static volatile uint32_t serial_slip_frames_ok = 0;   // Valid SLIP frames decoded
+static volatile uint32_t serial_slip_frames_ok = 0;   // Valid SLIP frames for us
 static volatile uint32_t serial_slip_errors = 0;      // SLIP framing errors
 static volatile uint32_t serial_baud_kbps = 4608;     // 460.8 kbps (× 10)
+static volatile uint32_t serial_rx_overruns = 0;      // RX bytes lost (ring full + FIFO OE)
+static volatile uint32_t serial_rx_peak = 0;          // Peak RX ring occupancy
+static volatile int32_t serial_baud_error_ppm = 0;    // Programmed vs. nominal baud
+static uint32_t serial_backend = 0;                   // rs485_backend_t (RW)
+static uint32_t serial_backend_prev = 0;
+static uint32_t serial_baud_set = RS485_BAUD_RATE;    // Requested baud (RW)
+static uint32_t serial_baud_set_prev = RS485_BAUD_RATE;
+
+// Bus utilization over the last 1 s window (util/bus_meter.h)
+static volatile uint32_t serial_rx_rate = 0;          // Bytes/s received
+static volatile uint32_t serial_tx_rate = 0;          // Bytes/s sent
+static float serial_rx_busy_pct = 0.0f;               // Wire busy with received bytes
+static float serial_tx_busy_pct = 0.0f;               // Wire busy with our replies
+static float serial_idle_pct = 100.0f;                // Wire idle
+static volatile uint32_t serial_peak_rate = 0;        // Highest RX + TX bytes/s
+static float serial_peak_busy_pct = 0.0f;             // Highest busy share
+
+// ============================================================================
+// Enum Values
+// ============================================================================
+
+static const char* backend_enum_values[] = {
+    "UART",
+    "PIO"
+};
 
 // ============================================================================
 // Field Definitions
@@ -34,7 +61,6 @@ static const field_meta_t serial_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 1,
         .ptr = (volatile uint32_t*)&serial_status,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -46,7 +72,6 @@ static const field_meta_t serial_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&serial_tx_count,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -58,7 +83,6 @@ static const field_meta_t serial_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&serial_rx_count,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -70,7 +94,6 @@ static const field_meta_t serial_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&serial_slip_frames_ok,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -82,7 +105,6 @@ static const field_meta_t serial_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&serial_slip_errors,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -94,7 +116,138 @@ static const field_meta_t serial_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 4608,
         .ptr = (volatile uint32_t*)&serial_baud_kbps,
-        .dirty = false,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 207,
+        .name = "rx_overruns",
+        .type = FIELD_TYPE_U32,
+        .units = "bytes",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&serial_rx_overruns,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 208,
+        .name = "rx_peak",
+        .type = FIELD_TYPE_U32,
+        .units = "bytes",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&serial_rx_peak,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 209,
+        .name = "baud_error_ppm",
+        .type = FIELD_TYPE_I32,
+        .units = "ppm",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&serial_baud_error_ppm,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 210,
+        .name = "backend",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&serial_backend,
+        .enum_values = backend_enum_values,
+        .enum_count = 2,
+    },
+    {
+        .id = 211,
+        .name = "baud_set",
+        .type = FIELD_TYPE_U32,
+        .units = "baud",
+        .access = FIELD_ACCESS_RW,
+        .default_val = RS485_BAUD_RATE,
+        .ptr = (volatile uint32_t*)&serial_baud_set,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 212,
+        .name = "rx_rate",
+        .type = FIELD_TYPE_U32,
+        .units = "B/s",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&serial_rx_rate,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 213,
+        .name = "tx_rate",
+        .type = FIELD_TYPE_U32,
+        .units = "B/s",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&serial_tx_rate,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 214,
+        .name = "rx_busy_pct",
+        .type = FIELD_TYPE_FLOAT,
+        .units = "%",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&serial_rx_busy_pct,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 215,
+        .name = "tx_busy_pct",
+        .type = FIELD_TYPE_FLOAT,
+        .units = "%",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&serial_tx_busy_pct,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 216,
+        .name = "idle_pct",
+        .type = FIELD_TYPE_FLOAT,
+        .units = "%",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&serial_idle_pct,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 217,
+        .name = "peak_rate",
+        .type = FIELD_TYPE_U32,
+        .units = "B/s",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&serial_peak_rate,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 218,
+        .name = "peak_busy_pct",
+        .type = FIELD_TYPE_FLOAT,
+        .units = "%",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&serial_peak_busy_pct,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -104,7 +257,7 @@ static const field_meta_t serial_fields[] = {
 // Table Definition
 // ============================================================================
 
-static const table_meta_t serial_table = {
+const table_meta_t table_serial_meta = {
     .id = 2,
     .name = "Serial Status",
     .description = "RS-485, SLIP, CRC statistics",
@@ -117,8 +270,9 @@ static const table_meta_t serial_table = {
 // ============================================================================
 
 void table_serial_init(void) {
-    // Register table with catalog
-    catalog_register_table(&serial_table);
+    serial_backend = serial_backend_prev = (uint32_t)rs485_get_backend();
+    serial_baud_set = serial_baud_set_prev = rs485_get_requested_baud();
+
 }
 
 // ============================================================================
@@ -126,6 +280,29 @@ void table_serial_init(void) {
 // ============================================================================
 
 void table_serial_update(void) {
+    // Counters move with the bus; the windowed rates also decay when it is quiet
+    static core_sync_doorbell_t bell;
+    if (!core_sync_doorbell_take(&bell, CORE_SYNC_BELL(CORE_SYNC_BELL_BUS) |
+                                        CORE_SYNC_BELL(CORE_SYNC_BELL_CONFIG),
+                                 CORE_SYNC_DOORBELL_AGE_US)) {
+        return;
+    }
+
+    // Backend / baud edits re-initialize the bus (a rejected rate keeps the old one)
+    if (serial_backend != serial_backend_prev || serial_baud_set != serial_baud_set_prev) {
+        if (serial_backend < RS485_BACKEND_COUNT &&
+            rs485_configure((rs485_backend_t)serial_backend, serial_baud_set)) {
+            printf("[RS485] %s at %lu baud\n", backend_enum_values[serial_backend],
+                   (unsigned long)serial_baud_set);
+        } else {
+            printf("[RS485] %lu baud rejected on %s, keeping current settings\n",
+                   (unsigned long)serial_baud_set,
+                   serial_backend < RS485_BACKEND_COUNT ? backend_enum_values[serial_backend] : "?");
+        }
+    }
+    serial_backend = serial_backend_prev = (uint32_t)rs485_get_backend();
+    serial_baud_set = serial_baud_set_prev = rs485_get_requested_baud();
+
     // Fetch latest stats from NSP handler (serial layer)
     uint32_t rx_b, tx_b, slip_ok, slip_err;
 
@@ -137,6 +314,30 @@ void table_serial_update(void) {
     serial_slip_frames_ok = slip_ok;
     serial_slip_errors = slip_err;
 
+    // RX ring health (any non-zero overrun means bytes were lost)
+    uint32_t dropped, hw_overruns, peak;
+    rs485_get_rx_stats(&dropped, &hw_overruns, &peak);
+    serial_rx_overruns = dropped + hw_overruns;
+    serial_rx_peak = peak;
+
+    // Programmed baud rate (UART divisor from clk_peri, see clock profile)
+    uint32_t baud;
+    int32_t baud_error;
+    rs485_get_baud(&baud, &baud_error);
+    serial_baud_kbps = baud / 100u;
+    serial_baud_error_ppm = baud_error;
+
+    // Windowed throughput and wire utilization
+    bus_meter_rates_t rates;
+    nsp_handler_get_bus_rates(&rates);
+    serial_rx_rate = rates.rx_bytes_per_s;
+    serial_tx_rate = rates.tx_bytes_per_s;
+    serial_rx_busy_pct = (float)rates.rx_busy_permille / 10.0f;
+    serial_tx_busy_pct = (float)rates.tx_busy_permille / 10.0f;
+    serial_idle_pct = (float)rates.idle_permille / 10.0f;
+    serial_peak_rate = rates.peak_bytes_per_s;
+    serial_peak_busy_pct = (float)rates.peak_busy_permille / 10.0f;
+
     // Status is active if we've received any bytes
     serial_status = (rx_b > 0 || tx_b > 0) ? 1 : 0;
 }
@@ -11,7 +11,7 @@
 #include <stdint.h>
 
 /**
- * @brief Initialize Serial Interface table and register with catalog
+ * @brief Initialize Serial Interface table state
  */
 void table_serial_init(void);
 
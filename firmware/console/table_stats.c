@@ -0,0 +1,235 @@
+/**
+ * @file table_stats.c
+ * @brief Statistics Table Implementation
+ *
+ * Table 18: Statistics (64-bit totals since boot, per-minute history)
+ *
+ * The totals come from util/stats.h: they count from boot, survive RESET
+ * and do not wrap, unlike the 32-bit counters in Tables 2, 3 and 10.
+ * interval_age picks one of the closed one-minute intervals (0 = the most
+ * recent); the min_* fields are the counter increases over that minute.
+ */
+
+#include "table_stats.h"
+#include "tables.h"
+#include "../util/stats.h"
+#include <stdio.h>
+
+// ============================================================================
+// Live Data (Connected to Statistics Counters)
+// ============================================================================
+
+#define STATS_TOTAL_STR_LEN 24  // 20 digits + NUL
+
+static char stats_total_str[STATS_COUNT][STATS_TOTAL_STR_LEN];  // Totals, decimal
+static volatile uint32_t stats_intervals = 0;                    // Closed intervals held
+static volatile uint32_t stats_age = 0;                          // Interval shown (0 = latest)
+static volatile uint32_t stats_end_s = 0;                        // Its end, s since boot
+static volatile uint32_t stats_delta[STATS_COUNT];               // Its counter increases
+
+_Static_assert(STATS_COUNT == 6, "one total and one per-minute field per counter");
+
+// ============================================================================
+// Field Definitions
+// ============================================================================
+
+static const field_meta_t stats_fields[] = {
+    {
+        .id = 1801,
+        .name = "physics_ticks",
+        .type = FIELD_TYPE_STRING,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)stats_total_str[0],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1802,
+        .name = "wheel_revs",
+        .type = FIELD_TYPE_STRING,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)stats_total_str[1],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1803,
+        .name = "rx_bytes",
+        .type = FIELD_TYPE_STRING,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)stats_total_str[2],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1804,
+        .name = "tx_bytes",
+        .type = FIELD_TYPE_STRING,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)stats_total_str[3],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1805,
+        .name = "rx_frames",
+        .type = FIELD_TYPE_STRING,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)stats_total_str[4],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1806,
+        .name = "tx_frames",
+        .type = FIELD_TYPE_STRING,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)stats_total_str[5],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1807,
+        .name = "intervals",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stats_intervals,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1808,
+        .name = "interval_age",
+        .type = FIELD_TYPE_U32,
+        .units = "min",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stats_age,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1809,
+        .name = "interval_end_s",
+        .type = FIELD_TYPE_U32,
+        .units = "s",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stats_end_s,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1810,
+        .name = "min_physics_ticks",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stats_delta[0],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1811,
+        .name = "min_wheel_revs",
+        .type = FIELD_TYPE_U32,
+        .units = "revs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stats_delta[1],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1812,
+        .name = "min_rx_bytes",
+        .type = FIELD_TYPE_U32,
+        .units = "bytes",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stats_delta[2],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1813,
+        .name = "min_tx_bytes",
+        .type = FIELD_TYPE_U32,
+        .units = "bytes",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stats_delta[3],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1814,
+        .name = "min_rx_frames",
+        .type = FIELD_TYPE_U32,
+        .units = "frames",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stats_delta[4],
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1815,
+        .name = "min_tx_frames",
+        .type = FIELD_TYPE_U32,
+        .units = "frames",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stats_delta[5],
+        .enum_values = NULL,
+        .enum_count = 0,
+    }
+};
+
+const table_meta_t table_stats_meta = {
+    .id = 18,
+    .name = "Statistics",
+    .description = "64-bit totals, per-minute history",
+    .fields = stats_fields,
+    .field_count = sizeof(stats_fields) / sizeof(stats_fields[0]),
+};
+
+// ============================================================================
+// Update Function
+// ============================================================================
+
+void table_stats_update(void) {
+    for (uint32_t i = 0; i < STATS_COUNT; i++) {
+        snprintf(stats_total_str[i], sizeof(stats_total_str[i]), "%llu",
+                 (unsigned long long)stats_read((stats_id_t)i));
+    }
+
+    stats_intervals = stats_interval_count();
+    stats_interval_t interval;
+    if (stats_get_interval(stats_age, &interval)) {
+        stats_end_s = interval.end_s;
+        for (uint32_t i = 0; i < STATS_COUNT; i++) {
+            stats_delta[i] = interval.delta[i];
+        }
+    } else {
+        stats_end_s = 0;
+        for (uint32_t i = 0; i < STATS_COUNT; i++) {
+            stats_delta[i] = 0;
+        }
+    }
+}
@@ -0,0 +1,20 @@
+/**
+ * @file table_stats.h
+ * @brief Statistics Table for Console TUI
+ *
+ * Table 18: Statistics (64-bit totals since boot, per-minute history)
+ */
+
+#ifndef TABLE_STATS_H
+#define TABLE_STATS_H
+
+#include <stdint.h>
+
+/**
+ * @brief Refresh the totals and the selected interval
+ *
+ * Call this periodically from the main loop
+ */
+void table_stats_update(void);
+
+#endif // TABLE_STATS_H
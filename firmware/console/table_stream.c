@@ -0,0 +1,245 @@
+/**
+ * @file table_stream.c
+ * @brief Telemetry Stream Table Implementation
+ *
+ * Table 14: Telemetry Stream (binary snapshot stream on USB CDC 1)
+ *
+ * Frame format and field bits are in drivers/usb_stream.h. The same port
+ * carries the RS-485 bus monitor capture (util/bus_mon.h), selected here.
+ */
+
+#include "table_stream.h"
+#include "tables.h"
+#include "board_pico.h"
+#include "../drivers/usb_stream.h"
+#include "../util/bus_mon.h"
+
+// ============================================================================
+// Live Data (Connected to Stream Driver)
+// ============================================================================
+
+static volatile uint32_t stream_enabled = 0;                       // Stream while host port open (bool)
+static volatile uint32_t stream_field_mask = USB_STREAM_FIELDS_ALL; // USB_STREAM_F_* bits sent
+static volatile uint32_t stream_divider = 1;                       // Stream every Nth tick
+static volatile uint32_t stream_frame_rate = 0;                    // Frames/s (all wheels)
+static volatile uint32_t stream_connected = 0;                     // Host has CDC 1 open (bool)
+static volatile uint32_t stream_frames_sent = 0;                   // Frames queued to USB
+static volatile uint32_t stream_bytes_sent = 0;                    // Encoded bytes queued
+static volatile uint32_t stream_dropped = 0;                       // Snapshots lost (ring full)
+static volatile uint32_t stream_ring_high_water = 0;               // Most snapshots queued at once
+static volatile uint32_t stream_bus_monitor = BUS_MON_OFF;         // bus_mon_mode_t
+static volatile uint32_t stream_captured = 0;                      // Bus frames captured
+static volatile uint32_t stream_capture_dropped = 0;               // Bus frames lost (capture ring full)
+static volatile uint32_t stream_capture_frames = 0;                // Capture frames queued to USB
+static volatile uint32_t stream_capture_high_water = 0;            // Most capture ring bytes in use
+
+static const char* bus_monitor_enum_values[] = {
+    "OFF",
+    "CAPTURE",
+    "PASSIVE",
+};
+
+// ============================================================================
+// Field Definitions
+// ============================================================================
+
+static const field_meta_t stream_fields[] = {
+    {
+        .id = 1401,
+        .name = "enabled",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_enabled,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1402,
+        .name = "field_mask",
+        .type = FIELD_TYPE_HEX,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = USB_STREAM_FIELDS_ALL,
+        .ptr = (volatile uint32_t*)&stream_field_mask,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1403,
+        .name = "divider",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 1,
+        .ptr = (volatile uint32_t*)&stream_divider,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1404,
+        .name = "frame_rate",
+        .type = FIELD_TYPE_U32,
+        .units = "Hz",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_frame_rate,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1405,
+        .name = "host_connected",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_connected,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1406,
+        .name = "frames_sent",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_frames_sent,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1407,
+        .name = "bytes_sent",
+        .type = FIELD_TYPE_U32,
+        .units = "bytes",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_bytes_sent,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1408,
+        .name = "dropped",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_dropped,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1409,
+        .name = "ring_high_water",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_ring_high_water,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1410,
+        .name = "bus_monitor",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_bus_monitor,
+        .enum_values = bus_monitor_enum_values,
+        .enum_count = 3,
+    },
+    {
+        .id = 1411,
+        .name = "captured",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_captured,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1412,
+        .name = "capture_dropped",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_capture_dropped,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1413,
+        .name = "capture_frames",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_capture_frames,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1414,
+        .name = "capture_high_water",
+        .type = FIELD_TYPE_U32,
+        .units = "bytes",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&stream_capture_high_water,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+};
+
+const table_meta_t table_stream_meta = {
+    .id = 14,
+    .name = "Telemetry Stream",
+    .description = "Binary snapshot stream on USB port 2",
+    .fields = stream_fields,
+    .field_count = sizeof(stream_fields) / sizeof(stream_fields[0]),
+};
+
+// ============================================================================
+// Update Function
+// ============================================================================
+
+void table_stream_update(void) {
+    // Settings edited in the TUI take effect on the next tick
+    if (stream_divider == 0) {
+        stream_divider = 1;
+    }
+    stream_field_mask &= USB_STREAM_FIELDS_ALL;
+    usb_stream_set_field_mask(stream_field_mask);
+    usb_stream_set_divider(stream_divider);
+    usb_stream_set_enabled(stream_enabled != 0);
+    if (stream_bus_monitor >= BUS_MON_MODE_COUNT) {
+        stream_bus_monitor = BUS_MON_OFF;
+    }
+    bus_mon_set_mode((bus_mon_mode_t)stream_bus_monitor);
+
+    stream_frame_rate = (PHYSICS_TICK_RATE_HZ * EMULATED_WHEEL_COUNT) / stream_divider;
+
+    usb_stream_stats_t stats;
+    usb_stream_get_stats(&stats);
+    stream_connected = stats.connected ? 1 : 0;
+    stream_frames_sent = stats.frames_sent;
+    stream_bytes_sent = stats.bytes_sent;
+    stream_dropped = stats.dropped_ring;
+    stream_ring_high_water = stats.ring_high_water;
+    stream_capture_frames = stats.capture_frames;
+
+    bus_mon_stats_t mon;
+    bus_mon_get_stats(&mon);
+    stream_captured = mon.captured;
+    stream_capture_dropped = mon.dropped;
+    stream_capture_high_water = mon.high_water;
+}
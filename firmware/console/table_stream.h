@@ -0,0 +1,20 @@
+/**
+ * @file table_stream.h
+ * @brief Telemetry Stream Table for Console TUI
+ *
+ * Table 14: Telemetry Stream (binary snapshot stream on USB CDC 1)
+ */
+
+#ifndef TABLE_STREAM_H
+#define TABLE_STREAM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Apply edited settings and refresh stream counters
+ *
+ * Call this periodically from the main loop
+ */
+void table_stream_update(void);
+
+#endif // TABLE_STREAM_H
@@ -38,7 +38,6 @@ static const field_meta_t telemetry_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&telem_last_block_id,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -50,7 +49,6 @@ static const field_meta_t telemetry_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&telem_sequence_num,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -62,7 +60,6 @@ static const field_meta_t telemetry_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&telem_rx_count,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -74,7 +71,6 @@ static const field_meta_t telemetry_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&telem_tx_count,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -86,7 +82,6 @@ static const field_meta_t telemetry_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&telem_last_rx_time_ms,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -98,7 +93,6 @@ static const field_meta_t telemetry_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&telem_last_tx_time_ms,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -108,19 +102,10 @@ static const field_meta_t telemetry_fields[] = {
 // Table Definition
 // ============================================================================
 
-static const table_meta_t telemetry_table = {
+const table_meta_t table_telemetry_meta = {
     .id = 7,
     .name = "NSP Telemetry",
     .description = "RS-485 telemetry block metadata (sequence, counts)",
     .fields = telemetry_fields,
     .field_count = sizeof(telemetry_fields) / sizeof(telemetry_fields[0]),
 };
-
-// ============================================================================
-// Initialization
-// ============================================================================
-
-void table_telemetry_init(void) {
-    // Register table with catalog
-    catalog_register_table(&telemetry_table);
-}
@@ -10,9 +10,4 @@
 
 #include <stdint.h>
 
-/**
- * @brief Initialize Telemetry Blocks table and register with catalog
- */
-void table_telemetry_init(void);
-
 #endif // TABLE_TELEMETRY_H
@@ -2,7 +2,10 @@
  * @file table_test_modes.c
  * @brief Table 11: Test Modes
  *
- * Simplified display showing current test mode status
+ * Simplified display showing current test mode status, and the test-mode
+ * sequencer: set seq_list (mode IDs as hex digits, left to right; 0 = all)
+ * and settle_ticks, then write seq_run = 1. The results are printed on the
+ * console when the sequence ends; result picks the mode shown below it.
  */
 
 #include "tables.h"
@@ -16,7 +19,7 @@
 
 // External reference to wheel state (shared across tables)
 // NOTE: Direct reads should be avoided - use telemetry snapshot for Core0 safety
-extern wheel_state_t g_wheel_state;
+extern wheel_state_t g_wheel_states[EMULATED_WHEEL_COUNT];
 
 // ============================================================================
 // Test Mode Status (Shadow State for Table Display)
@@ -25,20 +28,240 @@ extern wheel_state_t g_wheel_state;
 // These variables hold formatted status for display in the table
 static uint32_t active_mode_id = 0;  // Current active test mode ID
 
+// Sequencer control and results
+static volatile uint32_t seq_list = 0;                              // Modes for the next run
+static volatile uint32_t seq_settle_ticks = TEST_SEQ_SETTLE_TICKS_DEFAULT;
+static volatile uint32_t seq_run = 0;                               // Write 1 to start
+static volatile uint32_t seq_stop = 0;                              // Write 1 to stop
+static volatile uint32_t seq_state = 0;                             // test_seq_state_t
+static volatile uint32_t seq_current = 0;                           // Mode running
+static volatile uint32_t seq_done = 0;                              // Modes completed
+static volatile uint32_t seq_passed = 0;                            // Modes passed
+static volatile uint32_t seq_result = 0;                            // Result shown below
+static volatile uint32_t res_mode_id = 0;
+static volatile uint32_t res_outcome = 0;
+static volatile uint32_t res_settle_ms = 0;
+static volatile uint32_t res_run_ms = 0;
+static volatile float res_overshoot = 0.0f;
+static volatile float res_overshoot_pct = 0.0f;
+static volatile uint32_t res_faults = 0;
+static volatile uint32_t res_pass = 0;
+
+static test_seq_state_t last_seq_state = TEST_SEQ_IDLE;
+
+static const char* seq_state_enum[] = {
+    "IDLE",
+    "RUNNING",
+    "DONE",
+    "STOPPED",
+};
+
+static const char* outcome_enum[] = {
+    "SETTLED",
+    "FAULTED",
+    "TIMEOUT",
+};
+
 // ============================================================================
 // Field Definitions
 // ============================================================================
 
 static const field_meta_t test_mode_fields[] = {
     {
-        .id = 1101,
+        .id = 1601,
         .name = "active_mode_id",
         .type = FIELD_TYPE_U32,
         .units = "",
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = (volatile uint32_t*)&active_mode_id,
-        .dirty = false,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1602,
+        .name = "seq_list",
+        .type = FIELD_TYPE_HEX,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&seq_list,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1603,
+        .name = "settle_ticks",
+        .type = FIELD_TYPE_U32,
+        .units = "ticks",
+        .access = FIELD_ACCESS_RW,
+        .default_val = TEST_SEQ_SETTLE_TICKS_DEFAULT,
+        .ptr = (volatile uint32_t*)&seq_settle_ticks,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1604,
+        .name = "seq_run",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&seq_run,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1605,
+        .name = "seq_stop",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&seq_stop,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1606,
+        .name = "seq_state",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&seq_state,
+        .enum_values = seq_state_enum,
+        .enum_count = sizeof(seq_state_enum) / sizeof(seq_state_enum[0]),
+    },
+    {
+        .id = 1607,
+        .name = "seq_current",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&seq_current,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1608,
+        .name = "seq_done",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&seq_done,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1609,
+        .name = "seq_passed",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&seq_passed,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1610,
+        .name = "result",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&seq_result,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1611,
+        .name = "res_mode_id",
+        .type = FIELD_TYPE_U32,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&res_mode_id,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1612,
+        .name = "res_outcome",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&res_outcome,
+        .enum_values = outcome_enum,
+        .enum_count = sizeof(outcome_enum) / sizeof(outcome_enum[0]),
+    },
+    {
+        .id = 1613,
+        .name = "res_settle_ms",
+        .type = FIELD_TYPE_U32,
+        .units = "ms",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&res_settle_ms,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1614,
+        .name = "res_run_ms",
+        .type = FIELD_TYPE_U32,
+        .units = "ms",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&res_run_ms,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1615,
+        .name = "res_overshoot",
+        .type = FIELD_TYPE_FLOAT,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&res_overshoot,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1616,
+        .name = "res_overshoot_pct",
+        .type = FIELD_TYPE_FLOAT,
+        .units = "%",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&res_overshoot_pct,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1617,
+        .name = "res_faults",
+        .type = FIELD_TYPE_HEX,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&res_faults,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1618,
+        .name = "res_pass",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&res_pass,
         .enum_values = NULL,
         .enum_count = 0,
     }
@@ -50,32 +273,66 @@ static const field_meta_t test_mode_fields[] = {
 // Table Metadata
 // ============================================================================
 
-static const table_meta_t test_modes_table_meta = {
-    .id = 11,
+const table_meta_t table_test_modes_meta = {
+    .id = 16,
     .name = "Test Modes",
     .description = "Predefined operating scenarios for validation",
     .fields = test_mode_fields,
     .field_count = NUM_TEST_MODE_FIELDS
 };
 
-// ============================================================================
-// Table Registration
-// ============================================================================
-
-void table_test_modes_init(void) {
-    // Register table with catalog
-    catalog_register_table(&test_modes_table_meta);
-
-    printf("[TABLE] Test Modes table registered\n");
-}
-
 // ============================================================================
 // Update Function (Call periodically to refresh display)
 // ============================================================================
 
 void table_test_modes_update(void) {
+    if (seq_run) {
+        seq_run = 0;
+        test_seq_start(seq_list, seq_settle_ticks);
+    }
+    if (seq_stop) {
+        seq_stop = 0;
+        test_seq_stop();
+    }
+
     // Update shadow state from test mode framework
     active_mode_id = (uint32_t)test_mode_get_active();
+
+    test_seq_state_t state = test_seq_get_state();
+    if (state != last_seq_state && state != TEST_SEQ_RUNNING) {
+        test_seq_print_report();
+    }
+    last_seq_state = state;
+
+    seq_state = (uint32_t)state;
+    seq_current = (uint32_t)test_seq_get_current();
+    seq_done = 0;
+    seq_passed = 0;
+    test_seq_result_t result;
+    while (test_seq_get_result(seq_done, &result)) {
+        seq_passed += result.pass ? 1u : 0u;
+        seq_done++;
+    }
+
+    if (test_seq_get_result(seq_result, &result)) {
+        res_mode_id = (uint32_t)result.mode_id;
+        res_outcome = (uint32_t)result.outcome;
+        res_settle_ms = result.settle_ms;
+        res_run_ms = result.run_ms;
+        memcpy((void*)&res_overshoot, &result.overshoot, sizeof(float));
+        memcpy((void*)&res_overshoot_pct, &result.overshoot_pct, sizeof(float));
+        res_faults = result.faults;
+        res_pass = result.pass ? 1u : 0u;
+    } else {
+        res_mode_id = 0;
+        res_outcome = 0;
+        res_settle_ms = 0;
+        res_run_ms = 0;
+        res_overshoot = 0.0f;
+        res_overshoot_pct = 0.0f;
+        res_faults = 0;
+        res_pass = 0;
+    }
 }
 
 // ============================================================================
@@ -94,7 +351,7 @@ bool table_test_modes_activate(int mode_id) {
         return false;
     }
 
-    bool success = test_mode_activate(&g_wheel_state, (test_mode_id_t)mode_id);
+    bool success = test_mode_activate(&g_wheel_states[0], (test_mode_id_t)mode_id);
     if (success) {
         table_test_modes_update();
     }
@@ -107,7 +364,7 @@ bool table_test_modes_activate(int mode_id) {
  * Usage: test 0  (or test stop)
  */
 bool table_test_modes_deactivate(void) {
-    test_mode_deactivate(&g_wheel_state);
+    test_mode_deactivate(&g_wheel_states[0]);
     table_test_modes_update();
     return true;
 }
@@ -10,11 +10,6 @@
 #include <stddef.h>
 #include <stdbool.h>
 
-/**
- * @brief Initialize test modes table
- */
-void table_test_modes_init(void);
-
 /**
  * @brief Update test modes table status
  */
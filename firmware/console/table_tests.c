@@ -2,12 +2,15 @@
  * @file table_tests.c
  * @brief Built-In Tests Table
  *
- * Displays cached test results from boot-time checkpoint tests.
+ * Displays cached test results from boot-time checkpoint tests, and
+ * where they came from (run this boot or loaded from the flash cache).
  */
 
+#include "table_tests.h"
 #include "tables.h"
 #include "test_results.h"
 #include <stdio.h>
+#include <string.h>
 
 // ============================================================================
 // Live Value Storage (dummy for now - will show test summary)
@@ -18,6 +21,11 @@ static volatile uint32_t tests_passed = 0;
 static volatile uint32_t tests_failed = 0;
 static volatile uint32_t tests_duration_ms = 0;
 
+// Provenance
+static volatile uint32_t tests_cached = 0;             // Checkpoints loaded from flash
+static char tests_build[32] = "-";                     // Build that ran the cached ones
+static volatile uint32_t tests_clear_cache = 0;        // Write 1 to erase the flash record
+
 // ============================================================================
 // Field Definitions
 // ============================================================================
@@ -31,7 +39,6 @@ static const field_meta_t test_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = &tests_total,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -43,7 +50,6 @@ static const field_meta_t test_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = &tests_passed,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -55,7 +61,6 @@ static const field_meta_t test_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = &tests_failed,
-        .dirty = false,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -67,7 +72,39 @@ static const field_meta_t test_fields[] = {
         .access = FIELD_ACCESS_RO,
         .default_val = 0,
         .ptr = &tests_duration_ms,
-        .dirty = false,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 104,
+        .name = "cached",
+        .type = FIELD_TYPE_U32,
+        .units = "checkpoints",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = &tests_cached,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 105,
+        .name = "cached_build",
+        .type = FIELD_TYPE_STRING,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)tests_build,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 106,
+        .name = "clear_cache",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = 0,
+        .ptr = &tests_clear_cache,
         .enum_values = NULL,
         .enum_count = 0,
     },
@@ -77,7 +114,7 @@ static const field_meta_t test_fields[] = {
 // Table Definition
 // ============================================================================
 
-static const table_meta_t test_table = {
+const table_meta_t table_tests_meta = {
     .id = 1,
     .name = "Boot Test Results",
     .description = "Boot-time checkpoint test results",
@@ -95,7 +132,24 @@ void table_tests_init(void) {
     tests_passed = g_test_results.total_passed;
     tests_failed = g_test_results.total_tests - g_test_results.total_passed;
     tests_duration_ms = g_test_results.total_duration_ms;
+    tests_cached = g_test_results.cached_count;
+    if (g_test_results.cache_build) {
+        strncpy(tests_build, g_test_results.cache_build, sizeof(tests_build) - 1);
+    }
+
+}
+
+// ============================================================================
+// Update
+// ============================================================================
 
-    // Register table
-    catalog_register_table(&test_table);
+void table_tests_update(void) {
+    if (tests_clear_cache) {
+        tests_clear_cache = 0;
+        if (test_results_clear_cache()) {
+            printf("[TEST] Cached results erased (next boot runs every checkpoint)\n");
+        } else {
+            printf("[TEST] ERROR: Could not erase cached results\n");
+        }
+    }
 }
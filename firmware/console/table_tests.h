@@ -7,8 +7,13 @@
 #define TABLE_TESTS_H
 
 /**
- * @brief Initialize and register Built-In Tests table
+ * @brief Initialize Built-In Tests table state
  */
 void table_tests_init(void);
 
+/**
+ * @brief Apply the clear_cache request (call from main loop)
+ */
+void table_tests_update(void);
+
 #endif // TABLE_TESTS_H
@@ -0,0 +1,184 @@
+/**
+ * @file table_timebase.c
+ * @brief Timebase Table Implementation
+ *
+ * Table 17: Timebase (PPS discipline of the physics tick)
+ *
+ * With pps_enabled set, PPS_IN_PIN edges steer the tick period so boards
+ * sharing one PPS tick together. offset_us is the last edge's distance
+ * from the nearest tick; drift_ppb is the local crystal's error the loop
+ * has learned.
+ */
+
+#include "table_timebase.h"
+#include "tables.h"
+#include "board_pico.h"
+#include "timebase.h"
+
+// ============================================================================
+// Live Data (Connected to Timebase)
+// ============================================================================
+
+static volatile uint32_t pps_enabled = PPS_DISCIPLINE_DEFAULT;  // Discipline the tick (bool)
+static volatile uint32_t pps_state = 0;                         // timebase_pps_state_t
+static volatile int32_t pps_offset_us = 0;                      // Last edge minus nearest tick
+static volatile uint32_t pps_max_offset_us = 0;                 // Largest |offset| since lock
+static volatile int32_t pps_drift_ppb = 0;                      // Local clock vs. PPS
+static volatile uint32_t pps_period_ns = PHYSICS_TICK_PERIOD_US * 1000;  // Scheduled tick period
+static volatile uint32_t pps_interval_us = 0;                   // Local time between edges
+static volatile uint32_t pps_pulses = 0;                        // Edges seen
+static volatile uint32_t pps_rejected = 0;                      // Edges outside capture range
+static volatile uint32_t pps_lock_losses = 0;                   // Lock lost
+
+static const char* pps_state_enum[] = {
+    "OFF",
+    "ACQUIRING",
+    "TRACKING",
+    "LOCKED",
+    "HOLDOVER",
+};
+
+// ============================================================================
+// Field Definitions
+// ============================================================================
+
+static const field_meta_t timebase_fields[] = {
+    {
+        .id = 1701,
+        .name = "pps_enabled",
+        .type = FIELD_TYPE_BOOL,
+        .units = "",
+        .access = FIELD_ACCESS_RW,
+        .default_val = PPS_DISCIPLINE_DEFAULT,
+        .ptr = (volatile uint32_t*)&pps_enabled,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1702,
+        .name = "pps_state",
+        .type = FIELD_TYPE_ENUM,
+        .units = "",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&pps_state,
+        .enum_values = pps_state_enum,
+        .enum_count = sizeof(pps_state_enum) / sizeof(pps_state_enum[0]),
+    },
+    {
+        .id = 1703,
+        .name = "offset_us",
+        .type = FIELD_TYPE_I32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&pps_offset_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1704,
+        .name = "max_offset_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&pps_max_offset_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1705,
+        .name = "drift_ppb",
+        .type = FIELD_TYPE_I32,
+        .units = "ppb",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&pps_drift_ppb,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1706,
+        .name = "period_ns",
+        .type = FIELD_TYPE_U32,
+        .units = "ns",
+        .access = FIELD_ACCESS_RO,
+        .default_val = PHYSICS_TICK_PERIOD_US * 1000,
+        .ptr = (volatile uint32_t*)&pps_period_ns,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1707,
+        .name = "interval_us",
+        .type = FIELD_TYPE_U32,
+        .units = "µs",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&pps_interval_us,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1708,
+        .name = "pulses",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&pps_pulses,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1709,
+        .name = "rejected",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&pps_rejected,
+        .enum_values = NULL,
+        .enum_count = 0,
+    },
+    {
+        .id = 1710,
+        .name = "lock_losses",
+        .type = FIELD_TYPE_U32,
+        .units = "count",
+        .access = FIELD_ACCESS_RO,
+        .default_val = 0,
+        .ptr = (volatile uint32_t*)&pps_lock_losses,
+        .enum_values = NULL,
+        .enum_count = 0,
+    }
+};
+
+const table_meta_t table_timebase_meta = {
+    .id = 17,
+    .name = "Timebase",
+    .description = "PPS discipline of the physics tick",
+    .fields = timebase_fields,
+    .field_count = sizeof(timebase_fields) / sizeof(timebase_fields[0]),
+};
+
+// ============================================================================
+// Update Function
+// ============================================================================
+
+void table_timebase_update(void) {
+    timebase_set_pps_enabled(pps_enabled != 0);
+
+    timebase_pps_stats_t stats;
+    timebase_get_pps_stats(&stats);
+    pps_state = (uint32_t)stats.state;
+    pps_offset_us = stats.offset_us;
+    pps_max_offset_us = stats.max_offset_us;
+    pps_drift_ppb = stats.drift_ppb;
+    pps_period_ns = stats.period_ns;
+    pps_interval_us = stats.last_interval_us;
+    pps_pulses = stats.pulses;
+    pps_rejected = stats.rejected;
+    pps_lock_losses = stats.lock_losses;
+}
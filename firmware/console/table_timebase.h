@@ -0,0 +1,20 @@
+/**
+ * @file table_timebase.h
+ * @brief Timebase Table for Console TUI
+ *
+ * Table 17: Timebase (PPS discipline of the physics tick)
+ */
+
+#ifndef TABLE_TIMEBASE_H
+#define TABLE_TIMEBASE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Apply the PPS enable and refresh the loop statistics
+ *
+ * Call this periodically from the main loop
+ */
+void table_timebase_update(void);
+
+#endif // TABLE_TIMEBASE_H
@@ -2,22 +2,22 @@
  * @file tables.c
  * @brief Table/Field Catalog Implementation
  *
- * Modular registration-based catalog system.
- * Tables register themselves at initialization.
+ * Lookups over the generated const catalog (catalog_index.c), field
+ * access, dirty tracking and persistent fields.
  */
 
 #include "tables.h"
+#include "catalog_index.h"   // Generated (tools/catalog_compile.py)
 #include "table_tests.h"
 #include "table_serial.h"
-#include "table_nsp.h"
 #include "table_control.h"
 #include "table_protection_limits.h"
-#include "table_protection_status.h"
-#include "table_telemetry.h"
 #include "table_config.h"
 #include "table_fault_injection.h"
 #include "table_core1_stats.h"
-#include "table_test_modes.h"
+#include "table_profiler.h"
+#include "../config/config_store.h"
+#include "../util/core_sync.h"
 #include <string.h>
 #include <math.h>
 #include <strings.h>  // For strcasecmp
@@ -28,55 +28,102 @@
 // ============================================================================
 // Catalog Storage
 // ============================================================================
+//
+// The table list and its lookup index are generated at build time
+// (tools/catalog_compile.py → catalog_index.c) and live in flash. IDs index
+// arrays directly; names go through open-addressed hash tables
+// (case-insensitive FNV-1a, linear probing, at most half full). Fields are
+// numbered densely in menu order; slots hold 1 + that number (0 = empty).
 
-// Array of registered tables (pointers to static metadata)
-static const table_meta_t* catalog[CATALOG_MAX_TABLES];
-static uint8_t catalog_count = 0;
+_Static_assert(CATALOG_TABLE_COUNT <= CATALOG_MAX_TABLES, "too many tables");
+_Static_assert(CATALOG_FIELD_COUNT <= CATALOG_MAX_FIELDS, "too many fields");
+_Static_assert(CATALOG_PERSISTENT_COUNT <= CONFIG_STORE_MAX_KEYS, "config store too small");
+
+// Fields last written with a non-default value, one bit per dense number
+static uint32_t dirty_bits[(CATALOG_FIELD_COUNT + 31) / 32];
+
+/**
+ * @brief Case-insensitive FNV-1a, seeded (table position for field names)
+ *
+ * Must match name_hash() in tools/catalog_compile.py.
+ */
+static uint32_t name_hash(const char* name, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    while (*name) {
+        h ^= (uint8_t)tolower((unsigned char)*name++);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static inline const field_meta_t* field_at(uint16_t dense) {
+    const catalog_field_ref_t* ref = &catalog_fields[dense];
+    return &catalog_tables[ref->table]->fields[ref->field];
+}
+
+/**
+ * @brief Dense number of a catalog field (-1 if not in the catalog)
+ */
+static int32_t field_number(const field_meta_t* field) {
+    if (field->id > CATALOG_MAX_FIELD_ID || catalog_field_by_id[field->id] == 0) {
+        return -1;
+    }
+    uint16_t dense = (uint16_t)(catalog_field_by_id[field->id] - 1);
+    return (field_at(dense) == field) ? (int32_t)dense : -1;
+}
+
+/**
+ * @brief Update a field's dirty bit from its current value
+ */
+static bool update_dirty(const field_meta_t* field) {
+    int32_t dense = field_number(field);
+    uint32_t value;
+    if (dense < 0 || !catalog_get_value(field, &value)) {
+        return false;
+    }
+
+    uint32_t bit = 1u << (dense & 31);
+    bool dirty = (field->type != FIELD_TYPE_STRING && value != field->default_val);
+    if (dirty) {
+        dirty_bits[dense >> 5] |= bit;
+    } else {
+        dirty_bits[dense >> 5] &= ~bit;
+    }
+    return dirty;
+}
 
 // ============================================================================
 // Initialization
 // ============================================================================
 
 void catalog_init(void) {
-    // Clear catalog
-    memset(catalog, 0, sizeof(catalog));
-    catalog_count = 0;
+    memset(dirty_bits, 0, sizeof(dirty_bits));
 
-    // Register tables (in menu order)
+    // Tables that keep state of their own (menu order)
     table_tests_init();
     table_serial_init();
-    table_nsp_init();
     table_control_init();
     table_protection_limits_init();
-    table_protection_status_init();
-    table_telemetry_init();
     table_config_init();
     table_fault_injection_init();
     table_core1_stats_init();
-    table_test_modes_init();
-
-    printf("[CATALOG] Initialized with %d tables\n", catalog_count);
-}
-
-// ============================================================================
-// Registration
-// ============================================================================
-
-bool catalog_register_table(const table_meta_t* table) {
-    if (!table) {
-        printf("[CATALOG] ERROR: NULL table pointer\n");
-        return false;
-    }
-
-    if (catalog_count >= CATALOG_MAX_TABLES) {
-        printf("[CATALOG] ERROR: Catalog full (%d tables)\n", CATALOG_MAX_TABLES);
-        return false;
+    table_profiler_init();
+
+    printf("[CATALOG] %d tables, %d fields (index built at compile time)\n",
+           CATALOG_TABLE_COUNT, CATALOG_FIELD_COUNT);
+
+    // Stored values replace the defaults; each table applies them on its
+    // first update like any other edit
+    uint16_t restored = 0;
+    for (uint16_t i = 0; i < CATALOG_PERSISTENT_COUNT; i++) {
+        const field_meta_t* field = field_at(catalog_persistent[i]);
+        uint32_t value;
+        if (config_store_get(field->id, &value) && catalog_set_value(field, value)) {
+            restored++;
+        }
     }
-
-    catalog[catalog_count++] = table;
-    printf("[CATALOG] Registered table: %s (%d fields)\n",
-           table->name, table->field_count);
-    return true;
+    printf("[CATALOG] %u persistent fields, %u restored from flash\n",
+           (unsigned)CATALOG_PERSISTENT_COUNT, restored);
 }
 
 // ============================================================================
@@ -84,14 +131,14 @@ bool catalog_register_table(const table_meta_t* table) {
 // ============================================================================
 
 uint8_t catalog_get_table_count(void) {
-    return catalog_count;
+    return CATALOG_TABLE_COUNT;
 }
 
 const table_meta_t* catalog_get_table_by_index(uint8_t index) {
-    if (index >= catalog_count) {
+    if (index >= CATALOG_TABLE_COUNT) {
         return NULL;
     }
-    return catalog[index];
+    return catalog_tables[index];
 }
 
 const table_meta_t* catalog_get_table_by_name(const char* name) {
@@ -99,15 +146,25 @@ const table_meta_t* catalog_get_table_by_name(const char* name) {
         return NULL;
     }
 
-    for (uint8_t i = 0; i < catalog_count; i++) {
-        if (strcasecmp(catalog[i]->name, name) == 0) {
-            return catalog[i];
+    uint32_t h = name_hash(name, 0);
+    uint8_t slot;
+    while ((slot = catalog_table_hash[h & (CATALOG_TABLE_HASH_SLOTS - 1)]) != 0) {
+        if (strcasecmp(catalog_tables[slot - 1]->name, name) == 0) {
+            return catalog_tables[slot - 1];
         }
+        h++;
     }
 
     return NULL;
 }
 
+const table_meta_t* catalog_get_table_by_id(uint8_t id) {
+    if (id > CATALOG_MAX_TABLE_ID || catalog_table_by_id[id] == 0) {
+        return NULL;
+    }
+    return catalog_tables[catalog_table_by_id[id] - 1];
+}
+
 const field_meta_t* catalog_get_field(const table_meta_t* table, uint8_t field_index) {
     if (!table || field_index >= table->field_count) {
         return NULL;
@@ -120,15 +177,33 @@ const field_meta_t* catalog_get_field_by_name(const table_meta_t* table, const c
         return NULL;
     }
 
-    for (uint8_t i = 0; i < table->field_count; i++) {
-        if (strcasecmp(table->fields[i].name, name) == 0) {
-            return &table->fields[i];
+    // Hash is per catalog table (seeded with its position)
+    if (table->id > CATALOG_MAX_TABLE_ID || catalog_table_by_id[table->id] == 0 ||
+        catalog_tables[catalog_table_by_id[table->id] - 1] != table) {
+        return NULL;
+    }
+    uint8_t pos = (uint8_t)(catalog_table_by_id[table->id] - 1);
+
+    uint32_t h = name_hash(name, pos);
+    uint16_t slot;
+    while ((slot = catalog_field_hash[h & (CATALOG_FIELD_HASH_SLOTS - 1)]) != 0) {
+        if (catalog_fields[slot - 1].table == pos &&
+            strcasecmp(field_at((uint16_t)(slot - 1))->name, name) == 0) {
+            return field_at((uint16_t)(slot - 1));
         }
+        h++;
     }
 
     return NULL;
 }
 
+const field_meta_t* catalog_get_field_by_id(uint16_t id) {
+    if (id > CATALOG_MAX_FIELD_ID || catalog_field_by_id[id] == 0) {
+        return NULL;
+    }
+    return field_at((uint16_t)(catalog_field_by_id[id] - 1));
+}
+
 // ============================================================================
 // Field Access (Stubs - will be implemented in Checkpoint 8.2)
 // ============================================================================
@@ -157,33 +232,147 @@ bool catalog_write_field(const field_meta_t* field, float value) {
     // Type-specific encoding delegated to TUI field edit handler
     if (field->ptr && field->access != FIELD_ACCESS_RO) {
         *(volatile uint32_t*)field->ptr = (uint32_t)value;
+        update_dirty(field);
+        core_sync_ring(CORE_SYNC_BELL_CONFIG);
         return true;
     }
 
     return false;
 }
 
+bool catalog_get_value(const field_meta_t* field, uint32_t* value) {
+    if (!field || !field->ptr || !value) {
+        return false;
+    }
+
+    if (field->type == FIELD_TYPE_STRING) {
+        // For STRING type, pass the pointer value itself (address of string)
+        *value = (uint32_t)(uintptr_t)field->ptr;
+    } else if (field->type == FIELD_TYPE_FLOAT) {
+        // CRITICAL: For FLOAT type, use memcpy to avoid alignment issues
+        // The ptr points to a float, not a uint32_t. Dereferencing through
+        // uint32_t* causes strict aliasing violations and alignment faults.
+        float f;
+        memcpy(&f, (const void*)field->ptr, sizeof(float));
+        memcpy(value, &f, sizeof(uint32_t));
+    } else if (field->type == FIELD_TYPE_ENUM || field->type == FIELD_TYPE_BOOL) {
+        // CRITICAL: C enums are implementation-defined size (often 1-4 bytes)
+        // Read only 1 byte (most enums are 8-bit when values fit in 0-255)
+        // and zero-extend to uint32_t
+        uint8_t byte_val;
+        memcpy(&byte_val, (const void*)field->ptr, sizeof(uint8_t));
+        *value = (uint32_t)byte_val;
+    } else {
+        // For other types, dereference normally
+        *value = *field->ptr;
+    }
+    return true;
+}
+
+bool catalog_set_value(const field_meta_t* field, uint32_t value) {
+    if (!field || !field->ptr || field->access == FIELD_ACCESS_RO) {
+        return false;
+    }
+
+    // CRITICAL: For FLOAT type, use memcpy to avoid alignment issues
+    if (field->type == FIELD_TYPE_FLOAT) {
+        float f;
+        memcpy(&f, &value, sizeof(float));
+        memcpy((void*)field->ptr, &f, sizeof(float));
+    } else {
+        *(volatile uint32_t*)field->ptr = value;
+    }
+
+    update_dirty(field);
+
+    // The table updates that read this field run on their next pass
+    core_sync_ring(CORE_SYNC_BELL_CONFIG);
+    return true;
+}
+
 // ============================================================================
-// Defaults Tracking (Stubs - will be implemented in Checkpoint 8.2)
+// Persistent Fields
 // ============================================================================
 
+void catalog_save_persistent(uint64_t now_us) {
+    for (uint16_t i = 0; i < CATALOG_PERSISTENT_COUNT; i++) {
+        const field_meta_t* field = field_at(catalog_persistent[i]);
+        uint32_t value;
+        if (catalog_get_value(field, &value)) {
+            config_store_set(field->id, value, now_us);
+        }
+    }
+    config_store_service(now_us);
+}
+
+uint16_t catalog_get_persistent_count(void) {
+    return CATALOG_PERSISTENT_COUNT;
+}
+
+// ============================================================================
+// Defaults Tracking
+// ============================================================================
+
+bool catalog_is_dirty(const field_meta_t* field) {
+    if (!field) {
+        return false;
+    }
+    int32_t dense = field_number(field);
+    return dense >= 0 && (dirty_bits[dense >> 5] & (1u << (dense & 31))) != 0;
+}
+
 uint16_t catalog_get_dirty_fields(char* out_buf, size_t buflen) {
     if (!out_buf || buflen == 0) {
         return 0;
     }
-
-    // Dirty tracking not implemented - not required for Phase 10
-    // Future: Track which fields differ from defaults
     out_buf[0] = '\0';
-    return 0;
+
+    uint16_t count = 0;
+    size_t used = 0;
+    for (uint16_t w = 0; w < sizeof(dirty_bits) / sizeof(dirty_bits[0]); w++) {
+        uint32_t bits = dirty_bits[w];
+        while (bits != 0) {
+            uint16_t dense = (uint16_t)(w * 32u + (uint32_t)__builtin_ctz(bits));
+            bits &= bits - 1u;
+
+            // The table may have moved the value back since the write
+            const field_meta_t* field = field_at(dense);
+            if (!update_dirty(field)) {
+                continue;
+            }
+            count++;
+
+            uint32_t value = 0;
+            char value_str[32];
+            catalog_get_value(field, &value);
+            catalog_format_value(field, value, value_str, sizeof(value_str));
+            if (used < buflen) {
+                int n = snprintf(out_buf + used, buflen - used, "%u.%s = %s\n",
+                                 (unsigned)catalog_tables[catalog_fields[dense].table]->id,
+                                 field->name, value_str);
+                used = (n < 0) ? buflen : used + (size_t)n;
+            }
+        }
+    }
+    return count;
 }
 
 uint16_t catalog_restore_defaults(const table_meta_t* table, const field_meta_t* field) {
-    // Defaults restoration not implemented - not required for Phase 10
-    // Future: Reset fields to default_val from metadata
-    (void)table;
-    (void)field;
-    return 0;
+    uint16_t restored = 0;
+    for (uint16_t dense = 0; dense < CATALOG_FIELD_COUNT; dense++) {
+        if ((dirty_bits[dense >> 5] & (1u << (dense & 31))) == 0) {
+            continue;
+        }
+        const field_meta_t* f = field_at(dense);
+        if ((table && catalog_tables[catalog_fields[dense].table] != table) ||
+            (field && f != field)) {
+            continue;
+        }
+        if (catalog_set_value(f, f->default_val)) {
+            restored++;
+        }
+    }
+    return restored;
 }
 
 // ============================================================================
@@ -316,6 +505,28 @@ bool catalog_parse_value(const field_meta_t* field, const char* str, uint32_t* v
             }
             return false;
 
+        case FIELD_TYPE_I32:
+            {
+                char* endptr;
+                long num = strtol(str, &endptr, 10);
+                if (*str != '\0' && *endptr == '\0') {
+                    *value = (uint32_t)(int32_t)num;
+                    return true;
+                }
+            }
+            return false;
+
+        case FIELD_TYPE_FLOAT:
+            {
+                char* endptr;
+                float f = strtof(str, &endptr);
+                if (*str != '\0' && *endptr == '\0' && isfinite(f)) {
+                    memcpy(value, &f, sizeof(uint32_t));
+                    return true;
+                }
+            }
+            return false;
+
         default:
             // Unsupported type
             return false;
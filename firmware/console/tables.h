@@ -4,14 +4,14 @@
  *
  * **DESIGN PHILOSOPHY: FULLY MODULAR & EXTENSIBLE**
  *
- * This catalog system uses a registration-based architecture that allows
- * new tables to be added without modifying core TUI code:
+ * Each table is a const field metadata array plus a const table_meta_t in
+ * its own table_*.c, so descriptors stay in flash. At build time,
+ * tools/catalog_compile.py reads those sources and generates the catalog
+ * (catalog_index.c): the table list in menu order, the ID → field index and
+ * the name hash tables, all const. Nothing registers or indexes at boot;
+ * the only mutable catalog state is the dirty bitset in tables.c.
  *
- * 1. Define table metadata (see table_meta_t)
- * 2. Define field metadata array (see field_meta_t)
- * 3. Call catalog_register_table() during initialization
- *
- * The TUI and command palette dynamically discover tables via the catalog API.
+ * The TUI and command palette discover tables via the catalog API.
  *
  * **CURRENT TABLES** (per SPEC.md §8):
  * 1. Serial Interface
@@ -23,7 +23,12 @@
  * 7. Config & JSON
  *
  * **ADDING A NEW TABLE**:
- * See example in tables.c:catalog_init() and table_*.c files.
+ * 1. Define the field metadata array (field_meta_t) and a non-static
+ *    `const table_meta_t table_<name>_meta` in console/table_<name>.c
+ *    (literal .id and .name, .fields pointing at the array)
+ * 2. Add the source to NRWA_CATALOG_TABLES in firmware/CMakeLists.txt, in
+ *    menu order
+ * 3. If the table keeps state, call its init from catalog_init()
  */
 
 #ifndef TABLES_H
@@ -38,11 +43,11 @@
 // ============================================================================
 
 /**
- * @brief Maximum number of tables that can be registered
+ * @brief Maximum number of tables in the catalog
  *
- * Increase this if you need more than 16 tables in the catalog.
+ * Increase this if you need more than 24 tables in the catalog.
  */
-#define CATALOG_MAX_TABLES  16
+#define CATALOG_MAX_TABLES  24
 
 /**
  * @brief Maximum number of fields per table
@@ -51,6 +56,17 @@
  */
 #define CATALOG_MAX_FIELDS_PER_TABLE  32
 
+/**
+ * @brief Catalog-wide limits of the lookup index (see catalog_get_field_by_id)
+ *
+ * Field IDs are table ID × 100 + field number and must be unique; table IDs
+ * and names must be unique too. The generator rejects a catalog that breaks
+ * these rules, and the build fails.
+ */
+#define CATALOG_MAX_TABLE_ID    24
+#define CATALOG_MAX_FIELD_ID    ((CATALOG_MAX_TABLE_ID + 1) * 100 - 1)
+#define CATALOG_MAX_FIELDS      512
+
 /**
  * @brief Field type identifiers
  */
@@ -93,9 +109,9 @@ typedef struct {
     field_access_t access;      // Read/Write permissions
     uint32_t default_val;       // Compiled default value
     volatile uint32_t* ptr;     // Pointer to live value (NULL if not applicable)
-    bool dirty;                 // True if value != default
     const char** enum_values;   // Enum string lookup (NULL if not enum)
     uint8_t enum_count;         // Number of enum values
+    bool persistent;            // Kept in the flash config store across resets
 } field_meta_t;
 
 /**
@@ -114,47 +130,18 @@ typedef struct {
 // ============================================================================
 
 /**
- * @brief Initialize table/field catalog (empty)
+ * @brief Initialize the tables' state and restore the persistent fields
  *
- * Clears all registered tables. Call this first, then register tables.
- * Must be called before any table registration.
+ * The catalog itself is generated at build time; this clears the dirty
+ * bits, runs the init of each table that keeps state and applies the values
+ * kept in the config store.
  */
 void catalog_init(void);
 
 /**
- * @brief Register a table in the catalog
- *
- * **HOW TO ADD A NEW TABLE**:
- * 1. Create table metadata structure (table_meta_t)
- * 2. Create field metadata array (field_meta_t[])
- * 3. Call this function during initialization
- *
- * Example:
- * ```c
- * static const field_meta_t my_fields[] = {
- *     {.id = 1, .name = "field1", .type = FIELD_TYPE_U32, ...},
- *     {.id = 2, .name = "field2", .type = FIELD_TYPE_FLOAT, ...},
- * };
- *
- * static const table_meta_t my_table = {
- *     .name = "My Custom Table",
- *     .description = "Does something cool",
- *     .fields = my_fields,
- *     .field_count = 2,
- * };
- *
- * catalog_register_table(&my_table);
- * ```
- *
- * @param table Pointer to table metadata (must remain valid)
- * @return true if registered successfully, false if catalog full
- */
-bool catalog_register_table(const table_meta_t* table);
-
-/**
- * @brief Get number of registered tables
+ * @brief Get number of tables
  *
- * @return Number of tables currently in catalog
+ * @return Number of tables in the catalog
  */
 uint8_t catalog_get_table_count(void);
 
@@ -175,13 +162,21 @@ uint8_t catalog_get_table_count(void);
 const table_meta_t* catalog_get_table_by_index(uint8_t index);
 
 /**
- * @brief Get table metadata by name
+ * @brief Get table metadata by name (hashed, constant time)
  *
  * @param name Table name (case-insensitive)
  * @return Pointer to table metadata, or NULL if not found
  */
 const table_meta_t* catalog_get_table_by_name(const char* name);
 
+/**
+ * @brief Get table metadata by table ID (constant time)
+ *
+ * @param id Table ID (table_meta_t.id)
+ * @return Pointer to table metadata, or NULL if not in the catalog
+ */
+const table_meta_t* catalog_get_table_by_id(uint8_t id);
+
 /**
  * @brief Get field metadata by index within table
  *
@@ -192,7 +187,7 @@ const table_meta_t* catalog_get_table_by_name(const char* name);
 const field_meta_t* catalog_get_field(const table_meta_t* table, uint8_t field_index);
 
 /**
- * @brief Get field metadata by name within table
+ * @brief Get field metadata by name within table (hashed, constant time)
  *
  * @param table Table metadata pointer
  * @param name Field name (case-insensitive)
@@ -200,6 +195,14 @@ const field_meta_t* catalog_get_field(const table_meta_t* table, uint8_t field_i
  */
 const field_meta_t* catalog_get_field_by_name(const table_meta_t* table, const char* name);
 
+/**
+ * @brief Get field metadata by field ID (direct index, constant time)
+ *
+ * @param id Field ID (e.g., 401)
+ * @return Pointer to field metadata, or NULL if not in the catalog
+ */
+const field_meta_t* catalog_get_field_by_id(uint16_t id);
+
 // ============================================================================
 // Catalog API - Field Access Functions
 // ============================================================================
@@ -222,16 +225,50 @@ bool catalog_read_field(const field_meta_t* field, float* value);
  */
 bool catalog_write_field(const field_meta_t* field, float value);
 
+/**
+ * @brief Read a field's raw value as formatted by catalog_format_value()
+ *
+ * Reads ENUM/BOOL fields as one byte, FLOAT fields by copy (bit pattern),
+ * and gives STRING fields the string's address.
+ *
+ * @param field Field metadata pointer
+ * @param value Output: raw value
+ * @return false if the field has no pointer
+ */
+bool catalog_get_value(const field_meta_t* field, uint32_t* value);
+
+/**
+ * @brief Store a raw value (as parsed by catalog_parse_value()) into a field
+ *
+ * @param field Field metadata pointer
+ * @param value Raw value (FLOAT fields: IEEE-754 bit pattern)
+ * @return false if the field is read-only or has no pointer
+ */
+bool catalog_set_value(const field_meta_t* field, uint32_t value);
+
 // ============================================================================
 // Catalog API - Defaults Tracking
 // ============================================================================
 
+/**
+ * @brief Check if a field was written with a value other than its default
+ *
+ * Set by catalog_write_field()/catalog_set_value(), cleared when the value
+ * written is the default (one bit per field, in RAM).
+ *
+ * @param field Field metadata pointer
+ * @return true if the last catalog write left a non-default value
+ */
+bool catalog_is_dirty(const field_meta_t* field);
+
 /**
  * @brief Get list of non-default fields (for "defaults list" command)
  *
- * Iterates through all registered tables and finds fields where current != default.
+ * Walks the dirty bits, drops fields whose value is back at the default,
+ * and formats the rest one per line as "<table ID>.<field> = value" (the
+ * batch field syntax).
  *
- * @param out_buf Output buffer for formatted string
+ * @param out_buf Output buffer for formatted string (truncated to fit)
  * @param buflen Buffer size
  * @return Number of non-default fields found
  */
@@ -240,12 +277,35 @@ uint16_t catalog_get_dirty_fields(char* out_buf, size_t buflen);
 /**
  * @brief Restore defaults for a table or specific field
  *
+ * Writes default_val back into the dirty writable fields.
+ *
  * @param table Table metadata pointer, or NULL for all tables
  * @param field Field metadata pointer, or NULL for all fields in table
  * @return Number of fields restored
  */
 uint16_t catalog_restore_defaults(const table_meta_t* table, const field_meta_t* field);
 
+// ============================================================================
+// Persistent Fields (config/config_store.h)
+// ============================================================================
+
+/**
+ * @brief Save changed persistent fields to the config store
+ *
+ * Call from the Core0 main loop after the table updates. Changes reach
+ * flash coalesced, at most once per CONFIG_STORE_MIN_INTERVAL_MS.
+ *
+ * @param now_us Current time
+ */
+void catalog_save_persistent(uint64_t now_us);
+
+/**
+ * @brief Get the number of fields marked persistent
+ *
+ * @return Persistent field count
+ */
+uint16_t catalog_get_persistent_count(void);
+
 /**
  * @brief Format field value to string with units
  *
@@ -3,6 +3,12 @@
  * @brief Text User Interface Implementation (Redesigned)
  *
  * Arrow-key navigation with expand/collapse tables.
+ *
+ * Navigation redraws the whole screen; the periodic refresh only rewrites
+ * the cells whose text changed since they were last drawn (see Render
+ * Model below). Each update is one usb_console frame: it never blocks,
+ * is skipped while the previous one drains, and nothing is rendered
+ * while no host has the port open.
  */
 
 #include "tui.h"
@@ -13,10 +19,18 @@
 #include "console_format.h"
 #include "table_control.h"
 #include "table_test_modes.h"
+#include "table_fault_injection.h"
 #include "nss_nrwa_t6_model.h"
 #include "nss_nrwa_t6_protection.h"
 #include "nss_nrwa_t6_test_modes.h"
 #include "util/core_sync.h"
+#include "util/profiler.h"
+#include "util/tick_trace.h"
+#include "util/trend.h"
+#include "timebase.h"
+#include "warm_restart.h"
+#include "drivers/usb_console.h"
+#include "batch.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -37,11 +51,66 @@
 // ============================================================================
 
 // External wheel state (for status banner)
-extern wheel_state_t g_wheel_state;
+extern wheel_state_t g_wheel_states[EMULATED_WHEEL_COUNT];
 
 static tui_state_t g_tui_state;
 static uint32_t g_boot_time_ms;
 
+// ============================================================================
+// Render Model
+// ============================================================================
+//
+// The full redraw records the screen row of every live cell (header line,
+// status banner, status bar, each visible field value) and the text drawn
+// there. The periodic refresh re-formats the cells and rewrites only those
+// that changed, using cursor addressing.
+//
+// Rows are logical (1 = first line of the full redraw). Autowrap is off
+// while the TUI runs, so one printed line is one row. After every draw the
+// cursor is parked on the row below the screen at column 2 and its
+// position is queried (CPR): the first reply gives how many rows scrolled
+// off the top; a later reply that differs means something else printed
+// or the terminal was resized, and the next update redraws everything. A
+// terminal that never answers keeps getting full redraws.
+
+#define TUI_MAX_CELLS       128     // Visible fields tracked (more: full redraws)
+#define TUI_LINE_MAX        256     // Formatted line, including ANSI codes
+#define TUI_CELL_TEXT_MAX   32
+
+typedef struct {
+    const field_meta_t* field;
+    uint16_t row;                   // Logical row
+    uint8_t col;                    // Column of the value (1-based)
+    char text[TUI_CELL_TEXT_MAX];   // Value as last drawn
+} tui_cell_t;
+
+static struct {
+    bool valid;                     // Screen known to match the model
+    bool awaiting_baseline;         // First CPR after a full redraw not seen yet
+    bool overflow;                  // More visible fields than TUI_MAX_CELLS
+    uint16_t park_row;              // Logical row the cursor is parked on
+    uint16_t park_screen_row;       // Screen row it was reported on
+    uint16_t scroll;                // Logical rows scrolled off the top
+    uint16_t header_row;
+    uint16_t banner_row;
+    uint16_t status_row;
+    char header[TUI_LINE_MAX];
+    char banner[TUI_LINE_MAX];
+    char status[TUI_LINE_MAX];
+    uint16_t cell_count;
+    tui_cell_t cells[TUI_MAX_CELLS];
+} g_render;
+
+static uint8_t g_logo_rows;         // Lines in LOGO_ART
+static bool g_update_deferred;      // Skipped while the last frame drained
+
+// Wait for the last frame before a blocking menu prints directly
+#define TUI_MODAL_WAIT_US   100000
+
+// Last cursor position report (tui_getkey)
+static uint16_t g_report_row;
+static uint16_t g_report_col;
+
 // ============================================================================
 // ANSI Escape Helpers (for arrow keys)
 // ============================================================================
@@ -50,12 +119,45 @@ static uint32_t g_boot_time_ms;
 #define KEY_ARROW_DOWN  0x1001
 #define KEY_ARROW_RIGHT 0x1002
 #define KEY_ARROW_LEFT  0x1003
+#define KEY_CURSOR_REPORT 0x1004    // CPR reply, in g_report_row/g_report_col
+
+/**
+ * @brief Read the rest of a cursor position report ("ESC [ row ; col R")
+ *
+ * @param c First digit (already read)
+ * @return KEY_CURSOR_REPORT, or PICO_ERROR_TIMEOUT if malformed
+ */
+static int tui_read_cursor_report(int c) {
+    uint32_t num[2] = {0, 0};
+    uint8_t n = 0;
+
+    while (true) {
+        if (c >= '0' && c <= '9') {
+            num[n] = num[n] * 10u + (uint32_t)(c - '0');
+            if (num[n] > 9999u) {
+                return PICO_ERROR_TIMEOUT;
+            }
+        } else if (c == ';' && n == 0) {
+            n = 1;
+        } else if (c == 'R' && n == 1) {
+            g_report_row = (uint16_t)num[0];
+            g_report_col = (uint16_t)num[1];
+            return KEY_CURSOR_REPORT;
+        } else {
+            return PICO_ERROR_TIMEOUT;
+        }
+        c = getchar_timeout_us(1000);
+    }
+}
 
 /**
  * @brief Read key with arrow key support
  * @return Character code or KEY_ARROW_* constants
  */
 static int tui_getkey(void) {
+    // Console waits poll here: a prompt counts as a live main loop
+    warm_restart_core0_beat();
+
     int c = getchar_timeout_us(0);
     if (c == PICO_ERROR_TIMEOUT) {
         return PICO_ERROR_TIMEOUT;
@@ -66,6 +168,9 @@ static int tui_getkey(void) {
         int c2 = getchar_timeout_us(1000);  // Wait 1ms for '['
         if (c2 == '[') {
             int c3 = getchar_timeout_us(1000);  // Arrow key code
+            if (c3 >= '0' && c3 <= '9') {
+                return tui_read_cursor_report(c3);
+            }
             switch (c3) {
                 case 'A': return KEY_ARROW_UP;
                 case 'B': return KEY_ARROW_DOWN;
@@ -92,16 +197,23 @@ void tui_init(void) {
     g_tui_state.needs_refresh = true;
     g_boot_time_ms = to_ms_since_boot(get_absolute_time());
 
-    // Clear screen and hide cursor
-    printf(ANSI_CLEAR_SCREEN ANSI_CURSOR_HOME ANSI_CURSOR_HIDE);
+    g_logo_rows = 0;
+    for (const char* p = LOGO_ART; *p; p++) {
+        if (*p == '\n') {
+            g_logo_rows++;
+        }
+    }
 
     // Show initial browse view
-    tui_render_browse();
+    tui_update(true);
 }
 
 void tui_shutdown(void) {
+    g_render.valid = false;
+    usb_console_wait_idle(TUI_MODAL_WAIT_US);
+
     // Restore terminal state
-    printf(ANSI_CURSOR_SHOW ANSI_RESET);
+    printf(ANSI_CURSOR_SHOW ANSI_AUTOWRAP_ON ANSI_RESET);
     printf(ANSI_CLEAR_SCREEN ANSI_CURSOR_HOME);
     printf("TUI closed. Goodbye!\n");
 }
@@ -110,26 +222,72 @@ void tui_shutdown(void) {
 // Main Update Loop
 // ============================================================================
 
+static void tui_render_changes(void);
+
 void tui_update(bool force_redraw) {
-    if (!force_redraw && !g_tui_state.needs_refresh) {
-        return;  // Nothing to do
+    if (force_redraw) {
+        g_tui_state.needs_refresh = true;
     }
 
-    // Render current mode
-    switch (g_tui_state.mode) {
-        case TUI_MODE_BROWSE:
-            tui_render_browse();
-            break;
+    // Batch protocol owns the port
+    if (batch_is_active()) {
+        g_render.valid = false;
+        return;
+    }
 
-        case TUI_MODE_EDIT:
-            // In edit mode, re-render browse view with input shown in status bar
-            tui_render_browse();
-            break;
+    // Headless: render nothing, redraw in full once a host opens the port
+    if (!usb_console_host_present()) {
+        g_render.valid = false;
+        g_update_deferred = false;
+        return;
+    }
+
+    // Last frame still draining: render the latest state when it is done
+    if (!usb_console_begin()) {
+        g_update_deferred = true;
+        return;
+    }
+    g_update_deferred = false;
+
+    // Both modes share the browse view (edit input shows in the status bar).
+    // Anything that may have moved a line gets a full redraw.
+    if (g_tui_state.needs_refresh || !g_render.valid || g_render.overflow) {
+        tui_render_browse();
+    } else {
+        tui_render_changes();
     }
 
+    if (!usb_console_end()) {
+        g_render.overflow = true;   // Did not fit one frame: keep redrawing in full
+    }
     g_tui_state.needs_refresh = false;
 }
 
+void tui_poll(void) {
+    if (g_update_deferred && !usb_console_busy()) {
+        tui_update(false);
+    }
+}
+
+/**
+ * @brief Check a cursor position report against the parked cursor
+ */
+static void tui_handle_cursor_report(uint16_t row, uint16_t col) {
+    if (g_render.awaiting_baseline) {
+        g_render.awaiting_baseline = false;
+        if (col == 2 && row >= 1 && row <= g_render.park_row) {
+            g_render.park_screen_row = row;
+            g_render.scroll = g_render.park_row - row;
+            g_render.valid = true;
+        }
+        return;
+    }
+
+    if (row != g_render.park_screen_row || col != 2) {
+        g_render.valid = false;     // Foreign output or resize
+    }
+}
+
 // ============================================================================
 // Test Mode Menu
 // ============================================================================
@@ -204,11 +362,11 @@ static void tui_show_test_mode_menu(void) {
                 printf("(In real hardware, this requires cycling power or RESET pin)\n");
             } else {
                 uint32_t old_faults = snapshot.fault_latch;
-                // Send CLEAR_FAULT command to Core1 via command mailbox
+                // Send CLEAR_FAULT command to Core1 via command queue
                 uint32_t clear_mask = 0xFFFFFFFF;
                 float mask_as_float;
                 memcpy(&mask_as_float, &clear_mask, sizeof(float));
-                if (core_sync_send_command_blocking(CMD_CLEAR_FAULT, mask_as_float, 0.0f, 0)) {
+                if (core_sync_send_command(CMD_CLEAR_FAULT, mask_as_float, 0.0f)) {
                     if (old_faults != 0) {
                         printf(ANSI_FG_GREEN "All faults cleared!" ANSI_RESET "\n");
                         printf("Previous faults: 0x%08lX\n", (unsigned long)old_faults);
@@ -244,6 +402,138 @@ static void tui_show_test_mode_menu(void) {
     g_tui_state.needs_refresh = true;
 }
 
+// ============================================================================
+// Profiler Dump
+// ============================================================================
+
+/**
+ * @brief Print profiler statistics, tick timing and deadline misses over USB
+ */
+static void tui_show_profiler_dump(void) {
+    tui_clear_screen();
+
+    printf("\n");
+    printf(ANSI_BOLD "═══ Profiler Dump ═══" ANSI_RESET "\n");
+    printf("\n");
+    profiler_dump();
+    printf("\n");
+    tick_trace_dump();
+
+    printf("\nPress X to reset statistics, any other key to return...");
+    fflush(stdout);
+
+    int key;
+    do {
+        key = tui_getkey();
+        sleep_ms(10);
+    } while (key == PICO_ERROR_TIMEOUT);
+
+    if (key == 'x' || key == 'X') {
+        profiler_reset();
+        tick_trace_request_reset();
+        timebase_reset_jitter_stats();
+    }
+
+    g_tui_state.needs_refresh = true;
+}
+
+// ============================================================================
+// Trend View
+// ============================================================================
+
+/**
+ * @brief Print one quantity's trend: bucket means, and spread within each bucket
+ *
+ * The mean row spans the window's min..max, so drift shows as a slope; the
+ * spread row (max - min per bucket) shows oscillation faster than a bucket.
+ */
+static void tui_print_trend(uint8_t wheel, trend_res_t res, trend_qty_t qty, const char* label,
+                            const char* units) {
+    static trend_bucket_t buckets[TREND_BUCKETS];
+    static float values[TREND_BUCKETS];
+    char line[TREND_BUCKETS * 3 + 1];
+
+    uint32_t n = trend_read(wheel, res, qty, buckets, TREND_BUCKETS);
+    if (n == 0) {
+        printf(ANSI_BOLD "%s" ANSI_RESET " (%s): no complete bucket yet\n\n\n\n", label, units);
+        return;
+    }
+
+    float lo = buckets[0].min;
+    float hi = buckets[0].max;
+    float spread_max = 0.0f;
+    for (uint32_t i = 0; i < n; i++) {
+        lo = (buckets[i].min < lo) ? buckets[i].min : lo;
+        hi = (buckets[i].max > hi) ? buckets[i].max : hi;
+        float spread = buckets[i].max - buckets[i].min;
+        spread_max = (spread > spread_max) ? spread : spread_max;
+    }
+
+    printf(ANSI_BOLD "%s" ANSI_RESET " (%s): now %.2f, min %.2f, max %.2f\n", label, units,
+           buckets[n - 1].mean, lo, hi);
+    for (uint32_t i = 0; i < n; i++) {
+        values[i] = buckets[i].mean;
+    }
+    console_format_sparkline(line, sizeof(line), values, n, TREND_BUCKETS, lo, hi);
+    printf("  mean   %s\n", line);
+    for (uint32_t i = 0; i < n; i++) {
+        values[i] = buckets[i].max - buckets[i].min;
+    }
+    console_format_sparkline(line, sizeof(line), values, n, TREND_BUCKETS, 0.0f, spread_max);
+    printf("  spread %s  ≤%.2f\n\n", line, spread_max);
+}
+
+/**
+ * @brief Show the speed/current/power trends from the Core1 history rings
+ *
+ * Redraws once a second until a key other than the view keys is pressed.
+ */
+static void tui_show_trends(void) {
+    static const trend_res_t res_keys[] = { TREND_RES_1S, TREND_RES_10S, TREND_RES_60S };
+    trend_res_t res = TREND_RES_1S;
+    uint8_t wheel = 0;
+
+    for (;;) {
+        uint32_t bucket_s = trend_bucket_seconds(res);
+        tui_clear_screen();
+        printf("\n");
+        printf(ANSI_BOLD "═══ Trends: wheel %u, %lu s buckets, last %lu s ═══" ANSI_RESET "\n",
+               (unsigned)wheel, (unsigned long)bucket_s, (unsigned long)(bucket_s * TREND_BUCKETS));
+        printf("\n");
+        tui_print_trend(wheel, res, TREND_SPEED, "Speed", "RPM");
+        tui_print_trend(wheel, res, TREND_CURRENT, "Current", "A");
+        tui_print_trend(wheel, res, TREND_POWER, "Power", "W");
+        printf(ANSI_DIM "1/2/3 : 1 s / 10 s / 60 s buckets | W : Next wheel | X : Clear history | "
+               "other : Return" ANSI_RESET "\n");
+        fflush(stdout);
+
+        int key;
+        uint64_t redraw_us = time_us_64() + 1000000u;
+        do {
+            key = tui_getkey();
+            if (key == PICO_ERROR_TIMEOUT) {
+                sleep_ms(10);
+            }
+        } while ((key == PICO_ERROR_TIMEOUT || key == KEY_CURSOR_REPORT) &&
+                 time_us_64() < redraw_us);
+
+        if (key == PICO_ERROR_TIMEOUT || key == KEY_CURSOR_REPORT) {
+            continue;
+        }
+        if (key >= '1' && key <= '3') {
+            res = res_keys[key - '1'];
+        } else if (key == 'w' || key == 'W') {
+            wheel = (uint8_t)((wheel + 1u) % EMULATED_WHEEL_COUNT);
+        } else if (key == 'x' || key == 'X') {
+            trend_reset();
+        } else {
+            break;
+        }
+    }
+
+    g_tui_state.needs_refresh = true;
+}
+
 // ============================================================================
 // Input Handling
 // ============================================================================
@@ -252,10 +542,22 @@ static bool tui_handle_browse_input(int key);
 static bool tui_handle_edit_input(int key);
 
 bool tui_handle_input(void) {
+    if (batch_is_active()) {
+        return false;  // batch_service() reads the port
+    }
+
     int key = tui_getkey();
     if (key == PICO_ERROR_TIMEOUT) {
         return false;  // No input
     }
+    if (key == KEY_CURSOR_REPORT) {
+        tui_handle_cursor_report(g_report_row, g_report_col);
+        return false;  // Terminal reply, not user input
+    }
+    if (key == BATCH_ENTER_KEY) {
+        batch_enter();
+        return true;
+    }
 
     // Handle based on current mode
     switch (g_tui_state.mode) {
@@ -369,9 +671,32 @@ static bool tui_handle_browse_input(int key) {
         case 't':
         case 'T':
             // Test mode menu
+            usb_console_wait_idle(TUI_MODAL_WAIT_US);
             tui_show_test_mode_menu();
             return true;
 
+        case 'p':
+        case 'P':
+            // Profiler dump (statistics + histograms)
+            usb_console_wait_idle(TUI_MODAL_WAIT_US);
+            tui_show_profiler_dump();
+            return true;
+
+        case 'h':
+        case 'H':
+            // Trend view (history rings)
+            usb_console_wait_idle(TUI_MODAL_WAIT_US);
+            tui_show_trends();
+            return true;
+
+        case 'l':
+        case 'L':
+            // Scenario library (upload to flash)
+            usb_console_wait_idle(TUI_MODAL_WAIT_US);
+            fault_injection_library_menu();
+            g_tui_state.needs_refresh = true;
+            return true;
+
         case 'q':
         case 'Q':
         case 27:  // ESC
@@ -386,15 +711,15 @@ static bool tui_handle_browse_input(int key) {
 /**
  * @brief Send control command to Core1 based on field ID
  *
- * Maps Table 4 (Control) field IDs to Core1 command mailbox commands.
+ * Maps Table 4 (Control) field IDs to Core1 command queue commands.
  * This bridges TUI edits to the physics engine running on Core1.
  *
  * @param field_id Field ID from table definition
  * @param value Parsed value (uint32_t representation)
- * @return true if command was sent, false if not a control field or mailbox full
+ * @return true if command was sent, false if not a control field or queue full
  */
-static bool tui_send_control_command(uint32_t field_id, uint32_t value) {
-    // Table 4 (Control Mode) field IDs: 401-406
+bool tui_send_control_command(uint32_t field_id, uint32_t value) {
+    // Table 4 (Control Mode) field IDs: 401-408
     switch (field_id) {
         case 401:  // mode (ENUM: CURRENT=0, SPEED=1, TORQUE=2, PWM=3)
             return core_sync_send_command(CMD_SET_MODE, (float)value, 0.0f);
@@ -411,6 +736,14 @@ static bool tui_send_control_command(uint32_t field_id, uint32_t value) {
         case 405:  // pwm_pct (U32 in %, convert to 0.0-1.0)
             return core_sync_send_command(CMD_SET_PWM, (float)value / 100.0f, 0.0f);
 
+        case 407:  // integrator (ENUM: EULER=0, SUBSTEP=1, RK4=2, FIXED=3, LUT=4), keep substeps
+            return core_sync_send_command(CMD_SET_INTEGRATOR, (float)value,
+                                          (float)table_control_get_substeps());
+
+        case 408:  // substeps (U32, 1-16), keep integrator
+            return core_sync_send_command(CMD_SET_INTEGRATOR,
+                                          (float)table_control_get_integrator(), (float)value);
+
         case 406:  // direction (ENUM: POSITIVE=0, NEGATIVE=1)
             // Direction is handled by mode commands (param2 could be used for direction)
             // For now, just update local state - physics will use sign of setpoints
@@ -452,6 +785,7 @@ static bool tui_handle_edit_input(int key) {
 
                 // Special case: "?" for ENUM and BOOL fields shows help
                 if (strcmp(g_tui_state.input_buf, "?") == 0) {
+                    usb_console_wait_idle(TUI_MODAL_WAIT_US);
                     if (field->type == FIELD_TYPE_ENUM) {
                         // Display enum help
                         printf("\nAvailable values for %s:\n", field->name);
@@ -478,16 +812,7 @@ static bool tui_handle_edit_input(int key) {
                 uint32_t value;
                 if (catalog_parse_value(field, g_tui_state.input_buf, &value)) {
                     // Valid value - write to field
-                    if (field->ptr) {
-                        // CRITICAL: For FLOAT type, use memcpy to avoid alignment issues
-                        if (field->type == FIELD_TYPE_FLOAT) {
-                            float f;
-                            memcpy(&f, &value, sizeof(float));
-                            memcpy((void*)field->ptr, &f, sizeof(float));
-                        } else {
-                            *(volatile uint32_t*)field->ptr = value;
-                        }
-
+                    if (catalog_set_value(field, value)) {
                         // Send command to Core1 if this is a control field
                         bool cmd_sent = tui_send_control_command(field->id, value);
 
@@ -520,7 +845,6 @@ static bool tui_handle_edit_input(int key) {
             if (g_tui_state.input_len > 0) {
                 g_tui_state.input_len--;
                 g_tui_state.input_buf[g_tui_state.input_len] = '\0';
-                g_tui_state.needs_refresh = true;
             }
             return true;
 
@@ -542,8 +866,7 @@ static bool tui_handle_edit_input(int key) {
                 if (accept && g_tui_state.input_len < sizeof(g_tui_state.input_buf) - 1) {
                     g_tui_state.input_buf[g_tui_state.input_len++] = (char)key;
                     g_tui_state.input_buf[g_tui_state.input_len] = '\0';
-                    g_tui_state.needs_refresh = true;
-                    return true;
+                    return true;    // Status bar only, redrawn as a changed cell
                 }
             }
             break;
@@ -559,25 +882,70 @@ static bool tui_handle_edit_input(int key) {
 // Forward declaration
 static void format_field_display_name(const char* var_name, char* buf, size_t buflen);
 
-void tui_render_browse(void) {
-    // Clear screen and home cursor
-    tui_clear_screen();
+/**
+ * @brief Format a field's current value
+ */
+static void tui_format_field_text(const field_meta_t* field, char* value_str, size_t len) {
+    uint32_t value;
 
-    // Header
-    tui_print_header();
+    if (!catalog_get_value(field, &value)) {
+        snprintf(value_str, len, "N/A");
+        return;
+    }
+    catalog_format_value(field, value, value_str, len);
+}
+
+static void tui_format_header_line(char* buf, size_t len);
+static void tui_format_status_banner(char* buf, size_t len);
+static void tui_format_status_line(char* buf, size_t len);
 
-    // Status banner (wheel state)
-    tui_print_status_banner();
+/**
+ * @brief Separator line into the current frame
+ */
+static void tui_print_rule(void) {
+    usb_console_repeat('-', CONSOLE_WIDTH);
+    usb_console_printf("\n");
+}
+
+void tui_render_browse(void) {
+    uint16_t row = 1;
+
+    g_render.valid = false;
+    g_render.overflow = false;
+    g_render.cell_count = 0;
+
+    // Clear screen and home cursor (and set up a terminal that just connected)
+    usb_console_printf(ANSI_CLEAR_SCREEN ANSI_CURSOR_HOME ANSI_CURSOR_HIDE ANSI_AUTOWRAP_OFF);
+
+    // Header (logo, title line, build line)
+    tui_format_header_line(g_render.header, sizeof(g_render.header));
+    usb_console_printf("%s\n", LOGO_ART);
+    row += g_logo_rows;
+    g_render.header_row = row;
+    usb_console_printf("%s\n", g_render.header);
+    usb_console_printf(ANSI_DIM "Build: %s %s | RP2040 Dual-Core @ 125MHz" ANSI_RESET "\n",
+           BUILD_DATE, BUILD_TIME);
+    row += 2;
+
+    // Status banner (wheel state) between separator lines
+    tui_format_status_banner(g_render.banner, sizeof(g_render.banner));
+    tui_print_rule();
+    g_render.banner_row = row + 1;
+    usb_console_printf("%s\n", g_render.banner);
+    tui_print_rule();
+    row += 3;
 
     // Table list with expand/collapse
-    printf("\n");
-    printf(ANSI_BOLD "TABLES" ANSI_RESET "\n");
-    printf("\n");
+    usb_console_printf("\n");
+    usb_console_printf(ANSI_BOLD "TABLES" ANSI_RESET "\n");
+    usb_console_printf("\n");
+    row += 3;
 
     uint8_t table_count = catalog_get_table_count();
 
     if (table_count == 0) {
-        printf("  " ANSI_DIM "(No tables registered)" ANSI_RESET "\n");
+        usb_console_printf("  " ANSI_DIM "(No tables registered)" ANSI_RESET "\n");
+        row++;
     } else {
         for (uint8_t i = 0; i < table_count; i++) {
             const table_meta_t* table = catalog_get_table_by_index(i);
@@ -588,8 +956,9 @@ void tui_render_browse(void) {
             const char* cursor = is_selected ? ANSI_REVERSE ">" ANSI_RESET : " ";
             const char* expand_icon = g_tui_state.table_expanded[i] ? "▼" : "▶";
 
-            printf("%s %2d. %s %s\n",
+            usb_console_printf("%s %2d. %s %s\n",
                    cursor, i + 1, expand_icon, table->name);
+            row++;
 
             // Fields (if expanded)
             if (g_tui_state.table_expanded[i]) {
@@ -599,47 +968,10 @@ void tui_render_browse(void) {
 
                     // Format display name and value
                     char display_name[32];
-                    char value_str[32];
+                    char value_str[TUI_CELL_TEXT_MAX];
 
                     format_field_display_name(field->name, display_name, sizeof(display_name));
-
-                    if (field->ptr) {
-                        uint32_t value;
-
-                        if (field->type == FIELD_TYPE_STRING) {
-                            // For STRING type, pass the pointer value itself (address of string)
-                            value = (uint32_t)field->ptr;
-                        } else if (field->type == FIELD_TYPE_FLOAT) {
-                            // CRITICAL: For FLOAT type, use memcpy to avoid alignment issues
-                            // The ptr points to a float, not a uint32_t. Dereferencing through
-                            // uint32_t* causes strict aliasing violations and alignment faults.
-                            float f;
-                            memcpy(&f, (const void*)field->ptr, sizeof(float));
-                            memcpy(&value, &f, sizeof(uint32_t));
-                        } else if (field->type == FIELD_TYPE_ENUM) {
-                            // CRITICAL: For ENUM types, zero-extend from actual enum size
-                            // C enums are implementation-defined size (often 1-4 bytes)
-                            // We must read only the actual enum bytes, then zero-extend to uint32_t
-                            value = 0;  // Zero-initialize
-                            // Read only 1 byte (most enums are 8-bit when values fit in 0-255)
-                            uint8_t enum_val;
-                            memcpy(&enum_val, (const void*)field->ptr, sizeof(uint8_t));
-                            value = (uint32_t)enum_val;
-                        } else if (field->type == FIELD_TYPE_BOOL) {
-                            // CRITICAL: For BOOL types, read as single byte
-                            value = 0;
-                            uint8_t bool_val;
-                            memcpy(&bool_val, (const void*)field->ptr, sizeof(uint8_t));
-                            value = (uint32_t)bool_val;
-                        } else {
-                            // For other types, dereference normally
-                            value = *field->ptr;
-                        }
-
-                        catalog_format_value(field, value, value_str, sizeof(value_str));
-                    } else {
-                        snprintf(value_str, sizeof(value_str), "N/A");
-                    }
+                    tui_format_field_text(field, value_str, sizeof(value_str));
 
                     // Highlight selected field
                     bool is_field_selected = (i == g_tui_state.selected_table_idx) &&
@@ -647,19 +979,91 @@ void tui_render_browse(void) {
                     const char* field_cursor = is_field_selected ? ANSI_REVERSE "►" ANSI_RESET : " ";
 
                     // Field line: "Display Name (var_name) : value"
-                    printf("  %s   ├─ %s " ANSI_DIM "(%s)" ANSI_RESET " : %s\n",
+                    usb_console_printf("  %s   ├─ %s " ANSI_DIM "(%s)" ANSI_RESET " : %s\n",
                            field_cursor, display_name, field->name, value_str);
+
+                    // Remember the value cell (15 columns of fixed text before it)
+                    if (g_render.cell_count < TUI_MAX_CELLS) {
+                        tui_cell_t* cell = &g_render.cells[g_render.cell_count++];
+                        size_t col = 16 + strlen(display_name) + strlen(field->name);
+                        cell->field = field;
+                        cell->row = row;
+                        cell->col = (uint8_t)((col < 255) ? col : 255);
+                        memcpy(cell->text, value_str, sizeof(cell->text));
+                    } else {
+                        g_render.overflow = true;
+                    }
+                    row++;
                 }
             }
         }
     }
 
-    // Navigation hints
-    printf("\n");
+    // Navigation hints (one line in every mode)
+    usb_console_printf("\n");
     tui_print_nav_hints();
+    row += 2;
+
+    // Status bar: blank line, separator, message line
+    tui_format_status_line(g_render.status, sizeof(g_render.status));
+    usb_console_printf("\n");
+    tui_print_rule();
+    g_render.status_row = row + 2;
+    usb_console_printf("%s\n", g_render.status);
+    row += 3;
+
+    // Park and ask where the cursor ended up (reply sets the scroll offset)
+    g_render.park_row = row;
+    g_render.awaiting_baseline = true;
+    usb_console_printf("\033[2G" ANSI_CURSOR_REPORT);
+}
 
-    // Status bar
-    tui_print_status_bar(g_tui_state.status_msg);
+/**
+ * @brief Rewrite a whole line if its text changed
+ */
+static void tui_update_line(uint16_t row, char* last, const char* text) {
+    if (strcmp(last, text) == 0) {
+        return;
+    }
+    strcpy(last, text);
+    if (row > g_render.scroll) {
+        usb_console_printf("\033[%u;1H%s" ANSI_CLEAR_TO_EOL, (unsigned)(row - g_render.scroll), text);
+    }
+}
+
+/**
+ * @brief Rewrite the cells whose text changed since the last draw
+ */
+static void tui_render_changes(void) {
+    char line[TUI_LINE_MAX];
+
+    tui_format_header_line(line, sizeof(line));
+    tui_update_line(g_render.header_row, g_render.header, line);
+
+    tui_format_status_banner(line, sizeof(line));
+    tui_update_line(g_render.banner_row, g_render.banner, line);
+
+    tui_format_status_line(line, sizeof(line));
+    tui_update_line(g_render.status_row, g_render.status, line);
+
+    for (uint16_t i = 0; i < g_render.cell_count; i++) {
+        tui_cell_t* cell = &g_render.cells[i];
+        char value_str[TUI_CELL_TEXT_MAX];
+
+        tui_format_field_text(cell->field, value_str, sizeof(value_str));
+        if (strcmp(cell->text, value_str) == 0) {
+            continue;
+        }
+        memcpy(cell->text, value_str, sizeof(cell->text));
+        if (cell->row > g_render.scroll) {
+            // The value ends its line
+            usb_console_printf("\033[%u;%uH%s" ANSI_CLEAR_TO_EOL,
+                   (unsigned)(cell->row - g_render.scroll), (unsigned)cell->col, value_str);
+        }
+    }
+
+    // Back to the parking spot, and check nothing else moved the cursor
+    usb_console_printf("\033[%u;2H" ANSI_CURSOR_REPORT, (unsigned)g_render.park_screen_row);
 }
 
 void tui_render_field_edit(const void* table, const void* field) {
@@ -674,44 +1078,42 @@ void tui_cursor_pos(uint8_t row, uint8_t col) {
     printf("\033[%d;%dH", row, col);
 }
 
-void tui_print_header(void) {
+static void tui_format_header_line(char* buf, size_t len) {
     uint32_t uptime_ms = to_ms_since_boot(get_absolute_time()) - g_boot_time_ms;
     uint32_t uptime_sec = uptime_ms / 1000;
-    char header_buf[CONSOLE_WIDTH + 1];
+
+    // "NRWA-T6 Emulator VERSION    |    Uptime: HH:MM:SS    |    Tests: N/M ✓/✗"
+    snprintf(buf, len,
+             ANSI_BOLD ANSI_FG_CYAN "NRWA-T6 Emulator " ANSI_RESET ANSI_DIM "%s" ANSI_RESET
+             "    |    "
+             "Uptime: %02lu:%02lu:%02lu"
+             "    |    "
+             "Tests: %d/%d %s",
+             FIRMWARE_VERSION,
+             uptime_sec / 3600,
+             (uptime_sec % 3600) / 60,
+             uptime_sec % 60,
+             g_test_results.total_passed,
+             g_test_results.total_tests,
+             g_test_results.all_passed ? ANSI_FG_GREEN "✓" ANSI_RESET : ANSI_FG_RED "✗" ANSI_RESET);
+}
+
+void tui_print_header(void) {
+    char header_buf[TUI_LINE_MAX];
 
     // Print logo (centered)
     printf("%s\n", LOGO_ART);
 
-    // Format header info to fit exactly 80 characters
-    // Line 1: "NRWA-T6 Emulator VERSION    |    Uptime: HH:MM:SS    |    Tests: N/M ✓/✗"
-    int written = snprintf(header_buf, sizeof(header_buf),
-                           ANSI_BOLD ANSI_FG_CYAN "NRWA-T6 Emulator " ANSI_RESET ANSI_DIM "%s" ANSI_RESET
-                           "    |    "
-                           "Uptime: %02lu:%02lu:%02lu"
-                           "    |    "
-                           "Tests: %d/%d %s",
-                           FIRMWARE_VERSION,
-                           uptime_sec / 3600,
-                           (uptime_sec % 3600) / 60,
-                           uptime_sec % 60,
-                           g_test_results.total_passed,
-                           g_test_results.total_tests,
-                           g_test_results.all_passed ? ANSI_FG_GREEN "✓" ANSI_RESET : ANSI_FG_RED "✗" ANSI_RESET);
-
-    // Print header line 1 with newline (ANSI codes don't affect terminal width)
+    // Line 1: title, uptime, test results (ANSI codes don't affect terminal width)
+    tui_format_header_line(header_buf, sizeof(header_buf));
     printf("%s\n", header_buf);
 
-    (void)written;  // Suppress unused variable warning
-
     // Line 2: Build info
     printf(ANSI_DIM "Build: %s %s | RP2040 Dual-Core @ 125MHz" ANSI_RESET "\n",
            BUILD_DATE, BUILD_TIME);
 }
 
-void tui_print_status_banner(void) {
-    // Draw separator line
-    console_print_line('-');
-
+static void tui_format_status_banner(char* buf, size_t len) {
     // Get live values from control table
     uint32_t mode = table_control_get_mode();
     const char* mode_str = table_control_get_mode_string(mode);
@@ -734,28 +1136,39 @@ void tui_print_status_banner(void) {
     char fault_buf[64];
     int fault_count = protection_format_fault_string(faults, fault_buf, sizeof(fault_buf));
 
-    // Build the status string
-    printf("Status: %s%s" ANSI_RESET " │ Mode: %s%s" ANSI_RESET " │ RPM: %s%lu" ANSI_RESET " │ Current: %s%.2fA" ANSI_RESET " │ Fault: %s",
-           status_color, status,
-           (speed_rpm == 0) ? ANSI_DIM : "", mode_str,
-           (speed_rpm == 0) ? ANSI_DIM : ANSI_FG_CYAN, (unsigned long)speed_rpm,
-           (current_ma == 0) ? ANSI_DIM : ANSI_FG_YELLOW, current_a,
-           fault_color);
-
-    // Show fault names if any faults, or "-" if none
-    if (fault_count == 0) {
-        printf("-" ANSI_RESET);
-    } else {
-        printf("%s" ANSI_RESET, fault_buf);
-    }
+    // Build the status string; fault names if any faults, or "-" if none
+    snprintf(buf, len,
+             "Status: %s%s" ANSI_RESET " │ Mode: %s%s" ANSI_RESET " │ RPM: %s%lu" ANSI_RESET " │ Current: %s%.2fA" ANSI_RESET " │ Fault: %s%s" ANSI_RESET,
+             status_color, status,
+             (speed_rpm == 0) ? ANSI_DIM : "", mode_str,
+             (speed_rpm == 0) ? ANSI_DIM : ANSI_FG_CYAN, (unsigned long)speed_rpm,
+             (current_ma == 0) ? ANSI_DIM : ANSI_FG_YELLOW, current_a,
+             fault_color,
+             (fault_count == 0) ? "-" : fault_buf);
+}
 
-    // Pad to end of line
-    printf("\n");
+void tui_print_status_banner(void) {
+    char banner_buf[TUI_LINE_MAX];
 
-    // Draw separator line
+    tui_format_status_banner(banner_buf, sizeof(banner_buf));
+    console_print_line('-');
+    printf("%s\n", banner_buf);
     console_print_line('-');
 }
 
+static void tui_format_status_line(char* buf, size_t len) {
+    buf[0] = '\0';
+    if (g_tui_state.status_msg[0]) {
+        if (g_tui_state.mode == TUI_MODE_EDIT) {
+            // In edit mode, show input buffer
+            snprintf(buf, len, ANSI_FG_YELLOW "%s" ANSI_RESET ANSI_BOLD "%s" ANSI_RESET "_",
+                     g_tui_state.status_msg, g_tui_state.input_buf);
+        } else {
+            snprintf(buf, len, ANSI_FG_YELLOW "%s" ANSI_RESET, g_tui_state.status_msg);
+        }
+    }
+}
+
 void tui_print_status_bar(const char* message) {
     printf("\n");
     console_print_line('-');
@@ -773,10 +1186,11 @@ void tui_print_status_bar(const char* message) {
 void tui_print_nav_hints(void) {
     switch (g_tui_state.mode) {
         case TUI_MODE_BROWSE:
-            printf(ANSI_DIM "↑↓ : Navigate | → : Expand | ← : Collapse | T : Test Modes | R : Refresh | Q : Quit" ANSI_RESET "\n");
+            usb_console_printf(ANSI_DIM "↑↓ : Navigate | → : Expand | ← : Collapse | T : Test Modes | P : Profiler | H : Trends | L : Library | R : Refresh | Q : Quit" ANSI_RESET "\n");
             break;
 
         default:
+            usb_console_printf("\n");  // Keep the status bar on the same row
             break;
     }
 }
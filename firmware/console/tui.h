@@ -28,6 +28,9 @@
 #define ANSI_CURSOR_UP(n)       "\033[" #n "A"
 #define ANSI_CURSOR_DOWN(n)     "\033[" #n "B"
 #define ANSI_CURSOR_POS(row,col) "\033[" #row ";" #col "H"
+#define ANSI_CURSOR_REPORT      "\033[6n"    // Terminal replies ESC [ row ; col R
+#define ANSI_AUTOWRAP_OFF       "\033[?7l"
+#define ANSI_AUTOWRAP_ON        "\033[?7h"
 
 // Text attributes
 #define ANSI_RESET              "\033[0m"
@@ -80,7 +83,7 @@ typedef struct {
     tui_mode_t mode;                // Current display mode
     uint8_t selected_table_idx;     // Currently selected table (0-N)
     uint8_t selected_field_idx;     // Currently selected field within table (0 if table collapsed)
-    bool table_expanded[16];        // Expansion state for each table (max 16 tables)
+    bool table_expanded[CATALOG_MAX_TABLES];  // Expansion state for each table
     bool needs_refresh;             // Redraw screen on next update
     char input_buf[128];            // Input buffer for commands/editing
     uint8_t input_len;              // Current input length
@@ -101,13 +104,24 @@ void tui_init(void);
 /**
  * @brief Update TUI display (call from main loop)
  *
- * Refreshes the current view without scrolling. Uses ANSI cursor positioning
- * to update values in place.
+ * Refreshes the current view without scrolling. After navigation
+ * (needs_refresh) the screen is cleared and redrawn; otherwise only the
+ * values whose text changed since they were drawn are rewritten in place
+ * with ANSI cursor positioning.
+ *
+ * Output is one non-blocking usb_console frame. Nothing is rendered while
+ * no host has the port open; an update that comes while the previous frame
+ * is still draining is deferred to tui_poll().
  *
  * @param force_redraw If true, clear and redraw entire screen
  */
 void tui_update(bool force_redraw);
 
+/**
+ * @brief Run an update deferred by output backpressure (call every loop)
+ */
+void tui_poll(void);
+
 /**
  * @brief Handle keyboard input (non-blocking)
  *
@@ -118,6 +132,17 @@ void tui_update(bool force_redraw);
  */
 bool tui_handle_input(void);
 
+/**
+ * @brief Forward a written Table 4 (Control) field to Core1
+ *
+ * Call after storing a new value in a control field (TUI edit or batch set).
+ *
+ * @param field_id Field ID (401-408)
+ * @param value Stored raw value
+ * @return true if a command was sent, false if not a control field or queue full
+ */
+bool tui_send_control_command(uint32_t field_id, uint32_t value);
+
 /**
  * @brief Shutdown TUI (restore terminal state)
  *
@@ -134,6 +159,10 @@ void tui_shutdown(void);
  *
  * **NEW DESIGN**: Single unified view with arrow navigation.
  *
+ * Full redraw: also records where each live value was drawn, so later
+ * tui_update(false) calls can rewrite just the values that changed.
+ * Writes into the usb_console frame opened by tui_update().
+ *
  * Layout:
  * ┌─ Header: Title | Uptime | Tests ────────────────┐
  * ├─ Status: ON/OFF | Mode | RPM | Current | Fault ─┤
@@ -208,7 +237,7 @@ void tui_print_status_banner(void);
 void tui_print_status_bar(const char* message);
 
 /**
- * @brief Print navigation hints based on current mode
+ * @brief Print navigation hints based on current mode (into the current frame)
  */
 void tui_print_nav_hints(void);
 
@@ -7,424 +7,431 @@
 #include "nss_nrwa_t6_regs.h"
 #include "nss_nrwa_t6_telemetry.h"
 #include "nss_nrwa_t6_protection.h"
+#include "hot_path.h"
 #include "fixedpoint.h"
 #include "unaligned.h"
 #include "util/core_sync.h"
+#include "config/scenario.h"
+#include "timebase.h"
+#include "pico/platform.h"
+#include "dlog.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
 
-// Debug flag (set to false to disable verbose command logging)
+// Debug flag (set to false to disable verbose command logging). Handlers
+// run from the NSP service IRQ, so they log through the deferred ring only
 static bool debug_commands = false;
 
 // ============================================================================
 // Global State
 // ============================================================================
 
-static wheel_state_t* g_wheel_state = NULL;
-
-// Response buffer (max telemetry block size ~60 bytes)
-static uint8_t response_buffer[128];
+static wheel_state_t* wheel_states = NULL;   // Array of wheel_count wheels
+static uint8_t wheel_count = 0;
+static uint8_t cmd_wheel = 0;                 // Wheel addressed by the current command (or CORE_SYNC_WHEEL_ALL)
+static wheel_state_t* g_wheel_state = NULL;   // State read by the current command (wheel 0 for broadcast)
+
+// Response buffer (longest reply: PEEK of the whole map or MULTI-TELEMETRY)
+static uint8_t response_buffer[160];
+_Static_assert(sizeof(response_buffer) >= MULTI_TELEM_MAX_REPLY, "MULTI-TELEMETRY reply must fit");
+
+// APP-TELEM reply cache: one entry per (wheel, block), valid for a single
+// Core1 block publish. Repeat polls between two publishes reuse the copied
+// block and, when the request header matches, the finished frame.
+typedef struct {
+    uint32_t seq;                       // Block generation the bytes were copied from (0 = empty)
+    uint16_t len;                       // Encoded block length
+    uint8_t data[TELEM_MAX_BLOCK_SIZE]; // Encoded block
+    cmd_reply_frame_t frame;            // Finished reply (filled by the NSP handler)
+} telem_cache_entry_t;
+
+static telem_cache_entry_t telem_cache[EMULATED_WHEEL_COUNT][TELEM_BLOCK_COUNT];
+static uint32_t telem_cache_hits = 0;
+static uint32_t telem_cache_misses = 0;
+
+// MULTI-TELEMETRY extension: opt-in, and a whole block set copied per request
+static volatile bool multi_telem_enabled = false;
+static telemetry_blocks_t multi_telem_copy;
+
+// Per-command execution statistics (indexed by command code)
+static cmd_latency_stats_t cmd_stats[NSP_CMD_TABLE_SIZE];
+static uint32_t cmd_unknown_count = 0;
 
 // ============================================================================
 // Helper Functions
 // ============================================================================
 
+/**
+ * @brief Queue a Core1 command for the wheel(s) the current command targets
+ */
+static bool HOT_PATH_FUNC(send_to_wheel)(command_type_t type, float param1, float param2) {
+    return core_sync_send_wheel_command(cmd_wheel, type, param1, param2);
+}
+
 /**
  * @brief Build ACK response with no data
  */
-static void build_ack(cmd_result_t* result) {
+static void HOT_PATH_FUNC(build_ack)(cmd_result_t* result) {
     result->status = CMD_ACK;
     result->data = NULL;
     result->data_len = 0;
+    result->frame_cache = NULL;
 }
 
 /**
  * @brief Build NACK response
  */
-static void build_nack(cmd_result_t* result) {
+static void HOT_PATH_FUNC(build_nack)(cmd_result_t* result) {
     result->status = CMD_NACK;
     result->data = NULL;
     result->data_len = 0;
+    result->frame_cache = NULL;
 }
 
 /**
  * @brief Build ACK response with data payload
  */
-static void build_ack_with_data(cmd_result_t* result, const uint8_t* data, uint16_t len) {
+static void HOT_PATH_FUNC(build_ack_with_data)(cmd_result_t* result, const uint8_t* data, uint16_t len) {
     result->status = CMD_ACK;
     memcpy(response_buffer, data, len);
     result->data = response_buffer;
     result->data_len = len;
+    result->frame_cache = NULL;
 }
 
+// ============================================================================
+// ICD Register Map
+// ============================================================================
+
+// ICD Table 11-1 defines the Initialized Parameters address space (0x00-0x30)
+// as contiguous 4-byte registers, so the map is indexed by address / 4 and a
+// PEEK/POKE range is a slice of it. Reads act on one copy of g_wheel_state;
+// writes encode one Core1 command each, queued to the wheel(s) in cmd_wheel.
+
+typedef uint32_t (*icd_reg_read_fn)(const wheel_state_t* state);
+typedef bool (*icd_reg_write_fn)(uint32_t value, command_mailbox_t* cmd);
+
 /**
- * @brief Validate register address and count
- *
- * @param addr Starting register address
- * @param count Number of registers
- * @param write true if write operation (check read-only)
- * @return true if valid
+ * @brief ICD register accessors (write is NULL for read-only registers)
  */
-static bool validate_register_access(uint16_t addr, uint8_t count, bool write) {
-    // Register map address ranges:
-    // 0x0000-0x00FF: Device Information (read-only)
-    // 0x0100-0x01FF: Protection Configuration (read/write)
-    // 0x0200-0x02FF: Control Registers (read/write)
-    // 0x0300-0x03FF: Status Registers (read-only)
-    // 0x0400-0x04FF: Fault & Diagnostic Registers (read/write)
-
-    // Check if entire access range is within valid address space
-    if (addr + (count * 4) > 0x0500) {
-        return false;  // Out of register map range
-    }
+typedef struct {
+    icd_reg_read_fn read;
+    icd_reg_write_fn write;
+} icd_reg_entry_t;
+
+static uint32_t HOT_PATH_FUNC(icd_read_device_id)(const wheel_state_t* state) {
+    (void)state;
+    return 0x4E525754;  // "NRWT" in ASCII
+}
 
-    // Check read-only regions if write operation
-    if (write) {
-        // Device Information (0x0000-0x00FF) is read-only
-        if (addr >= 0x0000 && addr < 0x0100) {
-            return false;
-        }
-        // Status Registers (0x0300-0x03FF) are read-only
-        if (addr >= 0x0300 && addr < 0x0400) {
-            return false;
-        }
-    }
+static uint32_t HOT_PATH_FUNC(icd_read_firmware_version)(const wheel_state_t* state) {
+    (void)state;
+    return 0x00010000;  // v1.0.0 in BCD
+}
 
-    return true;
+static uint32_t HOT_PATH_FUNC(icd_read_control_mode)(const wheel_state_t* state) {
+    return (uint32_t)index_to_icd_mode(state->mode);  // Current mode as ICD bitmask
 }
 
-/**
- * @brief Read register value from wheel state
- *
- * @param addr Register address
- * @param value Pointer to output value (4 bytes, little-endian)
- * @return true if successful
- */
-static bool read_register(uint16_t addr, uint8_t* value) {
-    // Map register addresses to wheel state fields
-    // For Phase 6, implement key registers only
-
-    switch (addr) {
-        // Device Information Registers (read-only)
-        case REG_DEVICE_ID:
-            write_u32_le(value, 0x4E525754);  // "NRWT" in ASCII
-            return true;
-
-        case REG_FIRMWARE_VERSION:
-            write_u32_le(value, 0x00000100);  // v0.1.0 in BCD
-            return true;
-
-        case REG_HARDWARE_REVISION:
-            write_u16_le(value, 0x0001);  // Hardware rev 1
-            return true;
-
-        case REG_SERIAL_NUMBER:
-            write_u32_le(value, 0x00000001);  // Serial #1
-            return true;
-
-        // Fault/Warning Status
-        case REG_FAULT_STATUS:
-            write_u32_le(value, g_wheel_state->fault_status);
-            return true;
-
-        case REG_FAULT_LATCH:
-            write_u32_le(value, g_wheel_state->fault_latch);
-            return true;
-
-        case REG_WARNING_STATUS:
-            write_u32_le(value, g_wheel_state->warning_status);
-            return true;
-
-        // Control Mode
-        case REG_CONTROL_MODE:
-            write_u32_le(value, (uint32_t)g_wheel_state->mode);
-            return true;
-
-        // Current State (Status Registers)
-        case REG_CURRENT_SPEED_RPM:
-            write_u32_le(value, float_to_uq14_18(wheel_model_get_speed_rpm(g_wheel_state)));
-            return true;
-
-        case REG_CURRENT_CURRENT_MA:
-            write_u32_le(value, float_to_uq18_14(g_wheel_state->current_out_a * 1000.0f));
-            return true;
-
-        case REG_CURRENT_TORQUE_MNM:
-            write_u32_le(value, float_to_uq18_14(g_wheel_state->torque_out_mnm));
-            return true;
-
-        case REG_CURRENT_POWER_MW:
-            write_u32_le(value, float_to_uq18_14(g_wheel_state->power_w * 1000.0f));
-            return true;
-
-        case REG_CURRENT_MOMENTUM_NMS:
-            write_u32_le(value, float_to_uq18_14(g_wheel_state->momentum_nms * 1000.0f));
-            return true;
+static uint32_t HOT_PATH_FUNC(icd_read_speed_setpoint)(const wheel_state_t* state) {
+    return float_to_uq14_18(state->speed_cmd_rpm);  // Q14.18 RPM
+}
 
-        default:
-            // Unknown register
-            return false;
-    }
+static uint32_t HOT_PATH_FUNC(icd_read_current_setpoint)(const wheel_state_t* state) {
+    return float_to_uq14_18(state->current_cmd_a * 1000.0f);  // Q14.18 mA
 }
 
-// ============================================================================
-// ICD Register Address Translation
-// ============================================================================
+static uint32_t HOT_PATH_FUNC(icd_read_torque_setpoint)(const wheel_state_t* state) {
+    return float_to_q10_22(state->torque_cmd_mnm);  // Q10.22 mN-m
+}
 
-/**
- * @brief Map ICD 8-bit address to internal register and read
- *
- * ICD Table 11-1 defines the Initialized Parameters address space (0x00-0x30).
- * This function translates ICD addresses to our internal register map.
- *
- * @param icd_addr ICD 8-bit address (0x00-0x30)
- * @param value Pointer to output buffer (4 bytes, little-endian)
- * @return true if successful
- */
-static bool read_register_icd(uint8_t icd_addr, uint8_t* value) {
-    // Map ICD addresses to internal registers
-    // ICD uses contiguous 4-byte addresses (0x00, 0x04, 0x08, etc.)
-    switch (icd_addr) {
-        // Device Information
-        case 0x00:  // Device ID
-            write_u32_le(value, 0x4E525754);  // "NRWT" in ASCII
-            return true;
-
-        case 0x04:  // Firmware version
-            write_u32_le(value, 0x00010000);  // v1.0.0 in BCD
-            return true;
-
-        case 0x08:  // Control mode (current mode as ICD bitmask)
-            write_u32_le(value, (uint32_t)index_to_icd_mode(g_wheel_state->mode));
-            return true;
-
-        case 0x0C:  // Speed setpoint (Q14.18 RPM)
-            write_u32_le(value, float_to_uq14_18(g_wheel_state->speed_cmd_rpm));
-            return true;
-
-        case 0x10:  // Current setpoint (Q14.18 mA)
-            write_u32_le(value, float_to_uq14_18(g_wheel_state->current_cmd_a * 1000.0f));
-            return true;
-
-        case 0x14:  // Torque setpoint (Q10.22 mN-m)
-            write_u32_le(value, float_to_q10_22(g_wheel_state->torque_cmd_mnm));
-            return true;
-
-        case 0x18:  // PWM duty cycle
-            {
-                int16_t pwm_raw = (int16_t)(g_wheel_state->pwm_duty_pct * 5.12f);
-                if (g_wheel_state->direction == DIRECTION_NEGATIVE) pwm_raw = -pwm_raw;
-                write_u32_le(value, (uint32_t)(int32_t)pwm_raw);
-            }
-            return true;
+static uint32_t HOT_PATH_FUNC(icd_read_pwm_duty)(const wheel_state_t* state) {
+    int16_t pwm_raw = (int16_t)(state->pwm_duty_pct * 5.12f);
+    if (state->direction == DIRECTION_NEGATIVE) pwm_raw = -pwm_raw;
+    return (uint32_t)(int32_t)pwm_raw;
+}
 
-        case 0x1C:  // Fault status
-            write_u32_le(value, g_wheel_state->fault_status | g_wheel_state->fault_latch);
-            return true;
+static uint32_t HOT_PATH_FUNC(icd_read_fault_status)(const wheel_state_t* state) {
+    return state->fault_status | state->fault_latch;
+}
 
-        case 0x20:  // Warning status
-            write_u32_le(value, g_wheel_state->warning_status);
-            return true;
+static uint32_t HOT_PATH_FUNC(icd_read_warning_status)(const wheel_state_t* state) {
+    return state->warning_status;
+}
 
-        case 0x24:  // Current measurement (Q20.12 mA)
-            write_u32_le(value, float_to_q20_12(g_wheel_state->current_out_a * 1000.0f));
-            return true;
+static uint32_t HOT_PATH_FUNC(icd_read_current_measured)(const wheel_state_t* state) {
+    return float_to_q20_12(state->current_out_a * 1000.0f);  // Q20.12 mA
+}
 
-        case 0x28:  // Speed measurement (Q24.8 RPM)
-            write_u32_le(value, float_to_q24_8(wheel_model_get_speed_rpm(g_wheel_state)));
-            return true;
+static uint32_t HOT_PATH_FUNC(icd_read_speed_measured)(const wheel_state_t* state) {
+    return float_to_q24_8(wheel_model_get_speed_rpm(state));  // Q24.8 RPM
+}
 
-        case 0x2C:  // Protection enable mask
-            write_u32_le(value, g_wheel_state->protection_enable);
-            return true;
+static uint32_t HOT_PATH_FUNC(icd_read_protection_enable)(const wheel_state_t* state) {
+    return state->protection_enable;
+}
 
-        case 0x30:  // LCL status (bit 0 = tripped)
-            write_u32_le(value, g_wheel_state->lcl_tripped ? 1 : 0);
-            return true;
+static uint32_t HOT_PATH_FUNC(icd_read_lcl_status)(const wheel_state_t* state) {
+    return state->lcl_tripped ? 1 : 0;  // Bit 0 = tripped
+}
 
-        default:
-            // Unknown ICD address
-            return false;
+static bool HOT_PATH_FUNC(icd_write_control_mode)(uint32_t value, command_mailbox_t* cmd) {
+    uint8_t mode_index = icd_mode_to_index((uint8_t)value);
+    if (mode_index == 0xFF && value != ICD_MODE_IDLE) {
+        return false;  // Invalid mode
     }
+    cmd->type = CMD_SET_MODE;
+    cmd->param1 = (float)mode_index;
+    return true;
 }
 
-/**
- * @brief Map ICD 8-bit address to internal register and write
- *
- * @param icd_addr ICD 8-bit address (0x00-0x30)
- * @param value 32-bit value to write
- * @return true if successful
- */
-static bool write_register_icd(uint8_t icd_addr, uint32_t value) {
-    // Use blocking version with retry for reliable delivery to Core1
-    switch (icd_addr) {
-        case 0x08:  // Control mode - send to Core1
-            {
-                uint8_t mode_index = icd_mode_to_index((uint8_t)value);
-                if (mode_index == 0xFF && value != ICD_MODE_IDLE) {
-                    return false;  // Invalid mode
-                }
-                return core_sync_send_command_blocking(CMD_SET_MODE, (float)mode_index, 0.0f, 0);
-            }
+static bool HOT_PATH_FUNC(icd_write_speed_setpoint)(uint32_t value, command_mailbox_t* cmd) {
+    cmd->type = CMD_SET_SPEED;
+    cmd->param1 = uq14_18_to_float(value);
+    return true;
+}
 
-        case 0x0C:  // Speed setpoint - send to Core1
-            {
-                float speed_rpm = uq14_18_to_float(value);
-                return core_sync_send_command_blocking(CMD_SET_SPEED, speed_rpm, 0.0f, 0);
-            }
+static bool HOT_PATH_FUNC(icd_write_current_setpoint)(uint32_t value, command_mailbox_t* cmd) {
+    // Convert mA to A
+    cmd->type = CMD_SET_CURRENT;
+    cmd->param1 = uq14_18_to_float(value) / 1000.0f;
+    return true;
+}
 
-        case 0x10:  // Current setpoint - send to Core1 (convert mA to A)
-            {
-                float current_a = uq14_18_to_float(value) / 1000.0f;
-                return core_sync_send_command_blocking(CMD_SET_CURRENT, current_a, 0.0f, 0);
-            }
+static bool HOT_PATH_FUNC(icd_write_torque_setpoint)(uint32_t value, command_mailbox_t* cmd) {
+    cmd->type = CMD_SET_TORQUE;
+    cmd->param1 = q10_22_to_float(value);
+    return true;
+}
 
-        case 0x14:  // Torque setpoint - send to Core1
-            {
-                float torque_mnm = q10_22_to_float(value);
-                return core_sync_send_command_blocking(CMD_SET_TORQUE, torque_mnm, 0.0f, 0);
-            }
+static bool HOT_PATH_FUNC(icd_write_pwm_duty)(uint32_t value, command_mailbox_t* cmd) {
+    int32_t signed_val = (int32_t)value;
+    cmd->type = CMD_SET_PWM;
+    cmd->param1 = (float)(abs(signed_val) & 0x1FF) / 5.12f;
+    return true;
+}
 
-        case 0x18:  // PWM duty cycle - send to Core1
-            {
-                int32_t signed_val = (int32_t)value;
-                float duty_pct = (float)(abs(signed_val) & 0x1FF) / 5.12f;
-                return core_sync_send_command_blocking(CMD_SET_PWM, duty_pct, 0.0f, 0);
-            }
+static bool HOT_PATH_FUNC(icd_write_protection_enable)(uint32_t value, command_mailbox_t* cmd) {
+    // Queued like CONFIGURE-PROTECTION, in order with the other NSP writes
+    uint32_t enable_mask = value & 0x1F;
+    cmd->type = CMD_CONFIG_PROTECTION;
+    memcpy(&cmd->param1, &enable_mask, sizeof(float));
+    return true;
+}
 
-        case 0x2C:  // Protection enable mask (direct write, no Core1 sync needed)
-            g_wheel_state->protection_enable = value & 0x1F;
-            return true;
+// Kept in SRAM next to the handlers that index it on every PEEK/POKE
+static const icd_reg_entry_t __not_in_flash("commands") icd_reg_map[ICD_REG_COUNT] = {
+    [ICD_REG_DEVICE_ID         / ICD_REG_SIZE] = { icd_read_device_id,         NULL },
+    [ICD_REG_FIRMWARE_VERSION  / ICD_REG_SIZE] = { icd_read_firmware_version,  NULL },
+    [ICD_REG_CONTROL_MODE      / ICD_REG_SIZE] = { icd_read_control_mode,      icd_write_control_mode },
+    [ICD_REG_SPEED_SETPOINT    / ICD_REG_SIZE] = { icd_read_speed_setpoint,    icd_write_speed_setpoint },
+    [ICD_REG_CURRENT_SETPOINT  / ICD_REG_SIZE] = { icd_read_current_setpoint,  icd_write_current_setpoint },
+    [ICD_REG_TORQUE_SETPOINT   / ICD_REG_SIZE] = { icd_read_torque_setpoint,   icd_write_torque_setpoint },
+    [ICD_REG_PWM_DUTY          / ICD_REG_SIZE] = { icd_read_pwm_duty,          icd_write_pwm_duty },
+    [ICD_REG_FAULT_STATUS      / ICD_REG_SIZE] = { icd_read_fault_status,      NULL },
+    [ICD_REG_WARNING_STATUS    / ICD_REG_SIZE] = { icd_read_warning_status,    NULL },
+    [ICD_REG_CURRENT_MEASURED  / ICD_REG_SIZE] = { icd_read_current_measured,  NULL },
+    [ICD_REG_SPEED_MEASURED    / ICD_REG_SIZE] = { icd_read_speed_measured,    NULL },
+    [ICD_REG_PROTECTION_ENABLE / ICD_REG_SIZE] = { icd_read_protection_enable, icd_write_protection_enable },
+    [ICD_REG_LCL_STATUS        / ICD_REG_SIZE] = { icd_read_lcl_status,        NULL },
+};
 
-        // Read-only registers
-        case 0x00:  // Device ID
-        case 0x04:  // Firmware version
-        case 0x1C:  // Fault status
-        case 0x20:  // Warning status
-        case 0x24:  // Current measurement
-        case 0x28:  // Speed measurement
-        case 0x30:  // LCL status
-            return false;  // Read-only
+/**
+ * @brief Validate an ICD register range with a single bounds check
+ *
+ * @param addr Starting ICD address (multiple of ICD_REG_SIZE)
+ * @param count Number of consecutive registers (>= 1)
+ * @param write true if write operation (every register must be writable)
+ * @return true if valid
+ */
+static bool HOT_PATH_FUNC(validate_register_access)(uint8_t addr, uint8_t count, bool write) {
+    if ((addr % ICD_REG_SIZE) != 0 || count == 0) {
+        return false;
+    }
 
-        default:
-            return false;  // Unknown address
+    // Whole range must lie inside the map
+    uint32_t first = addr / ICD_REG_SIZE;
+    if (first + count > ICD_REG_COUNT) {
+        return false;
+    }
+
+    if (write) {
+        for (uint32_t i = first; i < first + count; i++) {
+            if (icd_reg_map[i].write == NULL) {
+                return false;  // Read-only register in range
+            }
+        }
     }
+
+    return true;
 }
 
 /**
- * @brief Write register value to wheel state (internal 16-bit addresses)
+ * @brief Read a validated ICD register range of the current wheel
+ *
+ * Every register comes from one copy of the wheel state taken between two
+ * Core1 ticks, so a bulk PEEK never mixes values from different ticks.
  *
- * @param addr Register address
- * @param value Pointer to value (4 bytes, little-endian)
- * @return true if successful
+ * @param addr Starting ICD address
+ * @param count Number of registers
+ * @param out Output buffer (count * ICD_REG_SIZE bytes, little-endian)
  */
-static bool write_register(uint16_t addr, const uint8_t* value) {
-    // Use unaligned-safe read function
-    uint32_t val32 = read_u32_le(value);
-    printf("[DEBUG] write_register: addr=0x%04X, val32=0x%08X\n", addr, val32);
-
-    // CRITICAL: Send commands to Core1 via command mailbox instead of
-    // modifying Core0's wheel_state copy. Core1 is the source of truth!
-    // Use blocking version with retry for reliable delivery
-    switch (addr) {
-        case REG_CONTROL_MODE:
-            printf("[DEBUG] REG_CONTROL_MODE: sending CMD_SET_MODE to Core1\n");
-            if (val32 <= CONTROL_MODE_PWM) {
-                bool sent = core_sync_send_command_blocking(CMD_SET_MODE, (float)val32, 0.0f, 0);
-                printf("[DEBUG] CMD_SET_MODE sent=%d\n", sent);
-                return sent;
-            }
-            printf("[DEBUG] Invalid mode value %u\n", val32);
-            return false;
+static void HOT_PATH_FUNC(read_register_range)(uint8_t addr, uint8_t count, uint8_t* out) {
+    static wheel_state_t view;  // Too large for the IRQ stack
+    core_sync_copy_wheel_state(g_wheel_state, &view);
 
-        case REG_SPEED_SETPOINT_RPM:
-            printf("[DEBUG] REG_SPEED_SETPOINT_RPM: sending CMD_SET_SPEED to Core1\n");
-            return core_sync_send_command_blocking(CMD_SET_SPEED, uq14_18_to_float(val32), 0.0f, 0);
-
-        case REG_CURRENT_SETPOINT_MA:
-            printf("[DEBUG] REG_CURRENT_SETPOINT_MA: sending CMD_SET_CURRENT to Core1\n");
-            return core_sync_send_command_blocking(CMD_SET_CURRENT, uq18_14_to_float(val32) / 1000.0f, 0.0f, 0);
-
-        case REG_TORQUE_SETPOINT_MNM:
-            printf("[DEBUG] REG_TORQUE_SETPOINT_MNM: sending CMD_SET_TORQUE to Core1\n");
-            return core_sync_send_command_blocking(CMD_SET_TORQUE, uq18_14_to_float(val32), 0.0f, 0);
-
-        case REG_PWM_DUTY_CYCLE:
-            printf("[DEBUG] REG_PWM_DUTY_CYCLE: sending CMD_SET_PWM to Core1\n");
-            return core_sync_send_command_blocking(CMD_SET_PWM, uq16_16_to_float(val32), 0.0f, 0);
-
-        case REG_DIRECTION:
-            printf("[DEBUG] REG_DIRECTION: value %u (not sent as separate command)\n", val32);
-            // Direction is encoded in sign of setpoints, not a separate command
-            // Update local state for display only
-            if (val32 <= DIRECTION_NEGATIVE) {
-                wheel_model_set_direction(g_wheel_state, (direction_t)val32);
-                return true;
-            }
-            return false;
+    const icd_reg_entry_t* reg = &icd_reg_map[addr / ICD_REG_SIZE];
+    for (uint8_t i = 0; i < count; i++) {
+        write_u32_le(&out[i * ICD_REG_SIZE], reg[i].read(&view));
+    }
+}
 
-        default:
-            // Unknown or read-only register
+/**
+ * @brief Write a validated ICD register range of the targeted wheel(s)
+ *
+ * Every value is checked and encoded first; the commands then go to Core1
+ * in address order with one all-or-none enqueue (non-blocking, applied
+ * together on the next tick), so a range is never half-written.
+ *
+ * @param addr Starting ICD address
+ * @param count Number of registers
+ * @param values Packed values (count * ICD_REG_SIZE bytes, little-endian)
+ * @return false if a value was rejected or the command queue lacked room
+ *         for the whole range (nothing written in either case)
+ */
+_Static_assert(ICD_REG_COUNT <= CORE_SYNC_CMD_QUEUE_DEPTH,
+               "a full-map POKE must fit in the command queue");
+
+static bool HOT_PATH_FUNC(write_register_range)(uint8_t addr, uint8_t count, const uint8_t* values) {
+    command_mailbox_t cmds[ICD_REG_COUNT] = { 0 };
+    const icd_reg_entry_t* reg = &icd_reg_map[addr / ICD_REG_SIZE];
+    for (uint8_t i = 0; i < count; i++) {
+        if (!reg[i].write(read_u32_le(&values[i * ICD_REG_SIZE]), &cmds[i])) {
             return false;
+        }
     }
+    return core_sync_send_wheel_commands(cmd_wheel, cmds, count);
 }
 
+// ============================================================================
+// Command Dispatch Table
+// ============================================================================
+
+typedef void (*cmd_handler_fn)(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result);
+
+// Indexed by command code; unassigned codes are NULL and NACKed
+static const cmd_handler_fn __not_in_flash("commands") cmd_handlers[NSP_CMD_TABLE_SIZE] = {
+    [NSP_CMD_PING]                  = cmd_ping,
+    [NSP_CMD_PEEK]                  = cmd_peek,
+    [NSP_CMD_POKE]                  = cmd_poke,
+    [NSP_CMD_APPLICATION_TELEMETRY] = cmd_application_telemetry,
+    [NSP_CMD_APPLICATION_COMMAND]   = cmd_application_command,
+    [NSP_CMD_CLEAR_FAULT]           = cmd_clear_fault,
+    [NSP_CMD_CONFIGURE_PROTECTION]  = cmd_configure_protection,
+    [NSP_CMD_TRIP_LCL]              = cmd_trip_lcl,
+    [NSP_CMD_SIM_STEP]              = cmd_sim_step,
+    [NSP_CMD_MULTI_TELEMETRY]       = cmd_multi_telemetry,
+};
+
 // ============================================================================
 // Command Handler API
 // ============================================================================
 
-void commands_init(wheel_state_t* state) {
-    g_wheel_state = state;
-    printf("[COMMANDS] Initialized with wheel state at %p\n", (void*)state);
+void commands_get_telem_cache_stats(uint32_t* hits, uint32_t* misses) {
+    if (hits) *hits = telem_cache_hits;
+    if (misses) *misses = telem_cache_misses;
 }
 
-bool commands_dispatch(uint8_t command, const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
-    if (g_wheel_state == NULL) {
-        printf("[COMMANDS] ERROR: Not initialized\n");
-        build_nack(result);
+bool commands_get_latency_stats(uint8_t command, cmd_latency_stats_t* stats) {
+    if (command >= NSP_CMD_TABLE_SIZE || cmd_handlers[command] == NULL) {
         return false;
     }
+    if (stats) *stats = cmd_stats[command];
+    return true;
+}
 
-    switch (command) {
-        case NSP_CMD_PING:
-            cmd_ping(payload, payload_len, result);
-            return true;
+void commands_set_multi_telem_enabled(bool enabled) {
+    multi_telem_enabled = enabled;
+}
 
-        case NSP_CMD_PEEK:
-            cmd_peek(payload, payload_len, result);
-            return true;
+bool commands_get_multi_telem_enabled(void) {
+    return multi_telem_enabled;
+}
 
-        case NSP_CMD_POKE:
-            cmd_poke(payload, payload_len, result);
-            return true;
+uint32_t commands_get_unknown_count(void) {
+    return cmd_unknown_count;
+}
 
-        case NSP_CMD_APPLICATION_TELEMETRY:
-            cmd_application_telemetry(payload, payload_len, result);
-            return true;
+void commands_reset_latency_stats(void) {
+    memset(cmd_stats, 0, sizeof(cmd_stats));
+    cmd_unknown_count = 0;
+}
 
-        case NSP_CMD_APPLICATION_COMMAND:
-            cmd_application_command(payload, payload_len, result);
-            return true;
+void commands_init(wheel_state_t* state) {
+    commands_init_wheels(state, 1);
+}
 
-        case NSP_CMD_CLEAR_FAULT:
-            cmd_clear_fault(payload, payload_len, result);
-            return true;
+void commands_init_wheels(wheel_state_t* states, uint8_t count) {
+    wheel_states = states;
+    wheel_count = count;
+    cmd_wheel = 0;
+    g_wheel_state = states;
+    memset(telem_cache, 0, sizeof(telem_cache));
+    telem_cache_hits = 0;
+    telem_cache_misses = 0;
+    commands_reset_latency_stats();
+    printf("[COMMANDS] Initialized with %u wheel state(s) at %p\n", count, (void*)states);
+}
 
-        case NSP_CMD_CONFIGURE_PROTECTION:
-            cmd_configure_protection(payload, payload_len, result);
-            return true;
+bool HOT_PATH_FUNC(commands_dispatch)(uint8_t command, const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
+    return commands_dispatch_wheel(0, command, payload, payload_len, result);
+}
 
-        case NSP_CMD_TRIP_LCL:
-            cmd_trip_lcl(payload, payload_len, result);
-            return true;
+bool HOT_PATH_FUNC(commands_dispatch_wheel)(uint8_t wheel, uint8_t command, const uint8_t* payload,
+                                            uint16_t payload_len, cmd_result_t* result) {
+    result->frame_cache = NULL;
 
-        default:
-            printf("[COMMANDS] Unknown command: 0x%02X\n", command);
-            build_nack(result);
-            return false;
+    if (wheel_states == NULL) {
+        if (debug_commands) DLOG("[COMMANDS] ERROR: Not initialized\n");
+        build_nack(result);
+        return false;
+    }
+    if (wheel >= wheel_count && wheel != CORE_SYNC_WHEEL_ALL) {
+        if (debug_commands) DLOG("[COMMANDS] ERROR: No wheel %u\n", wheel);
+        build_nack(result);
+        return false;
+    }
+
+    // Handlers below act on cmd_wheel; reads use the first targeted wheel
+    cmd_wheel = wheel;
+    g_wheel_state = &wheel_states[(wheel == CORE_SYNC_WHEEL_ALL) ? 0 : wheel];
+
+    // Events waiting on this command fire first, so a transport injection
+    // applies to this very reply; one load when none waits
+    if (scenario_nsp_cmd_wanted(command)) {
+        scenario_nsp_command(command);
+    }
+
+    cmd_handler_fn handler = (command < NSP_CMD_TABLE_SIZE) ? cmd_handlers[command] : NULL;
+    if (handler == NULL) {
+        cmd_unknown_count++;
+        DLOG("[COMMANDS] Unknown command: 0x%02X\n", command);
+        build_nack(result);
+        return false;
     }
+
+    uint32_t start = timebase_get_cycles();
+    handler(payload, payload_len, result);
+    uint32_t cycles = (timebase_get_cycles() - start) & TIMEBASE_CYCLE_MASK;
+
+    cmd_latency_stats_t* stats = &cmd_stats[command];
+    if (stats->calls == 0 || cycles < stats->min_cycles) stats->min_cycles = cycles;
+    if (cycles > stats->max_cycles) stats->max_cycles = cycles;
+    stats->total_cycles += cycles;
+    stats->calls++;
+    return true;
 }
 
 // ============================================================================
@@ -441,7 +448,7 @@ bool commands_dispatch(uint8_t command, const uint8_t* payload, uint16_t payload
  *   Byte 3: Firmware Minor Version
  *   Byte 4: Firmware Patch Version
  */
-void cmd_ping(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
+void HOT_PATH_FUNC(cmd_ping)(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
     (void)payload;
     (void)payload_len;
 
@@ -453,7 +460,7 @@ void cmd_ping(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result
     ping_data[3] = 0x00;  // Firmware Minor (v1.0.x)
     ping_data[4] = 0x00;  // Firmware Patch (v1.0.0)
 
-    if (debug_commands) printf("[CMD] PING: returning device info\n");
+    if (debug_commands) DLOG("[CMD] PING: returning device info\n");
     build_ack_with_data(result, ping_data, 5);
 }
 
@@ -463,37 +470,38 @@ void cmd_ping(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result
  * ICD Tables 12-5/12-6: PEEK format
  *   Request: [addr:1] - single 8-bit RAM address (0x00-0x30)
  *   Reply: [data:4] - 32-bit value (little-endian)
+ *
+ * Bulk extension for ground test procedures:
+ *   Request: [addr:1][count:1] - count consecutive registers from addr
+ *   Reply: [data:4*count] - values in address order (little-endian)
  */
-void cmd_peek(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
-    // ICD: Single byte address
-    if (payload_len != 1) {
-        if (debug_commands) printf("[CMD] PEEK: Invalid payload length %u (expected 1)\n", payload_len);
+void HOT_PATH_FUNC(cmd_peek)(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
+    // ICD: Single byte address, optionally followed by a register count
+    if (payload_len != 1 && payload_len != 2) {
+        if (debug_commands) DLOG("[CMD] PEEK: Invalid payload length %u (expected 1 or 2)\n", payload_len);
         build_nack(result);
         return;
     }
 
     uint8_t icd_addr = payload[0];  // 8-bit ICD address
+    uint8_t count = (payload_len == 2) ? payload[1] : 1;
 
-    if (debug_commands) printf("[CMD] PEEK: icd_addr=0x%02X\n", icd_addr);
-
-    // Validate ICD address range (0x00-0x30 per ICD Table 11-1)
-    if (icd_addr > 0x30) {
-        if (debug_commands) printf("[CMD] PEEK: Address 0x%02X out of range\n", icd_addr);
-        build_nack(result);
-        return;
-    }
+    if (debug_commands) DLOG("[CMD] PEEK: icd_addr=0x%02X, count=%u\n", icd_addr, count);
 
-    // Read single 4-byte register via ICD address translation
-    uint8_t data[4];
-    if (!read_register_icd(icd_addr, data)) {
-        if (debug_commands) printf("[CMD] PEEK: Failed to read ICD register 0x%02X\n", icd_addr);
+    // Validate the whole range against the ICD map (0x00-0x30 per ICD Table 11-1)
+    if (!validate_register_access(icd_addr, count, false)) {
+        if (debug_commands) DLOG("[CMD] PEEK: Range 0x%02X+%u invalid\n", icd_addr, count);
         build_nack(result);
         return;
     }
 
-    // ICD: Return single 4-byte value (little-endian)
-    build_ack_with_data(result, data, 4);
-    if (debug_commands) printf("[CMD] PEEK: Success, 4 bytes\n");
+    // Pack the range straight into the reply buffer
+    read_register_range(icd_addr, count, response_buffer);
+    result->status = CMD_ACK;
+    result->data = response_buffer;
+    result->data_len = (uint16_t)(count * ICD_REG_SIZE);
+    result->frame_cache = NULL;
+    if (debug_commands) DLOG("[CMD] PEEK: Success, %u bytes\n", result->data_len);
 }
 
 /**
@@ -502,85 +510,95 @@ void cmd_peek(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result
  * ICD Table 12-9: POKE format
  *   Request: [addr:1][data:4] - 8-bit address + 32-bit value (LE)
  *   Reply: ACK on success, NACK on failure
+ *
+ * Bulk extension: [addr:1][data:4*n] writes n consecutive registers. The
+ * range is rejected as a whole if any register in it is read-only, any
+ * value is invalid or the command queue cannot take all n writes.
  */
-void cmd_poke(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
-    // ICD: [addr:1][data:4] = 5 bytes total
-    if (payload_len != 5) {
-        if (debug_commands) printf("[CMD] POKE: Invalid payload length %u (expected 5)\n", payload_len);
+void HOT_PATH_FUNC(cmd_poke)(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
+    // ICD: [addr:1][data:4*n]
+    if (payload_len < 1 + ICD_REG_SIZE || ((payload_len - 1) % ICD_REG_SIZE) != 0) {
+        if (debug_commands) DLOG("[CMD] POKE: Invalid payload length %u (expected 1 + 4n)\n", payload_len);
         build_nack(result);
         return;
     }
 
     uint8_t icd_addr = payload[0];  // 8-bit ICD address
-    uint32_t value = read_u32_le(&payload[1]);  // Little-endian 32-bit value
+    uint8_t count = (uint8_t)((payload_len - 1) / ICD_REG_SIZE);
 
-    if (debug_commands) printf("[CMD] POKE: icd_addr=0x%02X, value=0x%08X\n", icd_addr, value);
+    if (debug_commands) DLOG("[CMD] POKE: icd_addr=0x%02X, count=%u\n", icd_addr, count);
 
-    // Validate ICD address range (0x00-0x30 per ICD Table 11-1)
-    if (icd_addr > 0x30) {
-        if (debug_commands) printf("[CMD] POKE: Address 0x%02X out of range\n", icd_addr);
+    // Validate the whole range before writing anything
+    if (!validate_register_access(icd_addr, count, true)) {
+        if (debug_commands) DLOG("[CMD] POKE: Range 0x%02X+%u invalid or read-only\n", icd_addr, count);
         build_nack(result);
         return;
     }
 
-    // Write via ICD address translation (sends to Core1 for state-changing regs)
-    if (!write_register_icd(icd_addr, value)) {
-        if (debug_commands) printf("[CMD] POKE: Failed to write ICD register 0x%02X\n", icd_addr);
+    // Write via the ICD map (sends to Core1 for state-changing regs)
+    if (!write_register_range(icd_addr, count, &payload[1])) {
+        if (debug_commands) DLOG("[CMD] POKE: Write rejected in range 0x%02X+%u\n", icd_addr, count);
         build_nack(result);
         return;
     }
 
     build_ack(result);
-    if (debug_commands) printf("[CMD] POKE: Success\n");
+    if (debug_commands) DLOG("[CMD] POKE: Success\n");
 }
 
-void cmd_application_telemetry(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
+void HOT_PATH_FUNC(cmd_application_telemetry)(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
     if (payload_len != 1) {
-        if (debug_commands) printf("[CMD] APP-TELEM: Invalid payload length %u (expected 1)\n", payload_len);
+        if (debug_commands) DLOG("[CMD] APP-TELEM: Invalid payload length %u (expected 1)\n", payload_len);
         build_nack(result);
         return;
     }
 
     uint8_t block_id = payload[0];
-    if (debug_commands) printf("[CMD] APP-TELEM: block_id=%u\n", block_id);
+    if (debug_commands) DLOG("[CMD] APP-TELEM: block_id=%u\n", block_id);
 
-    // Read latest telemetry snapshot from Core1 (thread-safe)
-    telemetry_snapshot_t snapshot;
-    if (!core_sync_read_telemetry(&snapshot)) {
-        // No telemetry available yet (Core1 not started?)
-        if (debug_commands) printf("[CMD] APP-TELEM: No telemetry available\n");
+    if (block_id >= TELEM_BLOCK_COUNT) {
+        if (debug_commands) DLOG("[CMD] APP-TELEM: Invalid block ID %u\n", block_id);
         build_nack(result);
         return;
     }
 
-    // Build temporary wheel_state from snapshot for telemetry builder
-    // This avoids race condition by using atomic snapshot
-    wheel_state_t temp_state = {0};
-    temp_state.omega_rad_s = snapshot.omega_rad_s;
-    temp_state.momentum_nms = snapshot.momentum_nms;
-    temp_state.current_out_a = snapshot.current_a;
-    temp_state.torque_out_mnm = snapshot.torque_mnm;
-    temp_state.power_w = snapshot.power_w;
-    temp_state.voltage_v = snapshot.voltage_v;
-    temp_state.mode = snapshot.mode;
-    temp_state.direction = snapshot.direction;
-    temp_state.fault_status = snapshot.fault_status;
-    temp_state.fault_latch = snapshot.fault_latch;
-    temp_state.warning_status = snapshot.warning_status;
-    temp_state.lcl_tripped = snapshot.lcl_tripped;
-    temp_state.tick_count = snapshot.tick_count;
-
-    // Build telemetry block from snapshot
-    uint16_t block_len = telemetry_build_block(block_id, &temp_state, response_buffer, sizeof(response_buffer));
-
-    if (block_len == 0) {
-        if (debug_commands) printf("[CMD] APP-TELEM: Invalid block ID or error\n");
+    // Served from cache if this block was copied from the current publish
+    uint8_t wheel = (uint8_t)(g_wheel_state - wheel_states);
+    telem_cache_entry_t* entry = &telem_cache[wheel][block_id];
+    uint32_t gen = core_sync_wheel_blocks_gen(wheel);
+
+    if (gen != 0 && entry->seq == gen) {
+        telem_cache_hits++;
+        result->status = CMD_ACK;
+        result->data = entry->data;
+        result->data_len = entry->len;
+        result->frame_cache = &entry->frame;
+        if (debug_commands) DLOG("[CMD] APP-TELEM: Cache hit, %u bytes\n", entry->len);
+        return;
+    }
+
+    // Copy the block Core1 encoded from the live wheel state (no float->fixed
+    // conversion on this core)
+    uint16_t block_len;
+    if (!core_sync_read_wheel_block(wheel, block_id, entry->data, sizeof(entry->data),
+                                    &block_len, &gen)) {
+        // No telemetry available yet (Core1 not started?)
+        entry->seq = 0;
+        if (debug_commands) DLOG("[CMD] APP-TELEM: No telemetry available\n");
         build_nack(result);
         return;
     }
 
-    build_ack_with_data(result, response_buffer, block_len);
-    if (debug_commands) printf("[CMD] APP-TELEM: Success, %u bytes\n", block_len);
+    telem_cache_misses++;
+    entry->seq = gen;
+    entry->len = block_len;
+    entry->frame.len = 0;  // Old frame belongs to the previous data
+
+    result->status = CMD_ACK;
+    result->data = entry->data;
+    result->data_len = block_len;
+    result->frame_cache = &entry->frame;
+    if (debug_commands) DLOG("[CMD] APP-TELEM: Success, %u bytes\n", block_len);
 }
 
 /**
@@ -598,10 +616,10 @@ void cmd_application_telemetry(const uint8_t* payload, uint16_t payload_len, cmd
  *   0b1000 (0x08): PWM control - setpoint is signed 32-bit (LSB 9 bits = duty, sign = dir)
  *   0b0000 (0x00): IDLE - High-Z, no active control
  */
-void cmd_application_command(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
+void HOT_PATH_FUNC(cmd_application_command)(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
     // ICD: [mode:1][setpoint:4] = 5 bytes
     if (payload_len != 5) {
-        if (debug_commands) printf("[CMD] APP-CMD: Invalid payload length %u (expected 5)\n", payload_len);
+        if (debug_commands) DLOG("[CMD] APP-CMD: Invalid payload length %u (expected 5)\n", payload_len);
         build_nack(result);
         return;
     }
@@ -613,26 +631,26 @@ void cmd_application_command(const uint8_t* payload, uint16_t payload_len, cmd_r
     uint8_t mode_bits = mode_byte & 0x0F;
     uint8_t mode_index = icd_mode_to_index(mode_bits);
 
-    if (debug_commands) printf("[CMD] APP-CMD: mode_byte=0x%02X, mode_bits=0x%02X, setpoint=0x%08X\n",
+    if (debug_commands) DLOG("[CMD] APP-CMD: mode_byte=0x%02X, mode_bits=0x%02X, setpoint=0x%08X\n",
                                mode_byte, mode_bits, setpoint);
 
     // Handle IDLE mode (0b0000) - no mode change, just acknowledge
     if (mode_bits == ICD_MODE_IDLE) {
-        if (debug_commands) printf("[CMD] APP-CMD: IDLE mode - no action\n");
+        if (debug_commands) DLOG("[CMD] APP-CMD: IDLE mode - no action\n");
         build_ack(result);
         return;
     }
 
     // Validate mode
     if (mode_index == 0xFF) {
-        if (debug_commands) printf("[CMD] APP-CMD: Invalid mode bits 0x%02X\n", mode_bits);
+        if (debug_commands) DLOG("[CMD] APP-CMD: Invalid mode bits 0x%02X\n", mode_bits);
         build_nack(result);
         return;
     }
 
     // Convert setpoint based on mode
     // We send both mode and setpoint in a single command to avoid race conditions
-    // (the command mailbox can only hold one command at a time)
+    // (Core1 then applies mode and setpoint in the same tick)
     float setpoint_converted = 0.0f;
 
     switch (mode_bits) {
@@ -641,7 +659,7 @@ void cmd_application_command(const uint8_t* payload, uint16_t payload_len, cmd_r
             {
                 float current_ma = uq14_18_to_float(setpoint);
                 setpoint_converted = current_ma / 1000.0f;  // Convert mA to A
-                if (debug_commands) printf("[CMD] APP-CMD: CURRENT mode, setpoint=%.3f A\n", setpoint_converted);
+                if (debug_commands) DLOG("[CMD] APP-CMD: CURRENT mode, setpoint=%.3f A\n", dlog_f32(setpoint_converted));
             }
             break;
 
@@ -649,7 +667,7 @@ void cmd_application_command(const uint8_t* payload, uint16_t payload_len, cmd_r
             // ICD: Q14.18 speed in RPM
             {
                 setpoint_converted = uq14_18_to_float(setpoint);
-                if (debug_commands) printf("[CMD] APP-CMD: SPEED mode, setpoint=%.1f RPM\n", setpoint_converted);
+                if (debug_commands) DLOG("[CMD] APP-CMD: SPEED mode, setpoint=%.1f RPM\n", dlog_f32(setpoint_converted));
             }
             break;
 
@@ -657,7 +675,7 @@ void cmd_application_command(const uint8_t* payload, uint16_t payload_len, cmd_r
             // ICD: Q10.22 torque in mN-m
             {
                 setpoint_converted = q10_22_to_float(setpoint);
-                if (debug_commands) printf("[CMD] APP-CMD: TORQUE mode, setpoint=%.2f mN-m\n", setpoint_converted);
+                if (debug_commands) DLOG("[CMD] APP-CMD: TORQUE mode, setpoint=%.2f mN-m\n", dlog_f32(setpoint_converted));
             }
             break;
 
@@ -666,13 +684,14 @@ void cmd_application_command(const uint8_t* payload, uint16_t payload_len, cmd_r
             {
                 int32_t signed_setpoint = (int32_t)setpoint;
                 setpoint_converted = (float)(abs(signed_setpoint) & 0x1FF) / 5.12f;  // 9-bit duty to 0-100%
-                direction_t dir = (signed_setpoint < 0) ? DIRECTION_NEGATIVE : DIRECTION_POSITIVE;
+                if (debug_commands) DLOG("[CMD] APP-CMD: PWM mode, duty=%.2f%%, dir=%d\n",
+                                         dlog_f32(setpoint_converted), signed_setpoint < 0);
 
-                // TODO: Direction is encoded in setpoint sign, need to send to Core1
-                // For now, store locally (not ideal but matches existing behavior)
-                wheel_model_set_direction(g_wheel_state, dir);
-
-                if (debug_commands) printf("[CMD] APP-CMD: PWM mode, duty=%.2f%%, dir=%d\n", setpoint_converted, dir);
+                // Direction travels as the sign of the duty, so Core1 applies
+                // it in the same tick as the mode
+                if (signed_setpoint < 0) {
+                    setpoint_converted = -setpoint_converted;
+                }
             }
             break;
 
@@ -680,11 +699,11 @@ void cmd_application_command(const uint8_t* payload, uint16_t payload_len, cmd_r
             break;
     }
 
-    // Send mode + setpoint to Core1 via command mailbox as single atomic command
+    // Send mode + setpoint to Core1 via command queue as single atomic command
     // param1 = mode_index, param2 = setpoint value (converted to internal units)
-    // Use blocking version with retry to ensure delivery (50ms timeout = 5 physics ticks)
-    if (!core_sync_send_command_blocking(CMD_SET_MODE, (float)mode_index, setpoint_converted, 0)) {
-        printf("[CMD] APP-CMD: Failed to send to Core1 (timeout after retries)\n");
+    // Non-blocking: the ACK goes out without waiting for Core1
+    if (!send_to_wheel(CMD_SET_MODE, (float)mode_index, setpoint_converted)) {
+        DLOG("[CMD] APP-CMD: Failed to send to Core1 (command queue full)\n");
         build_nack(result);
         return;
     }
@@ -701,31 +720,31 @@ void cmd_application_command(const uint8_t* payload, uint16_t payload_len, cmd_r
  *
  * Note: Does NOT clear LCL trip - requires hardware RESET.
  */
-void cmd_clear_fault(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
+void HOT_PATH_FUNC(cmd_clear_fault)(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
     if (payload_len != 4) {
-        if (debug_commands) printf("[CMD] CLEAR-FAULT: Invalid payload length %u (expected 4)\n", payload_len);
+        if (debug_commands) DLOG("[CMD] CLEAR-FAULT: Invalid payload length %u (expected 4)\n", payload_len);
         build_nack(result);
         return;
     }
 
     // ICD: Little-endian fault mask
     uint32_t fault_mask = read_u32_le(payload);
-    if (debug_commands) printf("[CMD] CLEAR-FAULT: mask=0x%08X\n", fault_mask);
+    if (debug_commands) DLOG("[CMD] CLEAR-FAULT: mask=0x%08X\n", fault_mask);
 
-    // Send CLEAR_FAULT command to Core1 via command mailbox
+    // Send CLEAR_FAULT command to Core1 via command queue
     // Pack mask into float for transport (Core1 will unpack)
-    // Use blocking version with retry for reliable delivery
+    // Queued to Core1 (non-blocking); fails only if the queue is full
     float mask_as_float;
     memcpy(&mask_as_float, &fault_mask, sizeof(float));
-    if (!core_sync_send_command_blocking(CMD_CLEAR_FAULT, mask_as_float, 0.0f, 0)) {
-        if (debug_commands) printf("[CMD] CLEAR-FAULT: Failed to send to Core1 (timeout after retries)\n");
+    if (!send_to_wheel(CMD_CLEAR_FAULT, mask_as_float, 0.0f)) {
+        DLOG("[CMD] CLEAR-FAULT: Failed to send to Core1 (command queue full)\n");
         build_nack(result);
         return;
     }
 
     // Check if LCL is still tripped (from local snapshot)
     if (wheel_model_is_lcl_tripped(g_wheel_state)) {
-        if (debug_commands) printf("[CMD] CLEAR-FAULT: LCL still tripped (requires hardware RESET)\n");
+        if (debug_commands) DLOG("[CMD] CLEAR-FAULT: LCL still tripped (requires hardware RESET)\n");
     }
 
     build_ack(result);
@@ -745,34 +764,34 @@ void cmd_clear_fault(const uint8_t* payload, uint16_t payload_len, cmd_result_t*
  *
  * Note: ICD uses "disable" bits (1=off), we internally use "enable" bits (1=on).
  */
-void cmd_configure_protection(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
+void HOT_PATH_FUNC(cmd_configure_protection)(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
     // ICD: [disable_mask:4] = 4 bytes
     if (payload_len != 4) {
-        if (debug_commands) printf("[CMD] CONFIG-PROT: Invalid payload length %u (expected 4)\n", payload_len);
+        if (debug_commands) DLOG("[CMD] CONFIG-PROT: Invalid payload length %u (expected 4)\n", payload_len);
         build_nack(result);
         return;
     }
 
     // ICD: Little-endian disable bitmask
     uint32_t disable_mask = read_u32_le(payload);
-    if (debug_commands) printf("[CMD] CONFIG-PROT: disable_mask=0x%08X\n", disable_mask);
+    if (debug_commands) DLOG("[CMD] CONFIG-PROT: disable_mask=0x%08X\n", disable_mask);
 
     // Invert to get enable mask (ICD: bit=1 disables, internal: bit=1 enables)
     // Only 5 bits are defined per ICD
     uint32_t enable_mask = ~disable_mask & 0x1F;
 
-    // Send protection config to Core1 via command mailbox
+    // Send protection config to Core1 via command queue
     // Pack enable_mask into float for transport (Core1 will unpack)
-    // Use blocking version with retry for reliable delivery
+    // Queued to Core1 (non-blocking); fails only if the queue is full
     float enable_mask_as_float;
     memcpy(&enable_mask_as_float, &enable_mask, sizeof(float));
-    if (!core_sync_send_command_blocking(CMD_CONFIG_PROTECTION, enable_mask_as_float, 0.0f, 0)) {
-        if (debug_commands) printf("[CMD] CONFIG-PROT: Failed to send to Core1 (timeout after retries)\n");
+    if (!send_to_wheel(CMD_CONFIG_PROTECTION, enable_mask_as_float, 0.0f)) {
+        DLOG("[CMD] CONFIG-PROT: Failed to send to Core1 (command queue full)\n");
         build_nack(result);
         return;
     }
 
-    if (debug_commands) printf("[CMD] CONFIG-PROT: enable_mask=0x%08X sent to Core1 (inverted from disable)\n", enable_mask);
+    if (debug_commands) DLOG("[CMD] CONFIG-PROT: enable_mask=0x%08X sent to Core1 (inverted from disable)\n", enable_mask);
 
     build_ack(result);
 }
@@ -787,18 +806,18 @@ void cmd_configure_protection(const uint8_t* payload, uint16_t payload_len, cmd_
  * Per ICD: "If successfully executed, no reply is sent because the
  * LCL has tripped and power rails are disabled."
  */
-void cmd_trip_lcl(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
+void HOT_PATH_FUNC(cmd_trip_lcl)(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
     (void)payload;
     (void)payload_len;
 
-    if (debug_commands) printf("[CMD] TRIP-LCL: Triggering LCL (no reply will be sent)\n");
+    if (debug_commands) DLOG("[CMD] TRIP-LCL: Triggering LCL (no reply will be sent)\n");
 
-    // Send TRIP-LCL command to Core1 physics model via command mailbox
+    // Send TRIP-LCL command to Core1 physics model via command queue
     // The Core1 physics loop will execute wheel_model_trip_lcl() on the authoritative state
-    // Use blocking version with retry for reliable delivery
-    if (!core_sync_send_command_blocking(CMD_TRIP_LCL, 0.0f, 0.0f, 0)) {
-        // Timeout after retries - extremely unlikely, but handle gracefully
-        if (debug_commands) printf("[CMD] TRIP-LCL: Failed to send to Core1 (timeout after retries)\n");
+    // Queued to Core1 (non-blocking); fails only if the queue is full
+    if (!send_to_wheel(CMD_TRIP_LCL, 0.0f, 0.0f)) {
+        // Queue full - extremely unlikely, but handle gracefully
+        DLOG("[CMD] TRIP-LCL: Failed to send to Core1 (command queue full)\n");
         // Still suppress reply per ICD (LCL trip is a one-way command)
     }
 
@@ -807,4 +826,94 @@ void cmd_trip_lcl(const uint8_t* payload, uint16_t payload_len, cmd_result_t* re
     result->status = CMD_NO_REPLY;
     result->data = NULL;
     result->data_len = 0;
+    result->frame_cache = NULL;
+}
+
+/**
+ * @brief SIM-STEP command handler - emulator extension
+ *
+ * Steps are queued to Core1 and run back to back; the reply reports the
+ * state at the time of the request, so pending counts what is still queued.
+ */
+void HOT_PATH_FUNC(cmd_sim_step)(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
+    if (payload_len == 1) {
+        if (payload[0] > TIMEBASE_STEPPED) {
+            build_nack(result);
+            return;
+        }
+        timebase_set_mode((timebase_mode_t)payload[0]);
+    } else if (payload_len == 4) {
+        uint32_t ticks = read_u32_le(payload);
+        if (timebase_get_mode() != TIMEBASE_STEPPED) {
+            timebase_set_mode(TIMEBASE_STEPPED);
+        }
+        timebase_step(ticks);
+        if (debug_commands) DLOG("[CMD] SIM-STEP: %lu tick(s) queued\n", (unsigned long)ticks);
+    } else if (payload_len != 0) {
+        build_nack(result);
+        return;
+    }
+
+    uint8_t reply[13];
+    reply[0] = (uint8_t)timebase_get_mode();
+    write_u32_le(&reply[1], timebase_get_tick_count());
+    write_u32_le(&reply[5], timebase_get_pending_steps());
+    write_u32_le(&reply[9], (uint32_t)(timebase_get_sim_us() / 1000u));
+    build_ack_with_data(result, reply, sizeof(reply));
+}
+
+/**
+ * @brief MULTI-TELEMETRY command handler - emulator extension
+ *
+ * Copies the wheel's whole published block set once, then packs the
+ * requested blocks, so every block in the reply comes from the same tick.
+ */
+void HOT_PATH_FUNC(cmd_multi_telemetry)(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result) {
+    if (!multi_telem_enabled) {
+        if (debug_commands) DLOG("[CMD] MULTI-TELEM: Extension disabled\n");
+        build_nack(result);
+        return;
+    }
+    if (payload_len != 1) {
+        if (debug_commands) DLOG("[CMD] MULTI-TELEM: Invalid payload length %u (expected 1)\n", payload_len);
+        build_nack(result);
+        return;
+    }
+
+    uint8_t mask = payload[0];
+    if (mask == 0 || (mask >> TELEM_BLOCK_COUNT) != 0) {
+        if (debug_commands) DLOG("[CMD] MULTI-TELEM: Invalid block mask 0x%02X\n", mask);
+        build_nack(result);
+        return;
+    }
+
+    uint8_t wheel = (uint8_t)(g_wheel_state - wheel_states);
+    if (!core_sync_read_wheel_blocks(wheel, &multi_telem_copy, NULL)) {
+        if (debug_commands) DLOG("[CMD] MULTI-TELEM: No telemetry available\n");
+        build_nack(result);
+        return;
+    }
+
+    uint16_t n = 0;
+    for (uint8_t id = 0; id < TELEM_BLOCK_COUNT; id++) {
+        if ((mask & (1u << id)) == 0) {
+            continue;
+        }
+        uint16_t len = multi_telem_copy.len[id];
+        if (len == 0) {
+            if (debug_commands) DLOG("[CMD] MULTI-TELEM: Block %u not encoded\n", id);
+            build_nack(result);
+            return;
+        }
+        response_buffer[n++] = id;
+        response_buffer[n++] = (uint8_t)len;
+        memcpy(&response_buffer[n], multi_telem_copy.data[id], len);
+        n = (uint16_t)(n + len);
+    }
+
+    result->status = CMD_ACK;
+    result->data = response_buffer;
+    result->data_len = n;
+    result->frame_cache = NULL;
+    if (debug_commands) DLOG("[CMD] MULTI-TELEM: mask=0x%02X, %u bytes\n", mask, n);
 }
@@ -11,6 +11,10 @@
  * - 0x09 CLEAR-FAULT (clear latched faults)
  * - 0x0A CONFIGURE-PROTECTION (update protection thresholds)
  * - 0x0B TRIP-LCL (test LCL trip)
+ *
+ * Emulator extensions (not in the ICD):
+ * - 0x0C SIM-STEP (lockstep tick control for simulators)
+ * - 0x0D MULTI-TELEMETRY (several telemetry blocks, one tick; off by default)
  */
 
 #ifndef NSS_NRWA_T6_COMMANDS_H
@@ -19,6 +23,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "nss_nrwa_t6_model.h"
+#include "nss_nrwa_t6_telemetry.h"
+#include "nsp.h"
 
 // ============================================================================
 // NSP Command Codes (from ICD)
@@ -32,6 +38,14 @@
 #define NSP_CMD_CLEAR_FAULT             0x09
 #define NSP_CMD_CONFIGURE_PROTECTION    0x0A
 #define NSP_CMD_TRIP_LCL                0x0B
+#define NSP_CMD_SIM_STEP                0x0C  // Emulator extension
+#define NSP_CMD_MULTI_TELEMETRY         0x0D  // Emulator extension (opt-in)
+
+/** Size of the dispatch table (highest command code + 1) */
+#define NSP_CMD_TABLE_SIZE              (NSP_CMD_MULTI_TELEMETRY + 1)
+
+/** Longest MULTI-TELEMETRY reply: every block with its [id][len] header */
+#define MULTI_TELEM_MAX_REPLY           (TELEM_BLOCK_COUNT * (2 + TELEM_MAX_BLOCK_SIZE))
 
 // ============================================================================
 // Command Response Types
@@ -46,6 +60,20 @@ typedef enum {
     CMD_NO_REPLY = 2,   // No reply should be sent (e.g., TRIP-LCL per ICD)
 } cmd_response_t;
 
+/**
+ * @brief Finished SLIP reply frame cached next to a command's reply data
+ *
+ * Filled and checked by the NSP handler. The command module empties it
+ * (len = 0) whenever the reply data it belongs to is rebuilt.
+ */
+typedef struct {
+    uint8_t bytes[NSP_SLIP_REPLY_MAX(TELEM_MAX_BLOCK_SIZE)];
+    uint16_t len;               // Encoded length (0 = empty)
+    uint8_t dest;               // Request header the frame answers
+    uint8_t src;
+    uint8_t ctrl;
+} cmd_reply_frame_t;
+
 /**
  * @brief Command handler result
  */
@@ -53,8 +81,19 @@ typedef struct {
     cmd_response_t status;      // ACK or NACK
     uint8_t* data;              // Response payload (NULL if none)
     uint16_t data_len;          // Payload length in bytes
+    cmd_reply_frame_t* frame_cache; // Reusable reply frame for this data (NULL if not cacheable)
 } cmd_result_t;
 
+/**
+ * @brief Per-command execution statistics (cycles spent in the handler)
+ */
+typedef struct {
+    uint32_t calls;             // Times the handler ran
+    uint32_t min_cycles;        // Fastest call (0 if never called)
+    uint32_t max_cycles;        // Slowest call
+    uint64_t total_cycles;      // Sum over all calls (avg = total / calls)
+} cmd_latency_stats_t;
+
 // ============================================================================
 // Command Handler API
 // ============================================================================
@@ -66,10 +105,18 @@ typedef struct {
  */
 void commands_init(wheel_state_t* state);
 
+/**
+ * @brief Initialize command handler subsystem for a wheel cluster
+ *
+ * @param states Array of wheel states (index = wheel)
+ * @param count Number of wheels in the array
+ */
+void commands_init_wheels(wheel_state_t* states, uint8_t count);
+
 /**
  * @brief Dispatch NSP command to appropriate handler
  *
- * @param command Command code (0x00-0x0B)
+ * @param command Command code (0x00-0x0D)
  * @param payload Command payload data
  * @param payload_len Payload length in bytes
  * @param result Pointer to result structure (filled by handler)
@@ -77,6 +124,73 @@ void commands_init(wheel_state_t* state);
  */
 bool commands_dispatch(uint8_t command, const uint8_t* payload, uint16_t payload_len, cmd_result_t* result);
 
+/**
+ * @brief Dispatch NSP command to one wheel of the cluster
+ *
+ * commands_dispatch() is this call for wheel 0.
+ *
+ * @param wheel Wheel index, or CORE_SYNC_WHEEL_ALL for broadcast frames
+ *              (state-changing commands go to every wheel, reads use wheel 0)
+ * @param command Command code (0x00-0x0D)
+ * @param payload Command payload data
+ * @param payload_len Payload length in bytes
+ * @param result Pointer to result structure (filled by handler)
+ * @return true if command was recognized and handled
+ */
+bool commands_dispatch_wheel(uint8_t wheel, uint8_t command, const uint8_t* payload,
+                             uint16_t payload_len, cmd_result_t* result);
+
+/**
+ * @brief Get APPLICATION-TELEMETRY reply cache statistics
+ *
+ * A hit reuses the block encoded earlier from the same telemetry publish.
+ *
+ * @param hits Output: requests served from the cache (can be NULL)
+ * @param misses Output: requests that encoded the block (can be NULL)
+ */
+void commands_get_telem_cache_stats(uint32_t* hits, uint32_t* misses);
+
+/**
+ * @brief Get execution statistics for one command code
+ *
+ * Cycles are measured around the handler call with the Core0 cycle
+ * counter (timebase_cycle_counter_start()).
+ *
+ * @param command Command code (0x00-0x0D)
+ * @param stats Output: statistics for the command
+ * @return false if the code has no handler
+ */
+bool commands_get_latency_stats(uint8_t command, cmd_latency_stats_t* stats);
+
+/**
+ * @brief Enable or disable the MULTI-TELEMETRY extension
+ *
+ * Off after boot: a flight-like OBC sees only the ICD command set. While
+ * off, 0x0D is answered with NACK like any other unsupported request.
+ *
+ * @param enabled true to serve MULTI-TELEMETRY requests
+ */
+void commands_set_multi_telem_enabled(bool enabled);
+
+/**
+ * @brief Check whether the MULTI-TELEMETRY extension is enabled
+ *
+ * @return true if MULTI-TELEMETRY requests are served
+ */
+bool commands_get_multi_telem_enabled(void);
+
+/**
+ * @brief Get count of frames whose command code has no handler
+ *
+ * @return Unknown command count since commands_reset_latency_stats()
+ */
+uint32_t commands_get_unknown_count(void);
+
+/**
+ * @brief Clear per-command execution statistics
+ */
+void commands_reset_latency_stats(void);
+
 // ============================================================================
 // Individual Command Handlers
 // ============================================================================
@@ -97,13 +211,14 @@ void cmd_ping(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result
  * @brief PEEK [0x02]: Read register(s)
  *
  * Payload format:
- *   [start_addr:2] [count:1]
+ *   [icd_addr:1] [count:1]   (count optional, default 1)
  *
- * Response: ACK with register data
+ * Response: ACK with register data (4 bytes each, little-endian)
  *   [reg0_value] [reg1_value] ...
+ * All values in one reply come from the same physics tick.
  *
  * @param payload Command payload
- * @param payload_len Payload length (should be 3)
+ * @param payload_len Payload length (1 or 2)
  * @param result Pointer to result structure
  */
 void cmd_peek(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result);
@@ -112,12 +227,13 @@ void cmd_peek(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result
  * @brief POKE [0x03]: Write register(s)
  *
  * Payload format:
- *   [start_addr:2] [count:1] [reg0_value] [reg1_value] ...
+ *   [icd_addr:1] [reg0_value:4] [reg1_value:4] ...
  *
- * Response: ACK if successful, NACK if invalid address or read-only
+ * Response: ACK if successful, NACK if the range is invalid or contains
+ * a read-only register
  *
  * @param payload Command payload
- * @param payload_len Payload length (3 + register data)
+ * @param payload_len Payload length (1 + 4 * register count)
  * @param result Pointer to result structure
  */
 void cmd_poke(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result);
@@ -218,4 +334,44 @@ void cmd_configure_protection(const uint8_t* payload, uint16_t payload_len, cmd_
  */
 void cmd_trip_lcl(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result);
 
+/**
+ * @brief SIM-STEP [0x0C]: Lockstep tick control (emulator extension)
+ *
+ * Payload format:
+ *   (none)       query only
+ *   [mode:1]     0 = free-run (alarm), 1 = stepped (external clock)
+ *   [ticks:4]    queue ticks, entering stepped mode first if needed
+ *
+ * Device-wide: every wheel of the cluster shares the physics tick. Send it
+ * broadcast without the poll bit to step several emulators on one bus.
+ *
+ * Response: ACK with [mode:1] [tick_count:4] [pending:4] [sim_ms:4]
+ * (little-endian), NACK on a bad length or mode
+ *
+ * @param payload Command payload
+ * @param payload_len Payload length (0, 1 or 4)
+ * @param result Pointer to result structure
+ */
+void cmd_sim_step(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result);
+
+/**
+ * @brief MULTI-TELEMETRY [0x0D]: Several telemetry blocks (emulator extension)
+ *
+ * Payload format:
+ *   [mask:1]     bit n requests block n (0x01 STANDARD ... 0x10 DIAGNOSTICS)
+ *
+ * All blocks come from one Core1 publish, so they describe the same physics
+ * tick, and one transaction replaces up to five APP-TELEM polls.
+ *
+ * Response: ACK with, for each requested block in ascending ID order,
+ * [block_id:1] [len:1] [block:len] (each block as APP-TELEM returns it);
+ * NACK if the extension is disabled, the mask is empty or names an unknown
+ * block, or no telemetry has been published yet
+ *
+ * @param payload Command payload
+ * @param payload_len Payload length (1)
+ * @param result Pointer to result structure
+ */
+void cmd_multi_telemetry(const uint8_t* payload, uint16_t payload_len, cmd_result_t* result);
+
 #endif // NSS_NRWA_T6_COMMANDS_H
@@ -0,0 +1,586 @@
+/**
+ * @file nss_nrwa_t6_engine.c
+ * @brief Physics Engine Tick Implementation
+ */
+
+#include "nss_nrwa_t6_engine.h"
+#include "nss_nrwa_t6_protection.h"
+#include "nss_nrwa_t6_telemetry.h"
+#include "nss_nrwa_t6_test_modes.h"
+#include "nss_nrwa_t6_thermal.h"
+#include "board_pico.h"
+#include "hot_path.h"
+#include "config/scenario.h"
+#include "util/profiler.h"
+#include "util/tick_trace.h"
+#include "util/flight_rec.h"
+#include "util/trend.h"
+#include "util/task_sched.h"
+#include "util/stats.h"
+#include "util/latency_hist.h"
+#include "pico/time.h"
+#include <string.h>
+
+// ============================================================================
+// Internal State (Core1 only)
+// ============================================================================
+
+static wheel_state_t* CORE1_DATA("engine") g_wheels = NULL;
+static physics_engine_snapshot_hook_t CORE1_DATA("engine") g_snapshot_hook = NULL;
+
+// Statistics
+static uint32_t CORE1_DATA("engine") g_tick_count = 0;
+static uint32_t CORE1_DATA("engine") g_max_jitter_us = 0;
+static uint32_t CORE1_DATA("engine") g_serialize_us = 0;
+
+// CPU load: busy time of the previous tick (body + idle tasks) and over
+// the last second
+static uint32_t CORE1_DATA("engine") g_busy_us = 0;
+static uint32_t CORE1_DATA("engine") g_load_permille = 0;
+static uint32_t CORE1_DATA("engine") g_window_busy_us = 0;
+static uint32_t CORE1_DATA("engine") g_window_ticks = 0;
+
+// Core1 copy of the scenario physics override block
+static physics_override_t CORE1_DATA("engine") g_physics_ovr;
+
+// Current tick, shared by the scheduled tasks
+static uint64_t CORE1_DATA("engine") g_tick_start_us = 0;
+static tick_sample_t CORE1_DATA("engine") g_sample;
+static uint32_t CORE1_DATA("engine") g_jitter_us = 0;
+static uint32_t CORE1_DATA("engine") g_physics_us = 0;
+static uint64_t CORE1_DATA("engine") g_tick_end_us = 0;
+
+// Hardware RESET: requests (RESET pin ISR) and resets applied, with the
+// time of the last one
+static volatile uint32_t g_hw_reset_req = 0;
+static volatile uint32_t g_hw_reset_done = 0;
+static volatile uint32_t g_hw_reset_us = 0;
+
+// Command latency, receive time to the start of the tick that applied it:
+// one histogram per command type (Core1 records, Core0 summarizes), and
+// the last command applied to each wheel for its snapshot
+static latency_hist_t g_cmd_latency[CMD_TYPE_COUNT];
+static volatile uint32_t g_cmd_latency_reset_req = 0;
+static uint32_t g_cmd_latency_reset_done = 0;
+
+typedef struct {
+    uint32_t id;
+    uint32_t tick;
+    uint32_t apply_us;
+    uint32_t latency_us;
+} cmd_echo_t;
+
+static cmd_echo_t g_cmd_echo[EMULATED_WHEEL_COUNT];
+
+// ============================================================================
+// Tick Steps
+// ============================================================================
+
+/**
+ * @brief Apply one queued Core0 command to a wheel
+ *
+ * @param w Target wheel
+ * @param cmd Command popped from the queue
+ */
+static void HOT_PATH_FUNC(apply_command)(wheel_state_t* w, const command_mailbox_t* cmd) {
+    // Apply command to wheel model
+    switch (cmd->type) {
+        case CMD_SET_MODE:
+            // param1 = mode index, param2 = setpoint (optional, from APP-CMD)
+            {
+                control_mode_t new_mode = (control_mode_t)cmd->param1;
+                wheel_model_set_mode(w, new_mode);
+
+                // If param2 is non-zero, apply the setpoint for the new mode
+                // This enables atomic mode+setpoint changes from APPLICATION-COMMAND
+                if (cmd->param2 != 0.0f) {
+                    switch (new_mode) {
+                        case CONTROL_MODE_CURRENT:
+                            wheel_model_set_current(w, cmd->param2);
+                            break;
+                        case CONTROL_MODE_SPEED:
+                            wheel_model_set_speed(w, cmd->param2);
+                            break;
+                        case CONTROL_MODE_TORQUE:
+                            wheel_model_set_torque(w, cmd->param2);
+                            break;
+                        case CONTROL_MODE_PWM:
+                            // Signed duty: the sign is the drive direction
+                            wheel_model_set_direction(w, (cmd->param2 < 0.0f) ? DIRECTION_NEGATIVE
+                                                                               : DIRECTION_POSITIVE);
+                            wheel_model_set_pwm(w, (cmd->param2 < 0.0f) ? -cmd->param2 : cmd->param2);
+                            break;
+                    }
+                }
+            }
+            break;
+
+        case CMD_SET_SPEED:
+            wheel_model_set_speed(w, cmd->param1);
+            break;
+
+        case CMD_SET_CURRENT:
+            wheel_model_set_current(w, cmd->param1);
+            break;
+
+        case CMD_SET_TORQUE:
+            wheel_model_set_torque(w, cmd->param1);
+            break;
+
+        case CMD_SET_PWM:
+            wheel_model_set_pwm(w, cmd->param1);
+            break;
+
+        case CMD_CLEAR_FAULT:
+            // Clear latched faults (param1 = fault mask encoded as float)
+            {
+                uint32_t fault_mask;
+                memcpy(&fault_mask, &cmd->param1, sizeof(uint32_t));
+                w->fault_latch &= ~fault_mask;
+                w->fault_status &= ~fault_mask;
+            }
+            break;
+
+        case CMD_INJECT_FAULT:
+            // Latch injected faults as if protection had detected them; the
+            // next protection pass disables the drive (CLEAR-FAULT recovers)
+            {
+                uint32_t fault_mask;
+                memcpy(&fault_mask, &cmd->param1, sizeof(uint32_t));
+                if (fault_mask & ~w->fault_latch) {
+                    w->drive_fault_count++;
+                }
+                w->fault_latch |= fault_mask;
+            }
+            break;
+
+        case CMD_RESET:
+            // Soft reset: reinitialize wheel model (temperatures carry over)
+            {
+                thermal_state_t thermal = w->thermal;
+                wheel_model_init(w);
+                protection_init(w);
+                w->thermal = thermal;
+            }
+            break;
+
+        case CMD_TRIP_LCL:
+            // Test LCL trip (ICD TRIP-LCL command)
+            // This simulates the hardware LCL tripping
+            wheel_model_trip_lcl(w);
+            break;
+
+        case CMD_SET_INTEGRATOR:
+            // param1 = integrator_mode_t, param2 = substeps
+            wheel_model_set_integrator(w,
+                                       (integrator_mode_t)cmd->param1,
+                                       (uint32_t)cmd->param2);
+            break;
+
+        case CMD_CONFIG_PROTECTION:
+            // Configure protection enable mask (ICD CONFIGURE-PROTECTION)
+            // param1 contains the enable mask encoded as float
+            {
+                uint32_t enable_mask;
+                memcpy(&enable_mask, &cmd->param1, sizeof(uint32_t));
+                w->protection_enable = enable_mask;
+            }
+            break;
+
+        case CMD_TEST_SEQ_START:
+        case CMD_TEST_SEQ_STOP:
+            // Sequencer drives wheel 0; param1 = mode list encoded as float
+            if (w == &g_wheels[0]) {
+                uint32_t list;
+                memcpy(&list, &cmd->param1, sizeof(uint32_t));
+                test_seq_request(w, list, (cmd->type == CMD_TEST_SEQ_START) ? (uint32_t)cmd->param2 : 0u);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Apply one wheel's share of a parameter transaction
+ *
+ * @param w Target wheel
+ * @param p Values (p->set selects them)
+ */
+static void HOT_PATH_FUNC(apply_params)(wheel_state_t* w, const wheel_params_t* p) {
+    for (uint8_t id = 0; id < PROT_PARAM_COUNT; id++) {
+        if (p->set & PARAM_SET_THRESHOLD(id)) {
+            protection_set_threshold(w, id, p->threshold[id]);
+        }
+    }
+    if (p->set & PARAM_SET_ENABLE) {
+        w->protection_enable = p->protection_enable;
+    }
+    if (p->set & (PARAM_SET_PI_KP | PARAM_SET_PI_KI | PARAM_SET_PI_I_MAX)) {
+        if (p->set & PARAM_SET_PI_KP) {
+            w->pi_kp = p->pi_kp;
+        }
+        if (p->set & PARAM_SET_PI_KI) {
+            w->pi_ki = p->pi_ki;
+        }
+        if (p->set & PARAM_SET_PI_I_MAX) {
+            w->pi_i_max_a = p->pi_i_max_a;
+        }
+        wheel_model_update_pi_params(w);
+    }
+}
+
+/**
+ * @brief Publish one wheel's telemetry snapshot
+ */
+static void HOT_PATH_FUNC(publish_wheel)(uint8_t wheel, uint32_t jitter_us, uint32_t physics_us,
+                                         uint64_t timestamp_us) {
+    const wheel_state_t* w = &g_wheels[wheel];
+    telemetry_snapshot_t snapshot;
+
+    snapshot.wheel = wheel;
+    snapshot.omega_rad_s = w->omega_rad_s;
+    snapshot.speed_rpm = w->omega_rad_s * RAD_S_TO_RPM;
+    snapshot.momentum_nms = w->momentum_nms;
+    snapshot.current_a = w->current_out_a;
+    snapshot.torque_mnm = w->torque_out_mnm;
+    snapshot.power_w = w->power_w;
+    snapshot.voltage_v = w->voltage_v;
+    snapshot.mode = w->mode;
+    snapshot.direction = w->direction;
+    snapshot.current_cmd_a = w->current_cmd_a;
+    snapshot.speed_cmd_rpm = w->speed_cmd_rpm;
+    snapshot.torque_cmd_mnm = w->torque_cmd_mnm;
+    snapshot.pwm_duty_pct = w->pwm_duty_pct;
+    snapshot.integrator = w->integrator;
+    snapshot.integrator_substeps = w->integrator_substeps;
+    snapshot.fault_status = w->fault_status;
+    snapshot.fault_latch = w->fault_latch;
+    snapshot.warning_status = w->warning_status;
+    snapshot.lcl_tripped = w->lcl_tripped;
+    snapshot.tick_count = w->tick_count;
+    snapshot.jitter_us = jitter_us;
+    snapshot.max_jitter_us = g_max_jitter_us;
+    snapshot.physics_us = physics_us;
+    snapshot.serialize_us = g_serialize_us;
+    snapshot.busy_us = g_busy_us;
+    snapshot.load_permille = g_load_permille;
+    snapshot.cmd_id = g_cmd_echo[wheel].id;
+    snapshot.cmd_tick = g_cmd_echo[wheel].tick;
+    snapshot.cmd_apply_us = g_cmd_echo[wheel].apply_us;
+    snapshot.cmd_latency_us = g_cmd_echo[wheel].latency_us;
+    snapshot.timestamp_us = timestamp_us;
+
+    core_sync_publish_wheel_telemetry(wheel, &snapshot);
+    if (g_snapshot_hook) {
+        g_snapshot_hook(&snapshot);
+    }
+}
+
+/**
+ * @brief Encode every APP-TELEM block for one wheel
+ *
+ * Runs in the slack after the snapshot is published, so the Q-format
+ * conversions stay off the Core0 reply path.
+ */
+static void HOT_PATH_FUNC(publish_blocks)(uint8_t wheel) {
+    telemetry_blocks_t* blocks = core_sync_wheel_blocks_back(wheel);
+
+    for (uint8_t id = 0; id < TELEM_BLOCK_COUNT; id++) {
+        blocks->len[id] = telemetry_build_block(id, &g_wheels[wheel],
+                                                blocks->data[id], TELEM_MAX_BLOCK_SIZE);
+    }
+
+    core_sync_publish_wheel_blocks(wheel);
+}
+
+// ============================================================================
+// Scheduled Tasks
+// ============================================================================
+
+// Budgets: the every-tick tasks share the hard real-time slot
+// (MAX_TICK_JITTER_US for the whole tick); slower and idle work gets what
+// it measures on the board with margin
+#define TASK_BUDGET_MODEL_US        (MAX_TICK_JITTER_US * 3 / 4)
+#define TASK_BUDGET_PUBLISH_US      (MAX_TICK_JITTER_US / 4)
+#define TASK_BUDGET_RECORDER_US     (5u * EMULATED_WHEEL_COUNT)
+#define TASK_BUDGET_TREND_US        (10u * EMULATED_WHEEL_COUNT)
+#define TASK_BUDGET_THERMAL_US      (20u * EMULATED_WHEEL_COUNT)
+#define TASK_BUDGET_BLOCKS_US       (60u * EMULATED_WHEEL_COUNT)
+
+// Idle and optional work stop this far ahead of the next tick (wake-up margin)
+#define IDLE_GUARD_US               (PHYSICS_TICK_PERIOD_US / 20)
+
+/**
+ * @brief Every tick: queued commands, control law, dynamics, protection
+ */
+static void HOT_PATH_FUNC(task_model)(void) {
+    // Guard steps 0-2 so Core0 bulk PEEKs copy state from a single tick
+    core_sync_state_write_begin();
+
+    // ====================================================================
+    // 0. Hardware RESET requested since the last tick: every wheel
+    //    restarts (LCL cycled, faults cleared; it keeps coasting and the
+    //    temperatures carry over), before any command of this tick
+    // ====================================================================
+    uint32_t reset_req = g_hw_reset_req;
+    if (reset_req != g_hw_reset_done) {
+        for (uint8_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+            thermal_state_t thermal = g_wheels[w].thermal;
+            wheel_model_reset(&g_wheels[w]);  // wheel_model_init() + protection_init()
+            g_wheels[w].thermal = thermal;
+        }
+        g_hw_reset_us = time_us_32();
+        g_hw_reset_done = reset_req;
+    }
+
+    // ====================================================================
+    // 1. Apply all commands queued by Core0 since the last tick, then the
+    //    parameter transaction committed since then
+    // ====================================================================
+    PROF_BEGIN(PROF_CORE1_CMD_DRAIN);
+    uint32_t latency_reset = g_cmd_latency_reset_req;
+    if (latency_reset != g_cmd_latency_reset_done) {
+        memset(g_cmd_latency, 0, sizeof(g_cmd_latency));
+        g_cmd_latency_reset_done = latency_reset;
+    }
+    uint32_t apply_us = (uint32_t)g_tick_start_us;
+    command_mailbox_t cmd;
+    while (core_sync_read_command(&cmd)) {
+        g_sample.cmd_type = (uint8_t)cmd.type;
+        if (g_sample.cmd_count < UINT8_MAX) {
+            g_sample.cmd_count++;
+        }
+
+        // Receive time (NSP frame END) to this tick
+        uint32_t latency_us = apply_us - cmd.timestamp_us;
+        if ((uint32_t)cmd.type < CMD_TYPE_COUNT) {
+            latency_hist_record(&g_cmd_latency[cmd.type], latency_us);
+        }
+        cmd_echo_t echo = { cmd.id, g_tick_count, apply_us, latency_us };
+
+        if (cmd.wheel == CORE_SYNC_WHEEL_ALL) {
+            for (uint8_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+                apply_command(&g_wheels[w], &cmd);
+                g_cmd_echo[w] = echo;
+            }
+        } else if (cmd.wheel < EMULATED_WHEEL_COUNT) {
+            apply_command(&g_wheels[cmd.wheel], &cmd);
+            g_cmd_echo[cmd.wheel] = echo;
+        }
+    }
+
+    // Parameter transaction committed since the last tick: every value in
+    // it takes effect together, before this tick's physics
+    const param_block_t* params = core_sync_params_acquire();
+    if (params != NULL) {
+        for (uint8_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+            if (params->wheel[w].set != 0) {
+                apply_params(&g_wheels[w], &params->wheel[w]);
+            }
+        }
+        core_sync_params_release();
+    }
+    PROF_END(PROF_CORE1_CMD_DRAIN);
+
+    // ====================================================================
+    // 2. Update physics model for every wheel (one MODEL_DT_S tick)
+    // ====================================================================
+    // Note: wheel_model_tick() includes protection checks
+    // Scenario overrides published by Core0 apply from this tick on
+    const physics_override_t* ovr =
+        core_sync_read_physics_override(&g_physics_ovr) ? &g_physics_ovr : NULL;
+    uint32_t physics_start = time_us_32();
+    uint32_t revs = 0;
+    for (uint8_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        uint32_t revs_before = g_wheels[w].revolution_count;
+        g_wheels[w].override = ovr;
+        wheel_model_tick(&g_wheels[w]);
+        revs += g_wheels[w].revolution_count - revs_before;
+    }
+    g_physics_us = time_us_32() - physics_start;
+
+    // Test-mode sequencer: judge this tick's state, start the next mode
+    test_seq_tick(&g_wheels[0]);
+    core_sync_state_write_end();
+
+    // Boot-monotonic totals (tick_count and revolution_count restart on RESET)
+    stats_add(STATS_PHYSICS_TICKS, 1);
+    stats_add(STATS_WHEEL_REVS, revs);
+
+    // Conditional scenario triggers see this tick's state (wheel 0)
+    scenario_eval_conditions(g_wheels[0].omega_rad_s, (uint8_t)g_wheels[0].mode);
+}
+
+/**
+ * @brief Every tick: telemetry snapshots to Core0
+ */
+static void HOT_PATH_FUNC(task_publish)(void) {
+    // Record jitter (commands + physics for the whole cluster)
+    g_tick_end_us = time_us_64();
+    g_jitter_us = (uint32_t)(g_tick_end_us - g_tick_start_us);
+
+    if (g_jitter_us > g_max_jitter_us) {
+        g_max_jitter_us = g_jitter_us;
+    }
+
+    PROF_BEGIN(PROF_CORE1_PUBLISH);
+    for (uint8_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        publish_wheel(w, g_jitter_us, g_physics_us, g_tick_end_us);
+    }
+    PROF_END(PROF_CORE1_PUBLISH);
+}
+
+/**
+ * @brief Every tick: flight recorder (all wheels, this tick)
+ */
+static void HOT_PATH_FUNC(task_recorder)(void) {
+    flight_rec_record(g_wheels, g_tick_count);
+}
+
+/**
+ * @brief Every tick: trend history buckets (all wheels, this tick)
+ */
+static void HOT_PATH_FUNC(task_trend)(void) {
+    trend_record(g_wheels);
+}
+
+/**
+ * @brief Every THERMAL_PERIOD_TICKS: thermal model and temperature warnings
+ */
+static void HOT_PATH_FUNC(task_thermal)(void) {
+    core_sync_state_write_begin();
+    for (uint8_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        thermal_tick(&g_wheels[w]);
+    }
+    core_sync_state_write_end();
+}
+
+/**
+ * @brief Idle: encode telemetry blocks for Core0 (off the measured tick)
+ */
+static void HOT_PATH_FUNC(task_blocks)(void) {
+    uint32_t serialize_start = time_us_32();
+    for (uint8_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        publish_blocks(w);
+    }
+    g_serialize_us = time_us_32() - serialize_start;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void physics_engine_init(wheel_state_t* wheels, physics_engine_snapshot_hook_t hook) {
+    g_wheels = wheels;
+    g_snapshot_hook = hook;
+
+    // Note: wheel_model_init() internally calls protection_init()
+    for (uint8_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        wheel_model_init(&g_wheels[w]);
+    }
+    test_mode_init();
+
+    // Task table (rate-monotonic: every-tick work first, in this order)
+    if (task_sched_get_count() == 0) {
+        task_sched_add("model", task_model, 1, TASK_BUDGET_MODEL_US);
+        task_sched_add("publish", task_publish, 1, TASK_BUDGET_PUBLISH_US);
+        task_sched_add_optional("recorder", task_recorder, 1, TASK_BUDGET_RECORDER_US,
+                                TASK_SCHED_PRIO_DEFER);
+        task_sched_add_optional("trend", task_trend, 1, TASK_BUDGET_TREND_US,
+                                TASK_SCHED_PRIO_SHED);
+        task_sched_add("thermal", task_thermal, THERMAL_PERIOD_TICKS, TASK_BUDGET_THERMAL_US);
+        task_sched_add("telem_blocks", task_blocks, TASK_SCHED_IDLE, TASK_BUDGET_BLOCKS_US);
+    }
+
+    // Optional work must leave the next tick its wake-up margin
+    task_sched_set_tick_budget(PHYSICS_TICK_PERIOD_US - IDLE_GUARD_US);
+}
+
+uint32_t physics_engine_get_tick_count(void) {
+    return g_tick_count;
+}
+
+void HOT_PATH_FUNC(physics_engine_request_hw_reset)(void) {
+    g_hw_reset_req++;
+}
+
+bool physics_engine_get_cmd_latency(uint8_t type, latency_summary_t* summary) {
+    if (summary == NULL) {
+        return false;
+    }
+
+    if (type == CMD_NONE) {
+        static latency_hist_t merged;  // Too large for the caller's stack
+        latency_hist_reset(&merged);
+        for (uint32_t t = 0; t < CMD_TYPE_COUNT; t++) {
+            latency_hist_merge(&merged, &g_cmd_latency[t]);
+        }
+        latency_hist_summarize(&merged, summary);
+        return true;
+    }
+
+    if (type >= CMD_TYPE_COUNT) {
+        return false;
+    }
+    latency_hist_summarize(&g_cmd_latency[type], summary);
+    return true;
+}
+
+void physics_engine_reset_cmd_latency(void) {
+    g_cmd_latency_reset_req++;
+}
+
+uint32_t physics_engine_get_hw_resets(uint32_t* applied_us) {
+    if (applied_us) {
+        *applied_us = g_hw_reset_us;
+    }
+    return g_hw_reset_done;
+}
+
+void HOT_PATH_FUNC(physics_engine_tick)(uint32_t wake_us) {
+    // Record tick start time (and this tick's alarm wake-up latency)
+    g_tick_start_us = time_us_64();
+    memset(&g_sample, 0, sizeof(g_sample));
+    g_sample.wake_us = wake_us;
+    g_sample.cmd_type = CMD_NONE;
+
+    // ====================================================================
+    // 1-3. Periodic tasks due on this tick (model, publish, recorder, ...)
+    // ====================================================================
+    task_sched_run_tick(g_tick_count);
+
+    g_tick_count++;
+
+    // ====================================================================
+    // 4. Jitter monitoring (histogram + deadline-miss ring, read by Core0)
+    // ====================================================================
+    // NOTE: Don't printf here! It will cause even more jitter.
+    g_sample.tick = g_tick_count;
+    g_sample.exec_us = g_jitter_us;
+    g_sample.mode = (uint8_t)g_wheels[0].mode;
+    g_sample.test_mode = (uint8_t)test_mode_get_active();
+    g_sample.scenario_event = scenario_get_last_event();
+    tick_trace_record(&g_sample);
+
+    // ====================================================================
+    // 5. CPU load (wake to here; idle tasks add theirs, the rest of the
+    //    period is spent in WFE)
+    // ====================================================================
+    g_busy_us = (uint32_t)(time_us_64() - g_tick_start_us);
+    g_window_busy_us += g_busy_us;
+    if (++g_window_ticks == PHYSICS_TICK_RATE_HZ) {
+        g_load_permille = (uint32_t)(((uint64_t)g_window_busy_us * 1000u) /
+                                     ((uint64_t)PHYSICS_TICK_PERIOD_US * g_window_ticks));
+        g_window_busy_us = 0;
+        g_window_ticks = 0;
+    }
+}
+
+void HOT_PATH_FUNC(physics_engine_idle)(void) {
+    uint64_t deadline_us = g_tick_start_us + PHYSICS_TICK_PERIOD_US - IDLE_GUARD_US;
+    uint32_t idle_us = task_sched_run_idle(deadline_us);
+    g_busy_us += idle_us;
+    g_window_busy_us += idle_us;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file nss_nrwa_t6_engine.h
+ * @brief Physics Engine Tick (Core1)
+ *
+ * One physics tick of the whole wheel cluster, as tasks of the Core1
+ * scheduler (util/task_sched.h): every tick, drain the Core0 command queue,
+ * step every wheel model (protection included), publish telemetry
+ * snapshots and feed the flight recorder; every THERMAL_PERIOD_TICKS, run
+ * the thermal model; in the slack after the tick, encode the APP-TELEM
+ * blocks. The tick trace and the CPU load figure close each tick. The
+ * recorder and the trend history are optional: the scheduler's budget
+ * governor defers or drops them when a tick runs long.
+ *
+ * The firmware calls physics_engine_tick() and then physics_engine_idle()
+ * from the Core1 alarm loop; the host build calls them from its physics
+ * thread, so both run the same emulator logic. Only the tick source and
+ * the per-snapshot hook differ.
+ */
+
+#ifndef NSS_NRWA_T6_ENGINE_H
+#define NSS_NRWA_T6_ENGINE_H
+
+#include <stdint.h>
+#include "nss_nrwa_t6_model.h"
+#include "util/core_sync.h"
+#include "util/latency_hist.h"
+
+/**
+ * @brief Called with every published wheel snapshot (e.g. USB stream)
+ */
+typedef void (*physics_engine_snapshot_hook_t)(const telemetry_snapshot_t* snapshot);
+
+/**
+ * @brief Initialize the wheel models and test mode framework
+ *
+ * @param wheels Wheel state array (EMULATED_WHEEL_COUNT, owned by Core1)
+ * @param hook Snapshot hook (NULL = none)
+ */
+void physics_engine_init(wheel_state_t* wheels, physics_engine_snapshot_hook_t hook);
+
+/**
+ * @brief Run one physics tick
+ *
+ * @param wake_us Alarm-to-wake latency of this tick (for the tick trace)
+ */
+void physics_engine_tick(uint32_t wake_us);
+
+/**
+ * @brief Run the idle-time tasks that fit before the next tick
+ *
+ * Call after every physics_engine_tick(), before sleeping.
+ */
+void physics_engine_idle(void);
+
+/**
+ * @brief Get the number of completed ticks
+ *
+ * @return Ticks since physics_engine_init()
+ */
+uint32_t physics_engine_get_tick_count(void);
+
+/**
+ * @brief Request a hardware RESET of every wheel (Core1, e.g. the RESET pin ISR)
+ *
+ * Applied at the start of the next tick, before that tick's commands:
+ * each wheel is re-initialized with default protection, which clears the
+ * latched faults and the LCL trip. The rotor keeps its speed and the
+ * temperatures carry over, as on the real unit.
+ */
+void physics_engine_request_hw_reset(void);
+
+/**
+ * @brief Get the number of hardware RESETs applied
+ *
+ * @param applied_us Output: time_us_32() when the last one was applied (may be NULL)
+ * @return Resets applied since boot
+ */
+uint32_t physics_engine_get_hw_resets(uint32_t* applied_us);
+
+/**
+ * @brief Get the command latency summary for one command type
+ *
+ * Latency runs from the command's receive time (the NSP frame END, or the
+ * queue time for console commands) to the start of the tick that applied
+ * it: NSP service, queue wait and tick phase together, the emulator's
+ * actuator latency.
+ *
+ * @param type Command type (CMD_NONE = every type merged)
+ * @param summary Output: percentiles in µs
+ * @return true if type is valid
+ */
+bool physics_engine_get_cmd_latency(uint8_t type, latency_summary_t* summary);
+
+/**
+ * @brief Clear the command latency histograms (applied by Core1 at its next tick)
+ */
+void physics_engine_reset_cmd_latency(void);
+
+#endif // NSS_NRWA_T6_ENGINE_H
@@ -5,10 +5,27 @@
 
 #include "nss_nrwa_t6_model.h"
 #include "nss_nrwa_t6_protection.h"
+#include "nss_nrwa_t6_thermal.h"
+#include "hot_path.h"
+#include "profiler.h"
+#include "dlog.h"
 #include <math.h>
 #include <string.h>
 #include <stdio.h>
 
+// Low-speed thresholds shared by the float and fixed-point dynamics paths
+#define OMEGA_FRICTION_THRESHOLD_RAD_S  0.01f   // Coulomb ramp below this (~0.1 RPM)
+#define STICTION_OMEGA_THRESHOLD_RAD_S  0.5f    // Hold at zero below this (~5 RPM) ...
+#define STICTION_CURRENT_THRESHOLD_A    0.01f   // ... with less than 10 mA applied
+
+// Unit folds, so the float paths multiply instead of divide
+#define MOTOR_KT_MNM_PER_A      (MOTOR_KT_NM_PER_A * 1000.0f)               // mN·m per A
+#define MNM_TO_ALPHA            (1.0f / (1000.0f * WHEEL_INERTIA_KGM2))     // mN·m → rad/s²
+#define LOSS_VISCOUS_A_MNM      (LOSS_VISCOUS_A * 1000.0f)
+#define LOSS_COULOMB_B_MNM      (LOSS_COULOMB_B * 1000.0f)
+#define LOSS_COPPER_C_MNM       (LOSS_COPPER_C * 1000.0f)
+#define FRICTION_RAMP_PER_RAD_S (1.0f / OMEGA_FRICTION_THRESHOLD_RAD_S)
+
 // ============================================================================
 // Internal Helper Functions
 // ============================================================================
@@ -16,7 +33,7 @@
 /**
  * @brief Sign function (returns -1, 0, or +1)
  */
-static inline float sign(float x) {
+static inline float HOT_PATH_FUNC(sign)(float x) {
     if (x > 0.0f) return 1.0f;
     if (x < 0.0f) return -1.0f;
     return 0.0f;
@@ -25,7 +42,7 @@ static inline float sign(float x) {
 /**
  * @brief Clamp value to range [min, max]
  */
-static inline float clamp(float value, float min_val, float max_val) {
+static inline float HOT_PATH_FUNC(clamp)(float value, float min_val, float max_val) {
     if (value < min_val) return min_val;
     if (value > max_val) return max_val;
     return value;
@@ -39,10 +56,9 @@ static inline float clamp(float value, float min_val, float max_val) {
  * @param current_a Motor current in A
  * @return Motor torque in mN·m
  */
-static float calculate_motor_torque(float current_a) {
-    // k_t = 0.0534 N·m/A
-    float torque_nm = MOTOR_KT_NM_PER_A * current_a;
-    return torque_nm * 1000.0f;  // Convert to mN·m
+static float HOT_PATH_FUNC(calculate_motor_torque)(float current_a) {
+    // k_t = 0.0534 N·m/A, folded to mN·m/A
+    return MOTOR_KT_MNM_PER_A * current_a;
 }
 
 /**
@@ -57,54 +73,335 @@ static float calculate_motor_torque(float current_a) {
  * @param current_a Motor current in A
  * @return Loss torque in mN·m
  */
-static float calculate_loss_torque(float omega_rad_s, float current_a) {
+static float HOT_PATH_FUNC(calculate_loss_torque)(float omega_rad_s, float current_a) {
+    float omega_abs = fabsf(omega_rad_s);
+
     // Viscous loss: a·|ω| (proportional to speed magnitude)
-    float loss_viscous = LOSS_VISCOUS_A * fabsf(omega_rad_s);
+    float loss_viscous = LOSS_VISCOUS_A_MNM * omega_abs;
 
     // Coulomb friction: b·scale (smooth ramp from 0 to full friction)
     // Instead of a hard cutoff at low speeds, use a smooth ramp to avoid
     // the wheel "floating" when Coulomb friction disappears at zero.
     // This ensures friction is always present when moving, even slightly.
-    const float OMEGA_FRICTION_THRESHOLD = 0.01f;  // rad/s (~0.1 RPM)
-    float omega_abs = fabsf(omega_rad_s);
-    float friction_scale;
-    if (omega_abs >= OMEGA_FRICTION_THRESHOLD) {
-        friction_scale = 1.0f;  // Full friction above threshold
+    float loss_coulomb;
+    if (omega_abs >= OMEGA_FRICTION_THRESHOLD_RAD_S) {
+        loss_coulomb = LOSS_COULOMB_B_MNM;  // Full friction above threshold
     } else {
         // Linear ramp from 0 to full friction
-        friction_scale = omega_abs / OMEGA_FRICTION_THRESHOLD;
+        loss_coulomb = LOSS_COULOMB_B_MNM * FRICTION_RAMP_PER_RAD_S * omega_abs;
     }
-    float loss_coulomb = LOSS_COULOMB_B * friction_scale;
 
     // Copper loss: c·i² (resistive losses in motor windings)
-    float loss_copper = LOSS_COPPER_C * current_a * current_a;
+    float loss_copper = LOSS_COPPER_C_MNM * current_a * current_a;
+
+    // Total loss MAGNITUDE (mN·m) - direction applied in update_dynamics()
+    return loss_viscous + loss_coulomb + loss_copper;
+}
 
-    // Total loss MAGNITUDE (N·m) - direction applied in update_dynamics()
-    float loss_nm = loss_viscous + loss_coulomb + loss_copper;
+/**
+ * @brief Angular acceleration for a given ω (the dynamics ODE right-hand side)
+ *
+ * α(ω) = (τ_motor - sign(ω)·τ_loss(ω, i)) / I
+ *
+ * @param torque_motor_mnm Signed motor torque (held over the tick)
+ * @param omega_rad_s Angular velocity to evaluate at
+ * @param current_a Motor current (for copper loss)
+ * @param torque_loss_mnm Output: loss torque magnitude at ω (can be NULL)
+ * @return Angular acceleration in rad/s²
+ */
+static inline float HOT_PATH_FUNC(dynamics_alpha)(float torque_motor_mnm, float omega_rad_s, float current_a,
+                                                  float* torque_loss_mnm) {
+    // Calculate loss torque (opposes motion)
+    float loss_mnm = calculate_loss_torque(omega_rad_s, current_a);
+    if (torque_loss_mnm) {
+        *torque_loss_mnm = loss_mnm;
+    }
 
-    return loss_nm * 1000.0f;  // Convert to mN·m
+    // Net torque (mN·m) - loss always opposes current velocity direction
+    float torque_net_mnm = torque_motor_mnm - (sign(omega_rad_s) * loss_mnm);
+
+    // Angular acceleration: α = τ / I (mN·m → N·m folded in)
+    return torque_net_mnm * MNM_TO_ALPHA;
+}
+
+/**
+ * @brief Zero-crossing detection
+ *
+ * If the wheel would cross zero under a motor torque too weak to overcome
+ * static friction, it stops instead. This prevents oscillation when
+ * friction would cause overshoot.
+ *
+ * @return Possibly clamped ω_new
+ */
+static inline float HOT_PATH_FUNC(dynamics_zero_cross)(float omega_old, float omega_new, float torque_motor_mnm) {
+    if ((omega_old > 0.0f && omega_new < 0.0f) ||
+        (omega_old < 0.0f && omega_new > 0.0f)) {
+        // Velocity would change sign - wheel is stopping
+        // Only allow if motor torque is strong enough to reverse direction
+        // Static friction threshold, compared in mN·m
+        if (fabsf(torque_motor_mnm) < LOSS_COULOMB_B_MNM) {
+            // Motor torque not strong enough to overcome static friction
+            return 0.0f;
+        }
+    }
+    return omega_new;
+}
+
+// ============================================================================
+// Fixed-Point Dynamics Kernel (INTEGRATOR_FIXED, INTEGRATOR_LUT)
+// ============================================================================
+//
+// Same Euler step as update_dynamics(), with k_t, the loss coefficients, 1/I
+// and Δt folded into per-tick Q-format constants so the kernel is integer
+// multiply/add only. Every term is a Δω per tick in Q16.16 rad/s.
+//
+// The coefficients grow with Δt. Small ones (< 1 at every tick rate) are
+// Q8.24 for precision; the Coulomb ramp, b·Δt/(I·ω_f), reaches the
+// hundreds at 10 Hz and is Q16.16. The asserts below reject a tick rate or
+// wheel profile that pushes any of them out of its format.
+
+#define FX_DW_MOTOR_PER_A_F     (MOTOR_KT_NM_PER_A * MODEL_DT_S / WHEEL_INERTIA_KGM2)
+#define FX_DW_VISCOUS_F         (LOSS_VISCOUS_A * MODEL_DT_S / WHEEL_INERTIA_KGM2)
+#define FX_DW_COULOMB_F         (LOSS_COULOMB_B * MODEL_DT_S / WHEEL_INERTIA_KGM2)
+#define FX_DW_COULOMB_RAMP_F    (FX_DW_COULOMB_F / OMEGA_FRICTION_THRESHOLD_RAD_S)
+#define FX_DW_COPPER_PER_A2_F   (LOSS_COPPER_C * MODEL_DT_S / WHEEL_INERTIA_KGM2)
+#define FX_CURRENT_BREAKAWAY_F  (LOSS_COULOMB_B / MOTOR_KT_NM_PER_A)  // k_t·i = b
+
+#define FX_DW_MOTOR_PER_A   Q8_24_CONST(FX_DW_MOTOR_PER_A_F)
+#define FX_DW_VISCOUS       Q8_24_CONST(FX_DW_VISCOUS_F)
+#define FX_DW_COULOMB       Q16_16_CONST(FX_DW_COULOMB_F)
+#define FX_DW_COULOMB_RAMP  Q16_16_CONST(FX_DW_COULOMB_RAMP_F)
+#define FX_DW_COPPER_PER_A2 Q8_24_CONST(FX_DW_COPPER_PER_A2_F)
+
+#define FX_OMEGA_FRICTION   Q16_16_CONST(OMEGA_FRICTION_THRESHOLD_RAD_S)
+#define FX_OMEGA_STICTION   Q16_16_CONST(STICTION_OMEGA_THRESHOLD_RAD_S)
+#define FX_CURRENT_STICTION Q16_16_CONST(STICTION_CURRENT_THRESHOLD_A)
+#define FX_CURRENT_BREAKAWAY Q16_16_CONST(FX_CURRENT_BREAKAWAY_F)
+
+_Static_assert(Q8_24_CONST_FITS(FX_DW_MOTOR_PER_A_F), "k_t*dt/I exceeds Q8.24 at this tick rate");
+_Static_assert(Q8_24_CONST_FITS(FX_DW_VISCOUS_F), "a*dt/I exceeds Q8.24 at this tick rate");
+_Static_assert(Q16_16_CONST_FITS(FX_DW_COULOMB_F), "b*dt/I exceeds Q16.16 at this tick rate");
+_Static_assert(Q16_16_CONST_FITS(FX_DW_COULOMB_RAMP_F), "Coulomb ramp exceeds Q16.16 at this tick rate");
+_Static_assert(Q8_24_CONST_FITS(FX_DW_COPPER_PER_A2_F), "c*dt/I exceeds Q8.24 at this tick rate");
+_Static_assert(Q16_16_CONST_FITS(FX_CURRENT_BREAKAWAY_F), "Breakaway current exceeds Q16.16");
+
+// Telemetry scale factors (Q16.16 Δω/tick → float)
+#define FX_TO_RAD_S         (1.0f / (float)Q16_16_ONE)
+#define FX_DW_TO_ALPHA      ((float)MODEL_TICK_RATE_HZ / (float)Q16_16_ONE)
+#define FX_DW_TO_MNM        (WHEEL_INERTIA_KGM2 * 1000.0f * (float)MODEL_TICK_RATE_HZ / (float)Q16_16_ONE)
+
+// Loss table span: breakpoints cover 0 .. LOSS_LUT_SPAN × overspeed fault
+#define LOSS_LUT_SPAN       1.25f
+
+/**
+ * @brief Speed-loss table of the LUT integrator (built once at init)
+ */
+typedef struct {
+    q16_16_t dw[LOSS_LUT_SEGMENTS + 1];     // Δω/tick of the loss at |ω| = k << shift
+    uint32_t shift;                         // log2 of the breakpoint spacing (Q16.16)
+    q16_16_t ramp;                          // dw[0] / friction threshold (Coulomb ramp)
+    q16_16_t breakaway_a;                   // Current whose motor torque overcomes dw[0]
+    bool built;
+} loss_lut_t;
+
+static loss_lut_t HOT_PATH_DATA("model") loss_lut;
+
+/**
+ * @brief Speed-dependent loss of the active profile at one speed (init only)
+ *
+ * @param omega_abs |ω| in rad/s
+ * @return Loss torque in mN·m (without the copper term)
+ */
+static float loss_curve_mnm(float omega_abs) {
+    const wheel_profile_t* p = wheel_profile_active();
+    if (p->loss_curve_mnm == NULL || p->loss_curve_points < 2 || p->loss_curve_step_rpm <= 0.0f) {
+        return LOSS_VISCOUS_A_MNM * omega_abs + LOSS_COULOMB_B_MNM;
+    }
+
+    // Linear between the characterized points, extrapolated past the last
+    float x = omega_abs * RAD_S_TO_RPM / p->loss_curve_step_rpm;
+    uint32_t i = (uint32_t)x;
+    if (i > p->loss_curve_points - 2u) {
+        i = p->loss_curve_points - 2u;
+    }
+    float y0 = p->loss_curve_mnm[i];
+    return y0 + (p->loss_curve_mnm[i + 1u] - y0) * (x - (float)i);
+}
+
+/**
+ * @brief Resample the profile's loss curve into the Q16.16 table
+ */
+static void loss_lut_build(void) {
+    // Smallest power-of-two spacing whose segments span the speed range
+    float span_fx = LOSS_LUT_SPAN * DEFAULT_OVERSPEED_FAULT_RPM * RPM_TO_RAD_S * (float)Q16_16_ONE;
+    uint32_t shift = 0;
+    while ((float)((uint64_t)LOSS_LUT_SEGMENTS << shift) < span_fx) {
+        shift++;
+    }
+
+    float step_rad_s = (float)(1u << shift) * FX_TO_RAD_S;
+    for (uint32_t k = 0; k <= LOSS_LUT_SEGMENTS; k++) {
+        float mnm = loss_curve_mnm((float)k * step_rad_s);
+        loss_lut.dw[k] = float_to_q16_16(mnm * MNM_TO_ALPHA * MODEL_DT_S);
+    }
+
+    float dw0 = q16_16_to_float(loss_lut.dw[0]);
+    loss_lut.shift = shift;
+    loss_lut.ramp = float_to_q16_16(dw0 / OMEGA_FRICTION_THRESHOLD_RAD_S);
+    loss_lut.breakaway_a = float_to_q16_16(loss_curve_mnm(0.0f) / MOTOR_KT_MNM_PER_A);
+    loss_lut.built = true;
+}
+
+/**
+ * @brief Speed loss from the table (Δω/tick, Q16.16)
+ *
+ * Below the friction threshold the Coulomb part ramps in as in FIXED.
+ */
+static inline q16_16_t HOT_PATH_FUNC(loss_lut_dw)(q16_16_t omega_abs) {
+    if (omega_abs < FX_OMEGA_FRICTION) {
+        return q16_16_mul(omega_abs, loss_lut.ramp);
+    }
+
+    uint32_t shift = loss_lut.shift;
+    uint32_t k = (uint32_t)omega_abs >> shift;
+    if (k >= LOSS_LUT_SEGMENTS) {
+        k = LOSS_LUT_SEGMENTS - 1u;     // Extrapolate the last segment
+    }
+    int32_t frac = omega_abs - (int32_t)(k << shift);
+    q16_16_t y0 = loss_lut.dw[k];
+    return y0 + (q16_16_t)(((int64_t)(loss_lut.dw[k + 1u] - y0) * frac) >> shift);
+}
+
+/**
+ * @brief Fixed-point Euler step (see update_dynamics() for the model)
+ *
+ * Used by FIXED and LUT, which differ only in the speed-loss term.
+ *
+ * Float is touched only at the edges: the current from the control law is
+ * converted in, and ω/α/τ are published for protections and telemetry.
+ *
+ * @param state Pointer to wheel state structure
+ */
+static void HOT_PATH_FUNC(update_dynamics_fixed)(wheel_state_t* state) {
+    // Pick up external writes to ω (reset, tests) before stepping
+    if (state->omega_rad_s != state->omega_fx_published) {
+        state->omega_fx = float_to_q16_16(state->omega_rad_s);
+    }
+
+    q16_16_t omega = state->omega_fx;
+    q16_16_t current = float_to_q16_16(state->current_out_a);
+    q16_16_t omega_abs = q16_16_abs(omega);
+    q16_16_t current_abs = q16_16_abs(current);
+
+    // Stiction hold (same thresholds as the float path)
+    if (omega_abs < FX_OMEGA_STICTION && current_abs < FX_CURRENT_STICTION) {
+        state->omega_fx = 0;
+        state->omega_fx_published = 0.0f;
+        state->omega_rad_s = 0.0f;
+        state->momentum_nms = 0.0f;
+        state->torque_out_mnm = 0.0f;
+        state->torque_loss_mnm = 0.0f;
+        state->alpha_rad_s2 = 0.0f;
+        state->power_w = 0.0f;
+        return;
+    }
+
+    // Motor term (direction inverts motor torque)
+    q16_16_t current_signed = (state->direction == DIRECTION_POSITIVE) ? current : -current;
+    q16_16_t dw_motor = q16_16_mul_q8_24(current_signed, FX_DW_MOTOR_PER_A);
+
+    // Loss magnitude: a·|ω| + b·ramp(|ω|) (or the table) + c·i²
+    bool lut = (state->integrator == INTEGRATOR_LUT);
+    q16_16_t dw_loss;
+    if (lut) {
+        dw_loss = loss_lut_dw(omega_abs);
+    } else {
+        dw_loss = q16_16_mul_q8_24(omega_abs, FX_DW_VISCOUS);
+        if (omega_abs >= FX_OMEGA_FRICTION) {
+            dw_loss = q16_16_add(dw_loss, FX_DW_COULOMB);
+        } else {
+            dw_loss = q16_16_add(dw_loss, q16_16_mul(omega_abs, FX_DW_COULOMB_RAMP));
+        }
+    }
+    dw_loss = q16_16_add(dw_loss, q16_16_mul_q8_24(q16_16_mul(current, current),
+                                                   FX_DW_COPPER_PER_A2));
+
+    // Loss opposes the current direction of motion
+    q16_16_t dw = dw_motor;
+    if (omega > 0) {
+        dw = q16_16_add(dw, -dw_loss);
+    } else if (omega < 0) {
+        dw = q16_16_add(dw, dw_loss);
+    }
+
+    q16_16_t omega_new = q16_16_add(omega, dw);
+
+    // Zero crossing: stop unless the motor can overcome static friction
+    q16_16_t breakaway = lut ? loss_lut.breakaway_a : FX_CURRENT_BREAKAWAY;
+    if (((omega > 0 && omega_new < 0) || (omega < 0 && omega_new > 0)) &&
+        current_abs < breakaway) {
+        omega_new = 0;
+    }
+
+    // Publish
+    state->omega_fx = omega_new;
+    state->omega_rad_s = (float)omega_new * FX_TO_RAD_S;
+    state->omega_fx_published = state->omega_rad_s;
+    state->momentum_nms = WHEEL_INERTIA_KGM2 * state->omega_rad_s;
+    state->torque_out_mnm = (float)dw_motor * FX_DW_TO_MNM;
+    state->torque_loss_mnm = (float)dw_loss * FX_DW_TO_MNM;
+    state->alpha_rad_s2 = (float)dw * FX_DW_TO_ALPHA;
+    state->power_w = (state->torque_out_mnm * 0.001f) * state->omega_rad_s;
 }
 
 /**
  * @brief Update dynamics for one timestep
  *
  * α = (τ_motor - τ_loss) / I
- * ω_new = ω_old + α·Δt
+ * ω_new = ω_old + ∫α·dt   (Euler, N Euler sub-steps, or N RK4 sub-steps)
  * H = I·ω
  *
  * @param state Pointer to wheel state structure
  */
-static void update_dynamics(wheel_state_t* state) {
+/**
+ * @brief Clamp ω to an injected speed limit after the step
+ *
+ * @param state Pointer to wheel state structure
+ * @param ovr Active override (non-NULL)
+ */
+static void HOT_PATH_FUNC(apply_speed_override)(wheel_state_t* state, const physics_override_t* ovr) {
+    float limit = ovr->speed_limit_rad_s;
+    if (fabsf(state->omega_rad_s) <= limit) {
+        return;
+    }
+
+    state->omega_rad_s = (state->omega_rad_s > 0.0f) ? limit : -limit;
+    state->momentum_nms = WHEEL_INERTIA_KGM2 * state->omega_rad_s;
+    state->power_w = (state->torque_out_mnm / 1000.0f) * state->omega_rad_s;
+    if (state->integrator >= INTEGRATOR_FIXED) {
+        state->omega_fx = float_to_q16_16(state->omega_rad_s);
+        state->omega_fx_published = state->omega_rad_s;
+    }
+}
+
+static void HOT_PATH_FUNC(update_dynamics)(wheel_state_t* state) {
+    const physics_override_t* ovr = state->override;
+
+    if (state->integrator >= INTEGRATOR_FIXED) {
+        update_dynamics_fixed(state);
+        if (ovr != NULL && (ovr->flags & PHYS_OVR_SPEED_LIMIT)) {
+            apply_speed_override(state, ovr);
+        }
+        return;
+    }
+
     // ========================================================================
     // Stiction Check: If wheel is nearly stopped with no motor torque, hold at zero
     // ========================================================================
     // This prevents numerical oscillation around zero caused by Coulomb friction
     // being stronger than the wheel's momentum at low speeds.
-    const float STICTION_OMEGA_THRESHOLD = 0.5f;  // rad/s (~5 RPM)
-    const float STICTION_CURRENT_THRESHOLD = 0.01f;  // A (10 mA)
-
-    if (fabsf(state->omega_rad_s) < STICTION_OMEGA_THRESHOLD &&
-        fabsf(state->current_out_a) < STICTION_CURRENT_THRESHOLD) {
+    if (fabsf(state->omega_rad_s) < STICTION_OMEGA_THRESHOLD_RAD_S &&
+        fabsf(state->current_out_a) < STICTION_CURRENT_THRESHOLD_A) {
         // No motor torque applied and wheel is nearly stopped - hold at zero
         state->omega_rad_s = 0.0f;
         state->momentum_nms = 0.0f;
@@ -122,45 +419,50 @@ static void update_dynamics(wheel_state_t* state) {
     // Calculate motor torque from output current
     float torque_motor_mnm = calculate_motor_torque(state->current_out_a);
 
-    // Calculate loss torque (opposes motion)
-    float torque_loss_mnm = calculate_loss_torque(state->omega_rad_s, state->current_out_a);
-
     // Apply direction (negative direction inverts motor torque)
     float direction_sign = (state->direction == DIRECTION_POSITIVE) ? 1.0f : -1.0f;
     torque_motor_mnm *= direction_sign;
 
-    // Loss torque always opposes motion direction
-    float loss_sign = sign(state->omega_rad_s);
-
-    // Net torque (mN·m) - loss always opposes current velocity direction
-    float torque_net_mnm = torque_motor_mnm - (loss_sign * torque_loss_mnm);
-    float torque_net_nm = torque_net_mnm / 1000.0f;  // Convert to N·m
-
-    // Angular acceleration: α = τ / I
-    float alpha_rad_s2 = torque_net_nm / WHEEL_INERTIA_KGM2;
-
-    // Calculate new velocity
+    // Acceleration and loss at the start of the tick (reported in telemetry)
+    float current_a = state->current_out_a;
     float omega_old = state->omega_rad_s;
-    float omega_new = omega_old + alpha_rad_s2 * MODEL_DT_S;
-
-    // ========================================================================
-    // Zero-Crossing Detection
-    // ========================================================================
-    // If the wheel was decelerating and would cross zero, clamp to zero.
-    // This prevents oscillation when friction would cause overshoot.
-    // A wheel that was spinning and then stopped should stay stopped unless
-    // motor torque is applied.
-    if ((omega_old > 0.0f && omega_new < 0.0f) ||
-        (omega_old < 0.0f && omega_new > 0.0f)) {
-        // Velocity would change sign - wheel is stopping
-        // Only allow if motor torque is strong enough to reverse direction
-        float motor_torque_nm = fabsf(torque_motor_mnm) / 1000.0f;
-        float static_friction_nm = LOSS_COULOMB_B;  // Static friction threshold
-
-        if (motor_torque_nm < static_friction_nm) {
-            // Motor torque not strong enough to overcome static friction
-            omega_new = 0.0f;
+    float torque_loss_mnm;
+    float alpha_rad_s2 = dynamics_alpha(torque_motor_mnm, omega_old, current_a, &torque_loss_mnm);
+
+    float omega_new;
+    if (state->integrator == INTEGRATOR_EULER) {
+        // Single explicit Euler step (reference behaviour)
+        omega_new = dynamics_zero_cross(omega_old,
+                                        omega_old + alpha_rad_s2 * MODEL_DT_S,
+                                        torque_motor_mnm);
+    } else {
+        uint32_t n = state->integrator_substeps;
+        float h = MODEL_DT_S / (float)n;
+        float omega = omega_old;
+        float k1 = alpha_rad_s2;
+
+        for (uint32_t step = 0; step < n; step++) {
+            float next;
+            if (state->integrator == INTEGRATOR_RK4) {
+                float k2 = dynamics_alpha(torque_motor_mnm, omega + 0.5f * h * k1, current_a, NULL);
+                float k3 = dynamics_alpha(torque_motor_mnm, omega + 0.5f * h * k2, current_a, NULL);
+                float k4 = dynamics_alpha(torque_motor_mnm, omega + h * k3, current_a, NULL);
+                next = omega + (h / 6.0f) * (k1 + 2.0f * k2 + 2.0f * k3 + k4);
+            } else {
+                next = omega + k1 * h;
+            }
+
+            // Per-step zero-crossing check locates the stop within the tick
+            omega = dynamics_zero_cross(omega, next, torque_motor_mnm);
+            if (omega == 0.0f && next != 0.0f) {
+                break;  // Stopped by static friction - stays stopped this tick
+            }
+
+            if (step + 1 < n) {
+                k1 = dynamics_alpha(torque_motor_mnm, omega, current_a, NULL);
+            }
         }
+        omega_new = omega;
     }
 
     state->omega_rad_s = omega_new;
@@ -174,7 +476,20 @@ static void update_dynamics(wheel_state_t* state) {
     state->alpha_rad_s2 = alpha_rad_s2;
 
     // Calculate electrical power: P = τ·ω
-    state->power_w = (torque_motor_mnm / 1000.0f) * state->omega_rad_s;
+    state->power_w = (torque_motor_mnm * 0.001f) * state->omega_rad_s;
+
+    if (ovr != NULL && (ovr->flags & PHYS_OVR_SPEED_LIMIT)) {
+        apply_speed_override(state, ovr);
+    }
+}
+
+/**
+ * @brief |x| as its IEEE-754 bit pattern (orders like the magnitude)
+ */
+static inline int32_t HOT_PATH_FUNC(float_magnitude_bits)(float x) {
+    int32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return bits & 0x7FFFFFFF;
 }
 
 /**
@@ -184,7 +499,7 @@ static void update_dynamics(wheel_state_t* state) {
  *
  * @param state Pointer to wheel state structure
  */
-static void check_protections(wheel_state_t* state) {
+static void HOT_PATH_FUNC(check_protections)(wheel_state_t* state) {
     uint32_t new_faults = 0;
     uint32_t new_warnings = 0;
 
@@ -199,41 +514,35 @@ static void check_protections(wheel_state_t* state) {
     state->fault_status = 0;
     state->warning_status = 0;
 
-    float speed_rpm = fabsf(wheel_model_get_speed_rpm(state));
-
-    // Check overspeed fault (hard, latched)
-    if (state->protection_enable & PROT_ENABLE_OVERSPEED) {
-        if (speed_rpm > state->overspeed_fault_rpm) {
-            new_faults |= FAULT_OVERSPEED;
-        }
+    // Magnitudes as float bit patterns against the native threshold block
+    // (integer compares only; see protection_native_t)
+    const protection_native_t* lim = &state->prot_native;
+    int32_t omega = float_magnitude_bits(state->omega_rad_s);
+    int32_t power = float_magnitude_bits(state->power_w);
+    int32_t current = float_magnitude_bits(state->current_out_a);
+    uint32_t enable = state->protection_enable;
+
+    // Overspeed fault (hard, latched) and warning (soft, non-latching)
+    if ((enable & PROT_ENABLE_OVERSPEED) && omega > lim->overspeed_fault_rad_s) {
+        new_faults |= FAULT_OVERSPEED;
     }
-
-    // Check overspeed warning (soft, non-latching)
-    if (state->protection_enable & PROT_ENABLE_SOFT_OVERSPEED) {
-        if (speed_rpm > state->overspeed_soft_rpm) {
-            new_warnings |= WARN_SOFT_OVERSPEED;
-        }
+    if ((enable & PROT_ENABLE_SOFT_OVERSPEED) && omega > lim->overspeed_soft_rad_s) {
+        new_warnings |= WARN_SOFT_OVERSPEED;
     }
 
-    // Check overpower (hard, latched)
-    if (state->protection_enable & PROT_ENABLE_OVERPOWER) {
-        if (fabsf(state->power_w) > state->motor_overpower_limit_w) {
-            new_faults |= FAULT_OVERPOWER;
-        }
+    // Overpower (hard, latched)
+    if ((enable & PROT_ENABLE_OVERPOWER) && power > lim->overpower_w) {
+        new_faults |= FAULT_OVERPOWER;
     }
 
-    // Check soft overcurrent (warning)
-    if (state->protection_enable & PROT_ENABLE_SOFT_OVERCURR) {
-        if (fabsf(state->current_out_a) > state->soft_overcurrent_a) {
-            new_warnings |= WARN_SOFT_OVERCURRENT;
-        }
+    // Soft overcurrent (warning)
+    if ((enable & PROT_ENABLE_SOFT_OVERCURR) && current > lim->soft_overcurrent_a) {
+        new_warnings |= WARN_SOFT_OVERCURRENT;
     }
 
-    // Check overvoltage (hard, latched)
-    if (state->protection_enable & PROT_ENABLE_OVERVOLTAGE) {
-        if (state->voltage_v > state->overvoltage_threshold_v) {
-            new_faults |= FAULT_OVERVOLTAGE;
-        }
+    // Overvoltage (hard, latched)
+    if ((enable & PROT_ENABLE_OVERVOLTAGE) && state->voltage_v > lim->overvoltage_v) {
+        new_faults |= FAULT_OVERVOLTAGE;
     }
 
     // Update fault status
@@ -244,21 +553,20 @@ static void check_protections(wheel_state_t* state) {
 
     state->fault_latch |= new_faults;  // Latch new faults
 
-    // Update warning status
-    state->warning_status = new_warnings;
+    // Update warning status (temperature warnings come from the thermal task)
+    state->warning_status = new_warnings | state->thermal.warnings;
 
     // Increment diagnostic counters for newly detected faults (ICD Table 12-19)
     if (newly_latched != 0) {
         state->drive_fault_count++;  // General fault counter
     }
-    // Note: drive_overtemp_count would be incremented by temperature monitoring
-    // (not implemented - thermal model is future work)
+    // Note: drive_overtemp_count is incremented by the thermal task
 
     // Hard faults trip the LCL (requires hardware reset to recover)
     // Per ICD: Overvoltage and hard overspeed trip LCL
     if (new_faults & (FAULT_OVERVOLTAGE | FAULT_OVERSPEED)) {
         state->lcl_tripped = true;
-        printf("[WHEEL] LCL TRIPPED: Hard fault detected (0x%08X)\n", new_faults);
+        DLOG("[WHEEL] LCL TRIPPED: Hard fault detected (0x%08X)\n", new_faults);
         // Note: FAULT pin assertion handled by gpio_map layer
     }
 
@@ -273,25 +581,46 @@ static void check_protections(wheel_state_t* state) {
  *
  * @param state Pointer to wheel state structure
  */
-static void apply_limits(wheel_state_t* state) {
-    // Power limit: |τ·ω| ≤ P_lim
+static void HOT_PATH_FUNC(apply_limits)(wheel_state_t* state) {
+    const control_coeffs_t* c = &state->control;
+
+    // Power limit: |τ·ω| ≤ P_lim → |i| ≤ (P_lim / k_t) / |ω|
     if (state->protection_enable & PROT_ENABLE_OVERPOWER) {
         float omega_abs = fabsf(state->omega_rad_s);
         if (omega_abs > 0.001f) {  // Avoid division by near-zero
-            float max_torque_nm = state->motor_overpower_limit_w / omega_abs;
-            float max_current_a = max_torque_nm / MOTOR_KT_NM_PER_A;
+            float max_current_a = c->overpower_a_rad_s / omega_abs;
             state->current_out_a = clamp(state->current_out_a, -max_current_a, max_current_a);
         }
     }
 
-    // Current limit
-    state->current_out_a = clamp(state->current_out_a, -state->soft_overcurrent_a, state->soft_overcurrent_a);
+    // Current and duty cycle limit in one clamp (simplified: duty ∝ current).
+    // In a real motor driver, duty cycle is modulated by BEMF; for this
+    // model, max duty corresponds to max current.
+    state->current_out_a = clamp(state->current_out_a, -c->current_limit_a, c->current_limit_a);
+
+    // Injected overrides (one load and compare when none is active)
+    const physics_override_t* ovr = state->override;
+    if (ovr == NULL) {
+        return;
+    }
 
-    // Duty cycle limit (simplified: duty ∝ current)
-    // In a real motor driver, duty cycle is modulated by BEMF
-    // For this model, we assume max duty corresponds to max current
-    float max_current_from_duty = state->soft_overcurrent_a * (state->max_duty_cycle_pct / 100.0f);
-    state->current_out_a = clamp(state->current_out_a, -max_current_from_duty, max_current_from_duty);
+    if (ovr->flags & PHYS_OVR_TORQUE) {
+        // Forced rotor torque: motor current that produces it (direction
+        // sign undone), no limits
+        float direction_sign = (state->direction == DIRECTION_POSITIVE) ? 1.0f : -1.0f;
+        state->current_out_a = direction_sign * ovr->torque_mnm / (MOTOR_KT_NM_PER_A * 1000.0f);
+        return;
+    }
+    if (ovr->flags & PHYS_OVR_POWER_LIMIT) {
+        float omega_abs = fabsf(state->omega_rad_s);
+        if (omega_abs > 0.001f) {
+            float max_current_a = ovr->power_limit_w / omega_abs / MOTOR_KT_NM_PER_A;
+            state->current_out_a = clamp(state->current_out_a, -max_current_a, max_current_a);
+        }
+    }
+    if (ovr->flags & PHYS_OVR_CURRENT_LIMIT) {
+        state->current_out_a = clamp(state->current_out_a, -ovr->current_limit_a, ovr->current_limit_a);
+    }
 }
 
 // ============================================================================
@@ -303,7 +632,7 @@ static void apply_limits(wheel_state_t* state) {
  *
  * i_out = i_cmd
  */
-static void control_mode_current(wheel_state_t* state) {
+static void HOT_PATH_FUNC(control_mode_current)(wheel_state_t* state) {
     state->current_out_a = state->current_cmd_a;
 }
 
@@ -313,7 +642,7 @@ static void control_mode_current(wheel_state_t* state) {
  * e = ω_setpoint - ω_actual
  * i_out = Kp·e + Ki·∫e
  */
-static void control_mode_speed(wheel_state_t* state) {
+static void HOT_PATH_FUNC(control_mode_speed)(wheel_state_t* state) {
     // Convert command from RPM to rad/s
     float omega_setpoint = state->speed_cmd_rpm * RPM_TO_RAD_S;
     float omega_actual = state->omega_rad_s;
@@ -327,8 +656,8 @@ static void control_mode_speed(wheel_state_t* state) {
     // Integral term with anti-windup
     state->pi_error_integral += error_rad_s * MODEL_DT_S;
 
-    // Clamp integral to prevent windup
-    float i_max = state->pi_i_max_a / state->pi_ki;  // Convert current limit to error integral limit
+    // Clamp integral to prevent windup (current limit as an error integral limit)
+    float i_max = state->control.speed_integral_max;
     state->pi_error_integral = clamp(state->pi_error_integral, -i_max, i_max);
 
     float i_term = state->pi_ki * state->pi_error_integral;
@@ -350,26 +679,23 @@ static void control_mode_speed(wheel_state_t* state) {
  * - At hard overspeed (6000 RPM): zero torque in accelerating direction
  * - If torque would accelerate past limit, clamp to zero
  */
-static void control_mode_torque(wheel_state_t* state) {
-    // Convert torque command from mN·m to N·m
-    float torque_nm = state->torque_cmd_mnm / 1000.0f;
+static void HOT_PATH_FUNC(control_mode_torque)(wheel_state_t* state) {
+    const control_coeffs_t* c = &state->control;
 
-    // Calculate required current: i = τ / k_t
-    float current_required = torque_nm / MOTOR_KT_NM_PER_A;
+    // Calculate required current: i = τ / k_t (mN·m → N·m folded in)
+    float current_required = state->torque_cmd_mnm * (1.0f / MOTOR_KT_MNM_PER_A);
 
     // Speed limiting: reduce torque as we approach overspeed
-    float speed_rpm = fabsf(wheel_model_get_speed_rpm(state));
-    float soft_limit = state->overspeed_soft_rpm;
-    float hard_limit = state->overspeed_fault_rpm;
+    float omega_abs = fabsf(state->omega_rad_s);
 
     // Check if torque would accelerate us toward the limit
     bool accelerating_positive = (state->omega_rad_s >= 0 && current_required > 0);
     bool accelerating_negative = (state->omega_rad_s < 0 && current_required < 0);
     bool accelerating_toward_limit = accelerating_positive || accelerating_negative;
 
-    if (accelerating_toward_limit && speed_rpm > soft_limit) {
+    if (accelerating_toward_limit && omega_abs > c->torque_soft_rad_s) {
         // Linear reduction from soft limit to hard limit
-        float reduction = (speed_rpm - soft_limit) / (hard_limit - soft_limit);
+        float reduction = (omega_abs - c->torque_soft_rad_s) * c->torque_band_inv;
         reduction = clamp(reduction, 0.0f, 1.0f);
 
         // At hard limit, torque drops to zero
@@ -385,14 +711,37 @@ static void control_mode_torque(wheel_state_t* state) {
  *
  * duty → i_out (simplified model: i ∝ duty)
  */
-static void control_mode_pwm(wheel_state_t* state) {
+static void HOT_PATH_FUNC(control_mode_pwm)(wheel_state_t* state) {
     // Simplified model: assume linear relationship between duty and current
     // In reality, current depends on BEMF, but this is a backup mode
-    float duty_normalized = state->pwm_duty_pct / 100.0f;
-    float max_current = state->soft_overcurrent_a;
+    state->current_out_a = state->pwm_duty_pct * state->control.pwm_pct_to_a;
+}
+
+/**
+ * @brief Invalid mode: zero output
+ */
+static void HOT_PATH_FUNC(control_mode_invalid)(wheel_state_t* state) {
+    state->current_out_a = 0.0f;
+}
+
+/** Control kernels indexed by control_mode_t (a new mode adds an entry) */
+static const control_kernel_fn_t HOT_PATH_DATA("model") control_kernels[] = {
+    [CONTROL_MODE_CURRENT] = control_mode_current,
+    [CONTROL_MODE_SPEED]   = control_mode_speed,
+    [CONTROL_MODE_TORQUE]  = control_mode_torque,
+    [CONTROL_MODE_PWM]     = control_mode_pwm,
+};
 
-    // Output current proportional to duty cycle
-    state->current_out_a = duty_normalized * max_current;
+/**
+ * @brief Select the control kernel for the current mode
+ */
+static void select_control_kernel(wheel_state_t* state) {
+    uint32_t mode = (uint32_t)state->mode;
+    control_kernel_fn_t kernel = NULL;
+    if (mode < (sizeof(control_kernels) / sizeof(control_kernels[0]))) {
+        kernel = control_kernels[mode];
+    }
+    state->control.kernel = kernel ? kernel : control_mode_invalid;
 }
 
 // ============================================================================
@@ -415,11 +764,24 @@ void wheel_model_init(wheel_state_t* state) {
     // Per SPEC.md §13: All protections enabled by default
     protection_init(state);
 
+    // Loss table for INTEGRATOR_LUT (same profile for every wheel)
+    if (!loss_lut.built) {
+        loss_lut_build();
+    }
+
+    // Default integrator: single Euler step (cheapest, matches flight reference)
+    state->integrator = INTEGRATOR_EULER;
+    state->integrator_substeps = DEFAULT_INTEGRATOR_SUBSTEPS;
+
     // Default PI controller parameters (for SPEED mode)
     state->pi_kp = DEFAULT_PI_KP;
     state->pi_ki = DEFAULT_PI_KI;
     state->pi_i_max_a = DEFAULT_PI_I_MAX_A;
 
+    // Kernel for the power-on mode and constants derived from the defaults
+    wheel_model_update_coeffs(state);
+    select_control_kernel(state);
+
     // Simulated bus voltage (nominal 28V satellite bus)
     state->voltage_v = 28.0f;
 
@@ -502,6 +864,9 @@ void wheel_model_init(wheel_state_t* state) {
     state->drive_fault_count = 0;     // Drive fault count
     state->drive_overtemp_count = 0;  // Overtemperature count
 
+    // Thermal model: everything at ambient at power-on
+    thermal_init(&state->thermal);
+
     printf("[WHEEL] Power-on initialization complete\n");
     printf("  Mode: CURRENT (High-Z)\n");
     printf("  All faults cleared: 0x%08X\n", state->fault_latch);
@@ -510,58 +875,56 @@ void wheel_model_init(wheel_state_t* state) {
            state->omega_rad_s, state->momentum_nms);
 }
 
-void wheel_model_tick(wheel_state_t* state) {
-    // Run control law based on mode
-    switch (state->mode) {
-        case CONTROL_MODE_CURRENT:
-            control_mode_current(state);
-            break;
-
-        case CONTROL_MODE_SPEED:
-            control_mode_speed(state);
-            break;
-
-        case CONTROL_MODE_TORQUE:
-            control_mode_torque(state);
-            break;
-
-        case CONTROL_MODE_PWM:
-            control_mode_pwm(state);
-            break;
-
-        default:
-            // Invalid mode, default to zero output
-            state->current_out_a = 0.0f;
-            break;
-    }
+void HOT_PATH_FUNC(wheel_model_tick)(wheel_state_t* state) {
+    // Run control law of the mode (kernel selected at mode change)
+    PROF_BEGIN(PROF_CORE1_CONTROL);
+    state->control.kernel(state);
+    PROF_END(PROF_CORE1_CONTROL);
 
     // Apply limits
+    PROF_BEGIN(PROF_CORE1_LIMITS);
     apply_limits(state);
+    PROF_END(PROF_CORE1_LIMITS);
 
     // Update dynamics
+    PROF_BEGIN(PROF_CORE1_DYNAMICS);
     update_dynamics(state);
+    PROF_END(PROF_CORE1_DYNAMICS);
 
     // Check protections
+    PROF_BEGIN(PROF_CORE1_PROTECTION);
     check_protections(state);
+    PROF_END(PROF_CORE1_PROTECTION);
 
     // Update statistics
     state->tick_count++;
-    if ((state->tick_count % 100) == 0) {
-        // Every 100 ticks = 1 second
+    if ((state->tick_count % MODEL_TICK_RATE_HZ) == 0) {
+        // Every MODEL_TICK_RATE_HZ ticks = 1 second
         state->uptime_seconds++;
     }
 
     // Update revolution count (ICD Table 12-19)
     // revolutions = ω * Δt / (2π)
-    // We integrate revolutions each tick (100 Hz)
-    // rev_per_tick = |ω| * 0.01 / (2π) = |ω| * 0.001591549
-    static float revolution_accumulator = 0.0f;
-    revolution_accumulator += fabsf(state->omega_rad_s) * MODEL_DT_S / (2.0f * 3.14159265f);
-    if (revolution_accumulator >= 1.0f) {
-        uint32_t whole_revs = (uint32_t)revolution_accumulator;
+    // We integrate revolutions each tick
+    // rev_per_tick = |ω| * Δt / (2π) (= |ω| * 0.001591549 at 100 Hz)
+    state->revolution_accum += fabsf(state->omega_rad_s) * MODEL_REV_PER_RAD_TICK;
+    if (state->revolution_accum >= 1.0f) {
+        uint32_t whole_revs = (uint32_t)state->revolution_accum;
         state->revolution_count += whole_revs;
-        revolution_accumulator -= (float)whole_revs;
+        state->revolution_accum -= (float)whole_revs;
+    }
+}
+
+void wheel_model_set_integrator(wheel_state_t* state, integrator_mode_t integrator,
+                                uint32_t substeps) {
+    if ((uint32_t)integrator >= INTEGRATOR_COUNT) {
+        integrator = INTEGRATOR_EULER;
     }
+    if (substeps < 1) substeps = 1;
+    if (substeps > INTEGRATOR_MAX_SUBSTEPS) substeps = INTEGRATOR_MAX_SUBSTEPS;
+
+    state->integrator = integrator;
+    state->integrator_substeps = substeps;
 }
 
 void wheel_model_set_mode(wheel_state_t* state, control_mode_t mode) {
@@ -572,7 +935,7 @@ void wheel_model_set_mode(wheel_state_t* state, control_mode_t mode) {
         return;
     }
 
-    printf("[WHEEL] Mode change: %d → %d\n", old_mode, mode);
+    DLOG("[WHEEL] Mode change: %d → %d\n", old_mode, mode);
 
     // ========================================================================
     // Reset State on Mode Exit
@@ -591,7 +954,7 @@ void wheel_model_set_mode(wheel_state_t* state, control_mode_t mode) {
             state->speed_cmd_rpm = 0.0f;
             state->pi_error_integral = 0.0f;
             state->pi_output_a = 0.0f;
-            printf("  [SPEED] PI controller reset\n");
+            DLOG("  [SPEED] PI controller reset\n");
             break;
 
         case CONTROL_MODE_TORQUE:
@@ -622,25 +985,25 @@ void wheel_model_set_mode(wheel_state_t* state, control_mode_t mode) {
         case CONTROL_MODE_CURRENT:
             // Current mode: Direct control, no special init needed
             // Output will be driven by current_cmd_a (currently 0)
-            printf("  [CURRENT] Direct current control active\n");
+            DLOG("  [CURRENT] Direct current control active\n");
             break;
 
         case CONTROL_MODE_SPEED:
             // Speed mode: Initialize PI controller with clean state
             state->pi_error_integral = 0.0f;
             state->pi_output_a = 0.0f;
-            printf("  [SPEED] PI controller initialized (Kp=%.3f, Ki=%.3f)\n",
-                   state->pi_kp, state->pi_ki);
+            DLOG("  [SPEED] PI controller initialized (Kp=%.3f, Ki=%.3f)\n",
+                 dlog_f32(state->pi_kp), dlog_f32(state->pi_ki));
             break;
 
         case CONTROL_MODE_TORQUE:
             // Torque mode: Feed-forward control, no special init needed
-            printf("  [TORQUE] Feed-forward torque control active\n");
+            DLOG("  [TORQUE] Feed-forward torque control active\n");
             break;
 
         case CONTROL_MODE_PWM:
             // PWM mode: Backup duty-cycle control
-            printf("  [PWM] Direct duty-cycle control active\n");
+            DLOG("  [PWM] Direct duty-cycle control active\n");
             break;
 
         default:
@@ -648,10 +1011,12 @@ void wheel_model_set_mode(wheel_state_t* state, control_mode_t mode) {
             state->mode = CONTROL_MODE_CURRENT;
             state->current_cmd_a = 0.0f;
             state->current_out_a = 0.0f;
-            printf("  [ERROR] Invalid mode %d, forced to CURRENT\n", mode);
+            DLOG("  [ERROR] Invalid mode %d, forced to CURRENT\n", mode);
             break;
     }
 
+    select_control_kernel(state);
+
     // ========================================================================
     // Common Reset on Any Mode Change
     // ========================================================================
@@ -688,15 +1053,37 @@ void wheel_model_clear_faults(wheel_state_t* state, uint32_t fault_mask) {
 }
 
 void wheel_model_update_protections(wheel_state_t* state) {
-    // This function would be called when POKE writes to protection registers
-    // For now, it's a placeholder for future register integration
-    // In Phase 6, this will read from the register map
+    // Thresholds written directly (POKE) take effect through the native
+    // block that check_protections() compares against
+    protection_update_native(state);
+}
+
+void wheel_model_update_coeffs(wheel_state_t* state) {
+    control_coeffs_t* c = &state->control;
+
+    // SPEED: ∫e limit that keeps Ki·∫e within the current limit
+    // (IEEE inf when Ki = 0, so the integral is left unclamped)
+    c->speed_integral_max = state->pi_i_max_a / state->pi_ki;
+
+    // TORQUE: reduction band between soft and hard overspeed
+    float soft_rad_s = state->overspeed_soft_rpm * RPM_TO_RAD_S;
+    float hard_rad_s = state->overspeed_fault_rpm * RPM_TO_RAD_S;
+    c->torque_soft_rad_s = soft_rad_s;
+    c->torque_band_inv = 1.0f / (hard_rad_s - soft_rad_s);
+
+    // PWM: full duty drives the soft overcurrent limit
+    c->pwm_pct_to_a = state->soft_overcurrent_a * 0.01f;
+
+    // Limits
+    c->overpower_a_rad_s = state->motor_overpower_limit_w / MOTOR_KT_NM_PER_A;
+    float duty_limit_a = state->soft_overcurrent_a * (state->max_duty_cycle_pct * 0.01f);
+    c->current_limit_a = (duty_limit_a < state->soft_overcurrent_a) ? duty_limit_a
+                                                                    : state->soft_overcurrent_a;
 }
 
 void wheel_model_update_pi_params(wheel_state_t* state) {
-    // This function would be called when POKE writes to PI tuning registers
-    // For now, it's a placeholder for future register integration
-    // In Phase 6, this will read from the register map
+    // PI gains or integral limit changed (POKE): refresh the SPEED constants
+    wheel_model_update_coeffs(state);
 }
 
 void wheel_model_reset(wheel_state_t* state) {
@@ -715,10 +1102,23 @@ void wheel_model_reset(wheel_state_t* state) {
     // Critical: Clear LCL trip flag (only reset can do this)
     state->lcl_tripped = false;
 
-    // Note: FAULT pin de-assertion handled by gpio_map layer
+    // Note: FAULT pin de-assertion follows on Core1 (drivers/fault_line.c)
     // Console output for debugging
-    printf("[WHEEL] Hardware RESET: LCL cycled, faults cleared, ω=%.1f rad/s\n",
-           omega_saved);
+    DLOG("[WHEEL] Hardware RESET: LCL cycled, faults cleared, ω=%.1f rad/s\n",
+         dlog_f32(omega_saved));
+}
+
+void wheel_model_restore(wheel_state_t* state, const wheel_state_t* saved) {
+    memcpy(state, saved, sizeof(wheel_state_t));
+
+    // Pointers are rebuilt, not trusted: the engine sets override each tick
+    state->override = NULL;
+    select_control_kernel(state);
+
+    // Loss table for INTEGRATOR_LUT (rebuilt at every boot)
+    if (!loss_lut.built) {
+        loss_lut_build();
+    }
 }
 
 bool wheel_model_is_lcl_tripped(const wheel_state_t* state) {
@@ -737,5 +1137,5 @@ void wheel_model_trip_lcl(wheel_state_t* state) {
     state->current_out_a = 0.0f;
 
     // Note: FAULT pin assertion handled by gpio_map layer
-    printf("[WHEEL] LCL TRIPPED (test command [0x0B]): Motor disabled, reset required\n");
+    DLOG("[WHEEL] LCL TRIPPED (test command [0x0B]): Motor disabled, reset required\n");
 }
@@ -2,7 +2,8 @@
  * @file nss_nrwa_t6_model.h
  * @brief NSS NRWA-T6 Reaction Wheel Physics Model
  *
- * Implements dynamics simulation for the NRWA-T6 reaction wheel with:
+ * Implements dynamics simulation for the NRWA-T6 reaction wheel (or the
+ * variant selected by the build's wheel profile) with:
  * - 4 control modes: CURRENT, SPEED, TORQUE, PWM
  * - Loss model: viscous + coulomb + copper losses
  * - Protection limits: power, current, duty cycle
@@ -16,46 +17,177 @@
 #include <stdbool.h>
 #include "nss_nrwa_t6_regs.h"
 #include "fixedpoint.h"
+#include "board_pico.h"
+#include "wheel_profile.h"
 
 // ============================================================================
-// Physical Constants (from SPEC.md and ICD)
+// Physical Constants (from the build's wheel profile, see wheel_profile.h)
 // ============================================================================
 
-// Wheel inertia: I = 5.35e-5 kg·m² (from ICD)
-#define WHEEL_INERTIA_KGM2      0.0000535f   // kg·m²
+#define WHEEL_INERTIA_KGM2      WHEEL_PROFILE_VALUE(INERTIA_KGM2)       // kg·m²
+#define MOTOR_KT_NM_PER_A       WHEEL_PROFILE_VALUE(KT_NM_PER_A)        // N·m/A
 
-// Motor torque constant: k_t = 0.0534 N·m/A (from SPEC.md)
-#define MOTOR_KT_NM_PER_A       0.0534f      // N·m/A
+// Loss model coefficients
+#define LOSS_VISCOUS_A          WHEEL_PROFILE_VALUE(LOSS_VISCOUS_A)     // a·ω (N·m·s/rad)
+#define LOSS_COULOMB_B          WHEEL_PROFILE_VALUE(LOSS_COULOMB_B)     // b·sign(ω) (N·m)
+#define LOSS_COPPER_C           WHEEL_PROFILE_VALUE(LOSS_COPPER_C)      // c·i² (N·m/A²)
 
-// Loss model coefficients (tuned for realistic NRWA-T6 behavior)
-// These values produce realistic coast-down times (~minutes from 6000 RPM)
-// and prevent runaway speed when motor current is disabled (LCL trip)
-#define LOSS_VISCOUS_A          0.000016f    // a·ω (N·m·s/rad) - 16 µN·m·s/rad
-#define LOSS_COULOMB_B          0.001f       // b·sign(ω) (N·m) - 1 mN·m static friction
-#define LOSS_COPPER_C           0.0001f      // c·i² (N·m/A²) - copper losses
+// Simulation timestep (folded from the physics tick rate, see board_pico.h)
+#define MODEL_TICK_RATE_HZ      PHYSICS_TICK_RATE_HZ            // ticks per second
+#define MODEL_DT_US             PHYSICS_TICK_PERIOD_US          // 10000 µs at 100 Hz
+#define MODEL_DT_S              ((float)MODEL_DT_US * 1.0e-6f)  // 0.010 s at 100 Hz
 
-// Simulation timestep
-#define MODEL_DT_MS             10           // 10 ms (100 Hz)
-#define MODEL_DT_S              0.010f       // 10 ms in seconds
+// Revolutions per tick per rad/s: Δt / (2π)
+#define MODEL_REV_PER_RAD_TICK  (MODEL_DT_S / (2.0f * 3.14159265f))
 
-// Default protection limits (from SPEC.md)
-#define DEFAULT_OVERVOLTAGE_V           36.0f      // V
-#define DEFAULT_OVERSPEED_FAULT_RPM     6000.0f    // RPM (latched fault)
-#define DEFAULT_OVERSPEED_SOFT_RPM      5000.0f    // RPM (warning)
-#define DEFAULT_MAX_DUTY_CYCLE          97.85f     // %
-#define DEFAULT_MOTOR_OVERPOWER_W       100.0f     // W
-#define DEFAULT_SOFT_OVERCURRENT_A      6.0f       // A
-#define DEFAULT_BRAKING_LOAD_V          31.0f      // V
+// Default protection limits (wheel profile)
+#define DEFAULT_OVERVOLTAGE_V           WHEEL_PROFILE_VALUE(OVERVOLTAGE_V)          // V
+#define DEFAULT_OVERSPEED_FAULT_RPM     WHEEL_PROFILE_VALUE(OVERSPEED_FAULT_RPM)    // RPM (latched fault)
+#define DEFAULT_OVERSPEED_SOFT_RPM      WHEEL_PROFILE_VALUE(OVERSPEED_SOFT_RPM)     // RPM (warning)
+#define DEFAULT_MAX_DUTY_CYCLE          WHEEL_PROFILE_VALUE(MAX_DUTY_CYCLE_PCT)     // %
+#define DEFAULT_MOTOR_OVERPOWER_W       WHEEL_PROFILE_VALUE(OVERPOWER_W)            // W
+#define DEFAULT_SOFT_OVERCURRENT_A      WHEEL_PROFILE_VALUE(SOFT_OVERCURRENT_A)     // A
+#define DEFAULT_BRAKING_LOAD_V          WHEEL_PROFILE_VALUE(BRAKING_LOAD_V)         // V
 
 // Default PI controller parameters (tuned for reasonable response)
 #define DEFAULT_PI_KP                   0.05f      // Proportional gain
 #define DEFAULT_PI_KI                   0.01f      // Integral gain
 #define DEFAULT_PI_I_MAX_A              3.0f       // Integral windup limit (A)
 
+// Integrator defaults (see integrator_mode_t)
+#define DEFAULT_INTEGRATOR_SUBSTEPS     4          // Inner steps per tick
+#define INTEGRATOR_MAX_SUBSTEPS         16         // Upper bound (Core1 budget)
+#define LOSS_LUT_SEGMENTS               64         // Loss table segments (INTEGRATOR_LUT)
+
 // Conversion constants
 #define RPM_TO_RAD_S                    0.10471975512f  // π/30
 #define RAD_S_TO_RPM                    9.54929658551f  // 30/π
 
+// ============================================================================
+// Integrator Selection
+// ============================================================================
+
+/**
+ * @brief Dynamics integrator used by wheel_model_tick()
+ *
+ * Control outputs are sample-and-hold at the tick rate; only the ω ODE
+ * (loss torque depends on ω) is integrated more finely.
+ *
+ * FIXED runs the same Euler step as EULER with coefficients folded into
+ * Q-format constants at compile time, so it needs no soft-float divides on
+ * the M0+ and is bit-reproducible across builds and hosts. ω is carried in
+ * Q16.16; the float ω is a published copy. EULER stays the reference.
+ *
+ * LUT is the FIXED step with the speed-dependent loss read from a table:
+ * LOSS_LUT_SEGMENTS linear segments over 0..1.25× the overspeed fault, on
+ * a power-of-two spacing in Q16.16 so the lookup is a shift, two loads and
+ * one multiply whatever the curve's shape. The table is resampled at boot
+ * from the wheel profile's characterized loss curve, or from a·ω + b when
+ * the profile has none (then LUT tracks FIXED).
+ */
+typedef enum {
+    INTEGRATOR_EULER = 0,   // One explicit Euler step per tick (reference, cheapest)
+    INTEGRATOR_SUBSTEP,     // N Euler steps of Δt/N, zero-crossing checked per step
+    INTEGRATOR_RK4,         // N classic RK4 steps of Δt/N (4 loss evaluations each)
+    INTEGRATOR_FIXED,       // One Euler step in Q16.16 integer arithmetic (no float in the kernel)
+    INTEGRATOR_LUT,         // FIXED with the speed loss interpolated from the loss table
+    INTEGRATOR_COUNT
+} integrator_mode_t;
+
+// ============================================================================
+// Physics Overrides (fault injection)
+// ============================================================================
+
+#define PHYS_OVR_POWER_LIMIT    (1u << 0)   // Clamp |τ·ω| to power_limit_w
+#define PHYS_OVR_CURRENT_LIMIT  (1u << 1)   // Clamp |i| to current_limit_a
+#define PHYS_OVR_SPEED_LIMIT    (1u << 2)   // Clamp |ω| to speed_limit_rad_s
+#define PHYS_OVR_TORQUE         (1u << 3)   // Force motor torque to torque_mnm
+
+/**
+ * @brief Scenario physics overrides applied on top of the control law
+ *
+ * Thresholds are converted to model units when published, so the tick
+ * only compares. Forced torque wins over every limit.
+ */
+typedef struct {
+    uint32_t flags;             // PHYS_OVR_* (0 = no override)
+    float power_limit_w;
+    float current_limit_a;
+    float speed_limit_rad_s;
+    float torque_mnm;
+} physics_override_t;
+
+// ============================================================================
+// Protection Thresholds (model-native units)
+// ============================================================================
+
+/**
+ * @brief Protection thresholds as check_protections() compares them
+ *
+ * Derived from the user-unit thresholds in wheel_state_t by
+ * protection_update_native() whenever one of those changes. Magnitude
+ * limits are kept in model units as the IEEE-754 bit pattern of the
+ * threshold: for non-negative floats the bit patterns order like the
+ * values, so |x| > limit becomes one AND and one integer compare on the
+ * M0+ (no soft-float call, no unit conversion). A negative user threshold
+ * (always exceeded) is stored as -1; a NaN input counts as exceeding.
+ */
+typedef struct {
+    int32_t overspeed_fault_rad_s;  // overspeed_fault_rpm · π/30
+    int32_t overspeed_soft_rad_s;   // overspeed_soft_rpm · π/30
+    int32_t overpower_w;            // motor_overpower_limit_w
+    int32_t soft_overcurrent_a;     // soft_overcurrent_a
+    float overvoltage_v;            // overvoltage_threshold_v (signed float compare)
+} protection_native_t;
+
+// ============================================================================
+// Thermal State
+// ============================================================================
+
+/**
+ * @brief Lumped thermal nodes (see nss_nrwa_t6_thermal.h)
+ *
+ * Kept apart from the rest of wheel_state_t so a soft reset, which
+ * re-initializes the model, can carry the temperatures over.
+ */
+typedef struct {
+    float motor_c;              // Motor winding (°C)
+    float driver_c;             // Motor driver (°C)
+    float dcdc_c;               // DC-DC converter (°C)
+    float enclosure_c;          // Enclosure (°C)
+    uint32_t warnings;          // WARN_HIGH_TEMP_* raised by the thermal task
+} thermal_state_t;
+
+// ============================================================================
+// Control Kernels
+// ============================================================================
+
+struct wheel_state;
+
+/**
+ * @brief Control law of one mode: command → current_out_a
+ */
+typedef void (*control_kernel_fn_t)(struct wheel_state* state);
+
+/**
+ * @brief Control kernel selected at mode change and its derived constants
+ *
+ * wheel_model_set_mode() picks the kernel, so the tick makes one indirect
+ * call instead of switching on the mode. The coefficients fold the user
+ * parameters (PI gains, thresholds) into what the kernels and limits
+ * multiply by; wheel_model_update_coeffs() recomputes them when one of
+ * those parameters changes (PI update, protection threshold, POKE).
+ */
+typedef struct {
+    control_kernel_fn_t kernel;
+    float speed_integral_max;       // SPEED: pi_i_max_a / pi_ki (rad)
+    float torque_soft_rad_s;        // TORQUE: overspeed_soft_rpm in rad/s
+    float torque_band_inv;          // TORQUE: 1 / (hard - soft overspeed) in s/rad
+    float pwm_pct_to_a;             // PWM: soft_overcurrent_a / 100
+    float overpower_a_rad_s;        // Limits: P_lim / k_t (|i| ≤ this / |ω|)
+    float current_limit_a;          // Limits: min(soft overcurrent, its max-duty share)
+} control_coeffs_t;
+
 // ============================================================================
 // Wheel State Structure
 // ============================================================================
@@ -66,7 +198,7 @@
  * All internal calculations use float for simplicity and accuracy.
  * Fixed-point conversions happen only at register boundaries.
  */
-typedef struct {
+typedef struct wheel_state {
     // Dynamic state
     float omega_rad_s;          // Angular velocity (rad/s)
     float momentum_nms;         // Angular momentum H = I·ω (N·m·s)
@@ -93,8 +225,17 @@ typedef struct {
 
     // Control mode
     control_mode_t mode;        // Active control mode
+    control_coeffs_t control;   // Kernel for mode + derived constants (do not write)
     direction_t direction;      // Rotation direction
 
+    // Integrator selection
+    integrator_mode_t integrator;   // Dynamics integrator
+    uint32_t integrator_substeps;   // Inner steps per tick (SUBSTEP/RK4)
+
+    // Fixed-point kernel state (INTEGRATOR_FIXED)
+    q16_16_t omega_fx;          // Authoritative ω in Q16.16 (rad/s)
+    float omega_fx_published;   // ω last published from omega_fx (detects external writes)
+
     // Protection thresholds (configurable via PEEK/POKE)
     float overvoltage_threshold_v;
     float overspeed_fault_rpm;
@@ -103,6 +244,7 @@ typedef struct {
     float motor_overpower_limit_w;
     float soft_overcurrent_a;
     float braking_load_setpoint_v;
+    protection_native_t prot_native;    // Derived from the above (do not write)
 
     // PI tuning parameters
     float pi_kp;
@@ -126,10 +268,17 @@ typedef struct {
 
     // Diagnostic counters (per ICD Table 12-19)
     uint32_t revolution_count;      // Revolution count (integrated from speed)
+    float revolution_accum;         // Fractional revolutions not yet counted
     uint32_t hall_invalid_count;    // Motor Hall sensor invalid transition count
     uint32_t drive_fault_count;     // Drive-Fault count
     uint32_t drive_overtemp_count;  // Drive-Overtemperature count
 
+    // Thermal model (updated every THERMAL_PERIOD_TICKS)
+    thermal_state_t thermal;
+
+    // Fault injection (Core1 points this at the published block each tick)
+    const physics_override_t* override;  // NULL = none
+
 } wheel_state_t;
 
 // ============================================================================
@@ -144,7 +293,7 @@ typedef struct {
 void wheel_model_init(wheel_state_t* state);
 
 /**
- * @brief Execute one physics tick (10 ms)
+ * @brief Execute one physics tick (MODEL_DT_S, 10 ms at 100 Hz)
  *
  * Updates dynamics, applies control law, enforces limits.
  *
@@ -160,6 +309,17 @@ void wheel_model_tick(wheel_state_t* state);
  */
 void wheel_model_set_mode(wheel_state_t* state, control_mode_t mode);
 
+/**
+ * @brief Select dynamics integrator
+ *
+ * @param state Pointer to wheel state structure
+ * @param integrator Integrator mode (invalid values select EULER)
+ * @param substeps Inner steps per tick, clamped to 1..INTEGRATOR_MAX_SUBSTEPS
+ *                 (ignored for EULER and FIXED)
+ */
+void wheel_model_set_integrator(wheel_state_t* state, integrator_mode_t integrator,
+                                uint32_t substeps);
+
 /**
  * @brief Set speed setpoint (for SPEED mode)
  *
@@ -217,6 +377,17 @@ void wheel_model_clear_faults(wheel_state_t* state, uint32_t fault_mask);
  */
 void wheel_model_update_protections(wheel_state_t* state);
 
+/**
+ * @brief Recompute the control kernel coefficients (state->control)
+ *
+ * Called by wheel_model_update_pi_params(), wheel_model_update_protections()
+ * and protection_update_native(); code that writes a PI gain or threshold
+ * field directly must call one of them.
+ *
+ * @param state Pointer to wheel state structure
+ */
+void wheel_model_update_coeffs(wheel_state_t* state);
+
 /**
  * @brief Update PI controller parameters from registers
  *
@@ -243,6 +414,19 @@ void wheel_model_update_pi_params(wheel_state_t* state);
  */
 void wheel_model_reset(wheel_state_t* state);
 
+/**
+ * @brief Restore a wheel from a copy taken on an earlier boot (warm restart)
+ *
+ * Unlike wheel_model_reset() nothing is cleared: speed, commands, mode,
+ * protection thresholds, fault latches and the LCL state carry over. Only
+ * what points into the previous boot is rebuilt (control kernel, fault
+ * injection override).
+ *
+ * @param state Wheel to restore
+ * @param saved Copy of the wheel's state
+ */
+void wheel_model_restore(wheel_state_t* state, const wheel_state_t* saved);
+
 /**
  * @brief Check if LCL is tripped
  *
@@ -6,6 +6,7 @@
 #include "nss_nrwa_t6_protection.h"
 #include "nss_nrwa_t6_model.h"
 #include "fixedpoint.h"
+#include "dlog.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -56,38 +57,41 @@ static const fault_info_t fault_table[] = {
 // ============================================================================
 
 /**
- * @brief Convert fault bit to array index
+ * @brief Bit position of a single set bit, via a de Bruijn multiply
  *
- * Efficiently converts a single fault bit (power of 2) to its corresponding
- * index in the fault_table array. Uses bit manipulation instead of looping.
+ * (bit × 0x077CB531) >> 27 is unique for each of the 32 powers of two;
+ * the table maps it back to the position. The M0+ has no CLZ/CTZ
+ * instruction, so this is the single-multiply equivalent.
+ */
+static const uint8_t debruijn_bit_pos[32] = {
+    0,  1,  28, 2,  29, 14, 24, 3,  30, 22, 20, 15, 25, 17, 4,  8,
+    31, 27, 13, 23, 21, 19, 16, 7,  26, 12, 18, 6,  11, 5,  10, 9,
+};
+
+/**
+ * @brief Convert fault bit to array index
  *
  * @param fault_bit Single fault bit (e.g., FAULT_OVERSPEED = 0x00000002)
  * @return Index 0-7, or -1 if invalid (zero, multiple bits, or out of range)
- *
- * Implementation:
- * - Validates exactly one bit is set using (x & (x-1)) == 0 trick
- * - Counts trailing zeros to find bit position (0-7)
- * - More efficient than loop-based lookup
  */
 static inline int fault_bit_to_index(uint32_t fault_bit) {
-    // Check for zero or multiple bits set
-    // For powers of 2: (x & (x-1)) == 0
-    // For zero: special case check
-    if (fault_bit == 0 || (fault_bit & (fault_bit - 1)) != 0) {
-        return -1;  // Invalid: zero or multiple bits
+    // Exactly one bit, and one of the 8 in fault_table
+    if (fault_bit == 0 || (fault_bit & (fault_bit - 1)) != 0 || fault_bit > 0x80u) {
+        return -1;
     }
+    return debruijn_bit_pos[(fault_bit * 0x077CB531u) >> 27];
+}
 
-    // Count trailing zeros (bit position)
-    // This is the index in fault_table
-    int idx = 0;
-    uint32_t mask = fault_bit;
-    while (!(mask & 1)) {
-        mask >>= 1;
-        idx++;
+/**
+ * @brief Bit pattern of a magnitude threshold (negative: always exceeded)
+ */
+static inline int32_t threshold_bits(float limit) {
+    if (limit < 0.0f) {
+        return -1;
     }
-
-    // Validate range (must be 0-7 for our 8 fault bits)
-    return (idx < 8) ? idx : -1;
+    int32_t bits;
+    memcpy(&bits, &limit, sizeof(bits));
+    return bits;
 }
 
 // ============================================================================
@@ -107,6 +111,8 @@ void protection_init(wheel_state_t* state) {
     state->braking_load_setpoint_v = DEFAULT_BRAKING_LOAD_V;
     state->max_duty_cycle_pct = DEFAULT_MAX_DUTY_CYCLE_PCT;
 
+    protection_update_native(state);
+
     // Enable all protections by default (per SPEC.md §13)
     state->protection_enable = PROT_ENABLE_ALL;
 
@@ -164,55 +170,78 @@ bool protection_set_parameter(wheel_state_t* state, uint8_t param_id, uint32_t v
             return false;
     }
 
+    return protection_set_threshold(state, param_id, value_float);
+}
+
+bool protection_set_threshold(wheel_state_t* state, uint8_t param_id, float value_float) {
+    if (!state || param_id >= PROT_PARAM_COUNT) {
+        return false;
+    }
+
     // Update the appropriate threshold
     switch (param_id) {
         case PROT_PARAM_OVERVOLTAGE_THRESHOLD:
             state->overvoltage_threshold_v = value_float;
-            printf("[PROTECTION] Overvoltage threshold updated: %.1f V\n", value_float);
+            DLOG("[PROTECTION] Overvoltage threshold updated: %.1f V\n", dlog_f32(value_float));
             break;
 
         case PROT_PARAM_OVERSPEED_FAULT_RPM:
             state->overspeed_fault_rpm = value_float;
-            printf("[PROTECTION] Overspeed fault threshold updated: %.0f RPM\n", value_float);
+            DLOG("[PROTECTION] Overspeed fault threshold updated: %.0f RPM\n", dlog_f32(value_float));
             break;
 
         case PROT_PARAM_OVERSPEED_SOFT_RPM:
             state->overspeed_soft_rpm = value_float;
-            printf("[PROTECTION] Overspeed soft limit updated: %.0f RPM\n", value_float);
+            DLOG("[PROTECTION] Overspeed soft limit updated: %.0f RPM\n", dlog_f32(value_float));
             break;
 
         case PROT_PARAM_OVERPOWER_LIMIT_W:
             state->motor_overpower_limit_w = value_float;
-            printf("[PROTECTION] Overpower limit updated: %.0f W\n", value_float);
+            DLOG("[PROTECTION] Overpower limit updated: %.0f W\n", dlog_f32(value_float));
             break;
 
         case PROT_PARAM_SOFT_OVERCURRENT_A:
             state->soft_overcurrent_a = value_float;
-            printf("[PROTECTION] Soft overcurrent updated: %.1f A\n", value_float);
+            DLOG("[PROTECTION] Soft overcurrent updated: %.1f A\n", dlog_f32(value_float));
             break;
 
         case PROT_PARAM_HARD_OVERCURRENT_A:
             // Note: hard_overcurrent not in model yet
-            printf("[PROTECTION] Hard overcurrent: Not implemented yet\n");
+            DLOG("[PROTECTION] Hard overcurrent: Not implemented yet\n");
             break;
 
         case PROT_PARAM_BRAKING_LOAD_V:
             state->braking_load_setpoint_v = value_float;
-            printf("[PROTECTION] Braking load updated: %.1f V\n", value_float);
+            DLOG("[PROTECTION] Braking load updated: %.1f V\n", dlog_f32(value_float));
             break;
 
         case PROT_PARAM_MAX_DUTY_CYCLE_PCT:
             state->max_duty_cycle_pct = value_float;
-            printf("[PROTECTION] Max duty cycle updated: %.2f%%\n", value_float);
+            DLOG("[PROTECTION] Max duty cycle updated: %.2f%%\n", dlog_f32(value_float));
             break;
 
         default:
             return false;
     }
 
+    protection_update_native(state);
     return true;
 }
 
+void protection_update_native(wheel_state_t* state) {
+    if (!state) return;
+
+    protection_native_t* n = &state->prot_native;
+    n->overspeed_fault_rad_s = threshold_bits(state->overspeed_fault_rpm * RPM_TO_RAD_S);
+    n->overspeed_soft_rad_s = threshold_bits(state->overspeed_soft_rpm * RPM_TO_RAD_S);
+    n->overpower_w = threshold_bits(state->motor_overpower_limit_w);
+    n->soft_overcurrent_a = threshold_bits(state->soft_overcurrent_a);
+    n->overvoltage_v = state->overvoltage_threshold_v;
+
+    // Limits and speed limiting fold the same thresholds
+    wheel_model_update_coeffs(state);
+}
+
 bool protection_get_parameter(const wheel_state_t* state, uint8_t param_id, uint32_t* value_fixed) {
     if (!state || !value_fixed || param_id >= PROT_PARAM_COUNT) {
         return false;
@@ -333,28 +362,28 @@ int protection_format_fault_string(uint32_t fault_mask, char* buf, size_t buf_si
     int fault_count = 0;
     int offset = 0;
 
-    // Iterate through all 8 fault bits
-    for (int i = 0; i < 8; i++) {
-        uint32_t fault_bit = (1U << i);
+    // Walk the set fault bits, lowest first
+    uint32_t pending = fault_mask & 0xFFu;
+    while (pending != 0) {
+        uint32_t fault_bit = pending & (0u - pending);
+        pending &= pending - 1;
 
-        if (fault_mask & fault_bit) {
-            // Add comma separator if not the first fault
-            if (fault_count > 0 && offset < buf_size - 1) {
-                buf[offset++] = ',';
-            }
+        // Add comma separator if not the first fault
+        if (fault_count > 0 && offset < buf_size - 1) {
+            buf[offset++] = ',';
+        }
 
-            // Append fault name
-            const char* name = fault_table[i].name;
-            while (*name && offset < buf_size - 1) {
-                buf[offset++] = *name++;
-            }
+        // Append fault name
+        const char* name = fault_table[fault_bit_to_index(fault_bit)].name;
+        while (*name && offset < buf_size - 1) {
+            buf[offset++] = *name++;
+        }
 
-            fault_count++;
+        fault_count++;
 
-            // Check if buffer is nearly full
-            if (offset >= buf_size - 20) {
-                break;  // Leave room for potential ellipsis or more names
-            }
+        // Check if buffer is nearly full
+        if (offset >= buf_size - 20) {
+            break;  // Leave room for potential ellipsis or more names
         }
     }
 
@@ -42,22 +42,22 @@ typedef enum {
 } protection_param_t;
 
 // ============================================================================
-// Protection Defaults (per SPEC.md and RESET_FAULT_REQUIREMENTS.md)
+// Protection Defaults (from the wheel profile, see wheel_profile.h)
 // ============================================================================
 
 // Hard Protection Defaults (immediate shutdown, trip LCL)
-#define DEFAULT_OVERVOLTAGE_THRESHOLD_V     36.0f   // Bus overvoltage
-#define DEFAULT_HARD_OVERCURRENT_A          6.0f    // Phase overcurrent (trips LCL)
-#define DEFAULT_MAX_DUTY_CYCLE_PCT          97.85f  // PWM duty cycle limit
-#define DEFAULT_OVERPOWER_LIMIT_W           100.0f  // Motor power limit
+#define DEFAULT_OVERVOLTAGE_THRESHOLD_V     WHEEL_PROFILE_VALUE(OVERVOLTAGE_V)          // Bus overvoltage
+#define DEFAULT_HARD_OVERCURRENT_A          WHEEL_PROFILE_VALUE(HARD_OVERCURRENT_A)     // Phase overcurrent (trips LCL)
+#define DEFAULT_MAX_DUTY_CYCLE_PCT          WHEEL_PROFILE_VALUE(MAX_DUTY_CYCLE_PCT)     // PWM duty cycle limit
+#define DEFAULT_OVERPOWER_LIMIT_W           WHEEL_PROFILE_VALUE(OVERPOWER_W)            // Motor power limit
 
 // Soft Protection Defaults (warnings → eventual fault)
-#define DEFAULT_BRAKING_LOAD_V              31.0f   // Regenerative braking threshold
-#define DEFAULT_SOFT_OVERCURRENT_A          6.0f    // Current warning threshold
-#define DEFAULT_OVERSPEED_SOFT_RPM          5000.0f // Speed warning threshold
+#define DEFAULT_BRAKING_LOAD_V              WHEEL_PROFILE_VALUE(BRAKING_LOAD_V)         // Regenerative braking threshold
+#define DEFAULT_SOFT_OVERCURRENT_A          WHEEL_PROFILE_VALUE(SOFT_OVERCURRENT_A)     // Current warning threshold
+#define DEFAULT_OVERSPEED_SOFT_RPM          WHEEL_PROFILE_VALUE(OVERSPEED_SOFT_RPM)     // Speed warning threshold
 
 // Latching Fault Defaults (require CLEAR-FAULT to reset)
-#define DEFAULT_OVERSPEED_FAULT_RPM         6000.0f // Hard fault, trips LCL
+#define DEFAULT_OVERSPEED_FAULT_RPM         WHEEL_PROFILE_VALUE(OVERSPEED_FAULT_RPM)    // Hard fault, trips LCL
 
 // ============================================================================
 // Protection Configuration API
@@ -73,6 +73,18 @@ typedef enum {
  */
 void protection_init(wheel_state_t* state);
 
+/**
+ * @brief Recompute the model-native threshold block (state->prot_native)
+ *
+ * Also refreshes the control coefficients that fold the same thresholds
+ * (wheel_model_update_coeffs). Called by every function here that changes
+ * a threshold; code that writes a user-unit threshold field directly must
+ * call it too.
+ *
+ * @param state Wheel state structure
+ */
+void protection_update_native(wheel_state_t* state);
+
 /**
  * @brief Update a protection parameter
  *
@@ -85,6 +97,19 @@ void protection_init(wheel_state_t* state);
  */
 bool protection_set_parameter(wheel_state_t* state, uint8_t param_id, uint32_t value_fixed);
 
+/**
+ * @brief Update a protection parameter from a value in user units
+ *
+ * Same as protection_set_parameter() without the fixed-point decoding
+ * (V, RPM, W, A, %).
+ *
+ * @param state Wheel state structure
+ * @param param_id Protection parameter ID (see protection_param_t)
+ * @param value Threshold in the parameter's user unit
+ * @return true if successful, false if invalid parameter ID
+ */
+bool protection_set_threshold(wheel_state_t* state, uint8_t param_id, float value);
+
 /**
  * @brief Get a protection parameter
  *
@@ -198,6 +198,29 @@ static inline uint8_t index_to_icd_mode(uint8_t mode) {
 #define REG_LAST_COMMAND_CODE       0x0428  // uint8_t: Last NSP command code received
 #define REG_LAST_COMMAND_TIMESTAMP  0x042C  // uint32_t: Timestamp of last command (ms)
 
+// ============================================================================
+// ICD Initialized Parameters (PEEK/POKE address space, ICD Table 11-1)
+// ============================================================================
+
+// 8-bit addresses of contiguous 4-byte registers, served by PEEK/POKE
+#define ICD_REG_DEVICE_ID           0x00  // uint32_t: Device ID (RO)
+#define ICD_REG_FIRMWARE_VERSION    0x04  // uint32_t: Firmware version, BCD (RO)
+#define ICD_REG_CONTROL_MODE        0x08  // uint32_t: Control mode, ICD bitmask (RW)
+#define ICD_REG_SPEED_SETPOINT      0x0C  // UQ14.18: Speed setpoint (RPM) (RW)
+#define ICD_REG_CURRENT_SETPOINT    0x10  // UQ14.18: Current setpoint (mA) (RW)
+#define ICD_REG_TORQUE_SETPOINT     0x14  // Q10.22: Torque setpoint (mN·m) (RW)
+#define ICD_REG_PWM_DUTY            0x18  // int32_t: Signed PWM duty, 512 = 100% (RW)
+#define ICD_REG_FAULT_STATUS        0x1C  // uint32_t: Fault status | latch (RO)
+#define ICD_REG_WARNING_STATUS      0x20  // uint32_t: Warning status (RO)
+#define ICD_REG_CURRENT_MEASURED    0x24  // Q20.12: Measured current (mA) (RO)
+#define ICD_REG_SPEED_MEASURED      0x28  // Q24.8: Measured speed (RPM) (RO)
+#define ICD_REG_PROTECTION_ENABLE   0x2C  // uint32_t: Protection enable mask (RW)
+#define ICD_REG_LCL_STATUS          0x30  // uint32_t: Bit 0 = LCL tripped (RO)
+
+#define ICD_REG_SIZE                4                                     // Bytes per register
+#define ICD_REG_LAST_ADDR           ICD_REG_LCL_STATUS
+#define ICD_REG_COUNT               ((ICD_REG_LAST_ADDR / ICD_REG_SIZE) + 1)  // 13 registers
+
 // ============================================================================
 // Register Access Helpers
 // ============================================================================
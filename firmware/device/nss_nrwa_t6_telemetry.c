@@ -5,6 +5,7 @@
 
 #include "nss_nrwa_t6_telemetry.h"
 #include "fixedpoint.h"
+#include "hot_path.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdbool.h>
@@ -21,7 +22,7 @@ static bool debug_telemetry = false;
  *
  * ICD N2-A2a-DD0021: All multi-byte values are little-endian (LSB first)
  */
-static void write_u32(uint8_t** buf, uint32_t value) {
+static void HOT_PATH_FUNC(write_u32)(uint8_t** buf, uint32_t value) {
     (*buf)[0] = value & 0xFF;          // LSB first
     (*buf)[1] = (value >> 8) & 0xFF;
     (*buf)[2] = (value >> 16) & 0xFF;
@@ -32,7 +33,7 @@ static void write_u32(uint8_t** buf, uint32_t value) {
 /**
  * @brief Write uint16_t to buffer (little-endian per ICD)
  */
-static void write_u16(uint8_t** buf, uint16_t value) {
+static void HOT_PATH_FUNC(write_u16)(uint8_t** buf, uint16_t value) {
     (*buf)[0] = value & 0xFF;          // LSB first
     (*buf)[1] = (value >> 8) & 0xFF;   // MSB last
     *buf += 2;
@@ -41,23 +42,36 @@ static void write_u16(uint8_t** buf, uint16_t value) {
 /**
  * @brief Write int16_t to buffer (little-endian per ICD)
  */
-static void write_s16(uint8_t** buf, int16_t value) {
+static void HOT_PATH_FUNC(write_s16)(uint8_t** buf, int16_t value) {
     write_u16(buf, (uint16_t)value);
 }
 
 /**
  * @brief Write uint8_t to buffer
  */
-static void write_u8(uint8_t** buf, uint8_t value) {
+static void HOT_PATH_FUNC(write_u8)(uint8_t** buf, uint8_t value) {
     **buf = value;
     (*buf)++;
 }
 
+/**
+ * @brief Round a temperature to whole °C (ICD: unsigned, so clamped at 0)
+ */
+static uint16_t HOT_PATH_FUNC(temp_to_u16)(float temp_c) {
+    if (temp_c <= 0.0f) {
+        return 0;
+    }
+    if (temp_c >= 65535.0f) {
+        return 65535;
+    }
+    return (uint16_t)(temp_c + 0.5f);
+}
+
 // ============================================================================
 // Telemetry API
 // ============================================================================
 
-uint16_t telemetry_build_block(uint8_t block_id, const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
+uint16_t HOT_PATH_FUNC(telemetry_build_block)(uint8_t block_id, const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
     switch (block_id) {
         case TELEM_BLOCK_STANDARD:
             return telemetry_build_standard(state, buffer, buffer_size);
@@ -97,7 +111,7 @@ uint16_t telemetry_build_block(uint8_t block_id, const wheel_state_t* state, uin
  *   Bytes 17-20: Current measurement (Q20.12 mA, LE)
  *   Bytes 21-24: Speed measurement (Q24.8 RPM, LE)
  */
-uint16_t telemetry_build_standard(const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
+uint16_t HOT_PATH_FUNC(telemetry_build_standard)(const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
     const uint16_t required_size = 25;  // ICD: exactly 25 bytes
 
     if (buffer_size < required_size) {
@@ -186,9 +200,7 @@ uint16_t telemetry_build_standard(const wheel_state_t* state, uint8_t* buffer, u
  *   Bytes 4-5:   Motor Driver Temperature (16-bit unsigned, °C)
  *   Bytes 6-7:   Motor Temperature (16-bit unsigned, °C)
  */
-uint16_t telemetry_build_temperatures(const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
-    (void)state;  // Not used yet (simulated temps)
-
+uint16_t HOT_PATH_FUNC(telemetry_build_temperatures)(const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
     const uint16_t required_size = 8;  // ICD Table 12-11: exactly 8 bytes
 
     if (buffer_size < required_size) {
@@ -198,12 +210,12 @@ uint16_t telemetry_build_temperatures(const wheel_state_t* state, uint8_t* buffe
 
     uint8_t* buf = buffer;
 
-    // Simulated temperatures (fixed at 25°C until thermal model implemented)
+    // Thermal model nodes (nss_nrwa_t6_thermal.c)
     // ICD: 16-bit unsigned integer °C (not fixed-point)
-    uint16_t dcdc_temp = 25;           // DC-DC converter temperature
-    uint16_t enclosure_temp = 25;      // Enclosure temperature
-    uint16_t motor_driver_temp = 25;   // Motor driver temperature
-    uint16_t motor_temp = 25;          // Motor temperature
+    uint16_t dcdc_temp = temp_to_u16(state->thermal.dcdc_c);             // DC-DC converter temperature
+    uint16_t enclosure_temp = temp_to_u16(state->thermal.enclosure_c);   // Enclosure temperature
+    uint16_t motor_driver_temp = temp_to_u16(state->thermal.driver_c);   // Motor driver temperature
+    uint16_t motor_temp = temp_to_u16(state->thermal.motor_c);           // Motor temperature
 
     write_u16(&buf, dcdc_temp);
     write_u16(&buf, enclosure_temp);
@@ -227,7 +239,7 @@ uint16_t telemetry_build_temperatures(const wheel_state_t* state, uint8_t* buffe
  *   Bytes 16-19: Monitor 30V supply voltage (UQ16.16 V)
  *   Bytes 20-23: Monitor 2V5 reference voltage (UQ16.16 V)
  */
-uint16_t telemetry_build_voltages(const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
+uint16_t HOT_PATH_FUNC(telemetry_build_voltages)(const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
     const uint16_t required_size = 24;  // ICD Table 12-11: exactly 24 bytes
 
     if (buffer_size < required_size) {
@@ -270,7 +282,7 @@ uint16_t telemetry_build_voltages(const wheel_state_t* state, uint8_t* buffer, u
  *   Bytes 16-19: Monitor 12V supply current (UQ16.16 mA)
  *   Bytes 20-23: Monitor 30V supply current (Q16.16 A) - Note: Q16.16, not UQ16.16
  */
-uint16_t telemetry_build_currents(const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
+uint16_t HOT_PATH_FUNC(telemetry_build_currents)(const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
     const uint16_t required_size = 24;  // ICD Table 12-11: exactly 24 bytes
 
     if (buffer_size < required_size) {
@@ -316,7 +328,7 @@ uint16_t telemetry_build_currents(const wheel_state_t* state, uint8_t* buffer, u
  *   Bytes 12-15: Drive-Fault count (32-bit unsigned)
  *   Bytes 16-19: Drive-Overtemperature count (32-bit unsigned)
  */
-uint16_t telemetry_build_diagnostics(const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
+uint16_t HOT_PATH_FUNC(telemetry_build_diagnostics)(const wheel_state_t* state, uint8_t* buffer, uint16_t buffer_size) {
     const uint16_t required_size = 20;  // ICD Table 12-11: exactly 20 bytes
 
     if (buffer_size < required_size) {
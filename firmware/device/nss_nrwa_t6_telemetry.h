@@ -26,6 +26,9 @@
 #define TELEM_BLOCK_CURRENTS        0x03
 #define TELEM_BLOCK_DIAGNOSTICS     0x04
 
+#define TELEM_BLOCK_COUNT           5       // Block IDs 0x00 .. TELEM_BLOCK_COUNT-1
+#define TELEM_MAX_BLOCK_SIZE        25      // Largest block (STANDARD) in bytes
+
 // ============================================================================
 // Telemetry API
 // ============================================================================
@@ -4,7 +4,10 @@
  */
 
 #include "nss_nrwa_t6_test_modes.h"
+#include "nss_nrwa_t6_protection.h"
+#include "hot_path.h"
 #include "util/core_sync.h"
+#include "hardware/sync.h"
 #include "pico/stdlib.h"
 #include <stdio.h>
 #include <string.h>
@@ -14,7 +17,7 @@
 // Test Mode Table
 // ============================================================================
 
-static const test_mode_desc_t test_mode_table[TEST_MODE_COUNT] = {
+static const test_mode_desc_t HOT_PATH_DATA("test_modes") test_mode_table[TEST_MODE_COUNT] = {
     // === NONE (Idle) ===
     [TEST_MODE_NONE] = {
         .id = TEST_MODE_NONE,
@@ -180,6 +183,13 @@ static const test_mode_desc_t test_mode_table[TEST_MODE_COUNT] = {
 
 static test_mode_id_t active_test_mode = TEST_MODE_NONE;
 
+// Sequencer state shared with Core0 (written by Core1 only)
+static volatile test_seq_state_t seq_state = TEST_SEQ_IDLE;
+static volatile test_mode_id_t seq_current = TEST_MODE_NONE;
+static volatile uint32_t seq_length = 0;
+static volatile uint32_t seq_done = 0;      // Published after the result is written
+static test_seq_result_t seq_results[TEST_SEQ_MAX_MODES];
+
 // ============================================================================
 // Settling Tolerances
 // ============================================================================
@@ -208,28 +218,25 @@ bool test_mode_activate(wheel_state_t* state, test_mode_id_t mode_id) {
     }
 
     const test_mode_desc_t* desc = &test_mode_table[mode_id];
-    (void)state;  // State pointer not used - commands go through mailbox
+    (void)state;  // State pointer not used - commands go through core_sync queue
+
+    // A running sequence would override the mode at its next step
+    if (seq_state == TEST_SEQ_RUNNING) {
+        test_seq_stop();
+    }
 
-    // CRITICAL: Use inter-core command mailbox to send commands to Core1
+    // CRITICAL: Use inter-core command queue to send commands to Core1
     // Direct writes to g_wheel_state cause race conditions because Core1
-    // is continuously updating the wheel state at 100 Hz.
+    // is continuously updating the wheel state every physics tick.
 
-    // Step 1: Set control mode via command mailbox
-    // Retry loop in case mailbox is busy (Core1 runs at 100Hz, so max ~10ms wait)
-    int retries = 20;  // 20 * 1ms = 20ms max wait
-    while (!core_sync_send_command(CMD_SET_MODE, (float)desc->mode, 0.0f) && retries > 0) {
-        sleep_ms(1);
-        retries--;
-    }
-    if (retries == 0) {
-        printf("[TEST_MODE] Failed to send mode command (mailbox busy)\n");
+    // Step 1: Set control mode via command queue. Core1 drains the queue in
+    // order each tick, so the setpoint below is applied after the mode switch.
+    if (!core_sync_send_command(CMD_SET_MODE, (float)desc->mode, 0.0f)) {
+        printf("[TEST_MODE] Failed to send mode command (queue full)\n");
         return false;
     }
 
-    // Wait for Core1 to process the mode command (runs at 100Hz = 10ms period)
-    sleep_ms(15);
-
-    // Step 2: Set mode-specific setpoint via command mailbox
+    // Step 2: Set mode-specific setpoint via command queue
     command_type_t setpoint_cmd;
     switch (desc->mode) {
         case CONTROL_MODE_CURRENT:
@@ -252,13 +259,8 @@ bool test_mode_activate(wheel_state_t* state, test_mode_id_t mode_id) {
             return false;
     }
 
-    retries = 20;
-    while (!core_sync_send_command(setpoint_cmd, desc->setpoint, 0.0f) && retries > 0) {
-        sleep_ms(1);
-        retries--;
-    }
-    if (retries == 0) {
-        printf("[TEST_MODE] Failed to send setpoint command (mailbox busy)\n");
+    if (!core_sync_send_command(setpoint_cmd, desc->setpoint, 0.0f)) {
+        printf("[TEST_MODE] Failed to send setpoint command (queue full)\n");
         return false;
     }
 
@@ -274,9 +276,13 @@ bool test_mode_activate(wheel_state_t* state, test_mode_id_t mode_id) {
 }
 
 void test_mode_deactivate(wheel_state_t* state) {
-    (void)state;  // State pointer not used - commands go through mailbox
+    (void)state;  // State pointer not used - commands go through core_sync queue
+
+    if (seq_state == TEST_SEQ_RUNNING) {
+        test_seq_stop();
+    }
 
-    // Return to safe idle state via inter-core command mailbox
+    // Return to safe idle state via inter-core command queue
     core_sync_send_command(CMD_SET_MODE, (float)CONTROL_MODE_CURRENT, 0.0f);
     core_sync_send_command(CMD_SET_CURRENT, 0.0f, 0.0f);
 
@@ -292,13 +298,10 @@ test_mode_id_t test_mode_get_active(void) {
     return active_test_mode;
 }
 
-bool test_mode_is_settled(const wheel_state_t* state) {
-    if (!state || active_test_mode == TEST_MODE_NONE) {
-        return false;
-    }
-
-    const test_mode_desc_t* desc = &test_mode_table[active_test_mode];
-
+/**
+ * @brief Settle check of one mode against a wheel's state
+ */
+static bool HOT_PATH_FUNC(desc_is_settled)(const test_mode_desc_t* desc, const wheel_state_t* state) {
     switch (desc->mode) {
         case CONTROL_MODE_SPEED: {
             // Check if wheel speed has settled to target
@@ -329,6 +332,14 @@ bool test_mode_is_settled(const wheel_state_t* state) {
     }
 }
 
+bool test_mode_is_settled(const wheel_state_t* state) {
+    if (!state || active_test_mode == TEST_MODE_NONE) {
+        return false;
+    }
+
+    return desc_is_settled(&test_mode_table[active_test_mode], state);
+}
+
 const test_mode_desc_t* test_mode_get_descriptor(test_mode_id_t mode_id) {
     if (mode_id >= TEST_MODE_COUNT) {
         return NULL;
@@ -375,3 +386,284 @@ int test_mode_list_all(char* buf, size_t buf_size) {
 
     return count;
 }
+
+// ============================================================================
+// Test-Mode Sequencer
+// ============================================================================
+
+// Core1 only
+static test_mode_id_t CORE1_DATA("test_seq") seq_modes[TEST_SEQ_MAX_MODES];
+static uint32_t CORE1_DATA("test_seq") seq_settle_ticks = 0;
+static uint32_t CORE1_DATA("test_seq") seq_mode_ticks = 0;         // Physics ticks since the mode was applied
+static uint32_t CORE1_DATA("test_seq") seq_timeout_ticks = 0;
+static uint32_t CORE1_DATA("test_seq") seq_settled_run = 0;        // Consecutive settled ticks
+static uint32_t CORE1_DATA("test_seq") seq_settled_since = 0;      // seq_mode_ticks at the start of that run
+static float CORE1_DATA("test_seq") seq_start_value = 0.0f;        // Tracked quantity when the mode was applied
+static test_seq_result_t CORE1_DATA("test_seq") seq_result;        // Mode in progress
+
+/**
+ * @brief Decode a hex-digit mode list
+ *
+ * @return Number of modes, 0 if a digit is not a valid mode ID
+ */
+static uint32_t decode_list(uint32_t list, test_mode_id_t* modes) {
+    uint32_t count = 0;
+    if (list == 0) {
+        for (uint32_t id = 1; id < TEST_MODE_COUNT; id++) {
+            modes[count++] = (test_mode_id_t)id;
+        }
+        return count;
+    }
+
+    bool leading = true;
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        uint32_t id = (list >> shift) & 0xFu;
+        if (id == 0 && leading) {
+            continue;
+        }
+        leading = false;
+        if (id == TEST_MODE_NONE || id >= TEST_MODE_COUNT || count == TEST_SEQ_MAX_MODES) {
+            return 0;
+        }
+        modes[count++] = (test_mode_id_t)id;
+    }
+    return count;
+}
+
+/**
+ * @brief Settle tolerance of a control mode, in setpoint units
+ */
+static float HOT_PATH_FUNC(settle_tolerance)(control_mode_t mode) {
+    switch (mode) {
+        case CONTROL_MODE_SPEED:
+            return SPEED_SETTLING_TOLERANCE_RPM;
+        case CONTROL_MODE_CURRENT:
+            return CURRENT_SETTLING_TOLERANCE_A;
+        case CONTROL_MODE_TORQUE:
+            return TORQUE_SETTLING_TOLERANCE_MNM;
+        default:
+            return 0.0f;
+    }
+}
+
+/**
+ * @brief Quantity the mode's setpoint controls (0 for open-loop PWM)
+ */
+static float HOT_PATH_FUNC(tracked_value)(const test_mode_desc_t* desc, const wheel_state_t* state) {
+    switch (desc->mode) {
+        case CONTROL_MODE_SPEED:
+            return wheel_model_get_speed_rpm(state);
+        case CONTROL_MODE_CURRENT:
+            return state->current_out_a;
+        case CONTROL_MODE_TORQUE:
+            return state->torque_out_mnm;
+        default:
+            return 0.0f;
+    }
+}
+
+static void set_idle(wheel_state_t* state) {
+    wheel_model_set_mode(state, CONTROL_MODE_CURRENT);
+    wheel_model_set_current(state, 0.0f);
+    seq_current = TEST_MODE_NONE;
+}
+
+/**
+ * @brief Apply the next mode of the sequence
+ */
+static void begin_mode(wheel_state_t* state) {
+    test_mode_id_t id = seq_modes[seq_done];
+    const test_mode_desc_t* desc = &test_mode_table[id];
+
+    if (state->fault_latch != 0 || state->lcl_tripped) {
+        // Same soft reset as CMD_RESET: temperatures carry over
+        thermal_state_t thermal = state->thermal;
+        wheel_model_init(state);
+        protection_init(state);
+        state->thermal = thermal;
+    }
+
+    wheel_model_set_mode(state, desc->mode);
+    switch (desc->mode) {
+        case CONTROL_MODE_CURRENT:
+            wheel_model_set_current(state, desc->setpoint);
+            break;
+        case CONTROL_MODE_SPEED:
+            wheel_model_set_speed(state, desc->setpoint);
+            break;
+        case CONTROL_MODE_TORQUE:
+            wheel_model_set_torque(state, desc->setpoint);
+            break;
+        case CONTROL_MODE_PWM:
+            wheel_model_set_pwm(state, desc->setpoint);
+            break;
+    }
+
+    float timeout_s = (desc->duration_s > 0.0f) ? desc->duration_s : TEST_SEQ_DEFAULT_TIMEOUT_S;
+    seq_timeout_ticks = (uint32_t)(timeout_s / MODEL_DT_S + 0.5f);
+    seq_mode_ticks = 0;
+    seq_settled_run = 0;
+    seq_settled_since = 0;
+    seq_start_value = tracked_value(desc, state);
+    memset(&seq_result, 0, sizeof(seq_result));
+    seq_result.mode_id = id;
+    seq_current = id;
+}
+
+/**
+ * @brief Publish the mode in progress and move on
+ */
+static void end_mode(wheel_state_t* state, test_seq_outcome_t outcome, uint32_t at_ticks) {
+    const test_mode_desc_t* desc = &test_mode_table[seq_result.mode_id];
+    seq_result.outcome = outcome;
+    seq_result.settle_ms = (uint32_t)(((uint64_t)at_ticks * MODEL_DT_US) / 1000u);
+    seq_result.run_ms = (uint32_t)(((uint64_t)seq_mode_ticks * MODEL_DT_US) / 1000u);
+    seq_result.pass = desc->expect_fault ? (outcome == TEST_SEQ_OUTCOME_FAULTED)
+                                         : (outcome == TEST_SEQ_OUTCOME_SETTLED);
+
+    uint32_t done = seq_done;
+    seq_results[done] = seq_result;
+    __dmb();    // Result complete before the count that publishes it
+    seq_done = done + 1;
+
+    if (done + 1 < seq_length) {
+        begin_mode(state);
+    } else {
+        set_idle(state);
+        seq_state = TEST_SEQ_DONE;
+    }
+}
+
+void test_seq_request(wheel_state_t* state, uint32_t list, uint32_t settle_ticks) {
+    if (settle_ticks == 0) {
+        if (seq_state == TEST_SEQ_RUNNING) {
+            set_idle(state);
+            seq_state = TEST_SEQ_STOPPED;
+        }
+        return;
+    }
+
+    uint32_t length = decode_list(list, seq_modes);
+    if (length == 0) {
+        return;
+    }
+    seq_settle_ticks = settle_ticks;
+    seq_done = 0;
+    seq_length = length;
+    seq_state = TEST_SEQ_RUNNING;
+    begin_mode(state);
+}
+
+void HOT_PATH_FUNC(test_seq_tick)(wheel_state_t* state) {
+    if (seq_state != TEST_SEQ_RUNNING) {
+        return;
+    }
+
+    // One more physics tick under this mode
+    const test_mode_desc_t* desc = &test_mode_table[seq_result.mode_id];
+    seq_mode_ticks++;
+    seq_result.faults |= state->fault_latch;
+
+    float step = desc->setpoint - seq_start_value;
+    if (step != 0.0f && desc->mode != CONTROL_MODE_PWM) {
+        float past = (tracked_value(desc, state) - desc->setpoint) * ((step > 0.0f) ? 1.0f : -1.0f);
+        if (past > seq_result.overshoot) {
+            // A step inside the settle tolerance has no meaningful percentage
+            seq_result.overshoot = past;
+            seq_result.overshoot_pct = (fabsf(step) >= settle_tolerance(desc->mode))
+                                       ? past / fabsf(step) * 100.0f : 0.0f;
+        }
+    }
+
+    if (seq_result.faults != 0) {
+        end_mode(state, TEST_SEQ_OUTCOME_FAULTED, seq_mode_ticks);
+        return;
+    }
+
+    if (!desc->expect_fault && desc_is_settled(desc, state)) {
+        if (seq_settled_run++ == 0) {
+            seq_settled_since = seq_mode_ticks;
+        }
+        if (seq_settled_run >= seq_settle_ticks) {
+            end_mode(state, TEST_SEQ_OUTCOME_SETTLED, seq_settled_since);
+            return;
+        }
+    } else {
+        seq_settled_run = 0;
+    }
+
+    if (seq_mode_ticks >= seq_timeout_ticks) {
+        end_mode(state, TEST_SEQ_OUTCOME_TIMEOUT, seq_mode_ticks);
+    }
+}
+
+bool test_seq_start(uint32_t list, uint32_t settle_ticks) {
+    test_mode_id_t modes[TEST_SEQ_MAX_MODES];
+    uint32_t length = decode_list(list, modes);
+    if (length == 0) {
+        printf("[TEST_SEQ] Invalid mode list 0x%lX\n", (unsigned long)list);
+        return false;
+    }
+    if (settle_ticks == 0) {
+        settle_ticks = TEST_SEQ_SETTLE_TICKS_DEFAULT;
+    }
+
+    float list_bits;
+    memcpy(&list_bits, &list, sizeof(list_bits));
+    if (!core_sync_send_command(CMD_TEST_SEQ_START, list_bits, (float)settle_ticks)) {
+        printf("[TEST_SEQ] Failed to send start command (queue full)\n");
+        return false;
+    }
+
+    // The sequence owns the wheel now
+    active_test_mode = TEST_MODE_NONE;
+    printf("[TEST_SEQ] Started: %lu modes, settled after %lu ticks\n",
+           (unsigned long)length, (unsigned long)settle_ticks);
+    return true;
+}
+
+bool test_seq_stop(void) {
+    return core_sync_send_command(CMD_TEST_SEQ_STOP, 0.0f, 0.0f);
+}
+
+test_seq_state_t test_seq_get_state(void) {
+    return seq_state;
+}
+
+test_mode_id_t test_seq_get_current(void) {
+    return seq_current;
+}
+
+uint32_t test_seq_get_length(void) {
+    return seq_length;
+}
+
+bool test_seq_get_result(uint32_t index, test_seq_result_t* result) {
+    if (!result || index >= seq_done) {
+        return false;
+    }
+    __dmb();    // Read the result after seeing the count that published it
+    *result = seq_results[index];
+    return true;
+}
+
+void test_seq_print_report(void) {
+    static const char* outcome_names[] = { "SETTLED", "FAULTED", "TIMEOUT" };
+    uint32_t done = seq_done;
+
+    printf("[TEST_SEQ] %lu/%lu modes run\n", (unsigned long)done, (unsigned long)seq_length);
+    printf("[TEST_SEQ]  # mode        outcome  settle_ms  run_ms  overshoot      %%   faults  result\n");
+    uint32_t passed = 0;
+    for (uint32_t i = 0; i < done; i++) {
+        test_seq_result_t r;
+        if (!test_seq_get_result(i, &r)) {
+            break;
+        }
+        passed += r.pass ? 1u : 0u;
+        printf("[TEST_SEQ] %2lu %-11s %-8s %9lu %7lu %10.2f %6.1f 0x%06lX  %s\n",
+               (unsigned long)i, test_mode_table[r.mode_id].name, outcome_names[r.outcome],
+               (unsigned long)r.settle_ms, (unsigned long)r.run_ms, (double)r.overshoot,
+               (double)r.overshoot_pct, (unsigned long)r.faults, r.pass ? "PASS" : "FAIL");
+    }
+    printf("[TEST_SEQ] %lu passed, %lu failed\n", (unsigned long)passed, (unsigned long)(done - passed));
+}
@@ -148,4 +148,143 @@ const test_mode_desc_t* test_mode_get_descriptor_by_name(const char* name);
  */
 int test_mode_list_all(char* buf, size_t buf_size);
 
+// ============================================================================
+// Test-Mode Sequencer
+// ============================================================================
+
+/**
+ * The sequencer runs a list of test modes back to back on wheel 0, from the
+ * Core1 tick (test_seq_tick()), and moves to the next mode as soon as the
+ * mode's settle criterion (test_mode_is_settled() tolerances) has held for
+ * settle_ticks consecutive ticks. duration_s is the time limit of a mode
+ * (TEST_SEQ_DEFAULT_TIMEOUT_S when 0). A mode with expect_fault ends when a
+ * fault latches; any other mode ends failed on a fault. A faulted wheel is
+ * soft-reset (as CMD_RESET) before the next mode; otherwise each mode starts
+ * from the state the previous one left. The wheel returns to idle (CURRENT
+ * mode, 0 A) at the end. Activating a single test mode stops a running
+ * sequence; other setpoint commands last until the next mode starts.
+ *
+ * The list is a 32-bit value whose hex digits, read left to right, are the
+ * mode IDs to run: 0x13D runs SPEED_1000, SPEED_3000, ZERO_CROSS. Leading
+ * zero digits are skipped; 0 runs every mode in ID order.
+ */
+
+/** Most modes in one sequence */
+#define TEST_SEQ_MAX_MODES          (TEST_MODE_COUNT - 1)
+
+/** Default consecutive in-tolerance ticks that count as settled */
+#define TEST_SEQ_SETTLE_TICKS_DEFAULT   20
+
+/** Time limit of a mode without a duration_s */
+#define TEST_SEQ_DEFAULT_TIMEOUT_S  10.0f
+
+/**
+ * @brief Sequencer states
+ */
+typedef enum {
+    TEST_SEQ_IDLE = 0,              // Never run
+    TEST_SEQ_RUNNING,               // Modes remaining
+    TEST_SEQ_DONE,                  // Every mode ran
+    TEST_SEQ_STOPPED                // Stopped early (test_seq_stop())
+} test_seq_state_t;
+
+/**
+ * @brief How a mode ended
+ */
+typedef enum {
+    TEST_SEQ_OUTCOME_SETTLED = 0,   // Settle criterion held for settle_ticks
+    TEST_SEQ_OUTCOME_FAULTED,       // A fault latched
+    TEST_SEQ_OUTCOME_TIMEOUT        // Time limit reached first
+} test_seq_outcome_t;
+
+/**
+ * @brief One mode's results
+ */
+typedef struct {
+    test_mode_id_t mode_id;
+    test_seq_outcome_t outcome;
+    uint32_t settle_ms;             // Mode start to the first tick of the settled run (or the fault)
+    uint32_t run_ms;                // Mode start to mode end
+    float overshoot;                // Peak past the setpoint, in setpoint units (RPM, A, mN·m)
+    float overshoot_pct;            // overshoot as % of the step from the starting value
+    uint32_t faults;                // Fault bits latched during the mode
+    bool pass;                      // Settled clean, or faulted when expect_fault
+} test_seq_result_t;
+
+/**
+ * @brief Start a sequence (Core0)
+ *
+ * Queues the list for Core1, which starts it on its next tick.
+ *
+ * @param list Mode IDs as hex digits (0 = all modes)
+ * @param settle_ticks Consecutive settled ticks before advancing (0 = default)
+ * @return false if the list holds an invalid ID or the command queue is full
+ */
+bool test_seq_start(uint32_t list, uint32_t settle_ticks);
+
+/**
+ * @brief Stop a running sequence and return the wheel to idle (Core0)
+ *
+ * @return false if the command queue is full
+ */
+bool test_seq_stop(void);
+
+/**
+ * @brief Sequencer step (Core1, every tick, after the physics update)
+ *
+ * Checks this tick's state for settle, fault and time limit, and
+ * applies the next mode's control mode and setpoint when one ends. Does
+ * nothing while no sequence runs.
+ *
+ * @param state Wheel driven by the sequence (wheel 0)
+ */
+void test_seq_tick(wheel_state_t* state);
+
+/**
+ * @brief Core1 side of CMD_TEST_SEQ_START / CMD_TEST_SEQ_STOP
+ *
+ * Applies the first mode at once (or idles the wheel), so commands queued
+ * after the request take effect on top of it.
+ *
+ * @param state Wheel driven by the sequence (wheel 0)
+ * @param list Mode IDs as hex digits (ignored to stop)
+ * @param settle_ticks Consecutive settled ticks (0 to stop)
+ */
+void test_seq_request(wheel_state_t* state, uint32_t list, uint32_t settle_ticks);
+
+/**
+ * @brief Get the sequencer state
+ *
+ * @return Current state
+ */
+test_seq_state_t test_seq_get_state(void);
+
+/**
+ * @brief Get the mode the sequence is running
+ *
+ * @return Mode ID (TEST_MODE_NONE when not running)
+ */
+test_mode_id_t test_seq_get_current(void);
+
+/**
+ * @brief Get the number of modes in the running or last sequence
+ *
+ * @return Mode count
+ */
+uint32_t test_seq_get_length(void);
+
+/**
+ * @brief Get the result of a completed mode (Core0)
+ *
+ * @param index Position in the sequence
+ * @param result Output result
+ * @return false if that mode has not completed
+ */
+bool test_seq_get_result(uint32_t index, test_seq_result_t* result);
+
+/**
+ * @brief Print the results of the running or last sequence (Core0)
+ */
+void test_seq_print_report(void);
+
 #endif // NSS_NRWA_T6_TEST_MODES_H
@@ -0,0 +1,94 @@
+/**
+ * @file nss_nrwa_t6_thermal.c
+ * @brief NSS NRWA-T6 Lumped Thermal Model Implementation
+ */
+
+#include "nss_nrwa_t6_thermal.h"
+#include "nss_nrwa_t6_regs.h"
+#include "hot_path.h"
+#include <math.h>
+
+// ============================================================================
+// Model Parameters (lumped, tuned for plausible minutes-scale transients)
+// ============================================================================
+
+// Loss sources
+#define THERMAL_R_WINDING_OHM       0.9f        // Copper loss i²·R
+#define THERMAL_DRIVER_DROP_V       0.4f        // Conduction loss i·V
+#define THERMAL_DRIVER_IDLE_W       0.3f        // Gate drive, logic
+#define THERMAL_DCDC_EFFICIENCY     0.88f
+#define THERMAL_DCDC_IDLE_W         0.5f
+
+// Heat capacities (J/K)
+#define THERMAL_C_MOTOR             60.0f
+#define THERMAL_C_DRIVER            8.0f
+#define THERMAL_C_DCDC              10.0f
+#define THERMAL_C_ENCLOSURE         600.0f
+
+// Thermal resistances (K/W)
+#define THERMAL_R_MOTOR_ENC         1.5f
+#define THERMAL_R_DRIVER_ENC        3.0f
+#define THERMAL_R_DCDC_ENC          2.5f
+#define THERMAL_R_ENC_AMBIENT       0.8f
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * @brief Set or clear a warning bit with hysteresis
+ */
+static void HOT_PATH_FUNC(update_warning)(thermal_state_t* t, uint32_t bit, float temp_c, float limit_c) {
+    if (temp_c > limit_c) {
+        t->warnings |= bit;
+    } else if (temp_c < limit_c - THERMAL_WARN_HYSTERESIS_C) {
+        t->warnings &= ~bit;
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void thermal_init(thermal_state_t* thermal) {
+    thermal->motor_c = THERMAL_AMBIENT_C;
+    thermal->driver_c = THERMAL_AMBIENT_C;
+    thermal->dcdc_c = THERMAL_AMBIENT_C;
+    thermal->enclosure_c = THERMAL_AMBIENT_C;
+    thermal->warnings = 0;
+}
+
+void HOT_PATH_FUNC(thermal_tick)(wheel_state_t* state) {
+    thermal_state_t* t = &state->thermal;
+
+    // Heat sources (W)
+    float i = fabsf(state->current_out_a);
+    float p_copper = i * i * THERMAL_R_WINDING_OHM;
+    float p_friction = fabsf(state->torque_loss_mnm * 0.001f * state->omega_rad_s);
+    float p_driver = i * THERMAL_DRIVER_DROP_V + THERMAL_DRIVER_IDLE_W;
+    float p_load = fabsf(state->power_w) + p_copper + p_driver;
+    float p_dcdc = p_load * (1.0f / THERMAL_DCDC_EFFICIENCY - 1.0f) + THERMAL_DCDC_IDLE_W;
+
+    // Conduction into the enclosure and out to ambient (W)
+    float q_motor = (t->motor_c - t->enclosure_c) / THERMAL_R_MOTOR_ENC;
+    float q_driver = (t->driver_c - t->enclosure_c) / THERMAL_R_DRIVER_ENC;
+    float q_dcdc = (t->dcdc_c - t->enclosure_c) / THERMAL_R_DCDC_ENC;
+    float q_ambient = (t->enclosure_c - THERMAL_AMBIENT_C) / THERMAL_R_ENC_AMBIENT;
+
+    // Explicit Euler (smallest time constant R·C is ~24 s, step is 0.1 s)
+    t->motor_c += (p_copper + p_friction - q_motor) * (THERMAL_DT_S / THERMAL_C_MOTOR);
+    t->driver_c += (p_driver - q_driver) * (THERMAL_DT_S / THERMAL_C_DRIVER);
+    t->dcdc_c += (p_dcdc - q_dcdc) * (THERMAL_DT_S / THERMAL_C_DCDC);
+    t->enclosure_c += (q_motor + q_driver + q_dcdc - q_ambient) *
+                      (THERMAL_DT_S / THERMAL_C_ENCLOSURE);
+
+    // Slow protections: warnings (merged by check_protections) and the
+    // drive overtemperature counter on each new electronics warning
+    uint32_t before = t->warnings;
+    float electronics_c = (t->driver_c > t->dcdc_c) ? t->driver_c : t->dcdc_c;
+    update_warning(t, WARN_HIGH_TEMP_MOTOR, t->motor_c, THERMAL_WARN_MOTOR_C);
+    update_warning(t, WARN_HIGH_TEMP_ELECTRONICS, electronics_c, THERMAL_WARN_ELECTRONICS_C);
+    if ((t->warnings & ~before) & WARN_HIGH_TEMP_ELECTRONICS) {
+        state->drive_overtemp_count++;
+    }
+}
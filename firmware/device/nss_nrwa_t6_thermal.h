@@ -0,0 +1,58 @@
+/**
+ * @file nss_nrwa_t6_thermal.h
+ * @brief NSS NRWA-T6 Lumped Thermal Model
+ *
+ * Four first-order RC nodes that feed the TEMPERATURES telemetry block:
+ * motor winding, motor driver and DC-DC converter each heat from their
+ * own losses and conduct into the enclosure, which radiates to a fixed
+ * ambient. Loss sources come from the electrical state the dynamics
+ * already compute (current, shaft power, loss torque).
+ *
+ * The nodes have time constants of tens of seconds to many minutes, so
+ * the model runs as a slow Core1 task every THERMAL_PERIOD_TICKS rather
+ * than in the hard real-time slot. The same task raises the high
+ * temperature warnings and counts drive overtemperature events (ICD
+ * DIAGNOSTICS block); no thermal fault trips the LCL.
+ */
+
+#ifndef NSS_NRWA_T6_THERMAL_H
+#define NSS_NRWA_T6_THERMAL_H
+
+#include "nss_nrwa_t6_model.h"
+
+/** Thermal model rate (Hz); folded into a tick divider below */
+#define THERMAL_RATE_HZ             10
+
+/** Ticks between thermal model updates (>= 1) */
+#define THERMAL_PERIOD_TICKS        ((PHYSICS_TICK_RATE_HZ / THERMAL_RATE_HZ) > 0 ? \
+                                     (PHYSICS_TICK_RATE_HZ / THERMAL_RATE_HZ) : 1)
+
+/** Thermal model time step (s) */
+#define THERMAL_DT_S                ((float)THERMAL_PERIOD_TICKS * MODEL_DT_S)
+
+// Environment
+#define THERMAL_AMBIENT_C           25.0f       // Mounting interface / ambient
+
+// High temperature warnings (non-latching, WARN_HIGH_TEMP_*)
+#define THERMAL_WARN_MOTOR_C        100.0f
+#define THERMAL_WARN_ELECTRONICS_C  85.0f       // Driver or DC-DC
+#define THERMAL_WARN_HYSTERESIS_C   5.0f
+
+/**
+ * @brief Set every node to ambient (power-on)
+ *
+ * @param thermal Thermal state
+ */
+void thermal_init(thermal_state_t* thermal);
+
+/**
+ * @brief Advance the thermal model by THERMAL_DT_S
+ *
+ * Updates state->thermal and, on a new electronics warning,
+ * state->drive_overtemp_count.
+ *
+ * @param state Wheel state (electrical inputs, thermal outputs)
+ */
+void thermal_tick(wheel_state_t* state);
+
+#endif // NSS_NRWA_T6_THERMAL_H
@@ -0,0 +1,36 @@
+/**
+ * @file wheel_profile.c
+ * @brief Wheel Variant Profile Descriptors
+ */
+
+#include "wheel_profile.h"
+
+#define WHEEL_PROFILE_ENTRY(p) {                                    \
+        .name = WP_##p##_NAME,                                      \
+        .inertia_kgm2 = WP_##p##_INERTIA_KGM2,                      \
+        .kt_nm_per_a = WP_##p##_KT_NM_PER_A,                        \
+        .loss_viscous_a = WP_##p##_LOSS_VISCOUS_A,                  \
+        .loss_coulomb_b = WP_##p##_LOSS_COULOMB_B,                  \
+        .loss_copper_c = WP_##p##_LOSS_COPPER_C,                    \
+        .overvoltage_v = WP_##p##_OVERVOLTAGE_V,                    \
+        .overspeed_fault_rpm = WP_##p##_OVERSPEED_FAULT_RPM,        \
+        .overspeed_soft_rpm = WP_##p##_OVERSPEED_SOFT_RPM,          \
+        .max_duty_cycle_pct = WP_##p##_MAX_DUTY_CYCLE_PCT,          \
+        .overpower_w = WP_##p##_OVERPOWER_W,                        \
+        .soft_overcurrent_a = WP_##p##_SOFT_OVERCURRENT_A,          \
+        .hard_overcurrent_a = WP_##p##_HARD_OVERCURRENT_A,          \
+        .braking_load_v = WP_##p##_BRAKING_LOAD_V,                  \
+        .loss_curve_mnm = WP_##p##_LOSS_CURVE,                      \
+        .loss_curve_points = WP_##p##_LOSS_CURVE_POINTS,            \
+        .loss_curve_step_rpm = WP_##p##_LOSS_CURVE_STEP_RPM,        \
+    }
+
+const wheel_profile_t g_wheel_profiles[WHEEL_PROFILE_COUNT] = {
+    [WHEEL_PROFILE_ID_NRWA_T6] = WHEEL_PROFILE_ENTRY(NRWA_T6),
+    [WHEEL_PROFILE_ID_SMALL] = WHEEL_PROFILE_ENTRY(SMALL),
+    [WHEEL_PROFILE_ID_LARGE] = WHEEL_PROFILE_ENTRY(LARGE),
+};
+
+const wheel_profile_t* wheel_profile_active(void) {
+    return &g_wheel_profiles[WHEEL_PROFILE_ID];
+}
@@ -0,0 +1,161 @@
+/**
+ * @file wheel_profile.h
+ * @brief Wheel Variant Profiles (Build-Time Physical Constants)
+ *
+ * Each emulated wheel variant is a profile: its rotor inertia, motor
+ * constant, loss coefficients and default protection limits. The profile
+ * is chosen at build time (cmake -DNRWA_WHEEL_PROFILE=NRWA_T6, passed as
+ * WHEEL_PROFILE) and its values become the model's constants
+ * (WHEEL_INERTIA_KGM2, MOTOR_KT_NM_PER_A, LOSS_*, DEFAULT_* limits), so
+ * the physics tick keeps folding them into immediates and the fixed-point
+ * coefficients exactly as for a single hard-coded wheel: a profile costs
+ * nothing per tick.
+ *
+ * The same values are also collected into const descriptors
+ * (g_wheel_profiles) for display; nothing on the tick path reads them.
+ *
+ * A profile may also carry a characterized loss curve: speed-dependent
+ * loss torque (bearing drag and friction, without the copper c·i² term)
+ * in mN·m at 0, step, 2·step... RPM, e.g. from a coast-down of the flight
+ * wheel. The LUT integrator resamples it at boot into its fixed-point
+ * table (see INTEGRATOR_LUT); without a curve the table is sampled from
+ * the analytic a·ω + b. To give a profile its curve, define the array in
+ * wheel_profile.c and point WP_<NAME>_LOSS_CURVE at it.
+ *
+ * Adding a variant: define its WP_<NAME>_* values below, add
+ * WHEEL_PROFILE_ID_<NAME> and its entry in wheel_profile.c, and list it in
+ * the NRWA_WHEEL_PROFILE strings in CMakeLists.txt.
+ */
+
+#ifndef WHEEL_PROFILE_H
+#define WHEEL_PROFILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// Profiles
+// ============================================================================
+
+// NRWA-T6 (from SPEC.md and the ICD). Loss coefficients tuned for
+// coast-down times of minutes from 6000 RPM and no runaway with the LCL open.
+#define WP_NRWA_T6_NAME                     "NRWA-T6"
+#define WP_NRWA_T6_INERTIA_KGM2             0.0000535f  // kg·m²
+#define WP_NRWA_T6_KT_NM_PER_A              0.0534f     // N·m/A
+#define WP_NRWA_T6_LOSS_VISCOUS_A           0.000016f   // N·m·s/rad
+#define WP_NRWA_T6_LOSS_COULOMB_B           0.001f      // N·m
+#define WP_NRWA_T6_LOSS_COPPER_C            0.0001f     // N·m/A²
+#define WP_NRWA_T6_OVERVOLTAGE_V            36.0f       // V
+#define WP_NRWA_T6_OVERSPEED_FAULT_RPM      6000.0f     // RPM (latched)
+#define WP_NRWA_T6_OVERSPEED_SOFT_RPM       5000.0f     // RPM (warning)
+#define WP_NRWA_T6_MAX_DUTY_CYCLE_PCT       97.85f      // %
+#define WP_NRWA_T6_OVERPOWER_W              100.0f      // W
+#define WP_NRWA_T6_SOFT_OVERCURRENT_A       6.0f        // A
+#define WP_NRWA_T6_HARD_OVERCURRENT_A       6.0f        // A (trips LCL)
+#define WP_NRWA_T6_BRAKING_LOAD_V           31.0f       // V
+#define WP_NRWA_T6_LOSS_CURVE               NULL        // Measured loss curve (NULL: a·ω + b)
+#define WP_NRWA_T6_LOSS_CURVE_POINTS        0
+#define WP_NRWA_T6_LOSS_CURVE_STEP_RPM      0.0f
+
+// Smaller wheel (about half the T6 momentum, faster rotor). Scaled from
+// the T6; replace with the variant's ICD figures.
+#define WP_SMALL_NAME                       "SMALL"
+#define WP_SMALL_INERTIA_KGM2               0.0000200f
+#define WP_SMALL_KT_NM_PER_A                0.0250f
+#define WP_SMALL_LOSS_VISCOUS_A             0.000008f
+#define WP_SMALL_LOSS_COULOMB_B             0.0005f
+#define WP_SMALL_LOSS_COPPER_C              0.0001f
+#define WP_SMALL_OVERVOLTAGE_V              36.0f
+#define WP_SMALL_OVERSPEED_FAULT_RPM        8000.0f
+#define WP_SMALL_OVERSPEED_SOFT_RPM         7000.0f
+#define WP_SMALL_MAX_DUTY_CYCLE_PCT         97.85f
+#define WP_SMALL_OVERPOWER_W                40.0f
+#define WP_SMALL_SOFT_OVERCURRENT_A         3.0f
+#define WP_SMALL_HARD_OVERCURRENT_A         3.0f
+#define WP_SMALL_BRAKING_LOAD_V             31.0f
+#define WP_SMALL_LOSS_CURVE                 NULL        // Measured loss curve (NULL: a·ω + b)
+#define WP_SMALL_LOSS_CURVE_POINTS          0
+#define WP_SMALL_LOSS_CURVE_STEP_RPM        0.0f
+
+// Larger wheel (about three times the T6 momentum). Scaled from the T6;
+// replace with the variant's ICD figures.
+#define WP_LARGE_NAME                       "LARGE"
+#define WP_LARGE_INERTIA_KGM2               0.000200f
+#define WP_LARGE_KT_NM_PER_A                0.0900f
+#define WP_LARGE_LOSS_VISCOUS_A             0.000040f
+#define WP_LARGE_LOSS_COULOMB_B             0.0025f
+#define WP_LARGE_LOSS_COPPER_C              0.0002f
+#define WP_LARGE_OVERVOLTAGE_V              36.0f
+#define WP_LARGE_OVERSPEED_FAULT_RPM        5000.0f
+#define WP_LARGE_OVERSPEED_SOFT_RPM         4500.0f
+#define WP_LARGE_MAX_DUTY_CYCLE_PCT         97.85f
+#define WP_LARGE_OVERPOWER_W                150.0f
+#define WP_LARGE_SOFT_OVERCURRENT_A         8.0f
+#define WP_LARGE_HARD_OVERCURRENT_A         8.0f
+#define WP_LARGE_BRAKING_LOAD_V             31.0f
+#define WP_LARGE_LOSS_CURVE                 NULL        // Measured loss curve (NULL: a·ω + b)
+#define WP_LARGE_LOSS_CURVE_POINTS          0
+#define WP_LARGE_LOSS_CURVE_STEP_RPM        0.0f
+
+// Profile indices (g_wheel_profiles)
+#define WHEEL_PROFILE_ID_NRWA_T6            0
+#define WHEEL_PROFILE_ID_SMALL              1
+#define WHEEL_PROFILE_ID_LARGE              2
+#define WHEEL_PROFILE_COUNT                 3
+
+// ============================================================================
+// Build-Time Selection
+// ============================================================================
+
+#ifndef WHEEL_PROFILE
+#define WHEEL_PROFILE NRWA_T6
+#endif
+
+#define WP_PASTE_(a, b, c)          a##b##c
+#define WP_PASTE(a, b, c)           WP_PASTE_(a, b, c)
+
+/** Value of the selected profile (WP_<WHEEL_PROFILE>_<field>) */
+#define WHEEL_PROFILE_VALUE(field)  WP_PASTE(WP_, WHEEL_PROFILE, _##field)
+
+/** Index of the selected profile in g_wheel_profiles */
+#define WHEEL_PROFILE_ID            WP_PASTE(WHEEL_PROFILE_ID_, WHEEL_PROFILE, )
+
+/** Name of the selected profile (string literal) */
+#define WHEEL_PROFILE_NAME          WHEEL_PROFILE_VALUE(NAME)
+
+// ============================================================================
+// Descriptors
+// ============================================================================
+
+/**
+ * @brief Physical constants and default limits of one wheel variant
+ */
+typedef struct {
+    const char* name;
+    float inertia_kgm2;             // Rotor inertia (kg·m²)
+    float kt_nm_per_a;              // Motor torque constant (N·m/A)
+    float loss_viscous_a;           // a·ω (N·m·s/rad)
+    float loss_coulomb_b;           // b·sign(ω) (N·m)
+    float loss_copper_c;            // c·i² (N·m/A²)
+    float overvoltage_v;
+    float overspeed_fault_rpm;
+    float overspeed_soft_rpm;
+    float max_duty_cycle_pct;
+    float overpower_w;
+    float soft_overcurrent_a;
+    float hard_overcurrent_a;
+    float braking_load_v;
+    const float* loss_curve_mnm;    // Loss torque at i·step RPM (NULL: analytic)
+    uint32_t loss_curve_points;     // At least 2 with a curve
+    float loss_curve_step_rpm;
+} wheel_profile_t;
+
+/** Every profile, indexed by WHEEL_PROFILE_ID_* */
+extern const wheel_profile_t g_wheel_profiles[WHEEL_PROFILE_COUNT];
+
+/**
+ * @brief Get the profile this build emulates
+ */
+const wheel_profile_t* wheel_profile_active(void);
+
+#endif // WHEEL_PROFILE_H
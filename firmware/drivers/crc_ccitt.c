@@ -16,9 +16,19 @@
  * 3. Return final CRC
  *
  * The polynomial 0x1021 becomes 0x8408 when reversed for LSB-first processing.
+ *
+ * Backends (all bit-exact, see test_crc_vectors):
+ * - Bitwise:  reference implementation of the algorithm above
+ * - Table:    256-entry lookup table in SRAM, one lookup per byte (default)
+ * - DMA:      RP2040 DMA sniffer in CRC16R mode for frames of
+ *             CRC_CCITT_DMA_MIN_LEN bytes or more (CRC_CCITT_DMA_SNIFFER=1)
  */
 
 #include "crc_ccitt.h"
+#include "hot_path.h"
+#include "pico/platform.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
 #include <stdbool.h>
 
 /**
@@ -29,15 +39,59 @@
  */
 #define CRC_CCITT_POLY_REVERSED 0x8408
 
+// ============================================================================
+// Lookup Table (SRAM)
+// ============================================================================
+
 /**
- * @brief Update CRC-16 CCITT with new data (LSB-first)
+ * @brief LSB-first CRC-16 CCITT table: crc_ccitt_table[i] = CRC of byte i
  *
- * @param crc Current CRC value
- * @param data Pointer to data buffer
- * @param len Number of bytes to process
- * @return Updated CRC value
+ * Generated from CRC_CCITT_POLY_REVERSED. Placed in SRAM so a lookup never
+ * waits on an XIP cache miss on the reply path.
  */
-uint16_t crc_ccitt_update(uint16_t crc, const uint8_t *data, size_t len) {
+const uint16_t __not_in_flash("crc_ccitt") crc_ccitt_table[256] = {
+    0x0000, 0x1189, 0x2312, 0x329B, 0x4624, 0x57AD, 0x6536, 0x74BF,
+    0x8C48, 0x9DC1, 0xAF5A, 0xBED3, 0xCA6C, 0xDBE5, 0xE97E, 0xF8F7,
+    0x1081, 0x0108, 0x3393, 0x221A, 0x56A5, 0x472C, 0x75B7, 0x643E,
+    0x9CC9, 0x8D40, 0xBFDB, 0xAE52, 0xDAED, 0xCB64, 0xF9FF, 0xE876,
+    0x2102, 0x308B, 0x0210, 0x1399, 0x6726, 0x76AF, 0x4434, 0x55BD,
+    0xAD4A, 0xBCC3, 0x8E58, 0x9FD1, 0xEB6E, 0xFAE7, 0xC87C, 0xD9F5,
+    0x3183, 0x200A, 0x1291, 0x0318, 0x77A7, 0x662E, 0x54B5, 0x453C,
+    0xBDCB, 0xAC42, 0x9ED9, 0x8F50, 0xFBEF, 0xEA66, 0xD8FD, 0xC974,
+    0x4204, 0x538D, 0x6116, 0x709F, 0x0420, 0x15A9, 0x2732, 0x36BB,
+    0xCE4C, 0xDFC5, 0xED5E, 0xFCD7, 0x8868, 0x99E1, 0xAB7A, 0xBAF3,
+    0x5285, 0x430C, 0x7197, 0x601E, 0x14A1, 0x0528, 0x37B3, 0x263A,
+    0xDECD, 0xCF44, 0xFDDF, 0xEC56, 0x98E9, 0x8960, 0xBBFB, 0xAA72,
+    0x6306, 0x728F, 0x4014, 0x519D, 0x2522, 0x34AB, 0x0630, 0x17B9,
+    0xEF4E, 0xFEC7, 0xCC5C, 0xDDD5, 0xA96A, 0xB8E3, 0x8A78, 0x9BF1,
+    0x7387, 0x620E, 0x5095, 0x411C, 0x35A3, 0x242A, 0x16B1, 0x0738,
+    0xFFCF, 0xEE46, 0xDCDD, 0xCD54, 0xB9EB, 0xA862, 0x9AF9, 0x8B70,
+    0x8408, 0x9581, 0xA71A, 0xB693, 0xC22C, 0xD3A5, 0xE13E, 0xF0B7,
+    0x0840, 0x19C9, 0x2B52, 0x3ADB, 0x4E64, 0x5FED, 0x6D76, 0x7CFF,
+    0x9489, 0x8500, 0xB79B, 0xA612, 0xD2AD, 0xC324, 0xF1BF, 0xE036,
+    0x18C1, 0x0948, 0x3BD3, 0x2A5A, 0x5EE5, 0x4F6C, 0x7DF7, 0x6C7E,
+    0xA50A, 0xB483, 0x8618, 0x9791, 0xE32E, 0xF2A7, 0xC03C, 0xD1B5,
+    0x2942, 0x38CB, 0x0A50, 0x1BD9, 0x6F66, 0x7EEF, 0x4C74, 0x5DFD,
+    0xB58B, 0xA402, 0x9699, 0x8710, 0xF3AF, 0xE226, 0xD0BD, 0xC134,
+    0x39C3, 0x284A, 0x1AD1, 0x0B58, 0x7FE7, 0x6E6E, 0x5CF5, 0x4D7C,
+    0xC60C, 0xD785, 0xE51E, 0xF497, 0x8028, 0x91A1, 0xA33A, 0xB2B3,
+    0x4A44, 0x5BCD, 0x6956, 0x78DF, 0x0C60, 0x1DE9, 0x2F72, 0x3EFB,
+    0xD68D, 0xC704, 0xF59F, 0xE416, 0x90A9, 0x8120, 0xB3BB, 0xA232,
+    0x5AC5, 0x4B4C, 0x79D7, 0x685E, 0x1CE1, 0x0D68, 0x3FF3, 0x2E7A,
+    0xE70E, 0xF687, 0xC41C, 0xD595, 0xA12A, 0xB0A3, 0x8238, 0x93B1,
+    0x6B46, 0x7ACF, 0x4854, 0x59DD, 0x2D62, 0x3CEB, 0x0E70, 0x1FF9,
+    0xF78F, 0xE606, 0xD49D, 0xC514, 0xB1AB, 0xA022, 0x92B9, 0x8330,
+    0x7BC7, 0x6A4E, 0x58D5, 0x495C, 0x3DE3, 0x2C6A, 0x1EF1, 0x0F78,
+};
+
+// ============================================================================
+// Backends
+// ============================================================================
+
+/**
+ * @brief Bitwise reference backend (LSB-first)
+ */
+uint16_t crc_ccitt_update_bitwise(uint16_t crc, const uint8_t *data, size_t len) {
     // Handle NULL pointer or zero length
     if (data == NULL || len == 0) {
         return crc;
@@ -63,6 +117,121 @@ uint16_t crc_ccitt_update(uint16_t crc, const uint8_t *data, size_t len) {
     return crc;
 }
 
+/**
+ * @brief Table backend: one lookup and shift per byte
+ */
+uint16_t __not_in_flash_func(crc_ccitt_update_table)(uint16_t crc, const uint8_t *data, size_t len) {
+    if (data == NULL || len == 0) {
+        return crc;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        crc = (crc >> 8) ^ crc_ccitt_table[(crc ^ data[i]) & 0xFF];
+    }
+
+    return crc;
+}
+
+// ============================================================================
+// DMA Sniffer Backend
+// ============================================================================
+
+/** DMA channel used for sniffer CRC (-1 = not claimed) */
+static int crc_dma_chan = -1;
+
+/** Sniffer in use (IRQ and thread may both compute CRCs) */
+static volatile bool crc_dma_busy = false;
+
+/** Sink for the sniffed transfer (write address does not increment) */
+static volatile uint8_t crc_dma_sink;
+
+/**
+ * @brief Reverse the bit order of a 16-bit value
+ */
+static inline uint16_t HOT_PATH_FUNC(crc_bitrev16)(uint16_t x) {
+    x = (uint16_t)(((x & 0x5555) << 1) | ((x >> 1) & 0x5555));
+    x = (uint16_t)(((x & 0x3333) << 2) | ((x >> 2) & 0x3333));
+    x = (uint16_t)(((x & 0x0F0F) << 4) | ((x >> 4) & 0x0F0F));
+    return (uint16_t)((x << 8) | (x >> 8));
+}
+
+bool crc_ccitt_dma_init(void) {
+    if (crc_dma_chan >= 0) {
+        return true;
+    }
+
+    int chan = dma_claim_unused_channel(false);
+    if (chan < 0) {
+        return false;
+    }
+
+    dma_channel_config cfg = dma_channel_get_default_config((uint)chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_sniff_enable(&cfg, true);
+    dma_channel_configure((uint)chan, &cfg, &crc_dma_sink, NULL, 0, false);
+
+    crc_dma_chan = chan;
+    return true;
+}
+
+/**
+ * @brief DMA sniffer backend
+ *
+ * The sniffer's CRC16R mode runs the MSB-first CCITT CRC over bit-reversed
+ * input bytes. With the register seeded and read back bit-reversed, that is
+ * exactly the LSB-first (reflected) CRC used by NSP. Falls back to the table
+ * if the channel is not claimed or the sniffer is already in use.
+ */
+uint16_t HOT_PATH_FUNC(crc_ccitt_update_dma)(uint16_t crc, const uint8_t *data, size_t len) {
+    if (data == NULL || len == 0) {
+        return crc;
+    }
+
+    uint32_t save = save_and_disable_interrupts();
+    bool available = (crc_dma_chan >= 0) && !crc_dma_busy;
+    if (available) {
+        crc_dma_busy = true;
+    }
+    restore_interrupts(save);
+
+    if (!available) {
+        return crc_ccitt_update_table(crc, data, len);
+    }
+
+    dma_sniffer_enable((uint)crc_dma_chan, DMA_SNIFF_CTRL_CALC_VALUE_CRC16R, true);
+    dma_hw->sniff_data = crc_bitrev16(crc);
+    dma_channel_transfer_from_buffer_now((uint)crc_dma_chan, data, (uint32_t)len);
+    dma_channel_wait_for_finish_blocking((uint)crc_dma_chan);
+    crc = crc_bitrev16((uint16_t)dma_hw->sniff_data);
+    dma_sniffer_disable();
+
+    crc_dma_busy = false;
+    return crc;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Update CRC-16 CCITT with new data (LSB-first)
+ *
+ * @param crc Current CRC value
+ * @param data Pointer to data buffer
+ * @param len Number of bytes to process
+ * @return Updated CRC value
+ */
+uint16_t HOT_PATH_FUNC(crc_ccitt_update)(uint16_t crc, const uint8_t *data, size_t len) {
+#if CRC_CCITT_DMA_SNIFFER
+    if (len >= CRC_CCITT_DMA_MIN_LEN && crc_dma_chan >= 0) {
+        return crc_ccitt_update_dma(crc, data, len);
+    }
+#endif
+    return crc_ccitt_update_table(crc, data, len);
+}
+
 /**
  * @brief Calculate CRC-16 CCITT for a buffer (one-shot)
  *
@@ -70,7 +239,7 @@ uint16_t crc_ccitt_update(uint16_t crc, const uint8_t *data, size_t len) {
  * @param len Number of bytes to process
  * @return Calculated CRC value
  */
-uint16_t crc_ccitt_calculate(const uint8_t *data, size_t len) {
+uint16_t HOT_PATH_FUNC(crc_ccitt_calculate)(const uint8_t *data, size_t len) {
     uint16_t crc = crc_ccitt_init();
     return crc_ccitt_update(crc, data, len);
 }
@@ -84,7 +253,7 @@ uint16_t crc_ccitt_calculate(const uint8_t *data, size_t len) {
  * @param len Total packet length including CRC (must be >= 2)
  * @return true if CRC is valid, false otherwise
  */
-bool crc_ccitt_verify(const uint8_t *packet, size_t len) {
+bool HOT_PATH_FUNC(crc_ccitt_verify)(const uint8_t *packet, size_t len) {
     // Need at least 2 bytes for CRC
     if (packet == NULL || len < 2) {
         return false;
@@ -109,7 +278,7 @@ bool crc_ccitt_verify(const uint8_t *packet, size_t len) {
  * @param data_len Length of data already in buffer
  * @return Total length (data_len + 2)
  */
-size_t crc_ccitt_append(uint8_t *buffer, size_t data_len) {
+size_t HOT_PATH_FUNC(crc_ccitt_append)(uint8_t *buffer, size_t data_len) {
     if (buffer == NULL) {
         return 0;
     }
@@ -37,6 +37,36 @@
  */
 #define CRC_CCITT_INIT 0xFFFF
 
+/**
+ * @brief Route large buffers through the DMA sniffer (0 = table only)
+ *
+ * Requires crc_ccitt_dma_init() at startup; until then the table is used.
+ */
+#ifndef CRC_CCITT_DMA_SNIFFER
+#define CRC_CCITT_DMA_SNIFFER 0
+#endif
+
+/**
+ * @brief Minimum length for the DMA sniffer backend
+ *
+ * Below this, programming the channel costs more than the table lookups.
+ */
+#define CRC_CCITT_DMA_MIN_LEN 64
+
+/**
+ * @brief CRC residue of a frame followed by its own CRC (LSB first)
+ *
+ * With no final XOR, running the CRC over [data | CRC_L | CRC_H] yields 0,
+ * so a streaming receiver can validate a frame without knowing where the
+ * payload ends.
+ */
+#define CRC_CCITT_RESIDUE 0x0000
+
+/**
+ * @brief LSB-first lookup table (SRAM, see crc_ccitt.c)
+ */
+extern const uint16_t crc_ccitt_table[256];
+
 /**
  * @brief Initialize CRC-16 CCITT
  *
@@ -46,6 +76,19 @@ static inline uint16_t crc_ccitt_init(void) {
     return CRC_CCITT_INIT;
 }
 
+/**
+ * @brief Update CRC-16 CCITT with a single byte (table lookup)
+ *
+ * For streaming use (e.g. accumulate while SLIP-decoding).
+ *
+ * @param crc Current CRC value
+ * @param byte Next data byte
+ * @return Updated CRC value
+ */
+static inline uint16_t crc_ccitt_update_byte(uint16_t crc, uint8_t byte) {
+    return (crc >> 8) ^ crc_ccitt_table[(crc ^ byte) & 0xFF];
+}
+
 /**
  * @brief Update CRC-16 CCITT with new data
  *
@@ -59,6 +102,34 @@ static inline uint16_t crc_ccitt_init(void) {
  */
 uint16_t crc_ccitt_update(uint16_t crc, const uint8_t *data, size_t len);
 
+/**
+ * @brief Bitwise reference backend (8 shift/XOR steps per byte)
+ *
+ * Same signature and result as crc_ccitt_update(). Kept for verification.
+ */
+uint16_t crc_ccitt_update_bitwise(uint16_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief Table backend (256-entry SRAM lookup table, default path)
+ */
+uint16_t crc_ccitt_update_table(uint16_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief DMA sniffer backend
+ *
+ * Uses the RP2040 DMA sniffer CRC hardware. Blocks until the transfer is
+ * done. Falls back to the table backend if crc_ccitt_dma_init() has not
+ * succeeded or the sniffer is busy.
+ */
+uint16_t crc_ccitt_update_dma(uint16_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief Claim a DMA channel for the sniffer backend
+ *
+ * @return true if a channel is available for crc_ccitt_update_dma()
+ */
+bool crc_ccitt_dma_init(void);
+
 /**
  * @brief Calculate CRC-16 CCITT for a buffer (one-shot)
  *
@@ -0,0 +1,121 @@
+/**
+ * @file fault_line.c
+ * @brief Hardware FAULT Line Output Implementation
+ */
+
+#include "fault_line.h"
+#include "board_pico.h"
+#include "timebase.h"
+#include "hot_path.h"
+#include "hardware/gpio.h"
+#include "pico/time.h"
+#include <stdio.h>
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+// Core1 (tick loop and the one-shot in its alarm ISR)
+static volatile bool CORE1_DATA("fault") line_scheduled = false;     // One-shot pending
+static uint32_t CORE1_DATA("fault") line_detect_us = 0;              // Detecting tick start
+static uint32_t CORE1_DATA("fault") line_due_us = 0;                 // Scheduled assertion
+
+// Written by Core0
+static volatile uint32_t line_delay_us = FAULT_ASSERT_DELAY_US;
+
+// Written by Core1, read by Core0
+static volatile fault_line_stats_t line_stats;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * @brief Drive the line low (tick loop, or the alarm ISR for a delay)
+ */
+static void HOT_PATH_FUNC(line_assert)(void) {
+    gpio_put(FAULT_PIN, 0);  // Single SIO write
+    uint32_t latency_us = time_us_32() - line_detect_us;
+    line_scheduled = false;
+    line_stats.asserted = true;
+    line_stats.asserts++;
+    line_stats.last_latency_us = latency_us;
+    if (latency_us > line_stats.max_latency_us) {
+        line_stats.max_latency_us = latency_us;
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void fault_line_init(void) {
+    gpio_put(FAULT_PIN, 1);  // Released (gpio_map_init() made it an output)
+    line_scheduled = false;
+    line_stats.asserted = false;
+    printf("[FAULT] FAULT line on GPIO %u driven by Core1 (delay %lu us)\n",
+           (unsigned)FAULT_PIN, (unsigned long)line_delay_us);
+}
+
+void HOT_PATH_FUNC(fault_line_update)(const wheel_state_t* wheels, uint8_t count,
+                                      uint32_t tick_start_us) {
+    bool fault = false;
+    for (uint8_t w = 0; w < count; w++) {
+        fault |= (wheels[w].fault_latch != 0) || wheels[w].lcl_tripped;
+    }
+
+    if (!fault) {
+        if (line_scheduled) {
+            timebase_cancel_oneshot();
+            line_scheduled = false;
+        }
+        if (line_stats.asserted) {
+            gpio_put(FAULT_PIN, 1);
+            line_stats.asserted = false;
+        }
+        return;
+    }
+
+    if (line_stats.asserted) {
+        return;
+    }
+    if (line_scheduled) {
+        // Dropped by a switch to stepped mode: assert now
+        if ((int32_t)(time_us_32() - line_due_us) > (int32_t)PHYSICS_TICK_PERIOD_US) {
+            timebase_cancel_oneshot();
+            line_assert();
+        }
+        return;
+    }
+
+    // New fault, detected in this tick
+    line_detect_us = tick_start_us;
+    uint32_t delay_us = line_delay_us;
+    if (delay_us > 0) {
+        line_due_us = tick_start_us + delay_us;
+        line_scheduled = true;
+        if (timebase_schedule_oneshot(line_due_us, line_assert)) {
+            return;
+        }
+        line_scheduled = false;
+    }
+    line_assert();  // No delay, already due, or stepped mode
+}
+
+bool fault_line_set_delay_us(uint32_t delay_us) {
+    if (delay_us > FAULT_ASSERT_DELAY_MAX_US) {
+        return false;
+    }
+    line_delay_us = delay_us;
+    return true;
+}
+
+void fault_line_get_stats(fault_line_stats_t* stats) {
+    if (!stats) {
+        return;
+    }
+    stats->asserted = line_stats.asserted;
+    stats->asserts = line_stats.asserts;
+    stats->last_latency_us = line_stats.last_latency_us;
+    stats->max_latency_us = line_stats.max_latency_us;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file fault_line.h
+ * @brief Hardware FAULT Line Output
+ *
+ * Drives FAULT_PIN (active low) from the wheel models: asserted while any
+ * wheel has a latched fault or a tripped LCL, released when all are clear
+ * (CLEAR-FAULT; an LCL trip holds it until reset).
+ *
+ * Core1 checks the models right after each physics tick and writes the
+ * pin through SIO, so with no delay the line goes low in the tick that
+ * detected the fault. A configurable delay emulates the real unit's
+ * detection-to-pin timing: the assertion is then a timebase one-shot at
+ * the tick start plus the delay, sub-tick and free of CPU load. In
+ * stepped mode there is no real time to wait for and the delay is skipped.
+ *
+ * Core1 owns the pin; Core0 only sets the delay and reads the statistics.
+ */
+
+#ifndef FAULT_LINE_H
+#define FAULT_LINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../device/nss_nrwa_t6_model.h"
+
+/**
+ * @brief FAULT line statistics
+ */
+typedef struct {
+    bool asserted;              // Pin driven low now
+    uint32_t asserts;           // Assertions since boot
+    uint32_t last_latency_us;   // Detecting tick start to pin low, last assertion
+    uint32_t max_latency_us;    // Worst of the above since boot
+} fault_line_stats_t;
+
+/**
+ * @brief Release the line and start from no fault (call once on Core1)
+ */
+void fault_line_init(void);
+
+/**
+ * @brief Follow the wheel fault state (Core1, right after each physics tick)
+ *
+ * @param wheels Wheel states just updated by the tick
+ * @param count Number of wheels
+ * @param tick_start_us time_us_32() when the tick started
+ */
+void fault_line_update(const wheel_state_t* wheels, uint8_t count, uint32_t tick_start_us);
+
+/**
+ * @brief Set the assertion delay (Core0; applies to the next assertion)
+ *
+ * @param delay_us Delay after the detecting tick starts (0 = in that tick)
+ * @return false if above FAULT_ASSERT_DELAY_MAX_US (unchanged)
+ */
+bool fault_line_set_delay_us(uint32_t delay_us);
+
+/**
+ * @brief Get the FAULT line statistics
+ *
+ * @param stats Output statistics
+ */
+void fault_line_get_stats(fault_line_stats_t* stats);
+
+#endif // FAULT_LINE_H
@@ -0,0 +1,114 @@
+/**
+ * @file hall_out.c
+ * @brief Hall Sensor / Tachometer Pulse Output Implementation
+ */
+
+#include "hall_out.h"
+#include "board_pico.h"
+#include "hot_path.h"
+#include "hardware/pio.h"
+#include "hardware/gpio.h"
+#include "hardware/clocks.h"
+#include "hall_pio.pio.h"
+#include <math.h>
+#include <stdio.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define HALL_PIO                pio1
+#define HALL_SM                 0
+
+/** Cycles per step outside the delay loop (set, mov, jmp pin, loop exit) */
+#define HALL_BLOCK_CYCLES       4u
+
+/** Commutation steps per electrical revolution */
+#define HALL_STEPS_PER_CYCLE    6u
+
+/** Radians per revolution */
+#define HALL_TWO_PI             6.28318530718f
+
+// ============================================================================
+// Internal State (Core1)
+// ============================================================================
+
+static bool CORE1_DATA("hall") hall_ready = false;
+static bool CORE1_DATA("hall") hall_running = false;          // State machine enabled
+static uint32_t CORE1_DATA("hall") hall_delay = 0;            // Step delay last loaded
+static float CORE1_DATA("hall") hall_cycles_rad = 0.0f;       // Cycles per step × rad/s
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool hall_out_init(void) {
+    if (!pio_can_add_program(HALL_PIO, &hall_tach_program)) {
+        printf("[HALL] No room in PIO1, Hall output disabled\n");
+        return false;
+    }
+    uint offset = pio_add_program(HALL_PIO, &hall_tach_program);
+    pio_sm_claim(HALL_PIO, HALL_SM);
+
+    // Direction pin is a plain output the state machine reads as its JMP pin
+    gpio_init(HALL_DIR_PIN);
+    gpio_set_dir(HALL_DIR_PIN, GPIO_OUT);
+    gpio_put(HALL_DIR_PIN, 0);
+
+    pio_sm_set_pins_with_mask(HALL_PIO, HALL_SM, 0, 7u << HALL_A_PIN);
+    pio_sm_set_consecutive_pindirs(HALL_PIO, HALL_SM, HALL_A_PIN, 3, true);
+    pio_gpio_init(HALL_PIO, HALL_A_PIN);
+    pio_gpio_init(HALL_PIO, HALL_B_PIN);
+    pio_gpio_init(HALL_PIO, HALL_C_PIN);
+
+    pio_sm_config c = hall_tach_program_get_default_config(offset);
+    sm_config_set_set_pins(&c, HALL_A_PIN, 3);
+    sm_config_set_jmp_pin(&c, HALL_DIR_PIN);
+    sm_config_set_clkdiv_int_frac(&c, 1, 0);
+    pio_sm_init(HALL_PIO, HALL_SM, offset, &c);
+
+    // Delay = cycles per step: clk_sys × 2π / (|ω| × pole pairs × 6)
+    hall_cycles_rad = (float)clock_get_hz(clk_sys) * HALL_TWO_PI /
+                      (float)(HALL_POLE_PAIRS * HALL_STEPS_PER_CYCLE);
+    hall_ready = true;
+    printf("[HALL] Hall output on GPIO %u-%u (dir GPIO %u), %u pole pairs\n",
+           (unsigned)HALL_A_PIN, (unsigned)HALL_C_PIN, (unsigned)HALL_DIR_PIN,
+           (unsigned)HALL_POLE_PAIRS);
+    return true;
+}
+
+void HOT_PATH_FUNC(hall_out_update)(float omega_rad_s) {
+    if (!hall_ready) {
+        return;
+    }
+
+    float speed = fabsf(omega_rad_s);
+    if (speed < HALL_MIN_RPM * (HALL_TWO_PI / 60.0f)) {
+        if (hall_running) {
+            pio_sm_set_enabled(HALL_PIO, HALL_SM, false);  // Hold the state
+            hall_running = false;
+        }
+        return;
+    }
+
+    float cycles = hall_cycles_rad / speed;
+    uint32_t delay = (cycles > 4.0e9f) ? 4000000000u :
+                     (cycles < (float)(HALL_BLOCK_CYCLES + 1u)) ? 1u :
+                     (uint32_t)cycles - HALL_BLOCK_CYCLES;
+
+    gpio_put(HALL_DIR_PIN, omega_rad_s < 0.0f);
+    if (delay != hall_delay || !hall_running) {
+        pio_sm_put(HALL_PIO, HALL_SM, delay);
+        pio_sm_exec(HALL_PIO, HALL_SM, pio_encode_pull(false, false));
+        // Restart the step in progress when it started from stop or is
+        // more than twice as long as the new one
+        if (!hall_running || delay < hall_delay / 2u) {
+            pio_sm_exec(HALL_PIO, HALL_SM, pio_encode_mov(pio_x, pio_osr));
+        }
+        hall_delay = delay;
+    }
+    if (!hall_running) {
+        pio_sm_set_enabled(HALL_PIO, HALL_SM, true);
+        hall_running = true;
+    }
+}
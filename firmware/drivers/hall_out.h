@@ -0,0 +1,41 @@
+/**
+ * @file hall_out.h
+ * @brief Hall Sensor / Tachometer Pulse Output
+ *
+ * Drives HALL_A/B/C_PIN with the six-state commutation sequence of a
+ * motor with HALL_POLE_PAIRS pole pairs turning at the emulated speed of
+ * wheel 0, and HALL_DIR_PIN with the direction (high = negative speed).
+ * Each Hall line is a tach signal of HALL_POLE_PAIRS cycles per
+ * revolution, 120° apart.
+ *
+ * The edges come from a PIO1 state machine (drivers/hall_pio.pio): Core1
+ * only writes the step delay once per tick, so edge timing has no CPU
+ * jitter and costs a few cycles per tick. The period changes on the next
+ * step boundary; a speed step of more than 2x restarts the current step
+ * so a fast wheel is not held by the last slow step. Below HALL_MIN_RPM
+ * the output holds its state.
+ *
+ * Core1 only (the state machine and the direction pin belong to it).
+ */
+
+#ifndef HALL_OUT_H
+#define HALL_OUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Load the program and claim the pins (call once on Core1)
+ *
+ * @return false if PIO1 has no room (output stays off)
+ */
+bool hall_out_init(void);
+
+/**
+ * @brief Set the output speed (once per physics tick)
+ *
+ * @param omega_rad_s Wheel speed (rad/s, sign = direction)
+ */
+void hall_out_update(float omega_rad_s);
+
+#endif // HALL_OUT_H
@@ -0,0 +1,187 @@
+/**
+ * @file monitor_out.c
+ * @brief PWM Analog Monitor Outputs Implementation
+ */
+
+#include "monitor_out.h"
+#include "board_pico.h"
+#include "hot_path.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/clocks.h"
+#include <stdint.h>
+#include <stdio.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+/** PWM counter top (10-bit levels: 122 kHz carrier at 125 MHz) */
+#define MONITOR_PWM_TOP         1023u
+
+/** Output channels */
+enum {
+    MON_SPEED = 0,
+    MON_CURRENT,
+    MON_TORQUE,
+    MON_COUNT
+};
+
+// Speed and current share one slice (A and B), torque uses channel A of another
+#define SLICE_SC                ((MONITOR_SPEED_PIN >> 1) & 7u)
+#define SLICE_T                 ((MONITOR_TORQUE_PIN >> 1) & 7u)
+
+// ============================================================================
+// Internal State (Core1)
+// ============================================================================
+
+// Sample blocks, double-buffered: one is read by DMA while Core1 fills the
+// other. Each word is a whole CC register (A level in bits 15:0, B in
+// 31:16). Main SRAM: scratch X has no room to spare beside the Core1 stack.
+static uint32_t block_sc[2][MONITOR_SAMPLES_PER_TICK];
+static uint32_t block_t[2][MONITOR_SAMPLES_PER_TICK];
+static uint32_t CORE1_DATA("monitor") block_next = 0;
+
+static int CORE1_DATA("monitor") dma_sc = -1;
+static int CORE1_DATA("monitor") dma_t = -1;
+static bool CORE1_DATA("monitor") upsample = false;
+static bool CORE1_DATA("monitor") ready = false;
+static float CORE1_DATA("monitor") level_prev[MON_COUNT];
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * @brief Value to PWM level (mid-scale = 0, clipped to full scale)
+ */
+static float HOT_PATH_FUNC(to_level)(float value, float full_scale) {
+    float level = (value / full_scale + 1.0f) * (0.5f * (float)MONITOR_PWM_TOP);
+    if (level < 0.0f) {
+        return 0.0f;
+    }
+    if (level > (float)MONITOR_PWM_TOP) {
+        return (float)MONITOR_PWM_TOP;
+    }
+    return level;
+}
+
+static void slice_init(uint slice) {
+    pwm_config c = pwm_get_default_config();
+    pwm_config_set_wrap(&c, MONITOR_PWM_TOP);
+    pwm_init(slice, &c, false);
+    pwm_set_counter(slice, 0);
+}
+
+static dma_channel_config dma_config(int timer) {
+    dma_channel_config c = dma_channel_get_default_config(0);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, dma_get_timer_dreq((uint)timer));
+    return c;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void monitor_out_init(void) {
+    slice_init(SLICE_SC);
+    slice_init(SLICE_T);
+    gpio_set_function(MONITOR_SPEED_PIN, GPIO_FUNC_PWM);
+    gpio_set_function(MONITOR_CURRENT_PIN, GPIO_FUNC_PWM);
+    gpio_set_function(MONITOR_TORQUE_PIN, GPIO_FUNC_PWM);
+
+    // Mid-scale (zero) until the first tick
+    for (uint32_t ch = 0; ch < MON_COUNT; ch++) {
+        level_prev[ch] = 0.5f * (float)MONITOR_PWM_TOP;
+    }
+    pwm_set_both_levels(SLICE_SC, MONITOR_PWM_TOP / 2u, MONITOR_PWM_TOP / 2u);
+    pwm_set_both_levels(SLICE_T, MONITOR_PWM_TOP / 2u, 0);
+    pwm_set_mask_enabled((1u << SLICE_SC) | (1u << SLICE_T));
+
+#if MONITOR_UPSAMPLE
+    // Sample pacing: clk_sys × X / Y just above MONITOR_SAMPLES_PER_TICK per
+    // tick, so a block always finishes before the next one starts
+    int timer = dma_claim_unused_timer(false);
+    dma_sc = dma_claim_unused_channel(false);
+    dma_t = dma_claim_unused_channel(false);
+    if (timer >= 0 && dma_sc >= 0 && dma_t >= 0) {
+        uint32_t rate_hz = (uint32_t)MONITOR_SAMPLES_PER_TICK * PHYSICS_TICK_RATE_HZ;
+        uint32_t x = 1;
+        uint32_t y = clock_get_hz(clk_sys) / rate_hz;
+        while (y > 0xFFFFu) {
+            x *= 2u;
+            y = (uint32_t)((uint64_t)clock_get_hz(clk_sys) * x / rate_hz);
+        }
+        dma_timer_set_fraction((uint)timer, (uint16_t)x, (uint16_t)y);
+
+        dma_channel_config c = dma_config(timer);
+        dma_channel_configure((uint)dma_sc, &c, &pwm_hw->slice[SLICE_SC].cc, block_sc[0],
+                              MONITOR_SAMPLES_PER_TICK, false);
+        c = dma_config(timer);
+        dma_channel_configure((uint)dma_t, &c, &pwm_hw->slice[SLICE_T].cc, block_t[0],
+                              MONITOR_SAMPLES_PER_TICK, false);
+        upsample = true;
+    } else {
+        printf("[MONITOR] No free DMA channel or timer: one level per tick\n");
+    }
+#endif
+
+    ready = true;
+    printf("[MONITOR] Speed/current/torque on GPIO %u/%u/%u (%s)\n",
+           (unsigned)MONITOR_SPEED_PIN, (unsigned)MONITOR_CURRENT_PIN,
+           (unsigned)MONITOR_TORQUE_PIN, upsample ? "DMA upsampled" : "per tick");
+}
+
+void HOT_PATH_FUNC(monitor_out_update)(float speed_rpm, float current_a, float torque_mnm) {
+    if (!ready) {
+        return;
+    }
+
+    float level[MON_COUNT] = {
+        to_level(speed_rpm, MONITOR_SPEED_FS_RPM),
+        to_level(current_a, MONITOR_CURRENT_FS_A),
+        to_level(torque_mnm, MONITOR_TORQUE_FS_MNM),
+    };
+
+    if (!upsample) {
+        pwm_set_both_levels(SLICE_SC, (uint16_t)level[MON_SPEED], (uint16_t)level[MON_CURRENT]);
+        pwm_set_both_levels(SLICE_T, (uint16_t)level[MON_TORQUE], 0);
+        return;
+    }
+
+    // Ramp from the last tick's levels to these over one tick
+    uint32_t* sc = block_sc[block_next];
+    uint32_t* t = block_t[block_next];
+    float step_s = (level[MON_SPEED] - level_prev[MON_SPEED]) / (float)MONITOR_SAMPLES_PER_TICK;
+    float step_c = (level[MON_CURRENT] - level_prev[MON_CURRENT]) / (float)MONITOR_SAMPLES_PER_TICK;
+    float step_t = (level[MON_TORQUE] - level_prev[MON_TORQUE]) / (float)MONITOR_SAMPLES_PER_TICK;
+    for (uint32_t k = 0; k < MONITOR_SAMPLES_PER_TICK; k++) {
+        float n = (float)(k + 1u);
+        uint32_t s = (uint32_t)(level_prev[MON_SPEED] + step_s * n);
+        uint32_t c = (uint32_t)(level_prev[MON_CURRENT] + step_c * n);
+        sc[k] = s | (c << 16);
+        t[k] = (uint32_t)(level_prev[MON_TORQUE] + step_t * n);
+    }
+    for (uint32_t ch = 0; ch < MON_COUNT; ch++) {
+        level_prev[ch] = level[ch];
+    }
+
+    // A late tick can find the last block still running: drop its tail
+    uint32_t mask = (1u << dma_sc) | (1u << dma_t);
+    if (dma_channel_is_busy((uint)dma_sc) || dma_channel_is_busy((uint)dma_t)) {
+        dma_hw->abort = mask;
+        while (dma_hw->abort & mask) {
+            tight_loop_contents();
+        }
+    }
+    dma_channel_set_read_addr((uint)dma_sc, sc, false);
+    dma_channel_set_trans_count((uint)dma_sc, MONITOR_SAMPLES_PER_TICK, false);
+    dma_channel_set_read_addr((uint)dma_t, t, false);
+    dma_channel_set_trans_count((uint)dma_t, MONITOR_SAMPLES_PER_TICK, false);
+    dma_start_channel_mask(mask);
+    block_next ^= 1u;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file monitor_out.h
+ * @brief PWM Analog Monitor Outputs (Speed, Current, Torque)
+ *
+ * Three PWM outputs, meant for an RC low-pass filter, give wheel 0's
+ * speed, motor current and output torque as voltages for a scope. Each is
+ * bipolar around mid-scale: 0 V is -full scale, VDD is +full scale
+ * (MONITOR_*_FS in board_pico.h), and values beyond that clip.
+ *
+ * With MONITOR_UPSAMPLE, Core1 writes a block of MONITOR_SAMPLES_PER_TICK
+ * samples once per tick, ramping linearly from the previous tick's value
+ * to this one. Two DMA channels paced by a DMA timer feed the PWM compare
+ * registers from it, so the filtered output is a smooth line rather than a
+ * staircase, one tick behind, with no per-sample CPU work. Without it (or
+ * when no DMA channel or timer is free) the level is set once per tick.
+ *
+ * Core1 only.
+ */
+
+#ifndef MONITOR_OUT_H
+#define MONITOR_OUT_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Set up the PWM slices and the DMA feed (call once on Core1)
+ */
+void monitor_out_init(void);
+
+/**
+ * @brief Output this tick's values (once per physics tick)
+ *
+ * @param speed_rpm Wheel speed (RPM)
+ * @param current_a Motor current (A)
+ * @param torque_mnm Output torque (mN·m)
+ */
+void monitor_out_update(float speed_rpm, float current_a, float torque_mnm);
+
+#endif // MONITOR_OUT_H
@@ -5,6 +5,8 @@
 
 #include "nsp.h"
 #include "crc_ccitt.h"
+#include "slip.h"
+#include "hot_path.h"
 #include <string.h>
 
 // ============================================================================
@@ -25,9 +27,9 @@ void nsp_init(uint8_t device_address) {
 // Packet Parsing
 // ============================================================================
 
-nsp_result_t nsp_parse(const uint8_t *raw_data, size_t raw_len, nsp_packet_t *packet) {
+nsp_result_t HOT_PATH_FUNC(nsp_parse_view)(const uint8_t *raw_data, size_t raw_len, nsp_view_t *view) {
     // Validate inputs
-    if (raw_data == NULL || packet == NULL) {
+    if (raw_data == NULL || view == NULL) {
         return NSP_ERR_NULL_PTR;
     }
 
@@ -37,9 +39,9 @@ nsp_result_t nsp_parse(const uint8_t *raw_data, size_t raw_len, nsp_packet_t *pa
     }
 
     // Parse header fields
-    packet->dest = raw_data[0];
-    packet->src  = raw_data[1];
-    packet->ctrl = raw_data[2];
+    view->dest = raw_data[0];
+    view->src  = raw_data[1];
+    view->ctrl = raw_data[2];
 
     // Calculate data length from packet size
     // Packet layout: [Dest | Src | Ctrl | Data... | CRC_L | CRC_H]
@@ -51,22 +53,19 @@ nsp_result_t nsp_parse(const uint8_t *raw_data, size_t raw_len, nsp_packet_t *pa
         return NSP_ERR_BAD_LENGTH;
     }
 
-    packet->len = (uint8_t)data_len;
-
-    // Extract data payload (if any)
-    if (packet->len > 0) {
-        memcpy(packet->data, &raw_data[3], packet->len);
-    }
+    // Payload stays in place
+    view->data = &raw_data[3];
+    view->len = data_len;
 
     // Extract received CRC (LSB-first: CRC_L at [3+len], CRC_H at [3+len+1])
-    size_t crc_offset = 3 + packet->len;
+    size_t crc_offset = 3 + data_len;
     uint16_t received_crc = (uint16_t)raw_data[crc_offset] |
                            ((uint16_t)raw_data[crc_offset + 1] << 8);
-    packet->crc = received_crc;
+    view->crc = received_crc;
 
     // Compute CRC over: Dest + Src + Ctrl + Data
     // (Length field is NOT part of NSP protocol per ICD Table 11-1)
-    uint16_t computed_crc = crc_ccitt_calculate(raw_data, 3 + packet->len);
+    uint16_t computed_crc = crc_ccitt_calculate(raw_data, 3 + data_len);
 
     // Verify CRC
     if (computed_crc != received_crc) {
@@ -76,14 +75,137 @@ nsp_result_t nsp_parse(const uint8_t *raw_data, size_t raw_len, nsp_packet_t *pa
     return NSP_OK;
 }
 
+nsp_result_t HOT_PATH_FUNC(nsp_parse)(const uint8_t *raw_data, size_t raw_len, nsp_packet_t *packet) {
+    if (packet == NULL) {
+        return NSP_ERR_NULL_PTR;
+    }
+
+    nsp_view_t view;
+    nsp_result_t result = nsp_parse_view(raw_data, raw_len, &view);
+    if (result == NSP_ERR_NULL_PTR || result == NSP_ERR_TOO_SHORT ||
+        result == NSP_ERR_BAD_LENGTH) {
+        return result;
+    }
+
+    // Owning copy (header, payload and received CRC)
+    packet->dest = view.dest;
+    packet->src  = view.src;
+    packet->ctrl = view.ctrl;
+    packet->len  = (uint8_t)view.len;
+    if (packet->len > 0) {
+        memcpy(packet->data, view.data, packet->len);
+    }
+    packet->crc = view.crc;
+
+    return result;
+}
+
+// ============================================================================
+// Streaming Receiver
+// ============================================================================
+
+bool nsp_rx_init(nsp_rx_t *rx, uint8_t device_address) {
+    bool valid = device_address <= NSP_ADDR_MAX;
+
+    slip_decoder_init(&rx->slip);
+    rx->len = 0;
+    rx->crc = CRC_CCITT_INIT;
+    rx->accept_mask = valid ? (uint8_t)(1u << device_address) : 0;
+    rx->skip = false;
+    rx->keep_all = false;
+    rx->overflow = false;
+    rx->dest = 0;
+    rx->src = 0;
+    rx->ctrl = 0;
+    rx->error = NSP_OK;
+    return valid;
+}
+
+void nsp_rx_set_accept_mask(nsp_rx_t *rx, uint8_t accept_mask) {
+    rx->accept_mask = accept_mask;
+}
+
+void nsp_rx_set_keep_all(nsp_rx_t *rx, bool keep_all) {
+    rx->keep_all = keep_all;
+}
+
+/**
+ * @brief Check destination against the accept mask
+ */
+static inline bool HOT_PATH_FUNC(nsp_rx_accepts)(const nsp_rx_t *rx, uint8_t dest) {
+    if (dest == NSP_ADDR_BROADCAST) {
+        return true;
+    }
+    return (dest < 8) && (rx->accept_mask & (1u << dest));
+}
+
+/**
+ * @brief Start bookkeeping for a new frame
+ */
+static inline void HOT_PATH_FUNC(nsp_rx_begin)(nsp_rx_t *rx) {
+    rx->len = 0;
+    rx->crc = CRC_CCITT_INIT;
+    rx->skip = false;
+    rx->overflow = false;
+}
+
+nsp_rx_event_t HOT_PATH_FUNC(nsp_rx_byte)(nsp_rx_t *rx, uint8_t byte) {
+    uint8_t data;
+
+    switch (slip_decode_step(&rx->slip, byte, &data)) {
+        case SLIP_EVENT_DATA:
+            if (rx->slip.frame_len == 1) {
+                // Byte 0: destination - decide right away whether to keep it
+                nsp_rx_begin(rx);
+                rx->dest = data;
+                rx->skip = !nsp_rx_accepts(rx, data);
+            }
+            if ((rx->skip && !rx->keep_all) || rx->overflow) {
+                return NSP_RX_NONE;  // Not ours / already too long: drop
+            }
+            if (rx->len >= NSP_MAX_PACKET_SIZE) {
+                rx->overflow = true;
+                return NSP_RX_NONE;
+            }
+            if (rx->len == 1) rx->src = data;
+            if (rx->len == 2) rx->ctrl = data;
+            rx->buf[rx->len++] = data;
+            rx->crc = crc_ccitt_update_byte(rx->crc, data);
+            return NSP_RX_NONE;
+
+        case SLIP_EVENT_FRAME_END:
+            if (rx->skip) {
+                return NSP_RX_FILTERED;
+            }
+            rx->error = nsp_rx_check(rx);
+            return (rx->error == NSP_OK) ? NSP_RX_FRAME : NSP_RX_BAD_FRAME;
+
+        case SLIP_EVENT_ERROR:
+            nsp_rx_begin(rx);
+            return NSP_RX_SLIP_ERROR;
+
+        default:
+            return NSP_RX_NONE;
+    }
+}
+
+void HOT_PATH_FUNC(nsp_rx_view)(const nsp_rx_t *rx, nsp_view_t *view) {
+    view->dest = rx->dest;
+    view->src  = rx->src;
+    view->ctrl = rx->ctrl;
+    view->data = nsp_rx_payload(rx);
+    view->len  = nsp_rx_payload_len(rx);
+    view->crc  = (uint16_t)(rx->buf[rx->len - 2] | ((uint16_t)rx->buf[rx->len - 1] << 8));
+}
+
 // ============================================================================
 // Packet Building
 // ============================================================================
 
-bool nsp_build_reply(const nsp_packet_t *request,
-                     bool ack,
-                     const uint8_t *data, size_t data_len,
-                     uint8_t *output, size_t *output_len) {
+bool HOT_PATH_FUNC(nsp_build_reply)(const nsp_packet_t *request,
+                                    bool ack,
+                                    const uint8_t *data, size_t data_len,
+                                    uint8_t *output, size_t *output_len) {
     // Validate inputs
     if (request == NULL || output == NULL || output_len == NULL) {
         return false;
@@ -133,7 +255,55 @@ bool nsp_build_reply(const nsp_packet_t *request,
     return true;
 }
 
-bool nsp_build_ack(const nsp_packet_t *request, uint8_t *output, size_t *output_len) {
+bool HOT_PATH_FUNC(nsp_build_ack)(const nsp_packet_t *request, uint8_t *output, size_t *output_len) {
     // ACK is a reply with no data payload, A bit set to 1
     return nsp_build_reply(request, true, NULL, 0, output, output_len);
 }
+
+bool HOT_PATH_FUNC(nsp_encode_reply_slip)(const nsp_view_t *request,
+                                          bool ack,
+                                          const uint8_t *data, size_t data_len,
+                                          uint8_t *output, size_t capacity, size_t *output_len) {
+    // Validate inputs
+    if (request == NULL || output == NULL || output_len == NULL) {
+        return false;
+    }
+
+    // Validate data length
+    if (data_len > NSP_MAX_DATA_SIZE) {
+        return false;
+    }
+
+    // If data_len > 0, data pointer must be valid
+    if (data_len > 0 && data == NULL) {
+        return false;
+    }
+
+    // Header: same rules as nsp_build_reply()
+    uint8_t header[3];
+    header[0] = request->src;
+    header[1] = (request->dest < 8) ? request->dest : g_device_address;
+    header[2] = (request->ctrl & NSP_CTRL_B_BIT) |
+                (ack ? NSP_CTRL_A_BIT : 0) |
+                nsp_get_command(request->ctrl);  // Poll=0 for replies
+
+    slip_writer_t w;
+    slip_writer_begin(&w, output, capacity);
+
+    // CRC and SLIP escaping advance together, byte by byte
+    uint16_t crc = CRC_CCITT_INIT;
+    for (size_t i = 0; i < sizeof(header); i++) {
+        crc = crc_ccitt_update_byte(crc, header[i]);
+        slip_writer_put(&w, header[i]);
+    }
+    for (size_t i = 0; i < data_len; i++) {
+        crc = crc_ccitt_update_byte(crc, data[i]);
+        slip_writer_put(&w, data[i]);
+    }
+
+    // Append CRC (LSB-first)
+    slip_writer_put(&w, (uint8_t)(crc & 0xFF));         // CRC_L
+    slip_writer_put(&w, (uint8_t)((crc >> 8) & 0xFF));  // CRC_H
+
+    return slip_writer_end(&w, output_len);
+}
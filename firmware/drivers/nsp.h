@@ -24,6 +24,8 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include "slip.h"
+#include "crc_ccitt.h"
 
 // ============================================================================
 // NSP Protocol Constants
@@ -38,6 +40,9 @@
 /** @brief Maximum NSP packet size (including CRC) */
 #define NSP_MAX_PACKET_SIZE (3 + NSP_MAX_DATA_SIZE + 2)  // Header (Dest+Src+Ctrl) + Data + CRC
 
+/** Worst-case SLIP-framed reply size for data_len payload bytes (every byte escaped + 2 END) */
+#define NSP_SLIP_REPLY_MAX(data_len) ((3 + (data_len) + 2) * 2 + 2)
+
 // ============================================================================
 // NSP Command Codes
 // ============================================================================
@@ -50,6 +55,8 @@
 #define NSP_CMD_CLEAR_FAULT             0x09  /**< Clear latched faults */
 #define NSP_CMD_CONFIGURE_PROTECTION    0x0A  /**< Configure protection thresholds */
 #define NSP_CMD_TRIP_LCL                0x0B  /**< Trip local current limit */
+#define NSP_CMD_SIM_STEP                0x0C  /**< Emulator extension: lockstep tick control */
+#define NSP_CMD_MULTI_TELEMETRY         0x0D  /**< Emulator extension: several telemetry blocks */
 
 // ============================================================================
 // Control Byte Bit Masks
@@ -76,6 +83,21 @@ typedef struct {
     uint16_t crc;         /**< CRC-16 CCITT (computed or received) */
 } nsp_packet_t;
 
+/**
+ * @brief NSP packet view (zero-copy parsed representation)
+ *
+ * Header fields are copied out; the payload points into the buffer the
+ * packet was parsed from and is only valid while that buffer is.
+ */
+typedef struct {
+    uint8_t dest;         /**< Destination address */
+    uint8_t src;          /**< Source address */
+    uint8_t ctrl;         /**< Control byte [Poll|B|A|Cmd] */
+    const uint8_t *data;  /**< Payload (points into source buffer) */
+    size_t len;           /**< Payload length (0-255) */
+    uint16_t crc;         /**< CRC-16 CCITT as received */
+} nsp_view_t;
+
 /**
  * @brief NSP parse result codes
  */
@@ -87,6 +109,140 @@ typedef enum {
     NSP_ERR_NULL_PTR      /**< NULL pointer argument */
 } nsp_result_t;
 
+/**
+ * @brief Broadcast destination address (accepted by every node)
+ */
+#define NSP_ADDR_BROADCAST 0xFF
+
+/**
+ * @brief Highest unicast address (addresses are 0-7)
+ */
+#define NSP_ADDR_MAX 0x07
+
+// ============================================================================
+// Streaming Receiver (fused SLIP decode + CRC + header capture)
+// ============================================================================
+
+/**
+ * @brief Events returned by nsp_rx_byte()
+ */
+typedef enum {
+    NSP_RX_NONE = 0,      /**< Byte consumed, frame still in progress */
+    NSP_RX_FRAME,         /**< Valid frame for this node (CRC checked) */
+    NSP_RX_FILTERED,      /**< Frame for another node ended (bytes skipped) */
+    NSP_RX_SLIP_ERROR,    /**< Invalid SLIP escape, frame discarded */
+    NSP_RX_BAD_FRAME      /**< Frame rejected, reason in rx->error */
+} nsp_rx_event_t;
+
+/**
+ * @brief Streaming NSP receiver
+ *
+ * Walks each received byte exactly once: SLIP unescape, CRC accumulate and
+ * header capture happen in the same step. The destination is checked as
+ * soon as byte 0 is decoded; frames for other nodes are skipped without
+ * storing or CRC work, unless keep_all is set for the bus monitor, which
+ * then finds them complete in buf when NSP_RX_FILTERED is returned.
+ * Because the CRC runs over the trailing CRC bytes as well, validation
+ * reduces to a residue check when END arrives.
+ */
+typedef struct {
+    slip_decoder_t slip;                /**< SLIP byte-level state */
+    uint8_t buf[NSP_MAX_PACKET_SIZE];   /**< Decoded frame [Dest|Src|Ctrl|Data|CRC] */
+    size_t len;                         /**< Decoded bytes in buf */
+    uint16_t crc;                       /**< Running CRC over decoded bytes */
+    uint8_t accept_mask;                /**< Bit n set = accept dest address n */
+    bool skip;                          /**< Current frame is for another node */
+    bool keep_all;                      /**< Store and CRC skipped frames too */
+    bool overflow;                      /**< Current frame exceeds NSP_MAX_PACKET_SIZE */
+    uint8_t dest;                       /**< Header of last frame (valid after byte 0..2) */
+    uint8_t src;
+    uint8_t ctrl;
+    nsp_result_t error;                 /**< Reason for last NSP_RX_BAD_FRAME */
+} nsp_rx_t;
+
+/**
+ * @brief Initialize streaming receiver
+ *
+ * @param rx Pointer to receiver
+ * @param device_address Address this node answers to (0-7); broadcast is
+ *                       always accepted
+ * @return false if the address is above NSP_ADDR_MAX (the receiver then
+ *         accepts broadcasts only)
+ */
+bool nsp_rx_init(nsp_rx_t *rx, uint8_t device_address);
+
+/**
+ * @brief Replace the set of accepted destination addresses
+ *
+ * @param rx Pointer to receiver
+ * @param accept_mask Bit n set = accept dest n (0-7); broadcast always accepted
+ */
+void nsp_rx_set_accept_mask(nsp_rx_t *rx, uint8_t accept_mask);
+
+/**
+ * @brief Also decode frames for other nodes (bus monitor)
+ *
+ * @param rx Pointer to receiver
+ * @param keep_all true to store and CRC every frame; filtered frames are
+ *                 still reported as NSP_RX_FILTERED
+ */
+void nsp_rx_set_keep_all(nsp_rx_t *rx, bool keep_all);
+
+/**
+ * @brief Validate the frame that just ended (length and CRC residue)
+ *
+ * @param rx Pointer to receiver, after NSP_RX_FRAME, NSP_RX_BAD_FRAME or
+ *           (with keep_all) NSP_RX_FILTERED
+ * @return NSP_OK, NSP_ERR_BAD_LENGTH, NSP_ERR_TOO_SHORT or NSP_ERR_BAD_CRC
+ */
+static inline nsp_result_t nsp_rx_check(const nsp_rx_t *rx) {
+    if (rx->overflow) {
+        return NSP_ERR_BAD_LENGTH;
+    }
+    if (rx->len < NSP_MIN_PACKET_SIZE) {
+        return NSP_ERR_TOO_SHORT;
+    }
+    if (rx->crc != CRC_CCITT_RESIDUE) {
+        return NSP_ERR_BAD_CRC;
+    }
+    return NSP_OK;
+}
+
+/**
+ * @brief Feed one raw (SLIP-encoded) byte
+ *
+ * On NSP_RX_FRAME, the full decoded frame is in rx->buf (rx->len bytes) and
+ * header fields are in rx->dest/src/ctrl. It stays valid until the next
+ * byte is fed.
+ *
+ * @param rx Pointer to receiver
+ * @param byte Raw byte from the wire
+ * @return Event produced by this byte
+ */
+nsp_rx_event_t nsp_rx_byte(nsp_rx_t *rx, uint8_t byte);
+
+/**
+ * @brief Fill a packet view from the last NSP_RX_FRAME
+ *
+ * @param rx Pointer to receiver
+ * @param view Pointer to view to fill (payload points into rx->buf)
+ */
+void nsp_rx_view(const nsp_rx_t *rx, nsp_view_t *view);
+
+/**
+ * @brief Payload of the last NSP_RX_FRAME (points into rx->buf)
+ */
+static inline const uint8_t *nsp_rx_payload(const nsp_rx_t *rx) {
+    return &rx->buf[3];
+}
+
+/**
+ * @brief Payload length of the last NSP_RX_FRAME
+ */
+static inline size_t nsp_rx_payload_len(const nsp_rx_t *rx) {
+    return rx->len - NSP_MIN_PACKET_SIZE;
+}
+
 // ============================================================================
 // NSP API Functions
 // ============================================================================
@@ -108,6 +264,18 @@ void nsp_init(uint8_t device_address);
  */
 nsp_result_t nsp_parse(const uint8_t *raw_data, size_t raw_len, nsp_packet_t *packet);
 
+/**
+ * @brief Parse NSP packet into a zero-copy view
+ *
+ * Same validation as nsp_parse(), but the payload is not copied.
+ *
+ * @param raw_data Pointer to raw packet data (after SLIP decode)
+ * @param raw_len Length of raw packet data
+ * @param view Pointer to view to fill (payload points into raw_data)
+ * @return nsp_result_t Parse result
+ */
+nsp_result_t nsp_parse_view(const uint8_t *raw_data, size_t raw_len, nsp_view_t *view);
+
 /**
  * @brief Build NSP reply packet
  *
@@ -139,6 +307,32 @@ bool nsp_build_reply(const nsp_packet_t *request,
  */
 bool nsp_build_ack(const nsp_packet_t *request, uint8_t *output, size_t *output_len);
 
+/**
+ * @brief Build NSP reply directly as a SLIP frame
+ *
+ * Same packet as nsp_build_reply(), but header, payload and CRC are escaped
+ * into the output as they are produced: no unescaped staging buffer, one
+ * pass over the reply data. Intended to write straight into the RS-485 TX
+ * buffer (see rs485_tx_acquire()).
+ *
+ * The reply source is the address the request was sent to, so each wheel of
+ * a multi-wheel emulator answers as itself; broadcast requests answer from
+ * the nsp_init() address.
+ *
+ * @param request Pointer to request view (dest, src and ctrl are used)
+ * @param ack true for ACK (A=1), false for NACK (A=0)
+ * @param data Pointer to reply data (can be NULL if data_len = 0)
+ * @param data_len Length of reply data
+ * @param output Pointer to output buffer
+ * @param capacity Output buffer size (worst case (data_len + 5) * 2 + 2)
+ * @param output_len Pointer to variable receiving encoded length
+ * @return true on success, false on bad arguments or if output is too small
+ */
+bool nsp_encode_reply_slip(const nsp_view_t *request,
+                           bool ack,
+                           const uint8_t *data, size_t data_len,
+                           uint8_t *output, size_t capacity, size_t *output_len);
+
 /**
  * @brief Get command code from control byte
  *
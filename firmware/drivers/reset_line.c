@@ -0,0 +1,144 @@
+/**
+ * @file reset_line.c
+ * @brief Hardware RESET Line Input Implementation
+ */
+
+#include "reset_line.h"
+#include "board_pico.h"
+#include "hot_path.h"
+#include "nsp_handler.h"
+#include "nss_nrwa_t6_engine.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
+#include <stdio.h>
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+// Core1 (edge ISR and tick loop)
+static volatile uint32_t CORE1_DATA("reset") line_requests = 0;     // Resets requested
+static volatile uint32_t CORE1_DATA("reset") line_assert_us = 0;    // Last falling edge
+static volatile uint32_t CORE1_DATA("reset") line_release_us = 0;   // Last rising edge
+static volatile uint32_t CORE1_DATA("reset") line_ready_us = 0;     // Release plus boot time
+static volatile bool CORE1_DATA("reset") line_ready_pending = false;
+static uint32_t CORE1_DATA("reset") line_applied = 0;               // Resets seen applied
+
+// Written by Core0
+static volatile uint32_t line_boot_us = RESET_BOOT_US;
+
+// Written by Core1, read by Core0
+static volatile reset_line_stats_t line_stats;
+
+// ============================================================================
+// Edge Handling
+// ============================================================================
+
+/**
+ * @brief RESET asserted: reset at the next tick, receiver held
+ */
+static void HOT_PATH_FUNC(line_assert)(uint32_t now_us) {
+    line_assert_us = now_us;
+    line_ready_pending = false;
+    line_stats.held = true;
+    line_stats.resets++;
+    line_requests++;
+    physics_engine_request_hw_reset();
+    nsp_handler_enter_reset();
+}
+
+/**
+ * @brief RESET released: answer again after the boot time
+ */
+static void HOT_PATH_FUNC(line_release)(uint32_t now_us) {
+    line_release_us = now_us;
+    line_ready_us = now_us + line_boot_us;
+    line_ready_pending = true;
+    line_stats.held = false;
+    nsp_handler_leave_reset(line_ready_us);
+}
+
+/**
+ * @brief RESET_PIN edge (Core1 GPIO bank IRQ)
+ *
+ * Both edges of a pulse shorter than the interrupt latency arrive
+ * together: the level read after the acknowledge sorts them out.
+ */
+static void HOT_PATH_FUNC(reset_line_isr)(void) {
+    uint32_t events = gpio_get_irq_event_mask(RESET_PIN) & (GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE);
+    if (events == 0) {
+        return;
+    }
+    uint32_t now_us = time_us_32();  // First thing after the check: the edge time
+    gpio_acknowledge_irq(RESET_PIN, events);
+
+    if ((events & GPIO_IRQ_EDGE_FALL) && !line_stats.held) {
+        line_assert(now_us);
+    }
+    if (line_stats.held && gpio_get(RESET_PIN)) {
+        line_release(time_us_32());
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void reset_line_init(void) {
+    gpio_add_raw_irq_handler(RESET_PIN, reset_line_isr);
+    gpio_set_irq_enabled(RESET_PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+
+    // Held low since power-up: in reset until the release
+    if (!gpio_get(RESET_PIN)) {
+        uint32_t save = save_and_disable_interrupts();
+        if (!line_stats.held) {
+            line_assert(time_us_32());
+        }
+        restore_interrupts(save);
+    }
+    printf("[RESET] RESET line on GPIO %u (boot time %lu us)\n",
+           (unsigned)RESET_PIN, (unsigned long)line_boot_us);
+}
+
+void HOT_PATH_FUNC(reset_line_update)(void) {
+    uint32_t applied_us;
+    uint32_t applied = physics_engine_get_hw_resets(&applied_us);
+    if (applied != line_applied) {
+        line_applied = applied;
+        uint32_t apply_us = applied_us - line_assert_us;
+        line_stats.last_apply_us = apply_us;
+        if (apply_us > line_stats.max_apply_us) {
+            line_stats.max_apply_us = apply_us;
+        }
+    }
+
+    // Ready once both the reset is applied and the boot time is over (the
+    // boot time covers a tick, so normally the latter)
+    if (line_ready_pending && applied == line_requests) {
+        uint32_t ready_us = ((int32_t)(applied_us - line_ready_us) > 0) ? applied_us : line_ready_us;
+        line_stats.last_ready_us = ready_us - line_release_us;
+        line_ready_pending = false;
+    }
+}
+
+bool reset_line_set_boot_us(uint32_t boot_us) {
+    if (boot_us < PHYSICS_TICK_PERIOD_US || boot_us > RESET_BOOT_MAX_US) {
+        return false;
+    }
+    line_boot_us = boot_us;
+    return true;
+}
+
+void reset_line_get_stats(reset_line_stats_t* stats) {
+    if (!stats) {
+        return;
+    }
+    stats->held = line_stats.held;
+    stats->resets = line_stats.resets;
+    stats->last_apply_us = line_stats.last_apply_us;
+    stats->max_apply_us = line_stats.max_apply_us;
+    stats->last_ready_us = line_stats.last_ready_us;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file reset_line.h
+ * @brief Hardware RESET Line Input
+ *
+ * A falling edge on RESET_PIN (active low) is a hardware reset from the
+ * OBC. The edge interrupt runs on Core1 and stamps the edge; the reset is
+ * applied at the next tick boundary (physics_engine_request_hw_reset():
+ * every wheel re-initialized with default protection, faults and the LCL
+ * trip cleared) and the NSP receiver is held in reset, bytes dropped.
+ * After the release the unit "boots" for the configured time before it
+ * answers again, so reset-to-ready is deterministic: release plus boot
+ * time, never less than the tick it takes to apply the reset.
+ *
+ * A pin held low at power-up counts as a reset in progress.
+ *
+ * Core1 owns the pin interrupt; Core0 only sets the boot time and reads
+ * the statistics.
+ */
+
+#ifndef RESET_LINE_H
+#define RESET_LINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief RESET line statistics
+ */
+typedef struct {
+    bool held;                  // RESET_PIN low now
+    uint32_t resets;            // Assertions since boot
+    uint32_t last_apply_us;     // Falling edge to wheels reset (tick boundary), last
+    uint32_t max_apply_us;      // Worst of the above since boot
+    uint32_t last_ready_us;     // Rising edge to requests answered again, last
+} reset_line_stats_t;
+
+/**
+ * @brief Install the edge interrupt (call once on Core1, after timebase_init())
+ */
+void reset_line_init(void);
+
+/**
+ * @brief Record the reset applied by the last tick (Core1, after each tick)
+ */
+void reset_line_update(void);
+
+/**
+ * @brief Set the emulated boot time (Core0; applies to the next release)
+ *
+ * @param boot_us Release to ready (PHYSICS_TICK_PERIOD_US to RESET_BOOT_MAX_US)
+ * @return false if out of range (unchanged)
+ */
+bool reset_line_set_boot_us(uint32_t boot_us);
+
+/**
+ * @brief Get the RESET line statistics
+ *
+ * @param stats Output statistics
+ */
+void reset_line_get_stats(reset_line_stats_t* stats);
+
+#endif // RESET_LINE_H
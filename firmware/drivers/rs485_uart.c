@@ -6,27 +6,602 @@
 #include "rs485_uart.h"
 #include "hardware/uart.h"
 #include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/dma.h"
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+#include "hardware/timer.h"
+#include "hardware/sync.h"
 #include "pico/time.h"
 #include "../platform/gpio_map.h"
+#include "../platform/board_pico.h"
+#include "../platform/clock_profile.h"
+#include "../util/ringbuf.h"
+#include "rs485_pio.pio.h"
 #include <string.h>
 
+#if RS485_RE_PIN != RS485_DE_PIN + 1
+#error "PIO backend side-sets DE and /RE as consecutive pins"
+#endif
+
 // ============================================================================
-// Initialization
+// RX Ring (filled by UART1 RX interrupt or PIO RX DMA)
 // ============================================================================
 
-bool rs485_init(void) {
-    // Initialize UART1 at 460.8 kbps, 8-N-1
-    uint actual_baud = uart_init(RS485_UART, RS485_BAUD_RATE);
+/**
+ * Backing storage for the RX ring (power of 2, see board_pico.h). Aligned
+ * to its size so the PIO backend's RX DMA can wrap in hardware ring mode.
+ */
+static uint8_t rx_storage[RS485_RX_BUFFER_SIZE] __attribute__((aligned(RS485_RX_BUFFER_SIZE)));
 
-    // Verify baud rate is within acceptable range (±1%)
-    uint baud_error = (actual_baud > RS485_BAUD_RATE) ?
-                      (actual_baud - RS485_BAUD_RATE) :
-                      (RS485_BAUD_RATE - actual_baud);
-    uint baud_tolerance = RS485_BAUD_RATE / 100;  // 1%
+/**
+ * SPSC ring: producer = UART1 ISR (or the RX DMA, whose write pointer the
+ * consumer publishes as head), consumer = NSP handler on Core0
+ */
+static ringbuf8_t rx_ring;
 
-    if (baud_error > baud_tolerance) {
-        return false;  // Baud rate out of tolerance
+/** Bytes dropped because the ring was full */
+static volatile uint32_t rx_dropped_count = 0;
+
+/** Hardware FIFO overrun events (UARTDR.OE) */
+static volatile uint32_t rx_hw_overrun_count = 0;
+
+/** Peak ring occupancy (bytes) since init */
+static volatile uint32_t rx_peak_count = 0;
+
+/** Accumulated error flags (RS485_ERR_* bits) */
+static volatile uint8_t rx_error_flags = 0;
+
+/** Delimiter notification (frame-complete wakeup for the NSP service) */
+static volatile rs485_rx_callback_t rx_callback = NULL;
+static volatile uint8_t rx_delimiter = 0;
+
+/**
+ * Delimiter arrival stamps (bus monitor): SPSC, producer = RX ISR,
+ * consumer = rs485_rx_delimiter_time(). Each entry names the ring slot the
+ * delimiter was stored in, so stamps of bytes flushed or dropped unread are
+ * recognised and discarded.
+ */
+#define RS485_STAMP_DEPTH       32
+#define RS485_STAMP_BATCH_MAX   8
+
+typedef struct {
+    uint32_t index;                 // rx_ring slot of the delimiter
+    uint32_t us;                    // time_us_32() at the end of its stop bit
+} rs485_stamp_t;
+
+static rs485_stamp_t stamp_queue[RS485_STAMP_DEPTH];
+static volatile uint32_t stamp_head = 0;
+static volatile uint32_t stamp_tail = 0;
+static volatile bool stamp_enabled = false;
+
+/** One character (10 bits) at the actual baud rate, in ns */
+static uint32_t rx_char_ns = 0;
+
+// ============================================================================
+// TX Path (DMA into UART1 TX FIFO, alarm-timed DE release)
+// ============================================================================
+
+/**
+ * Hardware alarm used to release DE (alarm 0 = physics tick on Core1,
+ * alarm 3 = SDK default alarm pool)
+ */
+#define RS485_TX_ALARM_NUM 1
+
+/** Re-check interval if the shift register is still busy at the alarm */
+#define RS485_TX_RECHECK_US 2
+
+/** Hardware alarm that releases deferred transmissions (see rs485_send_at()) */
+#define RS485_DEFER_ALARM_NUM 2
+
+/** Reply staging buffer (DMA source, stays valid until the last stop bit) */
+static uint8_t tx_buffer[RS485_TX_BUFFER_SIZE];
+
+/** DMA channel feeding the TX FIFO (-1 = not yet claimed) */
+static int tx_dma_chan = -1;
+
+/** True from DE assert until DE release */
+static volatile bool tx_active = false;
+
+/** Actual programmed baud rate (used for wire-time prediction) */
+static uint32_t tx_actual_baud = RS485_BAUD_RATE;
+
+/** Error of the programmed baud rate against RS485_BAUD_RATE (ppm) */
+static int32_t baud_error_ppm = 0;
+
+/** TX-complete notification */
+static volatile rs485_tx_callback_t tx_done_callback = NULL;
+
+/** time_us_32() at which the last transmission's first start bit left */
+static volatile uint32_t tx_start_us = 0;
+
+/** DE assert to first start bit for the active backend */
+static uint32_t tx_setup_us = RS485_SWITCH_DELAY_US;
+
+// ============================================================================
+// Backend Selection
+// ============================================================================
+
+/** Backend and nominal rate applied by the last rs485_configure() */
+static rs485_backend_t backend = RS485_BACKEND_DEFAULT;
+static uint32_t requested_baud = RS485_BAUD_RATE;
+
+/** True once a backend has been brought up (so it can be torn down) */
+static bool bus_up = false;
+
+/**
+ * @brief Queue a delimiter stamp (RX ISR)
+ *
+ * A full queue drops the stamp; the consumer then finds none for that
+ * delimiter and falls back to its own time.
+ */
+static inline void __not_in_flash_func(rs485_stamp_push)(uint32_t index, uint32_t us) {
+    uint32_t head = stamp_head;
+    if (head - stamp_tail >= RS485_STAMP_DEPTH) {
+        return;
+    }
+    stamp_queue[head % RS485_STAMP_DEPTH].index = index;
+    stamp_queue[head % RS485_STAMP_DEPTH].us = us;
+    __dmb();
+    stamp_head = head + 1;
+}
+
+// ============================================================================
+// PIO Backend (PIO0 SM0 = TX with DE/RE side-set, SM1 = RX)
+// ============================================================================
+
+#define RS485_PIO               pio0
+#define RS485_PIO_TX_SM         0
+#define RS485_PIO_RX_SM         1
+
+/** State machine cycles per bit (both programs, see rs485_pio.pio) */
+#define RS485_PIO_CYCLES_PER_BIT 8
+
+/** IRQ flags raised by the programs */
+#define RS485_PIO_IRQ_TX_DONE   0
+#define RS485_PIO_IRQ_RX_DELIM  1
+#define RS485_PIO_IRQ_RX_FRAME  2
+
+/** RX DMA write-ring size in address bits (whole rx_storage) */
+#define RS485_RX_RING_BITS      ((uint)__builtin_ctz(RS485_RX_BUFFER_SIZE))
+
+/** Program offsets in PIO0 instruction memory (-1 = not yet loaded) */
+static int pio_tx_offset = -1;
+static int pio_rx_offset = -1;
+
+/**
+ * RX DMA: the data channel runs for 2^32 - 1 bytes, then chains to the
+ * control channel, which reloads its count and retriggers it in place.
+ */
+static int rx_dma_chan = -1;
+static int rx_ctrl_chan = -1;
+static const uint32_t rx_dma_reload_count = 0xFFFFFFFFu;
+
+// ============================================================================
+// Deferred TX Queue (frames released by hardware alarm at a set time)
+// ============================================================================
+
+/**
+ * @brief One pre-encoded frame waiting for its release time
+ */
+typedef struct {
+    uint8_t bytes[RS485_DEFER_FRAME_SIZE];
+    uint16_t len;
+    uint64_t release_us;        // First start bit goes out at this time
+} rs485_deferred_t;
+
+/** FIFO of deferred frames, head = next to send (DMA reads it in place) */
+static rs485_deferred_t defer_queue[RS485_DEFER_DEPTH];
+static volatile uint32_t defer_head = 0;
+static volatile uint32_t defer_tail = 0;
+
+/** Head frame is on the wire; its slot is freed when DE is released */
+static volatile bool defer_in_flight = false;
+
+static volatile uint32_t defer_queued_count = 0;
+static volatile uint32_t defer_sent_count = 0;
+static volatile uint32_t defer_rejected_count = 0;
+static volatile uint32_t defer_max_late_us = 0;
+
+static void rs485_defer_service(void);
+
+/**
+ * @brief Time for len bytes to leave the wire (10 bit times per byte, 8-N-1)
+ */
+static inline uint32_t rs485_wire_time_us(size_t len) {
+    return (uint32_t)(((uint64_t)len * 10u * 1000000u + tx_actual_baud - 1) / tx_actual_baud);
+}
+
+/**
+ * @brief True while DMA or the UART (FIFO + shift register) still holds data
+ *
+ * UARTFR.BUSY stays set until the stop bit of the last character has been
+ * sent, which is exactly when the transceiver may be turned around.
+ */
+static inline bool rs485_tx_hw_busy(void) {
+    return dma_channel_is_busy((uint)tx_dma_chan) ||
+           (uart_get_hw(RS485_UART)->fr & UART_UARTFR_BUSY_BITS);
+}
+
+/**
+ * @brief Release the bus: DE low / RE low, notify listener
+ */
+static void __not_in_flash_func(rs485_tx_finish)(void) {
+    if (backend == RS485_BACKEND_UART) {
+        gpio_rs485_rx_enable();     // The PIO TX machine has already done it
     }
+    tx_active = false;
+
+    if (defer_in_flight) {
+        // Deferred frames carry an injected delay: keep them out of the
+        // listener's reply timing and move on to the next one
+        defer_in_flight = false;
+        defer_head++;
+        defer_sent_count++;
+        rs485_defer_service();
+        return;
+    }
+
+    rs485_tx_callback_t cb = tx_done_callback;
+    if (cb != NULL) {
+        cb();
+    }
+
+    // A deferred frame may have come due while this one was on the wire
+    rs485_defer_service();
+}
+
+/**
+ * @brief Put a buffer on the wire (caller has claimed the bus: tx_active set)
+ *
+ * Asserts DE, starts the DMA and arms the DE-release alarm. The buffer
+ * must stay untouched until rs485_tx_finish().
+ */
+static void __not_in_flash_func(rs485_tx_start)(const uint8_t *buf, size_t len) {
+    if (backend == RS485_BACKEND_PIO) {
+        // The TX machine raises DE as it pulls the first byte, waits out the
+        // enable time and releases the bus with IRQ 0 after the last stop bit
+        tx_start_us = time_us_32() + tx_setup_us;
+        dma_channel_transfer_from_buffer_now((uint)tx_dma_chan, buf, (uint32_t)len);
+        return;
+    }
+
+    // Switch to transmit mode and give the transceiver its enable time
+    // (busy-wait: rs485_send is called from the NSP service IRQ)
+    gpio_rs485_tx_enable();
+    busy_wait_us_32(RS485_SWITCH_DELAY_US);
+
+    // Characters leave back-to-back from here, so the end of the last stop
+    // bit is start + len character times
+    uint64_t start_us = time_us_64();
+    tx_start_us = (uint32_t)start_us;
+    dma_channel_transfer_from_buffer_now((uint)tx_dma_chan, buf, (uint32_t)len);
+
+    absolute_time_t done = from_us_since_boot(start_us + rs485_wire_time_us(len));
+    if (hardware_alarm_set_target(RS485_TX_ALARM_NUM, done)) {
+        // Preempted past the target before the alarm was armed
+        while (rs485_tx_hw_busy()) {
+            tight_loop_contents();
+        }
+        rs485_tx_finish();
+    }
+}
+
+/**
+ * @brief Send the head deferred frame if it is due, else arm its alarm
+ *
+ * Runs from the defer alarm, from rs485_tx_finish() and from
+ * rs485_send_at() (with interrupts disabled).
+ */
+static void __not_in_flash_func(rs485_defer_service)(void) {
+    while (defer_head != defer_tail && !defer_in_flight && !tx_active) {
+        rs485_deferred_t *d = &defer_queue[defer_head % RS485_DEFER_DEPTH];
+
+        // Assert DE early by the transceiver enable time so the first start
+        // bit leaves at release_us
+        uint64_t now = time_us_64();
+        if (now + tx_setup_us < d->release_us) {
+            absolute_time_t at = from_us_since_boot(d->release_us - tx_setup_us);
+            if (!hardware_alarm_set_target(RS485_DEFER_ALARM_NUM, at)) {
+                return;  // Armed: the alarm calls back in
+            }
+            continue;  // Target passed while arming: due now
+        }
+
+        // First start bit leaves after the enable delay
+        uint64_t start = now + tx_setup_us;
+        if (start > d->release_us && (uint32_t)(start - d->release_us) > defer_max_late_us) {
+            defer_max_late_us = (uint32_t)(start - d->release_us);
+        }
+
+        defer_in_flight = true;
+        tx_active = true;
+        rs485_tx_start(d->bytes, d->len);
+        // If the start fell back to finishing inline, the next frame has
+        // already been serviced and the loop condition stops here
+    }
+}
+
+/**
+ * @brief Alarm callback at the release time of the head deferred frame
+ */
+static void __not_in_flash_func(rs485_defer_alarm_cb)(uint alarm_num) {
+    (void)alarm_num;
+    rs485_defer_service();
+}
+
+/**
+ * @brief Alarm callback at the predicted end of the last stop bit
+ */
+static void __not_in_flash_func(rs485_tx_alarm_cb)(uint alarm_num) {
+    if (rs485_tx_hw_busy()) {
+        // Baud rounding left a bit or two on the wire - look again shortly
+        if (!hardware_alarm_set_target(alarm_num, make_timeout_time_us(RS485_TX_RECHECK_US))) {
+            return;
+        }
+        // Target already missed: finish here
+        while (rs485_tx_hw_busy()) {
+            tight_loop_contents();
+        }
+    }
+    rs485_tx_finish();
+}
+
+/**
+ * @brief UART1 RX / RX-timeout interrupt handler
+ *
+ * Drains the hardware FIFO into rx_ring. The RX interrupt fires at the FIFO
+ * trigger level, and the receive-timeout interrupt fires after 32 bit
+ * periods of idle line, so the tail of every frame is delivered promptly.
+ * Runs from RAM so a concurrent flash operation cannot stall it.
+ */
+static void __not_in_flash_func(rs485_rx_isr)(void) {
+    uart_hw_t *hw = uart_get_hw(RS485_UART);
+    bool saw_delimiter = false;
+
+    // Bus monitor: note where each delimiter falls in this batch, then
+    // back-date it from the drain time by the characters behind it. A
+    // receive timeout means the last byte ended 32 bit periods ago.
+    bool stamping = stamp_enabled;
+    bool timed_out = (hw->mis & UART_UARTMIS_RTMIS_BITS) != 0;
+    uint32_t batch_pos[RS485_STAMP_BATCH_MAX];
+    uint32_t batch_index[RS485_STAMP_BATCH_MAX];
+    uint32_t batch_delims = 0;
+    uint32_t batch_len = 0;
+
+    while (uart_is_readable(RS485_UART)) {
+        // Read DR once: bits [7:0] data, bits [11:8] OE/BE/PE/FE
+        uint32_t dr = hw->dr;
+
+        if (dr & (UART_UARTDR_OE_BITS | UART_UARTDR_BE_BITS |
+                  UART_UARTDR_PE_BITS | UART_UARTDR_FE_BITS)) {
+            if (dr & UART_UARTDR_OE_BITS) {
+                rx_error_flags |= RS485_ERR_OVERRUN;
+                rx_hw_overrun_count++;
+            }
+            if (dr & UART_UARTDR_BE_BITS) rx_error_flags |= RS485_ERR_BREAK;
+            if (dr & UART_UARTDR_PE_BITS) rx_error_flags |= RS485_ERR_PARITY;
+            if (dr & UART_UARTDR_FE_BITS) rx_error_flags |= RS485_ERR_FRAMING;
+        }
+
+        uint32_t slot = rx_ring.head;
+        bool stored = ringbuf8_push(&rx_ring, (uint8_t)dr);
+        if (!stored) {
+            rx_dropped_count++;
+        }
+
+        if ((uint8_t)dr == rx_delimiter) {
+            saw_delimiter = true;
+            if (stamping && stored && batch_delims < RS485_STAMP_BATCH_MAX) {
+                batch_pos[batch_delims] = batch_len;
+                batch_index[batch_delims] = slot;
+                batch_delims++;
+            }
+        }
+        batch_len++;
+    }
+
+    if (batch_delims > 0) {
+        uint32_t now = time_us_32();
+        uint32_t t_ref_ns = timed_out ? (32u * rx_char_ns) / 10u : 0;
+        for (uint32_t i = 0; i < batch_delims; i++) {
+            uint32_t behind_ns = t_ref_ns + (batch_len - 1u - batch_pos[i]) * rx_char_ns;
+            rs485_stamp_push(batch_index[i], now - behind_ns / 1000u);
+        }
+    }
+
+    uint32_t count = ringbuf8_count(&rx_ring);
+    if (count > rx_peak_count) {
+        rx_peak_count = count;
+    }
+
+    rs485_rx_callback_t cb = rx_callback;
+    if (saw_delimiter && cb != NULL) {
+        cb();
+    }
+}
+
+/**
+ * @brief Bytes the RX DMA has written, as a ring index (PIO backend)
+ */
+static inline uint32_t rs485_pio_rx_head(void) {
+    uintptr_t wr = (uintptr_t)dma_hw->ch[rx_dma_chan].write_addr;
+    return (uint32_t)(wr - (uintptr_t)rx_storage) & (RS485_RX_BUFFER_SIZE - 1u);
+}
+
+/**
+ * @brief Count a stalled RX push as a hardware overrun (PIO backend)
+ *
+ * RXSTALL is set when the RX machine could not push because the DMA fell
+ * behind; the byte on the wire meanwhile was lost.
+ */
+static void rs485_pio_poll_stall(void) {
+    const uint32_t stall = 1u << (PIO_FDEBUG_RXSTALL_LSB + RS485_PIO_RX_SM);
+    if (RS485_PIO->fdebug & stall) {
+        RS485_PIO->fdebug = stall;  // Write 1 to clear
+        rx_hw_overrun_count++;
+        rx_error_flags |= RS485_ERR_OVERRUN;
+    }
+}
+
+/**
+ * @brief Publish the RX DMA progress to the ring (consumer side)
+ *
+ * With the PIO backend nothing pushes into rx_ring: the consumer copies
+ * the DMA write pointer to head before reading. A ring lapped by the DMA
+ * cannot be told from an empty one; at 4 KB that takes 44 ms of unread
+ * traffic even at 921.6 kbps, and the frame CRC catches the damage.
+ */
+static inline void rs485_rx_sync(void) {
+    if (backend != RS485_BACKEND_PIO || !bus_up) {
+        return;
+    }
+
+    rx_ring.head = rs485_pio_rx_head();
+    uint32_t count = ringbuf8_count(&rx_ring);
+    if (count > rx_peak_count) {
+        rx_peak_count = count;
+    }
+    rs485_pio_poll_stall();
+}
+
+/**
+ * @brief PIO0 IRQ 0 handler: TX done, RX delimiter, RX framing error
+ */
+static void __not_in_flash_func(rs485_pio_isr)(void) {
+    uint32_t flags = RS485_PIO->irq;
+
+    if (flags & (1u << RS485_PIO_IRQ_RX_FRAME)) {
+        pio_interrupt_clear(RS485_PIO, RS485_PIO_IRQ_RX_FRAME);
+        rx_error_flags |= RS485_ERR_FRAMING;
+    }
+
+    if (flags & (1u << RS485_PIO_IRQ_RX_DELIM)) {
+        pio_interrupt_clear(RS485_PIO, RS485_PIO_IRQ_RX_DELIM);
+
+        // The delimiter was pushed just before the flag: let the DMA land it
+        while (!pio_sm_is_rx_fifo_empty(RS485_PIO, RS485_PIO_RX_SM)) {
+            tight_loop_contents();
+        }
+
+        uint32_t head = rs485_pio_rx_head();
+        uint32_t count = (head - rx_ring.tail) & (RS485_RX_BUFFER_SIZE - 1u);
+        if (count > rx_peak_count) {
+            rx_peak_count = count;
+        }
+
+        if (stamp_enabled) {
+            // A byte or two may follow the delimiter by now: find its slot
+            uint32_t us = time_us_32();
+            for (uint32_t back = 1; back <= 4 && back <= count; back++) {
+                uint32_t slot = (head - back) & (RS485_RX_BUFFER_SIZE - 1u);
+                if (rx_storage[slot] == rx_delimiter) {
+                    rs485_stamp_push(slot, us);
+                    break;
+                }
+            }
+        }
+
+        rs485_rx_callback_t cb = rx_callback;
+        if (cb != NULL) {
+            cb();
+        }
+    }
+
+    if (flags & (1u << RS485_PIO_IRQ_TX_DONE)) {
+        pio_interrupt_clear(RS485_PIO, RS485_PIO_IRQ_TX_DONE);
+
+        // A starved FIFO would end the burst early; the machine raises the
+        // flag again after the bytes that follow, so only the end counts
+        if (tx_active && !dma_channel_is_busy((uint)tx_dma_chan) &&
+            pio_sm_is_tx_fifo_empty(RS485_PIO, RS485_PIO_TX_SM)) {
+            rs485_tx_finish();
+        }
+    }
+}
+
+/**
+ * @brief Load a 32-bit constant into a stopped machine's Y register
+ */
+static void rs485_pio_load_y(uint sm, uint32_t value) {
+    pio_sm_put(RS485_PIO, sm, value);
+    pio_sm_exec(RS485_PIO, sm, pio_encode_pull(false, false));
+    pio_sm_exec(RS485_PIO, sm, pio_encode_mov(pio_y, pio_osr));
+}
+
+/**
+ * @brief State machine clock divider for a baud rate (16.8 fixed point)
+ *
+ * @param baud Requested baud rate
+ * @param actual Baud rate the rounded divider produces
+ */
+static uint32_t rs485_pio_divider(uint32_t baud, uint32_t *actual) {
+    uint64_t sys_hz = clock_get_hz(clk_sys);
+    uint64_t bit_hz = (uint64_t)baud * RS485_PIO_CYCLES_PER_BIT;
+    uint64_t div = (sys_hz * 256u + bit_hz / 2u) / bit_hz;
+    if (div < 256u) {
+        div = 256u;                     // Divider 1.0: clk_sys / 8 is the ceiling
+    } else if (div > 0xFFFFFFu) {
+        div = 0xFFFFFFu;
+    }
+    *actual = (uint32_t)((sys_hz * 256u) / (div * RS485_PIO_CYCLES_PER_BIT));
+    return (uint32_t)div;
+}
+
+/**
+ * @brief RX data channel configuration (chained to the reload channel or not)
+ */
+static dma_channel_config rs485_pio_rx_dma_config(bool chained) {
+    dma_channel_config cfg = dma_channel_get_default_config((uint)rx_dma_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_ring(&cfg, true, RS485_RX_RING_BITS);
+    channel_config_set_dreq(&cfg, pio_get_dreq(RS485_PIO, RS485_PIO_RX_SM, false));
+    if (chained) {
+        channel_config_set_chain_to(&cfg, (uint)rx_ctrl_chan);
+    }
+    return cfg;
+}
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+/**
+ * @brief Quiesce the active backend (no transmission, no RX interrupts)
+ */
+static void rs485_stop(void) {
+    // Drop deferred frames so nothing new starts, then let the wire drain
+    uint32_t save = save_and_disable_interrupts();
+    hardware_alarm_cancel(RS485_DEFER_ALARM_NUM);
+    defer_tail = defer_head + (defer_in_flight ? 1u : 0u);
+    restore_interrupts(save);
+    rs485_flush_tx();
+
+    if (backend == RS485_BACKEND_UART) {
+        uart_set_irq_enables(RS485_UART, false, false);
+        irq_set_enabled(UART1_IRQ, false);
+        return;
+    }
+
+    irq_set_enabled(PIO0_IRQ_0, false);
+    pio_set_sm_mask_enabled(RS485_PIO, (1u << RS485_PIO_TX_SM) | (1u << RS485_PIO_RX_SM), false);
+
+    // Unchain first so the abort cannot retrigger the data channel
+    dma_channel_config cfg = rs485_pio_rx_dma_config(false);
+    dma_channel_set_config((uint)rx_dma_chan, &cfg, false);
+    dma_channel_abort((uint)rx_dma_chan);
+    dma_channel_abort((uint)tx_dma_chan);
+}
+
+/**
+ * @brief Bring up the PL011 backend
+ */
+static uint32_t rs485_uart_start(uint32_t baud) {
+    // The divisor is computed from clk_peri, which follows the clock
+    // profile's clk_sys
+    uint actual_baud = uart_init(RS485_UART, baud);
 
     // Set data format: 8 bits, no parity, 1 stop bit
     uart_set_format(RS485_UART, 8, 1, UART_PARITY_NONE);
@@ -37,50 +612,336 @@ bool rs485_init(void) {
     // Enable UART FIFOs
     uart_set_fifo_enabled(RS485_UART, true);
 
-    // Configure GPIO pins for UART function
+    // Configure GPIO pins for UART function (DE/RE back to SIO after PIO)
     gpio_set_function(RS485_TX_PIN, GPIO_FUNC_UART);
     gpio_set_function(RS485_RX_PIN, GPIO_FUNC_UART);
+    gpio_set_function(RS485_DE_PIN, GPIO_FUNC_SIO);
+    gpio_set_function(RS485_RE_PIN, GPIO_FUNC_SIO);
 
     // Set RS-485 transceiver to receive mode (default state)
     gpio_rs485_rx_enable();
 
+    // Route RX into the ring via interrupt (RX level + receive timeout)
+    irq_set_exclusive_handler(UART1_IRQ, rs485_rx_isr);
+    irq_set_enabled(UART1_IRQ, true);
+    uart_set_irq_enables(RS485_UART, true, false);
+
+    // TX: DMA paced by the UART TX DREQ, DE released by hardware alarm
+    dma_channel_config cfg = dma_channel_get_default_config((uint)tx_dma_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, uart_get_dreq(RS485_UART, true));
+    dma_channel_configure((uint)tx_dma_chan, &cfg, &uart_get_hw(RS485_UART)->dr,
+                          tx_buffer, 0, false);
+
+    tx_setup_us = RS485_SWITCH_DELAY_US;
+    return actual_baud;
+}
+
+/**
+ * @brief Bring up the PIO backend
+ */
+static uint32_t rs485_pio_start(uint32_t baud) {
+    uint32_t actual_baud;
+    uint32_t div = rs485_pio_divider(baud, &actual_baud);
+
+    if (pio_tx_offset < 0) {
+        pio_tx_offset = (int)pio_add_program(RS485_PIO, &rs485_tx_program);
+        pio_rx_offset = (int)pio_add_program(RS485_PIO, &rs485_rx_program);
+        pio_sm_claim(RS485_PIO, RS485_PIO_TX_SM);
+        pio_sm_claim(RS485_PIO, RS485_PIO_RX_SM);
+        rx_dma_chan = dma_claim_unused_channel(true);
+        rx_ctrl_chan = dma_claim_unused_channel(true);
+    }
+
+    // Hand the pins to PIO0: TX idles high, DE/RE low (receive)
+    const uint32_t tx_pins = (1u << RS485_TX_PIN) | (1u << RS485_DE_PIN) | (1u << RS485_RE_PIN);
+    pio_sm_set_pins_with_mask(RS485_PIO, RS485_PIO_TX_SM, 1u << RS485_TX_PIN, tx_pins);
+    pio_sm_set_pindirs_with_mask(RS485_PIO, RS485_PIO_TX_SM, tx_pins, tx_pins);
+    pio_sm_set_consecutive_pindirs(RS485_PIO, RS485_PIO_RX_SM, RS485_RX_PIN, 1, false);
+    pio_gpio_init(RS485_PIO, RS485_TX_PIN);
+    pio_gpio_init(RS485_PIO, RS485_RX_PIN);
+    pio_gpio_init(RS485_PIO, RS485_DE_PIN);
+    pio_gpio_init(RS485_PIO, RS485_RE_PIN);
+
+    // TX machine: data on OUT/SET, DE + /RE on side-set, status = FIFO empty
+    pio_sm_config tc = rs485_tx_program_get_default_config((uint)pio_tx_offset);
+    sm_config_set_out_pins(&tc, RS485_TX_PIN, 1);
+    sm_config_set_set_pins(&tc, RS485_TX_PIN, 1);
+    sm_config_set_sideset_pins(&tc, RS485_DE_PIN);
+    sm_config_set_out_shift(&tc, true, false, 32);
+    sm_config_set_mov_status(&tc, STATUS_TX_LESSTHAN, 1);
+    sm_config_set_clkdiv_int_frac(&tc, (uint16_t)(div >> 8), (uint8_t)div);
+    pio_sm_init(RS485_PIO, RS485_PIO_TX_SM, (uint)pio_tx_offset + rs485_tx_offset_idle, &tc);
+
+    // Enable time in whole bit periods (Y + 1 of them)
+    uint32_t setup_bits = (uint32_t)(((uint64_t)RS485_SWITCH_DELAY_US * actual_baud + 999999u) / 1000000u);
+    if (setup_bits == 0) {
+        setup_bits = 1;
+    }
+    rs485_pio_load_y(RS485_PIO_TX_SM, setup_bits - 1u);
+    tx_setup_us = (uint32_t)(((uint64_t)setup_bits * 1000000u + actual_baud - 1u) / actual_baud);
+
+    // RX machine: 8 right shifts put the byte in bits 31:24, Y = delimiter
+    pio_sm_config rc = rs485_rx_program_get_default_config((uint)pio_rx_offset);
+    sm_config_set_in_pins(&rc, RS485_RX_PIN);
+    sm_config_set_jmp_pin(&rc, RS485_RX_PIN);
+    sm_config_set_in_shift(&rc, true, false, 32);
+    sm_config_set_clkdiv_int_frac(&rc, (uint16_t)(div >> 8), (uint8_t)div);
+    pio_sm_init(RS485_PIO, RS485_PIO_RX_SM, (uint)pio_rx_offset, &rc);
+    rs485_pio_load_y(RS485_PIO_RX_SM, (uint32_t)rx_delimiter << 24);
+
+    // RX DMA: FIFO byte lane 3 into the ring, endless via the reload channel
+    dma_channel_config dc = rs485_pio_rx_dma_config(true);
+    dma_channel_configure((uint)rx_dma_chan, &dc, rx_storage,
+                          (io_rw_8 *)&RS485_PIO->rxf[RS485_PIO_RX_SM] + 3,
+                          rx_dma_reload_count, true);
+
+    dma_channel_config cc = dma_channel_get_default_config((uint)rx_ctrl_chan);
+    channel_config_set_transfer_data_size(&cc, DMA_SIZE_32);
+    channel_config_set_read_increment(&cc, false);
+    channel_config_set_write_increment(&cc, false);
+    dma_channel_configure((uint)rx_ctrl_chan, &cc,
+                          &dma_hw->ch[rx_dma_chan].al1_transfer_count_trig,
+                          &rx_dma_reload_count, 1, false);
+
+    // TX DMA paced by the TX machine's FIFO (byte writes replicate to bit 0)
+    dma_channel_config cfg = dma_channel_get_default_config((uint)tx_dma_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, pio_get_dreq(RS485_PIO, RS485_PIO_TX_SM, true));
+    dma_channel_configure((uint)tx_dma_chan, &cfg, &RS485_PIO->txf[RS485_PIO_TX_SM],
+                          tx_buffer, 0, false);
+
+    pio_interrupt_clear(RS485_PIO, RS485_PIO_IRQ_TX_DONE);
+    pio_interrupt_clear(RS485_PIO, RS485_PIO_IRQ_RX_DELIM);
+    pio_interrupt_clear(RS485_PIO, RS485_PIO_IRQ_RX_FRAME);
+    RS485_PIO->fdebug = 1u << (PIO_FDEBUG_RXSTALL_LSB + RS485_PIO_RX_SM);
+    pio_set_irq0_source_mask_enabled(RS485_PIO,
+                                     (1u << (pis_interrupt0 + RS485_PIO_IRQ_TX_DONE)) |
+                                     (1u << (pis_interrupt0 + RS485_PIO_IRQ_RX_DELIM)) |
+                                     (1u << (pis_interrupt0 + RS485_PIO_IRQ_RX_FRAME)),
+                                     true);
+    irq_set_exclusive_handler(PIO0_IRQ_0, rs485_pio_isr);
+    irq_set_enabled(PIO0_IRQ_0, true);
+
+    pio_set_sm_mask_enabled(RS485_PIO, (1u << RS485_PIO_TX_SM) | (1u << RS485_PIO_RX_SM), true);
+    return actual_baud;
+}
+
+bool rs485_configure(rs485_backend_t new_backend, uint32_t baud) {
+    if (new_backend >= RS485_BACKEND_COUNT || baud < RS485_BAUD_MIN) {
+        return false;
+    }
+
+    // Check the divisor before touching the running bus (±1%)
+    uint32_t predicted;
+    if (new_backend == RS485_BACKEND_PIO) {
+        (void)rs485_pio_divider(baud, &predicted);
+        if (pio_tx_offset < 0 && (!pio_can_add_program(RS485_PIO, &rs485_tx_program) ||
+                                  !pio_can_add_program(RS485_PIO, &rs485_rx_program))) {
+            return false;  // PIO0 instruction memory taken
+        }
+    } else {
+        predicted = clock_profile_uart_baud(clock_get_hz(clk_peri), baud);
+    }
+    int32_t error_ppm = clock_profile_baud_error_ppm(predicted, baud);
+    if (error_ppm > CLOCK_UART_BAUD_TOLERANCE_PPM ||
+        error_ppm < -CLOCK_UART_BAUD_TOLERANCE_PPM) {
+        return false;  // Baud rate out of tolerance
+    }
+
+    if (bus_up) {
+        rs485_stop();
+    }
+
+    // Resources shared by both backends are claimed once; rs485_init() may
+    // be called again by tests
+    if (tx_dma_chan < 0) {
+        tx_dma_chan = dma_claim_unused_channel(true);
+        hardware_alarm_claim(RS485_TX_ALARM_NUM);
+        hardware_alarm_set_callback(RS485_TX_ALARM_NUM, rs485_tx_alarm_cb);
+        hardware_alarm_claim(RS485_DEFER_ALARM_NUM);
+        hardware_alarm_set_callback(RS485_DEFER_ALARM_NUM, rs485_defer_alarm_cb);
+    }
+
+    // Mask the RX interrupts first so re-initialization cannot race the ISR
+    irq_set_enabled(UART1_IRQ, false);
+    irq_set_enabled(PIO0_IRQ_0, false);
+    ringbuf8_init(&rx_ring, rx_storage, sizeof(rx_storage));
+    rx_dropped_count = 0;
+    rx_hw_overrun_count = 0;
+    rx_peak_count = 0;
+    rx_error_flags = 0;
+    stamp_tail = stamp_head;
+
+    hardware_alarm_cancel(RS485_DEFER_ALARM_NUM);
+    defer_head = 0;
+    defer_tail = 0;
+    defer_in_flight = false;
+    defer_queued_count = 0;
+    defer_sent_count = 0;
+    defer_rejected_count = 0;
+    defer_max_late_us = 0;
+    tx_active = false;
+
+    backend = new_backend;
+    requested_baud = baud;
+    tx_actual_baud = (backend == RS485_BACKEND_PIO) ? rs485_pio_start(baud) : rs485_uart_start(baud);
+    baud_error_ppm = clock_profile_baud_error_ppm(tx_actual_baud, baud);
+    rx_char_ns = 10000000000ull / tx_actual_baud;
+    bus_up = true;
+
+    return true;
+}
+
+bool rs485_init(void) {
+    return rs485_configure(backend, requested_baud);
+}
+
+bool rs485_set_loopback(bool enable) {
+    if (!bus_up || backend != RS485_BACKEND_UART) {
+        return false;
+    }
+    if (enable) {
+        hw_set_bits(&uart_get_hw(RS485_UART)->cr, UART_UARTCR_LBE_BITS);
+    } else {
+        hw_clear_bits(&uart_get_hw(RS485_UART)->cr, UART_UARTCR_LBE_BITS);
+    }
     return true;
 }
 
+rs485_backend_t rs485_get_backend(void) {
+    return backend;
+}
+
 // ============================================================================
 // Transmit
 // ============================================================================
 
-bool rs485_send(const uint8_t *data, size_t len) {
-    if (data == NULL || len == 0) {
+uint8_t *rs485_tx_acquire(size_t *capacity) {
+    if (tx_dma_chan < 0) {
+        return NULL;
+    }
+
+    // Half-duplex: one transmission on the wire at a time, and the DMA
+    // reads straight out of tx_buffer
+    while (tx_active) {
+        tight_loop_contents();
+    }
+
+    if (capacity) {
+        *capacity = sizeof(tx_buffer);
+    }
+    return tx_buffer;
+}
+
+bool rs485_tx_commit(size_t len) {
+    if (len == 0 || len > sizeof(tx_buffer) || tx_dma_chan < 0) {
         return false;
     }
 
-    // Switch to transmit mode
-    gpio_rs485_tx_enable();
+    // Claim the bus. A deferred frame may have gone out since
+    // rs485_tx_acquire(); it does not use tx_buffer, so just wait for it.
+    while (true) {
+        uint32_t save = save_and_disable_interrupts();
+        bool idle = !tx_active;
+        if (idle) {
+            tx_active = true;
+        }
+        restore_interrupts(save);
+        if (idle) {
+            break;
+        }
+        tight_loop_contents();
+    }
 
-    // Wait for transceiver to switch to TX mode
-    sleep_us(RS485_SWITCH_DELAY_US);
+    rs485_tx_start(tx_buffer, len);
+    return true;
+}
 
-    // Send all bytes
-    uart_write_blocking(RS485_UART, data, len);
+bool rs485_send_at(const uint8_t *data, size_t len, uint64_t release_us) {
+    if (data == NULL || len == 0 || len > RS485_DEFER_FRAME_SIZE || tx_dma_chan < 0) {
+        defer_rejected_count++;
+        return false;
+    }
 
-    // Wait for TX FIFO to drain and transmission to complete
-    uart_tx_wait_blocking(RS485_UART);
+    uint32_t save = save_and_disable_interrupts();
+    if (defer_tail - defer_head >= RS485_DEFER_DEPTH) {
+        restore_interrupts(save);
+        defer_rejected_count++;
+        return false;
+    }
 
-    // Additional delay to ensure last bit has fully transmitted
-    // At 460.8 kbps, 1 byte = ~21.7 µs
-    // Add a small safety margin
-    sleep_us(RS485_SWITCH_DELAY_US);
+    rs485_deferred_t *d = &defer_queue[defer_tail % RS485_DEFER_DEPTH];
+    memcpy(d->bytes, data, len);
+    d->len = (uint16_t)len;
+    d->release_us = release_us;
+    defer_tail++;
+    defer_queued_count++;
 
-    // Switch back to receive mode
-    gpio_rs485_rx_enable();
+    // Arm (or send) if this frame is now the head
+    rs485_defer_service();
+    restore_interrupts(save);
 
     return true;
 }
 
+void rs485_get_deferred_stats(uint32_t *queued, uint32_t *sent, uint32_t *rejected,
+                              uint32_t *max_late_us) {
+    if (queued) *queued = defer_queued_count;
+    if (sent) *sent = defer_sent_count;
+    if (rejected) *rejected = defer_rejected_count;
+    if (max_late_us) *max_late_us = defer_max_late_us;
+}
+
+size_t rs485_deferred_pending(void) {
+    return (size_t)(defer_tail - defer_head);
+}
+
+bool rs485_send_async(const uint8_t *data, size_t len) {
+    if (data == NULL || len == 0 || len > sizeof(tx_buffer)) {
+        return false;
+    }
+
+    // Stage the data so the caller's buffer can be reused immediately
+    uint8_t *buf = rs485_tx_acquire(NULL);
+    if (buf == NULL) {
+        return false;
+    }
+    memcpy(buf, data, len);
+
+    return rs485_tx_commit(len);
+}
+
+bool rs485_send(const uint8_t *data, size_t len) {
+    if (!rs485_send_async(data, len)) {
+        return false;
+    }
+
+    rs485_flush_tx();
+    return true;
+}
+
+bool rs485_tx_busy(void) {
+    return tx_active;
+}
+
+uint32_t rs485_tx_start_us(void) {
+    return tx_start_us;
+}
+
+void rs485_set_tx_done_callback(rs485_tx_callback_t callback) {
+    tx_done_callback = callback;
+}
+
 void rs485_flush_tx(void) {
-    uart_tx_wait_blocking(RS485_UART);
+    // DE is released by the alarm callback once the last stop bit is out
+    while (tx_active) {
+        tight_loop_contents();
+    }
 }
 
 // ============================================================================
@@ -88,7 +949,8 @@ void rs485_flush_tx(void) {
 // ============================================================================
 
 size_t rs485_available(void) {
-    return uart_is_readable(RS485_UART) ? 1 : 0;
+    rs485_rx_sync();
+    return ringbuf8_count(&rx_ring);
 }
 
 bool rs485_read_byte(uint8_t *byte) {
@@ -96,12 +958,11 @@ bool rs485_read_byte(uint8_t *byte) {
         return false;
     }
 
-    if (uart_is_readable(RS485_UART)) {
-        *byte = uart_getc(RS485_UART);
+    if (ringbuf8_pop(&rx_ring, byte)) {
         return true;
     }
-
-    return false;
+    rs485_rx_sync();
+    return ringbuf8_pop(&rx_ring, byte);
 }
 
 size_t rs485_read(uint8_t *buffer, size_t len) {
@@ -109,19 +970,84 @@ size_t rs485_read(uint8_t *buffer, size_t len) {
         return 0;
     }
 
+    rs485_rx_sync();
     size_t count = 0;
-    while (count < len && uart_is_readable(RS485_UART)) {
-        buffer[count++] = uart_getc(RS485_UART);
+    while (count < len && ringbuf8_pop(&rx_ring, &buffer[count])) {
+        count++;
     }
 
     return count;
 }
 
 void rs485_clear_rx(void) {
-    // Read and discard all bytes in RX FIFO
-    while (uart_is_readable(RS485_UART)) {
-        uart_getc(RS485_UART);
+    // Discard everything buffered so far (ISR or DMA keeps filling behind us)
+    rs485_rx_sync();
+    ringbuf8_flush(&rx_ring);
+}
+
+void rs485_set_rx_stamping(bool enable) {
+    if (enable && !stamp_enabled) {
+        stamp_tail = stamp_head;    // Nothing older than the switch-on
     }
+    stamp_enabled = enable;
+}
+
+bool rs485_rx_delimiter_time(uint32_t *us) {
+    if (us == NULL || !stamp_enabled) {
+        return false;
+    }
+
+    // The delimiter just popped sits one slot behind tail. Stamps are in
+    // arrival order: older ones belong to bytes flushed unread, a newer one
+    // to a delimiter still in the ring (this one's stamp was lost).
+    uint32_t want = (rx_ring.tail - 1u) & rx_ring.mask;
+    uint32_t unread = ringbuf8_count(&rx_ring);
+    while (stamp_tail != stamp_head) {
+        __dmb();
+        const rs485_stamp_t *s = &stamp_queue[stamp_tail % RS485_STAMP_DEPTH];
+        uint32_t ahead = (s->index - want) & rx_ring.mask;
+        if (ahead == 0) {
+            *us = s->us;
+            stamp_tail++;
+            return true;
+        }
+        if (ahead <= unread) {
+            return false;
+        }
+        stamp_tail++;
+    }
+    return false;
+}
+
+void rs485_set_rx_callback(uint8_t delimiter, rs485_rx_callback_t callback) {
+    rx_delimiter = delimiter;
+    rx_callback = callback;
+
+    if (backend == RS485_BACKEND_PIO && bus_up) {
+        // The RX machine compares against Y. Set before traffic starts (NSP
+        // handler init): a byte arriving while the machine is stopped is lost.
+        pio_sm_set_enabled(RS485_PIO, RS485_PIO_RX_SM, false);
+        rs485_pio_load_y(RS485_PIO_RX_SM, (uint32_t)delimiter << 24);
+        pio_sm_set_enabled(RS485_PIO, RS485_PIO_RX_SM, true);
+    }
+}
+
+void rs485_get_baud(uint32_t *actual_baud, int32_t *error_ppm) {
+    if (actual_baud) *actual_baud = tx_actual_baud;
+    if (error_ppm) *error_ppm = baud_error_ppm;
+}
+
+uint32_t rs485_get_requested_baud(void) {
+    return requested_baud;
+}
+
+void rs485_get_rx_stats(uint32_t *dropped, uint32_t *hw_overruns, uint32_t *peak) {
+    if (backend == RS485_BACKEND_PIO && bus_up) {
+        rs485_pio_poll_stall();
+    }
+    if (dropped) *dropped = rx_dropped_count;
+    if (hw_overruns) *hw_overruns = rx_hw_overrun_count;
+    if (peak) *peak = rx_peak_count;
 }
 
 // ============================================================================
@@ -129,15 +1055,22 @@ void rs485_clear_rx(void) {
 // ============================================================================
 
 uint8_t rs485_get_errors(void) {
-    // Read UART error status register
-    // This implementation is simplified - the Pico SDK doesn't expose
-    // direct error flag access, so we return 0 for now
-    // TODO: Access hardware registers directly if detailed error reporting needed
-    return 0;
+    // Flags are latched by the RX ISR from the per-byte UARTDR error bits
+    // (PIO backend: from the RX machine's framing IRQ and FIFO stalls)
+    if (backend == RS485_BACKEND_PIO && bus_up) {
+        rs485_pio_poll_stall();
+    }
+    return rx_error_flags;
 }
 
 void rs485_clear_errors(void) {
-    // Clear any pending errors by reading data register
-    // On RP2040, reading UARTDR clears error flags
-    rs485_clear_rx();
+    rx_error_flags = 0;
+
+    if (backend == RS485_BACKEND_PIO) {
+        RS485_PIO->fdebug = 1u << (PIO_FDEBUG_RXSTALL_LSB + RS485_PIO_RX_SM);
+        return;
+    }
+
+    // Writing UARTECR (aliases UARTRSR) clears the hardware error status
+    uart_get_hw(RS485_UART)->rsr = 0;
 }
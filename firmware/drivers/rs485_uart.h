@@ -4,6 +4,19 @@
  *
  * Provides half-duplex RS-485 communication with automatic DE/RE control.
  * Configured for 460.8 kbps, 8-N-1, with proper timing for transceiver switching.
+ *
+ * RX is interrupt-driven into a byte ring. TX is DMA-driven: the reply is
+ * fed into the UART FIFO by DMA and a hardware alarm, armed for the
+ * predicted end of the last stop bit and confirmed against UARTFR.BUSY,
+ * turns the transceiver back to receive with no fixed hold padding.
+ *
+ * Two backends drive the same pins. The PL011 (UART1) is the default. The
+ * PIO backend (drivers/rs485_pio.pio) runs TX and RX on PIO0 state
+ * machines for rates the bench OBCs use above 460.8 kbps: the TX machine
+ * drives DE/RE itself, DMA moves bytes in both directions (RX into the same
+ * ring, written in hardware ring mode), and the baud rate is just the
+ * state machine clock divider. Backend and baud rate can be changed at run
+ * time with rs485_configure().
  */
 
 #ifndef RS485_UART_H
@@ -38,13 +51,49 @@
 #define RS485_RX_PIN 5
 
 /**
- * @brief DE/RE switching delay in microseconds
+ * @brief DE assert to first start bit delay in microseconds
  *
- * The RS-485 transceiver needs time to switch between transmit and receive modes.
- * Typical MAX485-style transceivers need 10-30 µs.
+ * The RS-485 transceiver needs time to enable its driver before the first
+ * start bit. Typical MAX485-style transceivers need 10-30 µs. No delay is
+ * applied after the last stop bit; DE drops as soon as the UART goes idle.
  */
 #define RS485_SWITCH_DELAY_US 10
 
+/**
+ * @brief Transceiver backends
+ */
+typedef enum {
+    RS485_BACKEND_UART = 0,     /**< PL011 UART1, GPIO-driven DE/RE */
+    RS485_BACKEND_PIO = 1,      /**< PIO0 state machines, DE/RE by side-set */
+    RS485_BACKEND_COUNT
+} rs485_backend_t;
+
+/** Backend used by rs485_init() (cmake -DNRWA_RS485_BACKEND=PIO ..) */
+#ifndef RS485_BACKEND_DEFAULT
+#define RS485_BACKEND_DEFAULT RS485_BACKEND_UART
+#endif
+
+/** Slowest baud rate accepted by rs485_configure() */
+#define RS485_BAUD_MIN 9600
+
+/**
+ * @brief UART error flags returned by rs485_get_errors()
+ */
+#define RS485_ERR_OVERRUN   0x01    /**< RX FIFO overrun (OE) */
+#define RS485_ERR_BREAK     0x02    /**< Break condition (BE) */
+#define RS485_ERR_PARITY    0x04    /**< Parity mismatch (PE) */
+#define RS485_ERR_FRAMING   0x08    /**< Invalid stop bit (FE) */
+
+/**
+ * @brief RX notification callback (called from UART1 ISR context)
+ */
+typedef void (*rs485_rx_callback_t)(void);
+
+/**
+ * @brief TX-complete callback (called from timer alarm IRQ context)
+ */
+typedef void (*rs485_tx_callback_t)(void);
+
 // ============================================================================
 // API Functions
 // ============================================================================
@@ -52,8 +101,10 @@
 /**
  * @brief Initialize RS-485 UART
  *
- * Configures UART1 for 460.8 kbps, 8-N-1, and sets up DE/RE control pins.
- * After init, the transceiver is in receive mode.
+ * Configures UART1 for 460.8 kbps, 8-N-1, and sets up DE/RE control pins
+ * (or the PIO backend, see rs485_configure()). After init, the transceiver
+ * is in receive mode and RX bytes land in a RS485_RX_BUFFER_SIZE byte
+ * ring, so the caller may poll at any rate without losing data.
  *
  * @return true if initialization succeeded, false otherwise
  */
@@ -73,10 +124,111 @@ bool rs485_init(void);
  */
 bool rs485_send(const uint8_t *data, size_t len);
 
+/**
+ * @brief Queue data for transmission over RS-485 (non-blocking)
+ *
+ * Copies data into the driver's TX buffer, asserts DE and starts DMA, then
+ * returns while the bytes drain onto the wire. DE is released from a timer
+ * alarm when the last stop bit has left the shift register. If a previous
+ * transmission is still in progress, waits for it first (half-duplex).
+ *
+ * @param data Pointer to data buffer to send (may be reused on return)
+ * @param len Number of bytes to send (max RS485_TX_BUFFER_SIZE)
+ * @return true if queued, false if data is NULL, len is 0 or too long
+ */
+bool rs485_send_async(const uint8_t *data, size_t len);
+
+/**
+ * @brief Borrow the driver's TX buffer for in-place serialization
+ *
+ * Waits for any transmission in progress (the DMA reads from this buffer),
+ * then returns it. Fill it and hand it back with rs485_tx_commit(); do not
+ * touch it again until rs485_tx_busy() is false. Saves the copy made by
+ * rs485_send_async().
+ *
+ * @param capacity Optional pointer receiving the buffer size
+ * @return TX buffer, or NULL if the driver is not initialized
+ */
+uint8_t *rs485_tx_acquire(size_t *capacity);
+
+/**
+ * @brief Transmit the first len bytes of the TX buffer (non-blocking)
+ *
+ * Same wire behaviour as rs485_send_async(). If a deferred frame went out
+ * after rs485_tx_acquire(), waits for it to leave the wire first.
+ *
+ * @param len Number of bytes written into the buffer from rs485_tx_acquire()
+ * @return true if queued, false if len is 0 or too long
+ */
+bool rs485_tx_commit(size_t len);
+
+/**
+ * @brief Queue a frame for transmission at an absolute time (non-blocking)
+ *
+ * Copies the frame into one of RS485_DEFER_DEPTH slots. A dedicated
+ * hardware alarm asserts DE so the first start bit leaves at release_us
+ * (or as soon as the bus is free, whichever is later); reception and
+ * immediate transmissions continue meanwhile. Frames go out in the order
+ * they were queued.
+ *
+ * Completion of a deferred frame does not fire the TX-done callback, so
+ * injected delays stay out of the caller's reply timing.
+ *
+ * @param data Encoded frame (may be reused on return)
+ * @param len Frame length (max RS485_DEFER_FRAME_SIZE)
+ * @param release_us time_us_64() at which transmission should start
+ * @return true if queued, false if the queue is full or the frame too long
+ */
+bool rs485_send_at(const uint8_t *data, size_t len, uint64_t release_us);
+
+/**
+ * @brief Get deferred transmission statistics
+ *
+ * @param queued Output: frames accepted by rs485_send_at() (can be NULL)
+ * @param sent Output: deferred frames fully transmitted (can be NULL)
+ * @param rejected Output: frames refused (queue full / too long) (can be NULL)
+ * @param max_late_us Output: worst start after release_us (can be NULL)
+ */
+void rs485_get_deferred_stats(uint32_t *queued, uint32_t *sent, uint32_t *rejected,
+                              uint32_t *max_late_us);
+
+/**
+ * @brief Get the number of deferred frames not yet transmitted
+ *
+ * @return Frames queued or on the wire
+ */
+size_t rs485_deferred_pending(void);
+
+/**
+ * @brief Check whether a transmission is in progress
+ *
+ * @return true from DE assert until DE release
+ */
+bool rs485_tx_busy(void);
+
+/**
+ * @brief Get the start time of the most recent transmission
+ *
+ * Taken after the transceiver enable delay, when the first start bit goes
+ * out (the reply's first byte on the wire).
+ *
+ * @return time_us_32() timestamp, 0 if nothing has been sent
+ */
+uint32_t rs485_tx_start_us(void);
+
+/**
+ * @brief Register a callback fired when a transmission completes
+ *
+ * Runs in alarm IRQ context right after DE is released.
+ *
+ * @param callback Callback, or NULL to disable notification
+ */
+void rs485_set_tx_done_callback(rs485_tx_callback_t callback);
+
 /**
  * @brief Check if data is available to read
  *
- * @return Number of bytes available in RX FIFO
+ * @return Number of bytes buffered in the RX ring
  */
 size_t rs485_available(void);
 
@@ -93,7 +245,7 @@ bool rs485_read_byte(uint8_t *byte);
 /**
  * @brief Read multiple bytes from RS-485
  *
- * Reads up to len bytes from RX FIFO. Returns actual number of bytes read.
+ * Reads up to len bytes from the RX ring. Returns actual number of bytes read.
  *
  * @param buffer Buffer to store received bytes
  * @param len Maximum number of bytes to read
@@ -102,29 +254,122 @@ bool rs485_read_byte(uint8_t *byte);
 size_t rs485_read(uint8_t *buffer, size_t len);
 
 /**
- * @brief Flush TX FIFO and wait for transmission to complete
+ * @brief Wait for transmission to complete
  *
- * Blocks until all pending TX data has been transmitted.
+ * Blocks until all pending TX data has been transmitted and the transceiver
+ * is back in receive mode.
  */
 void rs485_flush_tx(void);
 
 /**
- * @brief Clear RX FIFO
+ * @brief Clear RX buffer
  *
- * Discards all unread data in the receive buffer.
+ * Discards all unread data in the receive ring.
  */
 void rs485_clear_rx(void);
 
+/**
+ * @brief Register a callback fired when a delimiter byte is received
+ *
+ * The callback runs in the UART1 RX ISR after the FIFO has been drained, so
+ * every byte up to and including the delimiter is already in the ring. Keep
+ * it short (e.g. pend a lower-priority service IRQ).
+ *
+ * @param delimiter Byte value that triggers the callback (e.g. SLIP END)
+ * @param callback Callback, or NULL to disable notification
+ */
+void rs485_set_rx_callback(uint8_t delimiter, rs485_rx_callback_t callback);
+
+/**
+ * @brief Stamp the arrival of every delimiter byte (bus meter and monitor)
+ *
+ * @param enable true to record stamps for rs485_rx_delimiter_time()
+ */
+void rs485_set_rx_stamping(bool enable);
+
+/**
+ * @brief Arrival time of the delimiter byte just read
+ *
+ * Call right after rs485_read_byte() has returned the delimiter. The UART
+ * backend stamps in the RX interrupt and back-dates each byte by its place
+ * in the drained FIFO batch (about ±1 character time); the PIO backend
+ * stamps as the RX machine pushes the byte (about 1 µs).
+ *
+ * @param us Output: time_us_32() at the end of the byte's stop bit
+ * @return true if stamping is on and the byte was stamped
+ */
+bool rs485_rx_delimiter_time(uint32_t *us);
+
+/**
+ * @brief Switch backend and/or baud rate
+ *
+ * Waits for the current transmission, drops any deferred frames and RX
+ * bytes not yet read, and brings the bus up again on the new settings.
+ * Called by rs485_init() with the last applied settings (initially
+ * RS485_BACKEND_DEFAULT at RS485_BAUD_RATE). The divisor is checked
+ * first; if it is rejected the bus keeps running on the current settings.
+ *
+ * @param backend Backend to use
+ * @param baud Requested baud rate (>= RS485_BAUD_MIN, divisor within ±1%)
+ * @return true if the bus is up on the requested settings
+ */
+bool rs485_configure(rs485_backend_t backend, uint32_t baud);
+
+/**
+ * @brief Get the active backend
+ *
+ * @return Backend in use
+ */
+rs485_backend_t rs485_get_backend(void);
+
+/**
+ * @brief Get the programmed baud rate
+ *
+ * @param actual_baud Baud rate the divisor produces (can be NULL)
+ * @param error_ppm Its error against the requested rate in ppm (can be NULL)
+ */
+void rs485_get_baud(uint32_t *actual_baud, int32_t *error_ppm);
+
+/**
+ * @brief Get the requested baud rate
+ *
+ * @return Nominal rate last passed to rs485_configure()
+ */
+uint32_t rs485_get_requested_baud(void);
+
+/**
+ * @brief Route TX back into RX inside the UART (PL011 loopback)
+ *
+ * For the load generator (nsp_loadgen.h): every byte sent, requests and
+ * replies alike, is received again without a jumper. The TX pin and DE
+ * keep toggling, so disconnect the bus first. Only the UART backend has
+ * the loopback; rs485_configure() turns it off.
+ *
+ * @param enable true to loop back, false for normal operation
+ * @return false if the active backend has no internal loopback
+ */
+bool rs485_set_loopback(bool enable);
+
+/**
+ * @brief Get RX ring statistics
+ *
+ * @param dropped Bytes lost because the ring was full (can be NULL)
+ * @param hw_overruns Hardware FIFO overrun events (can be NULL)
+ * @param peak Peak ring occupancy in bytes (can be NULL)
+ */
+void rs485_get_rx_stats(uint32_t *dropped, uint32_t *hw_overruns, uint32_t *peak);
+
 /**
  * @brief Get UART error flags
  *
- * Returns bit flags for UART errors:
+ * Returns bit flags for UART errors latched since the last clear (the PIO
+ * backend reports a bad stop bit as FE and a stalled RX FIFO as OE):
  * - Bit 0: Overrun error (OE) - RX FIFO overflow
  * - Bit 1: Break error (BE) - Break condition detected
  * - Bit 2: Parity error (PE) - Parity mismatch
  * - Bit 3: Framing error (FE) - Invalid stop bit
  *
- * @return Error flags (0 = no errors)
+ * @return Error flags (RS485_ERR_*, 0 = no errors)
  */
 uint8_t rs485_get_errors(void);
 
@@ -6,6 +6,7 @@
  */
 
 #include "slip.h"
+#include "hot_path.h"
 #include <string.h>
 
 // ============================================================================
@@ -63,6 +64,28 @@ bool slip_encode(const uint8_t *data, size_t data_len,
     return true;
 }
 
+void HOT_PATH_FUNC(slip_writer_begin)(slip_writer_t *writer, uint8_t *output, size_t capacity) {
+    writer->out = output;
+    writer->cap = capacity;
+    writer->len = 0;
+    writer->overflow = (output == NULL || capacity < 2);
+    if (!writer->overflow) {
+        writer->out[writer->len++] = SLIP_END;
+    }
+}
+
+bool HOT_PATH_FUNC(slip_writer_end)(slip_writer_t *writer, size_t *output_len) {
+    if (writer->overflow || writer->len + 1 > writer->cap) {
+        writer->overflow = true;
+        return false;
+    }
+    writer->out[writer->len++] = SLIP_END;
+    if (output_len) {
+        *output_len = writer->len;
+    }
+    return true;
+}
+
 // ============================================================================
 // SLIP Decoder (Streaming State Machine)
 // ============================================================================
@@ -78,20 +101,11 @@ void slip_decoder_init(slip_decoder_t *decoder) {
     decoder->frame_error = false;
 }
 
-void slip_decoder_reset(slip_decoder_t *decoder) {
+void HOT_PATH_FUNC(slip_decoder_reset)(slip_decoder_t *decoder) {
     slip_decoder_init(decoder);
 }
 
-bool slip_decode_byte(slip_decoder_t *decoder, uint8_t byte,
-                      uint8_t *output, size_t *output_len) {
-    // Validate inputs
-    if (decoder == NULL || output == NULL || output_len == NULL) {
-        return false;
-    }
-
-    // Reset frame completion flags at start of each call
-    decoder->frame_complete = false;
-
+slip_event_t HOT_PATH_FUNC(slip_decode_step)(slip_decoder_t *decoder, uint8_t byte, uint8_t *data) {
     switch (decoder->state) {
         case SLIP_STATE_IDLE:
             // Waiting for frame start
@@ -102,61 +116,117 @@ bool slip_decode_byte(slip_decoder_t *decoder, uint8_t byte,
                 decoder->frame_error = false;
             }
             // Ignore all other bytes while idle
-            break;
+            return SLIP_EVENT_NONE;
 
         case SLIP_STATE_IN_FRAME:
             if (byte == SLIP_END) {
                 // End of frame
                 if (decoder->frame_len > 0) {
                     // Valid frame - report it
-                    *output_len = decoder->frame_len;
-                    decoder->frame_complete = true;
                     decoder->state = SLIP_STATE_IDLE;
-                    decoder->frame_len = 0;
-                    return true;  // Frame complete!
-                } else {
-                    // Empty frame (two consecutive END bytes) - ignore and stay in frame mode
-                    // This handles the case where frames are sent back-to-back
-                    decoder->frame_len = 0;
+                    return SLIP_EVENT_FRAME_END;
                 }
-            } else if (byte == SLIP_ESC) {
+                // Empty frame (two consecutive END bytes) - ignore and stay in frame mode
+                // This handles the case where frames are sent back-to-back
+                return SLIP_EVENT_NONE;
+            }
+            if (byte == SLIP_ESC) {
                 // Start of escape sequence
                 decoder->state = SLIP_STATE_ESCAPED;
-            } else {
-                // Regular data byte
-                output[decoder->frame_len++] = byte;
+                return SLIP_EVENT_NONE;
             }
-            break;
+            // Regular data byte
+            *data = byte;
+            decoder->frame_len++;
+            return SLIP_EVENT_DATA;
 
         case SLIP_STATE_ESCAPED:
             // Previous byte was ESC - decode escape sequence
             if (byte == SLIP_ESC_END) {
                 // ESC + ESC_END -> END byte in data
-                output[decoder->frame_len++] = SLIP_END;
+                *data = SLIP_END;
+                decoder->frame_len++;
                 decoder->state = SLIP_STATE_IN_FRAME;
-            } else if (byte == SLIP_ESC_ESC) {
+                return SLIP_EVENT_DATA;
+            }
+            if (byte == SLIP_ESC_ESC) {
                 // ESC + ESC_ESC -> ESC byte in data
-                output[decoder->frame_len++] = SLIP_ESC;
+                *data = SLIP_ESC;
+                decoder->frame_len++;
                 decoder->state = SLIP_STATE_IN_FRAME;
-            } else if (byte == SLIP_END) {
-                // ESC followed by END - protocol error, but treat as end of frame
-                decoder->frame_error = true;
-                decoder->state = SLIP_STATE_IDLE;
-                decoder->frame_len = 0;
-            } else {
-                // Invalid escape sequence - protocol error
-                // Discard frame and reset
-                decoder->frame_error = true;
-                decoder->state = SLIP_STATE_IDLE;
-                decoder->frame_len = 0;
+                return SLIP_EVENT_DATA;
             }
-            break;
+            // ESC followed by END or any other byte - protocol error
+            // Discard frame and reset
+            decoder->frame_error = true;
+            decoder->state = SLIP_STATE_IDLE;
+            decoder->frame_len = 0;
+            return SLIP_EVENT_ERROR;
 
         default:
             // Should never reach here - reset to safe state
             slip_decoder_init(decoder);
-            break;
+            return SLIP_EVENT_NONE;
     }
+}
 
-    return false;  // No complete frame yet
+bool slip_decode_byte(slip_decoder_t *decoder, uint8_t byte,
+                      uint8_t *output, size_t *output_len) {
+    // Validate inputs
+    if (decoder == NULL || output == NULL || output_len == NULL) {
+        return false;
+    }
+
+    // Reset frame completion flags at start of each call
+    decoder->frame_complete = false;
+
+    size_t idx = decoder->frame_len;
+    uint8_t data;
+
+    switch (slip_decode_step(decoder, byte, &data)) {
+        case SLIP_EVENT_DATA:
+            output[idx] = data;
+            return false;
+
+        case SLIP_EVENT_FRAME_END:
+            *output_len = idx;
+            decoder->frame_complete = true;
+            decoder->frame_len = 0;
+            return true;  // Frame complete!
+
+        default:
+            return false;  // No complete frame yet
+    }
+}
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+bool slip_corrupt_last_byte(uint8_t *frame, size_t len) {
+    if (frame == NULL || len < 2 || frame[len - 1] != SLIP_END) {
+        return false;
+    }
+
+    uint8_t *last = &frame[len - 2];
+
+    // Escaped byte: swap the escape code, the decoded byte changes
+    // between END and ESC and the frame stays well-formed
+    if (len >= 3 && frame[len - 3] == SLIP_ESC &&
+        (*last == SLIP_ESC_END || *last == SLIP_ESC_ESC)) {
+        *last = (*last == SLIP_ESC_END) ? SLIP_ESC_ESC : SLIP_ESC_END;
+        return true;
+    }
+
+    if (*last == SLIP_END) {
+        return false;  // Empty frame
+    }
+
+    // Plain byte: flip a low bit without creating END or ESC
+    uint8_t flipped = *last ^ 0x01;
+    if (flipped == SLIP_END || flipped == SLIP_ESC) {
+        flipped = *last ^ 0x02;
+    }
+    *last = flipped;
+    return true;
 }
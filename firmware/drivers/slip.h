@@ -61,6 +61,60 @@
 bool slip_encode(const uint8_t *data, size_t data_len,
                  uint8_t *output, size_t *output_len);
 
+/**
+ * @brief Incremental SLIP writer
+ *
+ * Escapes bytes straight into a caller-owned buffer, so a packet can be
+ * serialized and framed in a single pass without an unescaped staging copy.
+ */
+typedef struct {
+    uint8_t *out;       /**< Output buffer */
+    size_t cap;         /**< Output buffer capacity */
+    size_t len;         /**< Bytes written so far */
+    bool overflow;      /**< Set if any byte did not fit */
+} slip_writer_t;
+
+/**
+ * @brief Start a SLIP frame (writes the leading END)
+ *
+ * @param writer Pointer to writer
+ * @param output Output buffer
+ * @param capacity Output buffer size in bytes
+ */
+void slip_writer_begin(slip_writer_t *writer, uint8_t *output, size_t capacity);
+
+/**
+ * @brief Append one data byte, escaping END/ESC
+ *
+ * @param writer Pointer to writer
+ * @param byte Data byte
+ */
+static inline void slip_writer_put(slip_writer_t *writer, uint8_t byte) {
+    bool special = (byte == SLIP_END) || (byte == SLIP_ESC);
+    if (writer->len + (special ? 2u : 1u) > writer->cap) {
+        writer->overflow = true;
+        return;
+    }
+    if (byte == SLIP_END) {
+        writer->out[writer->len++] = SLIP_ESC;
+        writer->out[writer->len++] = SLIP_ESC_END;
+    } else if (byte == SLIP_ESC) {
+        writer->out[writer->len++] = SLIP_ESC;
+        writer->out[writer->len++] = SLIP_ESC_ESC;
+    } else {
+        writer->out[writer->len++] = byte;
+    }
+}
+
+/**
+ * @brief Finish a SLIP frame (writes the trailing END)
+ *
+ * @param writer Pointer to writer
+ * @param output_len Pointer to variable receiving total encoded length
+ * @return true if the whole frame fit in the buffer
+ */
+bool slip_writer_end(slip_writer_t *writer, size_t *output_len);
+
 // ============================================================================
 // SLIP Decoder (Streaming)
 // ============================================================================
@@ -74,6 +128,16 @@ typedef enum {
     SLIP_STATE_ESCAPED      /**< Previous byte was ESC, process escape sequence */
 } slip_decoder_state_t;
 
+/**
+ * @brief Result of feeding one byte to slip_decode_step()
+ */
+typedef enum {
+    SLIP_EVENT_NONE,        /**< Byte consumed, nothing to report */
+    SLIP_EVENT_DATA,        /**< One unescaped data byte produced */
+    SLIP_EVENT_FRAME_END,   /**< END closed a non-empty frame */
+    SLIP_EVENT_ERROR        /**< Invalid escape sequence, frame discarded */
+} slip_event_t;
+
 /**
  * @brief SLIP decoder context
  *
@@ -112,6 +176,21 @@ void slip_decoder_init(slip_decoder_t *decoder);
 bool slip_decode_byte(slip_decoder_t *decoder, uint8_t byte,
                       uint8_t *output, size_t *output_len);
 
+/**
+ * @brief Decode a single SLIP byte without buffering (streaming)
+ *
+ * Low-level form of slip_decode_byte() for receivers that consume bytes on
+ * the fly (e.g. the fused NSP receiver). The caller owns storage.
+ * decoder->frame_len counts data bytes in the current frame and still holds
+ * the frame length when SLIP_EVENT_FRAME_END is returned.
+ *
+ * @param decoder Pointer to decoder context
+ * @param byte Incoming byte
+ * @param data Receives the unescaped byte on SLIP_EVENT_DATA
+ * @return Event produced by this byte
+ */
+slip_event_t slip_decode_step(slip_decoder_t *decoder, uint8_t byte, uint8_t *data);
+
 /**
  * @brief Reset decoder to idle state
  *
@@ -138,4 +217,17 @@ static inline size_t slip_max_encoded_size(size_t data_len) {
     return (data_len * 2) + 2;  // Worst case: all bytes escaped + 2 END bytes
 }
 
+/**
+ * @brief Corrupt the last data byte of an encoded frame in place
+ *
+ * Changes the byte before the trailing END (the CRC high byte of an NSP
+ * frame) while keeping SLIP framing valid, so the receiver gets a
+ * well-formed frame that fails its CRC check. Length is unchanged.
+ *
+ * @param frame Encoded frame ending in SLIP_END
+ * @param len Frame length
+ * @return true if a byte was changed
+ */
+bool slip_corrupt_last_byte(uint8_t *frame, size_t len);
+
 #endif // SLIP_H
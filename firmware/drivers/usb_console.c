@@ -0,0 +1,128 @@
+/**
+ * @file usb_console.c
+ * @brief Buffered, Non-Blocking Console Output Implementation
+ */
+
+#include "usb_console.h"
+#include "tusb.h"
+#include "pico/time.h"
+#include "hardware/sync.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+// State
+// ============================================================================
+//
+// One frame buffer, owned by the main loop while building and by the pump
+// while pending. g_pending hands it over in each direction.
+
+static char g_buf[USB_CONSOLE_BUF_SIZE];
+static uint32_t g_len = 0;                  // Bytes in the frame
+static bool g_truncated = false;            // Text dropped while building
+static volatile uint32_t g_sent = 0;        // Bytes already in the FIFO (pump only)
+static volatile bool g_pending = false;     // Frame handed to the pump
+
+// ============================================================================
+// Producer (main loop)
+// ============================================================================
+
+bool usb_console_host_present(void) {
+    return tud_cdc_n_connected(USB_CONSOLE_CDC_ITF);
+}
+
+bool usb_console_begin(void) {
+    if (g_pending || !usb_console_host_present()) {
+        return false;
+    }
+    __dmb();    // Pump finished reading before the buffer is reused
+    g_len = 0;
+    g_truncated = false;
+    return true;
+}
+
+void usb_console_printf(const char* fmt, ...) {
+    uint32_t room = USB_CONSOLE_BUF_SIZE - g_len;
+    va_list args;
+
+    va_start(args, fmt);
+    int n = vsnprintf(&g_buf[g_len], room, fmt, args);
+    va_end(args);
+
+    if (n < 0 || (uint32_t)n >= room) {
+        g_truncated = true;     // Drop the whole piece
+        return;
+    }
+    g_len += (uint32_t)n;
+}
+
+void usb_console_repeat(char ch, uint16_t n) {
+    if (n > USB_CONSOLE_BUF_SIZE - g_len) {
+        g_truncated = true;
+        return;
+    }
+    memset(&g_buf[g_len], ch, n);
+    g_len += n;
+}
+
+bool usb_console_end(void) {
+    if (g_len > 0) {
+        g_sent = 0;
+        __dmb();    // Frame complete before the pump sees it
+        g_pending = true;
+    }
+    return !g_truncated;
+}
+
+bool usb_console_busy(void) {
+    return g_pending;
+}
+
+bool usb_console_wait_idle(uint32_t timeout_us) {
+    absolute_time_t deadline = make_timeout_time_us(timeout_us);
+
+    while (g_pending) {
+        if (absolute_time_diff_us(get_absolute_time(), deadline) <= 0) {
+            return false;
+        }
+        tight_loop_contents();  // Pump runs from the USB background task
+    }
+    return true;
+}
+
+// ============================================================================
+// Consumer (tud_task context)
+// ============================================================================
+
+void usb_console_pump(void) {
+    if (!g_pending) {
+        return;
+    }
+
+    if (!tud_cdc_n_connected(USB_CONSOLE_CDC_ITF)) {
+        g_pending = false;      // Host gone: nobody to draw for
+        return;
+    }
+
+    __dmb();    // Read the frame after seeing it handed over
+    uint32_t sent = g_sent;
+    uint32_t room = tud_cdc_n_write_available(USB_CONSOLE_CDC_ITF);
+    uint32_t n = g_len - sent;
+    if (n > room) {
+        n = room;
+    }
+    if (n == 0) {
+        return;
+    }
+
+    tud_cdc_n_write(USB_CONSOLE_CDC_ITF, &g_buf[sent], n);
+    tud_cdc_n_write_flush(USB_CONSOLE_CDC_ITF);
+    sent += n;
+    g_sent = sent;
+
+    if (sent == g_len) {
+        __dmb();    // Done with the buffer before releasing it
+        g_pending = false;
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * @file usb_console.h
+ * @brief Buffered, Non-Blocking Console Output (USB CDC 0)
+ *
+ * The TUI formats each screen update into one RAM frame and hands it over
+ * whole; the frame is drained into the CDC 0 FIFO from the USB
+ * start-of-frame callback (every 1 ms, inside tud_task()) as space allows,
+ * so rendering never waits on the host. While a frame is still draining
+ * the next one cannot begin: the caller skips that update and renders the
+ * latest state once the port catches up, so updates coalesce under
+ * backpressure instead of queueing.
+ *
+ * With no host on the port (DTR low) a pending frame is discarded and
+ * usb_console_begin() refuses, so a headless emulator spends nothing on
+ * the console.
+ *
+ * Plain printf() still works for one-off messages and blocking menus; call
+ * usb_console_wait_idle() first so they do not land inside a frame.
+ */
+
+#ifndef USB_CONSOLE_H
+#define USB_CONSOLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** Frame buffer size (a full TUI redraw with several tables expanded) */
+#ifndef USB_CONSOLE_BUF_SIZE
+#define USB_CONSOLE_BUF_SIZE    16384
+#endif
+
+/** CDC interface of the console (stdio) */
+#define USB_CONSOLE_CDC_ITF     0
+
+/**
+ * @brief Check whether a host has the console port open (DTR high)
+ */
+bool usb_console_host_present(void);
+
+/**
+ * @brief Start formatting a frame
+ *
+ * @return false if no host is connected or the previous frame is still
+ *         draining (skip this update)
+ */
+bool usb_console_begin(void);
+
+/**
+ * @brief Append formatted text to the frame being built
+ *
+ * Text that does not fit is dropped whole (never half an escape sequence)
+ * and the frame is marked truncated.
+ */
+void usb_console_printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Append a character repeated n times
+ */
+void usb_console_repeat(char ch, uint16_t n);
+
+/**
+ * @brief Hand the frame over for sending
+ *
+ * @return false if some text was dropped because the buffer was full
+ */
+bool usb_console_end(void);
+
+/**
+ * @brief Check whether a frame is still draining
+ */
+bool usb_console_busy(void);
+
+/**
+ * @brief Wait for the pending frame to drain (before plain printf output)
+ *
+ * @param timeout_us Give up after this long (host not reading)
+ * @return true if idle
+ */
+bool usb_console_wait_idle(uint32_t timeout_us);
+
+/**
+ * @brief Move pending output into the CDC 0 FIFO (tud_task() context only)
+ */
+void usb_console_pump(void);
+
+#endif // USB_CONSOLE_H
@@ -0,0 +1,618 @@
+/**
+ * @file usb_stream.c
+ * @brief Binary Telemetry Stream Implementation
+ */
+
+#include "usb_stream.h"
+#include "usb_console.h"
+#include "slip.h"
+#include "crc_ccitt.h"
+#include "../util/nsp_trace.h"
+#include "../util/flight_rec.h"
+#include "board_pico.h"
+#include "tusb.h"
+#include "pico/platform.h"
+#include "hardware/sync.h"
+#include <string.h>
+
+// ============================================================================
+// Ring (Core1 → Core0, single producer / single consumer)
+// ============================================================================
+
+#define RING_MASK   (USB_STREAM_RING_DEPTH - 1u)
+
+_Static_assert((USB_STREAM_RING_DEPTH & RING_MASK) == 0, "ring depth must be a power of 2");
+_Static_assert(2u * (8u + 16u * USB_STREAM_TRACE_BATCH + 2u) + 2u <= USB_STREAM_MAX_FRAME,
+               "trace batch must fit the frame buffer");
+_Static_assert(2u * (8u + 16u * USB_STREAM_REC_BATCH + 2u) + 2u <= USB_STREAM_MAX_FRAME,
+               "recorder batch must fit the frame buffer");
+
+static telemetry_snapshot_t g_ring[USB_STREAM_RING_DEPTH];
+static uint16_t g_ring_seq[USB_STREAM_RING_DEPTH];
+static volatile uint32_t g_ring_head = 0;       // Written by Core1 only
+static volatile uint32_t g_ring_tail = 0;       // Written by Core0 only
+
+// ============================================================================
+// State
+// ============================================================================
+
+static volatile bool g_enabled = false;         // Set from the console
+static volatile bool g_active = false;          // Enabled and host listening (read by Core1)
+static volatile uint32_t g_field_mask = USB_STREAM_FIELDS_ALL;
+static volatile uint32_t g_divider = 1;
+
+static volatile uint32_t g_dropped_ring = 0;    // Written by Core1 only
+static volatile uint32_t g_ring_high_water = 0; // Written by Core1 only
+static uint16_t g_sequence = 0;                  // Written by Core1 only
+static uint32_t g_frames_sent = 0;
+static uint32_t g_bytes_sent = 0;
+
+// NSP trace dump in progress (Core0 pump only)
+static bool g_dump_active = false;
+static uint8_t g_dump_reason = 0;
+static uint32_t g_dump_first = 0;
+static uint32_t g_dump_next = 0;
+static uint32_t g_dump_end = 0;
+static uint32_t g_dumps_sent = 0;
+
+// Flight recorder download in progress (Core0 pump only)
+static volatile bool g_rec_requested = false;
+static bool g_rec_active = false;
+static flight_rec_info_t g_rec_info;
+static uint32_t g_rec_next = 0;                 // Next sample number
+static uint32_t g_rec_end = 0;
+static uint32_t g_rec_downloads = 0;
+
+// Bus monitor capture (Core0 pump only)
+static uint32_t g_capture_frames = 0;
+
+static uint8_t g_frame[USB_STREAM_CAPTURE_MAX_FRAME > USB_STREAM_MAX_FRAME ?
+                       USB_STREAM_CAPTURE_MAX_FRAME : USB_STREAM_MAX_FRAME];
+
+// ============================================================================
+// Core1 Producer
+// ============================================================================
+
+void __not_in_flash_func(usb_stream_core1_push)(const telemetry_snapshot_t* snapshot) {
+    if (!g_active) {
+        return;
+    }
+
+    uint32_t divider = g_divider;
+    if (divider > 1 && (snapshot->tick_count % divider) != 0) {
+        return;
+    }
+
+    // Dropped snapshots still take a sequence number, so the host sees the gap
+    uint16_t seq = g_sequence++;
+
+    uint32_t head = g_ring_head;
+    uint32_t used = head - g_ring_tail;
+    if (used >= USB_STREAM_RING_DEPTH) {
+        g_dropped_ring++;
+        return;
+    }
+
+    g_ring[head & RING_MASK] = *snapshot;
+    g_ring_seq[head & RING_MASK] = seq;
+    __dmb();    // Entry visible before the index that publishes it
+    g_ring_head = head + 1;
+
+    if (used + 1 > g_ring_high_water) {
+        g_ring_high_water = used + 1;
+    }
+}
+
+// ============================================================================
+// Frame Encoding
+// ============================================================================
+
+static inline void put_byte(slip_writer_t* w, uint16_t* crc, uint8_t byte) {
+    *crc = crc_ccitt_update_byte(*crc, byte);
+    slip_writer_put(w, byte);
+}
+
+static void put_u16(slip_writer_t* w, uint16_t* crc, uint16_t v) {
+    put_byte(w, crc, (uint8_t)v);
+    put_byte(w, crc, (uint8_t)(v >> 8));
+}
+
+static void put_u32(slip_writer_t* w, uint16_t* crc, uint32_t v) {
+    for (uint32_t i = 0; i < 4; i++) {
+        put_byte(w, crc, (uint8_t)(v >> (8 * i)));
+    }
+}
+
+static void frame_begin(slip_writer_t* w, uint16_t* crc) {
+    *crc = crc_ccitt_init();
+    slip_writer_begin(w, g_frame, sizeof(g_frame));
+}
+
+/**
+ * @brief Append the CRC-16 (little-endian like the payload) and close the frame
+ *
+ * @return Encoded length in g_frame
+ */
+static size_t frame_end(slip_writer_t* w, uint16_t crc) {
+    size_t len = 0;
+    slip_writer_put(w, (uint8_t)crc);
+    slip_writer_put(w, (uint8_t)(crc >> 8));
+    slip_writer_end(w, &len);
+    return len;
+}
+
+static uint32_t f32_bits(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+/**
+ * @brief 32-bit wire value of one snapshot field
+ */
+static uint32_t field_value(const telemetry_snapshot_t* s, uint32_t field) {
+    switch ((usb_stream_field_t)field) {
+        case USB_STREAM_F_OMEGA:          return f32_bits(s->omega_rad_s);
+        case USB_STREAM_F_SPEED_RPM:      return f32_bits(s->speed_rpm);
+        case USB_STREAM_F_MOMENTUM:       return f32_bits(s->momentum_nms);
+        case USB_STREAM_F_CURRENT:        return f32_bits(s->current_a);
+        case USB_STREAM_F_TORQUE:         return f32_bits(s->torque_mnm);
+        case USB_STREAM_F_POWER:          return f32_bits(s->power_w);
+        case USB_STREAM_F_VOLTAGE:        return f32_bits(s->voltage_v);
+        case USB_STREAM_F_MODE:           return (uint32_t)s->mode;
+        case USB_STREAM_F_DIRECTION:      return (uint32_t)s->direction;
+        case USB_STREAM_F_FAULT_STATUS:   return s->fault_status;
+        case USB_STREAM_F_FAULT_LATCH:    return s->fault_latch;
+        case USB_STREAM_F_WARNING_STATUS: return s->warning_status;
+        case USB_STREAM_F_LCL_TRIPPED:    return s->lcl_tripped ? 1u : 0u;
+        case USB_STREAM_F_JITTER:         return s->jitter_us;
+        case USB_STREAM_F_PHYSICS_US:     return s->physics_us;
+        case USB_STREAM_F_BUSY_US:        return s->busy_us;
+        case USB_STREAM_F_LOAD:           return s->load_permille;
+        case USB_STREAM_F_CURRENT_CMD:    return f32_bits(s->current_cmd_a);
+        case USB_STREAM_F_SPEED_CMD:      return f32_bits(s->speed_cmd_rpm);
+        case USB_STREAM_F_TORQUE_CMD:     return f32_bits(s->torque_cmd_mnm);
+        case USB_STREAM_F_PWM_DUTY:       return f32_bits(s->pwm_duty_pct);
+        default:                          return 0;
+    }
+}
+
+/**
+ * @brief Serialize, checksum and SLIP-frame one snapshot in a single pass
+ *
+ * @return Encoded length in g_frame
+ */
+static size_t encode_frame(const telemetry_snapshot_t* s, uint16_t seq, uint32_t mask) {
+    slip_writer_t w;
+    uint16_t crc;
+
+    frame_begin(&w, &crc);
+    put_byte(&w, &crc, USB_STREAM_FRAME_TELEMETRY);
+    put_byte(&w, &crc, s->wheel);
+    put_u16(&w, &crc, seq);
+    put_u32(&w, &crc, s->tick_count);
+    put_u32(&w, &crc, (uint32_t)s->timestamp_us);
+    put_u32(&w, &crc, (uint32_t)(s->timestamp_us >> 32));
+    put_u32(&w, &crc, mask);
+
+    for (uint32_t f = 0; f < USB_STREAM_FIELD_COUNT; f++) {
+        if (mask & (1u << f)) {
+            put_u32(&w, &crc, field_value(s, f));
+        }
+    }
+    return frame_end(&w, crc);
+}
+
+/**
+ * @brief Frame up to USB_STREAM_TRACE_BATCH trace entries from g_dump_next
+ *
+ * Entries overwritten since the dump was requested are skipped (the first
+ * index in the frame tells the host where the batch starts).
+ *
+ * @return Encoded length in g_frame
+ */
+static size_t encode_trace_frame(void) {
+    nsp_trace_entry_t batch[USB_STREAM_TRACE_BATCH];
+    uint32_t count = 0;
+
+    uint32_t oldest = nsp_trace_oldest();
+    if ((int32_t)(g_dump_next - oldest) < 0) {
+        g_dump_next = oldest;
+    }
+    uint32_t first = g_dump_next;
+    while (count < USB_STREAM_TRACE_BATCH && g_dump_next != g_dump_end) {
+        if (!nsp_trace_read(g_dump_next, &batch[count])) {
+            // Overwritten while reading: restart the batch at the new oldest
+            count = 0;
+            g_dump_next = nsp_trace_oldest();
+            first = g_dump_next;
+            if ((int32_t)(g_dump_next - g_dump_end) >= 0) {
+                g_dump_next = g_dump_end;
+                first = g_dump_end;
+            }
+            continue;
+        }
+        count++;
+        g_dump_next++;
+    }
+
+    slip_writer_t w;
+    uint16_t crc;
+
+    frame_begin(&w, &crc);
+    put_byte(&w, &crc, USB_STREAM_FRAME_NSP_TRACE);
+    put_byte(&w, &crc, g_dump_reason);
+    put_byte(&w, &crc, (uint8_t)count);
+    put_byte(&w, &crc, 0);
+    put_u32(&w, &crc, first);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const nsp_trace_entry_t* e = &batch[i];
+        put_u32(&w, &crc, e->rx_us);
+        put_u32(&w, &crc, e->reply_us);
+        put_byte(&w, &crc, e->dest);
+        put_byte(&w, &crc, e->src);
+        put_byte(&w, &crc, e->ctrl);
+        put_byte(&w, &crc, e->outcome);
+        put_byte(&w, &crc, e->detail);
+        put_byte(&w, &crc, e->frame_len);
+        put_u16(&w, &crc, e->reply_len);
+    }
+    return frame_end(&w, crc);
+}
+
+/**
+ * @brief Frame the end-of-dump marker
+ *
+ * @return Encoded length in g_frame
+ */
+static size_t encode_trace_end_frame(void) {
+    slip_writer_t w;
+    uint16_t crc;
+
+    frame_begin(&w, &crc);
+    put_byte(&w, &crc, USB_STREAM_FRAME_NSP_TRACE_END);
+    put_byte(&w, &crc, g_dump_reason);
+    put_u16(&w, &crc, 0);
+    put_u32(&w, &crc, g_dump_first);
+    put_u32(&w, &crc, g_dump_end);
+    return frame_end(&w, crc);
+}
+
+/**
+ * @brief Frame up to USB_STREAM_REC_BATCH flight recorder samples
+ *
+ * Samples go tick by tick, wheel by wheel; the first sample number in the
+ * frame is tick_index * EMULATED_WHEEL_COUNT + wheel.
+ *
+ * @return Encoded length in g_frame
+ */
+static size_t encode_rec_frame(void) {
+    flight_rec_sample_t batch[USB_STREAM_REC_BATCH];
+    uint32_t first = g_rec_next;
+    uint32_t count = 0;
+
+    while (count < USB_STREAM_REC_BATCH && g_rec_next < g_rec_end) {
+        uint32_t tick_index = g_rec_next / EMULATED_WHEEL_COUNT;
+        uint8_t wheel = (uint8_t)(g_rec_next % EMULATED_WHEEL_COUNT);
+        if (!flight_rec_read(tick_index, wheel, &batch[count])) {
+            g_rec_next = g_rec_end;     // Re-armed mid-download
+            break;
+        }
+        count++;
+        g_rec_next++;
+    }
+
+    slip_writer_t w;
+    uint16_t crc;
+
+    frame_begin(&w, &crc);
+    put_byte(&w, &crc, USB_STREAM_FRAME_FLIGHT_REC);
+    put_byte(&w, &crc, (uint8_t)count);
+    put_u16(&w, &crc, 0);
+    put_u32(&w, &crc, first);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const flight_rec_sample_t* r = &batch[i];
+        put_u16(&w, &crc, (uint16_t)r->omega);
+        put_u16(&w, &crc, (uint16_t)r->current_cmd);
+        put_u16(&w, &crc, (uint16_t)r->current_out);
+        put_u16(&w, &crc, (uint16_t)r->torque);
+        put_u16(&w, &crc, (uint16_t)r->power);
+        put_u16(&w, &crc, r->fault_status);
+        put_u16(&w, &crc, r->fault_latch);
+        put_byte(&w, &crc, r->warning_status);
+        put_byte(&w, &crc, r->mode_flags);
+    }
+    return frame_end(&w, crc);
+}
+
+/**
+ * @brief Frame the end-of-capture marker (capture summary)
+ *
+ * @return Encoded length in g_frame
+ */
+static size_t encode_rec_end_frame(void) {
+    slip_writer_t w;
+    uint16_t crc;
+
+    frame_begin(&w, &crc);
+    put_byte(&w, &crc, USB_STREAM_FRAME_FLIGHT_REC_END);
+    put_byte(&w, &crc, g_rec_info.cause);
+    put_byte(&w, &crc, g_rec_info.wheel);
+    put_byte(&w, &crc, (uint8_t)EMULATED_WHEEL_COUNT);
+    put_u32(&w, &crc, g_rec_info.trigger_tick);
+    put_u32(&w, &crc, g_rec_info.ticks);
+    put_u32(&w, &crc, g_rec_info.pre_ticks);
+    put_u32(&w, &crc, PHYSICS_TICK_PERIOD_US);
+    return frame_end(&w, crc);
+}
+
+/**
+ * @brief Frame as many waiting capture records as fit one capture frame
+ *
+ * Records are moved out of the capture ring into a local batch first, so
+ * the ring space is handed back before the slower SLIP pass.
+ *
+ * @return Encoded length in g_frame (0 = nothing waiting)
+ */
+static size_t encode_capture_frame(void) {
+    uint8_t batch[USB_STREAM_CAPTURE_PAYLOAD];
+    uint32_t used = 0;
+    uint32_t count = 0;
+    bus_mon_record_t rec;
+
+    while (count < 0xFF && bus_mon_peek(&rec) &&
+           used + BUS_MON_RECORD_HEADER + rec.len <= sizeof(batch)) {
+        uint8_t* hdr = &batch[used];
+        for (uint32_t i = 0; i < 8; i++) {
+            hdr[i] = (uint8_t)(rec.timestamp_us >> (8 * i));
+        }
+        hdr[8] = rec.flags;
+        hdr[9] = rec.verdict;
+        hdr[10] = (uint8_t)rec.len;
+        hdr[11] = (uint8_t)(rec.len >> 8);
+        bus_mon_pop(&batch[used + BUS_MON_RECORD_HEADER]);
+        used += BUS_MON_RECORD_HEADER + rec.len;
+        count++;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    bus_mon_stats_t stats;
+    bus_mon_get_stats(&stats);
+
+    slip_writer_t w;
+    uint16_t crc;
+
+    frame_begin(&w, &crc);
+    put_byte(&w, &crc, USB_STREAM_FRAME_BUS_CAPTURE);
+    put_byte(&w, &crc, (uint8_t)count);
+    put_u16(&w, &crc, 0);
+    put_u32(&w, &crc, stats.dropped);
+    for (uint32_t i = 0; i < used; i++) {
+        put_byte(&w, &crc, batch[i]);
+    }
+    return frame_end(&w, crc);
+}
+
+// ============================================================================
+// Core0 Consumer (USB start-of-frame, every 1 ms)
+// ============================================================================
+
+/**
+ * @brief Send captured bus traffic (bus monitor on)
+ *
+ * Runs ahead of the dumps: capture records arrive at bus rate and the ring
+ * only covers a few hundred ms, while a dump can wait.
+ */
+static bool usb_stream_pump_capture(void) {
+    bool wrote = false;
+
+    while (tud_cdc_n_write_available(USB_STREAM_CDC_ITF) >= USB_STREAM_CAPTURE_MAX_FRAME) {
+        size_t len = encode_capture_frame();
+        if (len == 0) {
+            break;
+        }
+        tud_cdc_n_write(USB_STREAM_CDC_ITF, g_frame, (uint32_t)len);
+        g_capture_frames++;
+        g_bytes_sent += (uint32_t)len;
+        wrote = true;
+    }
+    return wrote;
+}
+
+/**
+ * @brief Send the next part of a requested flight recorder download
+ *
+ * Only a frozen capture is sent; a request while still recording waits.
+ */
+static bool usb_stream_pump_rec(void) {
+    bool wrote = false;
+
+    if (!g_rec_active) {
+        if (!g_rec_requested) {
+            return false;
+        }
+        flight_rec_get_info(&g_rec_info);
+        if (g_rec_info.state != FLIGHT_REC_FROZEN) {
+            return false;
+        }
+        g_rec_requested = false;
+        g_rec_next = 0;
+        g_rec_end = g_rec_info.ticks * EMULATED_WHEEL_COUNT;
+        g_rec_active = true;
+    }
+
+    while (tud_cdc_n_write_available(USB_STREAM_CDC_ITF) >= USB_STREAM_MAX_FRAME) {
+        size_t len;
+        if (g_rec_next >= g_rec_end) {
+            len = encode_rec_end_frame();
+            g_rec_active = false;
+            g_rec_downloads++;
+        } else {
+            len = encode_rec_frame();
+        }
+
+        tud_cdc_n_write(USB_STREAM_CDC_ITF, g_frame, (uint32_t)len);
+        g_bytes_sent += (uint32_t)len;
+        wrote = true;
+        if (!g_rec_active) {
+            break;
+        }
+    }
+    return wrote;
+}
+
+/**
+ * @brief Send the next part of a requested NSP trace dump
+ *
+ * A request is only taken while the host has the port open; the dump then
+ * shares the FIFO with telemetry frames until the end marker is out.
+ */
+static bool usb_stream_pump_trace(void) {
+    bool wrote = false;
+
+    if (!g_dump_active) {
+        if (!nsp_trace_take_dump_request(&g_dump_reason, &g_dump_end)) {
+            return false;
+        }
+        g_dump_first = nsp_trace_oldest();
+        if ((int32_t)(g_dump_first - g_dump_end) > 0) {
+            g_dump_first = g_dump_end;
+        }
+        g_dump_next = g_dump_first;
+        g_dump_active = true;
+    }
+
+    while (tud_cdc_n_write_available(USB_STREAM_CDC_ITF) >= USB_STREAM_MAX_FRAME) {
+        size_t len;
+        if (g_dump_next == g_dump_end) {
+            len = encode_trace_end_frame();
+            g_dump_active = false;
+            g_dumps_sent++;
+        } else {
+            len = encode_trace_frame();
+        }
+
+        tud_cdc_n_write(USB_STREAM_CDC_ITF, g_frame, (uint32_t)len);
+        g_bytes_sent += (uint32_t)len;
+        wrote = true;
+        if (!g_dump_active) {
+            break;
+        }
+    }
+    return wrote;
+}
+
+/**
+ * @brief Drain the ring into the CDC 1 FIFO
+ *
+ * A frame is only written when the FIFO has room for all of it, so the
+ * host never sees a torn frame; otherwise it stays in the ring for the
+ * next SOF and Core1 counts a drop if the ring fills up.
+ */
+static void usb_stream_pump(void) {
+    bool connected = tud_cdc_n_connected(USB_STREAM_CDC_ITF);
+    g_active = g_enabled && connected;
+
+    if (!connected) {
+        g_dump_active = false;      // Restarts from the next request
+        g_rec_active = false;
+        bus_mon_flush();
+    }
+
+    if (!g_active) {
+        g_ring_tail = g_ring_head;   // Discard anything queued before the port closed
+        if (connected) {
+            bool wrote = usb_stream_pump_capture();
+            wrote |= usb_stream_pump_trace();
+            wrote |= usb_stream_pump_rec();
+            if (wrote) {
+                tud_cdc_n_write_flush(USB_STREAM_CDC_ITF);
+            }
+        }
+        return;
+    }
+
+    uint32_t mask = g_field_mask;
+    bool wrote = false;
+
+    while (g_ring_tail != g_ring_head) {
+        __dmb();    // Read the entry after seeing the index that published it
+        uint32_t tail = g_ring_tail;
+        const telemetry_snapshot_t* s = &g_ring[tail & RING_MASK];
+        uint16_t seq = g_ring_seq[tail & RING_MASK];
+
+        // Worst-case frame must fit, so the encoded one always does
+        if (tud_cdc_n_write_available(USB_STREAM_CDC_ITF) < USB_STREAM_MAX_FRAME) {
+            break;
+        }
+
+        size_t len = encode_frame(s, seq, mask);
+        __dmb();    // Done reading the entry before releasing the slot
+        g_ring_tail = tail + 1;
+
+        tud_cdc_n_write(USB_STREAM_CDC_ITF, g_frame, (uint32_t)len);
+        g_frames_sent++;
+        g_bytes_sent += (uint32_t)len;
+        wrote = true;
+    }
+
+    // Capture and dumps get whatever room the telemetry left
+    wrote |= usb_stream_pump_capture();
+    wrote |= usb_stream_pump_trace();
+    wrote |= usb_stream_pump_rec();
+
+    if (wrote) {
+        tud_cdc_n_write_flush(USB_STREAM_CDC_ITF);
+    }
+}
+
+/**
+ * @brief TinyUSB start-of-frame callback (runs in tud_task() context)
+ */
+void tud_sof_cb(uint32_t frame_count) {
+    (void)frame_count;
+    usb_stream_pump();
+    usb_console_pump();
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+void usb_stream_init(void) {
+    g_ring_head = 0;
+    g_ring_tail = 0;
+    g_active = false;
+    tud_sof_cb_enable(true);
+}
+
+void usb_stream_set_enabled(bool enable) {
+    g_enabled = enable;
+}
+
+void usb_stream_set_field_mask(uint32_t mask) {
+    g_field_mask = mask & USB_STREAM_FIELDS_ALL;
+}
+
+void usb_stream_set_divider(uint32_t divider) {
+    g_divider = (divider == 0) ? 1 : divider;
+}
+
+void usb_stream_request_flight_rec(void) {
+    g_rec_requested = true;
+}
+
+void usb_stream_get_stats(usb_stream_stats_t* stats) {
+    stats->frames_sent = g_frames_sent;
+    stats->bytes_sent = g_bytes_sent;
+    stats->dropped_ring = g_dropped_ring;
+    stats->ring_high_water = g_ring_high_water;
+    stats->trace_dumps_sent = g_dumps_sent;
+    stats->rec_downloads = g_rec_downloads;
+    stats->capture_frames = g_capture_frames;
+    stats->connected = tud_cdc_n_connected(USB_STREAM_CDC_ITF);
+}
@@ -0,0 +1,220 @@
+/**
+ * @file usb_stream.h
+ * @brief Binary Telemetry Stream (USB CDC 1)
+ *
+ * Streams every physics tick's telemetry snapshot (or every Nth) to the
+ * host on the second USB-CDC interface, so a test rig can log the
+ * emulator's ground truth at the full tick rate without scraping the TUI.
+ *
+ * Core1 pushes snapshots into a lock-free SPSC ring right after publishing
+ * them; Core0 drains the ring from the USB start-of-frame callback (every
+ * 1 ms, inside tud_task()), so no main-loop latency is added and the
+ * console on CDC 0 is unaffected. Nothing is queued while the host port is
+ * closed (DTR low).
+ *
+ * Frame (SLIP encoded, little-endian):
+ *
+ *   off  size  field
+ *     0     1  type (USB_STREAM_FRAME_TELEMETRY)
+ *     1     1  wheel index
+ *     2     2  sequence (per queued snapshot; a gap = snapshots dropped)
+ *     4     4  physics tick count
+ *     8     8  snapshot timestamp (µs since boot)
+ *    16     4  field mask (USB_STREAM_F_* bits present)
+ *    20   4*n  one 32-bit value per mask bit, lowest bit first
+ *              (floats as IEEE-754 single, the rest as uint32)
+ *   end     2  CRC-16 CCITT over all preceding bytes
+ *
+ * The same port carries NSP trace dumps (util/nsp_trace.h), requested from
+ * the console or on a fault latch, in two more frame types:
+ *
+ *   USB_STREAM_FRAME_NSP_TRACE       USB_STREAM_FRAME_NSP_TRACE_END
+ *     0  1  type                       0  1  type
+ *     1  1  reason                     1  1  reason
+ *     2  1  entry count n              2  2  reserved (0)
+ *     3  1  reserved (0)               4  4  first index dumped
+ *     4  4  index of first entry       8  4  end index (exclusive)
+ *     8 16n nsp_trace_entry_t,        12  2  CRC-16
+ *           fields in order
+ *   end  2  CRC-16
+ *
+ * and flight recorder downloads (util/flight_rec.h), requested from the
+ * console once a capture is frozen:
+ *
+ *   USB_STREAM_FRAME_FLIGHT_REC      USB_STREAM_FRAME_FLIGHT_REC_END
+ *     0  1  type                       0  1  type
+ *     1  1  sample count n             1  1  trigger cause (FLIGHT_REC_TRIG_*)
+ *     2  2  reserved (0)               2  1  trigger wheel
+ *     4  4  first sample number        3  1  wheel count
+ *           (tick * wheels + wheel)    4  4  trigger physics tick
+ *     8 16n flight_rec_sample_t,       8  4  ticks in the capture
+ *           fields in order           12  4  ticks before the trigger tick
+ *   end  2  CRC-16                    16  4  tick period (µs)
+ *                                     20  2  CRC-16
+ *
+ * With the bus monitor on (util/bus_mon.h), captured RS-485 frames follow
+ * as soon as they are decoded, whether or not telemetry is enabled:
+ *
+ *   USB_STREAM_FRAME_BUS_CAPTURE
+ *     0  1  type
+ *     1  1  record count n
+ *     2  2  reserved (0)
+ *     4  4  records dropped so far (capture ring full)
+ *     8     n records, each:  0  8  timestamp (µs since boot)
+ *                             8  1  flags (BUS_MON_F_*)
+ *                             9  1  verdict (bus_mon_verdict_t)
+ *                            10  2  frame length m
+ *                            12  m  decoded frame (dest, src, ctrl, data, CRC)
+ *   end  2  CRC-16
+ */
+
+#ifndef USB_STREAM_H
+#define USB_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../util/core_sync.h"
+#include "../util/bus_mon.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+/** @brief CDC interface carrying the stream (0 is the console) */
+#define USB_STREAM_CDC_ITF          1
+
+/** @brief Snapshots buffered between Core1 and the USB pump (power of 2) */
+#define USB_STREAM_RING_DEPTH       64
+
+/** @brief Frame type bytes */
+#define USB_STREAM_FRAME_TELEMETRY      0x01
+#define USB_STREAM_FRAME_NSP_TRACE      0x02
+#define USB_STREAM_FRAME_NSP_TRACE_END  0x03
+#define USB_STREAM_FRAME_FLIGHT_REC     0x04
+#define USB_STREAM_FRAME_FLIGHT_REC_END 0x05
+#define USB_STREAM_FRAME_BUS_CAPTURE    0x06
+
+/** @brief NSP trace entries per dump frame (fits USB_STREAM_MAX_FRAME) */
+#define USB_STREAM_TRACE_BATCH          5
+
+/** @brief Flight recorder samples per download frame */
+#define USB_STREAM_REC_BATCH            5
+
+// ============================================================================
+// Field Selection
+// ============================================================================
+
+/**
+ * @brief Snapshot fields (bit index in the field mask)
+ */
+typedef enum {
+    USB_STREAM_F_OMEGA = 0,         // omega_rad_s (f32)
+    USB_STREAM_F_SPEED_RPM,         // speed_rpm (f32)
+    USB_STREAM_F_MOMENTUM,          // momentum_nms (f32)
+    USB_STREAM_F_CURRENT,           // current_a (f32)
+    USB_STREAM_F_TORQUE,            // torque_mnm (f32)
+    USB_STREAM_F_POWER,             // power_w (f32)
+    USB_STREAM_F_VOLTAGE,           // voltage_v (f32)
+    USB_STREAM_F_MODE,              // mode (u32)
+    USB_STREAM_F_DIRECTION,         // direction (u32)
+    USB_STREAM_F_FAULT_STATUS,      // fault_status (u32)
+    USB_STREAM_F_FAULT_LATCH,       // fault_latch (u32)
+    USB_STREAM_F_WARNING_STATUS,    // warning_status (u32)
+    USB_STREAM_F_LCL_TRIPPED,       // lcl_tripped (u32, 0/1)
+    USB_STREAM_F_JITTER,            // jitter_us (u32)
+    USB_STREAM_F_PHYSICS_US,        // physics_us (u32)
+    USB_STREAM_F_BUSY_US,           // busy_us (u32)
+    USB_STREAM_F_LOAD,              // load_permille (u32)
+    USB_STREAM_F_CURRENT_CMD,       // current_cmd_a (f32)
+    USB_STREAM_F_SPEED_CMD,         // speed_cmd_rpm (f32)
+    USB_STREAM_F_TORQUE_CMD,        // torque_cmd_mnm (f32)
+    USB_STREAM_F_PWM_DUTY,          // pwm_duty_pct (f32)
+    USB_STREAM_FIELD_COUNT
+} usb_stream_field_t;
+
+/** @brief Mask selecting every field */
+#define USB_STREAM_FIELDS_ALL       ((1u << USB_STREAM_FIELD_COUNT) - 1u)
+
+/** @brief Largest SLIP-encoded frame (all fields, every byte escaped) */
+#define USB_STREAM_MAX_FRAME        (2u * (20u + 4u * USB_STREAM_FIELD_COUNT + 2u) + 2u)
+
+/** @brief Record bytes per capture frame (one full-size frame, or several short ones) */
+#define USB_STREAM_CAPTURE_PAYLOAD  (BUS_MON_RECORD_HEADER + BUS_MON_SNAPLEN)
+
+/** @brief Largest SLIP-encoded capture frame */
+#define USB_STREAM_CAPTURE_MAX_FRAME (2u * (8u + USB_STREAM_CAPTURE_PAYLOAD + 2u) + 2u)
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+/**
+ * @brief Stream counters
+ */
+typedef struct {
+    uint32_t frames_sent;       // Frames queued to the USB FIFO
+    uint32_t bytes_sent;        // Encoded bytes queued
+    uint32_t dropped_ring;      // Snapshots lost: ring full (USB not draining)
+    uint32_t ring_high_water;   // Most snapshots waiting at once
+    uint32_t trace_dumps_sent;  // NSP trace dumps completed
+    uint32_t rec_downloads;     // Flight recorder downloads completed
+    uint32_t capture_frames;    // Bus capture frames sent
+    bool connected;             // Host has the port open (DTR)
+} usb_stream_stats_t;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * @brief Initialize the stream (Core0, after stdio_init_all())
+ *
+ * Enables the USB start-of-frame callback that drains the ring.
+ */
+void usb_stream_init(void);
+
+/**
+ * @brief Enable or disable streaming
+ *
+ * @param enable true to stream while the host port is open
+ */
+void usb_stream_set_enabled(bool enable);
+
+/**
+ * @brief Select the fields sent in each frame
+ *
+ * @param mask USB_STREAM_F_* bits (bits above USB_STREAM_FIELD_COUNT ignored)
+ */
+void usb_stream_set_field_mask(uint32_t mask);
+
+/**
+ * @brief Stream every Nth physics tick
+ *
+ * @param divider 1 = every tick (0 treated as 1)
+ */
+void usb_stream_set_divider(uint32_t divider);
+
+/**
+ * @brief Queue a snapshot for streaming (Core1, once per wheel per tick)
+ *
+ * Returns immediately when streaming is off or the host is not listening.
+ *
+ * @param snapshot Snapshot just published to Core0
+ */
+void usb_stream_core1_push(const telemetry_snapshot_t* snapshot);
+
+/**
+ * @brief Send the frozen flight recorder capture to the host
+ *
+ * Waits until the capture is frozen and the host has the port open.
+ */
+void usb_stream_request_flight_rec(void);
+
+/**
+ * @brief Get stream counters
+ *
+ * @param stats Output: counters
+ */
+void usb_stream_get_stats(usb_stream_stats_t* stats);
+
+#endif // USB_STREAM_H
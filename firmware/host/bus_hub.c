@@ -0,0 +1,328 @@
+/**
+ * @file bus_hub.c
+ * @brief NRWA-T6 Emulator - Virtual Multi-Drop RS-485 Bus (nrwa_bus)
+ *
+ * Joins any number of nodes into one shared bus: emulator instances
+ * (nrwa_t6_sil --bus tcp:HOST:PORT) and the flight software, over TCP or a
+ * PTY. Like the physical bus, every byte a node sends reaches every other
+ * node; address filtering is the receivers' job (NSP dest byte).
+ *
+ * Single-threaded and event-driven (epoll). A node that stops reading
+ * gets a bounded backlog and then loses bytes, counted per node - the bus
+ * never waits for a slow listener. Two nodes with a SLIP frame open at the
+ * same time count as a collision (on the wire both frames would be lost);
+ * the bytes are still forwarded unchanged.
+ *
+ * Usage:
+ *   nrwa_bus [--listen [HOST:]PORT] [--pty LINK]
+ *   nrwa_bus --listen 5485 --pty /tmp/nrwa_bus0   # FSW opens /tmp/nrwa_bus0
+ *
+ * SIGUSR1 prints per-node counters to stderr.
+ */
+
+#define _GNU_SOURCE
+
+#include "bus_transport.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
+/** Nodes on one bus (connections + PTY) */
+#define BUS_HUB_MAX_NODES       128
+
+/** Bytes queued for a node that is not keeping up */
+#define BUS_HUB_BACKLOG         4096
+
+/** Default TCP port */
+#define BUS_HUB_DEFAULT_PORT    "5485"
+
+#define SLIP_END                0xC0
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief One node on the bus
+ */
+typedef struct {
+    int fd;                     // -1 = free slot
+    bool is_pty;
+    bool in_frame;              // Inside a SLIP frame (data since the last END)
+    uint32_t id;                // Connection number (log only)
+    uint64_t rx_bytes;          // Sent by this node onto the bus
+    uint64_t tx_bytes;          // Delivered to this node
+    uint64_t dropped;           // Not delivered (backlog full)
+    size_t backlog_len;
+    uint8_t backlog[BUS_HUB_BACKLOG];   // Last: not cleared on reuse
+} bus_node_t;
+
+// ============================================================================
+// State
+// ============================================================================
+
+static bus_node_t nodes[BUS_HUB_MAX_NODES];
+static int epfd = -1;
+static int listen_fd = -1;
+static int signal_fd = -1;
+static uint32_t next_id = 1;
+static uint32_t open_frames = 0;        // Nodes with in_frame set
+static uint64_t collisions = 0;
+static bus_transport_t pty;
+
+// ============================================================================
+// Node Management
+// ============================================================================
+
+static void node_watch(bus_node_t* n, bool want_out) {
+    struct epoll_event ev = { .events = EPOLLIN | (want_out ? EPOLLOUT : 0) };
+    ev.data.ptr = n;
+    epoll_ctl(epfd, EPOLL_CTL_MOD, n->fd, &ev);
+}
+
+static bus_node_t* node_add(int fd, bool is_pty) {
+    for (size_t i = 0; i < BUS_HUB_MAX_NODES; i++) {
+        bus_node_t* n = &nodes[i];
+        if (n->fd >= 0) {
+            continue;
+        }
+        memset(n, 0, offsetof(bus_node_t, backlog));
+        n->fd = fd;
+        n->is_pty = is_pty;
+        n->id = next_id++;
+
+        struct epoll_event ev = { .events = EPOLLIN };
+        ev.data.ptr = n;
+        epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+        fprintf(stderr, "[BUS] Node %u joined (%s)\n", n->id, is_pty ? "pty" : "tcp");
+        return n;
+    }
+    fprintf(stderr, "[BUS] Bus full (%u nodes), connection refused\n", (unsigned)BUS_HUB_MAX_NODES);
+    close(fd);
+    return NULL;
+}
+
+static void node_remove(bus_node_t* n) {
+    fprintf(stderr, "[BUS] Node %u left (sent %llu, received %llu, dropped %llu bytes)\n", n->id,
+            (unsigned long long)n->rx_bytes, (unsigned long long)n->tx_bytes,
+            (unsigned long long)n->dropped);
+    if (n->in_frame) {
+        open_frames--;
+    }
+    epoll_ctl(epfd, EPOLL_CTL_DEL, n->fd, NULL);
+    close(n->fd);
+    n->fd = -1;
+}
+
+/**
+ * @brief Write the backlog out as far as the node accepts it
+ */
+static void node_flush(bus_node_t* n) {
+    while (n->backlog_len > 0) {
+        ssize_t w = write(n->fd, n->backlog, n->backlog_len);
+        if (w <= 0) {
+            break;
+        }
+        memmove(n->backlog, n->backlog + w, n->backlog_len - (size_t)w);
+        n->backlog_len -= (size_t)w;
+        n->tx_bytes += (uint64_t)w;
+    }
+    node_watch(n, n->backlog_len > 0);
+}
+
+/**
+ * @brief Deliver bytes to one node (direct write, then backlog, then drop)
+ */
+static void node_deliver(bus_node_t* n, const uint8_t* data, size_t len) {
+    if (n->backlog_len == 0) {
+        ssize_t w = write(n->fd, data, len);
+        if (w > 0) {
+            n->tx_bytes += (uint64_t)w;
+            data += w;
+            len -= (size_t)w;
+        }
+        if (len == 0) {
+            return;
+        }
+    }
+
+    size_t room = BUS_HUB_BACKLOG - n->backlog_len;
+    size_t take = (len < room) ? len : room;
+    memcpy(n->backlog + n->backlog_len, data, take);
+    n->backlog_len += take;
+    n->dropped += (uint64_t)(len - take);
+    node_watch(n, true);
+}
+
+/**
+ * @brief Track SLIP frame state of the sender (collision counting)
+ */
+static void node_track_frames(bus_node_t* n, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] == SLIP_END) {
+            if (n->in_frame) {
+                n->in_frame = false;
+                open_frames--;
+            }
+        } else if (!n->in_frame) {
+            if (open_frames > 0) {
+                collisions++;
+            }
+            n->in_frame = true;
+            open_frames++;
+        }
+    }
+}
+
+/**
+ * @brief Read from a node and put it on the bus
+ */
+static void node_receive(bus_node_t* n) {
+    uint8_t buf[2048];
+    ssize_t len = read(n->fd, buf, sizeof(buf));
+    if (len < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return;
+    }
+    if (len <= 0) {
+        if (!n->is_pty) {
+            node_remove(n);
+        }
+        return;     // PTY: flight software closed the port, stays on the bus
+    }
+
+    n->rx_bytes += (uint64_t)len;
+    node_track_frames(n, buf, (size_t)len);
+    for (size_t i = 0; i < BUS_HUB_MAX_NODES; i++) {
+        if (nodes[i].fd >= 0 && &nodes[i] != n) {
+            node_deliver(&nodes[i], buf, (size_t)len);
+        }
+    }
+}
+
+static void print_stats(void) {
+    fprintf(stderr, "[BUS] Collisions: %llu\n", (unsigned long long)collisions);
+    for (size_t i = 0; i < BUS_HUB_MAX_NODES; i++) {
+        const bus_node_t* n = &nodes[i];
+        if (n->fd >= 0) {
+            fprintf(stderr, "[BUS]   node %u (%s): sent %llu, received %llu, dropped %llu, queued %zu\n",
+                    n->id, n->is_pty ? "pty" : "tcp", (unsigned long long)n->rx_bytes,
+                    (unsigned long long)n->tx_bytes, (unsigned long long)n->dropped, n->backlog_len);
+        }
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [--listen [HOST:]PORT] [--pty LINK]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    const char* listen_spec = BUS_HUB_DEFAULT_PORT;
+    const char* pty_link = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--listen") == 0 && i + 1 < argc) {
+            listen_spec = argv[++i];
+        } else if (strcmp(argv[i], "--pty") == 0 && i + 1 < argc) {
+            pty_link = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    for (size_t i = 0; i < BUS_HUB_MAX_NODES; i++) {
+        nodes[i].fd = -1;
+    }
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+
+    listen_fd = bus_transport_bind(listen_spec, SOCK_STREAM);
+    if (listen_fd < 0) {
+        return 1;
+    }
+    fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+    struct epoll_event ev = { .events = EPOLLIN };
+    ev.data.ptr = &listen_fd;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, listen_fd, &ev);
+
+    if (pty_link) {
+        char spec[128];
+        snprintf(spec, sizeof(spec), "pty:%s", pty_link);
+        if (!bus_transport_open(&pty, spec)) {
+            return 1;
+        }
+        node_add(pty.in_fd, true);
+    }
+
+    // Signals as events: stop on INT/TERM, counters on USR1
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    sigaddset(&mask, SIGUSR1);
+    sigprocmask(SIG_BLOCK, &mask, NULL);
+    signal(SIGPIPE, SIG_IGN);
+    signal_fd = signalfd(-1, &mask, SFD_CLOEXEC);
+    ev.data.ptr = &signal_fd;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, signal_fd, &ev);
+
+    fprintf(stderr, "[BUS] Listening on %s\n", listen_spec);
+
+    bool running = true;
+    while (running) {
+        struct epoll_event events[32];
+        int count = epoll_wait(epfd, events, 32, -1);
+        if (count < 0 && errno != EINTR) {
+            break;
+        }
+
+        for (int e = 0; e < count; e++) {
+            void* ptr = events[e].data.ptr;
+            if (ptr == &listen_fd) {
+                int fd;
+                while ((fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC | SOCK_NONBLOCK)) >= 0) {
+                    node_add(fd, false);
+                }
+            } else if (ptr == &signal_fd) {
+                struct signalfd_siginfo si;
+                if (read(signal_fd, &si, sizeof(si)) == sizeof(si)) {
+                    if (si.ssi_signo == SIGUSR1) {
+                        print_stats();
+                    } else {
+                        running = false;
+                    }
+                }
+            } else {
+                bus_node_t* n = ptr;
+                if (n->fd >= 0 && (events[e].events & EPOLLOUT)) {
+                    node_flush(n);
+                }
+                if (n->fd >= 0 && (events[e].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+                    node_receive(n);
+                }
+            }
+        }
+    }
+
+    print_stats();
+    for (size_t i = 0; i < BUS_HUB_MAX_NODES; i++) {
+        if (nodes[i].fd >= 0 && !nodes[i].is_pty) {
+            close(nodes[i].fd);
+        }
+    }
+    if (pty_link) {
+        bus_transport_close(&pty);
+    }
+    close(listen_fd);
+    return 0;
+}
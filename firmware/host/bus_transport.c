@@ -0,0 +1,394 @@
+/**
+ * @file bus_transport.c
+ * @brief Host HAL: Byte Transports for the Virtual RS-485 Bus
+ */
+
+#define _GNU_SOURCE
+
+#include "bus_transport.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <termios.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/serial.h>
+#include <sys/ioctl.h>
+#endif
+
+/** Longest a socket write may stall before the rest is dropped (ms) */
+#define BUS_TRANSPORT_SEND_TIMEOUT_MS   10
+
+/** Serial port rate when the endpoint names none (the NSP bus rate) */
+#define BUS_TRANSPORT_SERIAL_BAUD       460800
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void set_nonblocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+static void set_send_timeout(int fd) {
+    struct timeval tv = { .tv_sec = 0, .tv_usec = BUS_TRANSPORT_SEND_TIMEOUT_MS * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+static void set_nodelay(int fd) {
+    // Frames are small and latency-sensitive: no Nagle batching
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+/**
+ * @brief Split "HOST:PORT" (HOST may be empty) and resolve it
+ */
+static struct addrinfo* resolve(const char* hostport, int socktype, bool passive) {
+    char host[256];
+    const char* colon = strrchr(hostport, ':');
+    const char* port = hostport;
+    host[0] = '\0';
+    if (colon) {
+        size_t n = (size_t)(colon - hostport);
+        if (n >= sizeof(host)) {
+            return NULL;
+        }
+        memcpy(host, hostport, n);
+        host[n] = '\0';
+        port = colon + 1;
+    }
+
+    struct addrinfo hints = { 0 };
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = socktype;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+
+    struct addrinfo* res = NULL;
+    int rc = getaddrinfo(host[0] ? host : NULL, port, &hints, &res);
+    if (rc != 0) {
+        fprintf(stderr, "[BUS] Cannot resolve %s: %s\n", hostport, gai_strerror(rc));
+        return NULL;
+    }
+    return res;
+}
+
+int bus_transport_bind(const char* hostport, int socktype) {
+    struct addrinfo* res = resolve(hostport, socktype, true);
+    if (!res) {
+        return -1;
+    }
+    int fd = -1;
+    for (struct addrinfo* ai = res; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 &&
+            (socktype != SOCK_STREAM || listen(fd, SOMAXCONN) == 0)) {
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    if (fd < 0) {
+        fprintf(stderr, "[BUS] Cannot bind %s: %s\n", hostport, strerror(errno));
+    }
+    return fd;
+}
+
+static int open_connected(const char* hostport) {
+    struct addrinfo* res = resolve(hostport, SOCK_STREAM, false);
+    if (!res) {
+        return -1;
+    }
+    int fd = -1;
+    for (struct addrinfo* ai = res; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    if (fd < 0) {
+        fprintf(stderr, "[BUS] Cannot connect to %s: %s\n", hostport, strerror(errno));
+    }
+    return fd;
+}
+
+static bool open_pty(bus_transport_t* t, const char* link) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        fprintf(stderr, "[BUS] Cannot create PTY: %s\n", strerror(errno));
+        if (master >= 0) {
+            close(master);
+        }
+        return false;
+    }
+    const char* slave_name = ptsname(master);
+
+    // Keep a slave descriptor open ourselves: the master then never reports
+    // hangup while flight software is not attached. Raw mode, no echo.
+    int slave = open(slave_name, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (slave >= 0) {
+        struct termios tio;
+        if (tcgetattr(slave, &tio) == 0) {
+            cfmakeraw(&tio);
+            tcsetattr(slave, TCSANOW, &tio);
+        }
+    }
+
+    if (link && link[0]) {
+        unlink(link);
+        if (symlink(slave_name, link) != 0) {
+            fprintf(stderr, "[BUS] Cannot link %s -> %s: %s\n", link, slave_name, strerror(errno));
+        } else {
+            snprintf(t->link, sizeof(t->link), "%s", link);
+        }
+    }
+    fprintf(stderr, "[BUS] PTY %s%s%s\n", slave_name, t->link[0] ? " at " : "", t->link);
+
+    set_nonblocking(master);
+    t->in_fd = master;
+    t->out_fd = master;
+    t->listen_fd = slave;   // Only held open, never watched
+    return true;
+}
+
+static speed_t serial_speed(unsigned long baud) {
+    static const struct { unsigned long baud; speed_t speed; } speeds[] = {
+        { 9600, B9600 }, { 19200, B19200 }, { 38400, B38400 }, { 57600, B57600 },
+        { 115200, B115200 }, { 230400, B230400 }, { 460800, B460800 },
+        { 921600, B921600 },
+    };
+    for (size_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++) {
+        if (speeds[i].baud == baud) {
+            return speeds[i].speed;
+        }
+    }
+    return B0;
+}
+
+static bool open_serial(bus_transport_t* t, const char* spec) {
+    char dev[256];
+    unsigned long baud = BUS_TRANSPORT_SERIAL_BAUD;
+    snprintf(dev, sizeof(dev), "%s", spec);
+    char* colon = strrchr(dev, ':');
+    if (colon) {
+        baud = strtoul(colon + 1, NULL, 10);
+        *colon = '\0';
+    }
+    speed_t speed = serial_speed(baud);
+    if (speed == B0) {
+        fprintf(stderr, "[BUS] Unsupported serial rate %lu\n", baud);
+        return false;
+    }
+
+    int fd = open(dev, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    struct termios tio;
+    if (fd < 0 || tcgetattr(fd, &tio) != 0) {
+        fprintf(stderr, "[BUS] Cannot open %s: %s\n", dev, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+
+    // Raw 8-N-1, no flow control, reads return whatever has arrived
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+        fprintf(stderr, "[BUS] Cannot configure %s: %s\n", dev, strerror(errno));
+        close(fd);
+        return false;
+    }
+
+#ifdef __linux__
+    // Hand bytes up as they arrive instead of batching them (USB adapters
+    // otherwise hold a short reply for their latency timer, 16 ms on FTDI)
+    struct serial_struct ss;
+    if (ioctl(fd, TIOCGSERIAL, &ss) == 0) {
+        ss.flags |= ASYNC_LOW_LATENCY;
+        ioctl(fd, TIOCSSERIAL, &ss);
+    }
+#endif
+    tcflush(fd, TCIOFLUSH);
+
+    fprintf(stderr, "[BUS] Serial %s at %lu baud\n", dev, baud);
+    t->in_fd = fd;
+    t->out_fd = fd;
+    return true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool bus_transport_open(bus_transport_t* t, const char* spec) {
+    memset(t, 0, sizeof(*t));
+    t->in_fd = -1;
+    t->out_fd = -1;
+    t->listen_fd = -1;
+
+    if (!spec || strcmp(spec, "stdio") == 0) {
+        t->kind = BUS_TRANSPORT_STDIO;
+        t->in_fd = STDIN_FILENO;
+        t->out_fd = dup(STDOUT_FILENO);
+        return t->out_fd >= 0;
+    }
+    if (strncmp(spec, "tcp:", 4) == 0) {
+        t->kind = BUS_TRANSPORT_TCP;
+        t->in_fd = open_connected(spec + 4);
+        if (t->in_fd < 0) {
+            return false;
+        }
+        set_nodelay(t->in_fd);
+        set_send_timeout(t->in_fd);
+        t->out_fd = t->in_fd;
+        return true;
+    }
+    if (strncmp(spec, "tcp-listen:", 11) == 0) {
+        t->kind = BUS_TRANSPORT_TCP_LISTEN;
+        t->listen_fd = bus_transport_bind(spec + 11, SOCK_STREAM);
+        if (t->listen_fd < 0) {
+            return false;
+        }
+        set_nonblocking(t->listen_fd);
+        return true;
+    }
+    if (strncmp(spec, "udp:", 4) == 0) {
+        t->kind = BUS_TRANSPORT_UDP;
+        t->in_fd = bus_transport_bind(spec + 4, SOCK_DGRAM);
+        t->out_fd = t->in_fd;
+        return t->in_fd >= 0;
+    }
+    if (strcmp(spec, "pty") == 0 || strncmp(spec, "pty:", 4) == 0) {
+        t->kind = BUS_TRANSPORT_PTY;
+        return open_pty(t, spec[3] == ':' ? spec + 4 : NULL);
+    }
+
+    if (strncmp(spec, "serial:", 7) == 0) {
+        t->kind = BUS_TRANSPORT_SERIAL;
+        return open_serial(t, spec + 7);
+    }
+
+    fprintf(stderr, "[BUS] Unknown endpoint '%s' (stdio, tcp:HOST:PORT, tcp-listen:PORT, udp:PORT, pty[:LINK],\n"
+                    "      serial:DEV[:BAUD])\n", spec);
+    return false;
+}
+
+int bus_transport_fd(const bus_transport_t* t) {
+    if (t->kind == BUS_TRANSPORT_TCP_LISTEN && t->in_fd < 0) {
+        return t->listen_fd;
+    }
+    return t->in_fd;
+}
+
+ssize_t bus_transport_read(bus_transport_t* t, uint8_t* buf, size_t cap) {
+    if (t->kind == BUS_TRANSPORT_TCP_LISTEN && t->in_fd < 0) {
+        int fd = accept4(t->listen_fd, NULL, NULL, SOCK_CLOEXEC);
+        if (fd < 0) {
+            return 0;
+        }
+        set_nodelay(fd);
+        set_send_timeout(fd);
+        t->in_fd = fd;
+        t->out_fd = fd;
+        fprintf(stderr, "[BUS] Peer connected\n");
+        return BUS_TRANSPORT_FD_CHANGED;
+    }
+
+    ssize_t n;
+    if (t->kind == BUS_TRANSPORT_UDP) {
+        t->peer_len = sizeof(t->peer);
+        n = recvfrom(t->in_fd, buf, cap, MSG_DONTWAIT, (struct sockaddr*)&t->peer, &t->peer_len);
+    } else {
+        n = read(t->in_fd, buf, cap);
+    }
+
+    if (n > 0) {
+        return n;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return 0;
+    }
+    if (n == 0 && t->kind == BUS_TRANSPORT_SERIAL) {
+        return 0;   // VMIN 0: nothing received yet
+    }
+    if (t->kind == BUS_TRANSPORT_PTY || t->kind == BUS_TRANSPORT_UDP) {
+        return 0;   // PTY peer went away (EIO): wait for the next open
+    }
+    if (t->kind == BUS_TRANSPORT_TCP_LISTEN) {
+        fprintf(stderr, "[BUS] Peer disconnected\n");
+        close(t->in_fd);
+        t->in_fd = -1;
+        t->out_fd = -1;
+        return BUS_TRANSPORT_FD_CHANGED;
+    }
+    return -1;
+}
+
+void bus_transport_write(bus_transport_t* t, const uint8_t* data, size_t len) {
+    if (t->out_fd < 0 || (t->kind == BUS_TRANSPORT_UDP && t->peer_len == 0)) {
+        t->tx_dropped += (uint32_t)len;
+        return;
+    }
+    if (t->kind == BUS_TRANSPORT_UDP) {
+        if (sendto(t->out_fd, data, len, MSG_DONTWAIT, (const struct sockaddr*)&t->peer, t->peer_len) < 0) {
+            t->tx_dropped += (uint32_t)len;
+        }
+        return;
+    }
+
+    while (len > 0) {
+        ssize_t n = (t->kind == BUS_TRANSPORT_STDIO || t->kind == BUS_TRANSPORT_PTY ||
+                     t->kind == BUS_TRANSPORT_SERIAL)
+                        ? write(t->out_fd, data, len)
+                        : send(t->out_fd, data, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            t->tx_dropped += (uint32_t)len;   // Timed out, full or gone
+            return;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+void bus_transport_close(bus_transport_t* t) {
+    if (t->out_fd >= 0 && t->out_fd != t->in_fd) {
+        close(t->out_fd);
+    }
+    if (t->in_fd >= 0 && t->kind != BUS_TRANSPORT_STDIO) {
+        close(t->in_fd);
+    }
+    if (t->listen_fd >= 0) {
+        close(t->listen_fd);
+    }
+    if (t->link[0]) {
+        unlink(t->link);
+    }
+    t->in_fd = t->out_fd = t->listen_fd = -1;
+    t->link[0] = '\0';
+}
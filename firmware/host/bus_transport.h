@@ -0,0 +1,124 @@
+/**
+ * @file bus_transport.h
+ * @brief Host HAL: Byte Transports for the Virtual RS-485 Bus
+ *
+ * Carries the raw SLIP byte stream of the RS-485 bus between an emulator
+ * instance and the outside world. Selected by an endpoint string:
+ *
+ *   stdio              stdin in, stdout out (default)
+ *   tcp:HOST:PORT      connect to a bus hub (nrwa_bus) or a TCP server
+ *   tcp-listen:PORT    accept one peer at a time (reconnects are accepted)
+ *   udp:PORT           bind PORT; replies go to the last sender
+ *   pty[:LINK]         create a pseudo-terminal, optionally symlinked at
+ *                      LINK, that flight software opens like a serial port
+ *   serial:DEV[:BAUD]  a real serial port (USB-RS485 adapter), raw 8-N-1
+ *                      at BAUD (default 460800) with the driver's
+ *                      low-latency mode on
+ *
+ * Everything is non-blocking: the owner watches bus_transport_fd() with
+ * epoll and calls bus_transport_read() when it is readable. Bytes are bytes
+ * on every transport; frame boundaries come from SLIP, not from packets
+ * (a UDP datagram may hold several frames or part of one).
+ */
+
+#ifndef BUS_TRANSPORT_H
+#define BUS_TRANSPORT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+
+/**
+ * @brief Transport kinds
+ */
+typedef enum {
+    BUS_TRANSPORT_STDIO = 0,
+    BUS_TRANSPORT_TCP,          // Connected client
+    BUS_TRANSPORT_TCP_LISTEN,   // Server, one peer at a time
+    BUS_TRANSPORT_UDP,
+    BUS_TRANSPORT_PTY,
+    BUS_TRANSPORT_SERIAL,
+} bus_transport_kind_t;
+
+/**
+ * @brief Open transport
+ */
+typedef struct {
+    bus_transport_kind_t kind;
+    int in_fd;                      // Read side (-1 while a listener has no peer)
+    int out_fd;                     // Write side (same as in_fd except for stdio)
+    int listen_fd;                  // TCP listener (-1 otherwise)
+    struct sockaddr_storage peer;   // UDP: last sender
+    socklen_t peer_len;             // UDP: 0 until the first datagram
+    char link[108];                 // PTY: symlink to remove on close ("" = none)
+    uint32_t tx_dropped;            // Bytes not written (no peer, peer too slow)
+} bus_transport_t;
+
+/**
+ * @brief Open an endpoint
+ *
+ * @param t Transport to fill in
+ * @param spec Endpoint string (see file comment)
+ * @return false with a message on stderr if the spec is invalid or the
+ *         endpoint cannot be opened
+ */
+bool bus_transport_open(bus_transport_t* t, const char* spec);
+
+/**
+ * @brief Get the descriptor to watch for input
+ *
+ * Changes when a listener accepts or loses its peer: re-register after
+ * every bus_transport_read() that returns BUS_TRANSPORT_FD_CHANGED.
+ *
+ * @param t Transport
+ * @return File descriptor (listener or connection)
+ */
+int bus_transport_fd(const bus_transport_t* t);
+
+/** bus_transport_read(): watched descriptor changed (accept or peer loss) */
+#define BUS_TRANSPORT_FD_CHANGED    (-2)
+
+/**
+ * @brief Read what is available (call when bus_transport_fd() is readable)
+ *
+ * @param t Transport
+ * @param buf Output buffer
+ * @param cap Buffer size
+ * @return Bytes read (0 = nothing yet), BUS_TRANSPORT_FD_CHANGED, or -1
+ *         when the bus is gone for good (EOF on stdio or a TCP client)
+ */
+ssize_t bus_transport_read(bus_transport_t* t, uint8_t* buf, size_t cap);
+
+/**
+ * @brief Write bytes to the bus
+ *
+ * Never blocks for long: bytes that cannot be written (no peer yet, peer
+ * not reading) are dropped and counted, as on a wire.
+ *
+ * @param t Transport
+ * @param data Bytes
+ * @param len Byte count
+ */
+void bus_transport_write(bus_transport_t* t, const uint8_t* data, size_t len);
+
+/**
+ * @brief Open a bound socket (listening, for SOCK_STREAM)
+ *
+ * Shared with the bus hub, which accepts many peers on one port.
+ *
+ * @param hostport "[HOST:]PORT" (no HOST = all interfaces)
+ * @param socktype SOCK_STREAM or SOCK_DGRAM
+ * @return Socket, or -1 with a message on stderr
+ */
+int bus_transport_bind(const char* hostport, int socktype);
+
+/**
+ * @brief Close the transport (removes a PTY link)
+ *
+ * @param t Transport
+ */
+void bus_transport_close(bus_transport_t* t);
+
+#endif // BUS_TRANSPORT_H
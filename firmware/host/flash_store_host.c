@@ -0,0 +1,123 @@
+/**
+ * @file flash_store_host.c
+ * @brief Host HAL: Flash Erase/Program Service on a RAM Image
+ *
+ * Same contract as util/flash_store.c (sector-aligned offsets, erase then
+ * program, 0xFF padding; page programs only clear bits). There is no XIP
+ * to protect, so Core1 is never parked and flash_store_core1_poll()
+ * returns at once.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "flash_store_host.h"
+#include "util/flash_store.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+uint8_t flash_store_host_image[FLASH_STORE_FLASH_SIZE];
+
+static flash_store_stats_t stats;
+static int image_fd = -1;
+
+__attribute__((constructor))
+static void flash_store_host_erase_all(void) {
+    memset(flash_store_host_image, 0xFF, sizeof(flash_store_host_image));
+}
+
+// ============================================================================
+// Host API
+// ============================================================================
+
+bool flash_store_host_attach(const char* path) {
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    ssize_t got = pread(fd, flash_store_host_image, sizeof(flash_store_host_image), 0);
+    if (got < 0) {
+        close(fd);
+        return false;
+    }
+    printf("[FLASH] Image %s (%ld bytes loaded)\n", path, (long)got);
+
+    if (image_fd >= 0) {
+        close(image_fd);
+    }
+    image_fd = fd;
+    return true;
+}
+
+// ============================================================================
+// Core0 API
+// ============================================================================
+
+bool flash_store_write(uint32_t offset, const void* data, size_t len) {
+    if ((offset % FLASH_STORE_SECTOR_SIZE) != 0 || (len > 0 && data == NULL)) {
+        stats.failures++;
+        return false;
+    }
+
+    size_t erase_len = (len == 0) ? FLASH_STORE_SECTOR_SIZE :
+                       (len + FLASH_STORE_SECTOR_SIZE - 1) & ~(size_t)(FLASH_STORE_SECTOR_SIZE - 1);
+    if (offset + erase_len > FLASH_STORE_FLASH_SIZE) {
+        stats.failures++;
+        return false;
+    }
+
+    memset(&flash_store_host_image[offset], 0xFF, erase_len);
+    if (len > 0) {
+        memcpy(&flash_store_host_image[offset], data, len);
+    }
+
+    if (image_fd >= 0 &&
+        pwrite(image_fd, &flash_store_host_image[offset], erase_len, (off_t)offset) !=
+            (ssize_t)erase_len) {
+        printf("[FLASH] WARNING: Image write-through failed at 0x%06X\n", (unsigned)offset);
+    }
+
+    stats.last_park_us = 0;
+    stats.writes++;
+    return true;
+}
+
+bool flash_store_program(uint32_t offset, const void* data, size_t len) {
+    if ((offset % FLASH_STORE_PAGE_SIZE) != 0 || (len % FLASH_STORE_PAGE_SIZE) != 0 ||
+        len == 0 || data == NULL || offset + len > FLASH_STORE_FLASH_SIZE) {
+        stats.failures++;
+        return false;
+    }
+
+    // NOR programming only clears bits
+    const uint8_t* src = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        flash_store_host_image[offset + i] &= src[i];
+    }
+
+    if (image_fd >= 0 &&
+        pwrite(image_fd, &flash_store_host_image[offset], len, (off_t)offset) != (ssize_t)len) {
+        printf("[FLASH] WARNING: Image write-through failed at 0x%06X\n", (unsigned)offset);
+    }
+
+    stats.last_park_us = 0;
+    stats.writes++;
+    return true;
+}
+
+void flash_store_get_stats(flash_store_stats_t* out) {
+    if (out) *out = stats;
+}
+
+// ============================================================================
+// Core1 API
+// ============================================================================
+
+void flash_store_core1_poll(void) {
+}
@@ -0,0 +1,23 @@
+/**
+ * @file flash_store_host.h
+ * @brief Host HAL: File-Backed Flash Image
+ */
+
+#ifndef FLASH_STORE_HOST_H
+#define FLASH_STORE_HOST_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Back the flash image with a file
+ *
+ * Loads the file (a missing or short file reads as erased flash) and
+ * writes every later erase/program through to it, so the scenario library
+ * and cached test results survive restarts like on the board.
+ *
+ * @param path Image file
+ * @return false if the file cannot be opened
+ */
+bool flash_store_host_attach(const char* path);
+
+#endif // FLASH_STORE_HOST_H
@@ -0,0 +1,72 @@
+/**
+ * @file hal_host.c
+ * @brief Host HAL: Time Base and Register Stand-ins
+ *
+ * time_us_64() counts from process start on CLOCK_MONOTONIC, like the
+ * RP2040 timer counts from reset.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "pico/time.h"
+#include "pico/platform.h"
+#include "hardware/dma.h"
+#include <errno.h>
+#include <time.h>
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+static uint64_t boot_ns = 0;
+
+// Never touched (no DMA channel is ever claimed on the host)
+static dma_hw_t host_dma_regs;
+dma_hw_t* const dma_hw = &host_dma_regs;
+
+__thread uint host_core_num = 0;
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+__attribute__((constructor))
+static void hal_host_boot(void) {
+    boot_ns = monotonic_ns();
+}
+
+// ============================================================================
+// Time
+// ============================================================================
+
+uint64_t time_us_64(void) {
+    return (monotonic_ns() - boot_ns) / 1000u;
+}
+
+void sleep_until(absolute_time_t t) {
+    uint64_t ns = boot_ns + t * 1000u;
+    struct timespec ts = {
+        .tv_sec = (time_t)(ns / 1000000000u),
+        .tv_nsec = (long)(ns % 1000000000u),
+    };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+        // Interrupted by a signal: sleep the rest
+    }
+}
+
+void sleep_us(uint64_t us) {
+    sleep_until(time_us_64() + us);
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+void busy_wait_us(uint64_t us) {
+    uint64_t end = time_us_64() + us;
+    while (time_us_64() < end) {
+        // Spin (timing-sensitive callers only)
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file dma.h
+ * @brief Host HAL: DMA API (no channels on the host)
+ *
+ * dma_claim_unused_channel() finds no channel, so the CRC driver keeps to
+ * its table backend. The remaining calls are never reached.
+ */
+
+#ifndef HOST_HARDWARE_DMA_H
+#define HOST_HARDWARE_DMA_H
+
+#include "pico/types.h"
+
+#define DMA_SIZE_8                          0
+#define DMA_SIZE_16                         1
+#define DMA_SIZE_32                         2
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC16R    0x3
+
+typedef struct {
+    uint32_t ctrl;
+} dma_channel_config;
+
+typedef struct {
+    volatile uint32_t sniff_ctrl;
+    volatile uint32_t sniff_data;
+} dma_hw_t;
+
+extern dma_hw_t* const dma_hw;
+
+static inline int dma_claim_unused_channel(bool required) {
+    (void)required;
+    return -1;
+}
+
+static inline dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    dma_channel_config c = { 0 };
+    return c;
+}
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config* c, uint size) {
+    (void)c; (void)size;
+}
+
+static inline void channel_config_set_read_increment(dma_channel_config* c, bool incr) {
+    (void)c; (void)incr;
+}
+
+static inline void channel_config_set_write_increment(dma_channel_config* c, bool incr) {
+    (void)c; (void)incr;
+}
+
+static inline void channel_config_set_sniff_enable(dma_channel_config* c, bool sniff) {
+    (void)c; (void)sniff;
+}
+
+static inline void dma_channel_configure(uint channel, const dma_channel_config* config,
+                                         volatile void* write_addr, const volatile void* read_addr,
+                                         uint transfer_count, bool trigger) {
+    (void)channel; (void)config; (void)write_addr; (void)read_addr;
+    (void)transfer_count; (void)trigger;
+}
+
+static inline void dma_channel_transfer_from_buffer_now(uint channel, const volatile void* read_addr,
+                                                        uint32_t transfer_count) {
+    (void)channel; (void)read_addr; (void)transfer_count;
+}
+
+static inline void dma_channel_wait_for_finish_blocking(uint channel) {
+    (void)channel;
+}
+
+static inline void dma_sniffer_enable(uint channel, uint mode, bool force_channel_enable) {
+    (void)channel; (void)mode; (void)force_channel_enable;
+}
+
+static inline void dma_sniffer_disable(void) {}
+
+#endif // HOST_HARDWARE_DMA_H
@@ -0,0 +1,43 @@
+/**
+ * @file irq.h
+ * @brief Host HAL: NVIC API (no interrupts on the host)
+ *
+ * user_irq_claim_unused() finds no free IRQ, so the NSP handler stays in
+ * polled mode and the scenario doorbell is never armed; the host main
+ * loop calls nsp_handler_poll() and scenario_update() instead.
+ */
+
+#ifndef HOST_HARDWARE_IRQ_H
+#define HOST_HARDWARE_IRQ_H
+
+#include "pico/types.h"
+
+typedef void (*irq_handler_t)(void);
+
+#define SIO_IRQ_PROC0               15
+#define SIO_IRQ_PROC1               16
+#define PICO_LOWEST_IRQ_PRIORITY    0xFF
+#define PICO_HIGHEST_IRQ_PRIORITY   0x00
+
+static inline int user_irq_claim_unused(bool required) {
+    (void)required;
+    return -1;
+}
+
+static inline void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    (void)num; (void)handler;
+}
+
+static inline void irq_set_enabled(uint num, bool enabled) {
+    (void)num; (void)enabled;
+}
+
+static inline void irq_set_priority(uint num, uint8_t priority) {
+    (void)num; (void)priority;
+}
+
+static inline void irq_set_pending(uint num) {
+    (void)num;
+}
+
+#endif // HOST_HARDWARE_IRQ_H
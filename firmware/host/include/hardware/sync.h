@@ -0,0 +1,51 @@
+/**
+ * @file sync.h
+ * @brief Host HAL: barriers and interrupt masking
+ *
+ * The two emulated cores are threads. __dmb() is a full fence, so the
+ * lock-free Core0/Core1 handoffs keep their ordering guarantees; SEV/WFE
+ * become a yield. Interrupt masking only ever guards against same-core
+ * ISRs, and the host build has none, so it is a no-op.
+ */
+
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include <sched.h>
+#include "pico/types.h"
+
+static inline void __dmb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __dsb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __mem_fence_acquire(void) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
+static inline void __mem_fence_release(void) {
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void __sev(void) {}
+
+static inline void __wfe(void) {
+    sched_yield();
+}
+
+static inline void __wfi(void) {
+    sched_yield();
+}
+
+static inline uint32_t save_and_disable_interrupts(void) {
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+    (void)status;
+}
+
+#endif // HOST_HARDWARE_SYNC_H
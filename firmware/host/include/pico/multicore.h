@@ -0,0 +1,33 @@
+/**
+ * @file multicore.h
+ * @brief Host HAL: inter-core FIFO (not modelled)
+ *
+ * The FIFO only carries the scenario doorbell. It reports itself full and
+ * empty, so Core1 sets its condition-hit bits without ringing and Core0's
+ * scenario_update() picks them up on its next pass.
+ */
+
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+#include "pico/types.h"
+
+static inline bool multicore_fifo_wready(void) {
+    return false;
+}
+
+static inline bool multicore_fifo_rvalid(void) {
+    return false;
+}
+
+static inline void multicore_fifo_push_blocking(uint32_t data) {
+    (void)data;
+}
+
+static inline uint32_t multicore_fifo_pop_blocking(void) {
+    return 0;
+}
+
+static inline void multicore_fifo_clear_irq(void) {}
+
+#endif // HOST_PICO_MULTICORE_H
@@ -0,0 +1,38 @@
+/**
+ * @file platform.h
+ * @brief Host HAL: Pico SDK section and barrier macros
+ *
+ * RAM-placement attributes have no meaning on the host and expand to the
+ * plain declaration.
+ */
+
+#ifndef HOST_PICO_PLATFORM_H
+#define HOST_PICO_PLATFORM_H
+
+#include "pico/types.h"
+
+#define __not_in_flash(group)
+#define __not_in_flash_func(func_name)      func_name
+#define __time_critical_func(func_name)     func_name
+#define __no_inline_not_in_flash_func(func_name) __attribute__((noinline)) func_name
+#define __scratch_x(group)
+#define __scratch_y(group)
+#define __uninitialized_ram(name)           name
+#define __force_inline                      inline __attribute__((always_inline))
+
+#define __compiler_memory_barrier()         __asm__ volatile("" ::: "memory")
+
+#ifndef count_of
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#endif
+
+static inline void tight_loop_contents(void) {}
+
+/** Emulated core of the calling thread (the physics tick thread is core 1) */
+extern __thread uint host_core_num;
+
+static inline uint get_core_num(void) {
+    return host_core_num;
+}
+
+#endif // HOST_PICO_PLATFORM_H
@@ -0,0 +1,19 @@
+/**
+ * @file stdlib.h
+ * @brief Host HAL: Pico SDK stdlib umbrella
+ */
+
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include <stdio.h>
+#include "pico/types.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "hardware/sync.h"
+
+#ifndef PICO_ERROR_TIMEOUT
+#define PICO_ERROR_TIMEOUT  (-1)
+#endif
+
+#endif // HOST_PICO_STDLIB_H
@@ -0,0 +1,11 @@
+/**
+ * @file sync.h
+ * @brief Host HAL: Pico SDK synchronization umbrella
+ */
+
+#ifndef HOST_PICO_SYNC_H
+#define HOST_PICO_SYNC_H
+
+#include "hardware/sync.h"
+
+#endif // HOST_PICO_SYNC_H
@@ -0,0 +1,86 @@
+/**
+ * @file time.h
+ * @brief Host HAL: Pico SDK time API on CLOCK_MONOTONIC
+ *
+ * "Boot" is the first call into the HAL (host/hal_time.c). Alarms are not
+ * provided: add_alarm_at() reports no free slot, which every caller in the
+ * emulator already handles by polling from the main loop.
+ */
+
+#ifndef HOST_PICO_TIME_H
+#define HOST_PICO_TIME_H
+
+#include "pico/types.h"
+
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void* user_data);
+
+uint64_t time_us_64(void);
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+static inline absolute_time_t get_absolute_time(void) {
+    return time_us_64();
+}
+
+static inline uint64_t to_us_since_boot(absolute_time_t t) {
+    return t;
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000u);
+}
+
+static inline absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) {
+    return t + us;
+}
+
+static inline absolute_time_t make_timeout_time_us(uint64_t us) {
+    return time_us_64() + us;
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) {
+    return time_us_64() + (uint64_t)ms * 1000u;
+}
+
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) {
+    return (int64_t)(to - from);
+}
+
+static inline bool time_reached(absolute_time_t t) {
+    return time_us_64() >= t;
+}
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t t);
+void busy_wait_us(uint64_t us);
+
+static inline void busy_wait_us_32(uint32_t us) {
+    busy_wait_us(us);
+}
+
+static inline alarm_id_t add_alarm_at(absolute_time_t t, alarm_callback_t callback,
+                                      void* user_data, bool fire_if_past) {
+    (void)t; (void)callback; (void)user_data; (void)fire_if_past;
+    return -1;
+}
+
+static inline alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback,
+                                         void* user_data, bool fire_if_past) {
+    (void)us; (void)callback; (void)user_data; (void)fire_if_past;
+    return -1;
+}
+
+static inline bool cancel_alarm(alarm_id_t id) {
+    (void)id;
+    return false;
+}
+
+#endif // HOST_PICO_TIME_H
@@ -0,0 +1,18 @@
+/**
+ * @file types.h
+ * @brief Host HAL: Pico SDK base types
+ */
+
+#ifndef HOST_PICO_TYPES_H
+#define HOST_PICO_TYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+/** Microseconds since boot (the SDK's non-opaque representation) */
+typedef uint64_t absolute_time_t;
+
+#endif // HOST_PICO_TYPES_H
@@ -0,0 +1,1139 @@
+/**
+ * @file nsp_client.c
+ * @brief NRWA-T6 Emulator - Native NSP Load and Latency Client (nrwa_nsp_client)
+ *
+ * Plays the OBC: sends a scripted mix of NSP requests to one or more wheel
+ * addresses, matches each reply, and measures request-to-reply latency
+ * (write() of the request to arrival of the reply's SLIP END) on
+ * CLOCK_MONOTONIC. Frames are built and checked with the firmware's own
+ * crc_ccitt, slip and nsp sources, so the client and the emulator cannot
+ * disagree about the wire format.
+ *
+ * The bus is any host/bus_transport.h endpoint: a real adapter
+ * (serial:/dev/ttyUSB0, raw and low-latency), a bus hub (tcp:HOST:PORT)
+ * or a SIL (pty, stdio). One request is outstanding at a time, as on the
+ * half-duplex bus. --rate paces requests; without it the client sends the
+ * next request as soon as the previous one is answered or timed out.
+ *
+ * Results: a summary per command and overall (ACK/NACK/timeout/bad frame
+ * counts, p50..p99.9 and max), a text histogram, and optionally per-request
+ * and histogram CSV. --scenarios runs every tests/scenarios JSON file
+ * unattended against a fresh SIL (--sil) and reports one row per scenario:
+ * each file's "expect" block gives the requests to drive and the NACK,
+ * timeout and bad-frame counts and telemetry bits the injections must
+ * produce (tests/scenarios/README.md).
+ *
+ * Usage:
+ *   nrwa_nsp_client [--bus ENDPOINT] [--addr LIST] [--mix SPEC] [--rate HZ]
+ *                   [--count N | --duration S] [--timeout-ms T]
+ *                   [--csv FILE] [--hist-csv FILE]
+ *   nrwa_nsp_client --scenarios DIR --sil PATH [--speed X] [mix options]
+ *
+ *   SPEC: comma-separated NAME[=PAYLOAD_HEX][*WEIGHT]; NAME is ping, peek,
+ *         poke, telem, app-cmd, clear-fault, protection, trip-lcl, multi or
+ *         a command code (0x00-0x1F). Example: ping*2,telem=00,telem=04,peek=00
+ *
+ * Exit status: 0 when every request was answered (scenario mode: every
+ * scenario passed), 1 otherwise, 2 on bad arguments.
+ */
+
+#define _GNU_SOURCE
+
+#include "bus_transport.h"
+#include "crc_ccitt.h"
+#include "slip.h"
+#include "nsp.h"
+#include "util/latency_hist.h"
+#include "pico/time.h"
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/** Source address of the requests (the OBC's) */
+#define CLIENT_SRC_ADDR         0x11
+
+/** Entries in a request mix (after weights are expanded) */
+#define CLIENT_MAX_MIX          256
+
+/** Wheel addresses in one run */
+#define CLIENT_MAX_ADDRS        8
+
+/** Time allowed for a spawned SIL to answer its first telemetry request (ms) */
+#define CLIENT_SIL_START_MS     2000
+
+/** Run added after the last scheduled scenario event (ms) */
+#define CLIENT_SCENARIO_TAIL_MS 1000
+
+/** Histogram bar width (characters for the fullest bucket) */
+#define CLIENT_HIST_BAR         50
+
+/** STANDARD telemetry block: status, fault and current fields (ICD Table 12-13) */
+#define STD_TELEM_LEN           25
+#define STD_TELEM_STATUS        0
+#define STD_TELEM_FAULT         4
+#define STD_TELEM_CURRENT_CMD   15      // Q14.2 mA
+#define STD_TELEM_CURRENT_MEAS  17      // Q20.12 mA
+
+/** Measured current below this share of the target counts as limited */
+#define CLIENT_LIMITED_RATIO    0.9
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Request outcomes
+ */
+typedef enum {
+    RESULT_ACK = 0,
+    RESULT_NACK,
+    RESULT_TIMEOUT,
+    RESULT_COUNT
+} result_t;
+
+static const char* result_names[RESULT_COUNT] = { "ACK", "NACK", "TIMEOUT" };
+
+/**
+ * @brief One request of the mix
+ */
+typedef struct {
+    uint8_t command;
+    uint8_t payload[NSP_MAX_DATA_SIZE];
+    uint8_t payload_len;
+} mix_entry_t;
+
+/**
+ * @brief Counters and latency for one command (or all)
+ */
+typedef struct {
+    uint32_t results[RESULT_COUNT];
+    latency_hist_t hist;
+} cmd_totals_t;
+
+/**
+ * @brief Run settings
+ */
+typedef struct {
+    uint8_t addrs[CLIENT_MAX_ADDRS];
+    uint32_t addr_count;
+    uint32_t rate_hz;               // 0 = closed loop
+    uint32_t count;                 // 0 = until duration_ms
+    uint32_t duration_ms;
+    uint32_t timeout_ms;
+    FILE* csv;
+} run_config_t;
+
+/**
+ * @brief Run results (run_load() adds to them)
+ */
+typedef struct {
+    cmd_totals_t all;
+    cmd_totals_t per_cmd[NSP_CTRL_CMD_MASK + 1];
+    uint32_t sent;
+    uint32_t bad_frames;            // SLIP, CRC or length errors
+    uint32_t stray_frames;          // Valid frames that matched no request
+    uint64_t elapsed_us;
+
+    // STANDARD telemetry replies (telem=00)
+    uint32_t telem_status;          // Status bits seen (OR of all replies)
+    uint32_t telem_faults;          // Fault bits seen
+    uint32_t telem_limited;         // Replies with no fault and current below its target
+} run_stats_t;
+
+/**
+ * @brief Accepted range of one observed counter
+ */
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+} expect_range_t;
+
+/**
+ * @brief A scenario's "expect" block (what its injections must produce)
+ */
+typedef struct {
+    bool found;
+    char setup[256];                // Requests sent once before the run ("" = none)
+    uint32_t setup_ms;              // Scenario time of the setup
+    char mix[512];                  // Run mix ("" = the --mix)
+    uint32_t rate_hz;               // Run pacing (0 = the --rate)
+    uint32_t timeout_ms;            // Reply timeout, at least (for delayed replies)
+    expect_range_t nack;            // Absent: none expected
+    expect_range_t timeout;
+    expect_range_t bad;
+    uint32_t status_bits;           // Must each show in STANDARD telemetry
+    uint32_t fault_bits;
+    bool limited;                   // Current must be seen held below its target
+} scenario_expect_t;
+
+static mix_entry_t g_mix[CLIENT_MAX_MIX];
+static uint32_t g_mix_count = 0;
+static volatile sig_atomic_t g_stop = 0;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void client_signal(int sig) {
+    (void)sig;
+    g_stop = 1;
+}
+
+static bool parse_hex(const char* s, uint8_t* out, uint8_t* out_len) {
+    size_t n = strlen(s);
+    if (n % 2 != 0 || n / 2 > NSP_MAX_DATA_SIZE) {
+        return false;
+    }
+    for (size_t i = 0; i < n / 2; i++) {
+        char byte[3] = { s[2 * i], s[2 * i + 1], '\0' };
+        char* end;
+        out[i] = (uint8_t)strtoul(byte, &end, 16);
+        if (*end != '\0') {
+            return false;
+        }
+    }
+    *out_len = (uint8_t)(n / 2);
+    return true;
+}
+
+static bool command_code(const char* name, uint8_t* code) {
+    static const struct { const char* name; uint8_t code; } names[] = {
+        { "ping", NSP_CMD_PING },
+        { "peek", NSP_CMD_PEEK },
+        { "poke", NSP_CMD_POKE },
+        { "telem", NSP_CMD_APPLICATION_TELEMETRY },
+        { "app-cmd", NSP_CMD_APPLICATION_COMMAND },
+        { "clear-fault", NSP_CMD_CLEAR_FAULT },
+        { "protection", NSP_CMD_CONFIGURE_PROTECTION },
+        { "trip-lcl", NSP_CMD_TRIP_LCL },
+        { "multi", NSP_CMD_MULTI_TELEMETRY },
+    };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (strcmp(name, names[i].name) == 0) {
+            *code = names[i].code;
+            return true;
+        }
+    }
+    char* end;
+    unsigned long v = strtoul(name, &end, 0);
+    if (*end != '\0' || end == name || v > NSP_CTRL_CMD_MASK) {
+        return false;
+    }
+    *code = (uint8_t)v;
+    return true;
+}
+
+/**
+ * @brief Parse a mix specification into g_mix (weights expanded)
+ */
+static bool parse_mix(const char* spec) {
+    char buf[1024];
+    snprintf(buf, sizeof(buf), "%s", spec);
+    g_mix_count = 0;
+
+    for (char* item = strtok(buf, ","); item; item = strtok(NULL, ",")) {
+        uint32_t weight = 1;
+        char* star = strchr(item, '*');
+        if (star) {
+            *star = '\0';
+            weight = (uint32_t)strtoul(star + 1, NULL, 10);
+        }
+        mix_entry_t entry = { 0 };
+        char* eq = strchr(item, '=');
+        if (eq) {
+            *eq = '\0';
+            if (!parse_hex(eq + 1, entry.payload, &entry.payload_len)) {
+                fprintf(stderr, "[CLIENT] Bad payload '%s'\n", eq + 1);
+                return false;
+            }
+        }
+        if (!command_code(item, &entry.command) || weight == 0) {
+            fprintf(stderr, "[CLIENT] Bad mix entry '%s'\n", item);
+            return false;
+        }
+        for (uint32_t w = 0; w < weight; w++) {
+            if (g_mix_count >= CLIENT_MAX_MIX) {
+                fprintf(stderr, "[CLIENT] Mix longer than %u requests\n", (unsigned)CLIENT_MAX_MIX);
+                return false;
+            }
+            g_mix[g_mix_count++] = entry;
+        }
+    }
+    return g_mix_count > 0;
+}
+
+static uint32_t read_le32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static bool parse_addrs(const char* list, run_config_t* cfg) {
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", list);
+    cfg->addr_count = 0;
+    for (char* item = strtok(buf, ","); item; item = strtok(NULL, ",")) {
+        char* end;
+        unsigned long v = strtoul(item, &end, 0);
+        if (*end != '\0' || v > 0xFF || cfg->addr_count >= CLIENT_MAX_ADDRS) {
+            return false;
+        }
+        cfg->addrs[cfg->addr_count++] = (uint8_t)v;
+    }
+    return cfg->addr_count > 0;
+}
+
+/**
+ * @brief Build the SLIP frame for one request
+ */
+static size_t build_request(uint8_t addr, const mix_entry_t* entry, uint8_t* out) {
+    uint8_t pkt[NSP_MAX_PACKET_SIZE];
+    pkt[0] = addr;
+    pkt[1] = CLIENT_SRC_ADDR;
+    pkt[2] = nsp_make_ctrl(true, false, false, entry->command);
+    memcpy(&pkt[3], entry->payload, entry->payload_len);
+    size_t len = crc_ccitt_append(pkt, 3 + (size_t)entry->payload_len);
+    size_t out_len = 0;
+    slip_encode(pkt, len, out, &out_len);
+    return out_len;
+}
+
+// ============================================================================
+// Load Run
+// ============================================================================
+
+static void record(run_stats_t* stats, const run_config_t* cfg, uint32_t seq, uint64_t t_us,
+                   uint8_t addr, uint8_t command, result_t result, uint32_t latency_us) {
+    cmd_totals_t* cmd = &stats->per_cmd[command & NSP_CTRL_CMD_MASK];
+    stats->all.results[result]++;
+    cmd->results[result]++;
+    if (result != RESULT_TIMEOUT) {
+        latency_hist_record(&stats->all.hist, latency_us);
+        latency_hist_record(&cmd->hist, latency_us);
+    }
+    if (cfg->csv) {
+        fprintf(cfg->csv, "%u,%llu,0x%02X,0x%02X,%s,", (unsigned)seq, (unsigned long long)t_us,
+                addr, command, result_names[result]);
+        if (result != RESULT_TIMEOUT) {
+            fprintf(cfg->csv, "%u\n", (unsigned)latency_us);
+        } else {
+            fprintf(cfg->csv, "\n");
+        }
+    }
+}
+
+/**
+ * @brief Note what a STANDARD telemetry reply shows
+ */
+static void observe_standard(run_stats_t* stats, const uint8_t* data, size_t len) {
+    if (len != STD_TELEM_LEN) {
+        return;
+    }
+    uint32_t status = read_le32(&data[STD_TELEM_STATUS]);
+    uint32_t faults = read_le32(&data[STD_TELEM_FAULT]);
+    double cmd_ma = (double)(data[STD_TELEM_CURRENT_CMD] |
+                             (data[STD_TELEM_CURRENT_CMD + 1] << 8)) / 4.0;
+    double meas_ma = (double)(int32_t)read_le32(&data[STD_TELEM_CURRENT_MEAS]) / 4096.0;
+    stats->telem_status |= status;
+    stats->telem_faults |= faults;
+    if (faults == 0 && cmd_ma > 0.0 && (meas_ma < 0 ? -meas_ma : meas_ma) < CLIENT_LIMITED_RATIO * cmd_ma) {
+        stats->telem_limited++;
+    }
+}
+
+/**
+ * @brief Drive the mix over the bus
+ *
+ * Adds to stats, so consecutive runs (scenario phases) accumulate.
+ *
+ * @return false if the bus went away
+ */
+static bool run_load(bus_transport_t* bus, const run_config_t* cfg, run_stats_t* stats) {
+    uint32_t sent_before = stats->sent;
+
+    slip_decoder_t decoder;
+    slip_decoder_init(&decoder);
+    uint8_t frame[NSP_MAX_PACKET_SIZE];
+    size_t frame_len = 0;
+    uint8_t tx[2 * NSP_MAX_PACKET_SIZE + 2];
+    uint8_t rx[512];
+
+    uint64_t period_us = cfg->rate_hz ? (1000000u / cfg->rate_hz) : 0;
+    uint64_t timeout_us = (uint64_t)cfg->timeout_ms * 1000u;
+    uint64_t start_us = time_us_64();
+    uint64_t end_us = start_us + (uint64_t)cfg->duration_ms * 1000u;
+    uint64_t due_us = start_us;
+
+    bool outstanding = false;
+    uint8_t out_addr = 0, out_cmd = 0;
+    bool out_standard = false;
+    uint64_t out_sent_us = 0;
+    bool ok = true;
+
+    while (!g_stop) {
+        uint64_t now_us = time_us_64();
+
+        // Next request: previous one settled, its slot due, budget left
+        bool budget = cfg->count ? (stats->sent - sent_before < cfg->count) : (now_us < end_us);
+        if (!outstanding && budget && now_us >= due_us) {
+            uint32_t seq = stats->sent - sent_before;
+            out_addr = cfg->addrs[seq % cfg->addr_count];
+            const mix_entry_t* entry = &g_mix[(seq / cfg->addr_count) % g_mix_count];
+            out_cmd = entry->command;
+            out_standard = (out_cmd == NSP_CMD_APPLICATION_TELEMETRY && entry->payload_len == 1 &&
+                            entry->payload[0] == 0x00);
+            size_t len = build_request(out_addr, entry, tx);
+            out_sent_us = time_us_64();
+            bus_transport_write(bus, tx, len);
+            stats->sent++;
+            outstanding = true;
+            if (period_us) {
+                due_us += period_us;
+                if (due_us + period_us < now_us) {
+                    due_us = now_us;    // Fell behind: offer from now rather than burst
+                }
+            }
+        }
+        if (!outstanding && !budget) {
+            break;
+        }
+
+        // Wait for bytes until the reply deadline or the next slot
+        uint64_t wake_us = outstanding ? out_sent_us + timeout_us : due_us;
+        now_us = time_us_64();
+        int wait_ms = (wake_us > now_us) ? (int)((wake_us - now_us + 999u) / 1000u) : 0;
+        struct pollfd pfd = { .fd = bus_transport_fd(bus), .events = POLLIN };
+        int ready = poll(&pfd, 1, wait_ms);
+        uint64_t rx_us = time_us_64();
+
+        if (ready > 0) {
+            ssize_t n = bus_transport_read(bus, rx, sizeof(rx));
+            if (n < 0 && n != BUS_TRANSPORT_FD_CHANGED) {
+                fprintf(stderr, "[CLIENT] Bus closed\n");
+                ok = false;
+                break;
+            }
+            for (ssize_t i = 0; i < n; i++) {
+                uint8_t data;
+                slip_event_t ev = slip_decode_step(&decoder, rx[i], &data);
+                if (ev == SLIP_EVENT_DATA) {
+                    if (frame_len < sizeof(frame)) {
+                        frame[frame_len] = data;
+                    }
+                    frame_len++;
+                    continue;
+                }
+                if (ev == SLIP_EVENT_ERROR) {
+                    stats->bad_frames++;
+                    frame_len = 0;
+                    continue;
+                }
+                if (ev != SLIP_EVENT_FRAME_END) {
+                    continue;
+                }
+                size_t len = frame_len;
+                frame_len = 0;
+                if (len > NSP_MAX_PACKET_SIZE) {
+                    stats->bad_frames++;
+                    continue;
+                }
+                nsp_view_t view;
+                if (nsp_parse_view(frame, len, &view) != NSP_OK) {
+                    stats->bad_frames++;
+                    continue;
+                }
+                if (!outstanding || view.dest != CLIENT_SRC_ADDR ||
+                    view.src != out_addr || nsp_get_command(view.ctrl) != out_cmd) {
+                    stats->stray_frames++;  // Our own echo, another node, or late
+                    continue;
+                }
+                result_t result = (view.ctrl & NSP_CTRL_A_BIT) ? RESULT_ACK : RESULT_NACK;
+                if (result == RESULT_ACK && out_standard) {
+                    observe_standard(stats, view.data, view.len);
+                }
+                record(stats, cfg, stats->sent - 1, out_sent_us - start_us, out_addr, out_cmd,
+                       result, (uint32_t)(rx_us - out_sent_us));
+                outstanding = false;
+            }
+        }
+
+        if (outstanding && time_us_64() - out_sent_us >= timeout_us) {
+            record(stats, cfg, stats->sent - 1, out_sent_us - start_us, out_addr, out_cmd,
+                   RESULT_TIMEOUT, 0);
+            outstanding = false;
+        }
+    }
+
+    stats->elapsed_us += time_us_64() - start_us;
+    return ok;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+static void print_totals(const char* label, const cmd_totals_t* t) {
+    latency_summary_t s;
+    latency_hist_summarize(&t->hist, &s);
+    printf("%-8s %8u %8u %8u %7u %7u %7u %7u %7u\n", label, (unsigned)t->results[RESULT_ACK],
+           (unsigned)t->results[RESULT_NACK], (unsigned)t->results[RESULT_TIMEOUT],
+           (unsigned)s.p50_us, (unsigned)s.p90_us, (unsigned)s.p99_us, (unsigned)s.p999_us,
+           (unsigned)s.max_us);
+}
+
+static void print_report(const run_stats_t* stats) {
+    uint32_t answered = stats->all.results[RESULT_ACK] + stats->all.results[RESULT_NACK];
+    double seconds = (double)stats->elapsed_us / 1e6;
+    printf("Sent %u requests in %.3f s: %.1f req/s answered, %u bad frames, %u stray frames\n",
+           (unsigned)stats->sent, seconds, seconds > 0 ? answered / seconds : 0.0,
+           (unsigned)stats->bad_frames, (unsigned)stats->stray_frames);
+
+    printf("%-8s %8s %8s %8s %7s %7s %7s %7s %7s (us)\n", "command", "ack", "nack", "timeout",
+           "p50", "p90", "p99", "p99.9", "max");
+    for (uint32_t c = 0; c <= NSP_CTRL_CMD_MASK; c++) {
+        const cmd_totals_t* t = &stats->per_cmd[c];
+        if (t->results[RESULT_ACK] + t->results[RESULT_NACK] + t->results[RESULT_TIMEOUT] == 0) {
+            continue;
+        }
+        char label[8];
+        snprintf(label, sizeof(label), "0x%02X", (unsigned)c);
+        print_totals(label, t);
+    }
+    print_totals("all", &stats->all);
+
+    // Histogram of the non-empty buckets, bars scaled to the fullest
+    uint32_t peak = 0;
+    for (uint32_t i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        if (stats->all.hist.buckets[i] > peak) {
+            peak = stats->all.hist.buckets[i];
+        }
+    }
+    if (peak == 0) {
+        return;
+    }
+    printf("\nLatency histogram (bucket upper bound, us):\n");
+    for (uint32_t i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        uint32_t n = stats->all.hist.buckets[i];
+        if (n == 0) {
+            continue;
+        }
+        uint32_t upper = latency_hist_bucket_upper_us(i);
+        char bound[16];
+        if (upper == UINT32_MAX) {
+            snprintf(bound, sizeof(bound), ">=%u", (unsigned)LATENCY_HIST_MAX_US);
+        } else {
+            snprintf(bound, sizeof(bound), "%u", (unsigned)upper);
+        }
+        uint32_t bar = (uint32_t)(((uint64_t)n * CLIENT_HIST_BAR + peak - 1) / peak);
+        printf("%9s %8u ", bound, (unsigned)n);
+        for (uint32_t b = 0; b < bar; b++) {
+            putchar('#');
+        }
+        putchar('\n');
+    }
+}
+
+static bool write_hist_csv(const char* path, const latency_hist_t* hist) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "[CLIENT] Cannot write %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    fprintf(f, "bucket_upper_us,count\n");
+    for (uint32_t i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        uint32_t upper = latency_hist_bucket_upper_us(i);
+        fprintf(f, "%u,%u\n", (unsigned)(upper == UINT32_MAX ? hist->max_us : upper),
+                (unsigned)hist->buckets[i]);
+    }
+    fclose(f);
+    return true;
+}
+
+// ============================================================================
+// Scenario Runs
+// ============================================================================
+
+/**
+ * @brief Read a scenario file into a static buffer
+ *
+ * @return The NUL-terminated text, or NULL
+ */
+static const char* read_scenario(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return NULL;
+    }
+    static char json[16384];
+    size_t len = fread(json, 1, sizeof(json) - 1, f);
+    fclose(f);
+    json[len] = '\0';
+    return json;
+}
+
+/**
+ * @brief Largest t_ms + duration_ms in a scenario (its run length)
+ */
+static uint32_t scenario_length_ms(const char* json) {
+    // Each event's t_ms is followed by its own duration_ms, if any
+    uint32_t longest = 0;
+    for (const char* p = strstr(json, "\"t_ms\""); p; p = strstr(p + 1, "\"t_ms\"")) {
+        const char* colon = strchr(p, ':');
+        if (!colon) {
+            break;
+        }
+        uint32_t t = (uint32_t)strtoul(colon + 1, NULL, 10);
+        uint32_t d = 0;
+        const char* dur = strstr(p, "\"duration_ms\"");
+        const char* next = strstr(p + 1, "\"t_ms\"");
+        if (dur && (!next || dur < next) && (colon = strchr(dur, ':')) != NULL) {
+            d = (uint32_t)strtoul(colon + 1, NULL, 10);
+        }
+        if (t + d > longest) {
+            longest = t + d;
+        }
+    }
+    return longest;
+}
+
+/**
+ * @brief End of the JSON value at p (one past its last character)
+ */
+static const char* json_value_end(const char* p, const char* end) {
+    int depth = 0;
+    for (; p < end; p++) {
+        if (*p == '"') {
+            for (p++; p < end && *p != '"'; p++) {
+                if (*p == '\\') {
+                    p++;
+                }
+            }
+        } else if (*p == '{' || *p == '[') {
+            depth++;
+        } else if (*p == '}' || *p == ']') {
+            if (--depth <= 0) {
+                return p + 1;
+            }
+        } else if (depth == 0 && (*p == ',' || isspace((unsigned char)*p))) {
+            return p;
+        }
+    }
+    return end;
+}
+
+/**
+ * @brief Value of a member of the JSON object at obj (not of nested ones)
+ *
+ * @return Start of the value, or NULL if the object has no such member
+ */
+static const char* json_member(const char* obj, const char* end, const char* key) {
+    size_t key_len = strlen(key);
+    int depth = 0;
+    for (const char* p = obj; p < end; p++) {
+        if (*p == '{' || *p == '[') {
+            depth++;
+        } else if (*p == '}' || *p == ']') {
+            depth--;
+        } else if (*p == '"') {
+            const char* name = p + 1;
+            for (p++; p < end && *p != '"'; p++) {
+                if (*p == '\\') {
+                    p++;
+                }
+            }
+            const char* after = p + 1;
+            while (after < end && isspace((unsigned char)*after)) {
+                after++;
+            }
+            if (depth == 1 && after < end && *after == ':' && (size_t)(p - name) == key_len &&
+                memcmp(name, key, key_len) == 0) {
+                for (after++; after < end && isspace((unsigned char)*after); after++) {
+                }
+                return after;
+            }
+        }
+    }
+    return NULL;
+}
+
+static bool json_string(const char* v, char* out, size_t capacity) {
+    const char* close = v ? strchr(v + 1, '"') : NULL;
+    if (!close || *v != '"' || (size_t)(close - v - 1) >= capacity) {
+        return false;
+    }
+    memcpy(out, v + 1, (size_t)(close - v - 1));
+    out[close - v - 1] = '\0';
+    return true;
+}
+
+/**
+ * @brief Counter range: N (exactly N), [MIN, MAX] or [MIN] (at least MIN)
+ */
+static bool json_range(const char* v, expect_range_t* range) {
+    char* end;
+    if (*v != '[') {
+        range->min = range->max = (uint32_t)strtoul(v, &end, 10);
+        return end != v;
+    }
+    range->min = (uint32_t)strtoul(v + 1, &end, 10);
+    range->max = UINT32_MAX;
+    if (end == v + 1) {
+        return false;
+    }
+    while (isspace((unsigned char)*end)) {
+        end++;
+    }
+    if (*end == ',') {
+        const char* max = end + 1;
+        range->max = (uint32_t)strtoul(max, &end, 10);
+        if (end == max || range->max < range->min) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Read a scenario's "expect" block
+ *
+ * @return false if the block is malformed (absent is not an error)
+ */
+static bool parse_expect(const char* json, scenario_expect_t* e) {
+    memset(e, 0, sizeof(*e));
+    const char* end = json + strlen(json);
+    const char* obj = strchr(json, '{');
+    const char* block = obj ? json_member(obj, end, "expect") : NULL;
+    if (!block) {
+        return true;
+    }
+    if (*block != '{') {
+        return false;
+    }
+    e->found = true;
+    end = json_value_end(block, end);
+
+    const char* v;
+    if ((v = json_member(block, end, "setup")) && !json_string(v, e->setup, sizeof(e->setup))) {
+        return false;
+    }
+    if ((v = json_member(block, end, "setup_ms"))) {
+        e->setup_ms = (uint32_t)strtoul(v, NULL, 10);
+    }
+    if ((v = json_member(block, end, "mix")) && !json_string(v, e->mix, sizeof(e->mix))) {
+        return false;
+    }
+    if ((v = json_member(block, end, "rate_hz"))) {
+        e->rate_hz = (uint32_t)strtoul(v, NULL, 10);
+    }
+    if ((v = json_member(block, end, "timeout_ms"))) {
+        e->timeout_ms = (uint32_t)strtoul(v, NULL, 10);
+    }
+    if (((v = json_member(block, end, "nack")) && !json_range(v, &e->nack)) ||
+        ((v = json_member(block, end, "timeout")) && !json_range(v, &e->timeout)) ||
+        ((v = json_member(block, end, "bad")) && !json_range(v, &e->bad))) {
+        return false;
+    }
+    if ((v = json_member(block, end, "status_bits"))) {
+        e->status_bits = (uint32_t)strtoul(v, NULL, 10);
+    }
+    if ((v = json_member(block, end, "fault_bits"))) {
+        e->fault_bits = (uint32_t)strtoul(v, NULL, 10);
+    }
+    if ((v = json_member(block, end, "current_limited"))) {
+        e->limited = (strncmp(v, "true", 4) == 0);
+    }
+    return true;
+}
+
+static bool check_range(const char* name, uint32_t seen, const expect_range_t* range,
+                        char* why, size_t capacity) {
+    if (seen >= range->min && seen <= range->max) {
+        return true;
+    }
+    if (range->max == UINT32_MAX) {
+        snprintf(why, capacity, "%s %u < %u", name, (unsigned)seen, (unsigned)range->min);
+    } else {
+        snprintf(why, capacity, "%s %u not in %u..%u", name, (unsigned)seen,
+                 (unsigned)range->min, (unsigned)range->max);
+    }
+    return false;
+}
+
+/**
+ * @brief Compare a scenario run with its "expect" block
+ *
+ * An expectation of no visible effect fails too: it cannot tell a
+ * working injection from one that never fired.
+ *
+ * @return true if it matched; otherwise why holds the first mismatch
+ */
+static bool check_expect(const scenario_expect_t* e, const run_stats_t* stats,
+                         char* why, size_t capacity) {
+    if (!e->found) {
+        snprintf(why, capacity, "no expect block");
+        return false;
+    }
+    if (e->nack.min == 0 && e->timeout.min == 0 && e->bad.min == 0 &&
+        e->status_bits == 0 && e->fault_bits == 0 && !e->limited) {
+        snprintf(why, capacity, "expects no effect");
+        return false;
+    }
+    if (!check_range("nack", stats->all.results[RESULT_NACK], &e->nack, why, capacity) ||
+        !check_range("timeout", stats->all.results[RESULT_TIMEOUT], &e->timeout, why, capacity) ||
+        !check_range("bad", stats->bad_frames, &e->bad, why, capacity)) {
+        return false;
+    }
+    if ((stats->telem_status & e->status_bits) != e->status_bits) {
+        snprintf(why, capacity, "status 0x%08x lacks 0x%08x", (unsigned)stats->telem_status,
+                 (unsigned)e->status_bits);
+        return false;
+    }
+    if ((stats->telem_faults & e->fault_bits) != e->fault_bits) {
+        snprintf(why, capacity, "faults 0x%08x lack 0x%08x", (unsigned)stats->telem_faults,
+                 (unsigned)e->fault_bits);
+        return false;
+    }
+    if (e->limited && stats->telem_limited == 0) {
+        snprintf(why, capacity, "current never limited");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Start a SIL on a pipe pair with the scenario loaded
+ *
+ * @return Child PID, or -1
+ */
+static pid_t spawn_sil(const char* sil, const char* scenario, const char* speed,
+                       bus_transport_t* bus) {
+    int to_sil[2], from_sil[2];
+    if (pipe2(to_sil, O_CLOEXEC) != 0 || pipe2(from_sil, O_CLOEXEC) != 0) {
+        return -1;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        return -1;
+    }
+    if (pid == 0) {
+        dup2(to_sil[0], STDIN_FILENO);
+        dup2(from_sil[1], STDOUT_FILENO);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDERR_FILENO);   // Emulator log
+        }
+        if (speed) {
+            execl(sil, sil, "--scenario", scenario, "--speed", speed, (char*)NULL);
+        } else {
+            execl(sil, sil, "--scenario", scenario, (char*)NULL);
+        }
+        _exit(127);
+    }
+    close(to_sil[0]);
+    close(from_sil[1]);
+
+    memset(bus, 0, sizeof(*bus));
+    bus->kind = BUS_TRANSPORT_STDIO;
+    bus->in_fd = from_sil[0];
+    bus->out_fd = to_sil[1];
+    bus->listen_fd = -1;
+    fcntl(bus->in_fd, F_SETFL, fcntl(bus->in_fd, F_GETFL) | O_NONBLOCK);
+    return pid;
+}
+
+/**
+ * @brief Close the SIL's input and collect its exit status
+ *
+ * @return true if it exited with status 0 on its own
+ */
+static bool stop_sil(pid_t pid, bus_transport_t* bus) {
+    close(bus->out_fd);     // EOF on the SIL's stdin stops it
+    int status = 0;
+    bool exited = false;
+    for (int i = 0; i < 200 && !exited; i++) {
+        if (waitpid(pid, &status, WNOHANG) == pid) {
+            exited = true;
+        } else {
+            sleep_ms(10);
+        }
+    }
+    if (!exited) {
+        kill(pid, SIGKILL);
+        waitpid(pid, &status, 0);
+    }
+    close(bus->in_fd);
+    return exited && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static int compare_names(const void* a, const void* b) {
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+/**
+ * @brief Poll STANDARD telemetry until the SIL answers it
+ *
+ * The wheel NACKs telemetry until its first physics tick has published,
+ * so an ACK means both the bus and the model are up.
+ *
+ * @return false if it never did (or rejected the scenario and exited)
+ */
+static bool wait_sil(bus_transport_t* bus, const run_config_t* cfg) {
+    run_config_t probe = *cfg;
+    probe.count = 1;
+    probe.csv = NULL;
+    probe.rate_hz = 0;
+    probe.timeout_ms = 50;
+    g_mix[0] = (mix_entry_t){ .command = NSP_CMD_APPLICATION_TELEMETRY, .payload_len = 1 };
+    g_mix_count = 1;
+    static run_stats_t stats;
+    uint64_t deadline_us = time_us_64() + (uint64_t)CLIENT_SIL_START_MS * 1000u;
+    while (!g_stop && time_us_64() < deadline_us) {
+        memset(&stats, 0, sizeof(stats));
+        if (!run_load(bus, &probe, &stats)) {
+            break;  // Bus gone: the SIL rejected the scenario
+        }
+        if (stats.all.results[RESULT_ACK] > 0) {
+            return true;
+        }
+        if (stats.all.results[RESULT_NACK] > 0) {
+            sleep_ms(1);    // Booting
+        }
+    }
+    return false;
+}
+
+static int run_scenarios(const char* dir, const char* sil, const char* speed, const char* mix_spec,
+                         run_config_t* cfg) {
+    DIR* d = opendir(dir);
+    if (!d) {
+        fprintf(stderr, "[CLIENT] Cannot open %s: %s\n", dir, strerror(errno));
+        return 2;
+    }
+    char* names[256];
+    size_t count = 0;
+    for (struct dirent* e = readdir(d); e && count < 256; e = readdir(d)) {
+        size_t n = strlen(e->d_name);
+        if (n > 5 && strcmp(e->d_name + n - 5, ".json") == 0) {
+            names[count++] = strdup(e->d_name);
+        }
+    }
+    closedir(d);
+    qsort(names, count, sizeof(names[0]), compare_names);
+
+    double factor = speed ? atof(speed) : 1.0;
+    uint32_t passed = 0;
+    printf("%-28s %6s %8s %8s %8s %6s %7s %7s  %s\n", "scenario", "run_s", "ack", "nack",
+           "timeout", "bad", "p50", "p99", "result");
+
+    for (size_t i = 0; i < count && !g_stop; i++) {
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s", dir, names[i]);
+        char why[96] = "";
+        scenario_expect_t expect;
+        const char* json = read_scenario(path);
+        if (!json || !parse_expect(json, &expect) ||
+            !parse_mix(expect.mix[0] ? expect.mix : mix_spec) ||
+            (expect.setup[0] && !parse_mix(expect.setup))) {
+            printf("%-28s %6s %8s %8s %8s %6s %7s %7s  FAIL (bad expect block)\n", names[i],
+                   "-", "-", "-", "-", "-", "-", "-");
+            continue;
+        }
+
+        // Scenario time runs `speed` times faster than the wall clock
+        uint32_t length_ms = scenario_length_ms(json) + CLIENT_SCENARIO_TAIL_MS;
+        run_config_t run = *cfg;
+        run.count = 0;
+        if (expect.rate_hz) {
+            run.rate_hz = expect.rate_hz;
+        }
+        if (expect.timeout_ms > run.timeout_ms) {
+            run.timeout_ms = expect.timeout_ms;
+        }
+        run.duration_ms = (uint32_t)((double)length_ms / factor);
+        if (cfg->duration_ms && run.duration_ms > cfg->duration_ms) {
+            run.duration_ms = cfg->duration_ms;     // --duration caps each scenario
+        }
+        run_config_t before = run;
+        before.duration_ms = (uint32_t)((double)expect.setup_ms / factor);
+        if (before.duration_ms > run.duration_ms) {
+            before.duration_ms = run.duration_ms;
+        }
+        run.duration_ms -= before.duration_ms;
+
+        bus_transport_t bus;
+        pid_t pid = spawn_sil(sil, path, speed, &bus);
+        if (pid < 0) {
+            fprintf(stderr, "[CLIENT] Cannot start %s\n", sil);
+            break;
+        }
+        bool up = wait_sil(&bus, cfg);
+
+        // Run mix up to setup_ms, the setup requests once (each must be
+        // ACKed; counted apart from the run), then the run mix to the end
+        static run_stats_t stats;
+        static run_stats_t setup_stats;
+        memset(&stats, 0, sizeof(stats));
+        memset(&setup_stats, 0, sizeof(setup_stats));
+        bool ok = up;
+        bool setup_ok = true;
+        if (ok && before.duration_ms > 0) {
+            ok = parse_mix(expect.mix[0] ? expect.mix : mix_spec) && run_load(&bus, &before, &stats);
+        }
+        if (ok && expect.setup[0]) {
+            run_config_t setup = *cfg;
+            parse_mix(expect.setup);
+            setup.count = g_mix_count * cfg->addr_count;
+            setup.rate_hz = 0;
+            ok = run_load(&bus, &setup, &setup_stats);
+            setup_ok = (setup_stats.all.results[RESULT_ACK] == setup.count);
+        }
+        if (ok) {
+            ok = parse_mix(expect.mix[0] ? expect.mix : mix_spec) && run_load(&bus, &run, &stats);
+        }
+        bool clean_exit = stop_sil(pid, &bus);
+
+        bool pass = false;
+        if (!up) {
+            snprintf(why, sizeof(why), "no start");
+        } else if (!ok || !clean_exit) {
+            snprintf(why, sizeof(why), "exit");
+        } else if (!setup_ok) {
+            snprintf(why, sizeof(why), "setup: %u of %u ACKed",
+                     (unsigned)setup_stats.all.results[RESULT_ACK],
+                     (unsigned)(setup_stats.sent));
+        } else {
+            pass = check_expect(&expect, &stats, why, sizeof(why));
+        }
+        passed += pass ? 1u : 0u;
+
+        latency_summary_t s;
+        latency_hist_summarize(&stats.all.hist, &s);
+        printf("%-28s %6.1f %8u %8u %8u %6u %7u %7u  %s%s%s%s\n", names[i],
+               (double)(before.duration_ms + run.duration_ms) / 1000.0,
+               (unsigned)stats.all.results[RESULT_ACK], (unsigned)stats.all.results[RESULT_NACK],
+               (unsigned)stats.all.results[RESULT_TIMEOUT], (unsigned)stats.bad_frames,
+               (unsigned)s.p50_us, (unsigned)s.p99_us, pass ? "PASS" : "FAIL",
+               pass ? "" : " (", why, pass ? "" : ")");
+        fflush(stdout);
+    }
+
+    printf("%u/%u scenarios passed\n", (unsigned)passed, (unsigned)count);
+    bool all_passed = (passed == count);
+    for (size_t i = 0; i < count; i++) {
+        free(names[i]);
+    }
+    return all_passed ? 0 : 1;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void client_usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [--bus ENDPOINT] [--addr LIST] [--mix SPEC] [--rate HZ]\n"
+                    "          [--count N | --duration S] [--timeout-ms T] [--csv FILE] [--hist-csv FILE]\n"
+                    "       %s --scenarios DIR --sil PATH [--speed X] [mix options]\n"
+                    "  ENDPOINT: serial:DEV[:BAUD], tcp:HOST:PORT, pty[:LINK], stdio (default)\n"
+                    "  LIST:     wheel addresses, e.g. 0,1,2 (default 0)\n"
+                    "  SPEC:     NAME[=PAYLOAD_HEX][*WEIGHT],... (default ping)\n"
+                    "            NAME: ping peek poke telem app-cmd clear-fault protection\n"
+                    "                  trip-lcl multi, or a command code\n"
+                    "  --rate:   requests per second (default: back-to-back)\n",
+            argv0, argv0);
+}
+
+int main(int argc, char** argv) {
+    const char* bus_spec = "stdio";
+    const char* mix_spec = "ping";
+    const char* csv_path = NULL;
+    const char* hist_path = NULL;
+    const char* scenario_dir = NULL;
+    const char* sil_path = NULL;
+    const char* speed = NULL;
+    run_config_t cfg = { .addrs = { 0 }, .addr_count = 1, .count = 1000, .timeout_ms = 20 };
+
+    for (int i = 1; i < argc; i++) {
+        bool has_arg = (i + 1 < argc);
+        if (strcmp(argv[i], "--bus") == 0 && has_arg) {
+            bus_spec = argv[++i];
+        } else if (strcmp(argv[i], "--addr") == 0 && has_arg) {
+            if (!parse_addrs(argv[++i], &cfg)) {
+                client_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--mix") == 0 && has_arg) {
+            mix_spec = argv[++i];
+        } else if (strcmp(argv[i], "--rate") == 0 && has_arg) {
+            cfg.rate_hz = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--count") == 0 && has_arg) {
+            cfg.count = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--duration") == 0 && has_arg) {
+            cfg.duration_ms = (uint32_t)(atof(argv[++i]) * 1000.0);
+            cfg.count = 0;
+        } else if (strcmp(argv[i], "--timeout-ms") == 0 && has_arg) {
+            cfg.timeout_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--csv") == 0 && has_arg) {
+            csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--hist-csv") == 0 && has_arg) {
+            hist_path = argv[++i];
+        } else if (strcmp(argv[i], "--scenarios") == 0 && has_arg) {
+            scenario_dir = argv[++i];
+        } else if (strcmp(argv[i], "--sil") == 0 && has_arg) {
+            sil_path = argv[++i];
+        } else if (strcmp(argv[i], "--speed") == 0 && has_arg && atof(argv[i + 1]) > 0.0) {
+            speed = argv[++i];
+        } else {
+            client_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!parse_mix(mix_spec) || cfg.timeout_ms == 0 || (cfg.count == 0 && cfg.duration_ms == 0)) {
+        client_usage(argv[0]);
+        return 2;
+    }
+
+    signal(SIGINT, client_signal);
+    signal(SIGTERM, client_signal);
+    signal(SIGPIPE, SIG_IGN);
+
+    if (csv_path) {
+        cfg.csv = fopen(csv_path, "w");
+        if (!cfg.csv) {
+            fprintf(stderr, "[CLIENT] Cannot write %s: %s\n", csv_path, strerror(errno));
+            return 1;
+        }
+        fprintf(cfg.csv, "seq,t_us,addr,cmd,result,latency_us\n");
+    }
+
+    int rc;
+    if (scenario_dir) {
+        if (!sil_path) {
+            client_usage(argv[0]);
+            return 2;
+        }
+        rc = run_scenarios(scenario_dir, sil_path, speed, mix_spec, &cfg);
+    } else {
+        bus_transport_t bus;
+        if (!bus_transport_open(&bus, bus_spec)) {
+            return 1;
+        }
+        static run_stats_t stats;
+        bool ok = run_load(&bus, &cfg, &stats);
+        bus_transport_close(&bus);
+        print_report(&stats);
+        if (hist_path && !write_hist_csv(hist_path, &stats.all.hist)) {
+            ok = false;
+        }
+        rc = (ok && stats.all.results[RESULT_TIMEOUT] == 0) ? 0 : 1;
+    }
+
+    if (cfg.csv) {
+        fclose(cfg.csv);
+    }
+    return rc;
+}
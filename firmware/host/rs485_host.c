@@ -0,0 +1,283 @@
+/**
+ * @file rs485_host.c
+ * @brief Host HAL: RS-485 Driver on Memory Buffers
+ *
+ * Implements drivers/rs485_uart.h for the host build. A transmission is
+ * handed to the TX sink in one piece when committed, so the bus is never
+ * busy and the TX-done callback runs before the commit returns. Everything
+ * runs on the Core0 thread.
+ */
+
+#include "rs485_host.h"
+#include "drivers/rs485_uart.h"
+#include "board_pico.h"
+#include <string.h>
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+static bool initialized = false;
+
+// Recorded for Table 2 only: the memory bus has no bit timing
+static rs485_backend_t backend = RS485_BACKEND_DEFAULT;
+static uint32_t baud = RS485_BAUD_RATE;
+
+static uint8_t rx_ring[RS485_RX_BUFFER_SIZE];
+static size_t rx_head = 0;                      // Next write
+static size_t rx_tail = 0;                      // Next read
+static size_t rx_count = 0;
+static uint32_t rx_dropped = 0;
+static uint32_t rx_peak = 0;
+
+static rs485_rx_callback_t rx_callback = NULL;
+static uint8_t rx_delimiter = 0;
+
+static uint8_t tx_buf[RS485_TX_BUFFER_SIZE];
+static uint32_t tx_start_us = 0;
+static rs485_tx_callback_t tx_done_callback = NULL;
+static rs485_host_tx_sink_t tx_sink = NULL;
+static void* tx_sink_ctx = NULL;
+
+typedef struct {
+    uint8_t data[RS485_DEFER_FRAME_SIZE];
+    size_t len;
+    uint64_t release_us;
+} deferred_frame_t;
+
+static deferred_frame_t defer_queue[RS485_DEFER_DEPTH];
+static size_t defer_head = 0;                   // Oldest queued
+static size_t defer_count = 0;
+static uint32_t defer_queued = 0;
+static uint32_t defer_sent = 0;
+static uint32_t defer_rejected = 0;
+static uint32_t defer_max_late_us = 0;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void transmit(const uint8_t* data, size_t len) {
+    tx_start_us = time_us_32();
+    if (tx_sink) {
+        tx_sink(data, len, tx_sink_ctx);
+    }
+}
+
+// ============================================================================
+// Host Hooks
+// ============================================================================
+
+void rs485_host_set_tx_sink(rs485_host_tx_sink_t sink, void* ctx) {
+    tx_sink = sink;
+    tx_sink_ctx = ctx;
+}
+
+void rs485_host_receive(const uint8_t* data, size_t len) {
+    bool delimiter_seen = false;
+
+    for (size_t i = 0; i < len; i++) {
+        if (rx_count == sizeof(rx_ring)) {
+            rx_dropped++;
+            continue;
+        }
+        rx_ring[rx_head] = data[i];
+        rx_head = (rx_head + 1) % sizeof(rx_ring);
+        rx_count++;
+        if (data[i] == rx_delimiter) {
+            delimiter_seen = true;
+        }
+    }
+    if (rx_count > rx_peak) {
+        rx_peak = (uint32_t)rx_count;
+    }
+
+    if (delimiter_seen && rx_callback) {
+        rx_callback();
+    }
+}
+
+void rs485_host_poll(void) {
+    uint64_t now_us = time_us_64();
+
+    while (defer_count > 0 && defer_queue[defer_head].release_us <= now_us) {
+        deferred_frame_t* f = &defer_queue[defer_head];
+        uint32_t late_us = (uint32_t)(now_us - f->release_us);
+        if (late_us > defer_max_late_us) {
+            defer_max_late_us = late_us;
+        }
+        transmit(f->data, f->len);
+        defer_sent++;
+        defer_head = (defer_head + 1) % RS485_DEFER_DEPTH;
+        defer_count--;
+    }
+}
+
+uint64_t rs485_host_next_release_us(void) {
+    return (defer_count > 0) ? defer_queue[defer_head].release_us : UINT64_MAX;
+}
+
+// ============================================================================
+// rs485_uart.h API
+// ============================================================================
+
+bool rs485_init(void) {
+    initialized = true;
+    return true;
+}
+
+bool rs485_configure(rs485_backend_t new_backend, uint32_t new_baud) {
+    if (new_backend >= RS485_BACKEND_COUNT || new_baud < RS485_BAUD_MIN) {
+        return false;
+    }
+    backend = new_backend;
+    baud = new_baud;
+    initialized = true;
+    return true;
+}
+
+bool rs485_set_loopback(bool enable) {
+    (void)enable;
+    return false;   // No UART to loop back in; replies already go to the sink
+}
+
+rs485_backend_t rs485_get_backend(void) {
+    return backend;
+}
+
+bool rs485_send(const uint8_t *data, size_t len) {
+    return rs485_send_async(data, len);
+}
+
+bool rs485_send_async(const uint8_t *data, size_t len) {
+    if (data == NULL || len == 0 || len > sizeof(tx_buf)) {
+        return false;
+    }
+    transmit(data, len);
+    if (tx_done_callback) {
+        tx_done_callback();
+    }
+    return true;
+}
+
+uint8_t *rs485_tx_acquire(size_t *capacity) {
+    if (!initialized) {
+        return NULL;
+    }
+    if (capacity) {
+        *capacity = sizeof(tx_buf);
+    }
+    return tx_buf;
+}
+
+bool rs485_tx_commit(size_t len) {
+    return rs485_send_async(tx_buf, len);
+}
+
+bool rs485_send_at(const uint8_t *data, size_t len, uint64_t release_us) {
+    if (data == NULL || len == 0 || len > RS485_DEFER_FRAME_SIZE ||
+        defer_count == RS485_DEFER_DEPTH) {
+        defer_rejected++;
+        return false;
+    }
+
+    deferred_frame_t* f = &defer_queue[(defer_head + defer_count) % RS485_DEFER_DEPTH];
+    memcpy(f->data, data, len);
+    f->len = len;
+    f->release_us = release_us;
+    defer_count++;
+    defer_queued++;
+    return true;
+}
+
+void rs485_get_deferred_stats(uint32_t *queued, uint32_t *sent, uint32_t *rejected,
+                              uint32_t *max_late_us) {
+    if (queued) *queued = defer_queued;
+    if (sent) *sent = defer_sent;
+    if (rejected) *rejected = defer_rejected;
+    if (max_late_us) *max_late_us = defer_max_late_us;
+}
+
+size_t rs485_deferred_pending(void) {
+    return defer_count;
+}
+
+bool rs485_tx_busy(void) {
+    return false;
+}
+
+uint32_t rs485_tx_start_us(void) {
+    return tx_start_us;
+}
+
+void rs485_set_tx_done_callback(rs485_tx_callback_t callback) {
+    tx_done_callback = callback;
+}
+
+size_t rs485_available(void) {
+    return rx_count;
+}
+
+bool rs485_read_byte(uint8_t *byte) {
+    if (rx_count == 0) {
+        return false;
+    }
+    *byte = rx_ring[rx_tail];
+    rx_tail = (rx_tail + 1) % sizeof(rx_ring);
+    rx_count--;
+    return true;
+}
+
+size_t rs485_read(uint8_t *buffer, size_t len) {
+    size_t n = 0;
+    while (n < len && rs485_read_byte(&buffer[n])) {
+        n++;
+    }
+    return n;
+}
+
+void rs485_flush_tx(void) {
+    // Transmissions complete when committed
+}
+
+void rs485_clear_rx(void) {
+    rx_head = 0;
+    rx_tail = 0;
+    rx_count = 0;
+}
+
+void rs485_set_rx_callback(uint8_t delimiter, rs485_rx_callback_t callback) {
+    rx_delimiter = delimiter;
+    rx_callback = callback;
+}
+
+void rs485_get_baud(uint32_t *actual_baud, int32_t *error_ppm) {
+    if (actual_baud) *actual_baud = baud;
+    if (error_ppm) *error_ppm = 0;
+}
+
+uint32_t rs485_get_requested_baud(void) {
+    return baud;
+}
+
+void rs485_set_rx_stamping(bool enable) {
+    (void)enable;
+}
+
+bool rs485_rx_delimiter_time(uint32_t *us) {
+    (void)us;
+    return false;   // No wire timing: the handler stamps at service time
+}
+
+void rs485_get_rx_stats(uint32_t *dropped, uint32_t *hw_overruns, uint32_t *peak) {
+    if (dropped) *dropped = rx_dropped;
+    if (hw_overruns) *hw_overruns = 0;
+    if (peak) *peak = rx_peak;
+}
+
+uint8_t rs485_get_errors(void) {
+    return 0;
+}
+
+void rs485_clear_errors(void) {
+}
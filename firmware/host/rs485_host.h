@@ -0,0 +1,54 @@
+/**
+ * @file rs485_host.h
+ * @brief Host HAL: RS-485 Driver Backend Hooks
+ *
+ * rs485_host.c implements the drivers/rs485_uart.h API on memory buffers.
+ * A transport (stdio pipe, socket, ...) feeds received bytes in with
+ * rs485_host_receive() and gets every transmitted frame from the TX sink.
+ * Deferred frames (rs485_send_at) are released by rs485_host_poll().
+ */
+
+#ifndef RS485_HOST_H
+#define RS485_HOST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Receives each frame as it "leaves the wire"
+ */
+typedef void (*rs485_host_tx_sink_t)(const uint8_t* data, size_t len, void* ctx);
+
+/**
+ * @brief Set the TX sink (NULL discards transmitted frames)
+ *
+ * @param sink Sink callback
+ * @param ctx Passed back to the sink
+ */
+void rs485_host_set_tx_sink(rs485_host_tx_sink_t sink, void* ctx);
+
+/**
+ * @brief Deliver bytes received from the bus
+ *
+ * Appends to the RX ring (counting drops when full) and runs the delimiter
+ * callback if a delimiter byte was among them.
+ *
+ * @param data Received bytes
+ * @param len Byte count
+ */
+void rs485_host_receive(const uint8_t* data, size_t len);
+
+/**
+ * @brief Transmit deferred frames whose release time has passed
+ */
+void rs485_host_poll(void);
+
+/**
+ * @brief Get the release time of the next deferred frame
+ *
+ * @return time_us_64() of the earliest pending release, UINT64_MAX if none
+ */
+uint64_t rs485_host_next_release_us(void);
+
+#endif // RS485_HOST_H
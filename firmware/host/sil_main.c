@@ -0,0 +1,629 @@
+/**
+ * @file sil_main.c
+ * @brief NRWA-T6 Emulator - Host Software-in-the-Loop Executable
+ *
+ * Runs the firmware's NSP handler, command dispatch, telemetry and physics
+ * engine (nrwa_core) on Linux. The RS-485 bus is a byte stream: SLIP-framed
+ * NSP requests in, replies out, byte for byte what the board would put on
+ * the wire. By default it is stdin/stdout (log output then goes to stderr);
+ * --bus selects a socket or PTY instead (host/bus_transport.h), e.g. a
+ * shared multi-drop bus run by nrwa_bus.
+ *
+ * Threads mirror the RP2040 cores: the tick thread (host/timebase_host.c)
+ * runs physics_engine_tick() at PHYSICS_TICK_RATE_HZ, the main thread runs
+ * the Core0 service loop. They share state only through util/core_sync.
+ * The Core0 thread sleeps in epoll_wait() until bus input arrives, a
+ * deferred reply is due or a scenario needs its next time step.
+ *
+ * --lockstep hands the physics tick to the simulator on the bus: ticks run
+ * only on NSP SIM-STEP requests (timebase stepped mode), and scenario time
+ * follows them. --speed X steps the emulator itself at X times real time,
+ * one tick at a time with the Core0 scenario pass in between, so a run is
+ * tick-for-tick identical at any speed.
+ *
+ * --record FILE captures the bus traffic with physics-tick timestamps
+ * (nsp_replay.h). --replay FILE runs a capture instead of the bus: stepped,
+ * as fast as the host goes, each request fed in at its recorded tick, and
+ * every reply compared byte for byte with the capture's own replies or
+ * with --golden FILE. Differences are listed and the exit status is 1.
+ *
+ * Usage:
+ *   nrwa_t6_sil [--addr N] [--bus ENDPOINT] [--flash IMAGE] [--scenario FILE.json]...
+ *               [--lockstep | --speed X] [--record FILE]
+ *               [--replay FILE [--golden FILE]]
+ *
+ * Each --scenario runs in the next scenario layer (the first in layer 0),
+ * all at once.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "board_pico.h"
+#include "timebase.h"
+#include "timebase_host.h"
+#include "nsp_handler.h"
+#include "nsp_replay.h"
+#include "nss_nrwa_t6_engine.h"
+#include "nss_nrwa_t6_commands.h"
+#include "config/scenario.h"
+#include "config/json_loader.h"
+#include "util/core_sync.h"
+#include "util/dlog.h"
+#include "util/stats.h"
+#include "flash_store_host.h"
+#include "rs485_host.h"
+#include "bus_transport.h"
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <time.h>
+#include <unistd.h>
+
+// Firmware version (passed from CMake)
+#ifndef FIRMWARE_VERSION
+#define FIRMWARE_VERSION "v0.1.0-unknown"
+#endif
+
+/** Core0 service period while a scenario runs (event timing resolution, ms) */
+#define SIL_POLL_MS             5
+
+/** Core0 service period otherwise (housekeeping only, ms) */
+#define SIL_IDLE_MS             100
+
+/** Most ticks --speed runs before servicing the bus again */
+#define SIL_PACE_BATCH          256
+
+/** Reply differences --replay lists in full */
+#define SIL_REPLAY_SHOWN        10
+
+// ============================================================================
+// Global State
+// ============================================================================
+
+wheel_state_t g_wheel_states[EMULATED_WHEEL_COUNT];
+
+static volatile sig_atomic_t g_stop = 0;
+static bus_transport_t g_bus;
+
+// --speed pacing: ticks issued since pacing started at g_pace_start_us
+static double g_speed = 0.0;
+static uint64_t g_pace_start_us = 0;
+static uint64_t g_pace_issued = 0;
+
+// --record: bus traffic capture
+static FILE* g_record_file = NULL;
+static nsp_replay_rec_t g_recorder;
+
+// --replay: replies decoded from the TX sink and the golden replies they must match
+static bool g_replaying = false;
+static nsp_replay_reader_t g_golden;
+static slip_decoder_t g_reply_dec;
+static uint8_t g_reply_buf[NSP_MAX_PACKET_SIZE];
+static size_t g_reply_len = 0;
+static uint32_t g_replies = 0;
+static uint32_t g_mismatches = 0;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void sil_signal(int sig) {
+    (void)sig;
+    g_stop = 1;
+}
+
+/**
+ * @brief Physics tick (tick thread, the host's Core1)
+ */
+static void sil_physics_tick(void) {
+    physics_engine_tick(timebase_get_last_wake_us());
+    physics_engine_idle();
+}
+
+/**
+ * @brief Recorder output: append to the --record file
+ */
+static void sil_record_write(const void* data, size_t len, void* ctx) {
+    fwrite(data, 1, len, (FILE*)ctx);
+}
+
+static void sil_print_hex(const char* label, const uint8_t* data, size_t len) {
+    printf("  %s:", label);
+    for (size_t i = 0; i < len; i++) {
+        printf(" %02x", data[i]);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Compare one reply of a replay with the next golden reply
+ */
+static void sil_replay_check(const uint8_t* reply, size_t len) {
+    nsp_replay_frame_t want;
+    bool have;
+    while ((have = nsp_replay_reader_next(&g_golden, &want)) && want.dir != NSP_REPLAY_REPLY) {
+    }
+
+    uint32_t index = g_replies++;
+    if (have && want.len == len && memcmp(want.data, reply, len) == 0) {
+        return;
+    }
+    if (g_mismatches++ < SIL_REPLAY_SHOWN) {
+        if (have) {
+            printf("[SIL] Reply %lu (golden tick %lu) differs\n",
+                   (unsigned long)index, (unsigned long)want.tick);
+            sil_print_hex("golden", want.data, want.len);
+        } else {
+            printf("[SIL] Reply %lu not in the golden capture\n", (unsigned long)index);
+        }
+        sil_print_hex("actual", reply, len);
+    }
+}
+
+/**
+ * @brief TX sink: write the reply frame to the bus output (or check it, replaying)
+ */
+static void sil_bus_write(const uint8_t* data, size_t len, void* ctx) {
+    (void)ctx;
+    if (g_record_file) {
+        nsp_replay_rec_bytes(&g_recorder, NSP_REPLAY_REPLY, data, len, timebase_get_sim_us());
+    }
+    if (!g_replaying) {
+        bus_transport_write(&g_bus, data, len);
+        return;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        uint8_t byte;
+        switch (slip_decode_step(&g_reply_dec, data[i], &byte)) {
+            case SLIP_EVENT_DATA:
+                if (g_reply_len < sizeof(g_reply_buf)) {
+                    g_reply_buf[g_reply_len] = byte;
+                }
+                g_reply_len++;
+                break;
+            case SLIP_EVENT_FRAME_END:
+                sil_replay_check(g_reply_buf, g_reply_len < sizeof(g_reply_buf) ? g_reply_len
+                                                                                 : sizeof(g_reply_buf));
+                g_reply_len = 0;
+                break;
+            case SLIP_EVENT_ERROR:
+                g_reply_len = 0;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Watch the bus descriptor (again, after it changed)
+ */
+static void sil_bus_watch(int epfd, int* watched_fd) {
+    if (*watched_fd >= 0) {
+        epoll_ctl(epfd, EPOLL_CTL_DEL, *watched_fd, NULL);
+    }
+    *watched_fd = bus_transport_fd(&g_bus);
+    struct epoll_event ev = { .events = EPOLLIN };
+    ev.data.fd = *watched_fd;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, *watched_fd, &ev);
+}
+
+/**
+ * @brief Milliseconds until Core0 must run its service pass again
+ */
+static int sil_next_timeout_ms(void) {
+    int timeout_ms = scenario_get_active_layers() ? SIL_POLL_MS : SIL_IDLE_MS;
+    if (g_speed > 0.0) {
+        uint64_t next_us = g_pace_start_us +
+                           (uint64_t)((double)(g_pace_issued + 1) * PHYSICS_TICK_PERIOD_US / g_speed);
+        uint64_t now_us = time_us_64();
+        uint64_t wait_ms = (next_us > now_us) ? (next_us - now_us + 999u) / 1000u : 0;
+        if (wait_ms < (uint64_t)timeout_ms) {
+            timeout_ms = (int)wait_ms;
+        }
+    }
+    uint64_t release_us = rs485_host_next_release_us();
+    if (release_us != UINT64_MAX) {
+        uint64_t now_us = time_us_64();
+        uint64_t wait_ms = (release_us > now_us) ? (release_us - now_us + 999u) / 1000u : 0;
+        if (wait_ms < (uint64_t)timeout_ms) {
+            timeout_ms = (int)wait_ms;
+        }
+    }
+    return timeout_ms;
+}
+
+/**
+ * @brief Run the ticks --speed has made due, each followed by its Core0 pass
+ */
+static void sil_pace_steps(void) {
+    uint64_t due = (uint64_t)((double)(time_us_64() - g_pace_start_us) * g_speed / PHYSICS_TICK_PERIOD_US);
+    for (uint32_t n = 0; g_pace_issued < due && n < SIL_PACE_BATCH; n++) {
+        if (!timebase_step(1)) {
+            printf("[SIL] Tick source set to free-run, --speed pacing stopped\n");
+            g_speed = 0.0;
+            return;
+        }
+        timebase_host_wait_steps();
+        g_pace_issued++;
+        scenario_update();
+    }
+}
+
+/**
+ * @brief Load and activate a JSON scenario in a layer
+ *
+ * Layer 0 uses the engine's RAM image, the others an image of their own.
+ */
+static bool sil_load_scenario(const char* path, uint8_t layer) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "[SIL] Cannot open scenario %s\n", path);
+        return false;
+    }
+
+    static char json[16384];
+    size_t len = fread(json, 1, sizeof(json) - 1, f);
+    fclose(f);
+    json[len] = '\0';
+
+    bool loaded;
+    if (layer == SCENARIO_BASE_LAYER) {
+        loaded = scenario_load(json, len);
+    } else {
+        static uint32_t images[SCENARIO_LAYERS][SCENARIO_RAM_IMAGE_SIZE / 4];
+        scenario_bin_builder_t builder;
+        scenario_bin_begin(&builder, images[layer], sizeof(images[layer]));
+        size_t image_len = 0;
+        if (!json_parse_scenario(json, len, &builder)) {
+            fprintf(stderr, "[SIL] %s: %s\n", path, json_get_last_error());
+        } else if ((image_len = scenario_bin_finish(&builder)) == 0) {
+            fprintf(stderr, "[SIL] %s does not fit a scenario image\n", path);
+        }
+        loaded = image_len != 0 &&
+                 scenario_layer_load_image(layer, (const scenario_bin_header_t*)images[layer],
+                                           image_len);
+    }
+    if (!loaded || !scenario_layer_activate(layer)) {
+        fprintf(stderr, "[SIL] Scenario %s rejected\n", path);
+        return false;
+    }
+    printf("[SIL] Scenario active: %s (layer %u)\n", scenario_layer_get_name(layer),
+           (unsigned)layer);
+    return true;
+}
+
+/**
+ * @brief Read a whole capture file (malloc'd, caller frees)
+ */
+static uint8_t* sil_load_capture(const char* path, size_t* len) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "[SIL] Cannot open capture %s\n", path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t* data = (size > 0) ? malloc((size_t)size) : NULL;
+    if (!data || fread(data, 1, (size_t)size, f) != (size_t)size) {
+        fprintf(stderr, "[SIL] Cannot read capture %s\n", path);
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *len = (size_t)size;
+    return data;
+}
+
+/**
+ * @brief Let the Core0 side finish what the last request started
+ */
+static void sil_replay_settle(void) {
+    nsp_handler_poll();
+    for (uint64_t release_us; (release_us = rs485_host_next_release_us()) != UINT64_MAX;) {
+        uint64_t now_us = time_us_64();
+        if (release_us > now_us) {
+            uint64_t wait_us = release_us - now_us;  // Reply delay (Table 12) is wall time
+            struct timespec ts = { .tv_sec = (time_t)(wait_us / 1000000u),
+                                   .tv_nsec = (long)(wait_us % 1000000u) * 1000 };
+            nanosleep(&ts, NULL);
+        }
+        rs485_host_poll();
+    }
+    timebase_host_wait_steps();  // SIM-STEP requests in the capture
+    scenario_update();
+    dlog_drain(UINT32_MAX);
+}
+
+/**
+ * @brief Run a capture's requests at their recorded ticks (stepped mode)
+ *
+ * @return Process exit status: 0 if every reply matched the golden capture
+ */
+static int sil_replay(const uint8_t* capture, size_t capture_len,
+                      const uint8_t* golden, size_t golden_len) {
+    nsp_replay_reader_t reader;
+    const char* reason = nsp_replay_reader_open(&reader, capture, capture_len);
+    if (!reason) {
+        reason = nsp_replay_reader_open(&g_golden, golden, golden_len);
+    }
+    if (reason) {
+        fprintf(stderr, "[SIL] Replay refused: %s\n", reason);
+        return 1;
+    }
+    if (reader.base_addr != nsp_handler_get_address()) {
+        printf("[SIL] Capture recorded at 0x%02X, emulator at 0x%02X (--addr)\n",
+               (unsigned)reader.base_addr, (unsigned)nsp_handler_get_address());
+    }
+
+    // A tick already taken by a SIM-STEP in the capture is not stepped again
+    uint32_t tick0 = physics_engine_get_tick_count();
+    uint32_t requests = 0;
+    nsp_replay_frame_t frame;
+    slip_decoder_init(&g_reply_dec);
+    g_replaying = true;
+
+    while (!g_stop && nsp_replay_reader_next(&reader, &frame)) {
+        if (frame.dir != NSP_REPLAY_REQUEST) {
+            continue;
+        }
+        while (physics_engine_get_tick_count() - tick0 < frame.tick) {
+            if (!timebase_step(1)) {
+                fprintf(stderr, "[SIL] Tick source set to free-run, replay stopped\n");
+                return 1;
+            }
+            timebase_host_wait_steps();
+            scenario_update();
+        }
+
+        uint8_t slip[NSP_MAX_PACKET_SIZE * 2 + 2];
+        size_t slip_len = 0;
+        slip_encode(frame.data, frame.len, slip, &slip_len);
+        if (g_record_file) {
+            nsp_replay_rec_bytes(&g_recorder, NSP_REPLAY_REQUEST, slip, slip_len,
+                                 timebase_get_sim_us());
+        }
+        timebase_host_hold_steps();
+        rs485_host_receive(slip, slip_len);
+        sil_replay_settle();
+        requests++;
+    }
+
+    // Golden replies never produced
+    nsp_replay_frame_t want;
+    uint32_t missing = 0;
+    while (nsp_replay_reader_next(&g_golden, &want)) {
+        missing += (want.dir == NSP_REPLAY_REPLY);
+    }
+    g_mismatches += missing;
+    g_replaying = false;
+
+    printf("[SIL] Replay: %lu requests, %lu replies, %lu missing, %lu differences\n",
+           (unsigned long)requests, (unsigned long)g_replies, (unsigned long)missing,
+           (unsigned long)g_mismatches);
+    return (g_mismatches == 0) ? 0 : 1;
+}
+
+static void sil_usage(const char* argv0) {
+    fprintf(stderr, "Usage: %s [--addr N] [--bus ENDPOINT] [--flash IMAGE] [--scenario FILE.json]...\n"
+                    "          [--lockstep | --speed X] [--record FILE] [--replay FILE [--golden FILE]]\n"
+                    "  ENDPOINT: stdio (default), tcp:HOST:PORT, tcp-listen:PORT, udp:PORT, pty[:LINK],\n"
+                    "            serial:DEV[:BAUD]\n"
+                    "  --scenario: repeat to layer scenarios (layer 0 first, at most %u)\n"
+                    "  --lockstep: physics ticks only on NSP SIM-STEP (0x0C) requests\n"
+                    "  --speed X:  step physics at X times real time (e.g. 100)\n"
+                    "  --record:   capture the bus traffic (NSP replay format)\n"
+                    "  --replay:   run a capture, compare the replies with it (or --golden)\n",
+            argv0, (unsigned)SCENARIO_LAYERS);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    uint8_t device_addr = 0;
+    const char* flash_path = NULL;
+    const char* scenario_paths[SCENARIO_LAYERS];
+    uint8_t scenario_count = 0;
+    const char* bus_spec = "stdio";
+    const char* record_path = NULL;
+    const char* replay_path = NULL;
+    const char* golden_path = NULL;
+    bool lockstep = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--addr") == 0 && i + 1 < argc) {
+            unsigned long addr = strtoul(argv[++i], NULL, 0);
+            if (addr > NSP_ADDR_MAX) {
+                sil_usage(argv[0]);
+                return 2;
+            }
+            device_addr = (uint8_t)addr;
+        } else if (strcmp(argv[i], "--bus") == 0 && i + 1 < argc) {
+            bus_spec = argv[++i];
+        } else if (strcmp(argv[i], "--flash") == 0 && i + 1 < argc) {
+            flash_path = argv[++i];
+        } else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+            if (scenario_count == SCENARIO_LAYERS) {
+                sil_usage(argv[0]);
+                return 2;
+            }
+            scenario_paths[scenario_count++] = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            golden_path = argv[++i];
+        } else if (strcmp(argv[i], "--lockstep") == 0) {
+            lockstep = true;
+        } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc && atof(argv[i + 1]) > 0.0) {
+            g_speed = atof(argv[++i]);
+        } else {
+            sil_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (golden_path && !replay_path) {
+        sil_usage(argv[0]);
+        return 2;
+    }
+
+    // --replay: the capture replaces the bus and the tick source
+    uint8_t* capture = NULL;
+    uint8_t* golden = NULL;
+    size_t capture_len = 0;
+    size_t golden_len = 0;
+    if (replay_path) {
+        capture = sil_load_capture(replay_path, &capture_len);
+        golden = golden_path ? sil_load_capture(golden_path, &golden_len) : NULL;
+        if (!capture || (golden_path && !golden)) {
+            return 1;
+        }
+        bus_spec = "stdio";
+        lockstep = false;
+        g_speed = 0.0;
+    }
+
+    if (!bus_transport_open(&g_bus, bus_spec)) {
+        return 1;
+    }
+    if (g_bus.kind == BUS_TRANSPORT_STDIO && !replay_path) {
+        // stdout carries the bus; everything the firmware prints goes to stderr
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+    }
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    signal(SIGINT, sil_signal);
+    signal(SIGTERM, sil_signal);
+    signal(SIGPIPE, SIG_IGN);
+
+    printf("NRWA-T6 Emulator %s (host SIL) | %s profile | %u Hz physics | %u wheel(s) at 0x%02X\n",
+           FIRMWARE_VERSION, WHEEL_PROFILE_NAME, (unsigned)PHYSICS_TICK_RATE_HZ,
+           (unsigned)EMULATED_WHEEL_COUNT, device_addr);
+
+    if (flash_path && !flash_store_host_attach(flash_path)) {
+        fprintf(stderr, "[SIL] Cannot open flash image %s\n", flash_path);
+        bus_transport_close(&g_bus);
+        return 1;
+    }
+
+    // Same order as the firmware: sync, NSP, physics, then commands
+    core_sync_init();
+    if (!nsp_handler_init(device_addr)) {
+        bus_transport_close(&g_bus);
+        return 1;
+    }
+    rs485_host_set_tx_sink(sil_bus_write, NULL);
+
+    physics_engine_init(g_wheel_states, NULL);
+    commands_init_wheels(g_wheel_states, EMULATED_WHEEL_COUNT);
+    scenario_engine_init();     // Firmware does this in table_config_init()
+
+    timebase_init(sil_physics_tick);
+    if (lockstep || g_speed > 0.0 || replay_path) {
+        timebase_set_mode(TIMEBASE_STEPPED);   // Before the first tick
+        printf("[SIL] Tick source: %s\n", replay_path ? "capture replay" :
+                                           lockstep ? "NSP SIM-STEP" : "paced steps");
+    }
+    timebase_start();
+    // No spare IRQ or alarm pool on the host: both stay in polled mode
+    nsp_handler_start_service();
+    scenario_start_service();
+
+    for (uint8_t layer = 0; layer < scenario_count; layer++) {
+        if (!sil_load_scenario(scenario_paths[layer], layer)) {
+            timebase_stop();
+            bus_transport_close(&g_bus);
+            return 1;
+        }
+    }
+
+    if (record_path) {
+        g_record_file = fopen(record_path, "wb");
+        if (!g_record_file) {
+            fprintf(stderr, "[SIL] Cannot create capture %s\n", record_path);
+            timebase_stop();
+            bus_transport_close(&g_bus);
+            return 1;
+        }
+        nsp_replay_rec_begin(&g_recorder, device_addr, timebase_get_sim_us(),
+                             sil_record_write, g_record_file);
+    }
+
+    int status = 0;
+    if (replay_path) {
+        status = sil_replay(capture, capture_len, golden ? golden : capture,
+                            golden ? golden_len : capture_len);
+        g_stop = 1;  // Skip the bus loop
+    }
+
+    if (g_speed > 0.0) {
+        printf("[SIL] Running at %gx real time\n", g_speed);
+        g_pace_start_us = time_us_64();
+    }
+
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    int watched_fd = -1;
+    sil_bus_watch(epfd, &watched_fd);
+    uint8_t buf[512];
+
+    while (!g_stop) {
+        struct epoll_event ev;
+        int ready = epoll_wait(epfd, &ev, 1, sil_next_timeout_ms());
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+        if (ready > 0) {
+            ssize_t n = bus_transport_read(&g_bus, buf, sizeof(buf));
+            if (n < 0 && n != BUS_TRANSPORT_FD_CHANGED) {
+                break;  // Bus closed
+            }
+            if (n == BUS_TRANSPORT_FD_CHANGED) {
+                sil_bus_watch(epfd, &watched_fd);
+            } else if (n > 0) {
+                if (g_record_file) {
+                    nsp_replay_rec_bytes(&g_recorder, NSP_REPLAY_REQUEST, buf, (size_t)n,
+                                         timebase_get_sim_us());
+                }
+                if (lockstep) {
+                    timebase_host_hold_steps();  // Released by the wait below
+                }
+                rs485_host_receive(buf, (size_t)n);
+            }
+        }
+
+        nsp_handler_poll();
+        rs485_host_poll();
+        if (lockstep) {
+            timebase_host_wait_steps();  // SIM-STEP batch done before event checks
+        }
+        scenario_update();
+        stats_update(time_us_64());
+        dlog_drain(UINT32_MAX);
+        if (g_speed > 0.0) {
+            sil_pace_steps();
+        }
+    }
+
+    timebase_stop();
+    dlog_drain(UINT32_MAX);
+    close(epfd);
+    printf("[SIL] Stopped after %lu physics ticks, sim time %.3f s (%lu bus bytes dropped)\n",
+           (unsigned long)physics_engine_get_tick_count(), (double)timebase_get_sim_us() / 1e6,
+           (unsigned long)g_bus.tx_dropped);
+    if (g_record_file) {
+        printf("[SIL] Captured %lu frames to %s\n", (unsigned long)g_recorder.records, record_path);
+        fclose(g_record_file);
+    }
+    bus_transport_close(&g_bus);
+    free(capture);
+    free(golden);
+    return status;
+}
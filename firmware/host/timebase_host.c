@@ -0,0 +1,330 @@
+/**
+ * @file timebase_host.c
+ * @brief Host HAL: Physics Tick Thread
+ *
+ * Same API and statistics as platform/timebase.c. The hardware alarm ISR
+ * becomes a thread that sleeps to each absolute tick deadline and calls
+ * the tick callback itself, so the host's "Core1" is idle between ticks
+ * instead of spinning. The cycle counter counts nanoseconds.
+ *
+ * In stepped mode the thread waits on a condition variable for requested
+ * steps instead of the clock and runs them back to back. There is no
+ * SYNC_IN_PIN on the host; the simulator steps through timebase_step()
+ * (or NSP SIM-STEP) and can wait for completion with
+ * timebase_host_wait_steps().
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "board_pico.h"
+#include "timebase.h"
+#include "timebase_host.h"
+#include "util/latency_hist.h"
+#include "pico/platform.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+// ============================================================================
+// Static Variables
+// ============================================================================
+
+static timebase_tick_callback_t tick_callback = NULL;
+static volatile uint32_t tick_count = 0;
+static volatile uint32_t max_jitter_us = 0;
+static latency_hist_t wake_hist;
+static volatile uint32_t last_wake_us = 0;
+
+static pthread_t tick_thread;
+static volatile bool tick_running = false;
+
+// Stepped mode: everything below is guarded by step_lock
+static pthread_mutex_t step_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t step_wake = PTHREAD_COND_INITIALIZER;    // Steps requested / mode or run change
+static pthread_cond_t step_done = PTHREAD_COND_INITIALIZER;    // Pending reached zero
+static timebase_mode_t tick_mode = TIMEBASE_FREE_RUN;
+static uint32_t steps_requested = 0;
+static uint32_t steps_taken = 0;
+static uint32_t steps_per_pulse = 1;
+static bool steps_held = false;     // timebase_host_hold_steps() until the next wait
+static uint64_t sim_entry_us = 0;
+static uint32_t sim_entry_steps = 0;
+static int64_t sim_offset_us = 0;
+
+static uint64_t sim_us_locked(void) {
+    if (tick_mode == TIMEBASE_STEPPED) {
+        return sim_entry_us + (uint64_t)(steps_taken - sim_entry_steps) * PHYSICS_TICK_PERIOD_US;
+    }
+    return (uint64_t)((int64_t)time_us_64() + sim_offset_us);
+}
+
+// ============================================================================
+// Tick Thread
+// ============================================================================
+
+/**
+ * @brief Run requested steps until free-run resumes or the thread stops
+ */
+static void timebase_run_steps(void) {
+    pthread_mutex_lock(&step_lock);
+    while (tick_running && tick_mode == TIMEBASE_STEPPED) {
+        if (steps_held || steps_requested == steps_taken) {
+            pthread_cond_wait(&step_wake, &step_lock);
+            continue;
+        }
+        pthread_mutex_unlock(&step_lock);
+
+        if (timebase_take_step() && tick_callback != NULL) {
+            tick_callback();
+        }
+
+        pthread_mutex_lock(&step_lock);
+        if (steps_requested == steps_taken) {
+            pthread_cond_broadcast(&step_done);
+        }
+    }
+    pthread_cond_broadcast(&step_done);
+    pthread_mutex_unlock(&step_lock);
+}
+
+static void* timebase_tick_thread(void* arg) {
+    (void)arg;
+    host_core_num = 1;
+    uint64_t next_tick_us = time_us_64() + PHYSICS_TICK_PERIOD_US;
+
+    while (tick_running) {
+        if (tick_mode == TIMEBASE_STEPPED) {
+            timebase_run_steps();
+            next_tick_us = time_us_64() + PHYSICS_TICK_PERIOD_US;
+            continue;
+        }
+
+        sleep_until(next_tick_us);
+        if (tick_mode == TIMEBASE_STEPPED) {
+            continue;   // Switched while asleep: this deadline is void
+        }
+
+        uint64_t now_us = time_us_64();
+        uint32_t late_us = (uint32_t)(now_us - next_tick_us);
+        if (late_us > max_jitter_us) {
+            max_jitter_us = late_us;
+        }
+        last_wake_us = late_us;
+        latency_hist_record(&wake_hist, late_us);
+
+        tick_count++;
+        if (tick_callback != NULL) {
+            tick_callback();
+        }
+
+        // Absolute schedule; after a stall (debugger, overloaded host)
+        // restart from now rather than bursting the missed ticks
+        next_tick_us += PHYSICS_TICK_PERIOD_US;
+        if (time_us_64() > next_tick_us + PHYSICS_TICK_PERIOD_US) {
+            next_tick_us = time_us_64() + PHYSICS_TICK_PERIOD_US;
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void timebase_init(timebase_tick_callback_t callback) {
+    tick_callback = callback;
+    tick_count = 0;
+    max_jitter_us = 0;
+    last_wake_us = 0;
+    latency_hist_reset(&wake_hist);
+    printf("[Timebase] Host tick thread configured (period=%u us, rate=%u Hz)\n",
+           (unsigned)PHYSICS_TICK_PERIOD_US, (unsigned)PHYSICS_TICK_RATE_HZ);
+}
+
+void timebase_start(void) {
+    if (tick_running) {
+        return;
+    }
+    tick_running = true;
+    if (pthread_create(&tick_thread, NULL, timebase_tick_thread, NULL) != 0) {
+        tick_running = false;
+        printf("[Timebase] ERROR: Could not start tick thread\n");
+    }
+}
+
+void timebase_stop(void) {
+    if (!tick_running) {
+        return;
+    }
+    pthread_mutex_lock(&step_lock);
+    tick_running = false;
+    pthread_cond_broadcast(&step_wake);
+    pthread_mutex_unlock(&step_lock);
+    pthread_join(tick_thread, NULL);
+    printf("[Timebase] Timer stopped (total ticks: %u)\n", (unsigned)tick_count);
+}
+
+uint32_t timebase_get_tick_count(void) {
+    return tick_count;
+}
+
+uint64_t timebase_get_us(void) {
+    return time_us_64();
+}
+
+uint32_t timebase_get_ms(void) {
+    return (uint32_t)(time_us_64() / 1000);
+}
+
+uint32_t timebase_get_max_jitter_us(void) {
+    return max_jitter_us;
+}
+
+void timebase_reset_jitter_stats(void) {
+    max_jitter_us = 0;
+    last_wake_us = 0;
+    latency_hist_reset(&wake_hist);
+}
+
+uint32_t timebase_get_last_wake_us(void) {
+    return last_wake_us;
+}
+
+bool timebase_get_next_tick_us(uint32_t* next_us) {
+    // Host flash writes never stall the tick thread: nothing to fit around
+    (void)next_us;
+    return false;
+}
+
+bool timebase_schedule_oneshot(uint32_t at_us, timebase_tick_callback_t callback) {
+    // No sub-tick outputs on the host: callers act at once
+    (void)at_us;
+    (void)callback;
+    return false;
+}
+
+void timebase_cancel_oneshot(void) {
+}
+
+void timebase_get_wake_latency(latency_summary_t* summary) {
+    if (summary) latency_hist_summarize(&wake_hist, summary);
+}
+
+void timebase_set_mode(timebase_mode_t mode) {
+    pthread_mutex_lock(&step_lock);
+    if (mode == tick_mode) {
+        pthread_mutex_unlock(&step_lock);
+        return;
+    }
+    uint64_t sim_now_us = sim_us_locked();
+    if (mode == TIMEBASE_STEPPED && !tick_running && tick_count == 0) {
+        sim_now_us = 0;     // Stepped from the start: sim time does not depend on host startup
+    }
+    if (mode == TIMEBASE_STEPPED) {
+        sim_entry_us = sim_now_us;
+        sim_entry_steps = steps_taken;
+    } else {
+        sim_offset_us = (int64_t)sim_now_us - (int64_t)time_us_64();
+    }
+    steps_requested = steps_taken;  // Nothing pending in either direction
+    tick_mode = mode;
+    pthread_cond_broadcast(&step_wake);
+    pthread_mutex_unlock(&step_lock);
+}
+
+timebase_mode_t timebase_get_mode(void) {
+    return tick_mode;
+}
+
+bool timebase_step(uint32_t ticks) {
+    pthread_mutex_lock(&step_lock);
+    bool stepped = (tick_mode == TIMEBASE_STEPPED);
+    if (stepped) {
+        steps_requested += ticks;
+        pthread_cond_broadcast(&step_wake);
+    }
+    pthread_mutex_unlock(&step_lock);
+    return stepped;
+}
+
+void timebase_set_steps_per_pulse(uint32_t ticks) {
+    steps_per_pulse = ticks;    // Kept for the console; no sync pin on the host
+}
+
+uint32_t timebase_get_steps_per_pulse(void) {
+    return steps_per_pulse;
+}
+
+uint32_t timebase_get_pending_steps(void) {
+    pthread_mutex_lock(&step_lock);
+    uint32_t pending = (tick_mode == TIMEBASE_STEPPED) ? steps_requested - steps_taken : 0;
+    pthread_mutex_unlock(&step_lock);
+    return pending;
+}
+
+bool timebase_take_step(void) {
+    pthread_mutex_lock(&step_lock);
+    bool take = (tick_mode == TIMEBASE_STEPPED && steps_requested != steps_taken);
+    if (take) {
+        steps_taken++;
+        tick_count++;
+        last_wake_us = 0;
+    }
+    pthread_mutex_unlock(&step_lock);
+    return take;
+}
+
+uint64_t timebase_get_sim_us(void) {
+    pthread_mutex_lock(&step_lock);
+    uint64_t sim_us = sim_us_locked();
+    pthread_mutex_unlock(&step_lock);
+    return sim_us;
+}
+
+void timebase_set_pps_enabled(bool enabled) {
+    (void)enabled;  // No PPS input on the host: the tick thread follows CLOCK_MONOTONIC
+}
+
+void timebase_get_pps_stats(timebase_pps_stats_t* stats) {
+    if (stats) {
+        *stats = (timebase_pps_stats_t){ .state = TIMEBASE_PPS_OFF,
+                                         .period_ns = PHYSICS_TICK_PERIOD_US * 1000u };
+    }
+}
+
+void timebase_host_hold_steps(void) {
+    pthread_mutex_lock(&step_lock);
+    steps_held = true;
+    pthread_mutex_unlock(&step_lock);
+}
+
+void timebase_host_wait_steps(void) {
+    pthread_mutex_lock(&step_lock);
+    if (steps_held) {
+        steps_held = false;
+        pthread_cond_broadcast(&step_wake);
+    }
+    while (tick_running && tick_mode == TIMEBASE_STEPPED && steps_requested != steps_taken) {
+        pthread_cond_wait(&step_done, &step_lock);
+    }
+    pthread_mutex_unlock(&step_lock);
+}
+
+void timebase_cycle_counter_start(void) {
+    // CLOCK_MONOTONIC is always running
+}
+
+uint32_t timebase_get_cycles(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec) &
+           TIMEBASE_CYCLE_MASK;
+}
+
+void timebase_delay_us(uint32_t us) {
+    busy_wait_us(us);
+}
+
+void timebase_delay_ms(uint32_t ms) {
+    busy_wait_us_32(ms * 1000);
+}
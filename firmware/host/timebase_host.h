@@ -0,0 +1,28 @@
+/**
+ * @file timebase_host.h
+ * @brief Host HAL: Lockstep Helpers for the Tick Thread
+ */
+
+#ifndef TIMEBASE_HOST_H
+#define TIMEBASE_HOST_H
+
+/**
+ * @brief Keep the tick thread from starting queued steps until the next wait
+ *
+ * While a batch of bus input is handled, SIM-STEP replies then always
+ * report the steps as pending instead of racing the tick thread, so a
+ * recorded run replays byte for byte.
+ */
+void timebase_host_hold_steps(void);
+
+/**
+ * @brief Wait until the tick thread has run every requested step
+ *
+ * Releases timebase_host_hold_steps() first. Returns at once in free-run or
+ * when the tick thread is not running. A simulator that must see the
+ * result of its steps (or keep Core0 work such as scenario events on exact
+ * ticks) calls this after timebase_step().
+ */
+void timebase_host_wait_steps(void);
+
+#endif // TIMEBASE_HOST_H
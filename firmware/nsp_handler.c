@@ -7,7 +7,19 @@
 #include "drivers/rs485_uart.h"
 #include "drivers/slip.h"
 #include "drivers/nsp.h"
+#include "hot_path.h"
 #include "device/nss_nrwa_t6_commands.h"
+#include "util/core_sync.h"
+#include "util/profiler.h"
+#include "util/latency_hist.h"
+#include "util/nsp_trace.h"
+#include "util/bus_mon.h"
+#include "util/bus_meter.h"
+#include "util/stats.h"
+#include "config/scenario.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -15,9 +27,8 @@
 // Internal State
 // ============================================================================
 
-static slip_decoder_t slip_decoder;
-static uint8_t slip_output_buf[NSP_MAX_PACKET_SIZE];
-static uint8_t device_addr = 0;
+static nsp_rx_t nsp_rx;                  // Fused SLIP/CRC/header receiver
+static uint8_t device_addr = 0;               // Base address (wheel 0)
 
 // Statistics
 static uint32_t rx_packet_count = 0;
@@ -30,6 +41,7 @@ static uint32_t slip_error_count = 0;
 static uint32_t nsp_parse_error_count = 0;
 static uint32_t wrong_addr_count = 0;
 static uint32_t cmd_dispatch_error_count = 0;
+static uint32_t reply_frame_hit_count = 0;      // Replies copied from a cached frame
 
 // Last error details (for debugging)
 static uint32_t last_parse_error_code = 0;     // Last NSP parse error code (0=none, 1-4=error)
@@ -42,26 +54,243 @@ static uint32_t last_rx_cmd_len = 0;           // Length of last RX command
 // Debug flag (set to false to disable verbose logging after initial testing)
 static bool debug_rx = false;
 
+// Event-driven service (see nsp_handler_start_service)
+static int service_irq = -1;                    // Claimed user IRQ (-1 = polled mode)
+static uint32_t service_online_us = 0;          // time_us_32() when the service started
+static volatile bool rx_frame_stamp_valid = false;
+static volatile uint32_t rx_frame_stamp_us = 0; // Arrival of oldest unserviced frame END
+static uint32_t service_t0_us = 0;              // Reference time for current service pass
+static volatile uint32_t reply_t0_us = 0;       // Reference time for reply on the wire
+
+// Request-to-reply turnaround (frame END received -> reply fully on the wire)
+static uint32_t last_turnaround_us = 0;
+static uint32_t max_turnaround_us = 0;
+
+// Per-command latency histograms (index = command code), measured from the
+// request's SLIP END to the reply's first start bit and to its last stop bit
+static latency_hist_t reply_start_hist[NSP_CMD_TABLE_SIZE];
+static latency_hist_t reply_end_hist[NSP_CMD_TABLE_SIZE];
+static volatile uint8_t reply_cmd = 0;          // Command of the reply on the wire
+
+// Bus meter (console side): baud the meter was last reset for
+static uint32_t meter_baud = 0;
+
+#if PROFILER_ENABLED
+static uint32_t rx_frame_cycles = 0;            // Receiver cycles spent on the frame in progress
+#endif
+
+// Load generator input (nsp_handler_inject): whole SLIP frames the service
+// reads ahead of the bus. The injector owns head, the service tail and pos.
+static uint8_t inject_buf[NSP_INJECT_SLOTS][NSP_INJECT_MAX_FRAME];
+static uint8_t inject_len[NSP_INJECT_SLOTS];
+static volatile uint32_t inject_head = 0;
+static volatile uint32_t inject_tail = 0;
+static uint32_t inject_pos = 0;
+
+// Hardware RESET (nsp_handler_enter_reset() / nsp_handler_leave_reset(),
+// written by Core1; the service only reads them)
+#define RESET_IDLE      0
+#define RESET_HELD      1
+#define RESET_BOOTING   2
+static volatile uint32_t reset_seq = 0;         // Bumped on every assertion
+static volatile uint8_t reset_state = RESET_IDLE;
+static volatile uint32_t reset_ready_us = 0;    // End of the boot window
+static uint32_t reset_seen = 0;                 // Service copy of reset_seq
+static bool reset_passed = true;                // Service: boot window over
+static uint32_t reset_dropped_count = 0;        // Bytes dropped while in reset
+
+// Bus monitor: decoded copy of our own reply for the capture ring
+static uint8_t monitor_tx_frame[BUS_MON_SNAPLEN];
+
+_Static_assert(BUS_MON_SNAPLEN >= NSP_MAX_PACKET_SIZE, "bus monitor must keep whole NSP frames");
+
+static void HOT_PATH_FUNC(nsp_tx_done)(void);
+
+/**
+ * @brief Next receiver byte: injected frames first, then the bus
+ *
+ * @param injected Output: the byte came from nsp_handler_inject()
+ */
+static inline bool next_rx_byte(uint8_t* byte, bool* injected) {
+    uint32_t tail = inject_tail;
+    if (tail != inject_head) {
+        __dmb();    // Slot contents after the index that published them
+        uint32_t slot = tail % NSP_INJECT_SLOTS;
+        *byte = inject_buf[slot][inject_pos++];
+        if (inject_pos >= inject_len[slot]) {
+            inject_pos = 0;
+            inject_tail = tail + 1;
+        }
+        *injected = true;
+        return true;
+    }
+    *injected = false;
+    return rs485_read_byte(byte);
+}
+
+/**
+ * @brief Widen a time_us_32() stamp from the recent past to 64 bits
+ */
+static inline uint64_t monitor_time64(uint32_t us) {
+    uint64_t now = time_us_64();
+    return now - (uint32_t)((uint32_t)now - us);
+}
+
+/**
+ * @brief Map a receiver verdict onto the capture record's
+ */
+static inline uint8_t monitor_verdict(nsp_result_t result) {
+    switch (result) {
+        case NSP_OK:             return BUS_MON_OK;
+        case NSP_ERR_TOO_SHORT:  return BUS_MON_TOO_SHORT;
+        case NSP_ERR_BAD_LENGTH: return BUS_MON_TOO_LONG;
+        default:                 return BUS_MON_BAD_CRC;
+    }
+}
+
+/**
+ * @brief Capture a received frame (bus monitor on)
+ *
+ * @param flags BUS_MON_F_*
+ * @param verdict bus_mon_verdict_t
+ * @param stamped true if end_us is the END byte's arrival from the driver;
+ *                otherwise the service reference time is recorded instead
+ * @param end_us Arrival of the frame's END byte (time_us_32())
+ */
+static void HOT_PATH_FUNC(monitor_capture_rx)(uint8_t flags, uint8_t verdict,
+                                              bool stamped, uint32_t end_us) {
+    if (!stamped) {
+        end_us = service_t0_us;
+        flags |= BUS_MON_F_STAMP_EST;
+    }
+    if (verdict == BUS_MON_TOO_LONG) {
+        flags |= BUS_MON_F_TRUNC;
+    }
+    size_t len = (verdict == BUS_MON_SLIP_ERROR) ? 0 : nsp_rx.len;
+    bus_mon_capture(monitor_time64(end_us), flags, verdict, nsp_rx.buf, len);
+}
+
+/**
+ * @brief Capture our own reply (bus monitor CAPTURE mode)
+ *
+ * @param slip SLIP-framed reply as sent
+ * @param slip_len Encoded length
+ * @param start_us First start bit on the wire (µs since boot)
+ */
+static void HOT_PATH_FUNC(monitor_capture_tx)(const uint8_t* slip, size_t slip_len,
+                                              uint64_t start_us) {
+    slip_decoder_t dec;
+    slip_decoder_init(&dec);
+    size_t len = 0;
+    for (size_t i = 0; i < slip_len; i++) {
+        uint8_t data;
+        if (slip_decode_step(&dec, slip[i], &data) == SLIP_EVENT_DATA &&
+            len < sizeof(monitor_tx_frame)) {
+            monitor_tx_frame[len++] = data;
+        }
+    }
+    bus_mon_capture(start_us, BUS_MON_F_TX | BUS_MON_F_OURS, BUS_MON_OK, monitor_tx_frame, len);
+}
+
+/**
+ * @brief Append the frame just handled to the transaction trace
+ *
+ * @param frame Decoded frame (header bytes not present are traced as 0)
+ * @param frame_len Decoded length
+ * @param outcome nsp_trace_outcome_t
+ * @param detail Parse error code or injection flags
+ * @param reply_us Frame END to reply start (0 = no reply)
+ * @param reply_len SLIP reply bytes (0 = no reply)
+ */
+static void HOT_PATH_FUNC(trace_frame)(const uint8_t* frame, size_t frame_len, uint8_t outcome,
+                                       uint8_t detail, uint32_t reply_us, size_t reply_len) {
+    nsp_trace_entry_t entry;
+    entry.rx_us = service_t0_us;
+    entry.reply_us = reply_us;
+    entry.dest = (frame_len > 0) ? frame[0] : 0;
+    entry.src = (frame_len > 1) ? frame[1] : 0;
+    entry.ctrl = (frame_len > 2) ? frame[2] : 0;
+    entry.outcome = outcome;
+    entry.detail = detail;
+    entry.frame_len = (frame_len > 0xFF) ? 0xFF : (uint8_t)frame_len;
+    entry.reply_len = (uint16_t)reply_len;
+    nsp_trace_record(&entry);
+}
+
 // ============================================================================
 // Initialization
 // ============================================================================
 
-void nsp_handler_init(uint8_t device_address) {
+/**
+ * @brief Start the receiver from idle (at init and after a hardware RESET)
+ *
+ * @return Address accept mask
+ */
+static uint8_t rx_start(void) {
+    // Streaming receiver (SLIP decode + CRC + address filter). Wheel k of
+    // the cluster answers base + k (range checked in nsp_handler_init).
+    nsp_rx_init(&nsp_rx, device_addr);
+    uint8_t accept_mask = 0;
+    for (uint32_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        accept_mask |= (uint8_t)(1u << (device_addr + w));
+    }
+    nsp_rx_set_accept_mask(&nsp_rx, accept_mask);
+    return accept_mask;
+}
+
+/**
+ * @brief Follow the hardware RESET state (service context)
+ *
+ * The receiver restarts on every assertion; bytes are dropped until the
+ * boot window after the release is over.
+ *
+ * @return true while in reset (drop the input)
+ */
+static bool HOT_PATH_FUNC(reset_gate)(void) {
+    uint32_t seq = reset_seq;
+    if (seq != reset_seen) {
+        reset_seen = seq;
+        reset_passed = false;
+        rx_start();
+    }
+    if (reset_passed) {
+        return false;
+    }
+    if (reset_state == RESET_BOOTING && (int32_t)(time_us_32() - reset_ready_us) >= 0) {
+        reset_passed = true;  // Latched here: no wrap in the comparison later
+        return false;
+    }
+    return true;
+}
+
+bool nsp_handler_init(uint8_t device_address) {
+    // Every wheel of the cluster needs its own unicast address
+    if (device_address > NSP_ADDR_MAX + 1 - EMULATED_WHEEL_COUNT) {
+        printf("[NSP] ERROR: Address 0x%02X out of range (0x00-0x%02X for %u wheel(s))\n",
+               device_address, (unsigned)(NSP_ADDR_MAX + 1 - EMULATED_WHEEL_COUNT),
+               (unsigned)EMULATED_WHEEL_COUNT);
+        return false;
+    }
     device_addr = device_address;
 
     // Initialize RS-485
     if (!rs485_init()) {
         printf("[NSP] ERROR: RS-485 init failed\n");
-        return;
+        return false;
     }
     printf("[NSP] RS-485 initialized (460.8 kbps)\n");
+    rs485_set_tx_done_callback(nsp_tx_done);
+
+    // END arrival stamps feed the bus meter's gap figures and the monitor
+    rs485_set_rx_stamping(true);
+    meter_baud = 0;
 
-    // Initialize SLIP decoder
-    slip_decoder_init(&slip_decoder);
+    uint8_t accept_mask = rx_start();
 
     // Initialize NSP subsystem
     nsp_init(device_addr);
-    printf("[NSP] NSP handler initialized (addr=0x%02X)\n", device_addr);
+    printf("[NSP] NSP handler initialized (addr=0x%02X, %u wheel(s), mask=0x%02X)\n",
+           device_addr, (unsigned)EMULATED_WHEEL_COUNT, accept_mask);
 
     // Reset statistics
     rx_packet_count = 0;
@@ -74,210 +303,493 @@ void nsp_handler_init(uint8_t device_address) {
     nsp_parse_error_count = 0;
     wrong_addr_count = 0;
     cmd_dispatch_error_count = 0;
+    reply_frame_hit_count = 0;
     last_parse_error_code = 0;
     last_cmd_error_code = 0;
     last_frame_len = 0;
     last_rx_cmd_len = 0;
+    last_turnaround_us = 0;
+    max_turnaround_us = 0;
+    nsp_handler_reset_latency();
     memset(last_frame_bytes, 0, sizeof(last_frame_bytes));
     memset(last_rx_cmd_bytes, 0, sizeof(last_rx_cmd_bytes));
+    return true;
 }
 
 // ============================================================================
 // Packet Handler
 // ============================================================================
 
-void nsp_handler_poll(void) {
-    // Check if data available on RS-485
+/**
+ * @brief Drain the RX ring through SLIP/NSP/dispatch/reply
+ *
+ * Runs either from the NSP service IRQ (normal operation) or directly from
+ * nsp_handler_poll() before the service has been started. Never both.
+ */
+static void HOT_PATH_FUNC(nsp_handler_process)(void) {
+    // Check if data available on RS-485 (or injected by the load generator)
     size_t available = rs485_available();
-    if (available == 0) {
+    if (available == 0 && inject_tail == inject_head) {
         return;  // No data - return immediately
     }
 
-    // Read and process bytes through SLIP decoder
+    // A unit in reset does not listen: the bytes go nowhere
     uint8_t byte;
-    while (rs485_read_byte(&byte)) {
-        rx_byte_count++;
+    bool injected;
+    if (reset_gate()) {
+        while (next_rx_byte(&byte, &injected)) {
+            if (!injected) {
+                rx_byte_count++;
+            }
+            reset_dropped_count++;
+        }
+        core_sync_ring(CORE_SYNC_BELL_BUS);
+        return;
+    }
+
+    // Bus monitor: keep frames for other nodes too
+    bus_mon_mode_t monitor = bus_mon_get_mode();
+    nsp_rx_set_keep_all(&nsp_rx, monitor != BUS_MON_OFF);
+
+    // Read and process bytes through SLIP decoder
+    uint32_t rx_new = 0;
+    while (next_rx_byte(&byte, &injected)) {
+        if (!injected) {
+            rx_byte_count++;  // Wire bytes only
+            rx_new++;
+        }
 
         if (debug_rx) {
             printf("[RX] Byte: 0x%02X\n", byte);
         }
 
-        size_t decoded_len;
-
-        // Feed byte to SLIP decoder
-        if (slip_decode_byte(&slip_decoder, byte, slip_output_buf, &decoded_len)) {
-            // Complete SLIP frame received
-            if (slip_decoder.frame_error) {
-                // SLIP decode error
-                slip_error_count++;
-                error_count++;
-                if (debug_rx) {
-                    printf("[NSP] SLIP decode error (frame corrupted)\n");
-                }
-                slip_decoder_reset(&slip_decoder);
-                continue;
-            }
+        // Feed byte to the receiver: SLIP, CRC and header in one pass
+        PROF_BEGIN(PROF_NSP_SLIP);
+        nsp_rx_event_t ev = nsp_rx_byte(&nsp_rx, byte);
+        PROF_ACCUM(PROF_NSP_SLIP, rx_frame_cycles);
+        if (ev == NSP_RX_NONE) {
+            continue;
+        }
+        PROF_COMMIT(PROF_NSP_SLIP, rx_frame_cycles);
 
-            // Valid SLIP frame decoded
-            slip_frames_ok_count++;
+        uint32_t end_us = 0;
+        bool end_stamped = (byte == SLIP_END) && !injected && rs485_rx_delimiter_time(&end_us);
+        if (end_stamped) {
+            bus_meter_rx_frame(end_us, rx_byte_count + tx_byte_count);
+        }
 
-            // Save last frame for debugging (first 32 bytes)
-            last_frame_len = decoded_len;
-            size_t copy_len = decoded_len < sizeof(last_frame_bytes) ? decoded_len : sizeof(last_frame_bytes);
-            memcpy(last_frame_bytes, slip_output_buf, copy_len);
+        if (ev == NSP_RX_SLIP_ERROR) {
+            if (monitor != BUS_MON_OFF) {
+                monitor_capture_rx(0, BUS_MON_SLIP_ERROR, end_stamped, end_us);
+            }
+            slip_error_count++;
+            error_count++;
+            trace_frame(NULL, 0, NSP_TRACE_SLIP_ERROR, 0, 0, 0);
+            if (debug_rx) {
+                printf("[NSP] SLIP decode error (frame corrupted)\n");
+            }
+            continue;
+        }
 
+        if (ev == NSP_RX_FILTERED) {
+            // Not for us - rejected on byte 0 (multi-drop bus)
+            if (monitor != BUS_MON_OFF) {
+                monitor_capture_rx(0, monitor_verdict(nsp_rx_check(&nsp_rx)), end_stamped, end_us);
+            }
+            wrong_addr_count++;
+            trace_frame(&nsp_rx.dest, 1, NSP_TRACE_WRONG_ADDR, 0, 0, 0);
             if (debug_rx) {
-                printf("[NSP] SLIP frame complete (%zu bytes)\n", decoded_len);
-
-                // Hex dump of received frame
-                printf("[NSP] Frame hex dump: ");
-                for (size_t i = 0; i < decoded_len; i++) {
-                    printf("%02X ", slip_output_buf[i]);
-                    if ((i + 1) % 16 == 0 && i + 1 < decoded_len) {
-                        printf("\n[NSP]                  ");
-                    }
-                }
-                printf("\n");
+                printf("[NSP] Wrong address (dest=0x%02X, our_addr=0x%02X)\n",
+                       nsp_rx.dest, device_addr);
             }
+            continue;
+        }
 
-            // Parse NSP packet
-            nsp_packet_t packet;
-            nsp_result_t parse_result = nsp_parse(slip_output_buf, decoded_len, &packet);
+        // Complete SLIP frame for us (foreign ones count in wrong_addr only)
+        slip_frames_ok_count++;
 
-            if (parse_result != NSP_OK) {
-                // NSP parse error (CRC, length, etc.)
-                nsp_parse_error_count++;
-                error_count++;
-                last_parse_error_code = (uint32_t)parse_result;  // Save error code for debugging
-                if (debug_rx) {
-                    printf("[NSP] Parse error: %d ", parse_result);
-                    switch (parse_result) {
-                        case 1: printf("(TOO_SHORT: frame < 6 bytes, got %zu)\n", decoded_len); break;
-                        case 2: printf("(BAD_LENGTH: len field mismatch)\n"); break;
-                        case 3: printf("(BAD_CRC: CRC validation failed)\n"); break;
-                        case 4: printf("(NULL_PTR: null pointer)\n"); break;
-                        default: printf("(UNKNOWN)\n"); break;
-                    }
+        if (monitor != BUS_MON_OFF) {
+            monitor_capture_rx(BUS_MON_F_OURS,
+                               monitor_verdict(ev == NSP_RX_BAD_FRAME ? nsp_rx.error : NSP_OK),
+                               end_stamped, end_us);
+        }
+
+        PROF_BEGIN(PROF_NSP_PARSE);
+        size_t decoded_len = nsp_rx.len;
+
+        // Save last frame for debugging (first 32 bytes)
+        last_frame_len = decoded_len;
+        size_t copy_len = decoded_len < sizeof(last_frame_bytes) ? decoded_len : sizeof(last_frame_bytes);
+        memcpy(last_frame_bytes, nsp_rx.buf, copy_len);
+
+        if (debug_rx) {
+            printf("[NSP] SLIP frame complete (%zu bytes)\n", decoded_len);
+
+            // Hex dump of received frame
+            printf("[NSP] Frame hex dump: ");
+            for (size_t i = 0; i < decoded_len; i++) {
+                printf("%02X ", nsp_rx.buf[i]);
+                if ((i + 1) % 16 == 0 && i + 1 < decoded_len) {
+                    printf("\n[NSP]                  ");
                 }
-                slip_decoder_reset(&slip_decoder);
-                continue;
             }
+            printf("\n");
+        }
 
+        if (ev == NSP_RX_BAD_FRAME) {
+            // NSP frame error (CRC, length, etc.)
+            nsp_result_t parse_result = nsp_rx.error;
+            nsp_parse_error_count++;
+            error_count++;
+            last_parse_error_code = (uint32_t)parse_result;  // Save error code for debugging
+            trace_frame(nsp_rx.buf, decoded_len, NSP_TRACE_PARSE_ERROR, (uint8_t)parse_result, 0, 0);
             if (debug_rx) {
-                printf("[NSP] Packet parsed: dest=0x%02X src=0x%02X ctrl=0x%02X len=%zu\n",
-                       packet.dest, packet.src, packet.ctrl, packet.len);
+                printf("[NSP] Parse error: %d ", parse_result);
+                switch (parse_result) {
+                    case 1: printf("(TOO_SHORT: frame < 5 bytes, got %zu)\n", decoded_len); break;
+                    case 2: printf("(BAD_LENGTH: frame exceeds %d bytes)\n", NSP_MAX_PACKET_SIZE); break;
+                    case 3: printf("(BAD_CRC: CRC validation failed)\n"); break;
+                    default: printf("(UNKNOWN)\n"); break;
+                }
             }
+            continue;
+        }
+
+        if (monitor == BUS_MON_PASSIVE) {
+            PROF_END(PROF_NSP_PARSE);
+            continue;  // Listen only: never execute or answer
+        }
 
-            // Save last successfully parsed command (raw NSP packet, up to 16 bytes)
-            last_rx_cmd_len = decoded_len < sizeof(last_rx_cmd_bytes) ? decoded_len : sizeof(last_rx_cmd_bytes);
-            memcpy(last_rx_cmd_bytes, slip_output_buf, last_rx_cmd_len);
+        // Zero-copy view: payload points into nsp_rx.buf
+        nsp_view_t packet;
+        nsp_rx_view(&nsp_rx, &packet);
 
-            // Reset error fields on successful parse (don't show stale errors)
-            last_parse_error_code = 0;
-            last_cmd_error_code = 0;
-            last_frame_len = 0;
+        if (debug_rx) {
+            printf("[NSP] Packet parsed: dest=0x%02X src=0x%02X ctrl=0x%02X len=%zu\n",
+                   packet.dest, packet.src, packet.ctrl, packet.len);
+        }
 
-            // Check if packet is addressed to us
-            if (packet.dest != device_addr && packet.dest != 0xFF) {
-                // Not for us - ignore (multi-drop bus)
-                wrong_addr_count++;
-                if (debug_rx) {
-                    printf("[NSP] Wrong address (dest=0x%02X, our_addr=0x%02X)\n",
-                           packet.dest, device_addr);
-                }
-                slip_decoder_reset(&slip_decoder);
-                continue;
-            }
+        // Save last successfully parsed command (raw NSP packet, up to 16 bytes)
+        last_rx_cmd_len = decoded_len < sizeof(last_rx_cmd_bytes) ? decoded_len : sizeof(last_rx_cmd_bytes);
+        memcpy(last_rx_cmd_bytes, nsp_rx.buf, last_rx_cmd_len);
+
+        // Reset error fields on successful parse (don't show stale errors)
+        last_parse_error_code = 0;
+        last_cmd_error_code = 0;
+        last_frame_len = 0;
+
+        rx_packet_count++;
+        stats_add(STATS_NSP_RX_FRAMES, 1);
+        PROF_END(PROF_NSP_PARSE);
 
-            rx_packet_count++;
+        // Dispatch command to handler
+        uint8_t command = nsp_get_command(packet.ctrl);
+        cmd_result_t result;
 
-            // Dispatch command to handler
-            uint8_t command = nsp_get_command(packet.ctrl);
-            cmd_result_t result;
+        if (debug_rx) {
+            printf("[NSP] Dispatching command: 0x%02X\n", command);
+        }
 
+        uint8_t wheel = (packet.dest == NSP_ADDR_BROADCAST)
+                            ? CORE_SYNC_WHEEL_ALL
+                            : (uint8_t)(packet.dest - device_addr);
+
+        // Commands this frame queues to Core1 count their latency from its END
+        PROF_BEGIN(PROF_NSP_DISPATCH);
+        core_sync_set_command_origin(service_t0_us, true);
+        bool handled = commands_dispatch_wheel(wheel, command, packet.data, packet.len, &result);
+        core_sync_set_command_origin(0, false);
+        PROF_END(PROF_NSP_DISPATCH);
+
+        if (!handled) {
+            // Unrecognized command
+            cmd_dispatch_error_count++;
+            error_count++;
+            last_cmd_error_code = (uint32_t)command;  // Save unrecognized command code
+            trace_frame(nsp_rx.buf, decoded_len, NSP_TRACE_DISPATCH_ERROR, 0, 0, 0);
             if (debug_rx) {
-                printf("[NSP] Dispatching command: 0x%02X\n", command);
+                printf("[NSP] Command dispatch failed: 0x%02X (unrecognized)\n", command);
             }
+            continue;
+        }
 
-            if (!commands_dispatch(command, packet.data, packet.len, &result)) {
-                // Unrecognized command
-                cmd_dispatch_error_count++;
-                error_count++;
-                last_cmd_error_code = (uint32_t)command;  // Save unrecognized command code
+        if (debug_rx) {
+            printf("[NSP] Command executed successfully\n");
+        }
+
+        // If Poll bit set, send reply (unless command indicates NO_REPLY)
+        if (nsp_is_poll_set(packet.ctrl)) {
+            // ICD compliance: Check for CMD_NO_REPLY (e.g., TRIP-LCL success)
+            // Per ICD, some commands (like TRIP-LCL) should not send a reply
+            if (result.status == CMD_NO_REPLY) {
                 if (debug_rx) {
-                    printf("[NSP] Command dispatch failed: 0x%02X (unrecognized)\n", command);
+                    printf("[NSP] CMD_NO_REPLY: suppressing reply per ICD\n");
                 }
-                slip_decoder_reset(&slip_decoder);
+                trace_frame(nsp_rx.buf, decoded_len, NSP_TRACE_NO_REPLY, 0, 0, 0);
                 continue;
             }
 
             if (debug_rx) {
-                printf("[NSP] Command executed successfully\n");
+                printf("[NSP] Poll bit set, building reply...\n");
             }
 
-            // If Poll bit set, send reply (unless command indicates NO_REPLY)
-            if (nsp_is_poll_set(packet.ctrl)) {
-                // ICD compliance: Check for CMD_NO_REPLY (e.g., TRIP-LCL success)
-                // Per ICD, some commands (like TRIP-LCL) should not send a reply
-                if (result.status == CMD_NO_REPLY) {
-                    if (debug_rx) {
-                        printf("[NSP] CMD_NO_REPLY: suppressing reply per ICD\n");
-                    }
-                    slip_decoder_reset(&slip_decoder);
-                    continue;
+            // Transport fault injection (scenario engine). Nominal traffic
+            // pays one load and one not-taken branch.
+            bool ack = (result.status == CMD_ACK);
+            cmd_reply_frame_t *frame = result.frame_cache;
+            uint32_t inject = 0;
+            uint32_t delay_us = 0;
+            if (scenario_transport_armed()) {
+                inject = scenario_transport_decide(command, &delay_us);
+                if (inject & SCENARIO_XPORT_DROP) {
+                    trace_frame(nsp_rx.buf, decoded_len, NSP_TRACE_DROPPED, (uint8_t)inject, 0, 0);
+                    continue;  // OBC sees a reply timeout
                 }
-
-                uint8_t nsp_reply[NSP_MAX_PACKET_SIZE];
-                size_t nsp_reply_len;
-
-                if (debug_rx) {
-                    printf("[NSP] Poll bit set, building reply...\n");
+                if (inject & SCENARIO_XPORT_NACK) {
+                    ack = false;
+                    frame = NULL;  // Neither serve nor cache the forced NACK
                 }
+            }
 
-                // Build NSP reply packet (pass ACK/NACK status from command result)
-                bool ack = (result.status == CMD_ACK);
-                if (!nsp_build_reply(&packet, ack, result.data, result.data_len,
-                                     nsp_reply, &nsp_reply_len)) {
+            // Build the SLIP-framed reply in place in the RS-485 TX buffer.
+            // Acquire waits for the previous reply (if any) to leave the wire.
+            size_t tx_cap;
+            uint8_t *tx_buf = rs485_tx_acquire(&tx_cap);
+            PROF_BEGIN(PROF_NSP_REPLY);
+            size_t slip_reply_len;
+
+            if (tx_buf != NULL && frame != NULL && frame->len != 0 && frame->len <= tx_cap &&
+                frame->dest == packet.dest && frame->src == packet.src &&
+                frame->ctrl == packet.ctrl) {
+                // Same request against unchanged data: reuse the finished frame
+                memcpy(tx_buf, frame->bytes, frame->len);
+                slip_reply_len = frame->len;
+                reply_frame_hit_count++;
+            } else {
+                if (tx_buf == NULL ||
+                    !nsp_encode_reply_slip(&packet, ack, result.data, result.data_len,
+                                           tx_buf, tx_cap, &slip_reply_len)) {
                     error_count++;
+                    trace_frame(nsp_rx.buf, decoded_len, NSP_TRACE_REPLY_ERROR, (uint8_t)inject, 0, 0);
                     if (debug_rx) {
                         printf("[NSP] Failed to build reply packet\n");
                     }
-                    slip_decoder_reset(&slip_decoder);
                     continue;
                 }
 
-                // SLIP encode the reply
-                uint8_t slip_reply[NSP_MAX_PACKET_SIZE * 2 + 2];
-                size_t slip_reply_len;
-
-                if (!slip_encode(nsp_reply, nsp_reply_len, slip_reply, &slip_reply_len)) {
-                    error_count++;
-                    if (debug_rx) {
-                        printf("[NSP] Failed to SLIP encode reply\n");
-                    }
-                    slip_decoder_reset(&slip_decoder);
-                    continue;
+                // Keep a copy for repeat polls until the data is rebuilt
+                if (frame != NULL && slip_reply_len <= sizeof(frame->bytes)) {
+                    memcpy(frame->bytes, tx_buf, slip_reply_len);
+                    frame->len = (uint16_t)slip_reply_len;
+                    frame->dest = packet.dest;
+                    frame->src = packet.src;
+                    frame->ctrl = packet.ctrl;
                 }
+            }
 
-                // Send SLIP-encoded reply over RS-485
-                if (rs485_send(slip_reply, slip_reply_len)) {
-                    tx_packet_count++;
-                    tx_byte_count += slip_reply_len;  // Track TX bytes
-                    if (debug_rx) {
-                        printf("[NSP] Reply sent (%zu bytes)\n", slip_reply_len);
+            // Corrupt after caching so repeat polls start from a clean frame
+            if (inject & SCENARIO_XPORT_CORRUPT) {
+                slip_corrupt_last_byte(tx_buf, slip_reply_len);
+            }
+
+            PROF_END(PROF_NSP_REPLY);
+
+            if (inject & SCENARIO_XPORT_DELAY) {
+                // Hand the finished frame to the deferred TX queue, timed from
+                // the request's arrival; decoding carries on meanwhile
+                uint64_t now_us = time_us_64();
+                uint32_t since_rx_us = (uint32_t)now_us - service_t0_us;
+                uint64_t release_us = now_us - since_rx_us + delay_us;
+                if (rs485_send_at(tx_buf, slip_reply_len, release_us)) {
+                    if (monitor == BUS_MON_CAPTURE) {
+                        monitor_capture_tx(tx_buf, slip_reply_len, release_us);
                     }
+                    tx_packet_count++;
+                    tx_byte_count += slip_reply_len;
+                    stats_add(STATS_NSP_TX_FRAMES, 1);
+                    stats_add(STATS_NSP_TX_BYTES, (uint32_t)slip_reply_len);
+                    trace_frame(nsp_rx.buf, decoded_len, NSP_TRACE_DEFERRED, (uint8_t)inject,
+                                delay_us, slip_reply_len);
                 } else {
                     error_count++;
-                    if (debug_rx) {
-                        printf("[NSP] Failed to send reply over RS-485\n");
-                    }
+                    trace_frame(nsp_rx.buf, decoded_len, NSP_TRACE_REPLY_ERROR, (uint8_t)inject, 0, 0);
                 }
+                continue;
             }
 
-            // Reset decoder for next frame
-            slip_decoder_reset(&slip_decoder);
+            // Start DMA transmission. Returns immediately; the TX-complete
+            // callback records the turnaround when the last stop bit is out.
+            reply_t0_us = service_t0_us;
+            reply_cmd = command;
+            PROF_BEGIN(PROF_NSP_TX);
+            bool queued = rs485_tx_commit(slip_reply_len);
+            PROF_END(PROF_NSP_TX);
+            if (queued) {
+                if (monitor == BUS_MON_CAPTURE) {
+                    monitor_capture_tx(tx_buf, slip_reply_len, monitor_time64(rs485_tx_start_us()));
+                }
+                uint32_t reply_us = rs485_tx_start_us() - service_t0_us;
+                latency_hist_record(&reply_start_hist[command], reply_us);
+                trace_frame(nsp_rx.buf, decoded_len, ack ? NSP_TRACE_ACK : NSP_TRACE_NACK,
+                            (uint8_t)inject, reply_us, slip_reply_len);
+                tx_packet_count++;
+                tx_byte_count += slip_reply_len;  // Track TX bytes
+                stats_add(STATS_NSP_TX_FRAMES, 1);
+                stats_add(STATS_NSP_TX_BYTES, (uint32_t)slip_reply_len);
+                if (debug_rx) {
+                    printf("[NSP] Reply queued (%zu bytes)\n", slip_reply_len);
+                }
+            } else {
+                error_count++;
+                trace_frame(nsp_rx.buf, decoded_len, NSP_TRACE_REPLY_ERROR, (uint8_t)inject, 0, 0);
+                if (debug_rx) {
+                    printf("[NSP] Failed to send reply over RS-485\n");
+                }
+            }
+        } else {
+            trace_frame(nsp_rx.buf, decoded_len, NSP_TRACE_NO_REPLY, 0, 0, 0);
         }
     }
+
+    // One 64-bit update per drain rather than per byte
+    stats_add(STATS_NSP_RX_BYTES, rx_new);
+    core_sync_ring(CORE_SYNC_BELL_BUS);
+}
+
+/**
+ * @brief RS-485 TX-complete callback (alarm IRQ context)
+ */
+static void HOT_PATH_FUNC(nsp_tx_done)(void) {
+    uint32_t turnaround = time_us_32() - reply_t0_us;
+    last_turnaround_us = turnaround;
+    if (turnaround > max_turnaround_us) {
+        max_turnaround_us = turnaround;
+    }
+    latency_hist_record(&reply_end_hist[reply_cmd], turnaround);
+    core_sync_ring(CORE_SYNC_BELL_BUS);
+}
+
+/**
+ * @brief UART RX delimiter callback (UART1 ISR context)
+ *
+ * Stamps the arrival of the first unserviced frame and pends the service
+ * IRQ. Frames arriving while a pass is running re-pend it.
+ */
+static void HOT_PATH_FUNC(nsp_rx_frame_notify)(void) {
+    if (!rx_frame_stamp_valid) {
+        rx_frame_stamp_us = time_us_32();
+        rx_frame_stamp_valid = true;
+    }
+    irq_set_pending((uint)service_irq);
+}
+
+/**
+ * @brief NSP service IRQ (lowest priority, preempts thread-mode console work)
+ *
+ * Turnaround for every reply in this pass is measured from the oldest
+ * pending frame END, so the reported value is a conservative upper bound.
+ */
+static void HOT_PATH_FUNC(nsp_service_isr)(void) {
+    service_t0_us = rx_frame_stamp_valid ? rx_frame_stamp_us : time_us_32();
+    rx_frame_stamp_valid = false;
+
+    nsp_handler_process();
+}
+
+bool nsp_handler_start_service(void) {
+    if (service_irq >= 0) {
+        return true;  // Already running
+    }
+
+    int irq = user_irq_claim_unused(false);
+    if (irq < 0) {
+        printf("[NSP] ERROR: No spare IRQ for NSP service (staying in polled mode)\n");
+        return false;
+    }
+
+    irq_set_exclusive_handler((uint)irq, nsp_service_isr);
+    irq_set_priority((uint)irq, PICO_LOWEST_IRQ_PRIORITY);
+    service_irq = irq;
+    irq_set_enabled((uint)irq, true);
+
+    // Wake the service on every SLIP END byte
+    rs485_set_rx_callback(SLIP_END, nsp_rx_frame_notify);
+
+    // Pick up anything that arrived before the service was armed
+    if (rs485_available() > 0) {
+        irq_set_pending((uint)irq);
+    }
+
+    service_online_us = time_us_32();
+    printf("[NSP] Event-driven NSP service started (IRQ %d, %lu ms after reset)\n",
+           irq, (unsigned long)(service_online_us / 1000u));
+    return true;
+}
+
+uint32_t nsp_handler_get_online_us(void) {
+    return service_online_us;
+}
+
+uint8_t nsp_handler_get_address(void) {
+    return device_addr;
+}
+
+bool nsp_handler_inject(const uint8_t* frame, size_t len) {
+    if (frame == NULL || len == 0 || len > NSP_INJECT_MAX_FRAME) {
+        return false;
+    }
+    uint32_t head = inject_head;
+    if (head - inject_tail >= NSP_INJECT_SLOTS) {
+        return false;  // Service has not caught up
+    }
+
+    uint32_t slot = head % NSP_INJECT_SLOTS;
+    memcpy(inject_buf[slot], frame, len);
+    inject_len[slot] = (uint8_t)len;
+    __dmb();    // Slot complete before the index that publishes it
+    inject_head = head + 1;
+
+    if (service_irq >= 0) {
+        // Time the reply from the injection, like a frame END from the bus
+        uint32_t save = save_and_disable_interrupts();
+        if (!rx_frame_stamp_valid) {
+            rx_frame_stamp_us = time_us_32();
+            rx_frame_stamp_valid = true;
+        }
+        restore_interrupts(save);
+        irq_set_pending((uint)service_irq);
+    }
+    return true;
+}
+
+void HOT_PATH_FUNC(nsp_handler_enter_reset)(void) {
+    reset_state = RESET_HELD;
+    __dmb();
+    reset_seq++;
+}
+
+void HOT_PATH_FUNC(nsp_handler_leave_reset)(uint32_t ready_us) {
+    reset_ready_us = ready_us;
+    __dmb();    // Window end before the state that makes it count
+    reset_state = RESET_BOOTING;
+}
+
+uint32_t nsp_handler_get_reset_dropped(void) {
+    return reset_dropped_count;
+}
+
+void HOT_PATH_FUNC(nsp_handler_poll)(void) {
+    if (service_irq >= 0) {
+        // Service IRQ owns the decoder; just make sure no bytes are stranded
+        // (e.g. a frame whose END was lost on the wire)
+        if (rs485_available() > 0 || inject_tail != inject_head) {
+            irq_set_pending((uint)service_irq);
+        }
+        return;
+    }
+
+    service_t0_us = time_us_32();
+    nsp_handler_process();
 }
 
 // ============================================================================
@@ -329,6 +841,42 @@ void nsp_handler_set_debug(bool enable) {
     debug_rx = enable;
 }
 
+void nsp_handler_get_reply_cache_stats(uint32_t* frame_hits) {
+    if (frame_hits) *frame_hits = reply_frame_hit_count;
+}
+
+bool nsp_handler_get_latency(uint8_t command, bool to_reply_end, latency_summary_t* summary) {
+    const latency_hist_t* hists = to_reply_end ? reply_end_hist : reply_start_hist;
+
+    if (command == NSP_HANDLER_LATENCY_ALL) {
+        static latency_hist_t merged;  // Too large for the caller's stack
+        latency_hist_reset(&merged);
+        for (uint32_t c = 0; c < NSP_CMD_TABLE_SIZE; c++) {
+            latency_hist_merge(&merged, &hists[c]);
+        }
+        latency_hist_summarize(&merged, summary);
+        return true;
+    }
+
+    if (command >= NSP_CMD_TABLE_SIZE) {
+        return false;
+    }
+    latency_hist_summarize(&hists[command], summary);
+    return true;
+}
+
+void nsp_handler_reset_latency(void) {
+    for (uint32_t c = 0; c < NSP_CMD_TABLE_SIZE; c++) {
+        latency_hist_reset(&reply_start_hist[c]);
+        latency_hist_reset(&reply_end_hist[c]);
+    }
+}
+
+void nsp_handler_get_turnaround(uint32_t* last_us, uint32_t* max_us) {
+    if (last_us) *last_us = last_turnaround_us;
+    if (max_us) *max_us = max_turnaround_us;
+}
+
 void nsp_handler_get_serial_stats(uint32_t* rx_bytes, uint32_t* tx_bytes,
                                    uint32_t* slip_frames_ok, uint32_t* slip_errors) {
     if (rx_bytes) *rx_bytes = rx_byte_count;
@@ -336,3 +884,22 @@ void nsp_handler_get_serial_stats(uint32_t* rx_bytes, uint32_t* tx_bytes,
     if (slip_frames_ok) *slip_frames_ok = slip_frames_ok_count;
     if (slip_errors) *slip_errors = slip_error_count;
 }
+
+void nsp_handler_get_bus_rates(bus_meter_rates_t* rates) {
+    uint32_t baud;
+    int32_t error_ppm;
+    rs485_get_baud(&baud, &error_ppm);
+    if (baud != meter_baud) {
+        bus_meter_reset(baud);
+        meter_baud = baud;
+    }
+
+    bus_meter_counts_t totals = {
+        .rx_bytes = rx_byte_count,
+        .tx_bytes = tx_byte_count,
+        .rx_frames = slip_frames_ok_count + wrong_addr_count + slip_error_count,
+        .tx_frames = tx_packet_count,
+    };
+    bus_meter_update(time_us_32(), &totals);
+    bus_meter_get_rates(rates);
+}
@@ -12,6 +12,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include "util/latency_hist.h"
+#include "util/bus_meter.h"
 
 // ============================================================================
 // API Functions
@@ -21,17 +23,99 @@
  * @brief Initialize NSP handler
  *
  * Initializes RS-485, SLIP decoder, NSP subsystem, and command dispatch.
+ * Wheel k of the cluster answers device_address + k, so the whole cluster
+ * must fit in 0-7; any other address is rejected and the bus left alone.
  *
  * @param device_address Device address (0-7, from ADDR pins)
+ * @return false if the address is out of range or RS-485 init failed
  */
-void nsp_handler_init(uint8_t device_address);
+bool nsp_handler_init(uint8_t device_address);
+
+/**
+ * @brief Start the event-driven NSP service
+ *
+ * Claims a spare user IRQ at the lowest NVIC priority and arms it from the
+ * RS-485 RX interrupt on every SLIP END byte. From then on requests are
+ * decoded, dispatched and answered as soon as their frame completes, even
+ * while the Core0 main loop is blocked in console output. The UART RX ISR
+ * keeps a higher priority, so bytes are never lost while a reply is built.
+ *
+ * Call once after the boot-time checkpoint tests (which drive RS-485
+ * directly) and before entering the main loop. The fast-boot profile
+ * (FAST_BOOT=1) calls it as soon as Core1 is running and skips the tests.
+ *
+ * @return true if the service is running, false if no IRQ was available
+ *         (nsp_handler_poll() then keeps processing in the main loop)
+ */
+bool nsp_handler_start_service(void);
+
+/**
+ * @brief Get the time the event-driven service started
+ *
+ * @return time_us_32() at nsp_handler_start_service(), 0 if not started
+ */
+uint32_t nsp_handler_get_online_us(void);
+
+/**
+ * @brief Get the base NSP address (wheel 0)
+ *
+ * @return Address passed to nsp_handler_init()
+ */
+uint8_t nsp_handler_get_address(void);
+
+/** Frames nsp_handler_inject() can hold before the service reads them */
+#define NSP_INJECT_SLOTS        4
+
+/** Longest SLIP frame nsp_handler_inject() accepts (bytes, both ENDs included) */
+#define NSP_INJECT_MAX_FRAME    64
+
+/**
+ * @brief Feed a SLIP-encoded request to the receiver as if it came off the bus
+ *
+ * For the load generator (nsp_loadgen.h) and capture replay (nsp_replay.h),
+ * from one producer at a time (thread mode, or Core0 alarm callback). The
+ * frame goes through the same SLIP, parse, dispatch and reply path as bus
+ * traffic, ahead of any bytes waiting in the RS-485 ring, and the reply is
+ * sent on the bus. Injected bytes are not counted as received wire bytes.
+ *
+ * @param frame SLIP frame (END .. END)
+ * @param len Frame length (at most NSP_INJECT_MAX_FRAME)
+ * @return false if all NSP_INJECT_SLOTS are still waiting or len is invalid
+ */
+bool nsp_handler_inject(const uint8_t* frame, size_t len);
+
+/**
+ * @brief Hold the receiver in hardware RESET (any core, e.g. a pin ISR)
+ *
+ * The receiver restarts from idle (a frame in progress is lost) and every
+ * byte is dropped, unanswered, until nsp_handler_leave_reset()'s ready
+ * time.
+ */
+void nsp_handler_enter_reset(void);
+
+/**
+ * @brief Release hardware RESET (any core)
+ *
+ * @param ready_us time_us_32() from which requests are answered again
+ *                 (the emulated boot time after the release)
+ */
+void nsp_handler_leave_reset(uint32_t ready_us);
+
+/**
+ * @brief Get the bytes dropped while in hardware RESET
+ *
+ * @return Count since init
+ */
+uint32_t nsp_handler_get_reset_dropped(void);
 
 /**
  * @brief Poll RS-485 for incoming NSP packets and handle them
  *
- * This function should be called periodically from the Core0 main loop.
+ * Before nsp_handler_start_service(), this function does the work itself and
+ * should be called periodically from the Core0 main loop. Once the service
+ * is running it only re-pends the service IRQ if bytes are waiting.
  * It performs the following:
- * 1. Reads bytes from RS-485 RX FIFO
+ * 1. Reads bytes from the RS-485 RX ring (filled by the UART1 RX ISR)
  * 2. Feeds bytes through SLIP decoder
  * 3. When complete frame received, parses NSP packet
  * 4. Dispatches command to handler
@@ -97,21 +181,75 @@ void nsp_handler_get_last_rx_cmd(uint8_t* cmd_buf, size_t buf_size, uint32_t* cm
  * @brief Enable or disable debug RX logging
  *
  * When enabled, prints detailed information about received bytes and packet processing.
- * Default: enabled
+ * Output is produced from the NSP service IRQ and adds directly to turnaround.
+ * Default: disabled
  *
  * @param enable true to enable debug logging, false to disable
  */
 void nsp_handler_set_debug(bool enable);
 
+/**
+ * @brief Get request-to-reply turnaround
+ *
+ * Measured from reception of the request's SLIP END byte to the last stop
+ * bit of the reply leaving the UART.
+ *
+ * @param last_us Turnaround of the most recent reply (can be NULL)
+ * @param max_us Worst-case turnaround since init (can be NULL)
+ */
+void nsp_handler_get_turnaround(uint32_t* last_us, uint32_t* max_us);
+
+/** Command code for nsp_handler_get_latency() that merges every command */
+#define NSP_HANDLER_LATENCY_ALL 0xFF
+
+/**
+ * @brief Get reply latency percentiles for one NSP command
+ *
+ * Latency is measured from the request's SLIP END byte to either the
+ * reply's first start bit (response time) or its last stop bit (same
+ * endpoint as nsp_handler_get_turnaround()). Requests that share one
+ * service pass are all timed from the oldest END, an upper bound.
+ *
+ * @param command NSP command code, or NSP_HANDLER_LATENCY_ALL
+ * @param to_reply_end false = to first reply byte, true = to last
+ * @param summary Output: count, p50/p90/p99/p99.9 and max in µs
+ * @return false for an unknown command code
+ */
+bool nsp_handler_get_latency(uint8_t command, bool to_reply_end, latency_summary_t* summary);
+
+/**
+ * @brief Clear all reply latency histograms
+ */
+void nsp_handler_reset_latency(void);
+
+/**
+ * @brief Get reply frame cache statistics
+ *
+ * @param frame_hits Output: replies copied from a cached SLIP frame instead
+ *                   of being re-encoded (can be NULL)
+ */
+void nsp_handler_get_reply_cache_stats(uint32_t* frame_hits);
+
 /**
  * @brief Get serial layer statistics (RS-485 and SLIP)
  *
  * @param rx_bytes Total bytes received on RS-485
  * @param tx_bytes Total bytes transmitted on RS-485
- * @param slip_frames_ok Successfully decoded SLIP frames
+ * @param slip_frames_ok Successfully decoded SLIP frames addressed to us
+ *                       (frames for other nodes count in wrong_addr)
  * @param slip_errors SLIP framing errors
  */
 void nsp_handler_get_serial_stats(uint32_t* rx_bytes, uint32_t* tx_bytes,
                                    uint32_t* slip_frames_ok, uint32_t* slip_errors);
 
+/**
+ * @brief Get bus throughput and utilization over the last window
+ *
+ * Closes the meter window when it has run its length (see util/bus_meter.h);
+ * call from the console only. A baud rate change starts the meter over.
+ *
+ * @param rates Output: rates, busy shares, peaks and idle gaps
+ */
+void nsp_handler_get_bus_rates(bus_meter_rates_t* rates);
+
 #endif // NSP_HANDLER_H
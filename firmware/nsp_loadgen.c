@@ -0,0 +1,292 @@
+/**
+ * @file nsp_loadgen.c
+ * @brief On-Device NSP Load Generator Implementation
+ */
+
+#include "nsp_loadgen.h"
+#include "nsp_handler.h"
+#include "drivers/rs485_uart.h"
+#include "drivers/slip.h"
+#include "drivers/nsp.h"
+#include "drivers/crc_ccitt.h"
+#include "device/nss_nrwa_t6_telemetry.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
+#include <stdio.h>
+#include <string.h>
+
+/** Requests in the longest mix (MIXED: PING, PEEK, TELEM_BLOCK_COUNT blocks) */
+#define MIX_MAX_FRAMES      (2 + TELEM_BLOCK_COUNT)
+
+/** Time allowed at the end of a step for replies still in flight (µs) */
+#define DRAIN_US            NSP_LOADGEN_REPLY_TIMEOUT_US
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+static const uint32_t offered_rates[] = NSP_LOADGEN_RATES;
+
+_Static_assert(sizeof(offered_rates) / sizeof(offered_rates[0]) + 1 == NSP_LOADGEN_STEP_COUNT,
+               "one step per offered rate plus closed loop");
+
+static uint8_t frames[MIX_MAX_FRAMES][NSP_INJECT_MAX_FRAME];   // SLIP encoded requests
+static size_t frame_len[MIX_MAX_FRAMES];
+static uint32_t frame_count = 0;
+
+static nsp_loadgen_state_t state = NSP_LOADGEN_IDLE;
+static nsp_loadgen_report_t report;
+
+// ============================================================================
+// Request Building
+// ============================================================================
+
+/**
+ * @brief Append one SLIP-encoded request for wheel 0 to the mix
+ */
+static void add_request(uint8_t command, const uint8_t* payload, size_t payload_len) {
+    uint8_t pkt[3 + 1 + 2];     // Header, at most one payload byte, CRC
+    pkt[0] = nsp_handler_get_address();
+    pkt[1] = NSP_LOADGEN_SRC_ADDR;
+    pkt[2] = nsp_make_ctrl(true, false, false, command);
+    if (payload_len > 0) {
+        memcpy(&pkt[3], payload, payload_len);
+    }
+    size_t len = crc_ccitt_append(pkt, 3 + payload_len);
+    slip_encode(pkt, len, frames[frame_count], &frame_len[frame_count]);
+    frame_count++;
+}
+
+static void build_mix(nsp_loadgen_mix_t mix) {
+    frame_count = 0;
+    switch (mix) {
+        case NSP_LOADGEN_MIX_PING:
+            add_request(NSP_CMD_PING, NULL, 0);
+            break;
+        case NSP_LOADGEN_MIX_TELEM: {
+            uint8_t block = TELEM_BLOCK_STANDARD;
+            add_request(NSP_CMD_APPLICATION_TELEMETRY, &block, 1);
+            break;
+        }
+        default: {
+            uint8_t peek_addr = 0x00;
+            add_request(NSP_CMD_PING, NULL, 0);
+            add_request(NSP_CMD_PEEK, &peek_addr, 1);
+            for (uint8_t block = 0; block < TELEM_BLOCK_COUNT; block++) {
+                add_request(NSP_CMD_APPLICATION_TELEMETRY, &block, 1);
+            }
+            break;
+        }
+    }
+}
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+/**
+ * @brief Hand one request to the selected path
+ *
+ * @return false if the path is busy (try again later)
+ */
+static bool submit(const uint8_t* frame, size_t len) {
+    if (report.path == NSP_LOADGEN_PATH_INJECT) {
+        return nsp_handler_inject(frame, len);
+    }
+
+    // Replies are built in the same TX buffer: keep the service IRQ from
+    // starting one between the idle check and the copy
+    uint32_t save = save_and_disable_interrupts();
+    bool sent = !rs485_tx_busy() && rs485_send_async(frame, len);
+    restore_interrupts(save);
+    return sent;
+}
+
+static uint32_t reply_count(void) {
+    uint32_t tx_packets;
+    nsp_handler_get_detailed_stats(NULL, NULL, &tx_packets, NULL, NULL, NULL, NULL, NULL);
+    return tx_packets;
+}
+
+static uint32_t error_count(void) {
+    uint32_t nsp_errors, rx_dropped, rx_overruns;
+    nsp_handler_get_detailed_stats(NULL, NULL, NULL, NULL, NULL, NULL, NULL, &nsp_errors);
+    rs485_get_rx_stats(&rx_dropped, &rx_overruns, NULL);
+    return nsp_errors + rx_dropped + rx_overruns;
+}
+
+// ============================================================================
+// Steps
+// ============================================================================
+
+static void run_step(nsp_loadgen_step_t* step, uint32_t rate_hz) {
+    memset(step, 0, sizeof(*step));
+    step->offered_hz = rate_hz;
+
+    nsp_handler_reset_latency();
+    uint32_t replies0 = reply_count();
+    uint32_t errors0 = error_count();
+
+    uint32_t step_us = report.step_ms * 1000u;
+    uint32_t period_us = (rate_hz > 0) ? (1000000u / rate_hz) : 0;
+    uint32_t start_us = time_us_32();
+    uint32_t due_us = start_us;
+    uint32_t last_send_us = start_us;
+    uint32_t next_frame = 0;
+    bool held = false;
+
+    while ((uint32_t)(time_us_32() - start_us) < step_us) {
+        nsp_handler_poll();     // Host build: no service IRQ
+        uint32_t now_us = time_us_32();
+        uint32_t answered = (reply_count() - replies0) + step->lost;
+
+        if (rate_hz == 0) {
+            // Closed loop: next request once the last one is answered
+            if (answered < step->sent) {
+                if ((uint32_t)(now_us - last_send_us) >= NSP_LOADGEN_REPLY_TIMEOUT_US) {
+                    step->lost++;
+                }
+                continue;
+            }
+        } else if ((int32_t)(now_us - due_us) < 0) {
+            continue;
+        }
+
+        if (!submit(frames[next_frame], frame_len[next_frame])) {
+            if (!held) {
+                held = true;
+                step->stalled++;
+            }
+            continue;
+        }
+        held = false;
+        step->sent++;
+        last_send_us = now_us;
+        next_frame = (next_frame + 1 < frame_count) ? next_frame + 1 : 0;
+
+        if (rate_hz > 0) {
+            // Fallen a whole period behind: offer from now rather than burst
+            due_us += period_us;
+            if ((int32_t)(now_us - due_us) > (int32_t)period_us) {
+                due_us = now_us;
+            }
+        }
+    }
+
+    // Let the replies still in flight come out
+    uint32_t drain_us = time_us_32();
+    while (reply_count() - replies0 + step->lost < step->sent &&
+           (uint32_t)(time_us_32() - drain_us) < DRAIN_US) {
+        nsp_handler_poll();
+    }
+    uint32_t elapsed_us = time_us_32() - start_us;
+
+    // Closed loop moves on after a timeout; a reply that turned up later
+    // still counts, so recount lost from the totals
+    step->replies = reply_count() - replies0;
+    step->lost = (step->sent > step->replies) ? (step->sent - step->replies) : 0;
+    step->errors = step->lost + (error_count() - errors0);
+    step->achieved_hz = (uint32_t)(((uint64_t)step->replies * 1000000u) / elapsed_us);
+    nsp_handler_get_latency(NSP_HANDLER_LATENCY_ALL, true, &step->latency);
+}
+
+static void finish(void) {
+    if (report.path == NSP_LOADGEN_PATH_LOOPBACK) {
+        rs485_set_loopback(false);
+    }
+    state = NSP_LOADGEN_DONE;
+
+    static const char* path_names[] = { "INJECT", "LOOPBACK", "WIRE" };
+    static const char* mix_names[] = { "PING", "TELEM", "MIXED" };
+    printf("[LOADGEN] Sweep done: path=%s mix=%s, %lu ms per step\n",
+           path_names[report.path], mix_names[report.mix], (unsigned long)report.step_ms);
+    printf("[LOADGEN]  offered achieved     sent  replies   lost errors stalled   p50   p99 p99.9   max (us)\n");
+    for (uint32_t i = 0; i < report.steps_done; i++) {
+        const nsp_loadgen_step_t* s = &report.steps[i];
+        char offered[12];
+        if (s->offered_hz > 0) {
+            snprintf(offered, sizeof(offered), "%lu", (unsigned long)s->offered_hz);
+        } else {
+            snprintf(offered, sizeof(offered), "max");
+        }
+        printf("[LOADGEN] %8s %8lu %8lu %8lu %6lu %6lu %7lu %5lu %5lu %5lu %5lu\n",
+               offered, (unsigned long)s->achieved_hz, (unsigned long)s->sent,
+               (unsigned long)s->replies, (unsigned long)s->lost, (unsigned long)s->errors,
+               (unsigned long)s->stalled, (unsigned long)s->latency.p50_us,
+               (unsigned long)s->latency.p99_us, (unsigned long)s->latency.p999_us,
+               (unsigned long)s->latency.max_us);
+    }
+    printf("[LOADGEN] Max error-free rate: %lu req/s, errors from: ",
+           (unsigned long)report.max_clean_hz);
+    if (report.first_error_hz > 0) {
+        printf("%lu req/s\n", (unsigned long)report.first_error_hz);
+    } else {
+        printf("none\n");
+    }
+}
+
+// ============================================================================
+// Control
+// ============================================================================
+
+bool nsp_loadgen_start(nsp_loadgen_path_t path, nsp_loadgen_mix_t mix, uint32_t step_ms) {
+    if (state == NSP_LOADGEN_RUNNING || path >= NSP_LOADGEN_PATH_COUNT ||
+        mix >= NSP_LOADGEN_MIX_COUNT) {
+        return false;
+    }
+
+    if (step_ms < NSP_LOADGEN_STEP_MS_MIN) {
+        step_ms = NSP_LOADGEN_STEP_MS_MIN;
+    } else if (step_ms > NSP_LOADGEN_STEP_MS_MAX) {
+        step_ms = NSP_LOADGEN_STEP_MS_MAX;
+    }
+
+    memset(&report, 0, sizeof(report));
+    report.path = path;
+    report.mix = mix;
+    report.step_ms = step_ms;
+
+    if (path == NSP_LOADGEN_PATH_LOOPBACK && !rs485_set_loopback(true)) {
+        printf("[LOADGEN] Internal loopback needs the UART backend\n");
+        state = NSP_LOADGEN_FAILED;
+        return false;
+    }
+
+    build_mix(mix);
+    state = NSP_LOADGEN_RUNNING;
+    printf("[LOADGEN] Sweep started (%u steps of %lu ms)\n",
+           (unsigned)NSP_LOADGEN_STEP_COUNT, (unsigned long)step_ms);
+    return true;
+}
+
+void nsp_loadgen_service(void) {
+    if (state != NSP_LOADGEN_RUNNING) {
+        return;
+    }
+
+    uint32_t index = report.steps_done;
+    uint32_t rate_hz = (index < NSP_LOADGEN_STEP_COUNT - 1) ? offered_rates[index] : 0;
+    nsp_loadgen_step_t* step = &report.steps[index];
+    run_step(step, rate_hz);
+    report.steps_done++;
+
+    if (step->errors == 0) {
+        if (step->achieved_hz > report.max_clean_hz) {
+            report.max_clean_hz = step->achieved_hz;
+        }
+    } else if (report.first_error_hz == 0) {
+        report.first_error_hz = (rate_hz > 0) ? rate_hz : step->achieved_hz;
+    }
+
+    if (report.steps_done == NSP_LOADGEN_STEP_COUNT) {
+        finish();
+    }
+}
+
+nsp_loadgen_state_t nsp_loadgen_get_state(void) {
+    return state;
+}
+
+const nsp_loadgen_report_t* nsp_loadgen_get_report(void) {
+    return &report;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file nsp_loadgen.h
+ * @brief On-Device NSP Load Generator
+ *
+ * Acceptance benchmark for the NSP stack: the emulator sends itself
+ * requests and measures how many it can answer. A sweep runs one step per
+ * offered rate (NSP_LOADGEN_RATES, then back-to-back closed loop), each for
+ * a fixed time, and records per step the achieved reply rate, lost replies,
+ * stack errors and the reply latency distribution. The report keeps the
+ * highest error-free rate and the offered rate at which errors started.
+ *
+ * Request paths:
+ * - INJECT: SLIP frames handed to nsp_handler_inject(), so each request goes
+ *   through SLIP decode, parse, dispatch, reply build/encode and a real
+ *   transmission on the bus. Works on either RS-485 backend.
+ * - LOOPBACK: requests sent on the UART and received again through the
+ *   PL011 internal loopback (rs485_set_loopback()), so the RX interrupt,
+ *   RX ring and wire timing are included. UART backend only.
+ * - WIRE: as LOOPBACK, through an external jumper or transceiver loopback
+ *   (GPIO 4 TX to GPIO 5 RX, see test_rs485_loopback()).
+ *
+ * On the bus paths the emulator's replies come back too and are dropped as
+ * frames for another address. Replies go out on the bus on every path, so
+ * disconnect the OBC first. Each step clears the reply latency histograms
+ * (nsp_handler_reset_latency(), Table 12).
+ *
+ * One step runs per nsp_loadgen_service() call from the Core0 main loop, so
+ * the console stays responsive between steps.
+ */
+
+#ifndef NSP_LOADGEN_H
+#define NSP_LOADGEN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "util/latency_hist.h"
+
+/** Offered rates swept (req/s); a final closed-loop step follows */
+#define NSP_LOADGEN_RATES       { 100, 250, 500, 1000, 2000, 5000, 10000, 20000 }
+
+/** Steps per sweep (NSP_LOADGEN_RATES plus closed loop) */
+#define NSP_LOADGEN_STEP_COUNT  9
+
+/** Default and limits for one step's duration (ms) */
+#define NSP_LOADGEN_STEP_MS_DEFAULT 1000
+#define NSP_LOADGEN_STEP_MS_MIN     100
+#define NSP_LOADGEN_STEP_MS_MAX     10000
+
+/** A request without a reply after this long is counted lost (µs) */
+#define NSP_LOADGEN_REPLY_TIMEOUT_US 10000
+
+/** Source address of the generated requests (the OBC's) */
+#define NSP_LOADGEN_SRC_ADDR    0x11
+
+/**
+ * @brief Request paths
+ */
+typedef enum {
+    NSP_LOADGEN_PATH_INJECT = 0,    // Frames injected ahead of the receiver
+    NSP_LOADGEN_PATH_LOOPBACK,      // UART internal loopback
+    NSP_LOADGEN_PATH_WIRE,          // External TX-RX jumper
+    NSP_LOADGEN_PATH_COUNT
+} nsp_loadgen_path_t;
+
+/**
+ * @brief Request mixes (all read-only, wheel 0)
+ */
+typedef enum {
+    NSP_LOADGEN_MIX_PING = 0,       // PING only
+    NSP_LOADGEN_MIX_TELEM,          // APPLICATION-TELEMETRY, STANDARD block
+    NSP_LOADGEN_MIX_MIXED,          // PING, PEEK and every telemetry block in turn
+    NSP_LOADGEN_MIX_COUNT
+} nsp_loadgen_mix_t;
+
+/**
+ * @brief Sweep states
+ */
+typedef enum {
+    NSP_LOADGEN_IDLE = 0,           // Never run
+    NSP_LOADGEN_RUNNING,            // Steps remaining
+    NSP_LOADGEN_DONE,               // Report complete
+    NSP_LOADGEN_FAILED              // Path unavailable (e.g. LOOPBACK on PIO)
+} nsp_loadgen_state_t;
+
+/**
+ * @brief One step's results
+ */
+typedef struct {
+    uint32_t offered_hz;            // Offered rate (0 = closed loop)
+    uint32_t achieved_hz;           // Replies per second over the step
+    uint32_t sent;                  // Requests submitted
+    uint32_t replies;               // Replies produced
+    uint32_t lost;                  // Requests never answered
+    uint32_t errors;                // lost + NSP errors + RX drops/overruns
+    uint32_t stalled;               // Requests held back by a busy path
+    latency_summary_t latency;      // Request END to reply last stop bit
+} nsp_loadgen_step_t;
+
+/**
+ * @brief Sweep report
+ */
+typedef struct {
+    nsp_loadgen_path_t path;
+    nsp_loadgen_mix_t mix;
+    uint32_t step_ms;
+    uint32_t steps_done;
+    nsp_loadgen_step_t steps[NSP_LOADGEN_STEP_COUNT];
+    uint32_t max_clean_hz;          // Highest achieved rate of an error-free step
+    uint32_t first_error_hz;        // Offered rate of the first step with errors (0 = none)
+} nsp_loadgen_report_t;
+
+/**
+ * @brief Start a sweep (Core0 main loop)
+ *
+ * @param path Request path
+ * @param mix Request mix
+ * @param step_ms Duration of each step (clamped to the NSP_LOADGEN_STEP_MS_* limits)
+ * @return false if a sweep is running or the path is unavailable
+ */
+bool nsp_loadgen_start(nsp_loadgen_path_t path, nsp_loadgen_mix_t mix, uint32_t step_ms);
+
+/**
+ * @brief Run the next step of a started sweep (Core0 main loop)
+ *
+ * Blocks for one step. Prints the report when the last step completes.
+ */
+void nsp_loadgen_service(void);
+
+/**
+ * @brief Get the sweep state
+ *
+ * @return Current state
+ */
+nsp_loadgen_state_t nsp_loadgen_get_state(void);
+
+/**
+ * @brief Get the report of the running or last sweep
+ *
+ * @return Report (steps_done steps are valid)
+ */
+const nsp_loadgen_report_t* nsp_loadgen_get_report(void);
+
+#endif // NSP_LOADGEN_H
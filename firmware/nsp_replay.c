@@ -0,0 +1,324 @@
+/**
+ * @file nsp_replay.c
+ * @brief NSP Traffic Capture and Replay Implementation
+ */
+
+#include "nsp_replay.h"
+#include "nsp_handler.h"
+#include "nsp_loadgen.h"
+#include "board_pico.h"
+#include "timebase.h"
+#include "util/unaligned.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
+#include <stdio.h>
+#include <string.h>
+
+/** Delay before retrying a request while the injection slots are full (µs) */
+#define RETRY_US                50
+
+/** Worst-case SLIP encoding of a frame (slip_max_encoded_size()) */
+#define SLIP_FRAME_MAX          (NSP_MAX_PACKET_SIZE * 2 + 2)
+
+// ============================================================================
+// Recorder
+// ============================================================================
+
+void nsp_replay_rec_begin(nsp_replay_rec_t* rec, uint8_t base_addr, uint64_t start_us,
+                          nsp_replay_sink_t sink, void* ctx) {
+    memset(rec, 0, sizeof(*rec));
+    rec->sink = sink;
+    rec->ctx = ctx;
+    rec->start_us = start_us;
+    slip_decoder_init(&rec->dec[NSP_REPLAY_REQUEST]);
+    slip_decoder_init(&rec->dec[NSP_REPLAY_REPLY]);
+
+    // Record count 0: a capture stays valid however it ends
+    uint8_t header[NSP_REPLAY_HEADER_SIZE] = { 0 };
+    write_u32_le(&header[0], NSP_REPLAY_MAGIC);
+    write_u16_le(&header[4], NSP_REPLAY_VERSION);
+    write_u16_le(&header[6], PHYSICS_TICK_RATE_HZ);
+    header[8] = base_addr;
+    header[9] = EMULATED_WHEEL_COUNT;
+    sink(header, sizeof(header), ctx);
+}
+
+/**
+ * @brief Emit the frame just completed in one direction
+ */
+static void rec_emit(nsp_replay_rec_t* rec, uint8_t dir, uint64_t now_us) {
+    uint64_t elapsed_us = (now_us > rec->start_us) ? now_us - rec->start_us : 0;
+    uint8_t header[NSP_REPLAY_RECORD_SIZE] = { 0 };
+    write_u32_le(&header[0], (uint32_t)(elapsed_us / PHYSICS_TICK_PERIOD_US));
+    write_u32_le(&header[4], (uint32_t)(elapsed_us % PHYSICS_TICK_PERIOD_US));
+    header[8] = dir;
+    write_u16_le(&header[10], rec->len[dir]);
+    rec->sink(header, sizeof(header), rec->ctx);
+    rec->sink(rec->buf[dir], rec->len[dir], rec->ctx);
+    rec->records++;
+}
+
+void nsp_replay_rec_bytes(nsp_replay_rec_t* rec, uint8_t dir, const uint8_t* bytes, size_t len,
+                          uint64_t now_us) {
+    if (rec->sink == NULL || dir > NSP_REPLAY_REPLY) {
+        return;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        uint8_t data;
+        switch (slip_decode_step(&rec->dec[dir], bytes[i], &data)) {
+            case SLIP_EVENT_DATA:
+                if (rec->len[dir] < NSP_MAX_PACKET_SIZE) {
+                    rec->buf[dir][rec->len[dir]++] = data;
+                } else {
+                    rec->overflow[dir] = true;
+                }
+                break;
+
+            case SLIP_EVENT_FRAME_END:
+                if (!rec->overflow[dir] && rec->len[dir] >= NSP_MIN_PACKET_SIZE) {
+                    rec_emit(rec, dir, now_us);
+                }
+                rec->len[dir] = 0;
+                rec->overflow[dir] = false;
+                break;
+
+            case SLIP_EVENT_ERROR:
+                rec->len[dir] = 0;
+                rec->overflow[dir] = false;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+const char* nsp_replay_reader_open(nsp_replay_reader_t* reader, const uint8_t* image, size_t len) {
+    memset(reader, 0, sizeof(*reader));
+    if (image == NULL || len < NSP_REPLAY_HEADER_SIZE) {
+        return "no capture header";
+    }
+    if (read_u32_le(&image[0]) != NSP_REPLAY_MAGIC) {
+        return "not a capture (bad magic)";
+    }
+    if (read_u16_le(&image[4]) != NSP_REPLAY_VERSION) {
+        return "unsupported capture version";
+    }
+    if (read_u16_le(&image[6]) != PHYSICS_TICK_RATE_HZ) {
+        return "recorded at another physics tick rate";
+    }
+
+    reader->image = image;
+    reader->len = len;
+    reader->pos = NSP_REPLAY_HEADER_SIZE;
+    reader->base_addr = image[8];
+    reader->records = read_u32_le(&image[12]);
+    return NULL;
+}
+
+bool nsp_replay_reader_next(nsp_replay_reader_t* reader, nsp_replay_frame_t* frame) {
+    if (reader->image == NULL || (reader->records != 0 && reader->index >= reader->records) ||
+        reader->len - reader->pos < NSP_REPLAY_RECORD_SIZE) {
+        return false;
+    }
+
+    // Erased flash (0xFF) after the last record ends the capture as well
+    const uint8_t* header = &reader->image[reader->pos];
+    uint16_t len = read_u16_le(&header[10]);
+    if (header[8] > NSP_REPLAY_REPLY || len < NSP_MIN_PACKET_SIZE || len > NSP_MAX_PACKET_SIZE ||
+        reader->len - reader->pos - NSP_REPLAY_RECORD_SIZE < len) {
+        return false;
+    }
+
+    frame->tick = read_u32_le(&header[0]);
+    frame->offset_us = read_u32_le(&header[4]);
+    frame->dir = header[8];
+    frame->len = len;
+    frame->data = &header[NSP_REPLAY_RECORD_SIZE];
+    reader->pos += NSP_REPLAY_RECORD_SIZE + len;
+    reader->index++;
+    return true;
+}
+
+// ============================================================================
+// On-Board Replay
+// ============================================================================
+
+static nsp_replay_reader_t player;
+static nsp_replay_frame_t pending;          // Next request (valid while RUNNING)
+static uint64_t pending_due_us = 0;         // Its time in the timebase_get_sim_us() domain
+static uint64_t replay_t0_us = 0;           // Tick 0 of the capture
+static alarm_id_t replay_alarm = 0;         // > 0 while armed
+static bool replay_reported = true;         // End of the run printed
+static nsp_replay_status_t status;
+
+/**
+ * @brief Load the next request of the capture (replies are skipped)
+ *
+ * @return false at the end of the capture
+ */
+static bool next_request(void) {
+    while (nsp_replay_reader_next(&player, &pending)) {
+        if (pending.dir == NSP_REPLAY_REQUEST) {
+            pending_due_us = replay_t0_us + (uint64_t)pending.tick * PHYSICS_TICK_PERIOD_US +
+                             pending.offset_us;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int64_t replay_alarm_cb(alarm_id_t id, void* user_data);
+
+/**
+ * @brief Inject every due request, then arm the next deadline
+ *
+ * Runs from the replay alarm or with interrupts disabled, so the injection
+ * queue keeps a single producer.
+ */
+static void replay_advance(void) {
+    if (status.state != NSP_REPLAY_RUNNING || replay_alarm > 0) {
+        return;
+    }
+
+    for (;;) {
+        uint64_t now_us = timebase_get_sim_us();
+        uint64_t due_us = pending_due_us;
+
+        if (now_us >= due_us) {
+            uint8_t frame[SLIP_FRAME_MAX];
+            size_t len = 0;
+            slip_encode(pending.data, pending.len, frame, &len);
+            if (len == 0 || len > NSP_INJECT_MAX_FRAME) {
+                status.skipped++;
+            } else if (nsp_handler_inject(frame, len)) {
+                status.injected++;
+                status.last_tick = pending.tick;
+                uint32_t late_us = (uint32_t)(now_us - due_us);
+                if (late_us > status.late_max_us) {
+                    status.late_max_us = late_us;
+                }
+            } else {
+                due_us = now_us + RETRY_US;  // Slots full: retry once the service drained one
+            }
+
+            if (due_us == pending_due_us) {
+                if (!next_request()) {
+                    status.state = NSP_REPLAY_DONE;  // Reported by nsp_replay_service()
+                    return;
+                }
+                continue;
+            }
+        }
+
+        if (timebase_get_mode() == TIMEBASE_STEPPED) {
+            return;  // Wall-clock alarm is meaningless: nsp_replay_service() polls
+        }
+        alarm_id_t id = add_alarm_at(from_us_since_boot(due_us), replay_alarm_cb, NULL, false);
+        if (id > 0) {
+            replay_alarm = id;
+            return;  // Armed
+        }
+        if (id < 0) {
+            return;  // No alarm slot: nsp_replay_service() polls instead
+        }
+        // Deadline passed while arming: due now
+    }
+}
+
+static int64_t replay_alarm_cb(alarm_id_t id, void* user_data) {
+    (void)id;
+    (void)user_data;
+    replay_alarm = 0;
+    replay_advance();
+    return 0;  // replay_advance() arms the next deadline itself
+}
+
+bool nsp_replay_start(const uint8_t* image, size_t len) {
+    if (status.state == NSP_REPLAY_RUNNING) {
+        return false;
+    }
+    if (nsp_loadgen_get_state() == NSP_LOADGEN_RUNNING) {
+        printf("[REPLAY] Load test running, replay refused\n");
+        return false;
+    }
+
+    memset(&status, 0, sizeof(status));
+    const char* reason = nsp_replay_reader_open(&player, image, len);
+    if (reason != NULL) {
+        printf("[REPLAY] Capture refused: %s\n", reason);
+        status.state = NSP_REPLAY_FAILED;
+        return false;
+    }
+
+    // Tick 0 of the capture is the next tick boundary (now in stepped mode)
+    uint32_t save = save_and_disable_interrupts();
+    replay_t0_us = timebase_get_sim_us();
+    uint32_t next_us;
+    if (timebase_get_next_tick_us(&next_us)) {
+        int32_t lead_us = (int32_t)(next_us - time_us_32());
+        if (lead_us > 0) {
+            replay_t0_us += (uint32_t)lead_us;
+        }
+    }
+    bool any = next_request();
+    status.state = any ? NSP_REPLAY_RUNNING : NSP_REPLAY_DONE;
+    replay_reported = !any;
+    replay_advance();
+    restore_interrupts(save);
+
+    if (player.base_addr != nsp_handler_get_address()) {
+        printf("[REPLAY] Capture recorded at 0x%02X, emulator at 0x%02X\n",
+               (unsigned)player.base_addr, (unsigned)nsp_handler_get_address());
+    }
+    printf("[REPLAY] Started%s\n", any ? "" : " (no requests in the capture)");
+    return true;
+}
+
+void nsp_replay_stop(void) {
+    uint32_t save = save_and_disable_interrupts();
+    if (replay_alarm > 0) {
+        cancel_alarm(replay_alarm);
+        replay_alarm = 0;
+    }
+    bool stopped = (status.state == NSP_REPLAY_RUNNING);
+    if (stopped) {
+        status.state = NSP_REPLAY_DONE;
+        replay_reported = true;
+    }
+    restore_interrupts(save);
+
+    if (stopped) {
+        printf("[REPLAY] Stopped after %lu requests\n", (unsigned long)status.injected);
+    }
+}
+
+void nsp_replay_service(void) {
+    if (status.state == NSP_REPLAY_RUNNING && replay_alarm == 0) {
+        uint32_t save = save_and_disable_interrupts();
+        replay_advance();
+        restore_interrupts(save);
+    }
+
+    // The alarm finishes runs too, but prints nothing from interrupt context
+    if (status.state == NSP_REPLAY_DONE && !replay_reported) {
+        replay_reported = true;
+        printf("[REPLAY] Done: %lu requests injected, %lu skipped, worst %lu us late\n",
+               (unsigned long)status.injected, (unsigned long)status.skipped,
+               (unsigned long)status.late_max_us);
+    }
+}
+
+void nsp_replay_get_status(nsp_replay_status_t* out) {
+    if (!out) {
+        return;
+    }
+    uint32_t save = save_and_disable_interrupts();
+    *out = status;
+    restore_interrupts(save);
+}
@@ -0,0 +1,215 @@
+/**
+ * @file nsp_replay.h
+ * @brief NSP Traffic Capture and Replay
+ *
+ * Reproduces a bug that needs a particular OBC traffic sequence: the
+ * requests of a run are captured with the physics tick they arrived in,
+ * and replayed later into the same decoder at the same ticks.
+ *
+ * Capture format (little-endian, a file or a flash image):
+ * - Header (16 bytes): magic "NRPL", version, physics tick rate, base
+ *   address, wheel count, record count (0 = up to the end of the image).
+ * - Records (12-byte header, then the decoded NSP frame, CRC included):
+ *   tick since the capture started, microseconds into that tick,
+ *   direction (request or reply) and length.
+ *
+ * Replies are kept next to their requests, so a capture is its own golden
+ * reference, and requests of any address are kept (a shared bus replays
+ * as such). Captures come from the host SIL (--record) or from the bus
+ * monitor on the board (tools/telemetry_stream.py --nrpl).
+ *
+ * Replay:
+ * - Host SIL (--replay): stepped, as fast as the host runs; before each
+ *   tick, the requests recorded for it go through the receiver, and every
+ *   reply is compared byte for byte with the golden capture.
+ * - Board (nsp_replay_start()): in real time from a capture in flash
+ *   (FLASH_REPLAY_OFFSET), aligned to the tick schedule. Each request is
+ *   handed to nsp_handler_inject() at its recorded time from an SDK alarm
+ *   on Core0; nsp_replay_service() covers the case where no alarm slot is
+ *   free. Replies go out on the bus as usual. The load generator uses the
+ *   same injection path, so the two exclude each other.
+ */
+
+#ifndef NSP_REPLAY_H
+#define NSP_REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "drivers/slip.h"
+#include "drivers/nsp.h"
+
+/** Capture magic ("NRPL") and format version */
+#define NSP_REPLAY_MAGIC        0x4C50524Eu
+#define NSP_REPLAY_VERSION      1
+
+/** Header and record header bytes */
+#define NSP_REPLAY_HEADER_SIZE  16
+#define NSP_REPLAY_RECORD_SIZE  12
+
+/** Record directions */
+#define NSP_REPLAY_REQUEST      0       // Received by the emulator (any address)
+#define NSP_REPLAY_REPLY        1       // Sent by the emulator
+
+/**
+ * @brief Capture header
+ */
+typedef struct {
+    uint32_t magic;             // NSP_REPLAY_MAGIC
+    uint16_t version;           // NSP_REPLAY_VERSION
+    uint16_t tick_hz;           // PHYSICS_TICK_RATE_HZ of the recording
+    uint8_t base_addr;          // NSP address of wheel 0
+    uint8_t wheels;             // EMULATED_WHEEL_COUNT of the recording
+    uint16_t reserved;
+    uint32_t records;           // Record count (0 = up to the end)
+} nsp_replay_header_t;
+
+/**
+ * @brief One captured frame as read back
+ */
+typedef struct {
+    uint32_t tick;              // Physics ticks since the capture started
+    uint32_t offset_us;         // Microseconds into that tick
+    uint8_t dir;                // NSP_REPLAY_REQUEST or NSP_REPLAY_REPLY
+    uint16_t len;               // Frame bytes
+    const uint8_t* data;        // Decoded NSP frame (points into the image)
+} nsp_replay_frame_t;
+
+// ============================================================================
+// Recorder
+// ============================================================================
+
+/**
+ * @brief Output of the recorder (header, then record header and frame pairs)
+ */
+typedef void (*nsp_replay_sink_t)(const void* data, size_t len, void* ctx);
+
+/**
+ * @brief Recorder: SLIP byte streams in, capture records out
+ */
+typedef struct {
+    nsp_replay_sink_t sink;
+    void* ctx;
+    uint64_t start_us;                          // Simulation time at tick 0
+    slip_decoder_t dec[2];                      // Per direction
+    uint8_t buf[2][NSP_MAX_PACKET_SIZE];
+    uint16_t len[2];
+    bool overflow[2];
+    uint32_t records;
+} nsp_replay_rec_t;
+
+/**
+ * @brief Start a capture (writes the header)
+ *
+ * @param rec Recorder
+ * @param base_addr NSP address of wheel 0
+ * @param start_us Simulation time of tick 0 (timebase_get_sim_us(), on a tick boundary)
+ * @param sink Output
+ * @param ctx Passed to the sink
+ */
+void nsp_replay_rec_begin(nsp_replay_rec_t* rec, uint8_t base_addr, uint64_t start_us,
+                          nsp_replay_sink_t sink, void* ctx);
+
+/**
+ * @brief Feed bus bytes (SLIP-encoded, any split) to the recorder
+ *
+ * Every complete frame of at least NSP_MIN_PACKET_SIZE bytes becomes a
+ * record stamped with now_us. Frames with a SLIP error or longer than
+ * NSP_MAX_PACKET_SIZE are not recorded.
+ *
+ * @param rec Recorder
+ * @param dir NSP_REPLAY_REQUEST (bytes in) or NSP_REPLAY_REPLY (bytes out)
+ * @param bytes Bus bytes
+ * @param len Byte count
+ * @param now_us Simulation time of arrival (timebase_get_sim_us())
+ */
+void nsp_replay_rec_bytes(nsp_replay_rec_t* rec, uint8_t dir, const uint8_t* bytes, size_t len,
+                          uint64_t now_us);
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+/**
+ * @brief Capture reader (no copy: frames point into the image)
+ */
+typedef struct {
+    const uint8_t* image;
+    size_t len;
+    size_t pos;
+    uint32_t index;             // Records read
+    uint32_t records;           // From the header (0 = up to the end)
+    uint8_t base_addr;
+} nsp_replay_reader_t;
+
+/**
+ * @brief Validate a capture and position the reader on its first record
+ *
+ * @param reader Reader
+ * @param image Capture bytes (RAM or XIP flash)
+ * @param len Capture length (an upper bound is fine with a record count)
+ * @return NULL on success, otherwise the reason it was refused
+ */
+const char* nsp_replay_reader_open(nsp_replay_reader_t* reader, const uint8_t* image, size_t len);
+
+/**
+ * @brief Read the next record
+ *
+ * @param reader Reader
+ * @param frame Output record
+ * @return false at the end (or at a truncated or malformed record)
+ */
+bool nsp_replay_reader_next(nsp_replay_reader_t* reader, nsp_replay_frame_t* frame);
+
+// ============================================================================
+// On-Board Replay (Core0)
+// ============================================================================
+
+/**
+ * @brief Replay states
+ */
+typedef enum {
+    NSP_REPLAY_IDLE = 0,            // Never run
+    NSP_REPLAY_RUNNING,             // Requests remaining
+    NSP_REPLAY_DONE,                // Every request injected
+    NSP_REPLAY_FAILED               // Capture refused (see the console)
+} nsp_replay_state_t;
+
+/**
+ * @brief Replay progress
+ */
+typedef struct {
+    nsp_replay_state_t state;
+    uint32_t injected;          // Requests handed to the receiver
+    uint32_t skipped;           // Requests too long to inject, or no slot on time
+    uint32_t last_tick;         // Capture tick of the last request injected
+    uint32_t late_max_us;       // Worst injection time after the recorded time
+} nsp_replay_status_t;
+
+/**
+ * @brief Start replaying a capture, from the next physics tick
+ *
+ * @param image Capture (e.g. FLASH_STORE_XIP(FLASH_REPLAY_OFFSET)); must stay valid
+ * @param len Capture length bound
+ * @return false if refused (state FAILED, reason printed)
+ */
+bool nsp_replay_start(const uint8_t* image, size_t len);
+
+/**
+ * @brief Stop a replay in progress
+ */
+void nsp_replay_stop(void);
+
+/**
+ * @brief Inject due requests without an alarm (Core0 main loop)
+ */
+void nsp_replay_service(void);
+
+/**
+ * @brief Get the replay progress
+ *
+ * @param status Output
+ */
+void nsp_replay_get_status(nsp_replay_status_t* status);
+
+#endif // NSP_REPLAY_H
@@ -54,6 +54,17 @@
 /** Number of address bits (supports 8 devices: 0-7) */
 #define ADDR_PIN_COUNT      3
 
+/**
+ * Wheels emulated by one board (1-8)
+ *
+ * Wheel k answers NSP address (ADDR[2:0] + k) mod 8 on the shared bus, so a
+ * 4-wheel pyramid strapped to 0 answers 0-3. Set at configure time:
+ * -DNRWA_WHEEL_COUNT=4.
+ */
+#ifndef EMULATED_WHEEL_COUNT
+#define EMULATED_WHEEL_COUNT    1
+#endif
+
 // ============================================================================
 // Status and Control Pins
 // ============================================================================
@@ -61,9 +72,94 @@
 /** Fault output pin (open-drain, active low) */
 #define FAULT_PIN           13
 
+/**
+ * FAULT_PIN assertion delay after the detecting tick starts (microseconds)
+ *
+ * Default for Table 8 fault_pin_delay_us; 0 asserts in the detecting tick.
+ */
+#define FAULT_ASSERT_DELAY_US       0
+
+/** Longest accepted FAULT_PIN assertion delay (microseconds) */
+#define FAULT_ASSERT_DELAY_MAX_US   1000000u
+
 /** Reset input pin (active low) */
 #define RESET_PIN           14
 
+/**
+ * Emulated boot time: RESET_PIN release to the first request answered
+ * (microseconds)
+ *
+ * Default for Table 8 reset_boot_us; set it to the unit's measured figure
+ * (-DRESET_BOOT_US=...). At least one tick, so the reset is applied before
+ * requests are answered: 50 ms, or one tick at rates below 20 Hz.
+ */
+#ifndef RESET_BOOT_US
+#define RESET_BOOT_US               ((PHYSICS_TICK_PERIOD_US > 50000) ? \
+                                     (uint32_t)PHYSICS_TICK_PERIOD_US : 50000u)
+#endif
+
+/** Longest accepted boot time (microseconds) */
+#define RESET_BOOT_MAX_US           5000000u
+
+/**
+ * Lockstep sync input (rising edge = physics step, pull-down)
+ *
+ * Only counted in stepped timebase mode (timebase_set_mode()); each pulse
+ * queues timebase_get_steps_per_pulse() ticks.
+ */
+#define SYNC_IN_PIN         18
+
+/** PPS input for tick discipline (rising edge = top of second, pull-down) */
+#define PPS_IN_PIN          19
+
+/** Discipline the physics tick to PPS_IN_PIN from boot (else via Table 17) */
+#ifndef PPS_DISCIPLINE_DEFAULT
+#define PPS_DISCIPLINE_DEFAULT  0
+#endif
+
+/**
+ * Hall sensor outputs (commutation sequence of wheel 0, drivers/hall_out.h)
+ *
+ * A/B/C must be consecutive (PIO SET pins). Direction is high while the
+ * wheel turns negative.
+ */
+#define HALL_A_PIN          20
+#define HALL_B_PIN          21
+#define HALL_C_PIN          22
+#define HALL_DIR_PIN        26
+
+/** Motor pole pairs: Hall cycles per revolution on each line */
+#ifndef HALL_POLE_PAIRS
+#define HALL_POLE_PAIRS     4
+#endif
+
+/** Below this speed the Hall outputs hold their state (RPM) */
+#define HALL_MIN_RPM        1.0f
+
+/**
+ * PWM analog monitor outputs (wheel 0, drivers/monitor_out.h; add an RC
+ * low-pass, e.g. 10 kΩ / 100 nF)
+ *
+ * Speed and current must be channels A and B of one PWM slice (an even
+ * pin and the next one); torque takes channel A of another slice.
+ */
+#define MONITOR_SPEED_PIN       2
+#define MONITOR_CURRENT_PIN     3
+#define MONITOR_TORQUE_PIN      8
+
+/** Monitor full scales: ±FS maps to 0 V..VDD, zero to mid-scale */
+#define MONITOR_SPEED_FS_RPM    6000.0f
+#define MONITOR_CURRENT_FS_A    6.0f
+#define MONITOR_TORQUE_FS_MNM   320.0f      // 6 A × k_t
+
+/** Ramp between ticks through DMA (0 = one level step per tick) */
+#ifndef MONITOR_UPSAMPLE
+#define MONITOR_UPSAMPLE        1
+#endif
+
+/** Samples per tick when upsampling */
+#define MONITOR_SAMPLES_PER_TICK    32
+
 /** Onboard LED (GP25 on standard Pico, used for heartbeat) */
 #define LED_HEARTBEAT_PIN   PICO_DEFAULT_LED_PIN
 
@@ -84,14 +180,23 @@
 // Hardware Timing Configuration
 // ============================================================================
 
-/** Physics loop tick rate (Hz) */
+/**
+ * Physics loop tick rate (Hz)
+ *
+ * 100 Hz matches the flight unit. Select 200/500/1000 Hz for high-bandwidth
+ * ADCS loop testing at configure time: -DNRWA_PHYSICS_TICK_HZ=1000.
+ */
+#ifndef PHYSICS_TICK_RATE_HZ
 #define PHYSICS_TICK_RATE_HZ    100
+#endif
 
 /** Physics loop tick period (microseconds) */
 #define PHYSICS_TICK_PERIOD_US  (1000000 / PHYSICS_TICK_RATE_HZ)
 
-/** Maximum allowed jitter in physics tick (microseconds) */
-#define MAX_TICK_JITTER_US      200
+/** Maximum allowed jitter in physics tick (microseconds, 2% of the period) */
+#ifndef MAX_TICK_JITTER_US
+#define MAX_TICK_JITTER_US      (PHYSICS_TICK_PERIOD_US / 50)
+#endif
 
 /** RS-485 DE/RE timing: microseconds to assert DE before TX */
 #define RS485_DE_SETUP_US       10
@@ -103,12 +208,24 @@
 // Memory and Buffer Configuration
 // ============================================================================
 
-/** RS-485 RX ring buffer size (must be power of 2) */
-#define RS485_RX_BUFFER_SIZE    1024
+/**
+ * RS-485 RX ring buffer size (must be power of 2)
+ *
+ * Filled from the UART1 RX interrupt. 4 KB holds ~89 ms of back-to-back
+ * traffic at 460.8 kbps, which covers a full TUI redraw plus the main loop
+ * sleep without dropping bytes.
+ */
+#define RS485_RX_BUFFER_SIZE    4096
 
 /** RS-485 TX ring buffer size (must be power of 2) */
 #define RS485_TX_BUFFER_SIZE    1024
 
+/** Deferred (timed) RS-485 transmissions held at once */
+#define RS485_DEFER_DEPTH       4
+
+/** Deferred frame capacity (worst-case SLIP-encoded NSP reply is 522 bytes) */
+#define RS485_DEFER_FRAME_SIZE  528
+
 /** Maximum SLIP frame size (bytes) */
 #define SLIP_MAX_FRAME_SIZE     256
 
@@ -138,6 +255,24 @@
 /** Flash offset for scenario storage (starts at 1.5 MB from flash base) */
 #define FLASH_SCENARIO_OFFSET   0x00180000
 
+/** Reserved flash size for cached checkpoint-test results (8 KB) */
+#define FLASH_TEST_CACHE_SIZE   (2 * FLASH_SECTOR_SIZE)
+
+/** Flash offset for cached test results (after the scenario partition) */
+#define FLASH_TEST_CACHE_OFFSET (FLASH_SCENARIO_OFFSET + FLASH_SCENARIO_SIZE)
+
+/** Reserved flash size for the persistent configuration log (16 KB) */
+#define FLASH_CONFIG_SIZE       (4 * FLASH_SECTOR_SIZE)
+
+/** Flash offset for the configuration log (after the test cache) */
+#define FLASH_CONFIG_OFFSET     (FLASH_TEST_CACHE_OFFSET + FLASH_TEST_CACHE_SIZE)
+
+/** Reserved flash size for an NSP traffic capture to replay (256 KB, nsp_replay.h) */
+#define FLASH_REPLAY_SIZE       (64 * FLASH_SECTOR_SIZE)
+
+/** Flash offset for the replay capture (after the configuration log; picotool load) */
+#define FLASH_REPLAY_OFFSET     (FLASH_CONFIG_OFFSET + FLASH_CONFIG_SIZE)
+
 // ============================================================================
 // Core Assignment
 // ============================================================================
@@ -176,5 +311,23 @@
 BOARD_STATIC_ASSERT(IS_VALID_GPIO(RS485_UART_TX_PIN), "RS485 TX pin invalid");
 BOARD_STATIC_ASSERT(IS_VALID_GPIO(RS485_UART_RX_PIN), "RS485 RX pin invalid");
 BOARD_STATIC_ASSERT(RS485_UART_TX_PIN != RS485_UART_RX_PIN, "TX/RX pins must differ");
+BOARD_STATIC_ASSERT(HALL_B_PIN == HALL_A_PIN + 1 && HALL_C_PIN == HALL_A_PIN + 2,
+                    "Hall A/B/C pins must be consecutive");
+BOARD_STATIC_ASSERT(IS_VALID_GPIO(HALL_C_PIN) && IS_VALID_GPIO(HALL_DIR_PIN), "Hall pin invalid");
+BOARD_STATIC_ASSERT((MONITOR_SPEED_PIN & 1) == 0 && MONITOR_CURRENT_PIN == MONITOR_SPEED_PIN + 1,
+                    "speed/current monitors must be PWM channels A/B of one slice");
+BOARD_STATIC_ASSERT((MONITOR_TORQUE_PIN & 1) == 0 &&
+                    ((MONITOR_TORQUE_PIN >> 1) & 7) != ((MONITOR_SPEED_PIN >> 1) & 7),
+                    "torque monitor must be PWM channel A of another slice");
+BOARD_STATIC_ASSERT((RS485_RX_BUFFER_SIZE & (RS485_RX_BUFFER_SIZE - 1)) == 0,
+                    "RS485 RX buffer size must be power of 2");
+BOARD_STATIC_ASSERT(PHYSICS_TICK_RATE_HZ >= 10 && PHYSICS_TICK_RATE_HZ <= 1000,
+                    "Physics tick rate must be 10-1000 Hz");
+BOARD_STATIC_ASSERT((1000000 % PHYSICS_TICK_RATE_HZ) == 0,
+                    "Physics tick period must be a whole number of microseconds");
+BOARD_STATIC_ASSERT(RESET_BOOT_US >= PHYSICS_TICK_PERIOD_US && RESET_BOOT_US <= RESET_BOOT_MAX_US,
+                    "Boot time must cover a tick (reset applied first) and fit RESET_BOOT_MAX_US");
+BOARD_STATIC_ASSERT(EMULATED_WHEEL_COUNT >= 1 && EMULATED_WHEEL_COUNT <= (1 << ADDR_PIN_COUNT),
+                    "Wheel count must fit the NSP address space (1-8)");
 
 #endif // BOARD_PICO_H
@@ -0,0 +1,119 @@
+/**
+ * @file clock_profile.c
+ * @brief System Clock Performance Profiles Implementation
+ */
+
+#include "clock_profile.h"
+#include "board_pico.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/vreg.h"
+
+// ============================================================================
+// Profile Table
+// ============================================================================
+
+typedef struct {
+    const char* name;
+    uint32_t sys_khz;
+    enum vreg_voltage vreg;
+} clock_profile_def_t;
+
+static const clock_profile_def_t profiles[CLOCK_PROFILE_COUNT] = {
+    [CLOCK_PROFILE_STANDARD] = { "STANDARD", 125000, VREG_VOLTAGE_DEFAULT },
+    [CLOCK_PROFILE_FAST]     = { "FAST",     200000, VREG_VOLTAGE_1_15 },
+    [CLOCK_PROFILE_TURBO]    = { "TURBO",    250000, VREG_VOLTAGE_1_20 },
+};
+
+/** Regulator settling time after a voltage step */
+#define VREG_SETTLE_US              1000
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+static clock_profile_t active_profile = CLOCK_PROFILE_STANDARD;
+static const char* apply_status = NULL;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+uint32_t clock_profile_uart_baud(uint32_t peri_hz, uint32_t baud) {
+    // PL011: 16.6 fixed-point divisor of clk_peri / (16 · baud), rounded
+    // to the nearest 1/64 the way uart_set_baudrate() does
+    uint32_t div = (uint32_t)((8ull * peri_hz) / baud) + 1u;
+    uint32_t ibrd = div >> 7;
+    uint32_t fbrd;
+    if (ibrd == 0) {
+        ibrd = 1;
+        fbrd = 0;
+    } else if (ibrd >= 65535) {
+        ibrd = 65535;
+        fbrd = 0;
+    } else {
+        fbrd = (div & 0x7F) >> 1;
+    }
+    return (uint32_t)((4ull * peri_hz) / (64u * ibrd + fbrd));
+}
+
+int32_t clock_profile_baud_error_ppm(uint32_t actual, uint32_t nominal) {
+    return (int32_t)((((int64_t)actual - (int64_t)nominal) * 1000000) / (int64_t)nominal);
+}
+
+bool clock_profile_apply(clock_profile_t profile) {
+    apply_status = NULL;
+    if (profile >= CLOCK_PROFILE_COUNT) {
+        apply_status = "unknown profile";
+        return false;
+    }
+    const clock_profile_def_t* p = &profiles[profile];
+    uint32_t sys_hz = p->sys_khz * 1000u;
+
+    uint vco_hz, post_div1, post_div2;
+    if (!check_sys_clock_khz(p->sys_khz, &vco_hz, &post_div1, &post_div2)) {
+        apply_status = "PLL cannot make this frequency";
+        return false;
+    }
+
+    // Flash writes re-run boot2, which restores its own SCK divider
+    if (sys_hz / PICO_FLASH_SPI_CLKDIV > CLOCK_FLASH_SCK_MAX_HZ) {
+        apply_status = "flash SCK above rating (raise PICO_FLASH_SPI_CLKDIV)";
+        return false;
+    }
+
+    // clk_peri follows clk_sys: check the RS-485 divisor before committing
+    uint32_t baud = clock_profile_uart_baud(sys_hz, RS485_BAUD_RATE);
+    int32_t error_ppm = clock_profile_baud_error_ppm(baud, RS485_BAUD_RATE);
+    if (error_ppm > CLOCK_UART_BAUD_TOLERANCE_PPM || error_ppm < -CLOCK_UART_BAUD_TOLERANCE_PPM) {
+        apply_status = "UART baud error out of tolerance";
+        return false;
+    }
+
+    if (clock_get_hz(clk_sys) != sys_hz) {
+        // Voltage up first; the regulator settles on the unchanged clk_ref
+        // timer, which is also what keeps the physics timebase exact
+        vreg_set_voltage(p->vreg);
+        busy_wait_us(VREG_SETTLE_US);
+        set_sys_clock_pll(vco_hz, post_div1, post_div2);
+    }
+
+    active_profile = profile;
+    return true;
+}
+
+clock_profile_t clock_profile_get(void) {
+    return active_profile;
+}
+
+const char* clock_profile_get_name(clock_profile_t profile) {
+    return (profile < CLOCK_PROFILE_COUNT) ? profiles[profile].name : "?";
+}
+
+uint32_t clock_profile_get_sys_hz(void) {
+    return clock_get_hz(clk_sys);
+}
+
+const char* clock_profile_get_status(void) {
+    return apply_status;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file clock_profile.h
+ * @brief System Clock Performance Profiles
+ *
+ * The RP2040 boots at 125 MHz. A faster profile raises clk_sys (and with
+ * it clk_peri, which clocks the UART) for multi-wheel clusters and high
+ * tick rates. A profile is applied once at boot, before any peripheral is
+ * set up, and only if it passes the checks below; otherwise the board
+ * stays at 125 MHz:
+ *
+ * - The PLL can make the frequency exactly.
+ * - QSPI flash SCK (clk_sys / PICO_FLASH_SPI_CLKDIV, the boot2 divider
+ *   that flash writes restore) stays within the flash part's rating.
+ * - The PL011 divisor at the new clk_peri is within ±1% of 460.8 kbps.
+ *
+ * The core voltage is raised before the switch. The physics timebase
+ * counts the 1 MHz timer tick from clk_ref (XOSC), which a clk_sys change
+ * does not touch, so tick periods stay exact at any profile. Cycle figures
+ * (profiler, Table 12) scale with the clock.
+ */
+
+#ifndef CLOCK_PROFILE_H
+#define CLOCK_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Clock profiles
+ */
+typedef enum {
+    CLOCK_PROFILE_STANDARD = 0,     // 125 MHz, 1.10 V (SDK default)
+    CLOCK_PROFILE_FAST = 1,         // 200 MHz, 1.15 V
+    CLOCK_PROFILE_TURBO = 2,        // 250 MHz, 1.20 V
+    CLOCK_PROFILE_COUNT
+} clock_profile_t;
+
+/** Profile applied at boot (cmake -DNRWA_CLOCK_PROFILE=FAST ..) */
+#ifndef CLOCK_PROFILE_DEFAULT
+#define CLOCK_PROFILE_DEFAULT       CLOCK_PROFILE_STANDARD
+#endif
+
+/** Boot2 QSPI clock divider (SDK default for the W25Q080 boot stage) */
+#ifndef PICO_FLASH_SPI_CLKDIV
+#define PICO_FLASH_SPI_CLKDIV       2
+#endif
+
+/** Highest QSPI SCK the flash is rated for (W25Q16JV: 133 MHz) */
+#define CLOCK_FLASH_SCK_MAX_HZ      133000000u
+
+/** Largest UART baud error a profile may introduce */
+#define CLOCK_UART_BAUD_TOLERANCE_PPM 10000
+
+/**
+ * @brief Apply a profile (boot, before stdio and peripheral init)
+ *
+ * @param profile Requested profile
+ * @return true if the profile is active; false (with the reason saved for
+ *         clock_profile_get_status()) if it was rejected and 125 MHz kept
+ */
+bool clock_profile_apply(clock_profile_t profile);
+
+/**
+ * @brief Get the active profile
+ *
+ * @return Profile in effect
+ */
+clock_profile_t clock_profile_get(void);
+
+/**
+ * @brief Get a profile's name
+ *
+ * @param profile Profile
+ * @return Short name ("STANDARD", "FAST", "TURBO"), "?" if out of range
+ */
+const char* clock_profile_get_name(clock_profile_t profile);
+
+/**
+ * @brief Get the system clock
+ *
+ * @return clk_sys in Hz
+ */
+uint32_t clock_profile_get_sys_hz(void);
+
+/**
+ * @brief Get the outcome of the boot-time apply (for the banner)
+ *
+ * @return NULL if the requested profile is active, else why it was rejected
+ */
+const char* clock_profile_get_status(void);
+
+/**
+ * @brief Baud rate the PL011 divisor produces (same rounding as uart_init)
+ *
+ * @param peri_hz UART reference clock (clk_peri)
+ * @param baud Requested baud rate
+ * @return Actual baud rate
+ */
+uint32_t clock_profile_uart_baud(uint32_t peri_hz, uint32_t baud);
+
+/**
+ * @brief Signed baud error in ppm
+ *
+ * @param actual Actual baud rate
+ * @param nominal Requested baud rate
+ * @return (actual - nominal) / nominal in ppm
+ */
+int32_t clock_profile_baud_error_ppm(uint32_t actual, uint32_t nominal);
+
+#endif // CLOCK_PROFILE_H
@@ -59,6 +59,8 @@ static void gpio_init_address_pins(void) {
  *
  * FAULT: Open-drain output (active low), indicates fault condition
  * RESET: Input with pull-up (active low), allows external reset
+ * SYNC: Input with pull-down, lockstep tick pulses from an external clock
+ * PPS: Input with pull-down, pulse-per-second reference for the tick
  */
 static void gpio_init_fault_reset(void) {
     // FAULT pin: Configure as output, initially high (no fault)
@@ -73,8 +75,19 @@ static void gpio_init_fault_reset(void) {
     gpio_set_dir(RESET_PIN, GPIO_IN);
     gpio_pull_up(RESET_PIN);
 
-    printf("[GPIO] Fault/Reset pins initialized (FAULT=%d, RESET=%d)\n",
-           FAULT_PIN, RESET_PIN);
+    // SYNC input: pull-down so an unconnected pin never steps (edge IRQ is
+    // installed by the timebase on Core1)
+    gpio_init(SYNC_IN_PIN);
+    gpio_set_dir(SYNC_IN_PIN, GPIO_IN);
+    gpio_pull_down(SYNC_IN_PIN);
+
+    // PPS input: same, for the tick discipline PLL
+    gpio_init(PPS_IN_PIN);
+    gpio_set_dir(PPS_IN_PIN, GPIO_IN);
+    gpio_pull_down(PPS_IN_PIN);
+
+    printf("[GPIO] Fault/Reset/Sync/PPS pins initialized (FAULT=%d, RESET=%d, SYNC=%d, PPS=%d)\n",
+           FAULT_PIN, RESET_PIN, SYNC_IN_PIN, PPS_IN_PIN);
 }
 
 /**
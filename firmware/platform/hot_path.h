@@ -0,0 +1,65 @@
+/**
+ * @file hot_path.h
+ * @brief SRAM Placement of the Real-Time Paths (NRWA_SRAM_HOT_PATHS)
+ *
+ * By default everything outside the few ISR and flash-write paths that
+ * must run from RAM executes in place from XIP flash. A miss in the 16 KB
+ * XIP cache stalls the fetching core for a QSPI read, and Core0 console
+ * work (TUI strings, table walks) evicts Core1 lines, which shows up as
+ * tick jitter spikes.
+ *
+ * With the NRWA_SRAM_HOT_PATHS build profile, the macros below copy the
+ * Core1 tick path, the timebase ISRs, CRC/SLIP framing and NSP dispatch
+ * to striped SRAM at boot, and the same source files are compiled at -O2
+ * while the rest of the image stays -Os (see firmware/CMakeLists.txt).
+ * Core1-owned state goes to SRAM4 (scratch X), the bank that already holds
+ * the Core1 stack; SRAM5 (scratch Y) keeps the Core0 stack, so neither
+ * core's stack traffic contends with the other or with striped SRAM.
+ *
+ * Without the profile the macros expand to the plain declaration, so the
+ * default image is unchanged. The host build has no sections either.
+ */
+
+#ifndef HOT_PATH_H
+#define HOT_PATH_H
+
+#include "pico/platform.h"
+
+#ifndef NRWA_SRAM_HOT_PATHS
+#define NRWA_SRAM_HOT_PATHS 0
+#endif
+
+/**
+ * Scratch X is 4 KB with PICO_CORE1_STACK_SIZE (2 KB) at its top; wheel
+ * states up to this count fit beside the stack with room for the other
+ * Core1 state. Larger clusters keep the wheel array in main SRAM.
+ */
+#define CORE1_SCRATCH_MAX_WHEELS    4
+
+#if NRWA_SRAM_HOT_PATHS
+
+/** Function executed from SRAM (definition: `void HOT_PATH_FUNC(name)(...)`) */
+#define HOT_PATH_FUNC(func_name)    __not_in_flash_func(func_name)
+
+/** Constant table read by a hot path, kept in SRAM with it */
+#define HOT_PATH_DATA(group)        __not_in_flash(group)
+
+/** Core1-owned variable placed in SRAM4 beside the Core1 stack */
+#define CORE1_DATA(group)           __scratch_x(group)
+
+#else
+
+#define HOT_PATH_FUNC(func_name)    func_name
+#define HOT_PATH_DATA(group)
+#define CORE1_DATA(group)
+
+#endif
+
+/** Placement of the wheel state array (SRAM4 only when it fits) */
+#if NRWA_SRAM_HOT_PATHS && (EMULATED_WHEEL_COUNT <= CORE1_SCRATCH_MAX_WHEELS)
+#define CORE1_WHEEL_DATA            CORE1_DATA("wheels")
+#else
+#define CORE1_WHEEL_DATA
+#endif
+
+#endif // HOT_PATH_H
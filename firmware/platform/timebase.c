@@ -2,14 +2,28 @@
  * @file timebase.c
  * @brief Timebase Management for NRWA-T6 Emulator
  *
- * Provides a 100 Hz hardware alarm for Core1 physics simulation and
+ * Provides a PHYSICS_TICK_RATE_HZ (100 Hz default) hardware alarm for Core1 physics simulation and
  * microsecond-resolution timing for performance measurement.
+ *
+ * Ticks follow an absolute schedule in nanoseconds. With PPS discipline
+ * enabled a PLL on PPS_IN_PIN edges trims each period so the ticks of
+ * every board on the same PPS land on the same microsecond.
+ *
+ * In stepped mode the alarm is off and ticks come from an external clock:
+ * timebase_step() on Core0 (NSP SIM-STEP, console) or rising edges on
+ * SYNC_IN_PIN (GPIO IRQ on Core1). Each source has its own request counter
+ * with a single writer, so no lock is shared between the cores.
  */
 
 #include "board_pico.h"
 #include "timebase.h"
+#include "hot_path.h"
+#include "util/latency_hist.h"
 #include "hardware/timer.h"
 #include "hardware/irq.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "hardware/structs/systick.h"
 #include <stdio.h>
 
 // ============================================================================
@@ -19,18 +33,282 @@
 /** Callback function for physics tick (set by user) */
 static timebase_tick_callback_t tick_callback = NULL;
 
-/** Tick counter (increments at 100 Hz) */
+/** Tick counter (increments at PHYSICS_TICK_RATE_HZ) */
 static volatile uint32_t tick_count = 0;
 
-/** Jitter measurement: last tick timestamp (microseconds) */
-static volatile uint64_t last_tick_us = 0;
+/** Alarm target of the next tick (microseconds, absolute schedule) */
+static volatile uint64_t sched_tick_us = 0;
+
+/** Sub-microsecond remainder of the schedule (nanoseconds, 0-999) */
+static uint32_t sched_frac_ns = 0;
 
 /** Jitter measurement: maximum observed jitter (microseconds) */
 static volatile uint32_t max_jitter_us = 0;
 
+/** Wake-up latency: alarm target to ISR entry, every tick (written in the ISR) */
+static latency_hist_t wake_hist;
+
+/** Wake-up latency of the most recent tick (microseconds) */
+static volatile uint32_t last_wake_us = 0;
+
 /** Alarm number used for physics tick (use alarm 0) */
 #define PHYSICS_ALARM_NUM 0
 
+/** PPS capture range: edge intervals (and frequency corrections) within ±this (ppm) */
+#define PPS_CAPTURE_PPM     500
+
+/** PPS offset counted as in lock (microseconds) */
+#define PPS_LOCK_US         5
+
+/** Consecutive in-lock edges before LOCKED */
+#define PPS_LOCK_COUNT      4
+
+/** No edge for this long: holdover (microseconds) */
+#define PPS_TIMEOUT_US      2500000u
+
+/** Alarm scheduled (between timebase_start() and timebase_stop()) */
+static volatile bool alarm_running = false;
+
+/** One-shot sharing the tick alarm (Core1; NULL = none pending) */
+static volatile timebase_tick_callback_t oneshot_cb = NULL;
+static volatile uint32_t oneshot_us = 0;
+
+/** One-shot closer than this is run at once (alarm write vs. target race) */
+#define ONESHOT_MIN_LEAD_US 3
+
+/** Tick source */
+static volatile timebase_mode_t tick_mode = TIMEBASE_FREE_RUN;
+
+/** Steps requested by timebase_step() (written on Core0 only) */
+static volatile uint32_t steps_cmd = 0;
+
+/** Steps requested by SYNC_IN_PIN edges (written by the Core1 GPIO ISR only) */
+static volatile uint32_t steps_pulse = 0;
+
+/** Steps run (written by the Core1 tick loop only) */
+static volatile uint32_t steps_taken = 0;
+
+/** Ticks queued per sync pulse */
+static volatile uint32_t steps_per_pulse = 1;
+
+/** Simulation clock: time and steps_taken on entry to stepped mode */
+static uint64_t sim_entry_us = 0;
+static uint32_t sim_entry_steps = 0;
+
+/** Simulation clock while free-running: wall time plus this offset */
+static int64_t sim_offset_us = 0;
+
+// PPS discipline (all state below is written on Core1 only: the PPS edge
+// ISR and the alarm ISR share a core and a priority, so they never nest)
+
+/** Core0 request: discipline the schedule to PPS_IN_PIN */
+static volatile bool pps_enabled = PPS_DISCIPLINE_DEFAULT;
+
+/** Loop state and statistics (read by Core0 for display) */
+static timebase_pps_stats_t pps;
+
+/** Frequency correction (ns per tick, Q8 for sub-ns resolution) */
+static int32_t pps_freq_q8 = 0;
+
+/** Phase slew (ns per tick) and ticks left to apply it */
+static int32_t pps_slew_ns = 0;
+static uint32_t pps_slew_ticks = 0;
+
+/** Previous edge (microseconds, 0 = none yet) and good edges in lock range */
+static uint64_t pps_last_edge_us = 0;
+static uint32_t pps_in_range = 0;
+
+// ============================================================================
+// Alarm Scheduling
+// ============================================================================
+
+/**
+ * @brief Arm the alarm for the next tick or the pending one-shot, whichever is first
+ *
+ * A one-shot already due (or too close to arm safely) runs here instead.
+ * Called with the alarm interrupt unable to preempt (ISR or IRQs off).
+ */
+static void HOT_PATH_FUNC(alarm_arm)(void) {
+    uint32_t target = (uint32_t)sched_tick_us;
+    timebase_tick_callback_t cb = oneshot_cb;
+    if (cb != NULL) {
+        if ((int32_t)(oneshot_us - time_us_32()) < ONESHOT_MIN_LEAD_US) {
+            oneshot_cb = NULL;
+            cb();
+        } else if ((int32_t)(oneshot_us - target) < 0) {
+            target = oneshot_us;
+        }
+    }
+    timer_hw->alarm[PHYSICS_ALARM_NUM] = target;
+}
+
+// ============================================================================
+// PPS Discipline
+// ============================================================================
+//
+// A type-2 PLL run once per PPS edge. The phase error is the edge's offset
+// from the nearest scheduled tick; half of it is slewed out over the next
+// second and an eighth feeds the frequency term, which converges on the
+// local clock's offset from the PPS (closed-loop poles at |z| = 0.71).
+// Acquisition sets the frequency from the first edge interval and steps
+// the schedule onto the edge once.
+
+/**
+ * @brief Tick period for the next tick (nanoseconds, nominal plus corrections)
+ */
+static uint32_t HOT_PATH_FUNC(pps_tick_period_ns)(void) {
+    int32_t adj_ns = (pps_freq_q8 >> 8);
+    if (pps_slew_ticks > 0) {
+        pps_slew_ticks--;
+        adj_ns += pps_slew_ns;
+    }
+    return (uint32_t)((int32_t)(PHYSICS_TICK_PERIOD_US * 1000u) + adj_ns);
+}
+
+/**
+ * @brief Move the schedule one period on
+ */
+static void HOT_PATH_FUNC(schedule_advance)(uint32_t period_ns) {
+    sched_frac_ns += period_ns;
+    uint32_t whole_us = sched_frac_ns / 1000u;
+    sched_frac_ns -= whole_us * 1000u;
+    sched_tick_us += whole_us;
+    pps.period_ns = period_ns;
+}
+
+/**
+ * @brief Reset the loop to nominal (disabled or restarted)
+ */
+static void pps_reset(timebase_pps_state_t state) {
+    pps_freq_q8 = 0;
+    pps_slew_ns = 0;
+    pps_slew_ticks = 0;
+    pps_last_edge_us = 0;
+    pps_in_range = 0;
+    pps.state = state;
+    pps.offset_us = 0;
+    pps.max_offset_us = 0;
+    pps.drift_ppb = 0;
+}
+
+/**
+ * @brief Apply Core0's enable/disable and detect a lost PPS (every tick)
+ */
+static void HOT_PATH_FUNC(pps_check_holdover)(uint64_t now_us) {
+    if (!pps_enabled) {
+        if (pps.state != TIMEBASE_PPS_OFF) {
+            pps_reset(TIMEBASE_PPS_OFF);
+        }
+        return;
+    }
+    if (pps.state == TIMEBASE_PPS_OFF) {
+        pps_reset(TIMEBASE_PPS_ACQUIRING);
+        return;
+    }
+    if ((pps.state == TIMEBASE_PPS_TRACKING || pps.state == TIMEBASE_PPS_LOCKED) &&
+        now_us - pps_last_edge_us > PPS_TIMEOUT_US) {
+        // Keep the frequency estimate, stop correcting phase
+        if (pps.state == TIMEBASE_PPS_LOCKED) {
+            pps.lock_losses++;
+        }
+        pps.state = TIMEBASE_PPS_HOLDOVER;
+        pps_slew_ticks = 0;
+        pps_in_range = 0;
+    }
+}
+
+/**
+ * @brief Offset of an edge from the nearest scheduled tick (microseconds)
+ *
+ * Positive: the edge came after the tick, i.e. the ticks run early.
+ */
+static int32_t HOT_PATH_FUNC(pps_phase_error_us)(uint64_t edge_us) {
+    int32_t period_us = (int32_t)(pps.period_ns / 1000u);
+    int64_t since_tick = (int64_t)edge_us - (int64_t)(sched_tick_us - (uint64_t)period_us);
+    int32_t phase = (int32_t)(since_tick % period_us);
+    if (phase < 0) {
+        phase += period_us;
+    }
+    return (phase > period_us / 2) ? phase - period_us : phase;
+}
+
+/**
+ * @brief One PPS edge through the loop
+ */
+static void HOT_PATH_FUNC(pps_edge)(uint64_t edge_us) {
+    pps.pulses++;
+    if (!pps_enabled || pps.state == TIMEBASE_PPS_OFF ||
+        tick_mode != TIMEBASE_FREE_RUN || !alarm_running) {
+        return;
+    }
+
+    uint64_t prev_us = pps_last_edge_us;
+    pps_last_edge_us = edge_us;
+    if (prev_us == 0) {
+        return;  // First edge: nothing to compare with yet
+    }
+
+    // An edge interval outside the capture range is a glitch or a missed
+    // pulse: skip it, the next good pair restarts from there
+    int32_t interval_err_us = (int32_t)(edge_us - prev_us) - 1000000;
+    pps.last_interval_us = (uint32_t)(edge_us - prev_us);
+    if (interval_err_us > PPS_CAPTURE_PPM || interval_err_us < -PPS_CAPTURE_PPM) {
+        pps.rejected++;
+        pps_in_range = 0;
+        return;
+    }
+
+    int32_t err_us = pps_phase_error_us(edge_us);
+    pps.offset_us = err_us;
+    int32_t abs_err = (err_us < 0) ? -err_us : err_us;
+
+    if (pps.state == TIMEBASE_PPS_ACQUIRING) {
+        // Frequency from the interval (local µs per PPS second), then one
+        // phase step onto the edge; a negative step never lands in the past
+        pps_freq_q8 = (int32_t)(((int64_t)interval_err_us * 1000 * 256) / PHYSICS_TICK_RATE_HZ);
+        sched_tick_us += (uint64_t)(int64_t)err_us;
+        if (sched_tick_us <= time_us_64()) {
+            sched_tick_us += PHYSICS_TICK_PERIOD_US;
+        }
+        alarm_arm();
+        pps.state = TIMEBASE_PPS_TRACKING;
+        pps.max_offset_us = 0;
+    } else {
+        // PI update: Kp = 1/2 slewed over the next second, Ki = 1/8
+        int64_t err_ns = (int64_t)err_us * 1000;
+        pps_slew_ns = (int32_t)(err_ns / (2 * PHYSICS_TICK_RATE_HZ));
+        pps_slew_ticks = PHYSICS_TICK_RATE_HZ;
+        pps_freq_q8 += (int32_t)((err_ns * 256) / (8 * PHYSICS_TICK_RATE_HZ));
+
+        // Clamp to the capture range so a bad run cannot pull the tick away
+        int32_t max_q8 = (int32_t)(((int64_t)PPS_CAPTURE_PPM * 1000 * 256) / PHYSICS_TICK_RATE_HZ);
+        if (pps_freq_q8 > max_q8) pps_freq_q8 = max_q8;
+        if (pps_freq_q8 < -max_q8) pps_freq_q8 = -max_q8;
+
+        if (pps.state == TIMEBASE_PPS_HOLDOVER) {
+            pps.state = TIMEBASE_PPS_TRACKING;
+        }
+        if ((uint32_t)abs_err > pps.max_offset_us) {
+            pps.max_offset_us = (uint32_t)abs_err;
+        }
+        if (abs_err <= PPS_LOCK_US) {
+            if (++pps_in_range >= PPS_LOCK_COUNT && pps.state == TIMEBASE_PPS_TRACKING) {
+                pps.state = TIMEBASE_PPS_LOCKED;
+                pps.max_offset_us = (uint32_t)abs_err;  // Max while locked from here
+            }
+        } else {
+            pps_in_range = 0;
+            if (pps.state == TIMEBASE_PPS_LOCKED) {
+                pps.state = TIMEBASE_PPS_TRACKING;
+                pps.lock_losses++;
+            }
+        }
+    }
+
+    // Frequency term as a fraction of the period (local clock vs. PPS)
+    pps.drift_ppb = (int32_t)(((int64_t)pps_freq_q8 * 1000000) / (256 * (int64_t)PHYSICS_TICK_PERIOD_US));
+}
+
 // ============================================================================
 // Hardware Alarm ISR
 // ============================================================================
@@ -38,33 +316,41 @@ static volatile uint32_t max_jitter_us = 0;
 /**
  * @brief Hardware alarm interrupt handler
  *
- * Fires at 100 Hz to trigger physics simulation tick.
- * Measures jitter and calls user callback.
+ * Fires at PHYSICS_TICK_RATE_HZ to trigger physics simulation tick.
+ * Measures jitter and calls user callback. Also fires early for a pending
+ * one-shot (timebase_schedule_oneshot()).
  */
-static void timebase_alarm_isr(void) {
+static void HOT_PATH_FUNC(timebase_alarm_isr)(void) {
     // Clear the alarm interrupt
     hw_clear_bits(&timer_hw->intr, 1u << PHYSICS_ALARM_NUM);
 
-    // Measure jitter
+    // A one-shot alarm ahead of the tick: run it and re-arm for the tick,
+    // unless that is due by now too (an alarm written late never fires)
     uint64_t now_us = time_us_64();
-    if (last_tick_us != 0) {
-        uint64_t expected_us = last_tick_us + PHYSICS_TICK_PERIOD_US;
-        int64_t jitter = (int64_t)now_us - (int64_t)expected_us;
-        uint32_t abs_jitter = (jitter < 0) ? -jitter : jitter;
-
-        if (abs_jitter > max_jitter_us) {
-            max_jitter_us = abs_jitter;
+    if (now_us < sched_tick_us) {
+        alarm_arm();
+        if (time_us_64() < sched_tick_us) {
+            return;
         }
+        now_us = time_us_64();
+    }
 
-        // Warn if jitter exceeds spec
-        if (abs_jitter > MAX_TICK_JITTER_US) {
-            // Note: Don't printf in ISR for production code
-            // This is for debugging only
-            // printf("[WARN] Tick jitter: %u us (max allowed: %u us)\n",
-            //        abs_jitter, MAX_TICK_JITTER_US);
-        }
+    // The tick alarm never fires early, so arrival after its target is both
+    // the jitter and the wake-up latency
+    uint32_t late_us = (now_us > sched_tick_us) ? (uint32_t)(now_us - sched_tick_us) : 0;
+    if (late_us > max_jitter_us) {
+        max_jitter_us = late_us;
+    }
+    last_wake_us = late_us;
+    latency_hist_record(&wake_hist, late_us);
+
+    // Warn if jitter exceeds spec
+    if (late_us > MAX_TICK_JITTER_US) {
+        // Note: Don't printf in ISR for production code
+        // This is for debugging only
+        // printf("[WARN] Tick jitter: %u us (max allowed: %u us)\n",
+        //        late_us, MAX_TICK_JITTER_US);
     }
-    last_tick_us = now_us;
 
     // Increment tick counter
     tick_count++;
@@ -74,9 +360,38 @@ static void timebase_alarm_isr(void) {
         tick_callback();
     }
 
-    // Re-arm the alarm for next tick (absolute time to avoid drift)
-    uint64_t next_tick_us = last_tick_us + PHYSICS_TICK_PERIOD_US;
-    timer_hw->alarm[PHYSICS_ALARM_NUM] = (uint32_t)next_tick_us;
+    // Re-arm from the schedule, not from the wake-up, so latency does not
+    // accumulate; after a stall longer than a period restart from now
+    pps_check_holdover(now_us);
+    schedule_advance(pps_tick_period_ns());
+    if (sched_tick_us <= time_us_64()) {
+        sched_tick_us = time_us_64() + PHYSICS_TICK_PERIOD_US;
+        sched_frac_ns = 0;
+    }
+    alarm_arm();
+}
+
+/**
+ * @brief SYNC_IN_PIN rising edge (Core1 GPIO bank IRQ)
+ */
+static void HOT_PATH_FUNC(timebase_sync_isr)(void) {
+    if (gpio_get_irq_event_mask(SYNC_IN_PIN) & GPIO_IRQ_EDGE_RISE) {
+        gpio_acknowledge_irq(SYNC_IN_PIN, GPIO_IRQ_EDGE_RISE);
+        if (tick_mode == TIMEBASE_STEPPED) {
+            steps_pulse += steps_per_pulse;
+        }
+    }
+}
+
+/**
+ * @brief PPS_IN_PIN rising edge (Core1 GPIO bank IRQ)
+ */
+static void HOT_PATH_FUNC(timebase_pps_isr)(void) {
+    if (gpio_get_irq_event_mask(PPS_IN_PIN) & GPIO_IRQ_EDGE_RISE) {
+        uint64_t edge_us = time_us_64();  // First thing: the timestamp is the measurement
+        gpio_acknowledge_irq(PPS_IN_PIN, GPIO_IRQ_EDGE_RISE);
+        pps_edge(edge_us);
+    }
 }
 
 // ============================================================================
@@ -86,23 +401,36 @@ static void timebase_alarm_isr(void) {
 /**
  * @brief Initialize timebase with hardware alarm
  *
- * Sets up a repeating alarm at 100 Hz for physics simulation.
+ * Sets up a repeating alarm at PHYSICS_TICK_RATE_HZ for physics simulation.
  *
  * @param callback Function to call on each tick (can be NULL)
  */
 void timebase_init(timebase_tick_callback_t callback) {
-    printf("[Timebase] Initializing 100 Hz hardware alarm...\n");
+    printf("[Timebase] Initializing %u Hz hardware alarm...\n", (unsigned)PHYSICS_TICK_RATE_HZ);
 
     tick_callback = callback;
     tick_count = 0;
-    last_tick_us = 0;
+    sched_tick_us = 0;
+    sched_frac_ns = 0;
     max_jitter_us = 0;
+    last_wake_us = 0;
+    latency_hist_reset(&wake_hist);
+    pps_reset(TIMEBASE_PPS_OFF);
+    pps.period_ns = PHYSICS_TICK_PERIOD_US * 1000u;
 
     // Enable timer interrupt
     hw_set_bits(&timer_hw->inte, 1u << PHYSICS_ALARM_NUM);
     irq_set_exclusive_handler(TIMER_IRQ_0 + PHYSICS_ALARM_NUM, timebase_alarm_isr);
     irq_set_enabled(TIMER_IRQ_0 + PHYSICS_ALARM_NUM, true);
 
+    // Lockstep pulses are counted on this core (the one that takes the steps)
+    gpio_add_raw_irq_handler(SYNC_IN_PIN, timebase_sync_isr);
+    gpio_set_irq_enabled(SYNC_IN_PIN, GPIO_IRQ_EDGE_RISE, true);
+    // PPS edges are timestamped on the core that owns the tick schedule
+    gpio_add_raw_irq_handler(PPS_IN_PIN, timebase_pps_isr);
+    gpio_set_irq_enabled(PPS_IN_PIN, GPIO_IRQ_EDGE_RISE, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+
     printf("[Timebase] Alarm configured (period=%u us, rate=%u Hz)\n",
            PHYSICS_TICK_PERIOD_US, PHYSICS_TICK_RATE_HZ);
 }
@@ -116,9 +444,11 @@ void timebase_start(void) {
     printf("[Timebase] Starting timer...\n");
 
     // Schedule first tick
-    last_tick_us = time_us_64();
-    uint64_t first_tick_us = last_tick_us + PHYSICS_TICK_PERIOD_US;
-    timer_hw->alarm[PHYSICS_ALARM_NUM] = (uint32_t)first_tick_us;
+    sched_tick_us = time_us_64() + PHYSICS_TICK_PERIOD_US;
+    sched_frac_ns = 0;
+    oneshot_cb = NULL;
+    timer_hw->alarm[PHYSICS_ALARM_NUM] = (uint32_t)sched_tick_us;
+    alarm_running = true;
 
     printf("[Timebase] Timer started (first tick in %u us)\n", PHYSICS_TICK_PERIOD_US);
 }
@@ -130,6 +460,8 @@ void timebase_stop(void) {
     // Disable alarm interrupt
     hw_clear_bits(&timer_hw->inte, 1u << PHYSICS_ALARM_NUM);
     irq_set_enabled(TIMER_IRQ_0 + PHYSICS_ALARM_NUM, false);
+    alarm_running = false;
+    oneshot_cb = NULL;
 
     printf("[Timebase] Timer stopped (total ticks: %u)\n", tick_count);
 }
@@ -177,6 +509,232 @@ uint32_t timebase_get_max_jitter_us(void) {
  */
 void timebase_reset_jitter_stats(void) {
     max_jitter_us = 0;
+    last_wake_us = 0;
+    latency_hist_reset(&wake_hist);
+}
+
+/**
+ * @brief Get the wake-up latency of the most recent tick
+ *
+ * @return Microseconds from alarm target to ISR entry
+ */
+uint32_t HOT_PATH_FUNC(timebase_get_last_wake_us)(void) {
+    return last_wake_us;
+}
+
+bool timebase_get_next_tick_us(uint32_t* next_us) {
+    if (!alarm_running || tick_mode != TIMEBASE_FREE_RUN) {
+        return false;
+    }
+    *next_us = (uint32_t)sched_tick_us;  // Low word: never torn
+    return true;
+}
+
+/**
+ * @brief Run a callback from the alarm ISR at a given time (Core1)
+ *
+ * One pending at a time; the tick alarm is re-armed for whichever comes
+ * first.
+ *
+ * @param at_us Time in the time_us_32() domain
+ * @param callback Function to call (alarm ISR context)
+ * @return false if not scheduled (stepped mode, stopped, or at_us too close)
+ */
+bool timebase_schedule_oneshot(uint32_t at_us, timebase_tick_callback_t callback) {
+    if (!alarm_running || tick_mode != TIMEBASE_FREE_RUN || callback == NULL) {
+        return false;
+    }
+    uint32_t save = save_and_disable_interrupts();
+    bool armed = (int32_t)(at_us - time_us_32()) >= ONESHOT_MIN_LEAD_US;
+    if (armed) {
+        oneshot_us = at_us;
+        oneshot_cb = callback;
+        alarm_arm();
+    }
+    restore_interrupts(save);
+    return armed;
+}
+
+/**
+ * @brief Drop the pending one-shot, if any (Core1)
+ */
+void timebase_cancel_oneshot(void) {
+    uint32_t save = save_and_disable_interrupts();
+    oneshot_cb = NULL;  // An early alarm left armed just re-arms for the tick
+    restore_interrupts(save);
+}
+
+/**
+ * @brief Get the wake-up latency distribution
+ *
+ * @param summary Output: percentile summary since the last reset
+ */
+void timebase_get_wake_latency(latency_summary_t* summary) {
+    if (summary) latency_hist_summarize(&wake_hist, summary);
+}
+
+/**
+ * @brief Select the tick source
+ *
+ * The alarm interrupt is masked in stepped mode (its ISR may still finish
+ * the tick in flight). Returning to free-run restarts the schedule from now
+ * so the jitter statistics do not see the stepped interval.
+ *
+ * @param mode New tick source
+ */
+void timebase_set_mode(timebase_mode_t mode) {
+    if (mode == tick_mode) {
+        return;
+    }
+
+    uint32_t save = save_and_disable_interrupts();
+    uint64_t sim_now_us = timebase_get_sim_us();
+    if (mode == TIMEBASE_STEPPED) {
+        hw_clear_bits(&timer_hw->inte, 1u << PHYSICS_ALARM_NUM);
+        oneshot_cb = NULL;  // Masked with the alarm: dropped
+        sim_entry_us = sim_now_us;
+        sim_entry_steps = steps_taken;
+        steps_cmd = steps_taken - steps_pulse;  // Nothing pending
+        tick_mode = TIMEBASE_STEPPED;
+    } else {
+        tick_mode = TIMEBASE_FREE_RUN;
+        steps_cmd = steps_taken - steps_pulse;  // Drop what was not run
+        sim_offset_us = (int64_t)sim_now_us - (int64_t)time_us_64();
+        if (alarm_running) {
+            sched_tick_us = time_us_64() + PHYSICS_TICK_PERIOD_US;
+            sched_frac_ns = 0;
+            hw_clear_bits(&timer_hw->intr, 1u << PHYSICS_ALARM_NUM);
+            alarm_arm();
+            hw_set_bits(&timer_hw->inte, 1u << PHYSICS_ALARM_NUM);
+        }
+    }
+    restore_interrupts(save);
+}
+
+/**
+ * @brief Get the tick source
+ *
+ * @return Current mode
+ */
+timebase_mode_t timebase_get_mode(void) {
+    return tick_mode;
+}
+
+/**
+ * @brief Request physics ticks from the external clock (Core0)
+ *
+ * @param ticks Ticks to add
+ * @return false if not in stepped mode
+ */
+bool timebase_step(uint32_t ticks) {
+    if (tick_mode != TIMEBASE_STEPPED) {
+        return false;
+    }
+    uint32_t save = save_and_disable_interrupts();  // NSP IRQ vs. main loop
+    steps_cmd += ticks;
+    restore_interrupts(save);
+    __sev();  // Wake Core1 from WFE
+    return true;
+}
+
+/**
+ * @brief Set the ticks queued per rising edge on SYNC_IN_PIN
+ *
+ * @param ticks Ticks per pulse (0 ignores the pin)
+ */
+void timebase_set_steps_per_pulse(uint32_t ticks) {
+    steps_per_pulse = ticks;
+}
+
+/**
+ * @brief Get the ticks queued per sync pulse
+ *
+ * @return Ticks per pulse
+ */
+uint32_t timebase_get_steps_per_pulse(void) {
+    return steps_per_pulse;
+}
+
+/**
+ * @brief Get the number of requested ticks Core1 has not run yet
+ *
+ * @return Pending ticks
+ */
+uint32_t timebase_get_pending_steps(void) {
+    if (tick_mode != TIMEBASE_STEPPED) {
+        return 0;
+    }
+    return steps_cmd + steps_pulse - steps_taken;
+}
+
+/**
+ * @brief Take one pending step (Core1 tick loop)
+ *
+ * @return true if a step was taken
+ */
+bool HOT_PATH_FUNC(timebase_take_step)(void) {
+    if (tick_mode != TIMEBASE_STEPPED || steps_cmd + steps_pulse == steps_taken) {
+        return false;
+    }
+    steps_taken++;
+    tick_count++;
+    last_wake_us = 0;   // Started as soon as requested
+    return true;
+}
+
+/**
+ * @brief Get simulation time in microseconds
+ *
+ * @return Wall time plus offset (free-run) or entry time plus taken steps
+ */
+uint64_t timebase_get_sim_us(void) {
+    if (tick_mode == TIMEBASE_STEPPED) {
+        return sim_entry_us + (uint64_t)(steps_taken - sim_entry_steps) * PHYSICS_TICK_PERIOD_US;
+    }
+    return (uint64_t)((int64_t)time_us_64() + sim_offset_us);
+}
+
+/**
+ * @brief Enable or disable PPS discipline
+ *
+ * Applied by the Core1 alarm ISR on the next tick: enabling starts
+ * acquisition, disabling returns to the nominal period.
+ *
+ * @param enabled true to discipline the tick to PPS_IN_PIN
+ */
+void timebase_set_pps_enabled(bool enabled) {
+    pps_enabled = enabled;
+}
+
+/**
+ * @brief Get PPS discipline state and statistics
+ *
+ * @param stats Output: copy of the loop state (fields may be one edge apart)
+ */
+void timebase_get_pps_stats(timebase_pps_stats_t* stats) {
+    if (stats) *stats = pps;
+}
+
+/**
+ * @brief Start the free-running cycle counter on the calling core
+ *
+ * The Cortex-M0+ has no DWT cycle counter, so SysTick is run from the
+ * processor clock at its full 24-bit reload with the interrupt disabled.
+ */
+void timebase_cycle_counter_start(void) {
+    systick_hw->csr = 0;
+    systick_hw->rvr = TIMEBASE_CYCLE_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+}
+
+/**
+ * @brief Read the cycle counter
+ *
+ * @return Current 24-bit cycle count (SysTick counts down, so invert it)
+ */
+uint32_t timebase_get_cycles(void) {
+    return TIMEBASE_CYCLE_MASK - (systick_hw->cvr & TIMEBASE_CYCLE_MASK);
 }
 
 /**
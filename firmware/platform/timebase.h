@@ -7,11 +7,14 @@
 #define TIMEBASE_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "util/latency_hist.h"
 
 /**
  * @brief Callback function type for physics tick
  *
- * This function is called from the hardware alarm ISR at 100 Hz.
+ * This function is called from the hardware alarm ISR at
+ * PHYSICS_TICK_RATE_HZ (board_pico.h, 100 Hz by default).
  * Keep it short and avoid blocking operations.
  */
 typedef void (*timebase_tick_callback_t)(void);
@@ -19,7 +22,7 @@ typedef void (*timebase_tick_callback_t)(void);
 /**
  * @brief Initialize timebase with hardware alarm
  *
- * Sets up a repeating alarm at 100 Hz for physics simulation.
+ * Sets up a repeating alarm at PHYSICS_TICK_RATE_HZ for physics simulation.
  * Call this during startup before starting the timer.
  *
  * @param callback Function to call on each tick (can be NULL)
@@ -29,7 +32,7 @@ void timebase_init(timebase_tick_callback_t callback);
 /**
  * @brief Start the physics tick timer
  *
- * Begins generating ticks at 100 Hz. The callback registered in
+ * Begins generating ticks at PHYSICS_TICK_RATE_HZ. The callback registered in
  * timebase_init() will be called on each tick.
  */
 void timebase_start(void);
@@ -67,7 +70,7 @@ uint32_t timebase_get_ms(void);
 /**
  * @brief Get maximum observed jitter in microseconds
  *
- * Tracks the worst-case deviation from the expected 10ms tick period.
+ * Tracks the worst-case lateness of a tick against its schedule.
  *
  * @return Maximum jitter since timebase_start() was called
  */
@@ -76,11 +79,218 @@ uint32_t timebase_get_max_jitter_us(void);
 /**
  * @brief Reset jitter statistics
  *
- * Clears the maximum jitter counter. Useful for re-measuring after
- * a known disturbance (e.g., USB enumeration).
+ * Clears the maximum jitter counter and the wake-up latency histogram.
+ * Useful for re-measuring after a known disturbance (e.g., USB enumeration).
  */
 void timebase_reset_jitter_stats(void);
 
+/**
+ * @brief Get the wake-up latency of the most recent tick
+ *
+ * Time from the alarm target to entry of the alarm ISR. Read it on Core1
+ * right after the tick flag to pair it with that tick.
+ *
+ * @return Wake-up latency in microseconds
+ */
+uint32_t timebase_get_last_wake_us(void);
+
+/**
+ * @brief Get the alarm target of the next tick
+ *
+ * Lets Core0 fit work that stalls Core1 (flash writes) into the slack
+ * before that tick.
+ *
+ * @param next_us Output: target in the time_us_32() domain
+ * @return false if no tick is scheduled (stepped mode or stopped)
+ */
+bool timebase_get_next_tick_us(uint32_t* next_us);
+
+/**
+ * @brief Run a callback from the alarm ISR at a given time (Core1)
+ *
+ * Sub-tick timing without a hardware alarm of its own: the one-shot shares
+ * the tick alarm, which is armed for whichever of the two is first. One
+ * pending at a time; a new one replaces it. Free-running mode only (the
+ * alarm is masked while stepped, which drops a pending one-shot).
+ *
+ * @param at_us Time in the time_us_32() domain
+ * @param callback Function to call (alarm ISR context, keep it short)
+ * @return false if not scheduled: stepped mode, stopped, or at_us less
+ *         than a few microseconds away (the caller acts at once instead)
+ */
+bool timebase_schedule_oneshot(uint32_t at_us, timebase_tick_callback_t callback);
+
+/**
+ * @brief Drop the pending one-shot, if any (Core1)
+ */
+void timebase_cancel_oneshot(void);
+
+/**
+ * @brief Get the wake-up latency distribution
+ *
+ * One sample per tick, recorded in the alarm ISR.
+ *
+ * @param summary Output: percentile summary since the last reset
+ */
+void timebase_get_wake_latency(latency_summary_t* summary);
+
+// ============================================================================
+// Tick Source (free-running alarm or external steps)
+// ============================================================================
+
+/**
+ * @brief Where physics ticks come from
+ */
+typedef enum {
+    TIMEBASE_FREE_RUN = 0,  // Hardware alarm at PHYSICS_TICK_RATE_HZ (default)
+    TIMEBASE_STEPPED,       // One tick per step from timebase_step() or SYNC_IN_PIN
+} timebase_mode_t;
+
+/**
+ * @brief Select the tick source
+ *
+ * Stepped mode stops the alarm; ticks then run only when an external clock
+ * asks for them, back to back as fast as Core1 completes them, and the
+ * simulation clock (timebase_get_sim_us()) advances exactly one period per
+ * tick. Steps still pending when switching back to free-run are dropped and
+ * the alarm restarts from now. Call from Core0 (safe from the NSP service
+ * IRQ; prints nothing).
+ *
+ * @param mode New tick source
+ */
+void timebase_set_mode(timebase_mode_t mode);
+
+/**
+ * @brief Get the tick source
+ *
+ * @return Current mode
+ */
+timebase_mode_t timebase_get_mode(void);
+
+/**
+ * @brief Request physics ticks from the external clock (Core0)
+ *
+ * Safe from the NSP service IRQ. Ticks are queued; Core1 runs them in order.
+ *
+ * @param ticks Ticks to add (batch size)
+ * @return false if not in stepped mode (nothing queued)
+ */
+bool timebase_step(uint32_t ticks);
+
+/**
+ * @brief Set the ticks queued per rising edge on SYNC_IN_PIN
+ *
+ * @param ticks Ticks per pulse (0 ignores the pin)
+ */
+void timebase_set_steps_per_pulse(uint32_t ticks);
+
+/**
+ * @brief Get the ticks queued per sync pulse
+ *
+ * @return Ticks per pulse
+ */
+uint32_t timebase_get_steps_per_pulse(void);
+
+/**
+ * @brief Get the number of requested ticks Core1 has not run yet
+ *
+ * @return Pending ticks (0 in free-run)
+ */
+uint32_t timebase_get_pending_steps(void);
+
+/**
+ * @brief Take one pending step (Core1 tick loop)
+ *
+ * Accounts the tick exactly like an alarm tick (tick count, zero wake-up
+ * latency) and advances the simulation clock. The caller then runs the
+ * physics tick.
+ *
+ * @return true if a step was taken
+ */
+bool timebase_take_step(void);
+
+/**
+ * @brief Get simulation time in microseconds
+ *
+ * Wall time while free-running. In stepped mode it is the time of entry
+ * plus one tick period per step taken, so everything timed against it
+ * (scenario timeline, action durations) is deterministic relative to the
+ * external clock. Continuous across mode changes.
+ *
+ * @return Simulation microseconds
+ */
+uint64_t timebase_get_sim_us(void);
+
+// ============================================================================
+// PPS Discipline (free-run only)
+// ============================================================================
+
+/**
+ * @brief PPS loop state
+ */
+typedef enum {
+    TIMEBASE_PPS_OFF = 0,       // Nominal period, pin ignored
+    TIMEBASE_PPS_ACQUIRING,     // Waiting for two edges one second apart
+    TIMEBASE_PPS_TRACKING,      // PLL running, offset above the lock window
+    TIMEBASE_PPS_LOCKED,        // Offset within a few µs for several seconds
+    TIMEBASE_PPS_HOLDOVER,      // PPS lost: last frequency kept, no phase correction
+} timebase_pps_state_t;
+
+/**
+ * @brief PPS discipline statistics (written by Core1 on each edge)
+ */
+typedef struct {
+    timebase_pps_state_t state;
+    uint32_t pulses;            // Edges seen on PPS_IN_PIN
+    uint32_t rejected;          // Edges whose interval was outside the capture range
+    uint32_t lock_losses;       // LOCKED -> TRACKING/HOLDOVER transitions
+    int32_t offset_us;          // Last edge minus nearest tick (+ = ticks early)
+    uint32_t max_offset_us;     // Largest |offset| since lock (since acquisition before)
+    int32_t drift_ppb;          // Frequency correction: local clock vs. PPS
+    uint32_t period_ns;         // Tick period currently scheduled
+    uint32_t last_interval_us;  // Local time between the last two edges
+} timebase_pps_stats_t;
+
+/**
+ * @brief Enable or disable PPS discipline of the tick schedule
+ *
+ * Rising edges on PPS_IN_PIN steer the alarm period with a PLL so ticks
+ * line up with the top of each second, and with every other board on the
+ * same PPS. Takes effect on the next tick. No effect in stepped mode.
+ *
+ * @param enabled true to discipline the tick
+ */
+void timebase_set_pps_enabled(bool enabled);
+
+/**
+ * @brief Get PPS discipline state and statistics
+ *
+ * @param stats Output: loop state
+ */
+void timebase_get_pps_stats(timebase_pps_stats_t* stats);
+
+/** Width mask of the free-running cycle counter (SysTick is 24 bits) */
+#define TIMEBASE_CYCLE_MASK 0x00FFFFFFu
+
+/**
+ * @brief Start the free-running cycle counter on the calling core
+ *
+ * Configures SysTick to count processor clocks with no reload interrupt.
+ * SysTick is per-core, so call this on each core that measures cycles.
+ */
+void timebase_cycle_counter_start(void);
+
+/**
+ * @brief Read the cycle counter
+ *
+ * Counts up and wraps every 2^24 cycles (~134 ms at 125 MHz), so only
+ * differences of short intervals are meaningful; mask them with
+ * TIMEBASE_CYCLE_MASK.
+ *
+ * @return Current 24-bit cycle count (0 if the counter was never started)
+ */
+uint32_t timebase_get_cycles(void);
+
 /**
  * @brief Busy-wait delay in microseconds
  *
@@ -0,0 +1,66 @@
+/**
+ * @file tusb_config.h
+ * @brief TinyUSB Device Configuration
+ *
+ * The emulator enumerates as a composite device with two CDC-ACM
+ * interfaces and the picotool reset interface:
+ *   - CDC 0: stdio console (TUI, logs), driven by pico_stdio_usb
+ *   - CDC 1: binary telemetry stream (drivers/usb_stream.h)
+ *   - Reset: vendor interface (no endpoints), an application class driver
+ *
+ * Descriptors are in platform/usb_descriptors.c. TinyUSB is still
+ * initialized and serviced by pico_stdio_usb in its low-priority IRQ.
+ */
+
+#ifndef TUSB_CONFIG_H
+#define TUSB_CONFIG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Common
+// ============================================================================
+
+#ifndef CFG_TUSB_MCU
+#define CFG_TUSB_MCU            OPT_MCU_RP2040
+#endif
+
+#ifndef CFG_TUSB_OS
+#define CFG_TUSB_OS             OPT_OS_PICO
+#endif
+
+#define CFG_TUSB_RHPORT0_MODE   (OPT_MODE_DEVICE)
+
+#ifndef CFG_TUSB_MEM_ALIGN
+#define CFG_TUSB_MEM_ALIGN      __attribute__((aligned(4)))
+#endif
+
+// ============================================================================
+// Device
+// ============================================================================
+
+#define CFG_TUD_ENABLED         1
+#define CFG_TUD_ENDPOINT0_SIZE  64
+
+#define CFG_TUD_CDC             2
+#define CFG_TUD_MSC             0
+#define CFG_TUD_HID             0
+#define CFG_TUD_MIDI            0
+#define CFG_TUD_VENDOR          0
+
+// FIFO sizes apply to both CDC interfaces. The TX FIFO holds ~10 typical
+// telemetry frames (92 B), over 2 ms of stream at 1 kHz with 4 wheels.
+#define CFG_TUD_CDC_RX_BUFSIZE  256
+#define CFG_TUD_CDC_TX_BUFSIZE  1024
+
+// Endpoint transfer buffer: up to 8 packets per bulk transfer, so a burst
+// of frames goes out without a tud_task() round trip per 64-byte packet
+#define CFG_TUD_CDC_EP_BUFSIZE  512
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TUSB_CONFIG_H
@@ -0,0 +1,234 @@
+/**
+ * @file usb_descriptors.c
+ * @brief USB Descriptors (Composite: Console CDC + Telemetry CDC + Reset)
+ *
+ * Replaces the pico_stdio_usb default descriptors, which only expose the
+ * console. Interface 0/1 is the console (stdio), interface 2/3 the binary
+ * telemetry stream, so the host sees two serial ports:
+ *   Linux: /dev/ttyACM0 (console), /dev/ttyACM1 (telemetry)
+ *
+ * pico_stdio_usb drops its reset interface when the application brings its
+ * own descriptors, so interface 4 re-implements it here: `picotool reboot`
+ * (and `picotool load -f`) keep reaching a running board.
+ */
+
+#include "tusb.h"
+#include "device/usbd_pvt.h"
+#include "pico/unique_id.h"
+#include "pico/bootrom.h"
+#include "pico/usb_reset_interface.h"
+#include "hardware/watchdog.h"
+#include <string.h>
+
+// ============================================================================
+// Device Descriptor
+// ============================================================================
+
+#define USB_VID             0x2E8A      // Raspberry Pi
+#define USB_PID             0x000A      // Pico SDK CDC
+#define USB_BCD_DEVICE      0x0200      // Bumped so hosts drop the cached 1-port layout
+
+static const tusb_desc_device_t desc_device = {
+    .bLength            = sizeof(tusb_desc_device_t),
+    .bDescriptorType    = TUSB_DESC_DEVICE,
+    .bcdUSB             = 0x0200,
+
+    // Interface Association Descriptors: required for composite CDC
+    .bDeviceClass       = TUSB_CLASS_MISC,
+    .bDeviceSubClass    = MISC_SUBCLASS_COMMON,
+    .bDeviceProtocol    = MISC_PROTOCOL_IAD,
+    .bMaxPacketSize0    = CFG_TUD_ENDPOINT0_SIZE,
+
+    .idVendor           = USB_VID,
+    .idProduct          = USB_PID,
+    .bcdDevice          = USB_BCD_DEVICE,
+
+    .iManufacturer      = 0x01,
+    .iProduct           = 0x02,
+    .iSerialNumber      = 0x03,
+
+    .bNumConfigurations = 0x01,
+};
+
+const uint8_t* tud_descriptor_device_cb(void) {
+    return (const uint8_t*)&desc_device;
+}
+
+// ============================================================================
+// Configuration Descriptor
+// ============================================================================
+
+enum {
+    ITF_NUM_CONSOLE = 0,
+    ITF_NUM_CONSOLE_DATA,
+    ITF_NUM_STREAM,
+    ITF_NUM_STREAM_DATA,
+    ITF_NUM_RESET,
+    ITF_NUM_TOTAL
+};
+
+#define EPNUM_CONSOLE_NOTIF 0x81
+#define EPNUM_CONSOLE_OUT   0x02
+#define EPNUM_CONSOLE_IN    0x82
+#define EPNUM_STREAM_NOTIF  0x83
+#define EPNUM_STREAM_OUT    0x04
+#define EPNUM_STREAM_IN     0x84
+
+// Vendor interface without endpoints, matched by picotool on subclass/protocol
+#define TUD_RESET_DESC_LEN  9
+#define TUD_RESET_DESCRIPTOR(_itf, _stridx) \
+    9, TUSB_DESC_INTERFACE, _itf, 0, 0, TUSB_CLASS_VENDOR_SPECIFIC, \
+    RESET_INTERFACE_SUBCLASS, RESET_INTERFACE_PROTOCOL, _stridx
+
+#define CONFIG_TOTAL_LEN    (TUD_CONFIG_DESC_LEN + CFG_TUD_CDC * TUD_CDC_DESC_LEN + \
+                             TUD_RESET_DESC_LEN)
+
+static const uint8_t desc_configuration[] = {
+    // Config number, interface count, string index, total length, attribute, power (mA)
+    TUD_CONFIG_DESCRIPTOR(1, ITF_NUM_TOTAL, 0, CONFIG_TOTAL_LEN, 0x00, 250),
+
+    // Interface number, string index, notification EP & size, data EP OUT & IN, size
+    TUD_CDC_DESCRIPTOR(ITF_NUM_CONSOLE, 4, EPNUM_CONSOLE_NOTIF, 8,
+                       EPNUM_CONSOLE_OUT, EPNUM_CONSOLE_IN, 64),
+    TUD_CDC_DESCRIPTOR(ITF_NUM_STREAM, 5, EPNUM_STREAM_NOTIF, 8,
+                       EPNUM_STREAM_OUT, EPNUM_STREAM_IN, 64),
+    TUD_RESET_DESCRIPTOR(ITF_NUM_RESET, 6),
+};
+
+const uint8_t* tud_descriptor_configuration_cb(uint8_t index) {
+    (void)index;
+    return desc_configuration;
+}
+
+// ============================================================================
+// String Descriptors
+// ============================================================================
+
+static const char* const desc_strings[] = {
+    NULL,                       // 0: language (handled below)
+    "Raspberry Pi",             // 1: manufacturer
+    "NRWA-T6 Emulator",         // 2: product
+    NULL,                       // 3: serial (board unique ID)
+    "NRWA-T6 Console",          // 4: CDC 0
+    "NRWA-T6 Telemetry",        // 5: CDC 1
+    "Reset",                    // 6: reset interface
+};
+
+#define DESC_STRING_MAX_CHARS   31
+
+static uint16_t desc_str_buf[DESC_STRING_MAX_CHARS + 1];
+
+const uint16_t* tud_descriptor_string_cb(uint8_t index, uint16_t langid) {
+    (void)langid;
+    char serial[2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES + 1];
+    const char* str;
+    uint8_t len;
+
+    if (index == 0) {
+        desc_str_buf[1] = 0x0409;   // English (US)
+        len = 1;
+    } else {
+        if (index >= sizeof(desc_strings) / sizeof(desc_strings[0])) {
+            return NULL;
+        }
+
+        if (index == 3) {
+            pico_get_unique_board_id_string(serial, sizeof(serial));
+            str = serial;
+        } else {
+            str = desc_strings[index];
+        }
+
+        len = (uint8_t)strlen(str);
+        if (len > DESC_STRING_MAX_CHARS) {
+            len = DESC_STRING_MAX_CHARS;
+        }
+
+        // ASCII to UTF-16LE
+        for (uint8_t i = 0; i < len; i++) {
+            desc_str_buf[1 + i] = (uint8_t)str[i];
+        }
+    }
+
+    // First element: length (bytes, including header) and descriptor type
+    desc_str_buf[0] = (uint16_t)((TUSB_DESC_STRING << 8) | (2u * len + 2u));
+    return desc_str_buf;
+}
+
+// ============================================================================
+// Reset Interface
+// ============================================================================
+
+// Same requests and reboot delay as the pico_stdio_usb implementation
+#define RESET_TO_FLASH_DELAY_MS     100
+
+static uint8_t reset_itf_num;
+
+static void resetd_init(void) {
+}
+
+static void resetd_reset(uint8_t rhport) {
+    (void)rhport;
+    reset_itf_num = 0;
+}
+
+static uint16_t resetd_open(uint8_t rhport, const tusb_desc_interface_t* itf_desc, uint16_t max_len) {
+    (void)rhport;
+    TU_VERIFY(itf_desc->bInterfaceClass == TUSB_CLASS_VENDOR_SPECIFIC &&
+              itf_desc->bInterfaceSubClass == RESET_INTERFACE_SUBCLASS &&
+              itf_desc->bInterfaceProtocol == RESET_INTERFACE_PROTOCOL, 0);
+    TU_VERIFY(max_len >= sizeof(tusb_desc_interface_t), 0);
+
+    reset_itf_num = itf_desc->bInterfaceNumber;
+    return sizeof(tusb_desc_interface_t);
+}
+
+static bool resetd_control_xfer_cb(uint8_t rhport, uint8_t stage,
+                                   const tusb_control_request_t* request) {
+    (void)rhport;
+    if (stage != CONTROL_STAGE_SETUP) {
+        return true;
+    }
+    if (request->wIndex != reset_itf_num) {
+        return false;
+    }
+
+    if (request->bRequest == RESET_REQUEST_BOOTSEL) {
+        // wValue: bit 8 enables an activity LED on GPIO bits 9-15,
+        // bits 0-6 disable BOOTSEL interfaces (mass storage, PICOBOOT)
+        uint32_t led_mask = (request->wValue & 0x100u) ? (1u << (request->wValue >> 9)) : 0u;
+        reset_usb_boot(led_mask, request->wValue & 0x7Fu);
+    }
+    if (request->bRequest == RESET_REQUEST_FLASH) {
+        // Not watchdog_enable(): the next boot sees a cold start, not a warm restart
+        watchdog_reboot(0, 0, RESET_TO_FLASH_DELAY_MS);
+        return true;
+    }
+    return false;
+}
+
+static bool resetd_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result,
+                           uint32_t xferred_bytes) {
+    (void)rhport;
+    (void)ep_addr;
+    (void)result;
+    (void)xferred_bytes;
+    return true;
+}
+
+static const usbd_class_driver_t resetd_driver = {
+#if CFG_TUSB_DEBUG >= 2
+    .name            = "RESET",
+#endif
+    .init            = resetd_init,
+    .reset           = resetd_reset,
+    .open            = resetd_open,
+    .control_xfer_cb = resetd_control_xfer_cb,
+    .xfer_cb         = resetd_xfer_cb,
+    .sof             = NULL,
+};
+
+const usbd_class_driver_t* usbd_app_driver_get_cb(uint8_t* driver_count) {
+    *driver_count = 1;
+    return &resetd_driver;
+}
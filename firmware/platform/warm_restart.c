@@ -0,0 +1,360 @@
+/**
+ * @file warm_restart.c
+ * @brief Watchdog Supervision and Warm Restart Implementation
+ */
+
+#include "warm_restart.h"
+#include "hot_path.h"
+#include "crc_ccitt.h"
+#include "scenario.h"
+#include "util/task_sched.h"
+#include "pico/stdlib.h"
+#include "hardware/watchdog.h"
+#include "hardware/sync.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+// Records (.uninitialized_data, kept across a watchdog reset)
+// ============================================================================
+
+#define WARM_MAGIC              0x4D524157u     // "WARM"
+#define WARM_BUILD_ID           FIRMWARE_VERSION " " __DATE__ " " __TIME__
+#define WARM_SAVE_PERIOD_TICKS  ((PHYSICS_TICK_RATE_HZ / WARM_SAVE_HZ) ? \
+                                 (PHYSICS_TICK_RATE_HZ / WARM_SAVE_HZ) : 1u)
+#define TASK_BUDGET_WARM_US     (20u + 20u * EMULATED_WHEEL_COUNT)
+
+/**
+ * @brief Restart bookkeeping (Core0, written at boot and when a streak ends)
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t build_hash;        // FNV-1a of WARM_BUILD_ID
+    uint32_t restarts;          // Warm restarts since the last cold boot
+    uint32_t streak;            // Warm restarts without WARM_STABLE_MS between them
+    uint32_t crc;               // CRC-CCITT of the fields above
+} warm_control_t;
+
+/**
+ * @brief One copy of every wheel (Core1)
+ */
+typedef struct {
+    uint32_t seq;               // Copy number (0 = being written or never)
+    uint32_t crc;               // CRC-CCITT of seq and wheels
+    wheel_state_t wheels[EMULATED_WHEEL_COUNT];
+} warm_wheel_slot_t;
+
+/**
+ * @brief One copy of the running scenario layers (Core0)
+ */
+typedef struct {
+    uint32_t seq;
+    uint32_t crc;               // CRC-CCITT of seq, layers and resume
+    uint32_t layers;            // Bit per layer saved in resume[]
+    scenario_resume_t resume[SCENARIO_LAYERS];
+} warm_scenario_slot_t;
+
+typedef struct {
+    warm_control_t control;
+    warm_wheel_slot_t wheel_slot[2];
+    warm_scenario_slot_t scenario_slot[2];
+} warm_image_t;
+
+static warm_image_t __uninitialized_ram(g_warm_image);
+
+// ============================================================================
+// Local State
+// ============================================================================
+
+static bool g_warm = false;
+static wheel_state_t* CORE1_DATA("warm") g_wheels = NULL;
+static uint32_t CORE1_DATA("warm") g_wheel_seq = 0;
+static uint32_t g_scenario_seq = 0;
+static volatile uint32_t g_core1_beat = 0;
+static volatile uint32_t g_core0_beat = 0;
+
+// Feed timer (Core0 IRQ)
+static repeating_timer_t g_feed_timer;
+static uint32_t g_beat_seen = 0;
+static uint32_t g_stall_ms = 0;
+static uint32_t g_core0_beat_seen = 0;
+static uint32_t g_core0_stall_ms = 0;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * @brief FNV-1a hash of the build identity
+ */
+static uint32_t build_hash(void) {
+    uint32_t h = 2166136261u;
+    for (const char* p = WARM_BUILD_ID; *p; p++) {
+        h = (h ^ (uint8_t)*p) * 16777619u;
+    }
+    return h;
+}
+
+static uint32_t control_crc(const warm_control_t* c) {
+    return crc_ccitt_calculate((const uint8_t*)c, offsetof(warm_control_t, crc));
+}
+
+static void control_write(warm_control_t* c) {
+    c->crc = control_crc(c);
+}
+
+/**
+ * @brief CRC of a slot: its sequence number, then the payload after crc
+ *        (table backend only, Core1 must not share the DMA sniffer)
+ */
+static uint32_t HOT_PATH_FUNC(slot_crc)(uint32_t seq, const void* payload, size_t len) {
+    uint16_t crc = crc_ccitt_init();
+    crc = crc_ccitt_update_table(crc, (const uint8_t*)&seq, sizeof(seq));
+    return crc_ccitt_update_table(crc, (const uint8_t*)payload, len);
+}
+
+/**
+ * @brief Newer of a slot pair with a good CRC
+ *
+ * @return Slot index, or -1 if neither is valid
+ */
+static int newest_slot(uint32_t seq0, bool ok0, uint32_t seq1, bool ok1) {
+    ok0 = ok0 && seq0 != 0;
+    ok1 = ok1 && seq1 != 0;
+    if (ok0 && ok1) {
+        return ((int32_t)(seq1 - seq0) > 0) ? 1 : 0;
+    }
+    return ok0 ? 0 : ok1 ? 1 : -1;
+}
+
+static int wheel_slot_valid(void) {
+    const warm_wheel_slot_t* s = g_warm_image.wheel_slot;
+    return newest_slot(s[0].seq, s[0].crc == slot_crc(s[0].seq, s[0].wheels, sizeof(s[0].wheels)),
+                       s[1].seq, s[1].crc == slot_crc(s[1].seq, s[1].wheels, sizeof(s[1].wheels)));
+}
+
+static int scenario_slot_valid(void) {
+    const warm_scenario_slot_t* s = g_warm_image.scenario_slot;
+    const size_t len = sizeof(s[0]) - offsetof(warm_scenario_slot_t, layers);
+    return newest_slot(s[0].seq, s[0].crc == slot_crc(s[0].seq, &s[0].layers, len),
+                       s[1].seq, s[1].crc == slot_crc(s[1].seq, &s[1].layers, len));
+}
+
+// ============================================================================
+// Boot Decision
+// ============================================================================
+
+bool warm_restart_init(void) {
+    warm_control_t* c = &g_warm_image.control;
+    bool valid = c->magic == WARM_MAGIC && c->crc == control_crc(c) &&
+                 c->build_hash == build_hash();
+
+    g_warm = WATCHDOG_ENABLED && watchdog_enable_caused_reboot() && valid &&
+             c->streak < WARM_MAX_STREAK;
+    if (g_warm) {
+        c->restarts++;
+        c->streak++;
+        control_write(c);
+
+        // Keep writing after the newest copies
+        int w = wheel_slot_valid();
+        int s = scenario_slot_valid();
+        g_wheel_seq = (w >= 0) ? g_warm_image.wheel_slot[w].seq : 0;
+        g_scenario_seq = (s >= 0) ? g_warm_image.scenario_slot[s].seq : 0;
+        return true;
+    }
+
+    // Cold boot: forget the previous boot's state
+    memset(&g_warm_image, 0, sizeof(g_warm_image));
+    c->magic = WARM_MAGIC;
+    c->build_hash = build_hash();
+    control_write(c);
+    return false;
+}
+
+bool warm_restart_is_warm(void) {
+    return g_warm;
+}
+
+uint32_t warm_restart_get_count(void) {
+    return g_warm_image.control.restarts;
+}
+
+// ============================================================================
+// Core1: Wheel State
+// ============================================================================
+
+/**
+ * @brief Copy the wheels into the older slot (Core1 task, between ticks)
+ */
+static void HOT_PATH_FUNC(task_warm_save)(void) {
+    uint32_t seq = g_wheel_seq + 1u;
+    if (seq == 0) {
+        seq = 1;
+    }
+    warm_wheel_slot_t* slot = &g_warm_image.wheel_slot[seq & 1u];
+
+    slot->seq = 0;  // Invalid until complete
+    __dmb();
+    memcpy(slot->wheels, g_wheels, sizeof(slot->wheels));
+    slot->crc = slot_crc(seq, slot->wheels, sizeof(slot->wheels));
+    __dmb();
+    slot->seq = seq;
+    g_wheel_seq = seq;
+}
+
+bool warm_restart_core1_init(wheel_state_t* wheels) {
+    g_wheels = wheels;
+
+    bool restored = false;
+    int s = g_warm ? wheel_slot_valid() : -1;
+    if (s >= 0) {
+        const warm_wheel_slot_t* slot = &g_warm_image.wheel_slot[s];
+        for (uint8_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+            wheel_model_restore(&wheels[w], &slot->wheels[w]);
+        }
+        restored = true;
+        printf("[WARM] %u wheel(s) restored (copy %lu, wheel 0 at %.0f RPM)\n",
+               (unsigned)EMULATED_WHEEL_COUNT, (unsigned long)slot->seq,
+               (double)(wheels[0].omega_rad_s * RAD_S_TO_RPM));
+    } else if (g_warm) {
+        printf("[WARM] No valid wheel state saved, wheels start from power-on\n");
+    }
+
+    // A copy the governor drops is the previous one, one save period older
+    task_sched_add_optional("warm", task_warm_save, WARM_SAVE_PERIOD_TICKS, TASK_BUDGET_WARM_US,
+                            TASK_SCHED_PRIO_DEFER);
+    return restored;
+}
+
+void HOT_PATH_FUNC(warm_restart_core1_beat)(void) {
+    g_core1_beat++;
+}
+
+// ============================================================================
+// Core0: Scenarios
+// ============================================================================
+
+uint8_t warm_restart_resume_scenarios(void) {
+    int s = g_warm ? scenario_slot_valid() : -1;
+    if (s < 0) {
+        return 0;
+    }
+
+    const warm_scenario_slot_t* slot = &g_warm_image.scenario_slot[s];
+    uint8_t resumed = 0;
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        if ((slot->layers & (1u << l)) == 0) {
+            continue;
+        }
+        if (scenario_layer_resume(l, &slot->resume[l])) {
+            resumed++;
+        } else {
+            printf("[WARM] Scenario layer %u could not be resumed\n", (unsigned)l);
+        }
+    }
+    return resumed;
+}
+
+/**
+ * @brief Copy the running layers into the older slot
+ */
+static void save_scenarios(void) {
+    uint32_t seq = g_scenario_seq + 1u;
+    if (seq == 0) {
+        seq = 1;
+    }
+    warm_scenario_slot_t* slot = &g_warm_image.scenario_slot[seq & 1u];
+
+    slot->seq = 0;
+    __dmb();
+    slot->layers = 0;
+    for (uint8_t l = 0; l < SCENARIO_LAYERS; l++) {
+        if (scenario_layer_save_resume(l, &slot->resume[l])) {
+            slot->layers |= 1u << l;
+        } else {
+            memset(&slot->resume[l], 0, sizeof(slot->resume[l]));
+        }
+    }
+    slot->crc = slot_crc(seq, &slot->layers, sizeof(*slot) - offsetof(warm_scenario_slot_t, layers));
+    __dmb();
+    slot->seq = seq;
+    g_scenario_seq = seq;
+}
+
+void warm_restart_poll(void) {
+    // Nothing running and nothing saved: nothing to rewrite
+    const warm_scenario_slot_t* last = &g_warm_image.scenario_slot[g_scenario_seq & 1u];
+    if (scenario_get_active_layers() != 0 || (g_scenario_seq != 0 && last->layers != 0)) {
+        save_scenarios();
+    }
+
+    warm_control_t* c = &g_warm_image.control;
+    if (c->streak != 0 && time_us_64() >= (uint64_t)WARM_STABLE_MS * 1000u) {
+        c->streak = 0;
+        control_write(c);
+    }
+}
+
+// ============================================================================
+// Core0: Watchdog
+// ============================================================================
+
+void warm_restart_core0_beat(void) {
+    g_core0_beat++;
+}
+
+/**
+ * @brief Feed the watchdog while both cores beat (Core0 timer IRQ)
+ */
+static bool watchdog_feed_cb(repeating_timer_t* timer) {
+    (void)timer;
+
+    // Wakes Core1 out of WFE in stepped mode, so it beats with no ticks
+    __sev();
+
+    uint32_t beat = g_core1_beat;
+    if (beat != g_beat_seen) {
+        g_beat_seen = beat;
+        g_stall_ms = 0;
+    } else if (g_stall_ms < WARM_CORE1_STALL_MS) {
+        g_stall_ms += WARM_FEED_PERIOD_MS;
+    }
+
+    beat = g_core0_beat;
+    if (beat != g_core0_beat_seen) {
+        g_core0_beat_seen = beat;
+        g_core0_stall_ms = 0;
+    } else if (g_core0_stall_ms < WARM_CORE0_STALL_MS) {
+        g_core0_stall_ms += WARM_FEED_PERIOD_MS;
+    }
+
+    // A stalled Core1 or a hung Core0 main loop starves the watchdog
+    if (g_stall_ms < WARM_CORE1_STALL_MS && g_core0_stall_ms < WARM_CORE0_STALL_MS) {
+        watchdog_update();
+    }
+    return true;
+}
+
+bool warm_restart_start_watchdog(void) {
+    if (!WATCHDOG_ENABLED) {
+        printf("[WARM] Watchdog DISABLED (NRWA_WATCHDOG=OFF)\n");
+        return false;
+    }
+
+    g_beat_seen = g_core1_beat;
+    g_stall_ms = 0;
+    g_core0_beat_seen = g_core0_beat;
+    g_core0_stall_ms = 0;
+    if (!add_repeating_timer_ms(-WARM_FEED_PERIOD_MS, watchdog_feed_cb, NULL, &g_feed_timer)) {
+        printf("[WARM] ERROR: No timer for the watchdog feed, watchdog not armed\n");
+        return false;
+    }
+    watchdog_enable(WARM_WATCHDOG_TIMEOUT_MS, true);  // Paused while debugging
+
+    printf("[WARM] Watchdog armed (%u ms, heartbeats within %u ms Core0, %u ms Core1)\n",
+           (unsigned)WARM_WATCHDOG_TIMEOUT_MS, (unsigned)WARM_CORE0_STALL_MS,
+           (unsigned)WARM_CORE1_STALL_MS);
+    return true;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file warm_restart.h
+ * @brief Watchdog Supervision and Warm Restart
+ *
+ * The hardware watchdog is fed from a Core0 timer, and only while both
+ * cores show signs of life:
+ * - Core0: the feed timer itself (a hard fault or a spin with interrupts
+ *   disabled stops it), and a heartbeat counted once per main loop pass,
+ *   which must move within WARM_CORE0_STALL_MS. A console prompt waiting
+ *   for a key beats too, so it is not a failure; the long limit covers a
+ *   pass that writes the scenario library or the config store to flash.
+ * - Core1: a heartbeat counted in its wait loop, which must move within
+ *   WARM_CORE1_STALL_MS. The feed timer also sends an event, so Core1
+ *   beats while it waits for external steps; a flash write parks it for
+ *   well under the limit.
+ *
+ * A watchdog reset keeps SRAM. Core1 copies the wheel states (speed,
+ * commands, mode, protection thresholds and latches, LCL, thermal) into a
+ * CRC-protected record in .uninitialized_data every WARM_SAVE_HZ, and
+ * Core0 copies the running scenario layers' timeline positions once per
+ * main loop pass. Each record is a pair of slots written in turn, so a
+ * reset in the middle of a write leaves the previous copy intact.
+ *
+ * At boot, warm_restart_init() decides: a reset the watchdog caused, with
+ * records from this very build, is a warm restart. The wheels continue
+ * where they stopped, the scenarios resume, and the boot skips the USB
+ * delay, the checkpoint tests and the keypress (as FAST_BOOT does), so the
+ * NSP service answers again within milliseconds. Anything else (power-on,
+ * RUN pin, picotool reboot, a new build) is a cold boot and clears the
+ * records. A restart that comes back WARM_MAX_STREAK times without
+ * WARM_STABLE_MS of uptime in between falls back to a cold boot, so a
+ * state that crashes the firmware is not restored forever.
+ *
+ * The wheels are frozen for the time the reset takes (up to the watchdog
+ * timeout plus boot); they do not coast through it.
+ */
+
+#ifndef WARM_RESTART_H
+#define WARM_RESTART_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nss_nrwa_t6_model.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+/** Watchdog supervision (cmake -DNRWA_WATCHDOG=OFF for bring-up) */
+#ifndef WATCHDOG_ENABLED
+#define WATCHDOG_ENABLED            1
+#endif
+
+#define WARM_WATCHDOG_TIMEOUT_MS    1000    // Hardware watchdog period
+#define WARM_FEED_PERIOD_MS         100     // Core0 feed timer
+#define WARM_CORE0_STALL_MS         10000   // Longest Core0 main loop heartbeat gap
+#define WARM_CORE1_STALL_MS         500     // Longest Core1 heartbeat gap
+#define WARM_SAVE_HZ                100     // Wheel state copies per second
+#define WARM_STABLE_MS              10000   // Uptime that ends a restart streak
+#define WARM_MAX_STREAK             3       // Warm restarts before a cold boot
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Decide between a warm and a cold boot (first thing in main())
+ *
+ * A cold boot clears the records.
+ *
+ * @return true for a warm restart
+ */
+bool warm_restart_init(void);
+
+/**
+ * @brief Check if this boot is a warm restart
+ */
+bool warm_restart_is_warm(void);
+
+/**
+ * @brief Warm restarts since the last cold boot
+ */
+uint32_t warm_restart_get_count(void);
+
+/**
+ * @brief Restore the wheels and start saving them (Core1, after
+ *        physics_engine_init())
+ *
+ * Registers the "warm" task that copies the wheels every WARM_SAVE_HZ.
+ *
+ * @param wheels Wheel states (EMULATED_WHEEL_COUNT)
+ * @return true if the wheels were restored from the previous boot
+ */
+bool warm_restart_core1_init(wheel_state_t* wheels);
+
+/**
+ * @brief Core1 heartbeat (Core1 wait loop)
+ */
+void warm_restart_core1_beat(void);
+
+/**
+ * @brief Core0 heartbeat (main loop pass, console waits for a key)
+ */
+void warm_restart_core0_beat(void);
+
+/**
+ * @brief Resume the scenarios saved before the reset (Core0, after
+ *        catalog_init())
+ *
+ * @return Number of layers resumed
+ */
+uint8_t warm_restart_resume_scenarios(void);
+
+/**
+ * @brief Arm the watchdog and its feed timer (Core0, Core1 running)
+ *
+ * @return true if armed (false with WATCHDOG_ENABLED 0 or no timer)
+ */
+bool warm_restart_start_watchdog(void);
+
+/**
+ * @brief Save the scenario layers and end a restart streak (Core0 main loop)
+ */
+void warm_restart_poll(void);
+
+#endif // WARM_RESTART_H
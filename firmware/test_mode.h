@@ -219,6 +219,18 @@ void test_protection(void);
  */
 void run_all_checkpoint_tests(void);
 
+/**
+ * @brief Use this build's cached results, re-verifying a cheap subset
+ *
+ * Loads the flash record saved by an earlier fully passing run of the same
+ * build and re-runs the CRC vectors (CP 3.1) over it. Nothing here touches
+ * RS-485, so it is safe with the NSP service running.
+ *
+ * @return true if cached results were loaded and the re-run passed; false
+ *         leaves the registry empty (run run_all_checkpoint_tests())
+ */
+bool run_cached_checkpoint_tests(void);
+
 // ============================================================================
 // Helper Macros
 // ============================================================================
@@ -2,11 +2,13 @@
  * @file test_phase9.c
  * @brief Phase 9 Scenario Engine Test
  *
- * Tests JSON parsing and scenario timeline execution.
+ * Tests JSON parsing, compiled scenario images and scenario timeline
+ * execution.
  */
 
 #include "config/scenario.h"
 #include "config/json_loader.h"
+#include "config/scenario_registry.h"
 #include "pico/stdlib.h"
 #include <stdio.h>
 #include <string.h>
@@ -43,6 +45,19 @@ static const char* test_scenario_simple =
 "  ]\n"
 "}\n";
 
+// Same text as tests/scenarios/crc_burst.json (encoder cross-check)
+static const char* test_scenario_crc_burst =
+"{\n"
+"  \"name\": \"CRC Burst Test\",\n"
+"  \"description\": \"Multiple CRC errors at t=2s, 3s, 4s\",\n"
+"  \"version\": \"1.0\",\n"
+"  \"schedule\": [\n"
+"    { \"t_ms\": 2000, \"action\": { \"inject_crc_error\": true } },\n"
+"    { \"t_ms\": 3000, \"action\": { \"inject_crc_error\": true } },\n"
+"    { \"t_ms\": 4000, \"action\": { \"inject_crc_error\": true } }\n"
+"  ]\n"
+"}\n";
+
 // ============================================================================
 // Test Functions
 // ============================================================================
@@ -54,37 +69,46 @@ void test_json_parser(void) {
     printf("╚════════════════════════════════════════════════════════════╝\n");
     printf("\n");
 
-    scenario_t scenario;
-    bool result = json_parse_scenario(test_scenario_simple, strlen(test_scenario_simple), &scenario);
+    static uint32_t buf[SCENARIO_RAM_IMAGE_SIZE / 4];
+    scenario_bin_builder_t builder;
+    scenario_bin_begin(&builder, buf, sizeof(buf));
+    bool result = json_parse_scenario(test_scenario_simple, strlen(test_scenario_simple), &builder);
 
-    if (!result) {
+    if (!result || scenario_bin_finish(&builder) == 0) {
         printf("✗ FAIL: JSON parse failed: %s\n", json_get_last_error());
         return;
     }
 
+    const scenario_bin_header_t* image = (const scenario_bin_header_t*)buf;
     printf("✓ PASS: JSON parsed successfully\n");
-    printf("  Name: %s\n", scenario.name);
-    printf("  Description: %s\n", scenario.description);
-    printf("  Event count: %d\n", scenario.event_count);
+    printf("  Name: %s\n", image->name);
+    printf("  Description: %s\n", scenario_bin_description(image));
+    printf("  Event count: %d\n", image->event_count);
 
     // Verify event details
-    if (scenario.event_count != 3) {
-        printf("✗ FAIL: Expected 3 events, got %d\n", scenario.event_count);
+    if (image->event_count != 3) {
+        printf("✗ FAIL: Expected 3 events, got %d\n", image->event_count);
+        return;
+    }
+
+    const scenario_bin_event_t* ev0 = scenario_bin_event(image, 0);
+    const scenario_bin_event_t* ev1 = scenario_bin_event(image, 1);
+    const scenario_bin_event_t* ev2 = scenario_bin_event(image, 2);
+    if (ev0->op_count != 1 || scenario_bin_ops(ev0)[0].opcode != SCENARIO_OP_CRC_ERROR ||
+        ev1->op_count != 1 || scenario_bin_ops(ev1)[0].opcode != SCENARIO_OP_DROP_FRAMES ||
+        ev2->op_count != 1 || scenario_bin_ops(ev2)[0].opcode != SCENARIO_OP_OVERSPEED) {
+        printf("✗ FAIL: Unexpected opcodes\n");
         return;
     }
 
     printf("\n  Event 0: t=%lu ms, CRC injection: %s\n",
-           scenario.events[0].t_ms,
-           scenario.events[0].action.inject_crc_error ? "YES" : "NO");
+           ev0->t_ms, (ev0->layers & SCENARIO_LAYER_TRANSPORT) ? "YES" : "NO");
 
-    printf("  Event 1: t=%lu ms, duration=%lu ms, Drop rate: %d%%\n",
-           scenario.events[1].t_ms,
-           scenario.events[1].duration_ms,
-           scenario.events[1].action.drop_frames_pct);
+    printf("  Event 1: t=%lu ms, duration=%lu ms, Drop rate: %lu%%\n",
+           ev1->t_ms, ev1->duration_ms, scenario_bin_ops(ev1)[0].arg.u);
 
     printf("  Event 2: t=%lu ms, Overspeed fault: %s\n",
-           scenario.events[2].t_ms,
-           scenario.events[2].action.overspeed_fault ? "YES" : "NO");
+           ev2->t_ms, (ev2->layers & SCENARIO_LAYER_DEVICE) ? "YES" : "NO");
 
     printf("\n✓✓✓ JSON PARSER TEST PASSED ✓✓✓\n");
 }
@@ -222,6 +246,78 @@ void test_config_table_update(void) {
     printf("\n✓✓✓ CONFIG TABLE TEST PASSED ✓✓✓\n");
 }
 
+void test_builtin_images(void) {
+    printf("\n");
+    printf("╔════════════════════════════════════════════════════════════╗\n");
+    printf("║  TEST 5: BUILT-IN SCENARIO IMAGES                         ║\n");
+    printf("╚════════════════════════════════════════════════════════════╝\n");
+    printf("\n");
+
+    scenario_engine_init();
+
+    for (uint8_t i = 0; i < scenario_registry_count(); i++) {
+        const scenario_entry_t* entry = scenario_registry_get(i);
+        const char* error = scenario_bin_validate(entry->image, entry->image_len);
+        if (error != NULL) {
+            printf("✗ FAIL: %s: %s\n", entry->name, error);
+            return;
+        }
+        if (!scenario_load_image(entry->image, entry->image_len)) {
+            printf("✗ FAIL: %s: load failed\n", entry->name);
+            return;
+        }
+        printf("  %-24s %3u bytes, %u events (XIP %p)\n", entry->name,
+               (unsigned)entry->image_len, (unsigned)scenario_get_total_events(),
+               (const void*)entry->image);
+    }
+
+    // The firmware builder must agree with the build-time compiler
+    static uint32_t image[SCENARIO_RAM_IMAGE_SIZE / 4];
+    scenario_bin_builder_t builder;
+    scenario_bin_begin(&builder, image, sizeof(image));
+    const scenario_entry_t* entry = scenario_registry_get(scenario_registry_find("CRC Burst Test"));
+    if (entry == NULL ||
+        !json_parse_scenario(test_scenario_crc_burst, strlen(test_scenario_crc_burst), &builder)) {
+        printf("✗ FAIL: CRC Burst Test reference not available\n");
+        return;
+    }
+    size_t len = scenario_bin_finish(&builder);
+    if (len != entry->image_len || memcmp(image, entry->image, len) != 0) {
+        printf("✗ FAIL: Encoded CRC Burst Test differs from built-in image\n");
+        return;
+    }
+    printf("✓ PASS: JSON encoder matches the build-time image (%u bytes)\n", (unsigned)len);
+
+    // Fed one byte at a time (as from the console) the result is the same
+    static json_stream_t stream;
+    scenario_bin_begin(&builder, image, sizeof(image));
+    json_stream_begin(&stream, &builder);
+    for (const char* p = test_scenario_crc_burst; *p; p++) {
+        json_stream_feed(&stream, p, 1);
+    }
+    if (!json_stream_end(&stream) || scenario_bin_finish(&builder) != entry->image_len ||
+        memcmp(image, entry->image, entry->image_len) != 0) {
+        printf("✗ FAIL: Byte-wise stream parse differs: %s\n",
+               json_stream_error(&stream, NULL) ? json_stream_error(&stream, NULL) : "image");
+        return;
+    }
+
+    // Errors report where they were found
+    static const char bad_value[] = "{\"name\": \"T\", \"schedule\": [{\"t_ms\": x}]}";
+    uint32_t offset = 0;
+    scenario_bin_begin(&builder, image, sizeof(image));
+    json_stream_begin(&stream, &builder);
+    if (json_stream_feed(&stream, bad_value, sizeof(bad_value) - 1) ||
+        json_stream_error(&stream, &offset) == NULL || offset != 36) {
+        printf("✗ FAIL: Expected an error at byte 36, got %lu\n", (unsigned long)offset);
+        return;
+    }
+    printf("✓ PASS: Streaming parser matches byte by byte, errors at byte %lu\n",
+           (unsigned long)offset);
+
+    printf("\n✓✓✓ BUILT-IN IMAGE TEST PASSED ✓✓✓\n");
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -244,6 +340,9 @@ void run_phase9_tests(void) {
     sleep_ms(1000);
 
     test_config_table_update();
+    sleep_ms(1000);
+
+    test_builtin_images();
 
     printf("\n");
     printf("╔════════════════════════════════════════════════════════════╗\n");
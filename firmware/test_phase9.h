@@ -14,6 +14,7 @@
  * 2. Scenario loading (load, activate, deactivate)
  * 3. Timeline execution (event triggering)
  * 4. Config table integration
+ * 5. Built-in scenario images (validation, encoder cross-check)
  */
 void run_phase9_tests(void);
 
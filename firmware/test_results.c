@@ -4,9 +4,22 @@
  */
 
 #include "test_results.h"
+#include "board_pico.h"
+#include "crc_ccitt.h"
+#include "util/flash_store.h"
 #include <string.h>
 #include <stdio.h>
 
+// Firmware version (passed from CMake)
+#ifndef FIRMWARE_VERSION
+#define FIRMWARE_VERSION "v0.1.0-unknown"
+#endif
+
+/** Cache key: version string plus build time (catches rebuilds of a dirty tree) */
+#define TEST_CACHE_BUILD_ID     FIRMWARE_VERSION " " __DATE__ " " __TIME__
+
+#define TEST_CACHE_MAGIC        0x53455254u     // "TRES"
+
 // ============================================================================
 // Global State
 // ============================================================================
@@ -20,6 +33,49 @@ static checkpoint_results_t* current_checkpoint = NULL;
 static test_result_t test_storage[MAX_CHECKPOINTS][MAX_TESTS_PER_CHECKPOINT];
 static uint8_t test_counts[MAX_CHECKPOINTS];
 
+// ============================================================================
+// Flash Record
+// ============================================================================
+
+typedef struct {
+    uint32_t magic;             // TEST_CACHE_MAGIC
+    uint16_t layout;            // TEST_CACHE_LAYOUT
+    uint16_t crc;               // CRC-CCITT of the record after the header
+    uint32_t build_hash;        // FNV-1a of TEST_CACHE_BUILD_ID
+    uint8_t checkpoint_count;
+    uint8_t test_count;
+    uint16_t reserved;
+    char build[32];             // FIRMWARE_VERSION (display)
+} test_cache_header_t;
+
+typedef struct {
+    char name[TEST_CACHE_CP_NAME_LEN];
+    uint8_t phase;
+    uint8_t checkpoint;
+    uint8_t test_count;
+    uint8_t passed_count;
+    uint32_t total_duration_us;
+} test_cache_checkpoint_t;
+
+typedef struct {
+    char name[TEST_CACHE_TEST_NAME_LEN];
+    uint32_t duration_us;
+    uint8_t passed;
+    uint8_t reserved[3];
+} test_cache_test_t;
+
+typedef struct {
+    test_cache_header_t header;
+    test_cache_checkpoint_t checkpoints[MAX_CHECKPOINTS];
+    test_cache_test_t tests[TEST_CACHE_MAX_TESTS];      // In checkpoint order
+} test_cache_record_t;
+
+_Static_assert(sizeof(test_cache_record_t) <= FLASH_TEST_CACHE_SIZE,
+               "test cache record must fit its flash partition");
+
+// RAM image: built here before a save, and holds the names after a load
+static test_cache_record_t cache_image;
+
 // ============================================================================
 // Initialization
 // ============================================================================
@@ -36,13 +92,48 @@ void test_results_init(void) {
 // Checkpoint Management
 // ============================================================================
 
+/**
+ * @brief Recompute the registry totals from its checkpoints
+ */
+static void update_totals(void) {
+    uint32_t duration_us = 0;
+
+    g_test_results.total_tests = 0;
+    g_test_results.total_passed = 0;
+    g_test_results.all_passed = true;
+    g_test_results.cached_count = 0;
+
+    for (uint8_t i = 0; i < g_test_results.checkpoint_count; i++) {
+        const checkpoint_results_t* cp = &g_test_results.checkpoints[i];
+        g_test_results.total_tests += cp->test_count;
+        g_test_results.total_passed += cp->passed_count;
+        duration_us += cp->total_duration_us;
+        if (cp->test_count != cp->passed_count) {
+            g_test_results.all_passed = false;
+        }
+        if (cp->cached) {
+            g_test_results.cached_count++;
+        }
+    }
+    g_test_results.total_duration_ms = duration_us / 1000;
+}
+
 void test_checkpoint_begin(uint8_t phase, uint8_t checkpoint, const char* name) {
-    if (g_test_results.checkpoint_count >= MAX_CHECKPOINTS) {
+    // Re-run of a checkpoint already in the registry takes over its slot
+    uint8_t idx = g_test_results.checkpoint_count;
+    for (uint8_t i = 0; i < g_test_results.checkpoint_count; i++) {
+        if (g_test_results.checkpoints[i].phase == phase &&
+            g_test_results.checkpoints[i].checkpoint == checkpoint) {
+            idx = i;
+            break;
+        }
+    }
+
+    if (idx >= MAX_CHECKPOINTS) {
         printf("[TEST] ERROR: Checkpoint limit reached (%d)\n", MAX_CHECKPOINTS);
         return;
     }
 
-    uint8_t idx = g_test_results.checkpoint_count;
     current_checkpoint = &g_test_results.checkpoints[idx];
 
     current_checkpoint->checkpoint_name = name;
@@ -52,6 +143,7 @@ void test_checkpoint_begin(uint8_t phase, uint8_t checkpoint, const char* name)
     current_checkpoint->test_count = 0;
     current_checkpoint->passed_count = 0;
     current_checkpoint->total_duration_us = 0;
+    current_checkpoint->cached = false;
 
     test_counts[idx] = 0;
 }
@@ -61,20 +153,13 @@ void test_checkpoint_end(void) {
         return;
     }
 
-    // Update global stats
-    g_test_results.total_tests += current_checkpoint->test_count;
-    g_test_results.total_passed += current_checkpoint->passed_count;
-    g_test_results.total_duration_ms += (current_checkpoint->total_duration_us / 1000);
-
-    // Check if all tests passed
-    if (current_checkpoint->test_count == current_checkpoint->passed_count) {
-        // All passed for this checkpoint
-    } else {
-        g_test_results.all_passed = false;
+    uint8_t idx = (uint8_t)(current_checkpoint - g_test_results.checkpoints);
+    if (idx == g_test_results.checkpoint_count) {
+        g_test_results.checkpoint_count++;
     }
-
-    g_test_results.checkpoint_count++;
     current_checkpoint = NULL;
+
+    update_totals();
 }
 
 // ============================================================================
@@ -87,7 +172,7 @@ void test_record_result(const char* name, bool passed, uint32_t duration_us) {
         return;
     }
 
-    uint8_t idx = g_test_results.checkpoint_count;
+    uint8_t idx = (uint8_t)(current_checkpoint - g_test_results.checkpoints);
     if (test_counts[idx] >= MAX_TESTS_PER_CHECKPOINT) {
         printf("[TEST] ERROR: Test limit reached for checkpoint\n");
         return;
@@ -127,3 +212,135 @@ const checkpoint_results_t* test_get_checkpoint(uint8_t index) {
     }
     return &g_test_results.checkpoints[index];
 }
+
+// ============================================================================
+// Flash Cache
+// ============================================================================
+
+/**
+ * @brief FNV-1a hash of the build identity
+ */
+static uint32_t build_hash(void) {
+    uint32_t h = 2166136261u;
+    for (const char* p = TEST_CACHE_BUILD_ID; *p; p++) {
+        h = (h ^ (uint8_t)*p) * 16777619u;
+    }
+    return h;
+}
+
+static uint16_t record_crc(const test_cache_record_t* rec) {
+    return crc_ccitt_calculate((const uint8_t*)rec + sizeof(rec->header),
+                               sizeof(*rec) - sizeof(rec->header));
+}
+
+bool test_results_load(void) {
+    const test_cache_record_t* stored = FLASH_STORE_XIP(FLASH_TEST_CACHE_OFFSET);
+
+    if (stored->header.magic != TEST_CACHE_MAGIC ||
+        stored->header.layout != TEST_CACHE_LAYOUT ||
+        stored->header.build_hash != build_hash() ||
+        stored->header.checkpoint_count > MAX_CHECKPOINTS ||
+        stored->header.test_count > TEST_CACHE_MAX_TESTS) {
+        return false;
+    }
+
+    memcpy(&cache_image, stored, sizeof(cache_image));
+    if (record_crc(&cache_image) != cache_image.header.crc) {
+        printf("[TEST] Cached results CRC mismatch, ignoring\n");
+        return false;
+    }
+
+    test_results_init();
+
+    uint32_t next = 0;
+    for (uint8_t i = 0; i < cache_image.header.checkpoint_count; i++) {
+        test_cache_checkpoint_t* src = &cache_image.checkpoints[i];
+        checkpoint_results_t* cp = &g_test_results.checkpoints[i];
+
+        if (src->test_count > MAX_TESTS_PER_CHECKPOINT ||
+            next + src->test_count > cache_image.header.test_count) {
+            test_results_init();
+            return false;
+        }
+
+        src->name[TEST_CACHE_CP_NAME_LEN - 1] = '\0';
+        cp->checkpoint_name = src->name;
+        cp->phase = src->phase;
+        cp->checkpoint = src->checkpoint;
+        cp->tests = test_storage[i];
+        cp->test_count = src->test_count;
+        cp->passed_count = src->passed_count;
+        cp->total_duration_us = src->total_duration_us;
+        cp->cached = true;
+
+        for (uint8_t t = 0; t < src->test_count; t++, next++) {
+            test_cache_test_t* ts = &cache_image.tests[next];
+            ts->name[TEST_CACHE_TEST_NAME_LEN - 1] = '\0';
+            cp->tests[t].name = ts->name;
+            cp->tests[t].passed = (ts->passed != 0);
+            cp->tests[t].duration_us = ts->duration_us;
+        }
+        test_counts[i] = src->test_count;
+    }
+    g_test_results.checkpoint_count = cache_image.header.checkpoint_count;
+    cache_image.header.build[sizeof(cache_image.header.build) - 1] = '\0';
+    g_test_results.cache_build = cache_image.header.build;
+    update_totals();
+
+    printf("[TEST] Loaded %u cached results (%u checkpoints, build %s)\n",
+           (unsigned)g_test_results.total_tests, (unsigned)g_test_results.checkpoint_count,
+           g_test_results.cache_build);
+    return true;
+}
+
+bool test_results_save(void) {
+    if (!g_test_results.all_passed || g_test_results.cached_count > 0 ||
+        g_test_results.total_tests > TEST_CACHE_MAX_TESTS ||
+        g_test_results.checkpoint_count == 0) {
+        return false;
+    }
+
+    // A registry loaded earlier points into the image; it is rebuilt below
+    g_test_results.cache_build = NULL;
+    memset(&cache_image, 0, sizeof(cache_image));
+
+    uint32_t next = 0;
+    for (uint8_t i = 0; i < g_test_results.checkpoint_count; i++) {
+        const checkpoint_results_t* cp = &g_test_results.checkpoints[i];
+        test_cache_checkpoint_t* dst = &cache_image.checkpoints[i];
+
+        strncpy(dst->name, cp->checkpoint_name, TEST_CACHE_CP_NAME_LEN - 1);
+        dst->phase = cp->phase;
+        dst->checkpoint = cp->checkpoint;
+        dst->test_count = cp->test_count;
+        dst->passed_count = cp->passed_count;
+        dst->total_duration_us = cp->total_duration_us;
+
+        for (uint8_t t = 0; t < cp->test_count; t++, next++) {
+            test_cache_test_t* ts = &cache_image.tests[next];
+            strncpy(ts->name, cp->tests[t].name, TEST_CACHE_TEST_NAME_LEN - 1);
+            ts->duration_us = cp->tests[t].duration_us;
+            ts->passed = cp->tests[t].passed ? 1 : 0;
+        }
+    }
+
+    cache_image.header.magic = TEST_CACHE_MAGIC;
+    cache_image.header.layout = TEST_CACHE_LAYOUT;
+    cache_image.header.build_hash = build_hash();
+    cache_image.header.checkpoint_count = g_test_results.checkpoint_count;
+    cache_image.header.test_count = (uint8_t)next;
+    strncpy(cache_image.header.build, FIRMWARE_VERSION, sizeof(cache_image.header.build) - 1);
+    cache_image.header.crc = record_crc(&cache_image);
+
+    if (!flash_store_write(FLASH_TEST_CACHE_OFFSET, &cache_image, sizeof(cache_image))) {
+        printf("[TEST] ERROR: Could not save results to flash\n");
+        return false;
+    }
+    printf("[TEST] Saved %u results to flash\n", (unsigned)next);
+    return true;
+}
+
+bool test_results_clear_cache(void) {
+    // Names of a loaded registry live in cache_image (RAM), not in flash
+    return flash_store_write(FLASH_TEST_CACHE_OFFSET, NULL, 0);
+}
@@ -4,6 +4,11 @@
  *
  * Collects test results from all checkpoints at boot time.
  * Results are cached and displayed in TUI "Built-In Tests" table.
+ *
+ * A fully passing run is also saved to flash, tagged with a hash of
+ * FIRMWARE_VERSION and the build time. Later boots of the same build load
+ * it instead of re-running every checkpoint, then re-run a cheap subset
+ * (the CRC vectors) over the loaded results.
  */
 
 #ifndef TEST_RESULTS_H
@@ -37,6 +42,7 @@ typedef struct {
     uint8_t test_count;             // Number of tests
     uint8_t passed_count;           // Number of passed tests
     uint32_t total_duration_us;     // Total execution time
+    bool cached;                    // Loaded from flash, not run this boot
 } checkpoint_results_t;
 
 // ============================================================================
@@ -63,6 +69,8 @@ typedef struct {
     uint8_t total_passed;
     uint32_t total_duration_ms;
     bool all_passed;
+    uint8_t cached_count;           // Checkpoints loaded from flash
+    const char* cache_build;        // FIRMWARE_VERSION of the loaded record (NULL = none)
 } test_registry_t;
 
 // Global test registry (allocated at boot)
@@ -82,6 +90,9 @@ void test_results_init(void);
 /**
  * @brief Begin a checkpoint test suite
  *
+ * A checkpoint already in the registry with the same phase and number
+ * (e.g. loaded from flash) is replaced by the new run.
+ *
  * @param phase Phase number (3-7)
  * @param checkpoint Checkpoint number (1-3)
  * @param name Checkpoint name (e.g., "CRC-CCITT Implementation")
@@ -121,4 +132,47 @@ char* test_get_summary(char* buf, size_t buflen);
  */
 const checkpoint_results_t* test_get_checkpoint(uint8_t index);
 
+// ============================================================================
+// Flash Cache
+// ============================================================================
+
+/**
+ * @brief Flash record layout version (bump when the record changes)
+ */
+#define TEST_CACHE_LAYOUT           1
+
+/** Longest checkpoint / test name kept in the record (incl. NUL) */
+#define TEST_CACHE_CP_NAME_LEN      24
+#define TEST_CACHE_TEST_NAME_LEN    40
+
+/** Tests kept in the record (all checkpoints) */
+#define TEST_CACHE_MAX_TESTS        144
+
+/**
+ * @brief Replace the registry with the cached results of this build
+ *
+ * The record is used only if its layout, CRC and build hash match. Names
+ * are copied to RAM, so the record may be erased afterwards.
+ *
+ * @return true if results were loaded (all checkpoints marked cached)
+ */
+bool test_results_load(void);
+
+/**
+ * @brief Save the registry to flash for later boots of this build
+ *
+ * Only a fully passing registry with no cached checkpoints is saved;
+ * names longer than the record fields are truncated.
+ *
+ * @return true if the record was written
+ */
+bool test_results_save(void);
+
+/**
+ * @brief Erase the flash record (next boot runs every checkpoint)
+ *
+ * @return true if erased
+ */
+bool test_results_clear_cache(void);
+
 #endif // TEST_RESULTS_H
@@ -0,0 +1,132 @@
+/**
+ * @file bus_meter.c
+ * @brief RS-485 Bus Throughput and Utilization Meter Implementation
+ */
+
+#include "bus_meter.h"
+#include "hot_path.h"
+#include <string.h>
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+static volatile uint32_t char_ns = 0;           // One 10-bit character on the wire
+
+// Gap tracking (NSP service only, except the reset request)
+static uint32_t prev_end_us = 0;
+static uint32_t prev_wire_bytes = 0;
+static bool prev_valid = false;
+static volatile bool gap_reset_requested = false;
+static volatile uint32_t gap_count = 0;
+static volatile uint32_t gap_min_us = 0;
+static volatile uint32_t gap_max_us = 0;
+static volatile uint64_t gap_sum_us = 0;
+
+// Window (console only)
+static bool window_open = false;
+static uint32_t window_start_us = 0;
+static bus_meter_counts_t window_start;
+static bus_meter_rates_t rates;
+
+// ============================================================================
+// RX Path
+// ============================================================================
+
+void HOT_PATH_FUNC(bus_meter_rx_frame)(uint32_t end_us, uint32_t wire_bytes) {
+    if (gap_reset_requested) {
+        gap_reset_requested = false;
+        gap_count = 0;
+        gap_sum_us = 0;
+    }
+
+    if (prev_valid) {
+        uint32_t elapsed_us = end_us - prev_end_us;
+        uint32_t busy_us = (uint32_t)(((uint64_t)(wire_bytes - prev_wire_bytes) * char_ns) / 1000u);
+        uint32_t gap_us = (elapsed_us > busy_us) ? elapsed_us - busy_us : 0;
+
+        if (gap_count == 0 || gap_us < gap_min_us) gap_min_us = gap_us;
+        if (gap_count == 0 || gap_us > gap_max_us) gap_max_us = gap_us;
+        gap_sum_us += gap_us;
+        gap_count++;
+    }
+
+    prev_end_us = end_us;
+    prev_wire_bytes = wire_bytes;
+    prev_valid = true;
+}
+
+// ============================================================================
+// Windowing (console)
+// ============================================================================
+
+static uint32_t per_second(uint32_t delta, uint32_t window_us) {
+    return (uint32_t)(((uint64_t)delta * 1000000u) / window_us);
+}
+
+static uint32_t busy_permille(uint32_t bytes, uint32_t window_us) {
+    // bytes · char_ns / (window_us · 1000 ns) · 1000
+    uint64_t permille = ((uint64_t)bytes * char_ns) / window_us;
+    return (permille > 1000u) ? 1000u : (uint32_t)permille;
+}
+
+void bus_meter_reset(uint32_t baud) {
+    char_ns = (baud > 0) ? (uint32_t)(10000000000ull / baud) : 0;
+    memset(&rates, 0, sizeof(rates));
+    window_open = false;
+    gap_reset_requested = true;
+}
+
+bool bus_meter_update(uint32_t now_us, const bus_meter_counts_t* totals) {
+    if (!window_open) {
+        window_start_us = now_us;
+        window_start = *totals;
+        window_open = true;
+        gap_reset_requested = true;
+        return false;
+    }
+
+    uint32_t window_us = now_us - window_start_us;
+    if (window_us < BUS_METER_WINDOW_US) {
+        return false;
+    }
+
+    uint32_t rx_bytes = totals->rx_bytes - window_start.rx_bytes;
+    uint32_t tx_bytes = totals->tx_bytes - window_start.tx_bytes;
+
+    rates.window_us = window_us;
+    rates.rx_bytes_per_s = per_second(rx_bytes, window_us);
+    rates.tx_bytes_per_s = per_second(tx_bytes, window_us);
+    rates.rx_frames_per_s = per_second(totals->rx_frames - window_start.rx_frames, window_us);
+    rates.tx_frames_per_s = per_second(totals->tx_frames - window_start.tx_frames, window_us);
+    rates.rx_busy_permille = busy_permille(rx_bytes, window_us);
+    rates.tx_busy_permille = busy_permille(tx_bytes, window_us);
+    uint32_t busy = rates.rx_busy_permille + rates.tx_busy_permille;
+    if (busy > 1000u) {
+        busy = 1000u;
+    }
+    rates.idle_permille = 1000u - busy;
+
+    uint32_t bytes_per_s = rates.rx_bytes_per_s + rates.tx_bytes_per_s;
+    uint32_t frames_per_s = rates.rx_frames_per_s + rates.tx_frames_per_s;
+    if (bytes_per_s > rates.peak_bytes_per_s) rates.peak_bytes_per_s = bytes_per_s;
+    if (frames_per_s > rates.peak_frames_per_s) rates.peak_frames_per_s = frames_per_s;
+    if (busy > rates.peak_busy_permille) rates.peak_busy_permille = busy;
+
+    // Gap figures for the window (none if the RX path has not picked up the
+    // last reset, i.e. no stamped frame since), then ask it to start over
+    uint32_t count = gap_reset_requested ? 0 : gap_count;
+    rates.gap_count = count;
+    rates.gap_min_us = (count > 0) ? gap_min_us : 0;
+    rates.gap_max_us = (count > 0) ? gap_max_us : 0;
+    rates.gap_mean_us = (count > 0) ? (uint32_t)(gap_sum_us / count) : 0;
+    gap_reset_requested = true;
+
+    window_start_us = now_us;
+    window_start = *totals;
+    return true;
+}
+
+void bus_meter_get_rates(bus_meter_rates_t* out) {
+    *out = rates;
+}
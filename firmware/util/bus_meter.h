@@ -0,0 +1,91 @@
+/**
+ * @file bus_meter.h
+ * @brief RS-485 Bus Throughput and Utilization Meter
+ *
+ * Turns the NSP handler's cumulative byte and frame counters into windowed
+ * rates: bytes/s and frames/s each way, the share of the window the wire
+ * was busy with received traffic, with our replies and idle, and the peaks
+ * of those rates. Busy time is byte count times the character time (10 bit
+ * periods at the programmed baud), so it needs no per-byte timing.
+ *
+ * The NSP service also reports each received frame's END arrival; the
+ * meter subtracts the wire time of the bytes in between (both directions)
+ * from the time since the previous END, which leaves the idle gap before
+ * each frame. Only driver-stamped ENDs are used (rs485_rx_delimiter_time()).
+ *
+ * Rates are computed on the console side when a window of
+ * BUS_METER_WINDOW_US has elapsed; reading them costs the RX path nothing.
+ */
+
+#ifndef BUS_METER_H
+#define BUS_METER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Rate window (µs) */
+#define BUS_METER_WINDOW_US     1000000u
+
+/**
+ * @brief Cumulative counters sampled at the end of each window
+ */
+typedef struct {
+    uint32_t rx_bytes;          // Bytes received (SLIP encoded)
+    uint32_t tx_bytes;          // Bytes sent (SLIP encoded)
+    uint32_t rx_frames;         // Frames seen on the bus, any destination
+    uint32_t tx_frames;         // Replies sent
+} bus_meter_counts_t;
+
+/**
+ * @brief Rates over the last completed window
+ */
+typedef struct {
+    uint32_t window_us;         // Length of that window (0 = none yet)
+    uint32_t rx_bytes_per_s;
+    uint32_t tx_bytes_per_s;
+    uint32_t rx_frames_per_s;
+    uint32_t tx_frames_per_s;
+    uint32_t rx_busy_permille;  // Wire time of received bytes
+    uint32_t tx_busy_permille;  // Wire time of our replies
+    uint32_t idle_permille;     // The rest
+    uint32_t peak_bytes_per_s;  // Highest RX + TX rate of any window
+    uint32_t peak_frames_per_s;
+    uint32_t peak_busy_permille;
+    uint32_t gap_count;         // Idle gaps measured in the window
+    uint32_t gap_min_us;
+    uint32_t gap_mean_us;
+    uint32_t gap_max_us;
+} bus_meter_rates_t;
+
+/**
+ * @brief Start over at a new baud rate (clears rates and peaks)
+ *
+ * @param baud Actual baud rate on the wire
+ */
+void bus_meter_reset(uint32_t baud);
+
+/**
+ * @brief Note a received frame's END arrival (NSP service only)
+ *
+ * @param end_us time_us_32() when the END byte's stop bit ended
+ * @param wire_bytes Bytes received plus bytes sent so far (cumulative)
+ */
+void bus_meter_rx_frame(uint32_t end_us, uint32_t wire_bytes);
+
+/**
+ * @brief Close the window if it has run its length (console)
+ *
+ * @param now_us time_us_32()
+ * @param totals Current cumulative counters
+ * @return true if a window was closed and the rates changed
+ */
+bool bus_meter_update(uint32_t now_us, const bus_meter_counts_t* totals);
+
+/**
+ * @brief Get the rates of the last completed window
+ *
+ * @param rates Output: rates
+ */
+void bus_meter_get_rates(bus_meter_rates_t* rates);
+
+#endif // BUS_METER_H
@@ -0,0 +1,170 @@
+/**
+ * @file bus_mon.c
+ * @brief RS-485 Bus Monitor Capture Ring Implementation
+ */
+
+#include "bus_mon.h"
+#include "hot_path.h"
+#include "hardware/sync.h"
+#include <string.h>
+
+#define RING_MASK   (BUS_MON_RING_SIZE - 1u)
+
+_Static_assert((BUS_MON_RING_SIZE & RING_MASK) == 0, "capture ring size must be a power of 2");
+_Static_assert(BUS_MON_RING_SIZE >= 4u * (BUS_MON_RECORD_HEADER + BUS_MON_SNAPLEN),
+               "capture ring must hold several full-size frames");
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+static uint8_t ring[BUS_MON_RING_SIZE];
+static volatile uint32_t ring_head = 0;         // Written by the NSP service only
+static volatile uint32_t ring_tail = 0;         // Written by the USB pump only
+static volatile bool flush_requested = false;   // Mode change: pump discards the backlog
+
+static volatile bus_mon_mode_t mode = BUS_MON_OFF;
+
+static volatile uint32_t captured_count = 0;
+static volatile uint32_t dropped_count = 0;
+static volatile uint32_t sent_count = 0;
+static volatile uint32_t high_water = 0;
+
+// ============================================================================
+// Ring Access
+// ============================================================================
+
+static void HOT_PATH_FUNC(ring_write)(uint32_t pos, const uint8_t* src, size_t len) {
+    uint32_t off = pos & RING_MASK;
+    size_t first = BUS_MON_RING_SIZE - off;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(&ring[off], src, first);
+    memcpy(ring, src + first, len - first);
+}
+
+static void ring_read(uint32_t pos, uint8_t* dst, size_t len) {
+    uint32_t off = pos & RING_MASK;
+    size_t first = BUS_MON_RING_SIZE - off;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(dst, &ring[off], first);
+    memcpy(dst + first, ring, len - first);
+}
+
+// ============================================================================
+// Writer (NSP service)
+// ============================================================================
+
+bool HOT_PATH_FUNC(bus_mon_capture)(uint64_t timestamp_us, uint8_t flags, uint8_t verdict,
+                                    const uint8_t* data, size_t len) {
+    if (mode == BUS_MON_OFF) {
+        return false;
+    }
+
+    if (len > BUS_MON_SNAPLEN) {
+        len = BUS_MON_SNAPLEN;
+        flags |= BUS_MON_F_TRUNC;
+    }
+
+    uint32_t head = ring_head;
+    uint32_t used = head - ring_tail;
+    uint32_t need = BUS_MON_RECORD_HEADER + (uint32_t)len;
+    if (used + need > BUS_MON_RING_SIZE) {
+        dropped_count++;
+        return false;
+    }
+
+    // Header in wire order: timestamp (LE), flags, verdict, length (LE)
+    uint8_t hdr[BUS_MON_RECORD_HEADER];
+    for (uint32_t i = 0; i < 8; i++) {
+        hdr[i] = (uint8_t)(timestamp_us >> (8 * i));
+    }
+    hdr[8] = flags;
+    hdr[9] = verdict;
+    hdr[10] = (uint8_t)len;
+    hdr[11] = (uint8_t)(len >> 8);
+
+    ring_write(head, hdr, sizeof(hdr));
+    if (len > 0) {
+        ring_write(head + BUS_MON_RECORD_HEADER, data, len);
+    }
+    __dmb();    // Record complete before the index that publishes it
+    ring_head = head + need;
+
+    captured_count++;
+    if (used + need > high_water) {
+        high_water = used + need;
+    }
+    return true;
+}
+
+// ============================================================================
+// Reader (USB pump)
+// ============================================================================
+
+bool bus_mon_peek(bus_mon_record_t* record) {
+    if (flush_requested) {
+        flush_requested = false;
+        ring_tail = ring_head;
+    }
+
+    uint32_t tail = ring_tail;
+    if (tail == ring_head) {
+        return false;
+    }
+    __dmb();    // Read the record after seeing the index that published it
+
+    uint8_t hdr[BUS_MON_RECORD_HEADER];
+    ring_read(tail, hdr, sizeof(hdr));
+    record->timestamp_us = 0;
+    for (uint32_t i = 0; i < 8; i++) {
+        record->timestamp_us |= (uint64_t)hdr[i] << (8 * i);
+    }
+    record->flags = hdr[8];
+    record->verdict = hdr[9];
+    record->len = (uint16_t)(hdr[10] | ((uint16_t)hdr[11] << 8));
+    return true;
+}
+
+void bus_mon_pop(uint8_t* out) {
+    uint32_t tail = ring_tail;
+    uint8_t len_bytes[2];
+    ring_read(tail + 10, len_bytes, sizeof(len_bytes));
+    uint16_t len = (uint16_t)(len_bytes[0] | ((uint16_t)len_bytes[1] << 8));
+
+    ring_read(tail + BUS_MON_RECORD_HEADER, out, len);
+    __dmb();    // Done reading before the space is handed back
+    ring_tail = tail + BUS_MON_RECORD_HEADER + len;
+    sent_count++;
+}
+
+void bus_mon_flush(void) {
+    flush_requested = false;
+    ring_tail = ring_head;
+}
+
+// ============================================================================
+// Control
+// ============================================================================
+
+void bus_mon_set_mode(bus_mon_mode_t new_mode) {
+    if (new_mode >= BUS_MON_MODE_COUNT || new_mode == mode) {
+        return;
+    }
+    mode = new_mode;
+    flush_requested = true;
+}
+
+bus_mon_mode_t bus_mon_get_mode(void) {
+    return mode;
+}
+
+void bus_mon_get_stats(bus_mon_stats_t* stats) {
+    stats->captured = captured_count;
+    stats->dropped = dropped_count;
+    stats->sent = sent_count;
+    stats->high_water = high_water;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file bus_mon.h
+ * @brief RS-485 Bus Monitor Capture Ring
+ *
+ * With the bus monitor on, the NSP handler hands every decoded SLIP frame
+ * on the bus to this ring, whatever its destination: requests for other
+ * nodes, replies from real wheels on the same bus, malformed frames and
+ * (in CAPTURE mode) the emulator's own replies. Each record carries a
+ * µs timestamp and a CRC verdict. The USB stream pump batches the records
+ * into capture frames on the telemetry port (drivers/usb_stream.h), which
+ * tools/telemetry_stream.py --pcap turns into a pcap file.
+ *
+ * The ring is a byte FIFO of variable-length records (8-byte timestamp,
+ * flags, verdict, length, frame bytes), so short polls take little room:
+ * BUS_MON_RING_SIZE holds ~170 ms of back-to-back traffic at 460.8 kbps,
+ * far more than the 1 ms between USB pumps. The NSP service is the only
+ * writer and the USB pump the only reader; a full ring drops the record
+ * and counts it, and never stalls the NSP service.
+ */
+
+#ifndef BUS_MON_H
+#define BUS_MON_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** Capture ring size in bytes (power of 2) */
+#ifndef BUS_MON_RING_SIZE
+#define BUS_MON_RING_SIZE   8192
+#endif
+
+/** Longest frame kept per record (NSP_MAX_PACKET_SIZE; longer ones truncated) */
+#define BUS_MON_SNAPLEN     260
+
+/** Record header bytes in the ring and on the wire */
+#define BUS_MON_RECORD_HEADER 12
+
+/**
+ * @brief Monitor modes
+ */
+typedef enum {
+    BUS_MON_OFF = 0,            // Normal operation, nothing captured
+    BUS_MON_CAPTURE = 1,        // Capture everything, keep answering our addresses
+    BUS_MON_PASSIVE = 2,        // Capture everything, execute and answer nothing
+    BUS_MON_MODE_COUNT
+} bus_mon_mode_t;
+
+/** Record flags */
+#define BUS_MON_F_TX        0x01    // Our own reply (not received)
+#define BUS_MON_F_OURS      0x02    // Addressed to this emulator
+#define BUS_MON_F_TRUNC     0x04    // Frame longer than BUS_MON_SNAPLEN
+#define BUS_MON_F_STAMP_EST 0x08    // Timestamp is the service time, not the END arrival
+
+/**
+ * @brief Frame verdicts
+ */
+typedef enum {
+    BUS_MON_OK = 0,             // SLIP and CRC good
+    BUS_MON_TOO_SHORT,          // Fewer than NSP_MIN_PACKET_SIZE bytes
+    BUS_MON_TOO_LONG,           // More than NSP_MAX_PACKET_SIZE bytes
+    BUS_MON_BAD_CRC,            // CRC residue wrong
+    BUS_MON_SLIP_ERROR          // Invalid escape, frame discarded (no bytes kept)
+} bus_mon_verdict_t;
+
+/**
+ * @brief One captured frame (header of a ring record)
+ */
+typedef struct {
+    uint64_t timestamp_us;      // Frame END arrival (RX) or first start bit (TX)
+    uint8_t flags;              // BUS_MON_F_*
+    uint8_t verdict;            // bus_mon_verdict_t
+    uint16_t len;               // Frame bytes that follow
+} bus_mon_record_t;
+
+/**
+ * @brief Capture counters
+ */
+typedef struct {
+    uint32_t captured;          // Records written
+    uint32_t dropped;           // Records lost, ring full (USB not draining)
+    uint32_t sent;              // Records handed to USB
+    uint32_t high_water;        // Most ring bytes in use at once
+} bus_mon_stats_t;
+
+/**
+ * @brief Select the monitor mode (console)
+ *
+ * Switching mode discards records not yet sent.
+ *
+ * @param mode Mode
+ */
+void bus_mon_set_mode(bus_mon_mode_t mode);
+
+/**
+ * @brief Get the monitor mode
+ *
+ * @return Active mode
+ */
+bus_mon_mode_t bus_mon_get_mode(void);
+
+/**
+ * @brief Append a frame (NSP service only)
+ *
+ * @param timestamp_us Timestamp (µs since boot)
+ * @param flags BUS_MON_F_* (BUS_MON_F_TRUNC is added when len is cut)
+ * @param verdict bus_mon_verdict_t
+ * @param data Decoded frame bytes (may be NULL if len is 0)
+ * @param len Decoded length
+ * @return true if recorded, false if the monitor is off or the ring full
+ */
+bool bus_mon_capture(uint64_t timestamp_us, uint8_t flags, uint8_t verdict,
+                     const uint8_t* data, size_t len);
+
+/**
+ * @brief Look at the oldest record (USB pump only)
+ *
+ * @param record Output: header
+ * @return true if a record is waiting
+ */
+bool bus_mon_peek(bus_mon_record_t* record);
+
+/**
+ * @brief Copy the oldest record's frame bytes and release it (USB pump only)
+ *
+ * @param out Destination (record->len bytes, at most BUS_MON_SNAPLEN)
+ */
+void bus_mon_pop(uint8_t* out);
+
+/**
+ * @brief Discard every record not yet sent (USB pump only)
+ *
+ * Used while no host has the port open, so a capture picks up live traffic
+ * rather than a stale backlog.
+ */
+void bus_mon_flush(void);
+
+/**
+ * @brief Get capture counters
+ *
+ * @param stats Output: counters
+ */
+void bus_mon_get_stats(bus_mon_stats_t* stats);
+
+#endif // BUS_MON_H
@@ -8,40 +8,111 @@
 #include "pico/sync.h"
 #include "hardware/sync.h"
 #include <string.h>
+#include <stddef.h>
 
 // ============================================================================
 // Internal State
 // ============================================================================
 
-// Command mailbox (spinlock-protected)
-static spin_lock_t* command_spinlock = NULL;
-static command_mailbox_t command_mailbox;
-
-// Telemetry snapshot (spinlock-protected)
-static spin_lock_t* telemetry_spinlock = NULL;
-static telemetry_snapshot_t telemetry_snapshot;
-static volatile bool telemetry_valid = false;
+_Static_assert((CORE_SYNC_CMD_QUEUE_DEPTH & (CORE_SYNC_CMD_QUEUE_DEPTH - 1)) == 0,
+               "CORE_SYNC_CMD_QUEUE_DEPTH must be a power of 2");
+
+// Command queue (lock-free SPSC: Core0 produces, Core1 consumes).
+// Head/tail are free-running sequence numbers; slot = seq & (depth - 1).
+static command_mailbox_t command_queue[CORE_SYNC_CMD_QUEUE_DEPTH];
+static volatile uint32_t command_head = 0;   // Next seq to write (Core0 only)
+static volatile uint32_t command_tail = 0;   // Next seq to read (Core1 only)
+static volatile bool command_queue_ready = false;
+
+// Command queue statistics (Core0 only)
+static uint32_t command_sent_count = 0;
+static uint32_t command_dropped_count = 0;
+static uint32_t command_peak_depth = 0;
+
+// Receive time for the commands of the NSP frame being handled
+static volatile bool command_origin_valid = false;
+static volatile uint32_t command_origin_us = 0;
+
+// Telemetry snapshots, one seqlock per wheel (Core1 is the only writer and
+// never waits). Sequence is odd while a publish is in progress; 0 = nothing
+// published yet.
+static telemetry_snapshot_t telemetry_snapshot[EMULATED_WHEEL_COUNT];
+static volatile uint32_t telemetry_seq[EMULATED_WHEEL_COUNT];
+static volatile uint32_t telemetry_tick[EMULATED_WHEEL_COUNT];  // tick_count of published snapshot
+static volatile uint32_t telemetry_read_retries = 0;   // Core0: reads that raced a publish
+
+// Encoded telemetry blocks, double buffered per wheel. Core1 encodes into
+// buffer (gen + 1) & 1 while Core0 reads buffer gen & 1; gen counts publishes
+// (0 = none yet). A reader retries if gen moved during its copy, because
+// Core1 starts overwriting the old front buffer on the following tick.
+static telemetry_blocks_t telemetry_blocks[EMULATED_WHEEL_COUNT][2];
+static volatile uint32_t telemetry_blocks_gen[EMULATED_WHEEL_COUNT];
+
+// Live wheel state guard: odd while Core1 applies commands and steps the
+// physics (one sequence for the whole cluster, bumped twice per tick)
+static volatile uint32_t state_seq = 0;
+
+// Scenario physics overrides: Core0 writes under a sequence counter, Core1
+// copies once per tick. flags sits in the first word so an inactive block
+// costs Core1 one load and one compare.
+typedef struct {
+    physics_override_t ovr;
+    volatile uint32_t seq;
+} __attribute__((aligned(32))) override_block_t;
+
+static override_block_t override_block;
+
+// Parameter transactions: Core0 merges commits into the staging block and
+// publishes it (index, then generation) once Core1 has released the other
+// one; Core1 takes the published block and acknowledges its generation
+static param_block_t param_blocks[2];
+static uint8_t param_stage = 0;                 // Core0: block being filled
+static bool param_staged = false;               // Core0: staging block holds changes
+static volatile uint32_t param_pub_index = 0;   // Core0: block last published
+static volatile uint32_t param_pub_gen = 0;     // Core0: publishes so far
+static volatile uint32_t param_taken_gen = 0;   // Core1: publishes applied
+static uint32_t param_commit_count = 0;
+
+// Doorbell generations (each bell incremented on one core only)
+volatile uint32_t g_core_sync_bell_gen[CORE_SYNC_BELL_COUNT];
 
 // ============================================================================
 // Initialization
 // ============================================================================
 
 void core_sync_init(void) {
-    // Allocate spinlock for command mailbox
-    uint cmd_lock_num = spin_lock_claim_unused(true);
-    command_spinlock = spin_lock_init(cmd_lock_num);
-
-    // Initialize command mailbox to empty
-    memset(&command_mailbox, 0, sizeof(command_mailbox));
-    command_mailbox.type = CMD_NONE;
-
-    // Allocate spinlock for telemetry snapshot
-    uint telem_lock_num = spin_lock_claim_unused(true);
-    telemetry_spinlock = spin_lock_init(telem_lock_num);
-
-    // Initialize telemetry snapshot
-    memset(&telemetry_snapshot, 0, sizeof(telemetry_snapshot));
-    telemetry_valid = false;
+    // Initialize command queue to empty
+    memset(command_queue, 0, sizeof(command_queue));
+    command_head = 0;
+    command_tail = 0;
+    command_sent_count = 0;
+    command_dropped_count = 0;
+    command_peak_depth = 0;
+    command_origin_valid = false;
+    __dmb();
+    command_queue_ready = true;
+
+    // Initialize telemetry snapshots
+    memset(telemetry_snapshot, 0, sizeof(telemetry_snapshot));
+    for (uint32_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        telemetry_seq[w] = 0;
+        telemetry_tick[w] = 0;
+        telemetry_blocks_gen[w] = 0;
+    }
+    memset(telemetry_blocks, 0, sizeof(telemetry_blocks));
+    telemetry_read_retries = 0;
+    state_seq = 0;
+    memset(&override_block, 0, sizeof(override_block));
+    memset(param_blocks, 0, sizeof(param_blocks));
+    param_stage = 0;
+    param_staged = false;
+    param_pub_index = 0;
+    param_pub_gen = 0;
+    param_taken_gen = 0;
+    param_commit_count = 0;
+    for (uint32_t b = 0; b < CORE_SYNC_BELL_COUNT; b++) {
+        g_core_sync_bell_gen[b] = 0;
+    }
 }
 
 // ============================================================================
@@ -49,129 +120,502 @@ void core_sync_init(void) {
 // ============================================================================
 
 bool core_sync_send_command(command_type_t type, float param1, float param2) {
-    if (command_spinlock == NULL) {
+    return core_sync_send_wheel_command(0, type, param1, param2);
+}
+
+bool core_sync_send_wheel_command(uint8_t wheel, command_type_t type, float param1, float param2) {
+    command_mailbox_t cmd = { .type = type, .param1 = param1, .param2 = param2 };
+    return core_sync_send_wheel_commands(wheel, &cmd, 1);
+}
+
+bool core_sync_send_wheel_commands(uint8_t wheel, const command_mailbox_t* cmds, uint32_t count) {
+    if (!command_queue_ready) {
         return false;  // Not initialized
     }
+    if (wheel >= EMULATED_WHEEL_COUNT && wheel != CORE_SYNC_WHEEL_ALL) {
+        return false;  // No such wheel
+    }
 
-    uint32_t save = spin_lock_blocking(command_spinlock);
+    // Several Core0 contexts produce (NSP service IRQ, TUI, test modes);
+    // masking interrupts makes them a single producer as far as Core1 sees
+    uint32_t save = save_and_disable_interrupts();
 
-    // Check if previous command is still pending
-    if (command_mailbox.type != CMD_NONE) {
-        spin_unlock(command_spinlock, save);
-        return false;  // Mailbox full
+    uint32_t head = command_head;
+    uint32_t depth = head - command_tail;
+    if (count > CORE_SYNC_CMD_QUEUE_DEPTH - depth) {
+        command_dropped_count += count;
+        restore_interrupts(save);
+        return false;  // Queue full (nothing queued)
     }
 
-    // Write command to mailbox
-    command_mailbox.type = type;
-    command_mailbox.param1 = param1;
-    command_mailbox.param2 = param2;
-    command_mailbox.timestamp_us = (uint32_t)time_us_64();
+    // Fill the slots, then publish them together by advancing head
+    uint32_t timestamp_us = command_origin_valid ? command_origin_us : time_us_32();
+    for (uint32_t i = 0; i < count; i++) {
+        command_mailbox_t* slot = &command_queue[(head + i) & (CORE_SYNC_CMD_QUEUE_DEPTH - 1)];
+        slot->type = cmds[i].type;
+        slot->wheel = wheel;
+        slot->param1 = cmds[i].param1;
+        slot->param2 = cmds[i].param2;
+        slot->id = head + i + 1;
+        slot->timestamp_us = timestamp_us;
+    }
 
-    // Memory barrier to ensure visibility across cores
+    // Memory barrier: slot contents visible to Core1 before the new head
     __dmb();
+    command_head = head + count;
+
+    command_sent_count += count;
+    if (depth + count > command_peak_depth) {
+        command_peak_depth = depth + count;
+    }
 
-    spin_unlock(command_spinlock, save);
+    restore_interrupts(save);
     return true;
 }
 
-bool core_sync_send_command_blocking(command_type_t type, float param1, float param2, uint32_t timeout_us) {
-    if (command_spinlock == NULL) {
-        return false;  // Not initialized
+void core_sync_set_command_origin(uint32_t rx_us, bool valid) {
+    command_origin_us = rx_us;
+    command_origin_valid = valid;
+}
+
+bool core_sync_read_command(command_mailbox_t* cmd) {
+    if (!command_queue_ready || cmd == NULL) {
+        return false;
     }
 
-    // Use default timeout if 0 specified
-    if (timeout_us == 0) {
-        timeout_us = CORE_SYNC_CMD_TIMEOUT_US;
+    uint32_t tail = command_tail;
+    if (tail == command_head) {
+        return false;  // Queue empty
     }
 
-    uint64_t start_time = time_us_64();
-    uint64_t deadline = start_time + timeout_us;
+    // Memory barrier: read slot only after observing the head that published it
+    __dmb();
+    memcpy(cmd, &command_queue[tail & (CORE_SYNC_CMD_QUEUE_DEPTH - 1)], sizeof(command_mailbox_t));
 
-    while (time_us_64() < deadline) {
-        // Try to send command
-        if (core_sync_send_command(type, param1, param2)) {
-            return true;  // Success
-        }
+    // Memory barrier: slot fully read before handing it back to Core0
+    __dmb();
+    command_tail = tail + 1;
+    return true;
+}
+
+void core_sync_get_command_stats(uint32_t* sent, uint32_t* dropped, uint32_t* peak_depth) {
+    if (sent) *sent = command_sent_count;
+    if (dropped) *dropped = command_dropped_count;
+    if (peak_depth) *peak_depth = command_peak_depth;
+}
+
+// ============================================================================
+// Telemetry API (Core1 → Core0)
+// ============================================================================
+
+void core_sync_publish_telemetry(const telemetry_snapshot_t* snapshot) {
+    core_sync_publish_wheel_telemetry(0, snapshot);
+}
+
+void core_sync_publish_wheel_telemetry(uint8_t wheel, const telemetry_snapshot_t* snapshot) {
+    if (snapshot == NULL || wheel >= EMULATED_WHEEL_COUNT) {
+        return;
+    }
+
+    // Which doorbells this snapshot rings, against the previous one
+    // (mode..integrator_substeps and fault_status..lcl_tripped are 4-byte
+    // fields without padding)
+    uint32_t seq = telemetry_seq[wheel];
+    const uint8_t* next = (const uint8_t*)snapshot;
+    const uint8_t* prev = (const uint8_t*)&telemetry_snapshot[wheel];
+    size_t ctl_at = offsetof(telemetry_snapshot_t, mode);
+    size_t flt_at = offsetof(telemetry_snapshot_t, fault_status);
+    size_t flt_end = offsetof(telemetry_snapshot_t, lcl_tripped) + sizeof(snapshot->lcl_tripped);
+    bool control_changed = (seq == 0) ||
+                           memcmp(next + ctl_at, prev + ctl_at, flt_at - ctl_at) != 0;
+    bool fault_changed = (seq == 0) ||
+                         memcmp(next + flt_at, prev + flt_at, flt_end - flt_at) != 0;
+
+    // Odd sequence: readers that overlap this copy will retry
+    telemetry_seq[wheel] = seq + 1;
+    __dmb();
+
+    // Copy snapshot (Core1 writes, Core0 reads)
+    memcpy(&telemetry_snapshot[wheel], snapshot, sizeof(telemetry_snapshot_t));
+    telemetry_tick[wheel] = snapshot->tick_count;
+
+    // Memory barrier: contents visible before the sequence goes even again
+    __dmb();
+    telemetry_seq[wheel] = seq + 2;
 
-        // Mailbox full - wait a bit for Core1 to consume it
-        // Core1 runs at 100Hz (10ms period), so 1ms retry interval is reasonable
-        sleep_us(CORE_SYNC_CMD_RETRY_US);
+    if (control_changed) {
+        core_sync_ring(CORE_SYNC_BELL_CONTROL);
     }
+    if (fault_changed) {
+        core_sync_ring(CORE_SYNC_BELL_FAULT);
+    }
+    core_sync_ring(CORE_SYNC_BELL_SNAPSHOT);
+}
 
-    // Timeout expired
-    return false;
+/**
+ * @brief Count a read that raced Core1 and retried
+ *
+ * Readers run in several Core0 contexts (NSP service IRQ, TUI loop), so the
+ * increment is made with interrupts masked, like the command queue counters.
+ * Retries are rare: the mask costs nothing on the normal path.
+ */
+static void count_read_retry(void) {
+    uint32_t save = save_and_disable_interrupts();
+    telemetry_read_retries = telemetry_read_retries + 1;
+    restore_interrupts(save);
 }
 
-bool core_sync_read_command(command_mailbox_t* cmd) {
-    if (command_spinlock == NULL || cmd == NULL) {
+bool core_sync_read_telemetry(telemetry_snapshot_t* snapshot) {
+    return core_sync_read_wheel_telemetry(0, snapshot);
+}
+
+bool core_sync_read_wheel_telemetry(uint8_t wheel, telemetry_snapshot_t* snapshot) {
+    if (snapshot == NULL || wheel >= EMULATED_WHEEL_COUNT) {
         return false;
     }
 
-    uint32_t save = spin_lock_blocking(command_spinlock);
+    while (true) {
+        uint32_t seq = telemetry_seq[wheel];
+        if (seq == 0) {
+            return false;  // Nothing published yet
+        }
+        if (seq & 1u) {
+            // Core1 is mid-publish (well under a microsecond)
+            tight_loop_contents();
+            continue;
+        }
+
+        // Memory barrier: read contents only after observing an even sequence
+        __dmb();
+        memcpy(snapshot, &telemetry_snapshot[wheel], sizeof(telemetry_snapshot_t));
+        __dmb();
 
-    // Check if command is pending
-    if (command_mailbox.type == CMD_NONE) {
-        spin_unlock(command_spinlock, save);
-        return false;  // No command pending
+        if (telemetry_seq[wheel] == seq) {
+            return true;  // Consistent copy
+        }
+        count_read_retry();
     }
+}
 
-    // Copy command to output
-    memcpy(cmd, &command_mailbox, sizeof(command_mailbox_t));
+bool core_sync_read_telemetry_newer(uint32_t last_tick, telemetry_snapshot_t* snapshot) {
+    if (telemetry_seq[0] == 0 || telemetry_tick[0] == last_tick) {
+        return false;  // Nothing (new) published - skip the copy
+    }
+    return core_sync_read_telemetry(snapshot);
+}
 
-    // Clear mailbox
-    command_mailbox.type = CMD_NONE;
+uint32_t core_sync_telemetry_tick(void) {
+    return telemetry_tick[0];
+}
 
-    // Memory barrier
-    __dmb();
+uint32_t core_sync_telemetry_available(void) {
+    return (telemetry_seq[0] != 0) ? 1 : 0;
+}
 
-    spin_unlock(command_spinlock, save);
-    return true;
+uint32_t core_sync_telemetry_read_retries(void) {
+    return telemetry_read_retries;
 }
 
 // ============================================================================
-// Telemetry API (Core1 → Core0)
+// Encoded Telemetry Block API (Core1 → Core0)
 // ============================================================================
 
-void core_sync_publish_telemetry(const telemetry_snapshot_t* snapshot) {
-    if (telemetry_spinlock == NULL || snapshot == NULL) {
+telemetry_blocks_t* core_sync_wheel_blocks_back(uint8_t wheel) {
+    if (wheel >= EMULATED_WHEEL_COUNT) {
+        return NULL;
+    }
+    return &telemetry_blocks[wheel][(telemetry_blocks_gen[wheel] + 1) & 1u];
+}
+
+void core_sync_publish_wheel_blocks(uint8_t wheel) {
+    if (wheel >= EMULATED_WHEEL_COUNT) {
         return;
     }
 
-    uint32_t save = spin_lock_blocking(telemetry_spinlock);
+    // Memory barrier: encoded bytes visible before the buffer becomes front
+    __dmb();
+    telemetry_blocks_gen[wheel] = telemetry_blocks_gen[wheel] + 1;
+}
 
-    // Copy snapshot (Core1 writes, Core0 reads)
-    memcpy(&telemetry_snapshot, snapshot, sizeof(telemetry_snapshot_t));
-    telemetry_valid = true;
+uint32_t core_sync_wheel_blocks_gen(uint8_t wheel) {
+    if (wheel >= EMULATED_WHEEL_COUNT) {
+        return 0;
+    }
+    return telemetry_blocks_gen[wheel];
+}
 
-    // Memory barrier
-    __dmb();
+bool core_sync_read_wheel_block(uint8_t wheel, uint8_t block_id, uint8_t* out,
+                                uint16_t capacity, uint16_t* len, uint32_t* gen) {
+    if (wheel >= EMULATED_WHEEL_COUNT || block_id >= TELEM_BLOCK_COUNT ||
+        out == NULL || len == NULL) {
+        return false;
+    }
 
-    spin_unlock(telemetry_spinlock, save);
+    while (true) {
+        uint32_t g = telemetry_blocks_gen[wheel];
+        if (g == 0) {
+            return false;  // Nothing published yet
+        }
+
+        // Memory barrier: read the buffer only after observing the generation
+        __dmb();
+        const telemetry_blocks_t* front = &telemetry_blocks[wheel][g & 1u];
+        uint16_t n = front->len[block_id];
+        bool ok = (n != 0 && n <= capacity);
+        if (ok) {
+            memcpy(out, front->data[block_id], n);
+        }
+        __dmb();
+
+        if (telemetry_blocks_gen[wheel] == g) {
+            if (!ok) {
+                return false;  // Block failed to encode or does not fit
+            }
+            *len = n;
+            if (gen) *gen = g;
+            return true;  // Consistent copy
+        }
+        count_read_retry();
+    }
 }
 
-bool core_sync_read_telemetry(telemetry_snapshot_t* snapshot) {
-    if (telemetry_spinlock == NULL || snapshot == NULL) {
+bool core_sync_read_wheel_blocks(uint8_t wheel, telemetry_blocks_t* out, uint32_t* gen) {
+    if (wheel >= EMULATED_WHEEL_COUNT || out == NULL) {
         return false;
     }
 
-    uint32_t save = spin_lock_blocking(telemetry_spinlock);
+    while (true) {
+        uint32_t g = telemetry_blocks_gen[wheel];
+        if (g == 0) {
+            return false;  // Nothing published yet
+        }
+
+        // Memory barrier: read the buffer only after observing the generation
+        __dmb();
+        memcpy(out, &telemetry_blocks[wheel][g & 1u], sizeof(*out));
+        __dmb();
 
-    // Check if telemetry is valid
-    if (!telemetry_valid) {
-        spin_unlock(telemetry_spinlock, save);
+        if (telemetry_blocks_gen[wheel] == g) {
+            if (gen) *gen = g;
+            return true;  // Consistent copy
+        }
+        count_read_retry();
+    }
+}
+
+// ============================================================================
+// Live Wheel State Guard (Core1 → Core0)
+// ============================================================================
+
+void core_sync_state_write_begin(void) {
+    state_seq = state_seq + 1;
+    // Memory barrier: odd sequence visible before the state changes
+    __dmb();
+}
+
+void core_sync_state_write_end(void) {
+    // Memory barrier: state changes visible before the sequence goes even
+    __dmb();
+    state_seq = state_seq + 1;
+}
+
+void core_sync_copy_wheel_state(const wheel_state_t* live, wheel_state_t* copy) {
+    while (true) {
+        uint32_t seq = state_seq;
+        if (seq & 1u) {
+            tight_loop_contents();  // Core1 mid-tick (tens of µs)
+            continue;
+        }
+
+        // Memory barrier: read the state only after observing an even sequence
+        __dmb();
+        memcpy(copy, live, sizeof(*copy));
+        __dmb();
+
+        if (state_seq == seq) {
+            return;  // Consistent copy
+        }
+        count_read_retry();
+    }
+}
+
+// ============================================================================
+// Physics Override Block (Core0 → Core1)
+// ============================================================================
+
+void core_sync_publish_physics_override(const physics_override_t* ovr) {
+    uint32_t seq = override_block.seq;
+    override_block.seq = seq + 1;
+    // Memory barrier: odd sequence visible before the block changes
+    __dmb();
+    if (ovr != NULL) {
+        override_block.ovr = *ovr;
+    } else {
+        memset(&override_block.ovr, 0, sizeof(override_block.ovr));
+    }
+    // Memory barrier: block visible before the sequence goes even
+    __dmb();
+    override_block.seq = seq + 2;
+}
+
+bool __not_in_flash_func(core_sync_read_physics_override)(physics_override_t* ovr) {
+    // Fast path: nothing injected
+    if (*(volatile uint32_t*)&override_block.ovr.flags == 0) {
         return false;
     }
 
-    // Copy snapshot (Core0 reads, Core1 writes)
-    memcpy(snapshot, &telemetry_snapshot, sizeof(telemetry_snapshot_t));
+    while (true) {
+        uint32_t seq = override_block.seq;
+        if (seq & 1u) {
+            tight_loop_contents();  // Core0 mid-publish (a few stores)
+            continue;
+        }
+
+        // Memory barrier: read the block only after observing an even sequence
+        __dmb();
+        *ovr = override_block.ovr;
+        __dmb();
 
-    // Memory barrier
+        if (override_block.seq == seq) {
+            return ovr->flags != 0;
+        }
+    }
+}
+
+// ============================================================================
+// Parameter Transactions (Core0 → Core1)
+// ============================================================================
+
+/**
+ * @brief Merge a transaction into a staged wheel entry (later values win)
+ */
+static void merge_params(wheel_params_t* dst, const wheel_params_t* src) {
+    for (uint8_t p = 0; p < PROT_PARAM_COUNT; p++) {
+        if (src->set & PARAM_SET_THRESHOLD(p)) {
+            dst->threshold[p] = src->threshold[p];
+        }
+    }
+    if (src->set & PARAM_SET_ENABLE) {
+        dst->protection_enable = src->protection_enable;
+    }
+    if (src->set & PARAM_SET_PI_KP) {
+        dst->pi_kp = src->pi_kp;
+    }
+    if (src->set & PARAM_SET_PI_KI) {
+        dst->pi_ki = src->pi_ki;
+    }
+    if (src->set & PARAM_SET_PI_I_MAX) {
+        dst->pi_i_max_a = src->pi_i_max_a;
+    }
+    dst->set |= src->set;
+}
+
+/**
+ * @brief Publish the staging block if Core1 is done with the last one
+ *
+ * Call with interrupts disabled.
+ */
+static void flush_params(void) {
+    if (!param_staged || param_taken_gen != param_pub_gen) {
+        return;  // Nothing staged, or Core1 has yet to take the published block
+    }
+
+    // Index first, then the generation Core1 polls
+    param_pub_index = param_stage;
     __dmb();
+    param_pub_gen = param_pub_gen + 1;
 
-    spin_unlock(telemetry_spinlock, save);
+    // Core1 released the other block before acknowledging its generation
+    param_stage ^= 1u;
+    memset(&param_blocks[param_stage], 0, sizeof(param_block_t));
+    param_staged = false;
+}
+
+bool core_sync_params_commit(uint8_t wheel, const wheel_params_t* txn) {
+    if (txn == NULL || (wheel >= EMULATED_WHEEL_COUNT && wheel != CORE_SYNC_WHEEL_ALL)) {
+        return false;
+    }
+    if (txn->set == 0) {
+        return true;
+    }
+
+    uint8_t first = (wheel == CORE_SYNC_WHEEL_ALL) ? 0 : wheel;
+    uint8_t last = (wheel == CORE_SYNC_WHEEL_ALL) ? (EMULATED_WHEEL_COUNT - 1) : wheel;
+
+    uint32_t save = save_and_disable_interrupts();
+    param_block_t* block = &param_blocks[param_stage];
+    for (uint8_t w = first; w <= last; w++) {
+        merge_params(&block->wheel[w], txn);
+    }
+    param_staged = true;
+    param_commit_count++;
+    flush_params();
+    restore_interrupts(save);
     return true;
 }
 
-uint32_t core_sync_telemetry_available(void) {
-    return telemetry_valid ? 1 : 0;
+void core_sync_params_poll(void) {
+    if (!param_staged) {
+        return;
+    }
+    uint32_t save = save_and_disable_interrupts();
+    flush_params();
+    restore_interrupts(save);
+}
+
+bool core_sync_params_pending(void) {
+    return param_staged || param_taken_gen != param_pub_gen;
+}
+
+const param_block_t* __not_in_flash_func(core_sync_params_acquire)(void) {
+    if (param_pub_gen == param_taken_gen) {
+        return NULL;
+    }
+
+    // Memory barrier: read the index and block after the generation
+    __dmb();
+    return &param_blocks[param_pub_index];
+}
+
+void __not_in_flash_func(core_sync_params_release)(void) {
+    // Memory barrier: done with the block before Core0 may clear it
+    __dmb();
+    param_taken_gen = param_pub_gen;
+}
+
+void core_sync_get_param_stats(uint32_t* commits, uint32_t* swaps) {
+    if (commits) *commits = param_commit_count;
+    if (swaps) *swaps = param_taken_gen;
+}
+
+// ============================================================================
+// Doorbells
+// ============================================================================
+
+bool core_sync_doorbell_take(core_sync_doorbell_t* db, uint32_t bells, uint32_t max_age_us) {
+    if (db == NULL) {
+        return true;
+    }
+
+    bool rung = !db->started;
+    for (uint32_t b = 0; b < CORE_SYNC_BELL_COUNT; b++) {
+        if ((bells & CORE_SYNC_BELL(b)) == 0) {
+            continue;
+        }
+        uint32_t gen = g_core_sync_bell_gen[b];
+        if (gen != db->seen[b]) {
+            db->seen[b] = gen;
+            rung = true;
+        }
+    }
+
+    uint32_t now = time_us_32();
+    if (!rung && max_age_us != 0 && (now - db->last_us) >= max_age_us) {
+        rung = true;
+    }
+    if (rung) {
+        db->started = true;
+        db->last_us = now;
+    }
+    return rung;
 }
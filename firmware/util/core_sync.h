@@ -5,13 +5,22 @@
  * Provides safe communication between Core0 (communications) and Core1 (physics).
  *
  * Architecture:
- * - Core0 → Core1: Command mailbox (spinlock-protected)
- * - Core1 → Core0: Telemetry ring buffer (lock-free SPSC)
+ * - Core0 → Core1: Command queue (lock-free SPSC ring, CORE_SYNC_CMD_QUEUE_DEPTH)
+ * - Core1 → Core0: Telemetry snapshot per wheel (seqlock, writer never waits)
+ * - Core1 → Core0: ICD-encoded telemetry blocks per wheel (double buffer)
+ * - Core0 → Core1: Parameter transactions (double-buffered block, swapped in
+ *   at the start of a tick)
+ * - Either way: doorbells (per-event generation counters) that tell the
+ *   Core0 table updates when their inputs changed
+ *
+ * Commands and snapshots carry a wheel index (0..EMULATED_WHEEL_COUNT-1).
+ * The un-suffixed API addresses wheel 0, which is the only wheel in a
+ * single-wheel build.
  *
  * Usage:
  * 1. Call core_sync_init() during startup (before launching Core1)
  * 2. Core0: Use core_sync_send_command() to send commands
- * 3. Core1: Use core_sync_read_command() to read commands
+ * 3. Core1: Drain core_sync_read_command() until it returns false, each tick
  * 4. Core1: Use core_sync_publish_telemetry() to publish state
  * 5. Core0: Use core_sync_read_telemetry() to read telemetry
  */
@@ -22,6 +31,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "nss_nrwa_t6_model.h"
+#include "nss_nrwa_t6_telemetry.h"
+#include "nss_nrwa_t6_protection.h"
 
 // ============================================================================
 // Command Mailbox (Core0 → Core1)
@@ -40,17 +51,39 @@ typedef enum {
     CMD_CLEAR_FAULT,        // Clear latched faults
     CMD_RESET,              // Soft reset
     CMD_TRIP_LCL,           // Test LCL trip (ICD TRIP-LCL command)
-    CMD_CONFIG_PROTECTION,  // Configure protection enable mask (ICD CONFIGURE-PROTECTION)
+    CMD_CONFIG_PROTECTION,  // Configure protection enable mask (ICD CONFIGURE-PROTECTION, POKE)
+    CMD_SET_INTEGRATOR,     // Select dynamics integrator (param1 = mode, param2 = substeps)
+    CMD_TEST_SEQ_START,     // Start test-mode sequence (param1 = list bits, param2 = settle ticks)
+    CMD_TEST_SEQ_STOP,      // Stop test-mode sequence, wheel back to idle
+    CMD_INJECT_FAULT,       // Latch fault bits (scenario device layer; param1 = mask encoded as float)
+    CMD_TYPE_COUNT          // Number of command types
 } command_type_t;
 
 /**
- * @brief Command mailbox structure (spinlock-protected)
+ * @brief Command queue depth (power of 2)
+ *
+ * Comfortably more than the commands one NSP burst can produce within a
+ * single 10 ms physics tick.
+ */
+#define CORE_SYNC_CMD_QUEUE_DEPTH  16
+
+/**
+ * @brief Wheel index that applies a command to every emulated wheel
+ *
+ * Used for NSP broadcast frames.
+ */
+#define CORE_SYNC_WHEEL_ALL        0xFF
+
+/**
+ * @brief Command queue entry
  */
 typedef struct {
     command_type_t type;    // Command type
+    uint8_t wheel;          // Target wheel index (or CORE_SYNC_WHEEL_ALL)
     float param1;           // Primary parameter (mode, speed, current, etc.)
     float param2;           // Secondary parameter (reserved)
-    uint32_t timestamp_us;  // Command timestamp (for diagnostics)
+    uint32_t id;            // Sequence number (1 = first command since boot)
+    uint32_t timestamp_us;  // Receive time: NSP frame END (see core_sync_set_command_origin), else queue time
 } command_mailbox_t;
 
 // ============================================================================
@@ -61,9 +94,11 @@ typedef struct {
  * @brief Telemetry snapshot structure
  *
  * Simplified state snapshot for display in TUI and NSP telemetry.
- * Published by Core1 at 100 Hz, read by Core0 as needed.
+ * Published by Core1 every physics tick (one per wheel), read by Core0 as needed.
  */
 typedef struct {
+    uint8_t wheel;              // Wheel index this snapshot belongs to
+
     // Dynamic state
     float omega_rad_s;          // Angular velocity (rad/s)
     float speed_rpm;            // Speed in RPM
@@ -79,6 +114,16 @@ typedef struct {
     control_mode_t mode;        // Active control mode
     direction_t direction;      // Rotation direction
 
+    // Setpoints (what APP-CMD last commanded, as the telemetry blocks report it)
+    float current_cmd_a;        // Commanded current (A)
+    float speed_cmd_rpm;        // Commanded speed (RPM)
+    float torque_cmd_mnm;       // Commanded torque (mN·m)
+    float pwm_duty_pct;         // Commanded PWM duty cycle (%)
+
+    // Integrator
+    integrator_mode_t integrator;       // Active dynamics integrator
+    uint32_t integrator_substeps;       // Inner steps per tick
+
     // Protection status
     uint32_t fault_status;      // Active faults (bitmask)
     uint32_t fault_latch;       // Latched faults (bitmask)
@@ -89,11 +134,32 @@ typedef struct {
     uint32_t tick_count;        // Physics tick counter
     uint32_t jitter_us;         // Last tick jitter (µs)
     uint32_t max_jitter_us;     // Maximum jitter observed (µs)
+    uint32_t physics_us;        // wheel_model_tick() time for all wheels this tick (µs)
+    uint32_t serialize_us;      // Telemetry block encoding time, all wheels, previous tick (µs)
+    uint32_t busy_us;           // Core1 time awake (not in WFE), previous tick (µs)
+    uint32_t load_permille;     // Core1 busy time / tick period over the last second (‰)
+
+    // Last command applied to this wheel (0 until the first)
+    uint32_t cmd_id;            // command_mailbox_t.id
+    uint32_t cmd_tick;          // Engine tick that applied it
+    uint32_t cmd_apply_us;      // time_us_32() at the start of that tick
+    uint32_t cmd_latency_us;    // Receive time to cmd_apply_us (µs)
 
     // Timestamp
     uint64_t timestamp_us;      // Snapshot timestamp
 } telemetry_snapshot_t;
 
+/**
+ * @brief ICD-encoded telemetry blocks for one wheel
+ *
+ * Built by Core1 from the live wheel state right after the snapshot is
+ * published, so Core0 only copies bytes on the APP-TELEM request path.
+ */
+typedef struct {
+    uint16_t len[TELEM_BLOCK_COUNT];                        // Encoded length (0 = build failed)
+    uint8_t data[TELEM_BLOCK_COUNT][TELEM_MAX_BLOCK_SIZE];  // Encoded blocks (block ID = index)
+} telemetry_blocks_t;
+
 // ============================================================================
 // Initialization & Management
 // ============================================================================
@@ -102,7 +168,7 @@ typedef struct {
  * @brief Initialize inter-core synchronization
  *
  * Call this once during startup, before launching Core1.
- * Initializes spinlock and ring buffer.
+ * Resets the command queue and telemetry seqlock.
  */
 void core_sync_init(void);
 
@@ -113,48 +179,78 @@ void core_sync_init(void);
 /**
  * @brief Send command from Core0 to Core1 (non-blocking)
  *
- * Writes command to mailbox (spinlock-protected). Returns false if
- * previous command is still pending.
+ * Appends the command to the queue and returns immediately. Core1 applies
+ * queued commands in order at the start of its next tick. Safe to call from
+ * Core0 thread or IRQ context (the producer side is serialized with
+ * interrupts masked for a few instructions); not callable from Core1.
  *
  * @param type Command type
  * @param param1 Primary parameter (mode, speed, current, etc.)
  * @param param2 Secondary parameter (reserved)
- * @return true if command was sent, false if mailbox full
+ * @return true if command was queued, false if queue full
  */
 bool core_sync_send_command(command_type_t type, float param1, float param2);
 
-/** Default timeout for command retry (50ms = 5 physics ticks at 100Hz) */
-#define CORE_SYNC_CMD_TIMEOUT_US  50000
+/**
+ * @brief Send command to a specific wheel (non-blocking)
+ *
+ * Same as core_sync_send_command(), for wheel clusters.
+ *
+ * @param wheel Wheel index (0..EMULATED_WHEEL_COUNT-1) or CORE_SYNC_WHEEL_ALL
+ * @param type Command type
+ * @param param1 Primary parameter
+ * @param param2 Secondary parameter
+ * @return true if command was queued, false if queue full or wheel invalid
+ */
+bool core_sync_send_wheel_command(uint8_t wheel, command_type_t type, float param1, float param2);
 
-/** Retry interval between attempts (1ms) */
-#define CORE_SYNC_CMD_RETRY_US    1000
+/**
+ * @brief Send several commands to a wheel, all or none (non-blocking)
+ *
+ * Queues every command in order under one interrupt mask, so Core1 applies
+ * them in the same tick, or queues nothing if the queue has fewer than
+ * `count` free slots (all of them count as dropped).
+ *
+ * @param wheel Wheel index (0..EMULATED_WHEEL_COUNT-1) or CORE_SYNC_WHEEL_ALL
+ * @param cmds Commands (only type, param1 and param2 are used)
+ * @param count Number of commands (1..CORE_SYNC_CMD_QUEUE_DEPTH)
+ * @return true if all commands were queued, false if none was
+ */
+bool core_sync_send_wheel_commands(uint8_t wheel, const command_mailbox_t* cmds, uint32_t count);
 
 /**
- * @brief Send command from Core0 to Core1 with retry/wait
+ * @brief Stamp the commands queued from now on with a receive time
  *
- * Attempts to send command to mailbox, retrying with small delays if
- * the mailbox is full. This allows Core1 time to consume the previous
- * command. Use this when command delivery is critical.
+ * Core0 NSP service: call with the frame's SLIP END time before its
+ * handler runs and with valid = false after it, so the command latency
+ * Core1 measures starts on the wire. Commands queued outside (console,
+ * test modes) are stamped with their queue time.
  *
- * @param type Command type
- * @param param1 Primary parameter (mode, speed, current, etc.)
- * @param param2 Secondary parameter (reserved)
- * @param timeout_us Maximum time to wait for mailbox (0 = use default 50ms)
- * @return true if command was sent, false if timeout expired
+ * @param rx_us time_us_32() of the frame END
+ * @param valid false to go back to queue-time stamps
  */
-bool core_sync_send_command_blocking(command_type_t type, float param1, float param2, uint32_t timeout_us);
+void core_sync_set_command_origin(uint32_t rx_us, bool valid);
 
 /**
  * @brief Read command from Core1 (called by Core1 physics loop)
  *
- * Reads and clears pending command from mailbox (spinlock-protected).
- * Returns CMD_NONE if no command pending.
+ * Pops the oldest queued command (lock-free). Call in a loop until it
+ * returns false to drain everything queued since the last tick.
  *
- * @param cmd Pointer to command mailbox structure (output)
+ * @param cmd Pointer to command queue entry (output)
  * @return true if command was read, false if no command pending
  */
 bool core_sync_read_command(command_mailbox_t* cmd);
 
+/**
+ * @brief Get command queue statistics
+ *
+ * @param sent Output: commands queued since init (can be NULL)
+ * @param dropped Output: commands rejected because the queue was full (can be NULL)
+ * @param peak_depth Output: highest queue occupancy seen (can be NULL)
+ */
+void core_sync_get_command_stats(uint32_t* sent, uint32_t* dropped, uint32_t* peak_depth);
+
 // ============================================================================
 // Telemetry API (Core1 → Core0)
 // ============================================================================
@@ -162,29 +258,332 @@ bool core_sync_read_command(command_mailbox_t* cmd);
 /**
  * @brief Publish telemetry snapshot from Core1
  *
- * Writes telemetry snapshot to ring buffer (lock-free).
- * Called by Core1 physics loop after each tick.
+ * Writes telemetry snapshot under a sequence counter (lock-free, never
+ * blocks, never masks interrupts). Called by Core1 physics loop after each
+ * tick. Single writer: Core1 only.
  *
  * @param snapshot Pointer to telemetry snapshot
  */
 void core_sync_publish_telemetry(const telemetry_snapshot_t* snapshot);
 
+/**
+ * @brief Publish telemetry snapshot for one wheel from Core1
+ *
+ * @param wheel Wheel index (0..EMULATED_WHEEL_COUNT-1)
+ * @param snapshot Pointer to telemetry snapshot
+ */
+void core_sync_publish_wheel_telemetry(uint8_t wheel, const telemetry_snapshot_t* snapshot);
+
 /**
  * @brief Read latest telemetry snapshot from Core0
  *
- * Reads most recent telemetry snapshot from ring buffer (lock-free).
- * Returns false if no new data available.
+ * Copies the most recent snapshot, retrying if Core1 published during the
+ * copy (lock-free, interrupts stay enabled). Returns false only if nothing
+ * has been published yet.
  *
  * @param snapshot Pointer to telemetry snapshot (output)
- * @return true if new data was read, false if no new data
+ * @return true if a snapshot was read, false if none published yet
  */
 bool core_sync_read_telemetry(telemetry_snapshot_t* snapshot);
 
+/**
+ * @brief Read latest telemetry snapshot for one wheel from Core0
+ *
+ * @param wheel Wheel index (0..EMULATED_WHEEL_COUNT-1)
+ * @param snapshot Pointer to telemetry snapshot (output)
+ * @return true if a snapshot was read, false if none published yet or wheel invalid
+ */
+bool core_sync_read_wheel_telemetry(uint8_t wheel, telemetry_snapshot_t* snapshot);
+
+/**
+ * @brief Read telemetry snapshot only if it differs from tick N
+ *
+ * Cheap check against the published tick_count; the snapshot is copied
+ * only when Core1 has published since the caller's last read.
+ *
+ * @param last_tick tick_count of the snapshot the caller already holds
+ * @param snapshot Pointer to telemetry snapshot (output)
+ * @return true if a newer snapshot was read, false if unchanged or none yet
+ */
+bool core_sync_read_telemetry_newer(uint32_t last_tick, telemetry_snapshot_t* snapshot);
+
+/**
+ * @brief Get tick_count of the most recently published snapshot
+ *
+ * @return Published tick_count (0 before first publish)
+ */
+uint32_t core_sync_telemetry_tick(void);
+
+/**
+ * @brief Get number of telemetry reads that raced a publish and retried
+ *
+ * @return Retry count since init
+ */
+uint32_t core_sync_telemetry_read_retries(void);
+
 /**
  * @brief Get number of telemetry snapshots available
  *
- * @return Number of snapshots in ring buffer
+ * @return 1 once a snapshot has been published, 0 before
  */
 uint32_t core_sync_telemetry_available(void);
 
+// ============================================================================
+// Encoded Telemetry Block API (Core1 → Core0)
+// ============================================================================
+
+/**
+ * @brief Get the buffer Core1 encodes the next block set into
+ *
+ * Core1 only. The returned buffer is not visible to readers until
+ * core_sync_publish_wheel_blocks() is called.
+ *
+ * @param wheel Wheel index (0..EMULATED_WHEEL_COUNT-1)
+ * @return Back buffer, or NULL for an invalid wheel
+ */
+telemetry_blocks_t* core_sync_wheel_blocks_back(uint8_t wheel);
+
+/**
+ * @brief Make the back buffer the one Core0 reads (Core1 only)
+ *
+ * @param wheel Wheel index (0..EMULATED_WHEEL_COUNT-1)
+ */
+void core_sync_publish_wheel_blocks(uint8_t wheel);
+
+/**
+ * @brief Get the generation of one wheel's published blocks
+ *
+ * Incremented on every publish and never repeats (unlike tick_count, which
+ * restarts on CMD_RESET), so it is a safe cache key for the encoded bytes.
+ *
+ * @param wheel Wheel index (0..EMULATED_WHEEL_COUNT-1)
+ * @return Generation (0 before first publish or for an invalid wheel)
+ */
+uint32_t core_sync_wheel_blocks_gen(uint8_t wheel);
+
+/**
+ * @brief Copy one encoded block from Core0
+ *
+ * Lock-free: retries if Core1 published during the copy.
+ *
+ * @param wheel Wheel index (0..EMULATED_WHEEL_COUNT-1)
+ * @param block_id Telemetry block ID (0..TELEM_BLOCK_COUNT-1)
+ * @param out Output buffer
+ * @param capacity Output buffer size (TELEM_MAX_BLOCK_SIZE is always enough)
+ * @param len Output: block length
+ * @param gen Output: generation the copied bytes belong to (can be NULL)
+ * @return true if copied, false if nothing published yet, bad arguments,
+ *         or the block failed to encode
+ */
+bool core_sync_read_wheel_block(uint8_t wheel, uint8_t block_id, uint8_t* out,
+                                uint16_t capacity, uint16_t* len, uint32_t* gen);
+
+/**
+ * @brief Copy one wheel's whole published block set from Core0
+ *
+ * Lock-free like core_sync_read_wheel_block(), but every block in the copy
+ * comes from the same publish, i.e. the same physics tick.
+ *
+ * @param wheel Wheel index (0..EMULATED_WHEEL_COUNT-1)
+ * @param out Output: block set (len[] is 0 for blocks that failed to encode)
+ * @param gen Output: generation the copied bytes belong to (can be NULL)
+ * @return true if copied, false if nothing published yet or bad arguments
+ */
+bool core_sync_read_wheel_blocks(uint8_t wheel, telemetry_blocks_t* out, uint32_t* gen);
+
+// ============================================================================
+// Live Wheel State Guard (Core1 → Core0)
+// ============================================================================
+
+/**
+ * @brief Mark the start of Core1's per-tick wheel state update
+ *
+ * Core1 only. Brackets command application and the physics step so Core0
+ * can take a copy of a wheel state that belongs to a single tick.
+ */
+void core_sync_state_write_begin(void);
+
+/**
+ * @brief Mark the end of Core1's per-tick wheel state update (Core1 only)
+ */
+void core_sync_state_write_end(void);
+
+/**
+ * @brief Copy a live wheel state from Core0 between two Core1 updates
+ *
+ * Lock-free: waits out an update in progress and retries if one started
+ * during the copy. States Core1 does not drive copy on the first pass.
+ *
+ * @param live Wheel state owned by Core1
+ * @param copy Output: consistent copy
+ */
+void core_sync_copy_wheel_state(const wheel_state_t* live, wheel_state_t* copy);
+
+// ============================================================================
+// Physics Override Block (Core0 → Core1)
+// ============================================================================
+
+/**
+ * @brief Publish scenario physics overrides
+ *
+ * Core0 only (scenario engine; call with interrupts disabled if more than
+ * one Core0 context publishes). Takes effect on Core1's next tick.
+ *
+ * @param ovr Overrides to apply, or NULL to clear all
+ */
+void core_sync_publish_physics_override(const physics_override_t* ovr);
+
+/**
+ * @brief Take a consistent copy of the physics overrides
+ *
+ * Core1 only, once per tick. Costs one load and one compare while no
+ * override is active; never takes a spinlock.
+ *
+ * @param ovr Output: overrides (written only when active)
+ * @return true if any override is active
+ */
+bool core_sync_read_physics_override(physics_override_t* ovr);
+
+// ============================================================================
+// Parameter Transactions (Core0 → Core1)
+// ============================================================================
+
+/** wheel_params_t.set bits */
+#define PARAM_SET_THRESHOLD(p)      (1u << (p))     // p = protection_param_t
+#define PARAM_SET_ENABLE            (1u << PROT_PARAM_COUNT)
+#define PARAM_SET_PI_KP             (1u << (PROT_PARAM_COUNT + 1))
+#define PARAM_SET_PI_KI             (1u << (PROT_PARAM_COUNT + 2))
+#define PARAM_SET_PI_I_MAX          (1u << (PROT_PARAM_COUNT + 3))
+
+/**
+ * @brief Coupled wheel parameters changed together (only the set bits apply)
+ */
+typedef struct {
+    uint32_t set;                           // PARAM_SET_* of the values below
+    uint32_t protection_enable;             // PROT_ENABLE_* mask
+    float threshold[PROT_PARAM_COUNT];      // protection_set_threshold() units
+    float pi_kp;
+    float pi_ki;
+    float pi_i_max_a;                       // Speed loop integral limit (A)
+} wheel_params_t;
+
+/**
+ * @brief One transaction for the cluster, as Core1 swaps it in
+ */
+typedef struct {
+    wheel_params_t wheel[EMULATED_WHEEL_COUNT];
+} param_block_t;
+
+/**
+ * @brief Commit a set of parameter changes to a wheel (or all)
+ *
+ * Core0 (main loop or IRQ). Build txn on the caller's side, then commit
+ * it in one call: Core1 applies every value in it at the start of one
+ * tick, after that tick's queued commands, so no tick runs with half the
+ * set. Commits that land before Core1 took the previous one merge into
+ * the next block (later values win) and go out on the following commit
+ * or core_sync_params_poll().
+ *
+ * @param wheel Wheel index, or CORE_SYNC_WHEEL_ALL
+ * @param txn Changes (txn->set selects the values)
+ * @return true if staged (false for an unknown wheel)
+ */
+bool core_sync_params_commit(uint8_t wheel, const wheel_params_t* txn);
+
+/**
+ * @brief Publish a transaction held back by a busy block (Core0 main loop)
+ */
+void core_sync_params_poll(void);
+
+/**
+ * @brief Check if a committed transaction has yet to reach the wheels (Core0)
+ */
+bool core_sync_params_pending(void);
+
+/**
+ * @brief Take the transaction committed since the last tick
+ *
+ * Core1 only, once per tick. One load and one compare when there is none.
+ * The block stays Core1's until core_sync_params_release().
+ *
+ * @return Block to apply, or NULL
+ */
+const param_block_t* core_sync_params_acquire(void);
+
+/**
+ * @brief Hand the acquired block back to Core0 (Core1, after applying it)
+ */
+void core_sync_params_release(void);
+
+/**
+ * @brief Get parameter transaction statistics
+ *
+ * @param commits Output: transactions committed by Core0 (can be NULL)
+ * @param swaps Output: blocks swapped in by Core1 (can be NULL)
+ */
+void core_sync_get_param_stats(uint32_t* commits, uint32_t* swaps);
+
+// ============================================================================
+// Doorbells (change notifications for Core0 consumers)
+// ============================================================================
+
+/**
+ * @brief Events a producer signals when the data behind it changed
+ *
+ * Each bell is a generation counter incremented by its producer, so any
+ * number of consumers can tell "changed since I last looked" without
+ * clearing anything. Every bell has its writers on one core (Core1 for
+ * SNAPSHOT, CONTROL and FAULT; Core0 for the rest), so the increment needs
+ * no atomics on the M0+: two Core0 IRQs racing may lose one increment, but
+ * the count still moves, which is all a consumer looks at.
+ */
+typedef enum {
+    CORE_SYNC_BELL_SNAPSHOT = 0,    // Core1 published a telemetry snapshot
+    CORE_SYNC_BELL_CONTROL,         // Mode, setpoints or integrator changed
+    CORE_SYNC_BELL_FAULT,           // Fault, latch, warning or LCL state changed
+    CORE_SYNC_BELL_BUS,             // NSP bytes handled or a reply sent
+    CORE_SYNC_BELL_SCENARIO,        // Scenario loaded, started, stopped or fired
+    CORE_SYNC_BELL_CONFIG,          // Table field written from the console
+    CORE_SYNC_BELL_COUNT
+} core_sync_bell_t;
+
+/** Mask bit of a bell, for core_sync_doorbell_take() */
+#define CORE_SYNC_BELL(b)           (1u << (b))
+
+/** Refresh period of consumers whose values also age (windowed rates, uptime) */
+#define CORE_SYNC_DOORBELL_AGE_US   500000u
+
+/** Bell generations (use core_sync_ring / core_sync_doorbell_take) */
+extern volatile uint32_t g_core_sync_bell_gen[CORE_SYNC_BELL_COUNT];
+
+/**
+ * @brief Ring a bell (one increment; IRQ-safe on the bell's own core)
+ */
+static inline void core_sync_ring(core_sync_bell_t bell) {
+    g_core_sync_bell_gen[bell]++;
+}
+
+/**
+ * @brief Per-consumer doorbell state (zero-initialize; one per consumer)
+ */
+typedef struct {
+    uint32_t seen[CORE_SYNC_BELL_COUNT];    // Generations at the last take
+    bool started;                           // Took at least once
+    uint32_t last_us;                       // time_us_32() of the last take
+} core_sync_doorbell_t;
+
+/**
+ * @brief Check whether a consumer has work, and mark it seen
+ *
+ * Core0 only. True on the first call, when any bell in the mask rang since
+ * the last true return, or when max_age_us has passed since then (for
+ * consumers whose data also change with time, e.g. windowed rates).
+ *
+ * @param db Consumer state
+ * @param bells CORE_SYNC_BELL() mask of the consumer's inputs
+ * @param max_age_us Longest time between runs (0 = bells only)
+ * @return true if the consumer should run now
+ */
+bool core_sync_doorbell_take(core_sync_doorbell_t* db, uint32_t bells, uint32_t max_age_us);
+
 #endif // CORE_SYNC_H
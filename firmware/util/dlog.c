@@ -0,0 +1,189 @@
+/**
+ * @file dlog.c
+ * @brief Deferred Binary Log Implementation
+ */
+
+#include "dlog.h"
+#include "hot_path.h"
+#include "hardware/sync.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include <stdio.h>
+
+#define DLOG_MASK   (DLOG_RING_DEPTH - 1u)
+#define DLOG_CORES  2
+
+_Static_assert((DLOG_RING_DEPTH & DLOG_MASK) == 0, "log ring depth must be a power of 2");
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+typedef struct {
+    const char* fmt;
+    uint32_t timestamp_us;
+    uint32_t args[DLOG_MAX_ARGS];
+} dlog_record_t;
+
+/**
+ * One ring per core: writers on a core are serialized by masking
+ * interrupts, the Core0 main loop is the only reader of both
+ */
+typedef struct {
+    dlog_record_t records[DLOG_RING_DEPTH];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t written;
+    volatile uint32_t dropped;
+} dlog_ring_t;
+
+static dlog_ring_t rings[DLOG_CORES];
+static uint32_t dropped_reported = 0;           // Reader only
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+void HOT_PATH_FUNC(dlog_write)(const char* fmt, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+    dlog_ring_t* ring = &rings[get_core_num() & 1u];
+    uint32_t now = time_us_32();
+
+    uint32_t save = save_and_disable_interrupts();
+    uint32_t head = ring->head;
+    if (head - ring->tail >= DLOG_RING_DEPTH) {
+        ring->dropped++;
+        restore_interrupts(save);
+        return;
+    }
+    dlog_record_t* r = &ring->records[head & DLOG_MASK];
+    r->fmt = fmt;
+    r->timestamp_us = now;
+    r->args[0] = a0;
+    r->args[1] = a1;
+    r->args[2] = a2;
+    r->args[3] = a3;
+    __dmb();    // Record complete before the index that publishes it
+    ring->head = head + 1;
+    ring->written++;
+    restore_interrupts(save);
+}
+
+// ============================================================================
+// Formatting (Core0 main loop)
+// ============================================================================
+
+/**
+ * @brief printf() one record, one conversion at a time
+ *
+ * Each conversion takes the next argument word, typed by its conversion
+ * character; length modifiers are dropped since every word is 32 bits.
+ */
+static void dlog_print(const dlog_record_t* r) {
+    char line[160];
+    size_t used = 0;
+    uint32_t arg = 0;
+    const char* p = r->fmt;
+
+    while (*p != '\0' && used + 1 < sizeof(line)) {
+        if (*p != '%') {
+            line[used++] = *p++;
+            continue;
+        }
+
+        // Collect flags, width and precision; skip length modifiers
+        char spec[16];
+        size_t n = 0;
+        spec[n++] = *p++;
+        while (*p != '\0' && strchr("-+ #0123456789.hlzjLqt", *p) != NULL) {
+            if (strchr("hlzjLqt", *p) == NULL && n < sizeof(spec) - 2) {
+                spec[n++] = *p;
+            }
+            p++;
+        }
+        char conv = *p;
+        if (conv == '\0') {
+            break;
+        }
+        p++;
+        spec[n++] = conv;
+        spec[n] = '\0';
+
+        size_t room = sizeof(line) - used;
+        uint32_t word = (arg < DLOG_MAX_ARGS) ? r->args[arg] : 0;
+        int written;
+        switch (conv) {
+            case '%':
+                written = snprintf(&line[used], room, "%%");
+                break;
+            case 'd': case 'i':
+                written = snprintf(&line[used], room, spec, (int)(int32_t)word);
+                arg++;
+                break;
+            case 'u': case 'x': case 'X': case 'o': case 'c':
+                written = snprintf(&line[used], room, spec, (unsigned)word);
+                arg++;
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+                float f;
+                memcpy(&f, &word, sizeof(f));
+                written = snprintf(&line[used], room, spec, (double)f);
+                arg++;
+                break;
+            }
+            default:
+                written = snprintf(&line[used], room, "?");   // %s, %p, ...: not stored
+                arg++;
+                break;
+        }
+        if (written < 0) {
+            break;
+        }
+        used += ((size_t)written < room) ? (size_t)written : room - 1;
+    }
+    line[used] = '\0';
+    fputs(line, stdout);
+}
+
+uint32_t dlog_drain(uint32_t max_records) {
+    uint32_t printed = 0;
+
+    uint32_t dropped = rings[0].dropped + rings[1].dropped;
+    if (dropped != dropped_reported) {
+        printf("[DLOG] %lu log records dropped (ring full)\n",
+               (unsigned long)(dropped - dropped_reported));
+        dropped_reported = dropped;
+    }
+
+    while (printed < max_records) {
+        // Oldest waiting record of either core
+        dlog_ring_t* pick = NULL;
+        for (uint32_t c = 0; c < DLOG_CORES; c++) {
+            dlog_ring_t* ring = &rings[c];
+            if (ring->tail == ring->head) {
+                continue;
+            }
+            __dmb();    // Read the record after seeing the index that published it
+            if (pick == NULL ||
+                (int32_t)(ring->records[ring->tail & DLOG_MASK].timestamp_us -
+                          pick->records[pick->tail & DLOG_MASK].timestamp_us) < 0) {
+                pick = ring;
+            }
+        }
+        if (pick == NULL) {
+            break;
+        }
+
+        dlog_record_t r = pick->records[pick->tail & DLOG_MASK];
+        __dmb();    // Done reading before the slot is handed back
+        pick->tail++;
+
+        dlog_print(&r);
+        printed++;
+    }
+    return printed;
+}
+
+void dlog_get_stats(uint32_t* written, uint32_t* dropped) {
+    if (written) *written = rings[0].written + rings[1].written;
+    if (dropped) *dropped = rings[0].dropped + rings[1].dropped;
+}
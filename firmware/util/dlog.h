@@ -0,0 +1,86 @@
+/**
+ * @file dlog.h
+ * @brief Deferred Binary Log
+ *
+ * printf() on the NSP service IRQ or the Core1 tick costs milliseconds of
+ * USB stdio and, on Core1, contends with Core0 for the stdio lock. DLOG()
+ * instead stores a 24-byte record (format string pointer, timestamp, up to
+ * four 32-bit arguments) in a ring for the calling core, and the Core0 main
+ * loop formats and prints the records when it has time (dlog_drain()).
+ *
+ *   DLOG("[WHEEL] Mode change: %d → %d\n", old_mode, mode);
+ *   DLOG("[PROTECTION] Overvoltage threshold updated: %.1f V\n", dlog_f32(v));
+ *
+ * The format must be a string literal (only its address is stored).
+ * Arguments are passed as 32-bit words: integers as they are, floats
+ * through dlog_f32(). %s is not supported. A write masks interrupts on the
+ * calling core for the ~20-cycle copy, so any ISR or thread on that core
+ * may log; a full ring drops the record and counts it.
+ */
+
+#ifndef DLOG_H
+#define DLOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/** Records buffered per core (power of 2, 24 B each) */
+#ifndef DLOG_RING_DEPTH
+#define DLOG_RING_DEPTH     64
+#endif
+
+/** Arguments per record */
+#define DLOG_MAX_ARGS       4
+
+/** Records printed per dlog_drain() call from the main loop */
+#define DLOG_DRAIN_BATCH    8
+
+/**
+ * @brief Pass a float argument (matches %f, %e, %g)
+ */
+static inline uint32_t dlog_f32(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+/**
+ * @brief Append a record for the calling core (use the DLOG() macro)
+ *
+ * @param fmt printf format (string literal)
+ * @param a0 .. a3 Arguments as 32-bit words (unused ones 0)
+ */
+void dlog_write(const char* fmt, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+
+#define DLOG_0_(fmt)                dlog_write((fmt), 0, 0, 0, 0)
+#define DLOG_1_(fmt, a)             dlog_write((fmt), (uint32_t)(a), 0, 0, 0)
+#define DLOG_2_(fmt, a, b)          dlog_write((fmt), (uint32_t)(a), (uint32_t)(b), 0, 0)
+#define DLOG_3_(fmt, a, b, c)       dlog_write((fmt), (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), 0)
+#define DLOG_4_(fmt, a, b, c, d)    dlog_write((fmt), (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), \
+                                               (uint32_t)(d))
+#define DLOG_PICK_(_0, _1, _2, _3, _4, name, ...) name
+
+/** Log from any context: DLOG(fmt, up to four 32-bit arguments) */
+#define DLOG(...) DLOG_PICK_(__VA_ARGS__, DLOG_4_, DLOG_3_, DLOG_2_, DLOG_1_, DLOG_0_, unused)(__VA_ARGS__)
+
+/**
+ * @brief Print up to max_records waiting records, oldest first (Core0 thread mode)
+ *
+ * Records from both cores are merged by timestamp. A drop since the last
+ * call is reported in a line of its own.
+ *
+ * @param max_records Records to print at most
+ * @return Records printed
+ */
+uint32_t dlog_drain(uint32_t max_records);
+
+/**
+ * @brief Get log counters
+ *
+ * @param written Records stored (both cores)
+ * @param dropped Records lost because a ring was full
+ */
+void dlog_get_stats(uint32_t* written, uint32_t* dropped);
+
+#endif // DLOG_H
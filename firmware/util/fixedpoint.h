@@ -58,6 +58,9 @@ typedef uint32_t q10_22_t;
 /** @brief Q16.16 (signed): 16 integer bits (signed), 16 fractional bits (for 30V current in A per ICD) */
 typedef int32_t q16_16_t;
 
+/** @brief Q8.24 (signed): 8 integer bits (signed), 24 fractional bits (for physics kernel coefficients) */
+typedef int32_t q8_24_t;
+
 // ============================================================================
 // Format Constants
 // ============================================================================
@@ -125,6 +128,29 @@ typedef int32_t q16_16_t;
 #define Q16_16_MAX          INT32_MAX                   // Signed 32-bit max
 #define Q16_16_MIN          INT32_MIN                   // Signed 32-bit min
 
+// Q8.24 (Signed, physics kernel coefficients)
+#define Q8_24_FRAC_BITS     24
+#define Q8_24_INT_BITS      8
+#define Q8_24_ONE           (1 << Q8_24_FRAC_BITS)     // 16777216
+
+/**
+ * @brief Compile-time constant conversions (rounded to nearest)
+ *
+ * For coefficients folded from float constants; the argument must be a
+ * constant expression in range so the compiler evaluates it entirely.
+ */
+#define Q16_16_CONST(x)     ((q16_16_t)((double)(x) * (double)Q16_16_ONE + ((x) >= 0 ? 0.5 : -0.5)))
+#define Q8_24_CONST(x)      ((q8_24_t)((double)(x) * (double)Q8_24_ONE + ((x) >= 0 ? 0.5 : -0.5)))
+
+/**
+ * @brief Compile-time range checks for the conversions above
+ *
+ * For _Static_assert next to folded coefficients whose value depends on
+ * the build (tick rate, wheel profile): Q16.16 holds ±32768, Q8.24 ±128.
+ */
+#define Q16_16_CONST_FITS(x) ((double)(x) > -32768.0 && (double)(x) < 32768.0 - 1.0 / Q16_16_ONE)
+#define Q8_24_CONST_FITS(x)  ((double)(x) > -128.0 && (double)(x) < 128.0 - 1.0 / Q8_24_ONE)
+
 // ============================================================================
 // Conversion Functions: Float ↔ Fixed-Point
 // ============================================================================
@@ -520,6 +546,71 @@ static inline uq18_14_t uq18_14_mul(uq18_14_t a, uq18_14_t b) {
     return (uq18_14_t)result;
 }
 
+// ============================================================================
+// Arithmetic Operations: Q16.16 (Signed, Physics Kernel)
+// ============================================================================
+
+/**
+ * @brief Saturate a 64-bit intermediate to the Q16.16 range
+ */
+static inline q16_16_t q16_16_sat64(int64_t x) {
+    if (x > (int64_t)Q16_16_MAX) {
+        return Q16_16_MAX;
+    }
+    if (x < (int64_t)Q16_16_MIN) {
+        return Q16_16_MIN;
+    }
+    return (q16_16_t)x;
+}
+
+/**
+ * @brief Add two Q16.16 values with saturation
+ *
+ * @param a First operand
+ * @param b Second operand
+ * @return Sum, saturated to Q16_16_MIN/MAX
+ */
+static inline q16_16_t q16_16_add(q16_16_t a, q16_16_t b) {
+    return q16_16_sat64((int64_t)a + (int64_t)b);
+}
+
+/**
+ * @brief Multiply two Q16.16 values (rounded to nearest)
+ *
+ * @param a First operand
+ * @param b Second operand
+ * @return Product, saturated to Q16_16_MIN/MAX
+ */
+static inline q16_16_t q16_16_mul(q16_16_t a, q16_16_t b) {
+    int64_t product = (int64_t)a * (int64_t)b;
+    return q16_16_sat64((product + (1 << (Q16_16_FRAC_BITS - 1))) >> Q16_16_FRAC_BITS);
+}
+
+/**
+ * @brief Scale a Q16.16 value by a Q8.24 coefficient (rounded to nearest)
+ *
+ * The extra fractional bits keep small folded coefficients (e.g. a·Δt/I)
+ * accurate to better than 1e-4 relative.
+ *
+ * @param a Q16.16 operand
+ * @param k Q8.24 coefficient
+ * @return Product in Q16.16, saturated to Q16_16_MIN/MAX
+ */
+static inline q16_16_t q16_16_mul_q8_24(q16_16_t a, q8_24_t k) {
+    int64_t product = (int64_t)a * (int64_t)k;
+    return q16_16_sat64((product + (1 << (Q8_24_FRAC_BITS - 1))) >> Q8_24_FRAC_BITS);
+}
+
+/**
+ * @brief Absolute value of a Q16.16 value (saturates Q16_16_MIN)
+ */
+static inline q16_16_t q16_16_abs(q16_16_t x) {
+    if (x < 0) {
+        return (x == Q16_16_MIN) ? Q16_16_MAX : -x;
+    }
+    return x;
+}
+
 // ============================================================================
 // Utility Functions
 // ============================================================================
@@ -0,0 +1,366 @@
+/**
+ * @file flash_store.c
+ * @brief Flash Erase/Program Service Implementation
+ */
+
+#include "flash_store.h"
+#include "pico/stdlib.h"
+#include "pico/platform.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "timebase.h"
+#include <string.h>
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+// Core1 park handshake: Core0 bumps park_req, Core1 copies it to park_ack
+// and spins until park_release catches up
+static volatile uint32_t park_req = 0;
+static volatile uint32_t park_ack = 0;
+static volatile uint32_t park_release = 0;
+static volatile bool core1_attached = false;
+
+// Tick lateness watch (Core1 records while a write runs and just after it)
+static volatile bool write_active = false;
+static volatile uint32_t watch_until_tick = 0;
+static volatile uint32_t core1_max_jitter_us = 0;
+
+static flash_store_stats_t stats;
+
+_Static_assert(FLASH_STORE_PAGE_SIZE == FLASH_PAGE_SIZE, "flash page size mismatch");
+
+/** How long Core0 waits for Core1 to park (Core1 polls between ticks) */
+#define PARK_TIMEOUT_US         50000u
+
+/** Core1 is released this long before its next tick (suspend latency, wake-up) */
+#define SLICE_GUARD_US          300u
+
+/** Shortest slice worth a park; with less slack Core0 waits for the next tick */
+#define SLICE_MIN_US            1000u
+
+/** Slice length when no tick is scheduled (stepped mode) */
+#define SLICE_UNSCHEDULED_US    5000u
+
+/** Attempts to find a slice of at least SLICE_MIN_US before one unbounded slice */
+#define SLICE_ATTEMPTS          3u
+
+/** Time budgeted per page program (W25Q16JV: 0.4 ms typical) */
+#define PAGE_PROGRAM_BUDGET_US  800u
+
+// Flash commands (W25Q16JV on the Pico board)
+#define CMD_WRITE_ENABLE        0x06u
+#define CMD_READ_STATUS         0x05u
+#define CMD_SECTOR_ERASE        0x20u
+#define CMD_ERASE_SUSPEND       0x75u
+#define CMD_ERASE_RESUME        0x7Au
+#define STATUS_BUSY             0x01u
+
+/**
+ * @brief One Core1 park between two ticks
+ */
+typedef struct {
+    uint32_t req;               // Park request to release
+    uint32_t start_us;          // Park start
+    uint32_t end_us;            // Core1 must be released by then (if bounded)
+    bool bounded;               // false: run the flash operation to completion
+} slice_t;
+
+// ============================================================================
+// Core1 API
+// ============================================================================
+
+void __not_in_flash_func(flash_store_core1_poll)(void) {
+    core1_attached = true;
+
+    // Wake-up lateness of the tick just run, if a write overlapped it
+    if (write_active || (int32_t)(timebase_get_tick_count() - watch_until_tick) < 0) {
+        uint32_t late_us = timebase_get_last_wake_us();
+        if (late_us > core1_max_jitter_us) {
+            core1_max_jitter_us = late_us;
+        }
+    }
+
+    uint32_t req = park_req;
+    if (req == park_ack) {
+        return;
+    }
+
+    // From here until release nothing may be fetched from flash
+    uint32_t save = save_and_disable_interrupts();
+    park_ack = req;
+    __sev();
+    while (park_release != req) {
+        __wfe();
+    }
+    restore_interrupts(save);
+}
+
+// ============================================================================
+// Core1 Parking
+// ============================================================================
+
+/**
+ * @brief Ask Core1 to park in RAM and wait for it
+ *
+ * @return Request number to release, 0 if Core1 did not park in time
+ */
+static uint32_t park_core1(void) {
+    uint32_t req = park_req + 1;
+    park_req = req;
+    __sev();
+    uint64_t deadline = time_us_64() + PARK_TIMEOUT_US;
+    while (park_ack != req) {
+        if (time_us_64() > deadline) {
+            park_release = req;  // Withdraw: a late ack returns at once
+            __sev();
+            return 0;
+        }
+    }
+    return req;
+}
+
+static void release_core1(uint32_t req) {
+    park_release = req;
+    __sev();
+}
+
+/**
+ * @brief Wait until Core1 has run its next tick (bounded by PARK_TIMEOUT_US)
+ */
+static void wait_next_tick(void) {
+    uint32_t tick = timebase_get_tick_count();
+    uint64_t deadline = time_us_64() + PARK_TIMEOUT_US;
+    while (timebase_get_tick_count() == tick && time_us_64() < deadline) {
+        tight_loop_contents();
+    }
+}
+
+/**
+ * @brief Park Core1 for the slack before its next tick
+ *
+ * Core1 acknowledges from its idle loop, so a park usually starts right
+ * after a tick. If the slack left is too short the park is given back and
+ * retried after the next tick; after SLICE_ATTEMPTS the slice is unbounded.
+ */
+static bool slice_begin(slice_t* slice) {
+    for (uint32_t attempt = 0; ; attempt++) {
+        slice->req = park_core1();
+        if (slice->req == 0) {
+            return false;
+        }
+        slice->start_us = time_us_32();
+
+        uint32_t next_us;
+        if (!timebase_get_next_tick_us(&next_us)) {
+            slice->end_us = slice->start_us + SLICE_UNSCHEDULED_US;
+            slice->bounded = true;
+            break;
+        }
+        int32_t slack_us = (int32_t)(next_us - slice->start_us) - (int32_t)SLICE_GUARD_US;
+        if (slack_us >= (int32_t)SLICE_MIN_US) {
+            slice->end_us = slice->start_us + (uint32_t)slack_us;
+            slice->bounded = true;
+            break;
+        }
+        if (attempt + 1 >= SLICE_ATTEMPTS) {
+            slice->bounded = false;
+            break;
+        }
+        release_core1(slice->req);
+        wait_next_tick();
+    }
+    stats.slices++;
+    return true;
+}
+
+static void slice_end(const slice_t* slice) {
+    release_core1(slice->req);
+
+    uint32_t parked_us = time_us_32() - slice->start_us;
+    if (parked_us > stats.last_park_us) {
+        stats.last_park_us = parked_us;
+    }
+    if (parked_us > stats.max_park_us) {
+        stats.max_park_us = parked_us;
+    }
+}
+
+static void op_begin(void) {
+    stats.last_park_us = 0;
+    write_active = true;
+}
+
+static void op_end(bool ok) {
+    write_active = false;
+    watch_until_tick = timebase_get_tick_count() + 2u;  // The tick right after the last slice
+    if (ok) {
+        stats.writes++;
+    } else {
+        stats.failures++;
+    }
+}
+
+// ============================================================================
+// Flash Operations (Core1 parked)
+// ============================================================================
+
+static void __not_in_flash_func(flash_cmd)(uint8_t cmd) {
+    uint8_t tx[1];
+    tx[0] = cmd;
+    flash_do_cmd(tx, NULL, 1);
+}
+
+static bool __not_in_flash_func(flash_busy)(void) {
+    uint8_t tx[2];
+    uint8_t rx[2];
+    tx[0] = CMD_READ_STATUS;
+    tx[1] = 0;
+    flash_do_cmd(tx, rx, 2);
+    return (rx[1] & STATUS_BUSY) != 0;
+}
+
+/**
+ * @brief Run a sector erase until it finishes or the slice ends
+ *
+ * A running erase makes XIP reads invalid, so everything from the erase
+ * command to the suspend runs from RAM with interrupts off. A suspended
+ * erase leaves the rest of the flash readable until resumed.
+ *
+ * @return true if the erase completed, false if suspended
+ */
+static bool __not_in_flash_func(erase_slice)(uint32_t offset, bool resume, const slice_t* slice) {
+    uint32_t save = save_and_disable_interrupts();
+    if (resume) {
+        flash_cmd(CMD_ERASE_RESUME);
+    } else {
+        uint8_t tx[4];
+        tx[0] = CMD_SECTOR_ERASE;
+        tx[1] = (uint8_t)(offset >> 16);
+        tx[2] = (uint8_t)(offset >> 8);
+        tx[3] = (uint8_t)offset;
+        flash_cmd(CMD_WRITE_ENABLE);
+        flash_do_cmd(tx, NULL, 4);
+    }
+
+    bool done = false;
+    while (!(done = !flash_busy())) {
+        if (slice->bounded && (int32_t)(time_us_32() - slice->end_us) >= 0) {
+            break;
+        }
+    }
+    if (!done) {
+        flash_cmd(CMD_ERASE_SUSPEND);
+        while (flash_busy()) {
+            // Suspend latency (tSUS, 20 us)
+        }
+    }
+    restore_interrupts(save);
+    return done;
+}
+
+/**
+ * @brief Erase one sector in slices between physics ticks
+ */
+static bool erase_sector(uint32_t offset) {
+    bool resume = false;
+    bool done = false;
+    while (!done) {
+        slice_t slice;
+        if (!slice_begin(&slice)) {
+            if (!resume) {
+                return false;
+            }
+            // A suspended erase must be finished (nothing else may be
+            // erased or programmed meanwhile): retry until Core1 parks
+            continue;
+        }
+        done = erase_slice(offset, resume, &slice);
+        resume = true;
+        slice_end(&slice);
+    }
+    return true;
+}
+
+/**
+ * @brief Program pages in slices between physics ticks
+ */
+static bool program_pages(uint32_t offset, const uint8_t* data, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        slice_t slice;
+        if (!slice_begin(&slice)) {
+            return false;
+        }
+        uint32_t save = save_and_disable_interrupts();
+        do {
+            flash_range_program(offset + done, data + done, FLASH_PAGE_SIZE);
+            done += FLASH_PAGE_SIZE;
+        } while (done < len &&
+                 (!slice.bounded ||
+                  (int32_t)(slice.end_us - time_us_32()) >= (int32_t)PAGE_PROGRAM_BUDGET_US));
+        restore_interrupts(save);
+        slice_end(&slice);
+    }
+    return true;
+}
+
+// ============================================================================
+// Core0 API
+// ============================================================================
+
+bool flash_store_write(uint32_t offset, const void* data, size_t len) {
+    if ((offset % FLASH_STORE_SECTOR_SIZE) != 0 || (len > 0 && data == NULL) ||
+        !core1_attached) {
+        stats.failures++;
+        return false;
+    }
+
+    size_t erase_len = (len == 0) ? FLASH_STORE_SECTOR_SIZE :
+                       (len + FLASH_STORE_SECTOR_SIZE - 1) & ~(size_t)(FLASH_STORE_SECTOR_SIZE - 1);
+    size_t full_pages = len & ~(size_t)(FLASH_PAGE_SIZE - 1);
+    size_t tail = len - full_pages;
+
+    // Last partial page padded with erased-state bytes
+    uint8_t last_page[FLASH_PAGE_SIZE];
+    if (tail > 0) {
+        memset(last_page, 0xFF, sizeof(last_page));
+        memcpy(last_page, (const uint8_t*)data + full_pages, tail);
+    }
+
+    op_begin();
+    bool ok = true;
+    for (size_t s = 0; ok && s < erase_len; s += FLASH_STORE_SECTOR_SIZE) {
+        ok = erase_sector(offset + (uint32_t)s);
+    }
+    if (ok && full_pages > 0) {
+        ok = program_pages(offset, (const uint8_t*)data, full_pages);
+    }
+    if (ok && tail > 0) {
+        ok = program_pages(offset + (uint32_t)full_pages, last_page, FLASH_PAGE_SIZE);
+    }
+    op_end(ok);
+    return ok;
+}
+
+bool flash_store_program(uint32_t offset, const void* data, size_t len) {
+    if ((offset % FLASH_STORE_PAGE_SIZE) != 0 || (len % FLASH_STORE_PAGE_SIZE) != 0 ||
+        len == 0 || data == NULL || !core1_attached) {
+        stats.failures++;
+        return false;
+    }
+
+    op_begin();
+    bool ok = program_pages(offset, (const uint8_t*)data, len);
+    op_end(ok);
+    return ok;
+}
+
+void flash_store_get_stats(flash_store_stats_t* out) {
+    if (!out) {
+        return;
+    }
+    *out = stats;
+    out->max_jitter_us = core1_max_jitter_us;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file flash_store.h
+ * @brief Flash Erase/Program Service for Persistent Data
+ *
+ * Single path for every runtime flash write (scenario library, config
+ * store, ...). An erase or program takes the QSPI flash out of XIP mode,
+ * so nothing may execute from flash on either core while it runs:
+ *
+ * - Core0 runs the operation with interrupts disabled (the SDK flash
+ *   routines are RAM-resident).
+ * - Core1 polls flash_store_core1_poll() while it waits for its next
+ *   tick; on request it acknowledges and spins in RAM with interrupts
+ *   disabled until released.
+ *
+ * Operations are split into slices that fit the slack between two physics
+ * ticks: Core1 is parked right after a tick and released 300 us before
+ * the next one (timebase_get_next_tick_us()), so ticks stay on
+ * schedule. A page program fits a slice; a sector erase (45 ms typical)
+ * is suspended at the end of each slice and resumed after the tick (erase
+ * suspend, 75h/7Ah). If the slack is too short for a slice (high tick
+ * rates) an operation runs in one piece and its ticks are late. The worst
+ * tick lateness seen during writes is reported in the stats.
+ *
+ * Offsets are from the start of flash (not XIP_BASE) and must be
+ * sector-aligned (page-aligned for flash_store_program()). Source data
+ * must be in RAM.
+ */
+
+#ifndef FLASH_STORE_H
+#define FLASH_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** Erase unit (bytes) */
+#define FLASH_STORE_SECTOR_SIZE     4096u
+
+/** Program unit (bytes) */
+#define FLASH_STORE_PAGE_SIZE       256u
+
+/** Flash size covered by the store (host image size) */
+#define FLASH_STORE_FLASH_SIZE      (2u * 1024u * 1024u)
+
+/** XIP-mapped address of a flash offset (host build: the RAM image) */
+#ifdef NRWA_HOST
+extern uint8_t flash_store_host_image[FLASH_STORE_FLASH_SIZE];
+#define FLASH_STORE_XIP(offset)     ((const void*)(flash_store_host_image + (offset)))
+#else
+#define FLASH_STORE_XIP(offset)     ((const void*)(uintptr_t)(0x10000000u + (offset)))
+#endif
+
+/**
+ * @brief Flash write statistics
+ */
+typedef struct {
+    uint32_t writes;            // Successful operations
+    uint32_t failures;          // Rejected or Core1 did not park
+    uint32_t slices;            // Core1 parks (one per slice)
+    uint32_t last_park_us;      // Longest Core1 park of the last operation
+    uint32_t max_park_us;       // Longest Core1 park
+    uint32_t max_jitter_us;     // Worst tick lateness during a write
+} flash_store_stats_t;
+
+// ============================================================================
+// Core0 API
+// ============================================================================
+
+/**
+ * @brief Erase sectors and program data at their start
+ *
+ * Erases every sector spanned by len, then programs data (the last page
+ * is padded with 0xFF). len = 0 only erases one sector.
+ *
+ * @param offset Flash offset (sector-aligned)
+ * @param data Data to program (RAM, NULL if len = 0)
+ * @param len Bytes to program
+ * @return true on success, false if misaligned or Core1 did not park
+ */
+bool flash_store_write(uint32_t offset, const void* data, size_t len);
+
+/**
+ * @brief Program whole pages without erasing
+ *
+ * For append-only logs: programming can only clear bits, so 0xFF bytes
+ * leave already-programmed bytes of the page as they are.
+ *
+ * @param offset Flash offset (page-aligned)
+ * @param data Data to program (RAM)
+ * @param len Bytes to program (multiple of FLASH_STORE_PAGE_SIZE)
+ * @return true on success, false if misaligned or Core1 did not park
+ */
+bool flash_store_program(uint32_t offset, const void* data, size_t len);
+
+/**
+ * @brief Get flash write statistics
+ *
+ * @param stats Output: counters since boot
+ */
+void flash_store_get_stats(flash_store_stats_t* stats);
+
+// ============================================================================
+// Core1 API
+// ============================================================================
+
+/**
+ * @brief Park Core1 in RAM if Core0 is about to write flash
+ *
+ * Call from the Core1 idle loop before each WFE. Returns at once when no
+ * write is pending; the first call also tells Core0 that Core1 can be
+ * parked (until then writes are refused).
+ */
+void flash_store_core1_poll(void);
+
+#endif // FLASH_STORE_H
@@ -0,0 +1,191 @@
+/**
+ * @file flight_rec.c
+ * @brief Core1 Physics Flight Recorder Implementation
+ */
+
+#include "flight_rec.h"
+#include "config/scenario.h"
+#include "pico/platform.h"
+#include "hardware/sync.h"
+
+_Static_assert(sizeof(flight_rec_sample_t) == 16, "flight recorder sample must stay 16 bytes");
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+static flight_rec_sample_t rec_buf[FLIGHT_REC_TICKS][EMULATED_WHEEL_COUNT];
+
+// Core1 only
+static uint32_t rec_slot = 0;                   // Next tick slot to write
+static uint32_t rec_mask = FLIGHT_REC_TRIG_ALL;
+static uint32_t rec_post = FLIGHT_REC_TICKS / 4;
+static uint32_t rec_post_left = 0;
+static uint32_t prev_latch[EMULATED_WHEEL_COUNT];
+static bool prev_lcl[EMULATED_WHEEL_COUNT];
+static uint8_t prev_event = SCENARIO_NO_EVENT;
+static bool baseline_pending = true;            // Take prev_* from the next tick
+
+// Published by Core1 (stable once frozen)
+static volatile flight_rec_state_t rec_state = FLIGHT_REC_ARMED;
+static volatile uint32_t rec_filled = 0;        // Ticks in the buffer (saturates)
+static volatile uint8_t rec_cause = 0;
+static volatile uint8_t rec_wheel = 0;
+static volatile uint32_t rec_trigger_tick = 0;
+
+// Requests from Core0
+static volatile bool arm_pending = false;
+static volatile uint32_t arm_mask = FLIGHT_REC_TRIG_ALL;
+static volatile uint32_t arm_post = FLIGHT_REC_TICKS / 4;
+static volatile bool trigger_pending = false;
+
+// ============================================================================
+// Core1 API
+// ============================================================================
+
+static inline int16_t to_i16(float value, float scale) {
+    float x = value * scale;
+    if (x >= 32767.0f) {
+        return INT16_MAX;
+    }
+    if (x <= -32768.0f) {
+        return INT16_MIN;
+    }
+    return (int16_t)x;
+}
+
+void __not_in_flash_func(flight_rec_record)(const wheel_state_t* wheels, uint32_t tick) {
+    if (arm_pending) {
+        rec_mask = arm_mask;
+        rec_post = arm_post;
+        rec_slot = 0;
+        rec_filled = 0;
+        rec_cause = 0;
+        rec_wheel = 0;
+        trigger_pending = false;
+        baseline_pending = true;
+        rec_state = FLIGHT_REC_ARMED;
+        arm_pending = false;
+    }
+
+    if (rec_state == FLIGHT_REC_FROZEN) {
+        return;
+    }
+
+    flight_rec_sample_t* row = rec_buf[rec_slot];
+    uint8_t cause = 0;
+    uint8_t cause_wheel = 0;
+
+    for (uint32_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        const wheel_state_t* ws = &wheels[w];
+        flight_rec_sample_t* s = &row[w];
+
+        s->omega = to_i16(ws->omega_rad_s, FLIGHT_REC_OMEGA_SCALE);
+        s->current_cmd = to_i16(ws->current_cmd_a, FLIGHT_REC_CURRENT_SCALE);
+        s->current_out = to_i16(ws->current_out_a, FLIGHT_REC_CURRENT_SCALE);
+        s->torque = to_i16(ws->torque_out_mnm, FLIGHT_REC_TORQUE_SCALE);
+        s->power = to_i16(ws->power_w, FLIGHT_REC_POWER_SCALE);
+        s->fault_status = (uint16_t)ws->fault_status;
+        s->fault_latch = (uint16_t)ws->fault_latch;
+        s->warning_status = (uint8_t)ws->warning_status;
+        s->mode_flags = (uint8_t)(((uint32_t)ws->mode & FLIGHT_REC_MODE_MASK) |
+                                  (ws->lcl_tripped ? FLIGHT_REC_FLAG_LCL : 0u) |
+                                  (ws->direction == DIRECTION_NEGATIVE ? FLIGHT_REC_FLAG_NEGATIVE : 0u));
+
+        // Edge detection (first tick after arming only takes the baseline)
+        if (!baseline_pending) {
+            if (ws->fault_latch != prev_latch[w] && !(cause & FLIGHT_REC_TRIG_FAULT_LATCH)) {
+                cause |= FLIGHT_REC_TRIG_FAULT_LATCH;
+                cause_wheel = (uint8_t)w;
+            }
+            if (ws->lcl_tripped && !prev_lcl[w] && !(cause & FLIGHT_REC_TRIG_LCL)) {
+                cause |= FLIGHT_REC_TRIG_LCL;
+                cause_wheel = (uint8_t)w;
+            }
+        }
+        prev_latch[w] = ws->fault_latch;
+        prev_lcl[w] = ws->lcl_tripped;
+    }
+
+    uint8_t event = scenario_get_last_event();
+    if (!baseline_pending && event != prev_event && event != SCENARIO_NO_EVENT) {
+        cause |= FLIGHT_REC_TRIG_SCENARIO;
+    }
+    prev_event = event;
+    baseline_pending = false;
+
+    if (trigger_pending) {
+        cause |= FLIGHT_REC_TRIG_MANUAL;
+        trigger_pending = false;
+    }
+    cause &= (uint8_t)(rec_mask | FLIGHT_REC_TRIG_MANUAL);
+
+    if (++rec_slot == FLIGHT_REC_TICKS) {
+        rec_slot = 0;
+    }
+    if (rec_filled < FLIGHT_REC_TICKS) {
+        rec_filled = rec_filled + 1;
+    }
+
+    if (rec_state == FLIGHT_REC_ARMED) {
+        if (cause == 0) {
+            return;
+        }
+        rec_cause = cause;
+        rec_wheel = cause_wheel;
+        rec_trigger_tick = tick;
+        rec_post_left = rec_post;
+        rec_state = FLIGHT_REC_TRIGGERED;
+        if (rec_post_left > 0) {
+            return;
+        }
+    } else if (--rec_post_left > 0) {
+        return;
+    }
+
+    __dmb();    // Samples complete before Core0 sees the capture frozen
+    rec_state = FLIGHT_REC_FROZEN;
+}
+
+// ============================================================================
+// Core0 API
+// ============================================================================
+
+void flight_rec_arm(uint32_t trigger_mask, uint32_t post_ticks) {
+    arm_mask = trigger_mask & FLIGHT_REC_TRIG_ALL;
+    arm_post = (post_ticks < FLIGHT_REC_TICKS) ? post_ticks : FLIGHT_REC_TICKS - 1u;
+    __dmb();
+    arm_pending = true;
+}
+
+void flight_rec_trigger(void) {
+    trigger_pending = true;
+}
+
+void flight_rec_get_info(flight_rec_info_t* info) {
+    info->state = rec_state;
+    __dmb();
+    info->cause = rec_cause;
+    info->wheel = rec_wheel;
+    info->trigger_tick = rec_trigger_tick;
+    info->ticks = rec_filled;
+    info->pre_ticks = 0;
+    if (info->state == FLIGHT_REC_FROZEN) {
+        // Frozen exactly rec_post ticks after the trigger tick
+        info->pre_ticks = info->ticks - 1u - rec_post;
+    }
+}
+
+bool flight_rec_read(uint32_t tick_index, uint8_t wheel, flight_rec_sample_t* sample) {
+    if (rec_state != FLIGHT_REC_FROZEN || wheel >= EMULATED_WHEEL_COUNT ||
+        tick_index >= rec_filled) {
+        return false;
+    }
+    __dmb();
+
+    // A full buffer's oldest tick sits at the next write slot
+    uint32_t oldest = (rec_filled < FLIGHT_REC_TICKS) ? 0 : rec_slot;
+    uint32_t slot = (oldest + tick_index) % FLIGHT_REC_TICKS;
+    *sample = rec_buf[slot][wheel];
+    return true;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file flight_rec.h
+ * @brief Core1 Physics Flight Recorder (Pre/Post Trigger)
+ *
+ * Records a packed 16-byte sample of every wheel on every physics tick
+ * into a circular buffer. When a trigger fires (fault latch change, LCL
+ * trip, scenario event, or a console request) recording continues for
+ * post_ticks more ticks and then freezes, leaving the window around the
+ * trigger for download: FLIGHT_REC_TICKS - post_ticks ticks before it and
+ * post_ticks after.
+ *
+ * Core1 is the only writer and stops writing once frozen, so Core0 reads
+ * a frozen capture without further synchronization. Configuration and
+ * re-arming are requested by Core0 and applied by Core1 on its next tick.
+ *
+ * Cost: five saturating float-to-int16 conversions and a 16-byte store per
+ * wheel per tick, from SRAM (~2 µs per wheel at 125 MHz).
+ */
+
+#ifndef FLIGHT_REC_H
+#define FLIGHT_REC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "board_pico.h"
+#include "nss_nrwa_t6_model.h"
+
+/** Samples kept in total (all wheels), 16 B each */
+#ifndef FLIGHT_REC_SAMPLES
+#define FLIGHT_REC_SAMPLES      2048
+#endif
+
+/** Ticks kept (one sample per wheel per tick) */
+#define FLIGHT_REC_TICKS        (FLIGHT_REC_SAMPLES / EMULATED_WHEEL_COUNT)
+
+// Sample scaling (value = raw / scale)
+#define FLIGHT_REC_OMEGA_SCALE      32.0f       // 1/32 rad/s   (±1024 rad/s)
+#define FLIGHT_REC_CURRENT_SCALE    1000.0f     // mA           (±32.7 A)
+#define FLIGHT_REC_TORQUE_SCALE     100.0f      // 0.01 mN·m    (±327 mN·m)
+#define FLIGHT_REC_POWER_SCALE      100.0f      // 0.01 W       (±327 W)
+
+// mode_flags byte
+#define FLIGHT_REC_MODE_MASK        0x0Fu       // control_mode_t
+#define FLIGHT_REC_FLAG_LCL         0x10u       // LCL tripped
+#define FLIGHT_REC_FLAG_NEGATIVE    0x20u       // direction_t negative
+
+/**
+ * @brief One wheel on one tick (16 bytes, wire order of the download)
+ */
+typedef struct {
+    int16_t omega;              // ω × FLIGHT_REC_OMEGA_SCALE
+    int16_t current_cmd;        // Commanded current × FLIGHT_REC_CURRENT_SCALE
+    int16_t current_out;        // Actual current × FLIGHT_REC_CURRENT_SCALE
+    int16_t torque;             // Output torque × FLIGHT_REC_TORQUE_SCALE
+    int16_t power;              // Electrical power × FLIGHT_REC_POWER_SCALE
+    uint16_t fault_status;      // Active faults
+    uint16_t fault_latch;       // Latched faults
+    uint8_t warning_status;     // Active warnings
+    uint8_t mode_flags;         // Mode (low nibble) and FLIGHT_REC_FLAG_*
+} flight_rec_sample_t;
+
+/**
+ * @brief Trigger sources (bit mask)
+ */
+#define FLIGHT_REC_TRIG_FAULT_LATCH 0x01u   // Any wheel's fault_latch changed
+#define FLIGHT_REC_TRIG_LCL         0x02u   // Any wheel's LCL tripped
+#define FLIGHT_REC_TRIG_SCENARIO    0x04u   // A scenario event triggered
+#define FLIGHT_REC_TRIG_MANUAL      0x08u   // Requested from Core0
+#define FLIGHT_REC_TRIG_ALL         0x0Fu
+
+/**
+ * @brief Recorder state
+ */
+typedef enum {
+    FLIGHT_REC_ARMED = 0,       // Recording, waiting for a trigger
+    FLIGHT_REC_TRIGGERED,       // Recording the post-trigger window
+    FLIGHT_REC_FROZEN,          // Capture complete, ready to download
+} flight_rec_state_t;
+
+/**
+ * @brief Capture summary
+ */
+typedef struct {
+    flight_rec_state_t state;
+    uint8_t cause;              // FLIGHT_REC_TRIG_* that fired (0 while armed)
+    uint8_t wheel;              // Wheel that fired it (0 for scenario/manual)
+    uint32_t trigger_tick;      // Physics tick of the trigger
+    uint32_t ticks;             // Ticks in the capture (frozen: whole window)
+    uint32_t pre_ticks;         // Ticks before the trigger tick
+} flight_rec_info_t;
+
+// ============================================================================
+// Core1 API
+// ============================================================================
+
+/**
+ * @brief Record one tick of every wheel (call once per tick on Core1)
+ *
+ * Applies a pending arm/trigger request first; returns at once when frozen.
+ *
+ * @param wheels Wheel states (EMULATED_WHEEL_COUNT)
+ * @param tick Physics tick number
+ */
+void flight_rec_record(const wheel_state_t* wheels, uint32_t tick);
+
+// ============================================================================
+// Core0 API
+// ============================================================================
+
+/**
+ * @brief Clear and re-arm with new settings (applied on Core1's next tick)
+ *
+ * @param trigger_mask FLIGHT_REC_TRIG_* sources that fire (manual always does)
+ * @param post_ticks Ticks kept after the trigger (clamped to FLIGHT_REC_TICKS - 1)
+ */
+void flight_rec_arm(uint32_t trigger_mask, uint32_t post_ticks);
+
+/**
+ * @brief Fire the trigger now (applied on Core1's next tick)
+ */
+void flight_rec_trigger(void);
+
+/**
+ * @brief Get the capture summary
+ *
+ * @param info Output: state, cause and window
+ */
+void flight_rec_get_info(flight_rec_info_t* info);
+
+/**
+ * @brief Copy one sample of a frozen capture
+ *
+ * @param tick_index Tick within the capture (0 = oldest)
+ * @param wheel Wheel index
+ * @param sample Output: packed sample
+ * @return false if not frozen or out of range
+ */
+bool flight_rec_read(uint32_t tick_index, uint8_t wheel, flight_rec_sample_t* sample);
+
+#endif // FLIGHT_REC_H
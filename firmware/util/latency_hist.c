@@ -0,0 +1,111 @@
+/**
+ * @file latency_hist.c
+ * @brief Log-Bucketed Latency Histogram Implementation
+ */
+
+#include "latency_hist.h"
+#include "pico/platform.h"
+#include <string.h>
+
+// ============================================================================
+// Bucket Mapping
+// ============================================================================
+
+// log2 of the first octave above the linear range
+#define FIRST_OCTAVE_LOG2   4
+#define SUB_BUCKET_LOG2     3   // log2(LATENCY_HIST_SUB_BUCKETS)
+
+/**
+ * @brief Map a sample to its bucket index
+ */
+static uint32_t __not_in_flash_func(bucket_index)(uint32_t us) {
+    if (us < LATENCY_HIST_LINEAR_US) {
+        return us;
+    }
+    if (us >= LATENCY_HIST_MAX_US) {
+        return LATENCY_HIST_BUCKETS - 1;
+    }
+
+    // Octave k holds [2^k, 2^(k+1)); the SUB_BUCKET_LOG2 bits below the
+    // leading one select the sub-bucket
+    uint32_t k = FIRST_OCTAVE_LOG2;
+    while ((us >> (k + 1)) != 0) {
+        k++;
+    }
+    uint32_t sub = (us >> (k - SUB_BUCKET_LOG2)) & (LATENCY_HIST_SUB_BUCKETS - 1);
+    return LATENCY_HIST_LINEAR_US + (k - FIRST_OCTAVE_LOG2) * LATENCY_HIST_SUB_BUCKETS + sub;
+}
+
+uint32_t latency_hist_bucket_upper_us(uint32_t index) {
+    if (index < LATENCY_HIST_LINEAR_US) {
+        return index;
+    }
+    if (index >= LATENCY_HIST_BUCKETS - 1) {
+        return UINT32_MAX;  // Open-ended; callers clamp to max_us
+    }
+
+    uint32_t k = FIRST_OCTAVE_LOG2 + (index - LATENCY_HIST_LINEAR_US) / LATENCY_HIST_SUB_BUCKETS;
+    uint32_t sub = (index - LATENCY_HIST_LINEAR_US) % LATENCY_HIST_SUB_BUCKETS;
+    uint32_t width = 1u << (k - SUB_BUCKET_LOG2);
+    return (1u << k) + (sub + 1) * width - 1;
+}
+
+// ============================================================================
+// Histogram API
+// ============================================================================
+
+void latency_hist_reset(latency_hist_t* hist) {
+    memset(hist, 0, sizeof(*hist));
+}
+
+void __not_in_flash_func(latency_hist_record)(latency_hist_t* hist, uint32_t us) {
+    hist->buckets[bucket_index(us)]++;
+    hist->count++;
+    if (us > hist->max_us) {
+        hist->max_us = us;
+    }
+}
+
+void latency_hist_merge(latency_hist_t* dst, const latency_hist_t* src) {
+    for (uint32_t i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        dst->buckets[i] += src->buckets[i];
+    }
+    dst->count += src->count;
+    if (src->max_us > dst->max_us) {
+        dst->max_us = src->max_us;
+    }
+}
+
+uint32_t latency_hist_percentile(const latency_hist_t* hist, uint32_t per_mille) {
+    if (hist->count == 0) {
+        return 0;
+    }
+    if (per_mille > 1000) {
+        per_mille = 1000;
+    }
+
+    // Smallest rank covering per_mille of the samples (ceil, at least 1)
+    uint64_t rank = ((uint64_t)hist->count * per_mille + 999) / 1000;
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        seen += hist->buckets[i];
+        if (seen >= rank) {
+            uint32_t upper = latency_hist_bucket_upper_us(i);
+            return (upper < hist->max_us) ? upper : hist->max_us;
+        }
+    }
+    return hist->max_us;
+}
+
+void latency_hist_summarize(const latency_hist_t* hist, latency_summary_t* summary) {
+    summary->count = hist->count;
+    summary->p50_us = latency_hist_percentile(hist, 500);
+    summary->p90_us = latency_hist_percentile(hist, 900);
+    summary->p99_us = latency_hist_percentile(hist, 990);
+    summary->p999_us = latency_hist_percentile(hist, 999);
+    summary->max_us = hist->max_us;
+}
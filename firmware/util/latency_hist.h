@@ -0,0 +1,114 @@
+/**
+ * @file latency_hist.h
+ * @brief Log-Bucketed Latency Histogram (microseconds)
+ *
+ * Fixed-size histogram for latency percentiles without storing samples.
+ * Values below LATENCY_HIST_LINEAR_US get one bucket per microsecond;
+ * above that every power-of-two octave is split into
+ * LATENCY_HIST_SUB_BUCKETS equal buckets, so a reported percentile is
+ * at most 1/LATENCY_HIST_SUB_BUCKETS (12.5%) above the true value.
+ * Samples at or above LATENCY_HIST_MAX_US land in the last bucket; the
+ * exact maximum is tracked separately.
+ *
+ * Usage:
+ *   static latency_hist_t hist;
+ *   latency_hist_record(&hist, reply_us);
+ *
+ *   latency_summary_t s;
+ *   latency_hist_summarize(&hist, &s);   // s.p99_us, s.max_us, ...
+ */
+
+#ifndef LATENCY_HIST_H
+#define LATENCY_HIST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Histogram Layout
+// ============================================================================
+
+#define LATENCY_HIST_LINEAR_US      16      // 0-15 µs: one bucket each
+#define LATENCY_HIST_SUB_BUCKETS    8       // Buckets per octave above that
+#define LATENCY_HIST_OCTAVES        12      // Octaves 2^4 .. 2^15 µs
+#define LATENCY_HIST_MAX_US         (1u << 16)  // 65.536 ms (last bucket is open)
+
+#define LATENCY_HIST_BUCKETS        (LATENCY_HIST_LINEAR_US + \
+                                     LATENCY_HIST_OCTAVES * LATENCY_HIST_SUB_BUCKETS)
+
+/**
+ * @brief Latency histogram
+ */
+typedef struct {
+    uint32_t count;                             // Samples recorded
+    uint32_t max_us;                            // Exact largest sample
+    uint32_t buckets[LATENCY_HIST_BUCKETS];
+} latency_hist_t;
+
+/**
+ * @brief Percentile summary of a histogram (all values in µs)
+ *
+ * Percentiles are bucket upper bounds, never above max_us.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t p50_us;
+    uint32_t p90_us;
+    uint32_t p99_us;
+    uint32_t p999_us;
+    uint32_t max_us;
+} latency_summary_t;
+
+// ============================================================================
+// Histogram API
+// ============================================================================
+
+/**
+ * @brief Clear a histogram
+ *
+ * @param hist Histogram
+ */
+void latency_hist_reset(latency_hist_t* hist);
+
+/**
+ * @brief Record one sample (safe from IRQ context, no division)
+ *
+ * @param hist Histogram
+ * @param us Sample in microseconds
+ */
+void latency_hist_record(latency_hist_t* hist, uint32_t us);
+
+/**
+ * @brief Add every sample of src to dst
+ *
+ * @param dst Accumulating histogram
+ * @param src Histogram to add
+ */
+void latency_hist_merge(latency_hist_t* dst, const latency_hist_t* src);
+
+/**
+ * @brief Value at a percentile
+ *
+ * @param hist Histogram
+ * @param per_mille Percentile in 1/1000 (500 = p50, 999 = p99.9)
+ * @return Upper bound of the bucket holding that rank (0 if empty)
+ */
+uint32_t latency_hist_percentile(const latency_hist_t* hist, uint32_t per_mille);
+
+/**
+ * @brief Largest value that maps to a bucket
+ *
+ * @param index Bucket, 0 .. LATENCY_HIST_BUCKETS - 1
+ * @return Upper bound in µs (UINT32_MAX for the open last bucket)
+ */
+uint32_t latency_hist_bucket_upper_us(uint32_t index);
+
+/**
+ * @brief Compute p50/p90/p99/p99.9/max
+ *
+ * @param hist Histogram
+ * @param summary Output: percentile summary
+ */
+void latency_hist_summarize(const latency_hist_t* hist, latency_summary_t* summary);
+
+#endif // LATENCY_HIST_H
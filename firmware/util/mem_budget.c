@@ -0,0 +1,103 @@
+/**
+ * @file mem_budget.c
+ * @brief Stack High-Water Marks and Static RAM Budget Implementation
+ */
+
+#include "mem_budget.h"
+#include "pico/platform.h"
+#include <stddef.h>
+
+// ============================================================================
+// Linker Script Symbols (pico-sdk memmap_default.ld)
+// ============================================================================
+
+extern char __StackBottom;          // Core0 stack (SRAM5)
+extern char __StackTop;
+extern char __StackOneBottom;       // Core1 stack (SRAM4)
+extern char __StackOneTop;
+extern char __StackLimit;           // End of main SRAM (heap limit)
+extern char __data_start__;
+extern char __data_end__;
+extern char __bss_start__;
+extern char __bss_end__;
+extern char __end__;                // Heap start
+extern char __scratch_x_start__;
+extern char __scratch_x_end__;
+extern char __scratch_y_start__;
+extern char __scratch_y_end__;
+
+// newlib program break (unistd.h declares it only in GNU/POSIX modes)
+extern void* sbrk(ptrdiff_t incr);
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+static volatile bool painted[2] = { false, false };
+
+static uint32_t span(const char* start, const char* end) {
+    return (uint32_t)(end - start);
+}
+
+static void stack_bounds(uint32_t core, uint32_t** bottom, uint32_t** top) {
+    if (core == 0) {
+        *bottom = (uint32_t*)&__StackBottom;
+        *top = (uint32_t*)&__StackTop;
+    } else {
+        *bottom = (uint32_t*)&__StackOneBottom;
+        *top = (uint32_t*)&__StackOneTop;
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void mem_budget_paint_stack(void) {
+    uint32_t core = get_core_num();
+    uint32_t* bottom;
+    uint32_t* top;
+    stack_bounds(core, &bottom, &top);
+
+    uintptr_t sp;
+    __asm volatile ("mov %0, sp" : "=r" (sp));
+    uint32_t* limit = (uint32_t*)((sp - MEM_BUDGET_PAINT_MARGIN) & ~(uintptr_t)3);
+
+    for (volatile uint32_t* p = bottom; p < limit && p < top; p++) {
+        *p = MEM_BUDGET_PAINT;
+    }
+    painted[core] = true;
+}
+
+void mem_budget_get_stack(uint32_t core, mem_stack_t* stack) {
+    if (!stack || core > 1) {
+        return;
+    }
+    uint32_t* bottom;
+    uint32_t* top;
+    stack_bounds(core, &bottom, &top);
+
+    const volatile uint32_t* p = bottom;
+    while (p < top && *p == MEM_BUDGET_PAINT) {
+        p++;
+    }
+
+    stack->size = span((const char*)bottom, (const char*)top);
+    stack->high_water = span((const char*)p, (const char*)top);
+    stack->painted = painted[core];
+}
+
+void mem_budget_get_static(mem_static_t* budget) {
+    if (!budget) {
+        return;
+    }
+    uint32_t heap_top = (uint32_t)(uintptr_t)sbrk(0);  // Program break: malloc's heap top
+    uint32_t sram_end = (uint32_t)(uintptr_t)&__StackLimit;
+
+    budget->data = span(&__data_start__, &__data_end__);
+    budget->bss = span(&__bss_start__, &__bss_end__);
+    budget->scratch_x = span(&__scratch_x_start__, &__scratch_x_end__);
+    budget->scratch_y = span(&__scratch_y_start__, &__scratch_y_end__);
+    budget->heap_used = heap_top - (uint32_t)(uintptr_t)&__end__;
+    budget->sram_free = (sram_end > heap_top) ? sram_end - heap_top : 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file mem_budget.h
+ * @brief Stack High-Water Marks and Static RAM Budget
+ *
+ * Each core paints the unused part of its stack with MEM_BUDGET_PAINT at
+ * startup; the high-water mark is the depth of the deepest word that no
+ * longer holds the pattern. The Core0 stack is the SDK's main stack at the
+ * top of SRAM5 (scratch Y), the Core1 stack the SDK's core1 stack at the top
+ * of SRAM4 (scratch X). A mark equal to the stack size means the stack
+ * reached its bottom and has probably overflowed into the neighbouring data.
+ *
+ * The static budget comes from the linker script symbols: .data (which
+ * also holds the functions copied to SRAM), .bss, scratch X/Y data and the
+ * heap. Free SRAM is what is left between the heap top and the end of main
+ * SRAM. tools/ram_report.py splits the same sections by subsystem from the
+ * link map.
+ *
+ * Firmware only: the host build has no linker script symbols.
+ */
+
+#ifndef MEM_BUDGET_H
+#define MEM_BUDGET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Stack paint pattern */
+#define MEM_BUDGET_PAINT        0xC5AC5AC5u
+
+/** Bytes below the stack pointer left unpainted (the painting call's frame) */
+#define MEM_BUDGET_PAINT_MARGIN 64u
+
+/**
+ * @brief Stack usage of one core
+ */
+typedef struct {
+    uint32_t size;              // Stack size (bytes)
+    uint32_t high_water;        // Deepest use since painting (bytes)
+    bool painted;               // false until the core has painted its stack
+} mem_stack_t;
+
+/**
+ * @brief Static RAM budget (bytes)
+ */
+typedef struct {
+    uint32_t data;              // .data (initialised data and SRAM functions)
+    uint32_t bss;               // .bss (zeroed data)
+    uint32_t scratch_x;         // Core1 data in SRAM4 (beside the Core1 stack)
+    uint32_t scratch_y;         // Data in SRAM5 (beside the Core0 stack)
+    uint32_t heap_used;         // Heap obtained by malloc (program break)
+    uint32_t sram_free;         // Main SRAM above the heap top
+} mem_static_t;
+
+/**
+ * @brief Paint the calling core's stack below its current depth
+ *
+ * Call once per core, first thing in main() (Core0) and core1_main()
+ * (Core1).
+ */
+void mem_budget_paint_stack(void);
+
+/**
+ * @brief Get a core's stack size and high-water mark
+ *
+ * Scans up from the stack bottom to the first overwritten word (reads
+ * only; safe from either core).
+ *
+ * @param core Core number (0 or 1)
+ * @param stack Output: stack usage
+ */
+void mem_budget_get_stack(uint32_t core, mem_stack_t* stack);
+
+/**
+ * @brief Get the static RAM budget
+ *
+ * @param budget Output: section sizes and free SRAM
+ */
+void mem_budget_get_static(mem_static_t* budget);
+
+#endif // MEM_BUDGET_H
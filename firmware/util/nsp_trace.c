@@ -0,0 +1,85 @@
+/**
+ * @file nsp_trace.c
+ * @brief NSP Transaction Trace Ring Implementation
+ */
+
+#include "nsp_trace.h"
+#include "hardware/sync.h"
+
+#define TRACE_MASK  (NSP_TRACE_DEPTH - 1u)
+
+_Static_assert((NSP_TRACE_DEPTH & TRACE_MASK) == 0, "trace depth must be a power of 2");
+_Static_assert(sizeof(nsp_trace_entry_t) == 16, "trace entry must stay 16 bytes");
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+static nsp_trace_entry_t trace_ring[NSP_TRACE_DEPTH];
+static volatile uint32_t trace_head = 0;        // Published after the entry is written
+
+static volatile bool dump_pending = false;
+static volatile uint8_t dump_reason = 0;
+static volatile uint32_t dump_end = 0;
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+void nsp_trace_record(const nsp_trace_entry_t* entry) {
+    uint32_t head = trace_head;
+    trace_ring[head & TRACE_MASK] = *entry;
+    __dmb();    // Entry complete before the index that publishes it
+    trace_head = head + 1;
+}
+
+// ============================================================================
+// Readers
+// ============================================================================
+
+uint32_t nsp_trace_count(void) {
+    return trace_head;
+}
+
+uint32_t nsp_trace_oldest(void) {
+    // The slot after the newest may be mid-overwrite, so one less than DEPTH
+    uint32_t head = trace_head;
+    return (head >= NSP_TRACE_DEPTH) ? head - (NSP_TRACE_DEPTH - 1u) : 0;
+}
+
+bool nsp_trace_read(uint32_t index, nsp_trace_entry_t* entry) {
+    if ((int32_t)(index - trace_head) >= 0) {
+        return false;   // Not recorded yet
+    }
+
+    *entry = trace_ring[index & TRACE_MASK];
+    __dmb();
+
+    // Valid only if the writer has not started on this slot's next use
+    return (trace_head - index) < NSP_TRACE_DEPTH;
+}
+
+// ============================================================================
+// Dump Requests
+// ============================================================================
+
+void nsp_trace_request_dump(uint8_t reason) {
+    if (dump_pending) {
+        return;
+    }
+    dump_end = trace_head;
+    dump_reason = reason;
+    __dmb();
+    dump_pending = true;
+}
+
+bool nsp_trace_take_dump_request(uint8_t* reason, uint32_t* end) {
+    if (!dump_pending) {
+        return false;
+    }
+    __dmb();
+    *reason = dump_reason;
+    *end = dump_end;
+    dump_pending = false;
+    return true;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file nsp_trace.h
+ * @brief NSP Transaction Trace Ring
+ *
+ * Records every frame seen by the NSP handler (requests, replies and
+ * rejected frames) with its arrival time, header, outcome and reply
+ * timing, so a glitch reported by the OBC can be traced back over the
+ * last NSP_TRACE_DEPTH transactions (~25 s at 20 polls per second).
+ *
+ * The NSP service is the only writer: an append is a 16-byte store and an
+ * index update, with no locks or interrupt masking. Readers validate each
+ * copied entry against the write index and skip entries overwritten while
+ * they were reading.
+ *
+ * A dump (binary, over the telemetry USB port, see drivers/usb_stream.h)
+ * is requested from the console or automatically when a fault latches; it
+ * covers the ring as it was at the moment of the request.
+ */
+
+#ifndef NSP_TRACE_H
+#define NSP_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Transactions kept in the ring (power of 2, 16 B each) */
+#ifndef NSP_TRACE_DEPTH
+#define NSP_TRACE_DEPTH     512
+#endif
+
+/**
+ * @brief What became of a received frame
+ */
+typedef enum {
+    NSP_TRACE_ACK = 0,          // Reply sent, ACK
+    NSP_TRACE_NACK,             // Reply sent, NACK
+    NSP_TRACE_NO_REPLY,         // Executed, no reply (poll bit clear or NO_REPLY command)
+    NSP_TRACE_DEFERRED,         // Reply queued for delayed send (fault injection)
+    NSP_TRACE_DROPPED,          // Reply dropped by fault injection
+    NSP_TRACE_SLIP_ERROR,       // Error class: SLIP framing
+    NSP_TRACE_PARSE_ERROR,      // Error class: NSP length/CRC (detail = nsp_result_t)
+    NSP_TRACE_WRONG_ADDR,       // Error class: addressed to another node
+    NSP_TRACE_DISPATCH_ERROR,   // Error class: unknown command
+    NSP_TRACE_REPLY_ERROR,      // Reply could not be built or sent
+} nsp_trace_outcome_t;
+
+/**
+ * @brief One transaction (16 bytes, wire order of the binary dump)
+ */
+typedef struct {
+    uint32_t rx_us;             // Request frame END arrival (time_us_32)
+    uint32_t reply_us;          // Frame END to reply first start bit (0 = no reply)
+    uint8_t dest;               // Header (0 where the frame had none)
+    uint8_t src;
+    uint8_t ctrl;               // Control byte (command in the low 5 bits)
+    uint8_t outcome;            // nsp_trace_outcome_t
+    uint8_t detail;             // Parse error code or SCENARIO_XPORT_* injection flags
+    uint8_t frame_len;          // Decoded request length (saturates at 255)
+    uint16_t reply_len;         // SLIP-encoded reply bytes (0 = no reply)
+} nsp_trace_entry_t;
+
+/**
+ * @brief Reason for a dump (carried in the dump frames)
+ */
+typedef enum {
+    NSP_TRACE_DUMP_MANUAL = 1,  // Requested from the console
+    NSP_TRACE_DUMP_FAULT = 2,   // A wheel latched a fault
+} nsp_trace_dump_reason_t;
+
+// ============================================================================
+// Writer (NSP service only)
+// ============================================================================
+
+/**
+ * @brief Append a transaction
+ *
+ * @param entry Transaction record
+ */
+void nsp_trace_record(const nsp_trace_entry_t* entry);
+
+// ============================================================================
+// Readers
+// ============================================================================
+
+/**
+ * @brief Get the number of transactions recorded since boot
+ *
+ * Also the index the next transaction will get.
+ *
+ * @return Total appended (may exceed NSP_TRACE_DEPTH)
+ */
+uint32_t nsp_trace_count(void);
+
+/**
+ * @brief Get the index of the oldest transaction still readable
+ *
+ * @return Oldest index (equal to nsp_trace_count() if the ring is empty)
+ */
+uint32_t nsp_trace_oldest(void);
+
+/**
+ * @brief Copy one transaction
+ *
+ * @param index Transaction index (0 = first since boot)
+ * @param entry Output: transaction record
+ * @return false if the index is not recorded yet or already overwritten
+ */
+bool nsp_trace_read(uint32_t index, nsp_trace_entry_t* entry);
+
+// ============================================================================
+// Dump Requests
+// ============================================================================
+
+/**
+ * @brief Request a dump of the ring as it is now
+ *
+ * Ignored while an earlier request has not been taken yet.
+ *
+ * @param reason nsp_trace_dump_reason_t
+ */
+void nsp_trace_request_dump(uint8_t reason);
+
+/**
+ * @brief Take a pending dump request (dump sender only)
+ *
+ * @param reason Output: nsp_trace_dump_reason_t
+ * @param end Output: nsp_trace_count() at the time of the request
+ * @return true if a request was pending
+ */
+bool nsp_trace_take_dump_request(uint8_t* reason, uint32_t* end);
+
+#endif // NSP_TRACE_H
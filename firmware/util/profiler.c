@@ -0,0 +1,108 @@
+/**
+ * @file profiler.c
+ * @brief Cycle-Counting Hot-Path Profiler Implementation
+ */
+
+#include "profiler.h"
+#include "pico/platform.h"
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+static profiler_stats_t probe_stats[PROF_PROBE_COUNT];
+
+static const char* const probe_names[PROF_PROBE_COUNT] = {
+    [PROF_CORE1_CMD_DRAIN]  = "c1_cmd_drain",
+    [PROF_CORE1_CONTROL]    = "c1_control",
+    [PROF_CORE1_LIMITS]     = "c1_limits",
+    [PROF_CORE1_DYNAMICS]   = "c1_dynamics",
+    [PROF_CORE1_PROTECTION] = "c1_protection",
+    [PROF_CORE1_PUBLISH]    = "c1_publish",
+    [PROF_NSP_SLIP]         = "nsp_slip",
+    [PROF_NSP_PARSE]        = "nsp_parse",
+    [PROF_NSP_DISPATCH]     = "nsp_dispatch",
+    [PROF_NSP_REPLY]        = "nsp_reply",
+    [PROF_NSP_TX]           = "nsp_tx",
+};
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+void __not_in_flash_func(profiler_record)(profiler_probe_t probe, uint32_t cycles) {
+    if ((uint32_t)probe >= PROF_PROBE_COUNT) {
+        return;
+    }
+
+    profiler_stats_t* s = &probe_stats[probe];
+    if (s->count == 0 || cycles < s->min_cycles) s->min_cycles = cycles;
+    if (cycles > s->max_cycles) s->max_cycles = cycles;
+    s->total_cycles += cycles;
+    s->count++;
+
+    // Bucket = floor(log2(cycles)), 0 and 1 cycle share bucket 0
+    uint32_t bucket = 0;
+    while ((cycles >> 1) != 0 && bucket < PROFILER_HIST_BUCKETS - 1) {
+        cycles >>= 1;
+        bucket++;
+    }
+    s->hist[bucket]++;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void profiler_reset(void) {
+    memset(probe_stats, 0, sizeof(probe_stats));
+}
+
+bool profiler_get_stats(profiler_probe_t probe, profiler_stats_t* stats) {
+    if ((uint32_t)probe >= PROF_PROBE_COUNT) {
+        return false;
+    }
+    if (stats) *stats = probe_stats[probe];
+    return true;
+}
+
+const char* profiler_probe_name(profiler_probe_t probe) {
+    if ((uint32_t)probe >= PROF_PROBE_COUNT) {
+        return "?";
+    }
+    return probe_names[probe];
+}
+
+bool profiler_is_enabled(void) {
+    return PROFILER_ENABLED != 0;
+}
+
+void profiler_dump(void) {
+    if (!PROFILER_ENABLED) {
+        printf("[PROFILER] Probes not compiled in (build with -DNRWA_PROFILER=ON)\n");
+        return;
+    }
+
+    printf("[PROFILER] Probe statistics (cycles; histogram bucket b = [2^b, 2^(b+1)))\n");
+    printf("%-14s %10s %8s %8s %8s\n", "probe", "count", "min", "mean", "max");
+
+    for (uint32_t p = 0; p < PROF_PROBE_COUNT; p++) {
+        profiler_stats_t s = probe_stats[p];
+        uint32_t mean = (s.count > 0) ? (uint32_t)(s.total_cycles / s.count) : 0;
+        printf("%-14s %10lu %8lu %8lu %8lu\n", probe_names[p], (unsigned long)s.count,
+               (unsigned long)s.min_cycles, (unsigned long)mean, (unsigned long)s.max_cycles);
+
+        if (s.count == 0) {
+            continue;
+        }
+        printf("  hist:");
+        for (uint32_t b = 0; b < PROFILER_HIST_BUCKETS; b++) {
+            if (s.hist[b] != 0) {
+                printf(" 2^%lu:%lu", (unsigned long)b, (unsigned long)s.hist[b]);
+            }
+        }
+        printf("\n");
+    }
+}
@@ -0,0 +1,152 @@
+/**
+ * @file profiler.h
+ * @brief Cycle-Counting Hot-Path Profiler
+ *
+ * Named probe points around each stage of the Core1 physics tick and the
+ * Core0 NSP service path. Each probe keeps call count, min/max/mean cycles
+ * and a log2 histogram. Cycles come from the per-core SysTick counter
+ * (timebase_cycle_counter_start()), so each core must start its own.
+ *
+ * Probes compile to nothing unless the build sets PROFILER_ENABLED=1
+ * (cmake -DNRWA_PROFILER=ON ..). The statistics API is always present and
+ * reports zero counts in a build without probes.
+ *
+ * Usage:
+ *   PROF_BEGIN(PROF_CORE1_DYNAMICS);
+ *   update_dynamics(state);
+ *   PROF_END(PROF_CORE1_DYNAMICS);
+ *
+ * Every probe has exactly one writer (Core1 probes on Core1, NSP probes in
+ * the Core0 service IRQ); readers tolerate a torn update of one probe.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 0
+#endif
+
+// ============================================================================
+// Probe Points
+// ============================================================================
+
+/**
+ * @brief Profiler probe identifiers
+ */
+typedef enum {
+    // Core1 physics tick
+    PROF_CORE1_CMD_DRAIN = 0,   // Apply queued Core0 commands
+    PROF_CORE1_CONTROL,         // Control law (mode dispatch)
+    PROF_CORE1_LIMITS,          // apply_limits()
+    PROF_CORE1_DYNAMICS,        // update_dynamics()
+    PROF_CORE1_PROTECTION,      // check_protections()
+    PROF_CORE1_PUBLISH,         // Snapshot + telemetry block publish
+
+    // Core0 NSP service
+    PROF_NSP_SLIP,              // SLIP decode + CRC of one frame (fused receiver)
+    PROF_NSP_PARSE,             // Header view and bookkeeping
+    PROF_NSP_DISPATCH,          // Command handler
+    PROF_NSP_REPLY,             // Reply frame build (or cache copy)
+    PROF_NSP_TX,                // Hand reply to RS-485 DMA
+
+    PROF_PROBE_COUNT
+} profiler_probe_t;
+
+/** Histogram buckets: bucket b counts calls of [2^b, 2^(b+1)) cycles, last is open */
+#define PROFILER_HIST_BUCKETS   16
+
+/**
+ * @brief Statistics of one probe
+ */
+typedef struct {
+    uint32_t count;                         // Samples recorded
+    uint32_t min_cycles;                    // Fastest sample (0 if none)
+    uint32_t max_cycles;                    // Slowest sample
+    uint64_t total_cycles;                  // Sum (mean = total / count)
+    uint32_t hist[PROFILER_HIST_BUCKETS];   // log2 histogram
+} profiler_stats_t;
+
+// ============================================================================
+// Probe Macros
+// ============================================================================
+
+#if PROFILER_ENABLED
+
+#include "hardware/structs/systick.h"
+
+/** Read the calling core's SysTick (counts down, 24 bits) */
+static inline uint32_t profiler_cycles(void) {
+    return systick_hw->cvr;
+}
+
+#define PROF_BEGIN(probe)   uint32_t prof_t0_##probe = profiler_cycles()
+#define PROF_END(probe)     profiler_record((probe), \
+                                (prof_t0_##probe - profiler_cycles()) & 0x00FFFFFFu)
+
+// Stages split over several calls: add each slice to a uint32_t accumulator
+// (declared under #if PROFILER_ENABLED), then record the total once
+#define PROF_ACCUM(probe, acc)  ((acc) += (prof_t0_##probe - profiler_cycles()) & 0x00FFFFFFu)
+#define PROF_COMMIT(probe, acc) do { profiler_record((probe), (acc)); (acc) = 0; } while (0)
+
+#else
+
+#define PROF_BEGIN(probe)       do { } while (0)
+#define PROF_END(probe)         do { } while (0)
+#define PROF_ACCUM(probe, acc)  do { } while (0)
+#define PROF_COMMIT(probe, acc) do { } while (0)
+
+#endif
+
+// ============================================================================
+// Profiler API
+// ============================================================================
+
+/**
+ * @brief Record one sample for a probe
+ *
+ * Normally called through PROF_END(). Runs from RAM.
+ *
+ * @param probe Probe identifier
+ * @param cycles Elapsed cycles
+ */
+void profiler_record(profiler_probe_t probe, uint32_t cycles);
+
+/**
+ * @brief Clear all probe statistics
+ */
+void profiler_reset(void);
+
+/**
+ * @brief Get statistics of one probe
+ *
+ * @param probe Probe identifier
+ * @param stats Output: copy of the probe statistics
+ * @return false for an invalid probe
+ */
+bool profiler_get_stats(profiler_probe_t probe, profiler_stats_t* stats);
+
+/**
+ * @brief Get the short name of a probe (for console and dump)
+ *
+ * @param probe Probe identifier
+ * @return Name, or "?" for an invalid probe
+ */
+const char* profiler_probe_name(profiler_probe_t probe);
+
+/**
+ * @brief Check whether probes are compiled into this build
+ *
+ * @return true if built with PROFILER_ENABLED=1
+ */
+bool profiler_is_enabled(void);
+
+/**
+ * @brief Print every probe with its histogram to stdout (USB-CDC)
+ */
+void profiler_dump(void);
+
+#endif // PROFILER_H
@@ -183,3 +183,79 @@ void ringbuf_reset(ringbuf_t *rb) {
     rb->tail = 0;
     memory_barrier();
 }
+
+// ============================================================================
+// Byte Ring Buffer
+// ============================================================================
+
+bool ringbuf8_init(ringbuf8_t *rb, uint8_t *storage, uint32_t size) {
+    if (rb == NULL || storage == NULL) {
+        return false;
+    }
+
+    // Validate size is power of 2
+    if (!is_power_of_2(size)) {
+        return false;
+    }
+
+    rb->buffer = storage;
+    rb->head = 0;
+    rb->tail = 0;
+    rb->size = size;
+    rb->mask = size - 1;
+    memory_barrier();
+
+    return true;
+}
+
+bool ringbuf8_push(ringbuf8_t *rb, uint8_t byte) {
+    uint32_t head = rb->head;
+    uint32_t tail = rb->tail;  // Acquire (volatile)
+    memory_barrier();
+
+    uint32_t next_head = (head + 1) & rb->mask;
+    if (next_head == tail) {
+        return false;  // Ring full
+    }
+
+    rb->buffer[head] = byte;
+
+    // Release barrier: data visible before head update
+    memory_barrier();
+    rb->head = next_head;
+
+    return true;
+}
+
+bool ringbuf8_pop(ringbuf8_t *rb, uint8_t *byte) {
+    uint32_t head = rb->head;  // Acquire (volatile)
+    uint32_t tail = rb->tail;
+    memory_barrier();
+
+    if (head == tail) {
+        return false;  // Ring empty
+    }
+
+    *byte = rb->buffer[tail];
+
+    // Release barrier: data read before slot is handed back
+    memory_barrier();
+    rb->tail = (tail + 1) & rb->mask;
+
+    return true;
+}
+
+uint32_t ringbuf8_count(const ringbuf8_t *rb) {
+    uint32_t head = rb->head;
+    uint32_t tail = rb->tail;
+    memory_barrier();
+
+    return (head - tail) & rb->mask;
+}
+
+void ringbuf8_flush(ringbuf8_t *rb) {
+    // Consumer-side discard: advance tail to the current head snapshot
+    uint32_t head = rb->head;
+    memory_barrier();
+    rb->tail = head;
+}
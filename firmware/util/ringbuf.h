@@ -140,6 +140,71 @@ uint32_t ringbuf_available(const ringbuf_t *rb);
  */
 void ringbuf_reset(ringbuf_t *rb);
 
+// ============================================================================
+// Byte Ring Buffer (SPSC, caller-provided storage)
+// ============================================================================
+
+/**
+ * @brief Lock-free SPSC byte ring
+ *
+ * Same head/tail protocol as ringbuf_t, but stores bytes in a caller-provided
+ * power-of-2 array so large buffers (e.g. the RS-485 RX ring) do not inflate
+ * every ringbuf_t instance. Safe for ISR producer / main-loop consumer.
+ */
+typedef struct {
+    uint8_t *buffer;                     /**< Storage (size bytes, caller-owned) */
+    volatile uint32_t head;              /**< Write index (modified by producer only) */
+    volatile uint32_t tail;              /**< Read index (modified by consumer only) */
+    uint32_t size;                       /**< Buffer size (must be power of 2) */
+    uint32_t mask;                       /**< Size - 1, for fast modulo (index & mask) */
+} ringbuf8_t;
+
+/**
+ * @brief Initialize byte ring over caller-provided storage
+ *
+ * @param rb Pointer to byte ring structure
+ * @param storage Backing array (must outlive the ring)
+ * @param size Storage size in bytes (MUST be power of 2)
+ * @return true on success, false if arguments are invalid
+ */
+bool ringbuf8_init(ringbuf8_t *rb, uint8_t *storage, uint32_t size);
+
+/**
+ * @brief Push byte into ring (producer side)
+ *
+ * @param rb Pointer to byte ring
+ * @param byte Byte to push
+ * @return true if pushed, false if ring is full
+ */
+bool ringbuf8_push(ringbuf8_t *rb, uint8_t byte);
+
+/**
+ * @brief Pop byte from ring (consumer side)
+ *
+ * @param rb Pointer to byte ring
+ * @param byte Pointer to receive popped byte
+ * @return true if popped, false if ring is empty
+ */
+bool ringbuf8_pop(ringbuf8_t *rb, uint8_t *byte);
+
+/**
+ * @brief Get number of bytes currently in ring
+ *
+ * @param rb Pointer to byte ring
+ * @return Number of bytes buffered
+ */
+uint32_t ringbuf8_count(const ringbuf8_t *rb);
+
+/**
+ * @brief Discard all buffered bytes (consumer side)
+ *
+ * Unlike ringbuf_reset(), this only moves the consumer index, so it is
+ * safe to call while the producer is active.
+ *
+ * @param rb Pointer to byte ring
+ */
+void ringbuf8_flush(ringbuf8_t *rb);
+
 // ============================================================================
 // Helper Functions
 // ============================================================================
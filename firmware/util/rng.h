@@ -0,0 +1,98 @@
+/**
+ * @file rng.h
+ * @brief Seeded Pseudo-Random Generator (Header-Only)
+ *
+ * xorshift32 (Marsaglia): three shifts and three XORs per draw, no
+ * multiply or divide, so it is cheap on the Cortex-M0+ in IRQ context.
+ * The sequence depends only on the seed, which makes randomized fault
+ * injection reproducible: the same seed and the same command sequence give
+ * the same decisions.
+ *
+ * Not for anything security-related.
+ *
+ * Example:
+ *   rng_t rng;
+ *   rng_seed(&rng, 12345);
+ *   if (rng_chance_q16(&rng, 0x8000)) { ... }   // 50%
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Generator state (never 0 once seeded)
+ */
+typedef struct {
+    uint32_t state;
+} rng_t;
+
+/**
+ * @brief Scramble a value into a well-mixed 32-bit seed
+ *
+ * Finalizer of MurmurHash3; turns e.g. a timestamp into a seed whose bits
+ * are all meaningful. Never returns 0 (a dead state for xorshift).
+ *
+ * @param x Raw entropy (timestamp, counter, ...)
+ * @return Non-zero seed
+ */
+static inline uint32_t rng_mix(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x ? x : 0x9E3779B9u;
+}
+
+/**
+ * @brief Seed the generator
+ *
+ * @param rng Generator
+ * @param seed Any value; 0 is mapped to a fixed non-zero state
+ */
+static inline void rng_seed(rng_t* rng, uint32_t seed) {
+    rng->state = rng_mix(seed);
+}
+
+/**
+ * @brief Next 32-bit value
+ *
+ * @param rng Generator
+ * @return Uniform 32-bit value
+ */
+static inline uint32_t rng_next(rng_t* rng) {
+    uint32_t x = rng->state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng->state = x;
+    return x;
+}
+
+/**
+ * @brief Draw an event with a Q16 probability
+ *
+ * @param rng Generator
+ * @param p_q16 Probability in Q16 (0 = never, 0xFFFF = always)
+ * @return true with probability p_q16 / 65536 (always for 0xFFFF)
+ */
+static inline bool rng_chance_q16(rng_t* rng, uint32_t p_q16) {
+    uint32_t r = rng_next(rng) >> 16;
+    return p_q16 >= 0xFFFFu || r < p_q16;
+}
+
+/**
+ * @brief Draw an event with a percent probability
+ *
+ * @param rng Generator
+ * @param pct Percent (0 = never, 100 or more = always)
+ * @return true with probability pct / 100
+ */
+static inline bool rng_chance_pct(rng_t* rng, uint32_t pct) {
+    return ((rng_next(rng) >> 16) * 100u >> 16) < pct;
+}
+
+#endif // RNG_H
@@ -0,0 +1,102 @@
+/**
+ * @file stats.c
+ * @brief 64-bit Statistics Counters Implementation
+ */
+
+#include "stats.h"
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+stats_counter_t g_stats[STATS_COUNT];
+
+static const char* const stats_names[STATS_COUNT] = {
+    [STATS_PHYSICS_TICKS] = "physics_ticks",
+    [STATS_WHEEL_REVS]    = "wheel_revs",
+    [STATS_NSP_RX_BYTES]  = "rx_bytes",
+    [STATS_NSP_TX_BYTES]  = "tx_bytes",
+    [STATS_NSP_RX_FRAMES] = "rx_frames",
+    [STATS_NSP_TX_FRAMES] = "tx_frames",
+};
+
+// Interval history (Core0 main loop only)
+static stats_interval_t intervals[STATS_INTERVAL_DEPTH];
+static uint32_t interval_head = 0;              // Next slot to fill
+static uint32_t interval_count = 0;
+static uint64_t interval_start_us = 0;
+static uint64_t interval_base[STATS_COUNT];     // Totals when the interval opened
+static bool interval_started = false;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+uint64_t stats_read(stats_id_t id) {
+    if (id >= STATS_COUNT) {
+        return 0;
+    }
+    const stats_counter_t* c = &g_stats[id];
+
+    while (true) {
+        uint32_t seq = c->seq;
+        __dmb();
+        uint32_t lo = c->lo;
+        uint32_t hi = c->hi;
+        __dmb();
+        if ((seq & 1u) == 0 && c->seq == seq) {
+            return ((uint64_t)hi << 32) | lo;
+        }
+    }
+}
+
+const char* stats_get_name(stats_id_t id) {
+    return (id < STATS_COUNT) ? stats_names[id] : "?";
+}
+
+void stats_update(uint64_t now_us) {
+    if (!interval_started) {
+        interval_started = true;
+        interval_start_us = now_us;
+        for (uint32_t i = 0; i < STATS_COUNT; i++) {
+            interval_base[i] = stats_read((stats_id_t)i);
+        }
+        return;
+    }
+    if (now_us - interval_start_us < STATS_INTERVAL_US) {
+        return;
+    }
+
+    stats_interval_t* slot = &intervals[interval_head];
+    slot->end_s = (uint32_t)(now_us / 1000000u);
+    for (uint32_t i = 0; i < STATS_COUNT; i++) {
+        uint64_t total = stats_read((stats_id_t)i);
+        slot->delta[i] = (uint32_t)(total - interval_base[i]);
+        interval_base[i] = total;
+    }
+
+    // Next interval starts where this one was due, so a late main loop
+    // pass does not stretch the grid (unless it missed whole intervals)
+    interval_start_us += STATS_INTERVAL_US;
+    if (now_us - interval_start_us >= STATS_INTERVAL_US) {
+        interval_start_us = now_us;
+    }
+
+    interval_head = (interval_head + 1u) % STATS_INTERVAL_DEPTH;
+    if (interval_count < STATS_INTERVAL_DEPTH) {
+        interval_count++;
+    }
+}
+
+uint32_t stats_interval_count(void) {
+    return interval_count;
+}
+
+bool stats_get_interval(uint32_t age, stats_interval_t* out) {
+    if (age >= interval_count || out == NULL) {
+        return false;
+    }
+    uint32_t idx = (interval_head + STATS_INTERVAL_DEPTH - 1u - age) % STATS_INTERVAL_DEPTH;
+    *out = intervals[idx];
+    return true;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file stats.h
+ * @brief 64-bit Statistics Counters with Per-Minute History
+ *
+ * The per-module counters (tick_count, rx_byte_count, revolution_count)
+ * are 32-bit: they wrap during multi-day soaks and restart on RESET, and
+ * the other core reads them with no consistency guarantee. The counters
+ * here run from boot, never wrap in practice, and read consistently from
+ * either core, so long HIL campaigns get trustworthy totals and rates.
+ *
+ * Each counter has exactly one writer context (the physics tick on Core1
+ * or the NSP service on Core0) and is guarded by its own sequence number:
+ * the writer bumps it around the update, a reader retries while it is odd
+ * or changed. Readers must not preempt the writer (read from the main
+ * loop, not from an IRQ above the writer's).
+ *
+ * stats_update(), called from the Core0 main loop, closes one interval
+ * every STATS_INTERVAL_US and keeps the per-counter deltas of the last
+ * STATS_INTERVAL_DEPTH intervals in a ring.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/sync.h"
+
+/** Interval length (µs) */
+#define STATS_INTERVAL_US       60000000ull
+
+/** Closed intervals kept in the history ring */
+#ifndef STATS_INTERVAL_DEPTH
+#define STATS_INTERVAL_DEPTH    16
+#endif
+
+/**
+ * @brief Counter IDs
+ */
+typedef enum {
+    STATS_PHYSICS_TICKS = 0,    // Physics ticks run (Core1)
+    STATS_WHEEL_REVS,           // Whole revolutions, all wheels (Core1)
+    STATS_NSP_RX_BYTES,         // Bytes received, SLIP encoded (NSP service)
+    STATS_NSP_TX_BYTES,         // Bytes sent, SLIP encoded (NSP service)
+    STATS_NSP_RX_FRAMES,        // Valid frames received (NSP service)
+    STATS_NSP_TX_FRAMES,        // Replies sent (NSP service)
+    STATS_COUNT
+} stats_id_t;
+
+/**
+ * @brief One single-writer 64-bit counter
+ */
+typedef struct {
+    volatile uint32_t seq;      // Odd while the writer is mid-update
+    volatile uint32_t lo;
+    volatile uint32_t hi;
+} stats_counter_t;
+
+/**
+ * @brief One closed interval
+ */
+typedef struct {
+    uint32_t end_s;                 // Interval end, seconds since boot
+    uint32_t delta[STATS_COUNT];    // Counter increase over the interval
+} stats_interval_t;
+
+/** Counter storage (use stats_add() / stats_read()) */
+extern stats_counter_t g_stats[STATS_COUNT];
+
+/**
+ * @brief Add to a counter (its writer context only)
+ *
+ * @param id Counter
+ * @param n Increment
+ */
+static inline void stats_add(stats_id_t id, uint32_t n) {
+    stats_counter_t* c = &g_stats[id];
+    uint32_t lo = c->lo + n;
+    c->seq = c->seq + 1;
+    __dmb();
+    if (lo < c->lo) {
+        c->hi = c->hi + 1;
+    }
+    c->lo = lo;
+    __dmb();
+    c->seq = c->seq + 1;
+}
+
+/**
+ * @brief Read a counter consistently (any core)
+ *
+ * @param id Counter
+ * @return Total since boot (0 for an invalid ID)
+ */
+uint64_t stats_read(stats_id_t id);
+
+/**
+ * @brief Get a counter's name
+ *
+ * @param id Counter
+ * @return Short name ("?" for an invalid ID)
+ */
+const char* stats_get_name(stats_id_t id);
+
+/**
+ * @brief Close the current interval when it has run its length (Core0 main loop)
+ *
+ * @param now_us Time since boot (µs)
+ */
+void stats_update(uint64_t now_us);
+
+/**
+ * @brief Get the number of closed intervals held
+ *
+ * @return 0 .. STATS_INTERVAL_DEPTH
+ */
+uint32_t stats_interval_count(void);
+
+/**
+ * @brief Get a closed interval
+ *
+ * @param age 0 = most recent, up to stats_interval_count() - 1
+ * @param out Output: interval
+ * @return false if no interval of that age is held
+ */
+bool stats_get_interval(uint32_t age, stats_interval_t* out);
+
+#endif // STATS_H
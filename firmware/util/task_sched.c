@@ -0,0 +1,236 @@
+/**
+ * @file task_sched.c
+ * @brief Core1 Multi-Rate Task Scheduler Implementation
+ */
+
+#include "task_sched.h"
+#include "hot_path.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+// Internal State (written by Core1 only)
+// ============================================================================
+
+typedef struct {
+    task_sched_fn_t fn;
+    uint32_t phase;             // Periodic: runs when tick % period == phase
+    bool armed;                 // Idle or deferred: waiting for slack on this tick
+    uint32_t skip_run;          // Idle: consecutive ticks skipped
+    task_sched_stats_t stats;
+} task_entry_t;
+
+static task_entry_t CORE1_DATA("sched") tasks[TASK_SCHED_MAX_TASKS];
+static uint8_t task_count = 0;
+
+// Periodic tasks, shortest period first (rate-monotonic priority)
+static uint8_t run_order[TASK_SCHED_MAX_TASKS];
+static uint8_t periodic_count = 0;
+
+// Budget governor (0 = off) and ticks on which it held work back
+static uint32_t tick_budget_us = 0;
+static uint32_t shed_ticks = 0;
+
+static volatile bool reset_requested = false;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Run time to plan for: the budget, or more if the last run took longer
+static inline uint32_t task_cost_us(const task_entry_t* t) {
+    return (t->stats.last_us > t->stats.budget_us) ? t->stats.last_us : t->stats.budget_us;
+}
+
+static inline void __not_in_flash_func(run_task)(task_entry_t* t) {
+    uint32_t start = time_us_32();
+    t->fn();
+    uint32_t us = time_us_32() - start;
+
+    task_sched_stats_t* s = &t->stats;
+    s->runs++;
+    s->last_us = us;
+    s->total_us += us;
+    if (us > s->max_us) {
+        s->max_us = us;
+    }
+    if (us > s->budget_us) {
+        s->overruns++;
+    }
+}
+
+static void reset_stats(void) {
+    for (uint8_t i = 0; i < task_count; i++) {
+        task_sched_stats_t* s = &tasks[i].stats;
+        s->runs = 0;
+        s->last_us = 0;
+        s->max_us = 0;
+        s->total_us = 0;
+        s->overruns = 0;
+        s->skipped = 0;
+        s->deferred = 0;
+        s->shed = 0;
+    }
+    shed_ticks = 0;
+}
+
+static int add_task(const char* name, task_sched_fn_t fn, uint32_t period_ticks,
+                    uint32_t budget_us, task_sched_prio_t priority) {
+    if (!fn || task_count >= TASK_SCHED_MAX_TASKS) {
+        printf("[SCHED] ERROR: Cannot add task %s (table full)\n", name ? name : "?");
+        return -1;
+    }
+
+    uint8_t index = task_count++;
+    task_entry_t* t = &tasks[index];
+    memset(t, 0, sizeof(*t));
+    t->fn = fn;
+    t->stats.name = name ? name : "?";
+    t->stats.period_ticks = period_ticks;
+    t->stats.budget_us = budget_us;
+    t->stats.priority = (uint8_t)priority;
+
+    if (period_ticks == TASK_SCHED_IDLE) {
+        return index;
+    }
+
+    // Stagger tasks of the same period over its ticks
+    uint32_t same_period = 0;
+    for (uint8_t i = 0; i < periodic_count; i++) {
+        if (tasks[run_order[i]].stats.period_ticks == period_ticks) {
+            same_period++;
+        }
+    }
+    t->phase = same_period % period_ticks;
+
+    // Insert after every task with a period no longer than this one
+    uint8_t pos = periodic_count;
+    while (pos > 0 && tasks[run_order[pos - 1]].stats.period_ticks > period_ticks) {
+        run_order[pos] = run_order[pos - 1];
+        pos--;
+    }
+    run_order[pos] = index;
+    periodic_count++;
+    return index;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+int task_sched_add(const char* name, task_sched_fn_t fn, uint32_t period_ticks, uint32_t budget_us) {
+    return add_task(name, fn, period_ticks, budget_us, TASK_SCHED_PRIO_HARD);
+}
+
+int task_sched_add_optional(const char* name, task_sched_fn_t fn, uint32_t period_ticks,
+                            uint32_t cost_us, task_sched_prio_t priority) {
+    if (period_ticks == TASK_SCHED_IDLE ||
+        (priority != TASK_SCHED_PRIO_DEFER && priority != TASK_SCHED_PRIO_SHED)) {
+        printf("[SCHED] ERROR: Task %s is not an optional periodic task\n", name ? name : "?");
+        return -1;
+    }
+    return add_task(name, fn, period_ticks, cost_us, priority);
+}
+
+void task_sched_set_tick_budget(uint32_t budget_us) {
+    tick_budget_us = budget_us;
+}
+
+void __not_in_flash_func(task_sched_run_tick)(uint32_t tick) {
+    if (reset_requested) {
+        reset_requested = false;
+        reset_stats();
+    }
+    uint64_t deadline_us = time_us_64() + tick_budget_us;
+
+    // Tasks still armed got no slack on the previous tick
+    for (uint8_t i = 0; i < task_count; i++) {
+        task_entry_t* t = &tasks[i];
+        if (t->stats.period_ticks != TASK_SCHED_IDLE) {
+            if (t->armed) {
+                t->armed = false;   // Deferred: this activation is lost
+                t->stats.shed++;
+            }
+            continue;
+        }
+        if (t->armed) {
+            t->stats.skipped++;
+            t->skip_run++;
+        }
+        t->armed = true;
+    }
+
+    bool held = false;
+    for (uint8_t i = 0; i < periodic_count; i++) {
+        task_entry_t* t = &tasks[run_order[i]];
+        if ((tick % t->stats.period_ticks) != t->phase) {
+            continue;
+        }
+        if (t->stats.priority != TASK_SCHED_PRIO_HARD && tick_budget_us != 0 &&
+            time_us_64() + task_cost_us(t) > deadline_us) {
+            // Governor: not enough budget left on this tick
+            if (t->stats.priority == TASK_SCHED_PRIO_DEFER) {
+                t->armed = true;
+                t->stats.deferred++;
+            } else {
+                t->stats.shed++;
+            }
+            held = true;
+            continue;
+        }
+        run_task(t);
+    }
+    if (held) {
+        shed_ticks++;
+    }
+}
+
+uint32_t __not_in_flash_func(task_sched_run_idle)(uint64_t deadline_us) {
+    uint64_t start = time_us_64();
+
+    // Deferred periodic tasks first (never forced), then the idle tasks
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        for (uint8_t i = 0; i < task_count; i++) {
+            task_entry_t* t = &tasks[i];
+            bool idle = (t->stats.period_ticks == TASK_SCHED_IDLE);
+            if (!t->armed || idle != (pass == 1)) {
+                continue;
+            }
+            bool forced = idle && t->skip_run >= TASK_SCHED_IDLE_MAX_SKIP;
+            if (time_us_64() + task_cost_us(t) > deadline_us && !forced) {
+                continue;   // Not enough slack left on this call
+            }
+            t->armed = false;
+            t->skip_run = 0;
+            run_task(t);
+        }
+    }
+
+    return (uint32_t)(time_us_64() - start);
+}
+
+uint8_t task_sched_get_count(void) {
+    return task_count;
+}
+
+bool task_sched_get_stats(uint8_t index, task_sched_stats_t* stats) {
+    if (index >= task_count || !stats) {
+        return false;
+    }
+    *stats = tasks[index].stats;
+    return true;
+}
+
+const char* task_sched_get_name(uint8_t index) {
+    return (index < task_count) ? tasks[index].stats.name : "?";
+}
+
+uint32_t task_sched_get_shed_ticks(void) {
+    return shed_ticks;
+}
+
+void task_sched_request_reset(void) {
+    reset_requested = true;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file task_sched.h
+ * @brief Core1 Multi-Rate Task Scheduler
+ *
+ * Rate-monotonic table of the work Core1 does around the physics tick.
+ * Each task has a period in ticks:
+ *
+ *   1      every tick, in the hard real-time slot (control law, dynamics)
+ *   N > 1  every N ticks (thermal model, slow protections); tasks of the
+ *          same period are phase-staggered so they do not share a tick
+ *   0      idle: once per tick in the slack after the tick body, only if
+ *          its budget still fits before the next tick (telemetry block
+ *          encoding); a task skipped TASK_SCHED_IDLE_MAX_SKIP ticks in a
+ *          row runs anyway so its output never goes stale
+ *
+ * Periodic tasks run shortest period first, in registration order within
+ * a period. Every task keeps its own run time statistics against its
+ * budget; Core0 reads them (Table 11) and tolerates a torn update of one
+ * task, like the profiler.
+ *
+ * Budget governor: every task has a priority. Hard real-time tasks
+ * (task_sched_add(): control law, dynamics, publish, protections) always
+ * run. Optional periodic tasks (task_sched_add_optional(): recorders,
+ * history rings, state copies) run only if their cost estimate (the larger
+ * of the registered cost and the last run time) still fits in the tick
+ * budget, measured from the start of task_sched_run_tick(). When it does
+ * not, the governor either defers the task to the slack after the tick
+ * (TASK_SCHED_PRIO_DEFER; dropped if no slack comes before the next tick)
+ * or drops this activation at once (TASK_SCHED_PRIO_SHED). Either way the
+ * next tick starts on time, whatever instrumentation a build enables.
+ *
+ * Tasks are registered at Core1 init; registration is not thread-safe and
+ * the table never shrinks.
+ */
+
+#ifndef TASK_SCHED_H
+#define TASK_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Maximum number of tasks */
+#define TASK_SCHED_MAX_TASKS        8
+
+/** Ticks an idle task may be skipped for lack of slack before it is forced */
+#ifndef TASK_SCHED_IDLE_MAX_SKIP
+#define TASK_SCHED_IDLE_MAX_SKIP    10
+#endif
+
+/** Period value of an idle-time task */
+#define TASK_SCHED_IDLE             0
+
+/**
+ * @brief Task priority (budget governor)
+ */
+typedef enum {
+    TASK_SCHED_PRIO_HARD = 0,   // Always runs
+    TASK_SCHED_PRIO_DEFER,      // Over budget: runs in the slack, or is dropped
+    TASK_SCHED_PRIO_SHED,       // Over budget: dropped for this activation
+    TASK_SCHED_PRIO_COUNT
+} task_sched_prio_t;
+
+/**
+ * @brief Task body (Core1)
+ */
+typedef void (*task_sched_fn_t)(void);
+
+/**
+ * @brief Run time statistics of one task
+ */
+typedef struct {
+    const char* name;
+    uint32_t period_ticks;      // 0 = idle
+    uint32_t budget_us;         // Allowed run time per activation
+    uint32_t runs;              // Activations
+    uint32_t last_us;           // Last run time
+    uint32_t max_us;            // Longest run time
+    uint64_t total_us;          // Sum (mean = total / runs)
+    uint32_t overruns;          // Runs longer than budget_us
+    uint32_t skipped;           // Idle only: ticks ended without a run
+    uint8_t priority;           // task_sched_prio_t
+    uint32_t deferred;          // Activations moved to the slack by the governor
+    uint32_t shed;              // Activations dropped by the governor
+} task_sched_stats_t;
+
+/**
+ * @brief Register a task (Core1 init)
+ *
+ * @param name Short name (console)
+ * @param fn Task body
+ * @param period_ticks 1 = every tick, N = every N ticks, TASK_SCHED_IDLE
+ * @param budget_us Allowed run time per activation
+ * @return Task index, or -1 if the table is full
+ */
+int task_sched_add(const char* name, task_sched_fn_t fn, uint32_t period_ticks, uint32_t budget_us);
+
+/**
+ * @brief Register an optional periodic task (Core1 init)
+ *
+ * @param name Short name (console)
+ * @param fn Task body
+ * @param period_ticks 1 = every tick, N = every N ticks
+ * @param cost_us Estimated run time per activation (also its budget)
+ * @param priority TASK_SCHED_PRIO_DEFER or TASK_SCHED_PRIO_SHED
+ * @return Task index, or -1 if the table is full or the arguments are invalid
+ */
+int task_sched_add_optional(const char* name, task_sched_fn_t fn, uint32_t period_ticks,
+                            uint32_t cost_us, task_sched_prio_t priority);
+
+/**
+ * @brief Set the budget the governor holds optional tasks to (Core1 init)
+ *
+ * @param budget_us Time from the start of task_sched_run_tick() by which
+ *                  optional work must be done (0 = governor off)
+ */
+void task_sched_set_tick_budget(uint32_t budget_us);
+
+/**
+ * @brief Run the periodic tasks due on this tick (Core1)
+ *
+ * Also re-arms the idle tasks for the slack that follows, and drops the
+ * deferred tasks the previous slack could not fit.
+ *
+ * @param tick Tick number (phase of the slower tasks)
+ */
+void task_sched_run_tick(uint32_t tick);
+
+/**
+ * @brief Run deferred and armed idle tasks that fit before a deadline (Core1)
+ *
+ * A task fits when the larger of its budget and its last run time ends
+ * before deadline_us. Deferred periodic tasks go first.
+ *
+ * @param deadline_us time_us_64() by which idle work must be done
+ * @return Microseconds spent in idle tasks
+ */
+uint32_t task_sched_run_idle(uint64_t deadline_us);
+
+/**
+ * @brief Get the number of registered tasks
+ *
+ * @return Task count
+ */
+uint8_t task_sched_get_count(void);
+
+/**
+ * @brief Get the statistics of one task
+ *
+ * @param index Task index (registration order)
+ * @param stats Output: copy of the task statistics
+ * @return false for an invalid index
+ */
+bool task_sched_get_stats(uint8_t index, task_sched_stats_t* stats);
+
+/**
+ * @brief Get the name of one task
+ *
+ * @param index Task index
+ * @return Name, or "?" for an invalid index
+ */
+const char* task_sched_get_name(uint8_t index);
+
+/**
+ * @brief Get the number of ticks on which the governor deferred or dropped work
+ *
+ * @return Tick count (since boot or the last reset)
+ */
+uint32_t task_sched_get_shed_ticks(void);
+
+/**
+ * @brief Request a statistics reset (any core, applied on the next tick)
+ */
+void task_sched_request_reset(void);
+
+#endif // TASK_SCHED_H
@@ -0,0 +1,123 @@
+/**
+ * @file tick_trace.c
+ * @brief Core1 Physics Tick Timing Trace Implementation
+ */
+
+#include "tick_trace.h"
+#include "board_pico.h"
+#include "timebase.h"
+#include "config/scenario.h"
+#include "pico/platform.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+
+// ============================================================================
+// Internal State
+// ============================================================================
+
+static latency_hist_t exec_hist;
+
+static tick_sample_t miss_ring[TICK_TRACE_DEPTH];
+static volatile uint32_t miss_total = 0;   // Published after the entry is written
+
+static volatile bool reset_pending = false;
+
+// ============================================================================
+// Core1 API
+// ============================================================================
+
+bool __not_in_flash_func(tick_trace_record)(const tick_sample_t* sample) {
+    if (reset_pending) {
+        latency_hist_reset(&exec_hist);
+        miss_total = 0;
+        reset_pending = false;
+    }
+
+    latency_hist_record(&exec_hist, sample->exec_us);
+
+    if (sample->wake_us + sample->exec_us <= MAX_TICK_JITTER_US) {
+        return false;
+    }
+
+    uint32_t total = miss_total;
+    miss_ring[total & (TICK_TRACE_DEPTH - 1)] = *sample;
+    __dmb();  // Entry visible before the count that publishes it
+    miss_total = total + 1;
+    return true;
+}
+
+// ============================================================================
+// Core0 API
+// ============================================================================
+
+void tick_trace_get_exec(latency_summary_t* summary) {
+    if (summary) latency_hist_summarize(&exec_hist, summary);
+}
+
+uint32_t tick_trace_get_miss_count(void) {
+    return miss_total;
+}
+
+uint8_t tick_trace_get_misses(tick_sample_t* out, uint8_t max) {
+    uint32_t total;
+    uint8_t n;
+
+    // Retry if Core1 pushed a miss during the copy (at most one per tick)
+    do {
+        total = miss_total;
+        __dmb();
+        n = (total < TICK_TRACE_DEPTH) ? (uint8_t)total : TICK_TRACE_DEPTH;
+        if (n > max) {
+            n = max;
+        }
+        for (uint8_t i = 0; i < n; i++) {
+            out[i] = miss_ring[(total - 1 - i) & (TICK_TRACE_DEPTH - 1)];
+        }
+        __dmb();
+    } while (total != miss_total);
+
+    return n;
+}
+
+void tick_trace_request_reset(void) {
+    reset_pending = true;
+}
+
+void tick_trace_dump(void) {
+    latency_summary_t exec;
+    latency_summary_t wake;
+    tick_trace_get_exec(&exec);
+    timebase_get_wake_latency(&wake);
+
+    printf("[TICK] Physics tick timing (us, deadline %u us after alarm target)\n",
+           (unsigned)MAX_TICK_JITTER_US);
+    printf("%-6s %10s %6s %6s %6s %6s %6s\n", "", "count", "p50", "p90", "p99", "p99.9", "max");
+    printf("%-6s %10lu %6lu %6lu %6lu %6lu %6lu\n", "exec", (unsigned long)exec.count,
+           (unsigned long)exec.p50_us, (unsigned long)exec.p90_us, (unsigned long)exec.p99_us,
+           (unsigned long)exec.p999_us, (unsigned long)exec.max_us);
+    printf("%-6s %10lu %6lu %6lu %6lu %6lu %6lu\n", "wake", (unsigned long)wake.count,
+           (unsigned long)wake.p50_us, (unsigned long)wake.p90_us, (unsigned long)wake.p99_us,
+           (unsigned long)wake.p999_us, (unsigned long)wake.max_us);
+
+    tick_sample_t misses[TICK_TRACE_DEPTH];
+    uint8_t n = tick_trace_get_misses(misses, TICK_TRACE_DEPTH);
+    printf("[TICK] Deadline misses: %lu (last %u, newest first)\n",
+           (unsigned long)tick_trace_get_miss_count(), (unsigned)n);
+    if (n == 0) {
+        return;
+    }
+
+    printf("%10s %6s %6s %4s %4s %5s %4s %4s\n",
+           "tick", "exec", "wake", "mode", "test", "event", "cmd", "ncmd");
+    for (uint8_t i = 0; i < n; i++) {
+        const tick_sample_t* m = &misses[i];
+        printf("%10lu %6lu %6lu %4u %4u ", (unsigned long)m->tick, (unsigned long)m->exec_us,
+               (unsigned long)m->wake_us, (unsigned)m->mode, (unsigned)m->test_mode);
+        if (m->scenario_event == SCENARIO_NO_EVENT) {
+            printf("%5s", "-");
+        } else {
+            printf("%5u", (unsigned)m->scenario_event);
+        }
+        printf(" %4u %4u\n", (unsigned)m->cmd_type, (unsigned)m->cmd_count);
+    }
+}
@@ -0,0 +1,96 @@
+/**
+ * @file tick_trace.h
+ * @brief Core1 Physics Tick Timing Trace
+ *
+ * Histogram of per-tick execution time (command drain + physics, the span
+ * reported as jitter_us) and a ring of the last TICK_TRACE_DEPTH deadline
+ * misses with enough context to correlate them: tick number, control mode,
+ * active test mode, last triggered scenario event and the commands applied
+ * in that tick.
+ *
+ * A tick misses its deadline when wake-up latency plus execution time
+ * exceeds MAX_TICK_JITTER_US, i.e. the physics update finished more than
+ * the jitter budget after the alarm target.
+ *
+ * Core1 is the only writer (tick_trace_record() once per tick). Core0
+ * reads the ring consistently and requests resets, which Core1 applies
+ * on its next tick.
+ */
+
+#ifndef TICK_TRACE_H
+#define TICK_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "latency_hist.h"
+
+/** Deadline misses kept in the ring (power of 2) */
+#define TICK_TRACE_DEPTH    16
+
+/**
+ * @brief Timing and context of one physics tick
+ */
+typedef struct {
+    uint32_t tick;              // Core1 tick number
+    uint32_t exec_us;           // Command drain + physics (all wheels)
+    uint32_t wake_us;           // Alarm wake-up latency of this tick
+    uint8_t mode;               // Control mode of wheel 0 (control_mode_t)
+    uint8_t test_mode;          // Active test mode (test_mode_id_t)
+    uint8_t scenario_event;     // Last triggered scenario event (SCENARIO_NO_EVENT if none)
+    uint8_t cmd_type;           // Last command applied this tick (command_type_t, CMD_NONE if none)
+    uint8_t cmd_count;          // Commands applied this tick (saturates at 255)
+} tick_sample_t;
+
+// ============================================================================
+// Core1 API
+// ============================================================================
+
+/**
+ * @brief Record one tick (call once per tick on Core1)
+ *
+ * Adds exec_us to the histogram and pushes the sample into the
+ * deadline-miss ring if it missed. Applies a pending reset first.
+ *
+ * @param sample Tick timing and context
+ * @return true if the tick missed its deadline
+ */
+bool tick_trace_record(const tick_sample_t* sample);
+
+// ============================================================================
+// Core0 API
+// ============================================================================
+
+/**
+ * @brief Get the execution-time distribution
+ *
+ * @param summary Output: percentile summary since the last reset
+ */
+void tick_trace_get_exec(latency_summary_t* summary);
+
+/**
+ * @brief Get the number of deadline misses since the last reset
+ *
+ * @return Miss count (may exceed TICK_TRACE_DEPTH)
+ */
+uint32_t tick_trace_get_miss_count(void);
+
+/**
+ * @brief Copy the most recent deadline misses
+ *
+ * @param out Output: entries, newest first
+ * @param max Capacity of out
+ * @return Number of entries copied (at most TICK_TRACE_DEPTH)
+ */
+uint8_t tick_trace_get_misses(tick_sample_t* out, uint8_t max);
+
+/**
+ * @brief Ask Core1 to clear the histogram and the ring on its next tick
+ */
+void tick_trace_request_reset(void);
+
+/**
+ * @brief Print the execution and wake-up histograms and the miss ring to stdout
+ */
+void tick_trace_dump(void);
+
+#endif // TICK_TRACE_H
@@ -0,0 +1,181 @@
+/**
+ * @file trend.c
+ * @brief Core1 Multi-Resolution Telemetry History Implementation
+ */
+
+#include "trend.h"
+#include "hot_path.h"
+#include "hardware/sync.h"
+
+#define RPM_PER_RAD_S           9.549296586f    // 30/π
+
+/**
+ * @brief Open bucket of one quantity
+ */
+typedef struct {
+    float min;
+    float max;
+    float sum;                  // Of the inputs (ticks, or the finer means)
+} trend_accum_t;
+
+/**
+ * @brief Closed bucket as stored in the rings (× the quantity's scale)
+ */
+typedef struct {
+    int16_t min;
+    int16_t max;
+    int16_t mean;
+} trend_packed_t;
+
+// Inputs that close a bucket: ticks, then buckets of the finer resolution
+static const uint16_t HOT_PATH_DATA("trend") inputs_per_bucket[TREND_RES_COUNT] = {
+    PHYSICS_TICK_RATE_HZ, 10, 6,
+};
+static const float HOT_PATH_DATA("trend") scales[TREND_QTY_COUNT] = {
+    TREND_SPEED_SCALE, TREND_CURRENT_SCALE, TREND_POWER_SCALE,
+};
+
+// Core1 only
+static trend_accum_t acc[TREND_RES_COUNT][EMULATED_WHEEL_COUNT][TREND_QTY_COUNT];
+static uint16_t acc_inputs[TREND_RES_COUNT];
+
+// Written by Core1, read by Core0 once published in ring_count
+static trend_packed_t ring[TREND_RES_COUNT][EMULATED_WHEEL_COUNT][TREND_QTY_COUNT][TREND_BUCKETS];
+static volatile uint32_t ring_count[TREND_RES_COUNT];   // Buckets closed since the reset
+
+// Requested by Core0, applied by Core1 (start with a clean history)
+static volatile bool reset_pending = true;
+
+// ============================================================================
+// Core1 API
+// ============================================================================
+
+static inline int16_t to_i16(float value, float scale) {
+    float x = value * scale;
+    if (x >= 32767.0f) {
+        return INT16_MAX;
+    }
+    if (x <= -32768.0f) {
+        return INT16_MIN;
+    }
+    return (int16_t)x;
+}
+
+/**
+ * @brief Fold one input into an open bucket (the first input opens it)
+ */
+static inline void fold(trend_accum_t* a, bool first, float min, float max, float value) {
+    if (first) {
+        a->min = min;
+        a->max = max;
+        a->sum = value;
+        return;
+    }
+    if (min < a->min) {
+        a->min = min;
+    }
+    if (max > a->max) {
+        a->max = max;
+    }
+    a->sum += value;
+}
+
+/**
+ * @brief Close the open buckets of a resolution into its ring
+ *
+ * Each closed bucket is one input of the next resolution's open bucket.
+ */
+static void HOT_PATH_FUNC(close_buckets)(uint32_t res) {
+    float n = (float)inputs_per_bucket[res];
+    uint32_t slot = ring_count[res] % TREND_BUCKETS;
+    bool next = (res + 1u < TREND_RES_COUNT);
+    bool first = next && (acc_inputs[res + 1u] == 0);
+
+    for (uint32_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        for (uint32_t q = 0; q < TREND_QTY_COUNT; q++) {
+            const trend_accum_t* a = &acc[res][w][q];
+            float mean = a->sum / n;
+            trend_packed_t* b = &ring[res][w][q][slot];
+            b->min = to_i16(a->min, scales[q]);
+            b->max = to_i16(a->max, scales[q]);
+            b->mean = to_i16(mean, scales[q]);
+            if (next) {
+                fold(&acc[res + 1u][w][q], first, a->min, a->max, mean);
+            }
+        }
+    }
+
+    __dmb();    // Bucket complete before Core0 sees it counted
+    ring_count[res] = ring_count[res] + 1u;
+    acc_inputs[res] = 0;
+    if (next) {
+        acc_inputs[res + 1u]++;
+    }
+}
+
+void HOT_PATH_FUNC(trend_record)(const wheel_state_t* wheels) {
+    if (reset_pending) {
+        for (uint32_t r = 0; r < TREND_RES_COUNT; r++) {
+            acc_inputs[r] = 0;
+            ring_count[r] = 0;
+        }
+        reset_pending = false;
+    }
+
+    bool first = (acc_inputs[TREND_RES_1S] == 0);
+    for (uint32_t w = 0; w < EMULATED_WHEEL_COUNT; w++) {
+        const wheel_state_t* ws = &wheels[w];
+        float rpm = ws->omega_rad_s * RPM_PER_RAD_S;
+        trend_accum_t* a = acc[TREND_RES_1S][w];
+        fold(&a[TREND_SPEED], first, rpm, rpm, rpm);
+        fold(&a[TREND_CURRENT], first, ws->current_out_a, ws->current_out_a, ws->current_out_a);
+        fold(&a[TREND_POWER], first, ws->power_w, ws->power_w, ws->power_w);
+    }
+
+    // A full bucket closes, and may fill the next resolution's
+    acc_inputs[TREND_RES_1S]++;
+    for (uint32_t r = 0; r < TREND_RES_COUNT && acc_inputs[r] == inputs_per_bucket[r]; r++) {
+        close_buckets(r);
+    }
+}
+
+// ============================================================================
+// Core0 API
+// ============================================================================
+
+void trend_reset(void) {
+    reset_pending = true;
+}
+
+uint32_t trend_bucket_seconds(trend_res_t res) {
+    uint32_t seconds = 1;
+    for (uint32_t r = TREND_RES_1S + 1u; r <= (uint32_t)res && r < TREND_RES_COUNT; r++) {
+        seconds *= inputs_per_bucket[r];
+    }
+    return seconds;
+}
+
+uint32_t trend_read(uint8_t wheel, trend_res_t res, trend_qty_t qty, trend_bucket_t* out,
+                    uint32_t max) {
+    if (wheel >= EMULATED_WHEEL_COUNT || res >= TREND_RES_COUNT || qty >= TREND_QTY_COUNT ||
+        reset_pending) {
+        return 0;
+    }
+
+    uint32_t count = ring_count[res];
+    __dmb();
+    uint32_t n = (count < TREND_BUCKETS) ? count : TREND_BUCKETS;
+    if (n > max) {
+        n = max;
+    }
+
+    // Newest n buckets, oldest first
+    float scale = scales[qty];
+    for (uint32_t i = 0; i < n; i++) {
+        const trend_packed_t* b = &ring[res][wheel][qty][(count - n + i) % TREND_BUCKETS];
+        out[i].min = (float)b->min / scale;
+        out[i].max = (float)b->max / scale;
+        out[i].mean = (float)b->mean / scale;
+    }
+    return n;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file trend.h
+ * @brief Core1 Multi-Resolution Telemetry History (Trend Rings)
+ *
+ * Keeps min/max/mean buckets of wheel speed, current and power at three
+ * resolutions (1 s, 10 s, 60 s), TREND_BUCKETS of each, for the console's
+ * trend view. Core1 folds every tick into the open 1 s bucket (two
+ * compares and an add per value); a closed bucket is folded into the next
+ * resolution's open bucket the same way, so the work per tick is bounded
+ * and Core0 never recomputes an aggregate.
+ *
+ * Core1 is the only writer: a bucket is written into its ring before the
+ * ring's count is published, and Core0 reads the published buckets. A
+ * reader slower than a whole ring sees the oldest bucket replaced by a
+ * newer one, which a trend plot tolerates.
+ *
+ * Cost: 9 float compares/adds per wheel per tick, plus 9 int16
+ * conversions and folds per wheel for each bucket closed (once a second,
+ * more rarely for the coarser rings).
+ */
+
+#ifndef TREND_H
+#define TREND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "board_pico.h"
+#include "nss_nrwa_t6_model.h"
+
+/** Buckets kept per resolution (one sparkline row) */
+#ifndef TREND_BUCKETS
+#define TREND_BUCKETS           60
+#endif
+
+/**
+ * @brief Bucket resolutions (each bucket is a fixed number of the finer ones)
+ */
+typedef enum {
+    TREND_RES_1S = 0,           // PHYSICS_TICK_RATE_HZ ticks
+    TREND_RES_10S,              // 10 one-second buckets
+    TREND_RES_60S,              // 6 ten-second buckets
+    TREND_RES_COUNT
+} trend_res_t;
+
+/**
+ * @brief Tracked quantities
+ */
+typedef enum {
+    TREND_SPEED = 0,            // Wheel speed (RPM, signed)
+    TREND_CURRENT,              // Actual current (A)
+    TREND_POWER,                // Electrical power (W)
+    TREND_QTY_COUNT
+} trend_qty_t;
+
+// Ring storage scaling (value = raw / scale)
+#define TREND_SPEED_SCALE       1.0f        // 1 RPM        (±32767 RPM)
+#define TREND_CURRENT_SCALE     1000.0f     // mA           (±32.7 A)
+#define TREND_POWER_SCALE       100.0f      // 0.01 W       (±327 W)
+
+/**
+ * @brief One bucket in engineering units
+ */
+typedef struct {
+    float min;
+    float max;
+    float mean;
+} trend_bucket_t;
+
+// ============================================================================
+// Core1 API
+// ============================================================================
+
+/**
+ * @brief Fold one tick of every wheel into the open buckets (Core1, every tick)
+ *
+ * Applies a pending trend_reset() first.
+ *
+ * @param wheels Wheel states (EMULATED_WHEEL_COUNT)
+ */
+void trend_record(const wheel_state_t* wheels);
+
+// ============================================================================
+// Core0 API
+// ============================================================================
+
+/**
+ * @brief Discard the history (applied on Core1's next tick)
+ */
+void trend_reset(void);
+
+/**
+ * @brief Get the duration of one bucket
+ *
+ * @param res Resolution
+ * @return Seconds per bucket
+ */
+uint32_t trend_bucket_seconds(trend_res_t res);
+
+/**
+ * @brief Copy the newest buckets of one ring, oldest first
+ *
+ * @param wheel Wheel index
+ * @param res Resolution
+ * @param qty Quantity
+ * @param out Output: up to max buckets
+ * @param max Capacity of out
+ * @return Buckets copied (fewer than TREND_BUCKETS until the ring fills)
+ */
+uint32_t trend_read(uint8_t wheel, trend_res_t res, trend_qty_t qty, trend_bucket_t* out,
+                    uint32_t max);
+
+#endif // TREND_H
@@ -0,0 +1,181 @@
+/**
+ * @file test_bus_hub.c
+ * @brief Virtual Bus Hub Delivery
+ *
+ * Usage: test_bus_hub NRWA_BUS
+ *
+ * Starts nrwa_bus on a free loopback port and connects three TCP nodes.
+ * Frames sent by one node must reach each of the others unchanged (as on
+ * the multi-drop bus, including frames for another address) and never
+ * come back to the sender.
+ */
+
+#define _GNU_SOURCE
+
+#include "bus_transport.h"
+#include "nsp.h"
+#include "crc_ccitt.h"
+#include "slip.h"
+#include "unit_test.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define NODES               3
+#define OBC_ADDR            0x11
+#define QUIET_MS            100         // No more bytes expected after this
+#define JOIN_ATTEMPTS       50
+
+static bus_transport_t node[NODES];
+
+/**
+ * @brief A loopback port nothing listens on right now
+ */
+static int free_port(void) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    socklen_t len = sizeof(addr);
+    if (fd < 0 || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        getsockname(fd, (struct sockaddr*)&addr, &len) != 0) {
+        return -1;
+    }
+    close(fd);
+    return ntohs(addr.sin_port);
+}
+
+/**
+ * @brief Everything a node receives until the bus goes quiet
+ */
+static size_t drain(bus_transport_t* t, uint8_t* buf, size_t cap) {
+    size_t len = 0;
+    struct pollfd pfd = { .fd = bus_transport_fd(t), .events = POLLIN };
+    while (len < cap && poll(&pfd, 1, QUIET_MS) > 0) {
+        ssize_t n = bus_transport_read(t, buf + len, cap - len);
+        if (n <= 0) {
+            break;
+        }
+        len += (size_t)n;
+    }
+    return len;
+}
+
+static size_t build_frame(uint8_t dest, uint8_t src, bool poll_bit, uint8_t command,
+                          const uint8_t* payload, size_t payload_len, uint8_t* out) {
+    uint8_t pkt[NSP_MAX_PACKET_SIZE];
+    pkt[0] = dest;
+    pkt[1] = src;
+    pkt[2] = nsp_make_ctrl(poll_bit, false, !poll_bit, command);
+    memcpy(&pkt[3], payload, payload_len);
+    size_t len = crc_ccitt_append(pkt, 3 + payload_len);
+    size_t out_len = 0;
+    slip_encode(pkt, len, out, &out_len);
+    return out_len;
+}
+
+/**
+ * @brief Send from one node; every other node must get exactly these bytes
+ */
+static void check_delivery(int from, const uint8_t* frame, size_t len, const char* what) {
+    bus_transport_write(&node[from], frame, len);
+    for (int n = 0; n < NODES; n++) {
+        uint8_t got[512];
+        size_t got_len = drain(&node[n], got, sizeof(got));
+        if (n == from) {
+            UT_CHECK(got_len == 0, "%s: sender %d got %u bytes back", what, from, (unsigned)got_len);
+        } else {
+            UT_CHECK(got_len == len && memcmp(got, frame, len) == 0,
+                     "%s: node %d got %u bytes, expected the %u sent by node %d", what, n,
+                     (unsigned)got_len, (unsigned)len, from);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s NRWA_BUS\n", argv[0]);
+        return 2;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    int port = free_port();
+    UT_CHECK(port > 0, "no free port");
+    char listen_spec[32], connect_spec[48];
+    snprintf(listen_spec, sizeof(listen_spec), "127.0.0.1:%d", port);
+    snprintf(connect_spec, sizeof(connect_spec), "tcp:127.0.0.1:%d", port);
+
+    pid_t hub = fork();
+    if (hub == 0) {
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDERR_FILENO);   // Hub log
+        }
+        execl(argv[1], argv[1], "--listen", listen_spec, (char*)NULL);
+        _exit(127);
+    }
+
+    // Connect once the hub listens
+    bool connected = false;
+    for (int attempt = 0; attempt < JOIN_ATTEMPTS && !connected; attempt++) {
+        usleep(20000);
+        int stderr_fd = dup(STDERR_FILENO);     // Refused connects are expected here
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, STDERR_FILENO);
+        connected = bus_transport_open(&node[0], connect_spec);
+        dup2(stderr_fd, STDERR_FILENO);
+        close(devnull);
+        close(stderr_fd);
+    }
+    UT_CHECK(connected, "hub not listening on %s", listen_spec);
+    for (int n = 1; n < NODES && connected; n++) {
+        connected = bus_transport_open(&node[n], connect_spec);
+        UT_CHECK(connected, "node %d cannot connect", n);
+    }
+
+    if (connected) {
+        // The hub accepts asynchronously: wait until every node hears node 0
+        static const uint8_t end = 0xC0;    // Empty SLIP frame, ignored by receivers
+        bool joined = false;
+        for (int attempt = 0; attempt < JOIN_ATTEMPTS && !joined; attempt++) {
+            bus_transport_write(&node[0], &end, 1);
+            joined = true;
+            for (int n = 1; n < NODES; n++) {
+                uint8_t got[64];
+                joined &= drain(&node[n], got, sizeof(got)) > 0;
+            }
+        }
+        UT_CHECK(joined, "nodes never joined the bus");
+        for (int n = 0; n < NODES; n++) {
+            uint8_t got[64];
+            drain(&node[n], got, sizeof(got));
+        }
+
+        // OBC request, a wheel's reply, and a frame full of SLIP escapes
+        uint8_t frame[2 * NSP_MAX_PACKET_SIZE + 2];
+        size_t len = build_frame(0x00, OBC_ADDR, true, NSP_CMD_PING, NULL, 0, frame);
+        check_delivery(0, frame, len, "request");
+
+        static const uint8_t version[] = { 0x01, 0x00, 0x00, 0x00 };
+        len = build_frame(OBC_ADDR, 0x00, false, NSP_CMD_PING, version, sizeof(version), frame);
+        check_delivery(1, frame, len, "reply");
+
+        static const uint8_t escapes[] = { 0xC0, 0xDB, 0xC0, 0xDB, 0xDC, 0xDD };
+        len = build_frame(0x01, OBC_ADDR, true, NSP_CMD_POKE, escapes, sizeof(escapes), frame);
+        check_delivery(2, frame, len, "escaped");
+
+        for (int n = 0; n < NODES; n++) {
+            bus_transport_close(&node[n]);
+        }
+    }
+
+    kill(hub, SIGTERM);
+    int status = 0;
+    waitpid(hub, &status, 0);
+    UT_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0, "hub did not stop cleanly");
+    return ut_finish("bus_hub");
+}
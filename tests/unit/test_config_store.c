@@ -0,0 +1,174 @@
+/**
+ * @file test_config_store.c
+ * @brief Configuration Store Power-Cut Recovery
+ *
+ * Drives config_store on the host flash image (host/flash_store_host.c):
+ * appends, a compaction into the next sector, then cuts the power at each
+ * point a write can be interrupted (half-programmed record, compaction
+ * before its header, half-programmed header, cut mid-erase) by rebuilding
+ * the image as flash would have been left, reloads, and checks that the
+ * last committed values come back and that the store keeps working.
+ */
+
+#include "config_store.h"
+#include "board_pico.h"
+#include "util/flash_store.h"
+#include "unit_test.h"
+#include <string.h>
+
+#define KEYS                3           // Keys 1..KEYS
+#define RECORD_SIZE         8
+#define HEADER_SIZE         16
+#define LOG_SECTORS         (FLASH_CONFIG_SIZE / FLASH_SECTOR_SIZE)
+#define LOG_MAGIC           0x4746434Eu     // "NCFG", little-endian in flash
+
+static uint8_t before[FLASH_CONFIG_SIZE];
+static uint8_t after[FLASH_CONFIG_SIZE];
+static uint32_t expected[KEYS + 1];     // Last committed value per key
+
+static uint8_t* partition(void) {
+    return &flash_store_host_image[FLASH_CONFIG_OFFSET];
+}
+
+static void snapshot(uint8_t* image) {
+    memcpy(image, partition(), FLASH_CONFIG_SIZE);
+}
+
+/**
+ * @brief Set and commit one key
+ */
+static bool commit(uint16_t key, uint32_t value) {
+    if (!config_store_set(key, value, 0) || !config_store_commit()) {
+        return false;
+    }
+    expected[key] = value;
+    return true;
+}
+
+/**
+ * @brief Reboot: rebuild the index from flash and compare every key
+ */
+static void reload_and_check(const char* step) {
+    uint32_t keys = config_store_init();
+    UT_CHECK(keys == KEYS, "%s: %u keys restored, expected %u", step, (unsigned)keys, KEYS);
+    for (uint16_t key = 1; key <= KEYS; key++) {
+        uint32_t value = 0;
+        bool found = config_store_get(key, &value);
+        UT_CHECK(found && value == expected[key], "%s: key %u = %s%u, expected %u", step,
+                 (unsigned)key, found ? "" : "(missing) ", (unsigned)value, (unsigned)expected[key]);
+    }
+}
+
+/**
+ * @brief First byte the last write changed (-1 if none)
+ */
+static int32_t first_change(void) {
+    for (uint32_t i = 0; i < FLASH_CONFIG_SIZE; i++) {
+        if (before[i] != after[i]) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Commit one key with the power cut after the first `kept` changed
+ *        bytes reached flash; the committed value is not expected back
+ */
+static void torn_commit(uint16_t key, uint32_t value, uint32_t kept, const char* step) {
+    uint32_t last_good = expected[key];
+    snapshot(before);
+    UT_CHECK(commit(key, value), "%s: commit refused", step);
+    snapshot(after);
+    int32_t at = first_change();
+    UT_CHECK(at >= 0, "%s: commit changed nothing", step);
+
+    memcpy(partition(), before, FLASH_CONFIG_SIZE);
+    memcpy(partition() + at, after + at, kept);
+    expected[key] = last_good;
+    reload_and_check(step);
+}
+
+/**
+ * @brief Commit single changes until one compacts into the next sector
+ *
+ * @return Sector the compaction wrote (images before/after it saved)
+ */
+static int32_t commit_until_compaction(uint16_t key, const char* step) {
+    config_store_stats_t s0, s1;
+    config_store_get_stats(&s0);
+    for (uint32_t n = 0; n < FLASH_SECTOR_SIZE / RECORD_SIZE + 1; n++) {
+        snapshot(before);
+        UT_CHECK(commit(key, expected[key] + 1), "%s: commit %u refused", step, (unsigned)n);
+        config_store_get_stats(&s1);
+        if (s1.compactions != s0.compactions) {
+            snapshot(after);
+            UT_CHECK(s1.generation == s0.generation + 1, "%s: generation %u after %u", step,
+                     (unsigned)s1.generation, (unsigned)s0.generation);
+            return first_change() / FLASH_SECTOR_SIZE;
+        }
+    }
+    UT_CHECK(false, "%s: a full sector did not compact", step);
+    return -1;
+}
+
+int main(void) {
+    UT_CHECK(config_store_erase(), "erase refused");
+    UT_CHECK(config_store_init() == 0, "erased store restored keys");
+
+    // Append and reload
+    for (uint16_t key = 1; key <= KEYS; key++) {
+        UT_CHECK(commit(key, 1000u * key), "first commit of key %u refused", (unsigned)key);
+    }
+    reload_and_check("append");
+
+    // Half-programmed record: key and CRC reached flash, the value did not
+    torn_commit(1, 0x12345678u, 4, "torn record");
+    UT_CHECK(commit(1, 1111u), "commit after torn record refused");
+    reload_and_check("after torn record");
+
+    // Compaction when the sector is full
+    int32_t target = commit_until_compaction(2, "compaction");
+    reload_and_check("compaction");
+
+    // Cut during compaction: records in the new sector, header not yet programmed
+    target = commit_until_compaction(3, "compaction 2");
+    uint32_t last_good = expected[3] - 1;
+    memcpy(partition(), after, FLASH_CONFIG_SIZE);
+    memset(partition() + target * FLASH_SECTOR_SIZE, 0xFF, HEADER_SIZE);
+    expected[3] = last_good;
+    reload_and_check("compaction cut before header");
+
+    // Half-programmed header: magic and generation written, check word erased
+    memcpy(partition(), after, FLASH_CONFIG_SIZE);
+    memset(partition() + target * FLASH_SECTOR_SIZE + 8, 0xFF, HEADER_SIZE - 8);
+    reload_and_check("half-programmed header");
+
+    // The store recovers: the next compaction redoes the interrupted one
+    target = commit_until_compaction(3, "recompaction");
+    reload_and_check("recompaction");
+
+    // Go round the partition so the next target still holds an old log,
+    // then cut its erase half way (erased front, or header still intact)
+    for (uint32_t lap = 0; lap < LOG_SECTORS; lap++) {
+        commit_until_compaction(1, "lap");
+    }
+    target = commit_until_compaction(2, "erase");
+    uint32_t old_magic;
+    memcpy(&old_magic, before + target * FLASH_SECTOR_SIZE, sizeof(old_magic));
+    UT_CHECK(old_magic == LOG_MAGIC, "erase: target sector %d held no old log", (int)target);
+    last_good = expected[2] - 1;
+    expected[2] = last_good;
+    memcpy(partition(), before, FLASH_CONFIG_SIZE);
+    memset(partition() + target * FLASH_SECTOR_SIZE, 0xFF, FLASH_SECTOR_SIZE / 2);
+    reload_and_check("cut mid-erase (front erased)");
+    memcpy(partition(), before, FLASH_CONFIG_SIZE);
+    memset(partition() + target * FLASH_SECTOR_SIZE + FLASH_SECTOR_SIZE / 2, 0xFF,
+           FLASH_SECTOR_SIZE / 2);
+    reload_and_check("cut mid-erase (header intact)");
+
+    UT_CHECK(commit(2, 2222u), "commit after cut erase refused");
+    reload_and_check("after cut erase");
+
+    return ut_finish("config_store");
+}
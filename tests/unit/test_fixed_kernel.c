@@ -0,0 +1,120 @@
+/**
+ * @file test_fixed_kernel.c
+ * @brief Fixed-Point Dynamics Kernel vs Float Reference
+ *
+ * Runs the same CURRENT-mode profile (spin-up, coast, reversal through
+ * zero, restart from a crawl) with INTEGRATOR_EULER and with the Q-format
+ * kernels (INTEGRATOR_FIXED, INTEGRATOR_LUT) and checks that ω and the
+ * published torques agree every tick. Built once per tick rate and wheel
+ * profile (tests/unit/CMakeLists.txt), so the folded coefficients are
+ * checked at both ends of the 10-1000 Hz range.
+ */
+
+#include "nss_nrwa_t6_model.h"
+#include "unit_test.h"
+#include <math.h>
+
+// ============================================================================
+// Test Profile
+// ============================================================================
+
+#define PHASE_TICKS         (2u * MODEL_TICK_RATE_HZ)   // 2 s per phase
+
+// Tolerances: ω relative to the top speed of the phase (at least
+// OMEGA_SCALE_MIN of the overspeed fault), torque relative to k_t·i
+#define OMEGA_SCALE_MIN     0.05f
+#define OMEGA_TOLERANCE     2.0e-3f
+#define TORQUE_TOLERANCE    2.0e-3f
+
+/**
+ * @brief Current that takes the wheel to ~40% of the overspeed fault in
+ *        one phase (ignoring losses)
+ */
+static float spin_current_a(void) {
+    float omega_target = 0.4f * DEFAULT_OVERSPEED_FAULT_RPM * RPM_TO_RAD_S;
+    float seconds = (float)PHASE_TICKS / (float)MODEL_TICK_RATE_HZ;
+    return omega_target * WHEEL_INERTIA_KGM2 / (MOTOR_KT_NM_PER_A * seconds);
+}
+
+typedef struct {
+    unsigned ticks;         // Phase length
+    float current_a;        // CURRENT-mode command
+    float omega_start;      // ω written before the phase (NAN = keep)
+} phase_t;
+
+// ============================================================================
+// Comparison
+// ============================================================================
+
+static float max_omega_err;
+static float max_torque_err;
+
+static void run_profile(integrator_mode_t integrator, const char* name) {
+    float i_spin = spin_current_a();
+    float i_crawl = 1.5f * LOSS_COULOMB_B / MOTOR_KT_NM_PER_A;  // Above breakaway and stiction
+    const phase_t phases[] = {
+        { PHASE_TICKS,      i_spin,           NAN },    // Spin up from rest
+        { PHASE_TICKS,      0.0f,             NAN },    // Coast (losses only)
+        { 2 * PHASE_TICKS, -i_spin,           NAN },    // Brake through zero, spin back up
+        { PHASE_TICKS,      0.0f,             NAN },    // Coast
+        { PHASE_TICKS,      i_crawl,          0.005f }, // Restart from a crawl (Coulomb ramp)
+    };
+
+    wheel_state_t ref;
+    wheel_state_t fx;
+    wheel_model_init(&ref);
+    wheel_model_init(&fx);
+    wheel_model_set_integrator(&fx, integrator, 1);
+
+    float omega_top = 0.0f;
+    float torque_scale = MOTOR_KT_NM_PER_A * 1000.0f * i_spin;
+    max_omega_err = 0.0f;
+    max_torque_err = 0.0f;
+
+    for (unsigned p = 0; p < sizeof(phases) / sizeof(phases[0]); p++) {
+        if (!isnan(phases[p].omega_start)) {
+            ref.omega_rad_s = phases[p].omega_start;
+            fx.omega_rad_s = phases[p].omega_start;
+        }
+        wheel_model_set_current(&ref, phases[p].current_a);
+        wheel_model_set_current(&fx, phases[p].current_a);
+        float omega_scale = fmaxf(fabsf(ref.omega_rad_s),
+                                  OMEGA_SCALE_MIN * DEFAULT_OVERSPEED_FAULT_RPM * RPM_TO_RAD_S);
+
+        for (unsigned t = 0; t < phases[p].ticks; t++) {
+            wheel_model_tick(&ref);
+            wheel_model_tick(&fx);
+
+            if (fabsf(ref.omega_rad_s) > omega_scale) {
+                omega_scale = fabsf(ref.omega_rad_s);
+            }
+            if (omega_scale > omega_top) {
+                omega_top = omega_scale;
+            }
+            float omega_err = fabsf(fx.omega_rad_s - ref.omega_rad_s) / omega_scale;
+            float torque_err = fabsf(fx.torque_out_mnm - ref.torque_out_mnm) / torque_scale;
+            if (omega_err > max_omega_err) max_omega_err = omega_err;
+            if (torque_err > max_torque_err) max_torque_err = torque_err;
+        }
+        UT_CHECK(fx.fault_status == ref.fault_status,
+                 "%s phase %u: faults 0x%08x, reference 0x%08x", name, p,
+                 (unsigned)fx.fault_status, (unsigned)ref.fault_status);
+    }
+
+    // The profile must actually have moved the wheel both ways
+    UT_CHECK(omega_top > 0.2f * DEFAULT_OVERSPEED_FAULT_RPM * RPM_TO_RAD_S,
+             "%s: reference only reached %.1f rad/s", name, omega_top);
+    UT_CHECK(max_omega_err <= OMEGA_TOLERANCE,
+             "%s: omega error %.2e (limit %.0e)", name, max_omega_err, OMEGA_TOLERANCE);
+    UT_CHECK(max_torque_err <= TORQUE_TOLERANCE,
+             "%s: motor torque error %.2e of %.3f mN·m (limit %.0e)", name, max_torque_err,
+             torque_scale, TORQUE_TOLERANCE);
+    printf("[TEST] %s at %u Hz (%s): omega err %.2e, torque err %.2e\n", name,
+           (unsigned)MODEL_TICK_RATE_HZ, WHEEL_PROFILE_NAME, max_omega_err, max_torque_err);
+}
+
+int main(void) {
+    run_profile(INTEGRATOR_FIXED, "FIXED");
+    run_profile(INTEGRATOR_LUT, "LUT");
+    return ut_finish("fixed_kernel");
+}
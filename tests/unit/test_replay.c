@@ -0,0 +1,250 @@
+/**
+ * @file test_replay.c
+ * @brief Record/Replay Round Trip Through the SIL
+ *
+ * Usage: test_replay SIL WORKDIR
+ *
+ * Records a lockstep session (mode commands, SIM-STEPs, telemetry and
+ * PEEKs) with --record, replays it with --replay --record, and checks that
+ * the replay reports no difference and that both captures hold the same
+ * replies, byte for byte and at the same ticks. A capture with one reply
+ * byte changed must then make the replay fail.
+ */
+
+#define _GNU_SOURCE
+
+#include "nsp.h"
+#include "nsp_replay.h"
+#include "crc_ccitt.h"
+#include "slip.h"
+#include "unit_test.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define OBC_ADDR            0x11
+#define REPLY_TIMEOUT_MS    2000
+#define MAX_CAPTURE         (256u * 1024u)
+
+typedef struct {
+    uint8_t command;
+    const char* payload_hex;
+} request_t;
+
+// Every command below answers, so each request waits for one reply
+static const request_t session[] = {
+    { NSP_CMD_PING, "" },
+    { NSP_CMD_APPLICATION_COMMAND, "010000a00f" },     // CURRENT 1000 mA
+    { NSP_CMD_SIM_STEP, "64000000" },                  // 100 ticks
+    { NSP_CMD_APPLICATION_TELEMETRY, "00" },
+    { NSP_CMD_PEEK, "0004" },
+    { NSP_CMD_APPLICATION_COMMAND, "020000e02e" },     // SPEED 3000 RPM
+    { NSP_CMD_SIM_STEP, "f4010000" },                  // 500 ticks
+    { NSP_CMD_APPLICATION_TELEMETRY, "00" },
+    { NSP_CMD_APPLICATION_TELEMETRY, "04" },
+    { NSP_CMD_SIM_STEP, "01000000" },
+    { NSP_CMD_APPLICATION_TELEMETRY, "00" },
+};
+
+// ============================================================================
+// SIL Process
+// ============================================================================
+
+typedef struct {
+    pid_t pid;
+    int to_fd;
+    int from_fd;
+} sil_t;
+
+static bool sil_start(sil_t* sil, char* const argv[]) {
+    int to_sil[2], from_sil[2];
+    if (pipe2(to_sil, O_CLOEXEC) != 0 || pipe2(from_sil, O_CLOEXEC) != 0) {
+        return false;
+    }
+    sil->pid = fork();
+    if (sil->pid < 0) {
+        return false;
+    }
+    if (sil->pid == 0) {
+        dup2(to_sil[0], STDIN_FILENO);
+        dup2(from_sil[1], STDOUT_FILENO);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDERR_FILENO);   // Emulator log
+        }
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    close(to_sil[0]);
+    close(from_sil[1]);
+    sil->to_fd = to_sil[1];
+    sil->from_fd = from_sil[0];
+    return true;
+}
+
+/**
+ * @brief Close the SIL's input and wait for it
+ *
+ * @return Exit status, or -1 if it did not exit normally
+ */
+static int sil_stop(sil_t* sil) {
+    if (sil->to_fd >= 0) {
+        close(sil->to_fd);      // EOF on stdin stops the SIL
+    }
+    int status = 0;
+    waitpid(sil->pid, &status, 0);
+    close(sil->from_fd);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+static size_t hex_bytes(const char* hex, uint8_t* out) {
+    size_t n = strlen(hex) / 2;
+    for (size_t i = 0; i < n; i++) {
+        char byte[3] = { hex[2 * i], hex[2 * i + 1], '\0' };
+        out[i] = (uint8_t)strtoul(byte, NULL, 16);
+    }
+    return n;
+}
+
+/**
+ * @brief Send one request and wait for a complete reply frame
+ */
+static bool exchange(sil_t* sil, const request_t* req) {
+    uint8_t pkt[NSP_MAX_PACKET_SIZE];
+    pkt[0] = 0x00;
+    pkt[1] = OBC_ADDR;
+    pkt[2] = nsp_make_ctrl(true, false, false, req->command);
+    size_t len = crc_ccitt_append(pkt, 3 + hex_bytes(req->payload_hex, &pkt[3]));
+    uint8_t tx[2 * NSP_MAX_PACKET_SIZE + 2];
+    size_t tx_len = 0;
+    slip_encode(pkt, len, tx, &tx_len);
+    if (write(sil->to_fd, tx, tx_len) != (ssize_t)tx_len) {
+        return false;
+    }
+
+    slip_decoder_t dec;
+    slip_decoder_init(&dec);
+    size_t frame_len = 0;
+    struct pollfd pfd = { .fd = sil->from_fd, .events = POLLIN };
+    while (poll(&pfd, 1, REPLY_TIMEOUT_MS) > 0) {
+        uint8_t byte;
+        if (read(sil->from_fd, &byte, 1) != 1) {
+            return false;
+        }
+        uint8_t data;
+        slip_event_t ev = slip_decode_step(&dec, byte, &data);
+        if (ev == SLIP_EVENT_DATA) {
+            frame_len++;
+        } else if (ev == SLIP_EVENT_FRAME_END && frame_len >= NSP_MIN_PACKET_SIZE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// Captures
+// ============================================================================
+
+static size_t load(const char* path, uint8_t* buf) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return 0;
+    }
+    size_t len = fread(buf, 1, MAX_CAPTURE, f);
+    fclose(f);
+    return len;
+}
+
+/**
+ * @brief Compare the replies of two captures
+ *
+ * @return Number of replies compared (both captures), 0 on a mismatch
+ */
+static uint32_t compare_replies(const uint8_t* a, size_t a_len, const uint8_t* b, size_t b_len) {
+    nsp_replay_reader_t ra, rb;
+    UT_CHECK(nsp_replay_reader_open(&ra, a, a_len) == NULL, "recorded capture refused");
+    UT_CHECK(nsp_replay_reader_open(&rb, b, b_len) == NULL, "replayed capture refused");
+    uint32_t count = 0;
+    nsp_replay_frame_t fa, fb;
+    while (true) {
+        bool more_a, more_b;
+        while ((more_a = nsp_replay_reader_next(&ra, &fa)) && fa.dir != NSP_REPLAY_REPLY) {
+        }
+        while ((more_b = nsp_replay_reader_next(&rb, &fb)) && fb.dir != NSP_REPLAY_REPLY) {
+        }
+        if (!more_a || !more_b) {
+            UT_CHECK(more_a == more_b, "reply counts differ after %u replies", (unsigned)count);
+            return (more_a == more_b) ? count : 0;
+        }
+        bool same = fa.len == fb.len && memcmp(fa.data, fb.data, fa.len) == 0;
+        UT_CHECK(same, "reply %u differs (%u vs %u bytes)", (unsigned)count, fa.len, fb.len);
+        UT_CHECK(fa.tick == fb.tick, "reply %u at tick %u, replayed at %u", (unsigned)count,
+                 (unsigned)fa.tick, (unsigned)fb.tick);
+        if (!same) {
+            return 0;
+        }
+        count++;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s SIL WORKDIR\n", argv[0]);
+        return 2;
+    }
+    char recorded[1024], replayed[1024], tampered[1024];
+    snprintf(recorded, sizeof(recorded), "%s/replay_recorded.nrpl", argv[2]);
+    snprintf(replayed, sizeof(replayed), "%s/replay_replayed.nrpl", argv[2]);
+    snprintf(tampered, sizeof(tampered), "%s/replay_tampered.nrpl", argv[2]);
+
+    // Record a lockstep session
+    sil_t sil;
+    char* record_argv[] = { argv[1], "--lockstep", "--record", recorded, NULL };
+    UT_CHECK(sil_start(&sil, record_argv), "cannot start %s", argv[1]);
+    for (size_t i = 0; i < sizeof(session) / sizeof(session[0]); i++) {
+        UT_CHECK(exchange(&sil, &session[i]), "request %u (0x%02X) not answered", (unsigned)i,
+                 session[i].command);
+    }
+    UT_CHECK(sil_stop(&sil) == 0, "recording SIL failed");
+
+    // Replay it, recording the replay
+    char* replay_argv[] = { argv[1], "--replay", recorded, "--record", replayed, NULL };
+    UT_CHECK(sil_start(&sil, replay_argv), "cannot start %s", argv[1]);
+    UT_CHECK(sil_stop(&sil) == 0, "replay reported differences");
+
+    static uint8_t a[MAX_CAPTURE], b[MAX_CAPTURE];
+    size_t a_len = load(recorded, a);
+    size_t b_len = load(replayed, b);
+    uint32_t replies = compare_replies(a, a_len, b, b_len);
+    UT_CHECK(replies == sizeof(session) / sizeof(session[0]), "%u replies compared, expected %u",
+             (unsigned)replies, (unsigned)(sizeof(session) / sizeof(session[0])));
+
+    // A changed golden reply must be reported: flip a byte of the last one
+    nsp_replay_reader_t reader;
+    nsp_replay_frame_t frame;
+    const uint8_t* last = NULL;
+    nsp_replay_reader_open(&reader, a, a_len);
+    while (nsp_replay_reader_next(&reader, &frame)) {
+        if (frame.dir == NSP_REPLAY_REPLY) {
+            last = frame.data + 3;      // First payload byte (or the CRC)
+        }
+    }
+    UT_CHECK(last != NULL, "no reply recorded");
+    if (last) {
+        a[last - a] ^= 0x01;
+        FILE* f = fopen(tampered, "wb");
+        UT_CHECK(f && fwrite(a, 1, a_len, f) == a_len, "cannot write %s", tampered);
+        if (f) {
+            fclose(f);
+        }
+        char* tampered_argv[] = { argv[1], "--replay", tampered, NULL };
+        UT_CHECK(sil_start(&sil, tampered_argv), "cannot start %s", argv[1]);
+        UT_CHECK(sil_stop(&sil) == 1, "replay against a changed reply passed");
+    }
+
+    return ut_finish("replay");
+}
@@ -0,0 +1,40 @@
+/**
+ * @file unit_test.h
+ * @brief Host Unit Test Helpers
+ *
+ * Each test is a host executable run by ctest: it prints one line per
+ * failed check and exits non-zero if any check failed.
+ *
+ *   UT_CHECK(state.omega_rad_s > 0.0f, "spin-up: omega %.3f", state.omega_rad_s);
+ *   return ut_finish("fixed_kernel");
+ */
+
+#ifndef UNIT_TEST_H
+#define UNIT_TEST_H
+
+#include <stdio.h>
+
+static unsigned ut_checks = 0;
+static unsigned ut_failures = 0;
+
+/** Check a condition; on failure print the message (printf format) */
+#define UT_CHECK(cond, ...) do {                                    \
+        ut_checks++;                                                \
+        if (!(cond)) {                                              \
+            ut_failures++;                                          \
+            printf("[FAIL] %s:%d: ", __FILE__, __LINE__);           \
+            printf(__VA_ARGS__);                                    \
+            printf("\n");                                           \
+        }                                                           \
+    } while (0)
+
+/**
+ * @brief Print the summary line and return the process exit code
+ */
+static inline int ut_finish(const char* name) {
+    printf("[%s] %s: %u checks, %u failed\n", ut_failures ? "FAIL" : "PASS",
+           name, ut_checks, ut_failures);
+    return ut_failures ? 1 : 0;
+}
+
+#endif // UNIT_TEST_H
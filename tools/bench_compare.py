@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+Compare two nrwa_t6_bench reports (firmware/bench/bench_main.c).
+
+Each report is the console output of one benchmark run, saved to a file;
+anything outside the BENCH-BEGIN / BENCH-END block is ignored. Medians are
+compared per benchmark; a benchmark regresses when its median grows by more
+than the threshold. Exit status 1 if anything regressed or failed.
+
+Usage:
+    bench_compare.py baseline.txt current.txt
+    bench_compare.py --threshold 5 baseline.txt current.txt
+"""
+
+import argparse
+import sys
+
+
+def read_report(path):
+    """Return (header dict, {bench: row dict}) of the first report in a file."""
+    header = {}
+    rows = {}
+    columns = None
+    inside = False
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("BENCH-BEGIN"):
+                header = dict(kv.split("=", 1) for kv in line.split()[1:] if "=" in kv)
+                inside = True
+                continue
+            if not inside:
+                continue
+            if line.startswith("BENCH-END"):
+                break
+            if columns is None:
+                columns = line.split(",")
+                continue
+            values = line.split(",")
+            if len(values) == len(columns):
+                rows[values[0]] = dict(zip(columns, values))
+    if not inside:
+        sys.exit(f"{path}: no BENCH-BEGIN block")
+    return header, rows
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    ap.add_argument("baseline", help="reference report")
+    ap.add_argument("current", help="report to check")
+    ap.add_argument("--threshold", type=float, default=10.0,
+                    help="allowed median growth in percent (default 10)")
+    args = ap.parse_args()
+
+    base_hdr, base = read_report(args.baseline)
+    cur_hdr, cur = read_report(args.current)
+    for key in ("unit", "clock_hz", "wheels", "tick_hz"):
+        if base_hdr.get(key) != cur_hdr.get(key):
+            print(f"warning: {key} differs ({base_hdr.get(key)} vs {cur_hdr.get(key)})", file=sys.stderr)
+
+    unit = cur_hdr.get("unit", "")
+    print(f"{base_hdr.get('version', '?')} -> {cur_hdr.get('version', '?')} (median {unit})")
+    print(f"{'bench':32} {'base':>9} {'current':>9} {'change':>8}")
+
+    bad = 0
+    for name, row in cur.items():
+        median = int(row["median"])
+        status = ""
+        if row.get("ok") != "1":
+            status = "FAILED"
+            bad += 1
+        if name not in base:
+            print(f"{name:32} {'-':>9} {median:9d} {'new':>8} {status}")
+            continue
+        ref = int(base[name]["median"])
+        change = (median - ref) * 100.0 / ref if ref else 0.0
+        if change > args.threshold and not status:
+            status = "REGRESSED"
+            bad += 1
+        print(f"{name:32} {ref:9d} {median:9d} {change:+7.1f}% {status}")
+
+    for name in base:
+        if name not in cur:
+            print(f"{name:32} {'(missing from current report)'}")
+
+    return 1 if bad else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
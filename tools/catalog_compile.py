@@ -0,0 +1,310 @@
+#!/usr/bin/env python3
+"""
+Generate the console field catalog index from the table sources.
+
+Reads the const field_meta_t array and the table_meta_t of every
+firmware/console/table_*.c given, and emits a C source holding the table
+list in menu order plus the index tables.c looks fields up with, all const
+(flash): table ID and field ID to position, the dense field list, the
+name hash tables and the persistent field list. The catalog needs no
+registration or index building at boot.
+
+The hash is the case-insensitive FNV-1a of tables.c (name_hash()) with the
+same linear probing; keep them in step.
+
+Usage:
+    catalog_compile.py --out-c catalog_index.c --out-h catalog_index.h \\
+        firmware/console/table_tests.c firmware/console/table_serial.c ...
+
+Menu order (and so the TUI table numbering) follows the argument order.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+FIELD_ARRAY = re.compile(r"\bconst\s+field_meta_t\s+(\w+)\s*\[\s*\]\s*=\s*\{(.*?)\n\};", re.S)
+TABLE_META = re.compile(r"\bconst\s+table_meta_t\s+(\w+)\s*=\s*\{([^{}]*)\}", re.S)
+ENTRY = re.compile(r"\{([^{}]*)\}")
+ID = re.compile(r"\.id\s*=\s*(\d+)\s*,")
+NAME = re.compile(r'\.name\s*=\s*"([^"\\]*)"')
+FIELDS = re.compile(r"\.fields\s*=\s*(\w+)")
+PERSISTENT = re.compile(r"\.persistent\s*=\s*true\b")
+
+
+class CatalogError(Exception):
+    pass
+
+
+def strip_comments(text):
+    """Remove // and /* */ comments, leaving string and char literals alone."""
+    out = []
+    i = 0
+    n = len(text)
+    while i < n:
+        c = text[i]
+        if c in "\"'":
+            end = i + 1
+            while end < n and text[end] != c:
+                end += 2 if text[end] == "\\" else 1
+            out.append(text[i:end + 1])
+            i = end + 1
+        elif text.startswith("//", i):
+            end = text.find("\n", i)
+            i = n if end < 0 else end
+        elif text.startswith("/*", i):
+            end = text.find("*/", i + 2)
+            if end < 0:
+                raise CatalogError("unterminated comment")
+            out.append(" ")
+            i = end + 2
+        else:
+            out.append(c)
+            i += 1
+    return "".join(out)
+
+
+def parse_table(path):
+    with open(path, encoding="utf-8") as src:
+        text = strip_comments(src.read())
+
+    arrays = FIELD_ARRAY.findall(text)
+    metas = TABLE_META.findall(text)
+    if len(arrays) != 1 or len(metas) != 1:
+        raise CatalogError("expected one field_meta_t array and one table_meta_t")
+    array_name, body = arrays[0]
+    meta_name, meta = metas[0]
+
+    table_id = ID.search(meta)
+    table_name = NAME.search(meta)
+    fields_ref = FIELDS.search(meta)
+    if not table_id or not table_name:
+        raise CatalogError("%s: .id and .name must be literals" % meta_name)
+    if not fields_ref or fields_ref.group(1) != array_name:
+        raise CatalogError("%s: .fields must be %s" % (meta_name, array_name))
+
+    fields = []
+    for entry in ENTRY.findall(body):
+        field_id = ID.search(entry)
+        field_name = NAME.search(entry)
+        if not field_id or not field_name:
+            raise CatalogError("%s: every field needs a literal .id and .name" % array_name)
+        fields.append((int(field_id.group(1)), field_name.group(1),
+                       PERSISTENT.search(entry) is not None))
+    if not fields:
+        raise CatalogError("%s: no fields" % array_name)
+
+    return {
+        "meta": meta_name,
+        "id": int(table_id.group(1)),
+        "name": table_name.group(1),
+        "fields": fields,
+        "source": os.path.basename(path),
+    }
+
+
+def name_hash(name, seed):
+    h = 2166136261 ^ seed
+    for b in name.encode("utf-8"):
+        if 0x41 <= b <= 0x5A:
+            b += 0x20
+        h ^= b
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def hash_slots(count):
+    slots = 8
+    while slots < 2 * count:
+        slots *= 2
+    return slots
+
+
+def build_hash(slots, keys):
+    table = [0] * slots
+    for name, seed, value in keys:
+        h = name_hash(name, seed)
+        while table[h & (slots - 1)] != 0:
+            h += 1
+        table[h & (slots - 1)] = value
+    return table
+
+
+def check(tables):
+    if len(tables) > 255:
+        raise CatalogError("at most 255 tables")
+    seen_tables = {}
+    seen_names = {}
+    seen_fields = {}
+    for t in tables:
+        where = t["source"]
+        if t["id"] == 0 or t["id"] in seen_tables:
+            raise CatalogError("%s: table ID %d invalid or used by %s"
+                               % (where, t["id"], seen_tables.get(t["id"], "0")))
+        seen_tables[t["id"]] = where
+        if t["name"].lower() in seen_names:
+            raise CatalogError("%s: table name \"%s\" used by %s"
+                               % (where, t["name"], seen_names[t["name"].lower()]))
+        seen_names[t["name"].lower()] = where
+        if len(t["fields"]) > 255:
+            raise CatalogError("%s: at most 255 fields per table" % where)
+
+        names = set()
+        for field_id, name, _ in t["fields"]:
+            if field_id // 100 != t["id"]:
+                raise CatalogError("%s: field %s ID %d is not in table %d (ID = table x 100 + n)"
+                                   % (where, name, field_id, t["id"]))
+            if field_id in seen_fields:
+                raise CatalogError("%s: field ID %d used by %s" % (where, field_id,
+                                                                    seen_fields[field_id]))
+            seen_fields[field_id] = "%s.%s" % (t["name"], name)
+            if name.lower() in names:
+                raise CatalogError("%s: duplicate field name %s" % (where, name))
+            names.add(name.lower())
+
+
+def c_list(values, per_line=12):
+    return ["    " + ", ".join(str(v) for v in values[i:i + per_line]) + ","
+            for i in range(0, len(values), per_line)]
+
+
+def emit_c(path, tables):
+    dense = []          # (table position, field index, field ID, name, persistent)
+    for pos, t in enumerate(tables):
+        for index, (field_id, name, persistent) in enumerate(t["fields"]):
+            dense.append((pos, index, field_id, name, persistent))
+
+    table_hash = build_hash(hash_slots(len(tables)),
+                            [(t["name"], 0, pos + 1) for pos, t in enumerate(tables)])
+    field_hash = build_hash(hash_slots(len(dense)),
+                            [(name, pos, i + 1) for i, (pos, _, _, name, _) in enumerate(dense)])
+    persistent = [i for i, f in enumerate(dense) if f[4]]
+
+    lines = [
+        "/**",
+        " * @file catalog_index.c",
+        " * @brief Console Catalog Index (generated by tools/catalog_compile.py)",
+        " *",
+        " * Do not edit: regenerated from the console table sources on every build.",
+        " */",
+        "",
+        '#include "catalog_index.h"',
+        "",
+    ]
+    for t in tables:
+        lines.append("extern const table_meta_t %s;" % t["meta"])
+    lines.append("")
+
+    lines.append("const table_meta_t* const catalog_tables[CATALOG_TABLE_COUNT] = {")
+    for t in tables:
+        lines.append("    &%s,   // %d %s (%s)" % (t["meta"], t["id"], t["name"], t["source"]))
+    lines.append("};")
+    lines.append("")
+
+    lines.append("const uint8_t catalog_table_by_id[CATALOG_MAX_TABLE_ID + 1] = {")
+    for pos, t in enumerate(tables):
+        lines.append("    [%d] = %d," % (t["id"], pos + 1))
+    lines.append("};")
+    lines.append("")
+
+    lines.append("const uint16_t catalog_field_by_id[CATALOG_MAX_FIELD_ID + 1] = {")
+    for i, (_, _, field_id, _, _) in enumerate(dense):
+        lines.append("    [%d] = %d," % (field_id, i + 1))
+    lines.append("};")
+    lines.append("")
+
+    lines.append("const catalog_field_ref_t catalog_fields[CATALOG_FIELD_COUNT] = {")
+    for pos, index, field_id, name, _ in dense:
+        lines.append("    { %d, %d },   // %d %s" % (pos, index, field_id, name))
+    lines.append("};")
+    lines.append("")
+
+    lines.append("const uint8_t catalog_table_hash[CATALOG_TABLE_HASH_SLOTS] = {")
+    lines.extend(c_list(table_hash))
+    lines.append("};")
+    lines.append("")
+
+    lines.append("const uint16_t catalog_field_hash[CATALOG_FIELD_HASH_SLOTS] = {")
+    lines.extend(c_list(field_hash))
+    lines.append("};")
+    lines.append("")
+
+    lines.append("const uint16_t catalog_persistent[] = {")
+    lines.extend(c_list(persistent) if persistent else ["    0,"])
+    lines.append("};")
+    lines.append("")
+
+    with open(path, "w", encoding="utf-8") as out:
+        out.write("\n".join(lines))
+
+    return len(dense), len(persistent), len(table_hash), len(field_hash)
+
+
+def emit_h(path, tables, field_count, persistent_count, table_slots, field_slots):
+    lines = [
+        "/**",
+        " * @file catalog_index.h",
+        " * @brief Console Catalog Index (generated by tools/catalog_compile.py)",
+        " *",
+        " * Private to tables.c. Fields are numbered densely in menu order; the",
+        " * ID and hash tables hold 1 + that number (0 = none), the table tables",
+        " * 1 + the menu position.",
+        " */",
+        "",
+        "#ifndef CATALOG_INDEX_H",
+        "#define CATALOG_INDEX_H",
+        "",
+        '#include "tables.h"',
+        "",
+        "#define CATALOG_TABLE_COUNT         %d" % len(tables),
+        "#define CATALOG_FIELD_COUNT         %d" % field_count,
+        "#define CATALOG_PERSISTENT_COUNT    %d" % persistent_count,
+        "#define CATALOG_TABLE_HASH_SLOTS    %d" % table_slots,
+        "#define CATALOG_FIELD_HASH_SLOTS    %d" % field_slots,
+        "",
+        "/** Position of a field: catalog_tables[table]->fields[field] */",
+        "typedef struct {",
+        "    uint8_t table;",
+        "    uint8_t field;",
+        "} catalog_field_ref_t;",
+        "",
+        "extern const table_meta_t* const catalog_tables[CATALOG_TABLE_COUNT];",
+        "extern const uint8_t catalog_table_by_id[CATALOG_MAX_TABLE_ID + 1];",
+        "extern const uint16_t catalog_field_by_id[CATALOG_MAX_FIELD_ID + 1];",
+        "extern const catalog_field_ref_t catalog_fields[CATALOG_FIELD_COUNT];",
+        "extern const uint8_t catalog_table_hash[CATALOG_TABLE_HASH_SLOTS];",
+        "extern const uint16_t catalog_field_hash[CATALOG_FIELD_HASH_SLOTS];",
+        "extern const uint16_t catalog_persistent[];     // Dense numbers, menu order",
+        "",
+        "#endif // CATALOG_INDEX_H",
+        "",
+    ]
+    with open(path, "w", encoding="utf-8") as out:
+        out.write("\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--out-c", required=True, help="generated C source")
+    parser.add_argument("--out-h", required=True, help="generated header")
+    parser.add_argument("tables", nargs="+", help="table sources, in menu order")
+    args = parser.parse_args()
+
+    tables = []
+    for path in args.tables:
+        try:
+            tables.append(parse_table(path))
+        except (OSError, CatalogError) as err:
+            sys.exit("catalog_compile: %s: %s" % (path, err))
+    try:
+        check(tables)
+    except CatalogError as err:
+        sys.exit("catalog_compile: %s" % err)
+
+    counts = emit_c(args.out_c, tables)
+    emit_h(args.out_h, tables, *counts)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""
+Static RAM budget by subsystem, from the firmware link map.
+
+Sums the input sections placed in the RAM output sections (.data, .bss,
+.scratch_x, .scratch_y, and .uninitialized_data, the records a warm
+restart keeps) per firmware source directory (drivers, device,
+util, ...), the SDK and the C library. Archive members (libnrwa_core.a)
+are mapped to their directory through the source tree. The firmware
+build runs it after linking; Table 20 shows the same sections on the board
+(but for .uninitialized_data).
+
+Usage:
+    ram_report.py --src firmware build/firmware/nrwa_t6_emulator.map
+"""
+
+import argparse
+import os
+import re
+import sys
+
+RAM_SECTIONS = (".data", ".bss", ".scratch_x", ".scratch_y", ".uninitialized_data")
+COLUMN_NAMES = {".uninitialized_data": ".noinit"}
+
+# Input section line: name (optional), address, size, object
+INPUT_RE = re.compile(r"^\s+(\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+OUTPUT_RE = re.compile(r"^(\.\S+)\s+0x[0-9a-fA-F]+\s+0x[0-9a-fA-F]+")
+
+
+def source_dirs(src):
+    """Return {source basename: subsystem} for the firmware tree."""
+    dirs = {}
+    for root, _, files in os.walk(src):
+        rel = os.path.relpath(root, src)
+        subsystem = "app" if rel == "." else rel.split(os.sep)[0]
+        for name in files:
+            if name.endswith(".c"):
+                dirs.setdefault(name, subsystem)
+    return dirs
+
+
+def subsystem_of(obj, dirs):
+    """Subsystem of an object path or archive member."""
+    member = re.search(r"\(([^)]+)\)$", obj)
+    name = os.path.basename(member.group(1) if member else obj)
+    if "pico-sdk" in obj or "pico_" in obj or "tinyusb" in obj:
+        return "sdk"
+    if re.search(r"lib(c|m|gcc|nosys)[^/]*\.a", obj):
+        return "libc"
+    base = re.sub(r"\.(obj|o)$", "", name)
+    return dirs.get(base, "other")
+
+
+def read_map(path, dirs):
+    """Return {subsystem: {section: bytes}}."""
+    totals = {}
+    section = None
+    pending = None
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            out = OUTPUT_RE.match(line)
+            if out:
+                section = out.group(1) if out.group(1) in RAM_SECTIONS else None
+                pending = None
+                continue
+            if section is None:
+                continue
+            m = INPUT_RE.match(line)
+            if not m:
+                # Long input section names wrap: the numbers follow on the next line
+                stripped = line.strip()
+                pending = stripped if stripped.startswith(".") and " " not in stripped else None
+                continue
+            name = m.group(1) or pending
+            pending = None
+            size = int(m.group(3), 16)
+            if not name or size == 0 or name.startswith("*"):
+                continue
+            sub = subsystem_of(m.group(4), dirs)
+            totals.setdefault(sub, {}).setdefault(section, 0)
+            totals[sub][section] += size
+    return totals
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--src", required=True, help="firmware source directory")
+    parser.add_argument("map", help="linker map file")
+    args = parser.parse_args()
+
+    totals = read_map(args.map, source_dirs(args.src))
+    if not totals:
+        print("ram_report: no RAM sections found in %s" % args.map, file=sys.stderr)
+        return 1
+
+    print("%-10s" % "subsystem" + "".join("%11s" % COLUMN_NAMES.get(s, s) for s in RAM_SECTIONS) +
+          "%11s" % "total")
+    column = {s: 0 for s in RAM_SECTIONS}
+    for sub in sorted(totals, key=lambda k: -sum(totals[k].values())):
+        row = [totals[sub].get(s, 0) for s in RAM_SECTIONS]
+        for s, v in zip(RAM_SECTIONS, row):
+            column[s] += v
+        print("%-10s" % sub + "".join("%11d" % v for v in row) + "%11d" % sum(row))
+    print("%-10s" % "total" + "".join("%11d" % column[s] for s in RAM_SECTIONS) +
+          "%11d" % sum(column.values()))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
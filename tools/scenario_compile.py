@@ -0,0 +1,337 @@
+#!/usr/bin/env python3
+"""
+Compile fault injection scenarios (JSON) into binary images for flash.
+
+Emits a C source holding one image per scenario plus the built-in
+scenario registry, and a header with the scenario count. The image layout
+is defined in firmware/config/scenario_bin.h; keep FORMAT_VERSION and the
+struct formats and opcodes below in step with it. The firmware's builder
+(scenario_bin_add_event()) produces byte-identical images from the same JSON.
+
+Usage:
+    scenario_compile.py --out-c scenario_images.c --out-h scenario_images.h \\
+        tests/scenarios/single_crc_error.json ...
+
+Registry order (and so the TUI scenario index) follows the argument order.
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+MAGIC = 0x4E43534E          # "NSCN"
+FORMAT_VERSION = 3
+CRC_START = 8
+
+NAME_LEN = 32
+DESC_LEN = 128
+MAX_EVENTS = 128
+MAX_CONDITIONS = 32
+
+RPM_TO_RAD_S = 0.10471975512
+
+HEADER = struct.Struct("<IHHIBBHHH32sI")
+EVENT = struct.Struct("<IIBBBx")
+CONDITION = struct.Struct("<ffIBB2x")
+OP_U = struct.Struct("<B3xI")
+OP_F = struct.Struct("<B3xf")
+
+assert HEADER.size == 56 and EVENT.size == 12 and CONDITION.size == 16 and OP_U.size == 8
+
+MODES = {"CURRENT": 0, "SPEED": 1, "TORQUE": 2, "PWM": 3}
+CONDITION_KEYS = ("mode_in", "rpm_gt", "rpm_lt", "nsp_cmd_eq")   # nsp_cmd_count qualifies nsp_cmd_eq
+
+# Opcodes; the high nibble is the layer (transport, device, physics)
+OP_CRC_ERROR = 0x01
+OP_DROP_FRAMES = 0x02
+OP_DELAY_REPLY = 0x03
+OP_FORCE_NACK = 0x04
+OP_BURST_MODEL = 0x05
+OP_BURST_LOSS = 0x06
+OP_TARGET_CMDS = 0x07
+OP_FLIP_STATUS = 0x10
+OP_SET_FAULT = 0x11
+OP_CLEAR_FAULT = 0x12
+OP_OVERSPEED = 0x13
+OP_TRIP_LCL = 0x14
+OP_LIMIT_POWER = 0x20
+OP_LIMIT_CURRENT = 0x21
+OP_LIMIT_SPEED = 0x22
+OP_OVERRIDE_TORQUE = 0x23
+
+
+class ScenarioError(Exception):
+    pass
+
+
+def f32(value):
+    """Round to single precision, as the firmware stores it."""
+    return struct.unpack("<f", struct.pack("<f", float(value)))[0]
+
+
+def q16(value):
+    """Probability (0..1, clamped) to Q16, as the firmware builder rounds it."""
+    p = f32(value)
+    if not p > 0.0:
+        return 0
+    if p >= 1.0:
+        return 0xFFFF
+    return int(f32(f32(p * 65535.0) + 0.5))
+
+
+def command_bit(value):
+    if not isinstance(value, str) or not value.startswith("0x"):
+        raise ScenarioError("invalid NSP command format %r" % value)
+    return 1 << (int(value[2:], 16) & 0x1F)
+
+
+def crc_ccitt(data, crc=0xFFFF):
+    """CRC-16 CCITT, LSB-first, no final XOR (drivers/crc_ccitt.c)."""
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x8408 if crc & 1 else crc >> 1
+    return crc
+
+
+def compile_condition(cond):
+    """Compiled condition record, or None if no condition key is present."""
+    if not any(k in cond for k in CONDITION_KEYS):
+        return None
+
+    omega_gt = float("-inf")
+    omega_lt = float("inf")
+    cmd_mask = 0
+    cmd_count = 0
+    mode_mask = 0xFF
+
+    for key, value in cond.items():
+        if key == "mode_in":
+            if value not in MODES:
+                raise ScenarioError("invalid mode value %r" % value)
+            mode_mask = 1 << MODES[value]
+        elif key == "rpm_gt":
+            omega_gt = f32(f32(value) * f32(RPM_TO_RAD_S))
+        elif key == "rpm_lt":
+            omega_lt = f32(f32(value) * f32(RPM_TO_RAD_S))
+        elif key == "nsp_cmd_eq":
+            cmd_mask = command_bit(value)
+        elif key == "nsp_cmd_count":
+            if not isinstance(value, (int, float)) or not 0 <= value <= 255:
+                raise ScenarioError("nsp_cmd_count out of range (0-255): %r" % (value,))
+            cmd_count = int(value)
+        # Unknown keys are ignored, as by the firmware's JSON loader
+
+    # The count only applies to a command condition (as in scenario_bin.c)
+    return CONDITION.pack(omega_gt, omega_lt, cmd_mask, mode_mask, cmd_count if cmd_mask else 0)
+
+
+def compile_action(action):
+    """List of (opcode, packed op) in ascending opcode order."""
+    ops = []
+
+    def op_u(code, value):
+        ops.append((code, OP_U.pack(code, value)))
+
+    def op_f(code, value):
+        ops.append((code, OP_F.pack(code, value)))
+
+    if action.get("inject_crc_error"):
+        op_u(OP_CRC_ERROR, 0)
+    drop_pct = int(action.get("drop_frames_pct", 0)) & 0xFF
+    if drop_pct > 0:
+        op_u(OP_DROP_FRAMES, drop_pct)
+    delay_ms = int(action.get("delay_reply_ms", 0)) & 0xFFFF
+    if delay_ms > 0:
+        op_u(OP_DELAY_REPLY, delay_ms)
+    if action.get("force_nack"):
+        op_u(OP_FORCE_NACK, 0)
+    if "burst_p_enter" in action:
+        op_u(OP_BURST_MODEL, q16(action["burst_p_enter"]) |
+             (q16(action.get("burst_p_exit", 0)) << 16))
+        op_u(OP_BURST_LOSS, q16(action.get("burst_loss_good", 0)) |
+             (q16(action.get("burst_loss_bad", 1.0)) << 16))
+    if "target_cmds" in action:
+        mask = 0
+        for cmd in action["target_cmds"]:
+            mask |= command_bit(cmd)
+        if mask:
+            op_u(OP_TARGET_CMDS, mask)
+    if "flip_status_bits" in action:
+        op_u(OP_FLIP_STATUS, int(action["flip_status_bits"]) & 0xFFFFFFFF)
+    if "set_fault_bits" in action:
+        op_u(OP_SET_FAULT, int(action["set_fault_bits"]) & 0xFFFFFFFF)
+    if "clear_fault_bits" in action:
+        op_u(OP_CLEAR_FAULT, int(action["clear_fault_bits"]) & 0xFFFFFFFF)
+    if action.get("overspeed_fault"):
+        op_u(OP_OVERSPEED, 0)
+    if action.get("trip_lcl"):
+        op_u(OP_TRIP_LCL, 0)
+    if "limit_power_w" in action:
+        op_f(OP_LIMIT_POWER, f32(action["limit_power_w"]))
+    if "limit_current_a" in action:
+        op_f(OP_LIMIT_CURRENT, f32(action["limit_current_a"]))
+    if "limit_speed_rpm" in action:
+        op_f(OP_LIMIT_SPEED, f32(f32(action["limit_speed_rpm"]) * f32(RPM_TO_RAD_S)))
+    if "override_torque_mNm" in action:
+        op_f(OP_OVERRIDE_TORQUE, f32(action["override_torque_mNm"]))
+
+    return ops
+
+
+def compile_scenario(doc):
+    if "name" not in doc or "schedule" not in doc:
+        raise ScenarioError("scenario missing required fields (name, schedule)")
+
+    name = doc["name"].encode("utf-8")
+    desc = doc.get("description", "").encode("utf-8")
+    if len(name) >= NAME_LEN:
+        raise ScenarioError("name longer than %d bytes" % (NAME_LEN - 1))
+    if len(desc) >= DESC_LEN:
+        raise ScenarioError("description longer than %d bytes" % (DESC_LEN - 1))
+
+    schedule = doc["schedule"]
+    if len(schedule) > MAX_EVENTS:
+        raise ScenarioError("too many events (max %d)" % MAX_EVENTS)
+
+    # Records in file order, each followed by its condition and ops
+    body = bytearray()
+    entries = []
+    conditions = 0
+    for event in schedule:
+        if "t_ms" not in event or "action" not in event:
+            raise ScenarioError("event missing required fields (t_ms, action)")
+        t_ms = int(event["t_ms"]) & 0xFFFFFFFF
+        duration = int(event.get("duration_ms", 0)) & 0xFFFFFFFF
+        cond = compile_condition(event.get("condition", {}))
+        ops = compile_action(event["action"])
+
+        layers = 0
+        for code, _ in ops:
+            layers |= 1 << (code >> 4)
+
+        entries.append((t_ms, HEADER.size + len(body)))
+        body += EVENT.pack(t_ms, duration, len(ops), layers, 1 if cond else 0)
+        if cond:
+            body += cond
+            conditions += 1
+        body += b"".join(packed for _, packed in ops)
+
+    if conditions > MAX_CONDITIONS:
+        raise ScenarioError("too many conditional events (max %d)" % MAX_CONDITIONS)
+
+    # Index sorted by t_ms; stable, so equal t_ms keep file order
+    entries.sort(key=lambda e: e[0])
+    index_offset = HEADER.size + len(body)
+    index = b"".join(struct.pack("<H", offset) for _, offset in entries)
+    index_end = (index_offset + len(index) + 3) & ~3
+    index += b"\0" * (index_end - index_offset - len(index))
+
+    desc_offset = index_end if desc else 0
+    desc_block = desc + b"\0" if desc else b""
+    total = index_end + len(desc_block)
+    total = (total + 3) & ~3
+    tail = desc_block + b"\0" * (total - index_end - len(desc_block))
+    if total > 0xFFFF:
+        raise ScenarioError("image larger than 64 KiB")
+
+    seed = int(doc.get("seed", 0)) & 0xFFFFFFFF
+    header = HEADER.pack(MAGIC, FORMAT_VERSION, 0, total, len(entries), conditions,
+                         index_offset, desc_offset, len(desc_block), name, seed)
+    image = bytearray(header + body + index + tail)
+    crc = crc_ccitt(image[CRC_START:])
+    struct.pack_into("<H", image, 6, crc)
+    return doc["name"], bytes(image)
+
+
+def c_string(text):
+    return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def emit_c(path, scenarios):
+    lines = [
+        "/**",
+        " * @file scenario_images.c",
+        " * @brief Built-in Scenario Images (generated by tools/scenario_compile.py)",
+        " *",
+        " * Do not edit: regenerated from the JSON files in tests/scenarios on every build.",
+        " */",
+        "",
+        '#include "scenario_registry.h"',
+        "",
+    ]
+
+    for index, (name, source, image) in enumerate(scenarios):
+        lines.append("// %s (%s, %d bytes)" % (name, source, len(image)))
+        lines.append("static const uint8_t __attribute__((aligned(4))) scenario_image_%d[] = {"
+                     % index)
+        for offset in range(0, len(image), 12):
+            chunk = image[offset:offset + 12]
+            lines.append("    " + ", ".join("0x%02X" % b for b in chunk) + ",")
+        lines.append("};")
+        lines.append("")
+
+    lines.append("const scenario_entry_t g_scenario_registry[] = {")
+    for index, (name, _, _) in enumerate(scenarios):
+        lines.append("    { %s, (const scenario_bin_header_t*)scenario_image_%d, "
+                     "sizeof(scenario_image_%d) }," % (c_string(name), index, index))
+    lines.append("};")
+    lines.append("")
+    lines.append("const uint8_t g_scenario_count = %d;" % len(scenarios))
+    lines.append("")
+    lines.append("const char* g_scenario_registry_enum[] = {")
+    for name, _, _ in scenarios:
+        lines.append("    %s," % c_string(name.upper()))
+    lines.append("};")
+    lines.append("")
+
+    with open(path, "w", encoding="utf-8") as out:
+        out.write("\n".join(lines))
+
+
+def emit_h(path, scenarios):
+    lines = [
+        "/**",
+        " * @file scenario_images.h",
+        " * @brief Built-in Scenario Count (generated by tools/scenario_compile.py)",
+        " */",
+        "",
+        "#ifndef SCENARIO_IMAGES_H",
+        "#define SCENARIO_IMAGES_H",
+        "",
+        "#define SCENARIO_BUILTIN_COUNT %d" % len(scenarios),
+        "",
+        "#endif // SCENARIO_IMAGES_H",
+        "",
+    ]
+    with open(path, "w", encoding="utf-8") as out:
+        out.write("\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--out-c", required=True, help="generated C source")
+    parser.add_argument("--out-h", required=True, help="generated header")
+    parser.add_argument("scenarios", nargs="+", help="scenario JSON files, in registry order")
+    args = parser.parse_args()
+
+    if len(args.scenarios) > 255:
+        sys.exit("scenario_compile: at most 255 scenarios")
+
+    scenarios = []
+    for path in args.scenarios:
+        try:
+            with open(path, encoding="utf-8") as src:
+                name, image = compile_scenario(json.load(src))
+        except (OSError, ValueError, ScenarioError) as err:
+            sys.exit("scenario_compile: %s: %s" % (path, err))
+        scenarios.append((name, os.path.basename(path), image))
+
+    emit_c(args.out_c, scenarios)
+    emit_h(args.out_h, scenarios)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,369 @@
+#!/usr/bin/env python3
+"""
+Decode the emulator's binary telemetry stream (second USB serial port).
+
+Reads SLIP frames from the telemetry CDC port, checks their CRC and prints
+one CSV row per frame. Dropped snapshots show as sequence gaps. The
+frame layout is defined in firmware/drivers/usb_stream.h; keep FIELDS and
+the header format below in step with it.
+
+Streaming must be enabled on the console first (Table 14, enabled = true).
+NSP trace dumps (Table 3 trace_dump, or automatic on a fault latch) arrive
+on the same port; --trace writes their entries to a CSV file. So do flight
+recorder downloads (Table 15 download); --rec writes their samples to a CSV
+file, one row per wheel per physics tick. With the bus monitor on (Table 14
+bus_monitor), --pcap writes every captured RS-485 frame to a pcap file
+(LINKTYPE_USER0: a 4-byte pseudo-header of flags, verdict and two zero
+bytes, then the decoded NSP frame); timestamps count from emulator boot.
+--nrpl writes the same captures as an NSP replay capture
+(firmware/nsp_replay.h): requests with their physics tick counted from the
+first frame, and the emulator's replies as the golden reference. Replay it
+with nrwa_t6_sil --replay, or load it at FLASH_REPLAY_OFFSET for Table 19.
+
+Usage:
+    telemetry_stream.py /dev/ttyACM1 > run.csv
+    telemetry_stream.py --stats /dev/ttyACM1
+    telemetry_stream.py --trace nsp_trace.csv /dev/ttyACM1 > /dev/null
+    telemetry_stream.py --rec flight.csv /dev/ttyACM1 > /dev/null
+    telemetry_stream.py --pcap bus.pcap /dev/ttyACM1 > /dev/null
+    telemetry_stream.py --nrpl run.nrpl /dev/ttyACM1 > /dev/null
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+
+SLIP_END = 0xC0
+SLIP_ESC = 0xDB
+SLIP_ESC_END = 0xDC
+SLIP_ESC_ESC = 0xDD
+
+FRAME_TELEMETRY = 0x01
+FRAME_NSP_TRACE = 0x02
+FRAME_NSP_TRACE_END = 0x03
+HEADER = struct.Struct("<BBHIQI")
+TRACE_HEADER = struct.Struct("<BBBxI")
+TRACE_ENTRY = struct.Struct("<IIBBBBBBH")
+TRACE_END = struct.Struct("<BBxxII")
+FRAME_FLIGHT_REC = 0x04
+FRAME_FLIGHT_REC_END = 0x05
+REC_HEADER = struct.Struct("<BBxxI")
+REC_SAMPLE = struct.Struct("<hhhhhHHBB")
+REC_END = struct.Struct("<BBBBIIII")
+FRAME_BUS_CAPTURE = 0x06
+CAPTURE_HEADER = struct.Struct("<BBxxI")
+CAPTURE_RECORD = struct.Struct("<QBBH")
+PCAP_HEADER = struct.Struct("<IHHiIII")
+PCAP_RECORD = struct.Struct("<IIII")
+PCAP_LINKTYPE_USER0 = 147
+PCAP_SNAPLEN = 4 + 260      # Pseudo-header + BUS_MON_SNAPLEN
+BUS_MON_F_TX = 0x01
+BUS_MON_F_TRUNC = 0x04
+BUS_MON_OK = 0
+BUS_MON_BAD_CRC = 3
+NRPL_HEADER = struct.Struct("<IHHBBHI")     # nsp_replay.h: magic "NRPL", version, tick Hz, ...
+NRPL_RECORD = struct.Struct("<IIBBH")       # tick, offset_us, dir, flags, len
+NRPL_MAGIC = 0x4C50524E
+NSP_MIN_PACKET_SIZE = 5
+NSP_MAX_PACKET_SIZE = 3 + 256 + 2
+
+# Sample scaling (util/flight_rec.h): omega, current_cmd, current_out, torque, power
+REC_SCALES = (32.0, 1000.0, 1000.0, 100.0, 100.0)
+
+TRACE_REASONS = {1: "manual", 2: "fault"}
+TRACE_OUTCOMES = ["ack", "nack", "no_reply", "deferred", "dropped", "slip_error",
+                  "parse_error", "wrong_addr", "dispatch_error", "reply_error"]
+
+# Bit order of the field mask: (name, struct code)
+FIELDS = [
+    ("omega_rad_s", "f"),
+    ("speed_rpm", "f"),
+    ("momentum_nms", "f"),
+    ("current_a", "f"),
+    ("torque_mnm", "f"),
+    ("power_w", "f"),
+    ("voltage_v", "f"),
+    ("mode", "I"),
+    ("direction", "I"),
+    ("fault_status", "I"),
+    ("fault_latch", "I"),
+    ("warning_status", "I"),
+    ("lcl_tripped", "I"),
+    ("jitter_us", "I"),
+    ("physics_us", "I"),
+    ("busy_us", "I"),
+    ("load_permille", "I"),
+    ("current_cmd_a", "f"),
+    ("speed_cmd_rpm", "f"),
+    ("torque_cmd_mnm", "f"),
+    ("pwm_duty_pct", "f"),
+]
+
+
+def crc_ccitt(data, crc=0xFFFF):
+    """CRC-16 CCITT, LSB-first, no final XOR (drivers/crc_ccitt.c)."""
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x8408 if crc & 1 else crc >> 1
+    return crc
+
+
+def slip_frames(fd):
+    """Yield unescaped frames read from a file descriptor."""
+    frame = bytearray()
+    escaped = False
+    while True:
+        chunk = os.read(fd, 4096)
+        if not chunk:
+            return
+        for b in chunk:
+            if b == SLIP_END:
+                if frame:
+                    yield bytes(frame)
+                frame.clear()
+                escaped = False
+            elif escaped:
+                frame.append(SLIP_END if b == SLIP_ESC_END else
+                             SLIP_ESC if b == SLIP_ESC_ESC else b)
+                escaped = False
+            elif b == SLIP_ESC:
+                escaped = True
+            else:
+                frame.append(b)
+
+
+def crc_ok(frame):
+    return len(frame) > 2 and crc_ccitt(frame[:-2]) == struct.unpack_from("<H", frame, len(frame) - 2)[0]
+
+
+def decode_trace(frame):
+    """Return (reason, [(index, entry tuple), ...]) for a trace frame, or None."""
+    if len(frame) < TRACE_HEADER.size + 2:
+        return None
+    _, reason, count, first = TRACE_HEADER.unpack_from(frame)
+    if TRACE_HEADER.size + count * TRACE_ENTRY.size + 2 != len(frame):
+        return None
+    entries = [(first + i, TRACE_ENTRY.unpack_from(frame, TRACE_HEADER.size + i * TRACE_ENTRY.size))
+               for i in range(count)]
+    return reason, entries
+
+
+def decode_rec(frame):
+    """Return [(sample number, sample tuple), ...] for a flight recorder frame, or None."""
+    if len(frame) < REC_HEADER.size + 2:
+        return None
+    _, count, first = REC_HEADER.unpack_from(frame)
+    if REC_HEADER.size + count * REC_SAMPLE.size + 2 != len(frame):
+        return None
+    return [(first + i, REC_SAMPLE.unpack_from(frame, REC_HEADER.size + i * REC_SAMPLE.size))
+            for i in range(count)]
+
+
+def decode_capture(frame):
+    """Return (dropped, [(timestamp_us, flags, verdict, bytes), ...]) for a capture frame, or None."""
+    if len(frame) < CAPTURE_HEADER.size + 2:
+        return None
+    _, count, dropped = CAPTURE_HEADER.unpack_from(frame)
+    records = []
+    off = CAPTURE_HEADER.size
+    for _ in range(count):
+        if off + CAPTURE_RECORD.size > len(frame) - 2:
+            return None
+        ts, flags, verdict, n = CAPTURE_RECORD.unpack_from(frame, off)
+        off += CAPTURE_RECORD.size
+        records.append((ts, flags, verdict, bytes(frame[off:off + n])))
+        off += n
+    if off != len(frame) - 2:
+        return None
+    return dropped, records
+
+
+def decode(frame):
+    """Return (wheel, seq, tick, timestamp_us, {field: value}) or None."""
+    if len(frame) < HEADER.size + 2:
+        return None
+    ftype, wheel, seq, tick, ts, mask = HEADER.unpack_from(frame)
+    if ftype != FRAME_TELEMETRY:
+        return None
+    names = [(n, c) for i, (n, c) in enumerate(FIELDS) if mask & (1 << i)]
+    if HEADER.size + 4 * len(names) + 2 != len(frame):
+        return None
+    values = struct.unpack_from("<" + "".join(c for _, c in names), frame, HEADER.size)
+    return wheel, seq, tick, ts, dict(zip((n for n, _ in names), values))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    ap.add_argument("port", help="telemetry serial device (e.g. /dev/ttyACM1)")
+    ap.add_argument("--stats", action="store_true", help="print rates and losses instead of CSV")
+    ap.add_argument("--trace", metavar="CSV", help="write NSP trace dump entries to this file")
+    ap.add_argument("--rec", metavar="CSV", help="write flight recorder samples to this file")
+    ap.add_argument("--pcap", metavar="FILE", help="write bus monitor captures to this pcap file")
+    ap.add_argument("--nrpl", metavar="FILE", help="write bus monitor captures as an NSP replay capture")
+    ap.add_argument("--tick-hz", type=int, default=100, help="emulator physics tick rate for --nrpl")
+    ap.add_argument("--addr", type=lambda v: int(v, 0), default=0,
+                    help="emulator NSP address recorded in the --nrpl header")
+    args = ap.parse_args()
+
+    # Opening the port raises DTR, which starts the stream (raw mode, no echo)
+    fd = os.open(args.port, os.O_RDONLY | os.O_NOCTTY)
+    if os.isatty(fd):
+        import termios
+        import tty
+        tty.setraw(fd)
+        attrs = termios.tcgetattr(fd)
+        attrs[2] |= termios.HUPCL
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+
+    trace = open(args.trace, "w") if args.trace else None
+    if trace:
+        trace.write("reason,index,rx_us,reply_us,dest,src,ctrl,command,outcome,detail,frame_len,reply_len\n")
+    rec_file = open(args.rec, "w") if args.rec else None
+    rec_rows = []
+    pcap = open(args.pcap, "wb") if args.pcap else None
+    if pcap:
+        pcap.write(PCAP_HEADER.pack(0xA1B2C3D4, 2, 4, 0, 0, PCAP_SNAPLEN, PCAP_LINKTYPE_USER0))
+    nrpl = open(args.nrpl, "wb") if args.nrpl else None
+    if nrpl:
+        nrpl.write(NRPL_HEADER.pack(NRPL_MAGIC, 1, args.tick_hz, args.addr & 0x07, 1, 0, 0))
+    nrpl_t0 = None
+    nrpl_frames = 0
+    tick_us = 1000000 // args.tick_hz
+    captured = 0
+    capture_dropped = None
+
+    frames = bad = lost = 0
+    last_seq = None
+    header_done = False
+    t0 = time.monotonic()
+
+    try:
+        for raw in slip_frames(fd):
+            if not crc_ok(raw):
+                bad += 1
+                continue
+            if raw[0] == FRAME_NSP_TRACE:
+                rec = decode_trace(raw)
+                if rec is None:
+                    bad += 1
+                elif trace:
+                    reason, entries = rec
+                    for index, (rx, reply, dest, src, ctrl, outcome, detail, flen, rlen) in entries:
+                        name = TRACE_OUTCOMES[outcome] if outcome < len(TRACE_OUTCOMES) else str(outcome)
+                        trace.write(f"{TRACE_REASONS.get(reason, reason)},{index},{rx},{reply},"
+                                    f"0x{dest:02X},0x{src:02X},0x{ctrl:02X},0x{ctrl & 0x1F:02X},"
+                                    f"{name},{detail},{flen},{rlen}\n")
+                continue
+            if raw[0] == FRAME_NSP_TRACE_END:
+                if len(raw) == TRACE_END.size + 2:
+                    _, reason, first, end = TRACE_END.unpack_from(raw)
+                    print(f"NSP trace dump ({TRACE_REASONS.get(reason, reason)}): "
+                          f"entries {first}..{end - 1}", file=sys.stderr)
+                    if trace:
+                        trace.flush()
+                continue
+
+            if raw[0] == FRAME_BUS_CAPTURE:
+                batch = decode_capture(raw)
+                if batch is None:
+                    bad += 1
+                    continue
+                dropped, records = batch
+                if capture_dropped is None:
+                    capture_dropped = dropped
+                elif dropped != capture_dropped:
+                    print(f"Bus capture: {dropped - capture_dropped} frames dropped", file=sys.stderr)
+                    capture_dropped = dropped
+                captured += len(records)
+                if pcap:
+                    for ts, flags, verdict, data in records:
+                        pkt = bytes([flags, verdict, 0, 0]) + data
+                        sec, usec = divmod(ts, 1000000)
+                        pcap.write(PCAP_RECORD.pack(sec, usec, len(pkt), len(pkt)) + pkt)
+                if nrpl:
+                    # Every request seen (any address, bad CRCs too) and our replies
+                    for ts, flags, verdict, data in records:
+                        if (flags & BUS_MON_F_TRUNC or verdict not in (BUS_MON_OK, BUS_MON_BAD_CRC) or
+                                not NSP_MIN_PACKET_SIZE <= len(data) <= NSP_MAX_PACKET_SIZE):
+                            continue
+                        if nrpl_t0 is None:
+                            nrpl_t0 = ts
+                        tick, offset = divmod(ts - nrpl_t0, tick_us)
+                        nrpl.write(NRPL_RECORD.pack(tick, offset, 1 if flags & BUS_MON_F_TX else 0,
+                                                    0, len(data)) + data)
+                        nrpl_frames += 1
+                continue
+
+            if raw[0] == FRAME_FLIGHT_REC:
+                samples = decode_rec(raw)
+                if samples is None:
+                    bad += 1
+                elif rec_file:
+                    if samples and samples[0][0] == 0:
+                        rec_rows = []   # New download
+                    rec_rows.extend(samples)
+                continue
+            if raw[0] == FRAME_FLIGHT_REC_END:
+                if len(raw) == REC_END.size + 2:
+                    _, cause, trig_wheel, wheels, trig_tick, ticks, pre, period_us = REC_END.unpack_from(raw)
+                    print(f"Flight recorder: cause 0x{cause:02X} wheel {trig_wheel} at tick {trig_tick}, "
+                          f"{ticks} ticks ({pre} before)", file=sys.stderr)
+                    if rec_file:
+                        rec_file.write("t_us,tick,wheel,omega_rad_s,current_cmd_a,current_out_a,torque_mnm,"
+                                       "power_w,fault_status,fault_latch,warning_status,mode,lcl,negative\n")
+                        for n, s in rec_rows:
+                            tick_index, wheel = divmod(n, wheels)
+                            rel = tick_index - pre
+                            vals = [f"{s[i] / REC_SCALES[i]:g}" for i in range(5)]
+                            flags = s[8]
+                            rec_file.write(f"{rel * period_us},{trig_tick + rel},{wheel}," + ",".join(vals) +
+                                           f",0x{s[5]:04X},0x{s[6]:04X},0x{s[7]:02X},{flags & 0x0F},"
+                                           f"{(flags >> 4) & 1},{(flags >> 5) & 1}\n")
+                        rec_file.flush()
+                rec_rows = []
+                continue
+
+            rec = decode(raw)
+            if rec is None:
+                bad += 1
+                continue
+            wheel, seq, tick, ts, values = rec
+            if last_seq is not None:
+                lost += (seq - last_seq - 1) & 0xFFFF
+            last_seq = seq
+            frames += 1
+
+            if args.stats:
+                elapsed = time.monotonic() - t0
+                if elapsed >= 1.0:
+                    print(f"{frames / elapsed:8.1f} frames/s  lost {lost}  bad {bad}", file=sys.stderr)
+                    frames = 0
+                    t0 = time.monotonic()
+                continue
+
+            if not header_done:
+                print(",".join(["wheel", "seq", "tick", "timestamp_us"] + list(values)))
+                header_done = True
+            print(",".join(str(v) for v in [wheel, seq, tick, ts] + list(values.values())))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.close(fd)
+        if trace:
+            trace.close()
+        if rec_file:
+            rec_file.close()
+        if pcap:
+            pcap.close()
+            print(f"{captured} bus frames written to {args.pcap}", file=sys.stderr)
+        if nrpl:
+            nrpl.close()
+            print(f"{nrpl_frames} frames written to {args.nrpl}", file=sys.stderr)
+        print(f"lost {lost} frames (sequence gaps), {bad} bad frames", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()